@@ -5,7 +5,7 @@
  * @date        2026-01-29
  * @brief       基于STM32 SysTick定时器实现的微秒/毫秒延时驱动模块
  *              支持FreeRTOS操作系统适配，同时重定义HAL库延时函数HAL_Delay
- *              HAL库使用TIM2作为tick源，SysTick完全交给FreeRTOS使用
+ *              SYS_HAL_TICK_USE_OS为1时HAL库与FreeRTOS共用SysTick时基，否则HAL库使用TIM2作为tick源
  ****************************************************************************************************
  */
 
@@ -19,6 +19,14 @@
 extern void xPortSysTickHandler(void);
 #endif
 
+#if SYS_SUPPORT_OS && SYS_HAL_TICK_USE_OS
+extern __IO uint32_t uwTick;    /* HAL库tick计数(stm32f1xx_hal.c)，调度器启动后不再增加 */
+
+/* 调度器启动前HAL_IncTick()每个SysTick中断加uwTickFreq(1ms)，启动后按FreeRTOS节拍换算毫秒，
+ * 两者一致要求节拍周期正好为1ms。configTICK_RATE_HZ带有类型转换，不能用于#if，故用数组长度检查 */
+typedef char delay_tick_rate_must_be_1000hz[(configTICK_RATE_HZ == 1000) ? 1 : -1];
+#endif
+
 /* 微秒延时的倍频系数 */
 static uint32_t g_fac_us = 0;
 
@@ -30,8 +38,8 @@ static uint16_t g_fac_ms = 0;
 #if SYS_SUPPORT_OS
 /**
  * @brief  SysTick中断服务函数（FreeRTOS专用）
- * @note   只调用FreeRTOS的SysTick处理函数
- *         不调用HAL_IncTick()，因为HAL使用TIM2作为时间基准
+ * @note   调度器启动后只调用FreeRTOS的SysTick处理函数
+ *         SYS_HAL_TICK_USE_OS为1时，调度器启动前由本中断调用HAL_IncTick()维护HAL时基
  */
 void SysTick_Handler(void)
 {
@@ -39,7 +47,33 @@ void SysTick_Handler(void)
     {
         xPortSysTickHandler();
     }
+#if SYS_HAL_TICK_USE_OS
+    else
+    {
+        HAL_IncTick();
+    }
+#endif
 }
+
+#if SYS_HAL_TICK_USE_OS
+/**
+ * @brief  重定义HAL_GetTick（HAL时基与FreeRTOS节拍统一）
+ * @retval 系统运行毫秒数
+ * @note   1. 调度器启动前返回SysTick中断累计的uwTick
+ *         2. 调度器启动后uwTick停止增加，返回uwTick加上FreeRTOS节拍换算的毫秒数，保证时基连续
+ *         3. 调度器挂起(vTaskSuspendAll)期间节拍计数暂停，但挂起期间的节拍也计入返回值，HAL超时照常到期
+ *         4. 任务和中断中均可调用
+ */
+uint32_t HAL_GetTick(void)
+{
+    if (xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED)
+    {
+        return uwTick;
+    }
+
+    return uwTick + (uint32_t)xTaskGetTickCountIncludingPended() * g_fac_ms;
+}
+#endif
 #endif
 
 /**
@@ -35,6 +35,13 @@
  */
 #define SYS_SUPPORT_OS          1
 
+/**
+ * SYS_HAL_TICK_USE_OS用于定义HAL库时基来源(仅SYS_SUPPORT_OS为1时有效)
+ * 0,HAL库时基由TIM2的1ms中断提供
+ * 1,HAL库时基与OS共用SysTick(调度器启动前由SysTick中断计数, 启动后读取OS节拍), TIM2可另作他用
+ */
+#define SYS_HAL_TICK_USE_OS     1
+
 
 /*函数申明*******************************************************************************************/
 
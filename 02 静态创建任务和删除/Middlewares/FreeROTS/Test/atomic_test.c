@@ -0,0 +1,669 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test of the functions in atomic.h and of the kernel paths that use them
+ * in place of a critical section, on the simulation port.  run.sh builds it
+ * twice: with the generic functions of atomic.h, which mask interrupts, and
+ * with -DportHAS_NATIVE_ATOMICS=1, which uses the LDREX/STREX functions of
+ * portable/RVDS/ARM_CM3/portatomic.h on host stand-ins for the exclusive
+ * access intrinsics, see host/port.c.
+ *
+ *   atomic_test test <seed>
+ *       Checks the value returned and the value left by every function in
+ *       atomic.h against a model, over random operands.  Then checks that
+ *       xTaskCatchUpTicks(), which adds to xPendedTicks with Atomic_Add_u32(),
+ *       moves the tick count on by exactly the ticks given, as well as any
+ *       ticks taken while the scheduler was suspended, and wakes delayed
+ *       tasks on time, and that ulTaskNotifyValueClear(), which clears bits
+ *       with Atomic_AND_u32(), returns the value before the clear and leaves
+ *       the other bits alone while an interrupt sets bits between calls.
+ *       Each of these must mask interrupts once more than it otherwise would
+ *       with the generic functions, and not at all more with native ones.
+ *
+ *   atomic_test threads <threads> <operations>
+ *       Native build only.  Host threads make random atomic operations on
+ *       shared words at once, with the stand-in for STREX failing at random
+ *       as well as when another thread wrote the word, so every retry path
+ *       of the LDREX/STREX loops runs.  Counts, bits and swapped values must
+ *       all come out exact.
+ *
+ *   atomic_test bench
+ *       For some kernel calls and the tick interrupt, the number of times
+ *       each masks interrupts and the longest time interrupts stay masked,
+ *       in host nanoseconds, the lowest of 25 runs so that host preemption
+ *       does not count.  Built both ways, it shows what the atomic
+ *       functions take off the masked time.
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "atomic.h"
+#include "sim.h"
+
+#define testMODEL_OPERATIONS    200000
+#define testCATCH_UPS           2000
+#define testCLEARS              20000
+#define testMAX_THREADS         8
+
+static unsigned long ulErrors = 0;
+static uint64_t ullRandomState = 88172645463325252ULL;
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    ullRandomState ^= ullRandomState << 13;
+    ullRandomState ^= ullRandomState >> 7;
+    ullRandomState ^= ullRandomState << 17;
+
+    return ( uint32_t ) ullRandomState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvError( const char * pcWhat )
+{
+    if( ulErrors++ < 5 )
+    {
+        printf( "%s\n", pcWhat );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* The masked sections a call of one of the atomic functions adds. */
+static unsigned long prvExpectedAtomicSections( void )
+{
+    return ( portHAS_NATIVE_ATOMICS == 1 ) ? 0UL : 1UL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckAtomicFunctions( void )
+{
+    static uint32_t volatile ulWord;
+    uint32_t ulBefore, ulOperand, ulComparand, ulExpected, ulReturned, ulExpectedReturn;
+    unsigned long ulSections;
+    int i, iFunction;
+
+    for( i = 0; i < testMODEL_OPERATIONS; i++ )
+    {
+        ulBefore = prvRandom();
+        ulOperand = prvRandom() >> ( prvRandom() % 32U );
+        iFunction = ( int ) ( prvRandom() % 11U );
+        ulWord = ulBefore;
+        ulExpectedReturn = ulBefore;
+        vSimStartMaskedCount( pdFALSE );
+
+        switch( iFunction )
+        {
+            case 0:
+                ulReturned = Atomic_Add_u32( &ulWord, ulOperand );
+                ulExpected = ulBefore + ulOperand;
+                break;
+
+            case 1:
+                ulReturned = Atomic_Subtract_u32( &ulWord, ulOperand );
+                ulExpected = ulBefore - ulOperand;
+                break;
+
+            case 2:
+                ulReturned = Atomic_Increment_u32( &ulWord );
+                ulExpected = ulBefore + 1U;
+                break;
+
+            case 3:
+                ulReturned = Atomic_Decrement_u32( &ulWord );
+                ulExpected = ulBefore - 1U;
+                break;
+
+            case 4:
+                ulReturned = Atomic_OR_u32( &ulWord, ulOperand );
+                ulExpected = ulBefore | ulOperand;
+                break;
+
+            case 5:
+                ulReturned = Atomic_AND_u32( &ulWord, ulOperand );
+                ulExpected = ulBefore & ulOperand;
+                break;
+
+            case 6:
+                ulReturned = Atomic_NAND_u32( &ulWord, ulOperand );
+                ulExpected = ~( ulBefore & ulOperand );
+                break;
+
+            case 7:
+                ulReturned = Atomic_XOR_u32( &ulWord, ulOperand );
+                ulExpected = ulBefore ^ ulOperand;
+                break;
+
+            default:
+                /* Compare and swap, matching about half the time. */
+                ulComparand = ( ( prvRandom() % 2U ) == 0U ) ? ulBefore : prvRandom();
+                ulReturned = Atomic_CompareAndSwap_u32( &ulWord, ulOperand, ulComparand );
+                ulExpected = ( ulComparand == ulBefore ) ? ulOperand : ulBefore;
+                ulExpectedReturn = ( ulComparand == ulBefore ) ? ATOMIC_COMPARE_AND_SWAP_SUCCESS : ATOMIC_COMPARE_AND_SWAP_FAILURE;
+                break;
+        }
+
+        ulSections = ulSimMaskedSections();
+
+        if( ( ulReturned != ulExpectedReturn ) || ( ulWord != ulExpected ) )
+        {
+            printf( "function %d on 0x%08lx with 0x%08lx returned 0x%08lx and left 0x%08lx\n", iFunction, ( unsigned long ) ulBefore,
+                    ( unsigned long ) ulOperand, ( unsigned long ) ulReturned, ( unsigned long ) ulWord );
+            prvError( "FAIL: an atomic function gave the wrong result" );
+        }
+
+        if( ulSections != prvExpectedAtomicSections() )
+        {
+            prvError( "FAIL: an atomic function masked interrupts the wrong number of times" );
+        }
+    }
+
+    /* The pointer functions cast pointers to 32 bits in portatomic.h, so they
+     * can only be run with the generic functions on a 64-bit host. */
+    #if ( portHAS_NATIVE_ATOMICS == 0 )
+    {
+        static int iTargets[ 2 ];
+        void * volatile pvPointer = &( iTargets[ 0 ] );
+
+        if( ( Atomic_SwapPointers_p32( &pvPointer, &( iTargets[ 1 ] ) ) != &( iTargets[ 0 ] ) ) || ( pvPointer != &( iTargets[ 1 ] ) ) ||
+            ( Atomic_CompareAndSwapPointers_p32( &pvPointer, NULL, &( iTargets[ 0 ] ) ) != ATOMIC_COMPARE_AND_SWAP_FAILURE ) ||
+            ( Atomic_CompareAndSwapPointers_p32( &pvPointer, NULL, &( iTargets[ 1 ] ) ) != ATOMIC_COMPARE_AND_SWAP_SUCCESS ) || ( pvPointer != NULL ) )
+        {
+            prvError( "FAIL: a pointer atomic function gave the wrong result" );
+        }
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * xTaskCatchUpTicks().
+ */
+
+static volatile TickType_t xDelayedWake;
+static volatile BaseType_t xDelayedWoken;
+static TickType_t xDelayTicks;
+static TaskHandle_t xDelayedTask;
+
+static void prvDelayedTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        xDelayedWoken = pdFALSE;
+        vTaskDelay( xDelayTicks );
+        xDelayedWake = xTaskGetTickCount();
+        xDelayedWoken = pdTRUE;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckCatchUpTicks( void )
+{
+    TickType_t xStart, xCatchUp, xSuspendedTicks, xElapsed;
+    unsigned long ulResumeSections, ulCatchUpSections;
+    int i;
+
+    /* The masked sections of suspending and resuming the scheduler alone. */
+    vSimStartMaskedCount( pdFALSE );
+    vTaskSuspendAll();
+    ( void ) xTaskResumeAll();
+    ulResumeSections = ulSimMaskedSections();
+
+    for( i = 0; i < testCATCH_UPS; i++ )
+    {
+        /* The delayed task runs at a higher priority, so it blocks as soon as
+         * it is notified. */
+        xDelayTicks = 1U + ( prvRandom() % 30U );
+        xTaskNotifyGive( xDelayedTask );
+        xStart = xTaskGetTickCount();
+
+        /* Ticks taken while the scheduler is suspended are pended by the
+         * tick interrupt, and caught up with those added here. */
+        xSuspendedTicks = prvRandom() % 3U;
+
+        if( xSuspendedTicks != 0U )
+        {
+            vTaskSuspendAll();
+            vSimRun( xSuspendedTicks * simCYCLES_PER_TICK );
+            ( void ) xTaskResumeAll();
+        }
+
+        xCatchUp = prvRandom() % 40U;
+        vSimStartMaskedCount( pdFALSE );
+        ( void ) xTaskCatchUpTicks( xCatchUp );
+        ulCatchUpSections = ulSimMaskedSections();
+
+        /* A task woken by the catch up runs before xTaskCatchUpTicks()
+         * returns, and masks interrupts itself. */
+        if( ( xDelayedWoken == pdFALSE ) && ( ulCatchUpSections != ( ulResumeSections + prvExpectedAtomicSections() ) ) )
+        {
+            printf( "xTaskCatchUpTicks() masked interrupts %lu times, resuming the scheduler alone %lu times\n", ulCatchUpSections, ulResumeSections );
+            prvError( "FAIL: xTaskCatchUpTicks() masked interrupts the wrong number of times" );
+        }
+
+        xElapsed = xTaskGetTickCount() - xStart;
+
+        if( xElapsed != ( xSuspendedTicks + xCatchUp ) )
+        {
+            printf( "the tick count moved on %lu ticks, not %lu\n", ( unsigned long ) xElapsed, ( unsigned long ) ( xSuspendedTicks + xCatchUp ) );
+            prvError( "FAIL: xTaskCatchUpTicks() moved the tick count on by the wrong number of ticks" );
+        }
+
+        if( xDelayedWoken != pdFALSE )
+        {
+            if( ( TickType_t ) ( xDelayedWake - xStart ) < xDelayTicks )
+            {
+                prvError( "FAIL: a delayed task woke before it was due" );
+            }
+        }
+        else if( xElapsed >= xDelayTicks )
+        {
+            prvError( "FAIL: a delayed task was not woken when the tick count passed its wake time" );
+        }
+
+        /* Let the delayed task finish before the next round. */
+        while( xDelayedWoken == pdFALSE )
+        {
+            vTaskDelay( 1 );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * ulTaskNotifyValueClear().
+ */
+
+static TaskHandle_t xNotifiedTask;
+
+static void prvNotifiedTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        vTaskSuspend( NULL );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckNotifyValueClear( void )
+{
+    uint32_t ulModel = 0, ulBits, ulReturned;
+    BaseType_t xWoken;
+    unsigned long ulSections;
+    int i;
+
+    ( void ) ulTaskNotifyValueClear( xNotifiedTask, 0xffffffffUL );
+
+    for( i = 0; i < testCLEARS; i++ )
+    {
+        if( ( prvRandom() % 2U ) == 0U )
+        {
+            ulBits = prvRandom();
+            xWoken = pdFALSE;
+            vSimEnterISR();
+            ( void ) xTaskNotifyFromISR( xNotifiedTask, ulBits, eSetBits, &xWoken );
+            vSimExitISR( xWoken );
+            ulModel |= ulBits;
+        }
+
+        ulBits = prvRandom() & prvRandom();
+        vSimStartMaskedCount( pdFALSE );
+        ulReturned = ulTaskNotifyValueClear( xNotifiedTask, ulBits );
+        ulSections = ulSimMaskedSections();
+
+        if( ulReturned != ulModel )
+        {
+            prvError( "FAIL: ulTaskNotifyValueClear() did not return the value before the clear" );
+        }
+
+        if( ulSections != prvExpectedAtomicSections() )
+        {
+            prvError( "FAIL: ulTaskNotifyValueClear() masked interrupts the wrong number of times" );
+        }
+
+        ulModel &= ~ulBits;
+
+        if( ulTaskNotifyValueClear( xNotifiedTask, 0 ) != ulModel )
+        {
+            prvError( "FAIL: ulTaskNotifyValueClear() cleared the wrong bits" );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    prvCheckAtomicFunctions();
+    prvCheckCatchUpTicks();
+    prvCheckNotifyValueClear();
+
+    printf( "%s atomic functions: %lu errors\n", ( portHAS_NATIVE_ATOMICS == 1 ) ? "native" : "generic", ulErrors );
+
+    exit( ( ulErrors != 0 ) ? 1 : 0 );
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Threads.
+ */
+
+typedef struct
+{
+    int iThread;
+    long lOperations;
+    uint64_t ullRandom;
+    uint32_t ulAdded;
+    uint32_t ulSwapped;
+    uint32_t ulSwappedIn;
+    uint32_t ulCompareAndSwaps;
+    uint32_t ulBits;
+} ThreadState_t;
+
+static uint32_t volatile ulSharedCount = 0, ulSharedBits = 0, ulSharedSwap = 0, ulSharedCompareAndSwaps = 0;
+static pthread_barrier_t xStartBarrier;
+
+/* Each thread only changes its own four bits of the shared word, so the bits
+ * an operation returns must be the ones the thread left. */
+static void prvCheckOwnBits( const ThreadState_t * pxState,
+                             uint32_t ulReturned,
+                             uint32_t ulOwnBits )
+{
+    if( ( ( ulReturned ^ pxState->ulBits ) & ulOwnBits ) != 0U )
+    {
+        prvError( "FAIL: a thread's bits of the shared word changed under it" );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void * prvThread( void * pvParameters )
+{
+    ThreadState_t * pxState = ( ThreadState_t * ) pvParameters;
+    const uint32_t ulOwnBits = 0xfUL << ( pxState->iThread * 4 );
+    uint32_t ulRandom, ulBits, ulValue;
+    long l;
+
+    ( void ) pthread_barrier_wait( &xStartBarrier );
+
+    for( l = 0; l < pxState->lOperations; l++ )
+    {
+        pxState->ullRandom ^= pxState->ullRandom << 13;
+        pxState->ullRandom ^= pxState->ullRandom >> 7;
+        pxState->ullRandom ^= pxState->ullRandom << 17;
+        ulRandom = ( uint32_t ) pxState->ullRandom;
+        ulBits = ( ulRandom >> 8 ) & ulOwnBits;
+
+        switch( ulRandom % 9U )
+        {
+            case 0:
+                ( void ) Atomic_Add_u32( &ulSharedCount, ulRandom >> 20 );
+                pxState->ulAdded += ulRandom >> 20;
+                break;
+
+            case 1:
+                ( void ) Atomic_Subtract_u32( &ulSharedCount, ulRandom >> 20 );
+                pxState->ulAdded -= ulRandom >> 20;
+                break;
+
+            case 2:
+                ( void ) Atomic_Increment_u32( &ulSharedCount );
+                pxState->ulAdded++;
+                break;
+
+            case 3:
+                ( void ) Atomic_Decrement_u32( &ulSharedCount );
+                pxState->ulAdded--;
+                break;
+
+            case 4:
+                prvCheckOwnBits( pxState, Atomic_OR_u32( &ulSharedBits, ulBits ), ulOwnBits );
+                pxState->ulBits |= ulBits;
+                break;
+
+            case 5:
+                prvCheckOwnBits( pxState, Atomic_AND_u32( &ulSharedBits, ~ulBits ), ulOwnBits );
+                pxState->ulBits &= ~ulBits;
+                break;
+
+            case 6:
+                prvCheckOwnBits( pxState, Atomic_XOR_u32( &ulSharedBits, ulBits ), ulOwnBits );
+                pxState->ulBits ^= ulBits;
+                break;
+
+            case 7:
+
+                do
+                {
+                    ulValue = ulSharedCompareAndSwaps;
+                } while( Atomic_CompareAndSwap_u32( &ulSharedCompareAndSwaps, ulValue + 1U, ulValue ) != ATOMIC_COMPARE_AND_SWAP_SUCCESS );
+
+                pxState->ulCompareAndSwaps++;
+                break;
+
+            default:
+
+                /* Every value swapped in is swapped out exactly once, by this
+                 * or a later swap or at the end. */
+                ulValue = ulRandom | 1U;
+                pxState->ulSwapped ^= ( uint32_t ) ( uintptr_t ) Atomic_SwapPointers_p32( ( void * volatile * ) &ulSharedSwap, ( void * ) ( uintptr_t ) ulValue );
+                pxState->ulSwappedIn ^= ulValue;
+                break;
+        }
+    }
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static int prvRunThreads( int iThreads,
+                          long lOperations )
+{
+    pthread_t xThreads[ testMAX_THREADS ];
+    ThreadState_t xStates[ testMAX_THREADS ];
+    uint32_t ulAdded = 0, ulBits = 0, ulCompareAndSwaps = 0, ulSwappedIn = 0, ulSwappedOut = 0;
+    int i;
+
+    memset( xStates, 0, sizeof( xStates ) );
+    ( void ) pthread_barrier_init( &xStartBarrier, NULL, ( unsigned ) iThreads );
+
+    for( i = 0; i < iThreads; i++ )
+    {
+        xStates[ i ].iThread = i;
+        xStates[ i ].lOperations = lOperations;
+        xStates[ i ].ullRandom = ullRandomState + ( ( uint64_t ) i * 0x9E3779B97F4A7C15ULL );
+        ( void ) pthread_create( &( xThreads[ i ] ), NULL, prvThread, &( xStates[ i ] ) );
+    }
+
+    for( i = 0; i < iThreads; i++ )
+    {
+        ( void ) pthread_join( xThreads[ i ], NULL );
+        ulAdded += xStates[ i ].ulAdded;
+        ulBits |= xStates[ i ].ulBits;
+        ulCompareAndSwaps += xStates[ i ].ulCompareAndSwaps;
+        ulSwappedIn ^= xStates[ i ].ulSwappedIn;
+        ulSwappedOut ^= xStates[ i ].ulSwapped;
+    }
+
+    /* Every value swapped in was swapped out again or is still there. */
+    ulSwappedOut ^= ulSharedSwap;
+
+    printf( "%d threads, %ld operations each: count 0x%08lx, bits 0x%08lx, compare and swaps %lu, %lu errors\n", iThreads, lOperations,
+            ( unsigned long ) ulSharedCount, ( unsigned long ) ulSharedBits, ( unsigned long ) ulSharedCompareAndSwaps, ulErrors );
+
+    if( ( ulSharedCount != ulAdded ) || ( ulSharedBits != ulBits ) || ( ulSharedCompareAndSwaps != ulCompareAndSwaps ) || ( ulSwappedIn != ulSwappedOut ) )
+    {
+        prvError( "FAIL: the shared words do not match the operations made on them" );
+    }
+
+    return ( ulErrors != 0 ) ? 1 : 0;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Benchmark.
+ */
+
+#define benchRUNS     25
+#define benchCALLS    1000
+
+typedef enum
+{
+    eQueueSendReceive,
+    eNotifyValueClear,
+    eCatchUpTicks,
+    eSingleWordReads,
+    eTickInterrupt,
+    eBenchOperations
+} BenchOperation_t;
+
+static const char * const pcBenchNames[ eBenchOperations ] =
+{
+    "xQueueSend() and xQueueReceive()",
+    "ulTaskNotifyValueClear()",
+    "xTaskCatchUpTicks( 1 )",
+    "uxTaskPriorityGet() and uxQueueMessagesWaiting()",
+    "tick interrupt"
+};
+
+static void prvBenchOperation( BenchOperation_t eOperation,
+                               QueueHandle_t xQueue )
+{
+    uint32_t ulItem = 0;
+
+    switch( eOperation )
+    {
+        case eQueueSendReceive:
+            ( void ) xQueueSend( xQueue, &ulItem, 0 );
+            ( void ) xQueueReceive( xQueue, &ulItem, 0 );
+            break;
+
+        case eNotifyValueClear:
+            ( void ) ulTaskNotifyValueClear( xNotifiedTask, 1U );
+            break;
+
+        case eCatchUpTicks:
+            ( void ) xTaskCatchUpTicks( 1 );
+            break;
+
+        case eSingleWordReads:
+            ( void ) uxTaskPriorityGet( NULL );
+            ( void ) uxQueueMessagesWaiting( xQueue );
+            break;
+
+        default:
+            vSimRun( simCYCLES_PER_TICK );
+            break;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void * pvParameters )
+{
+    QueueHandle_t xQueue = xQueueCreate( 4, sizeof( uint32_t ) );
+    uint64_t ullLongest, ullLongestOfAll = 0;
+    unsigned long ulSections = 0;
+    int iOperation, iRun, iCall;
+
+    ( void ) pvParameters;
+
+    printf( "%s atomic functions\n", ( portHAS_NATIVE_ATOMICS == 1 ) ? "native" : "generic" );
+    printf( "%-50s %17s %13s\n", "", "masked sections", "longest (ns)" );
+
+    for( iOperation = 0; iOperation < ( int ) eBenchOperations; iOperation++ )
+    {
+        ullLongest = UINT64_MAX;
+
+        for( iRun = 0; iRun < benchRUNS; iRun++ )
+        {
+            vSimStartMaskedCount( pdTRUE );
+
+            for( iCall = 0; iCall < benchCALLS; iCall++ )
+            {
+                prvBenchOperation( ( BenchOperation_t ) iOperation, xQueue );
+            }
+
+            ulSections = ulSimMaskedSections();
+
+            if( ullSimLongestMaskedNanoseconds() < ullLongest )
+            {
+                ullLongest = ullSimLongestMaskedNanoseconds();
+            }
+        }
+
+        if( ullLongest > ullLongestOfAll )
+        {
+            ullLongestOfAll = ullLongest;
+        }
+
+        printf( "%-50s %17.1f %13llu\n", pcBenchNames[ iOperation ], ( double ) ulSections / benchCALLS, ( unsigned long long ) ullLongest );
+    }
+
+    printf( "%-50s %17s %13llu\n", "longest of all", "", ( unsigned long long ) ullLongestOfAll );
+
+    exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    if( ( argc == 3 ) && ( strcmp( argv[ 1 ], "test" ) == 0 ) )
+    {
+        ullRandomState ^= strtoull( argv[ 2 ], NULL, 0 ) * 0x9E3779B97F4A7C15ULL;
+        ( void ) xTaskCreate( prvTestTask, "Test", configMINIMAL_STACK_SIZE, NULL, 1, NULL );
+        ( void ) xTaskCreate( prvDelayedTask, "Delayed", configMINIMAL_STACK_SIZE, NULL, 2, &xDelayedTask );
+        ( void ) xTaskCreate( prvNotifiedTask, "Notified", configMINIMAL_STACK_SIZE, NULL, 2, &xNotifiedTask );
+    }
+    else if( ( argc == 4 ) && ( strcmp( argv[ 1 ], "threads" ) == 0 ) && ( portHAS_NATIVE_ATOMICS == 1 ) &&
+             ( atoi( argv[ 2 ] ) >= 1 ) && ( atoi( argv[ 2 ] ) <= testMAX_THREADS ) )
+    {
+        return prvRunThreads( atoi( argv[ 2 ] ), atol( argv[ 3 ] ) );
+    }
+    else if( ( argc == 2 ) && ( strcmp( argv[ 1 ], "bench" ) == 0 ) )
+    {
+        ( void ) xTaskCreate( prvBenchTask, "Bench", configMINIMAL_STACK_SIZE, NULL, 1, NULL );
+        ( void ) xTaskCreate( prvNotifiedTask, "Notified", configMINIMAL_STACK_SIZE, NULL, 2, &xNotifiedTask );
+    }
+    else
+    {
+        printf( "usage: %s test <seed> | threads <1 to %d> <operations> | bench\n", argv[ 0 ], testMAX_THREADS );
+        printf( "threads needs a build with -DportHAS_NATIVE_ATOMICS=1\n" );
+        return 1;
+    }
+
+    vTaskStartScheduler();
+
+    return 1;
+}
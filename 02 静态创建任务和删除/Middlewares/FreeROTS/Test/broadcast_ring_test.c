@@ -0,0 +1,305 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test of broadcast rings (configUSE_BROADCAST_RINGS) with several readers on
+ * the simulation port.
+ *
+ *   broadcast_ring_test <seconds> <seed>
+ *
+ * One producer task sends numbered items to a ring of 8 items, from the task
+ * with random block times and as if from an interrupt, to four reader tasks
+ * at different priorities.  Two readers drop the oldest item when they fall
+ * behind and two hold the producer back, and one of the back-pressure readers
+ * keeps leaving the ring and joining it again.  Every reader checks that its
+ * items are intact and in order, a back-pressure reader that nothing is
+ * missing, and a drop oldest reader that the items it missed match its
+ * overrun count.  A receive that times out must not return before its block
+ * time.
+ *
+ * The producer stops at the given time and the readers then have a second to
+ * read what is left, after which every reader that stayed on the ring must
+ * account for every item sent.  Every task's notification value is set
+ * before the scheduler starts, and must be unchanged at the end, as the ring
+ * only uses the notification state to block.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "bcastring.h"
+#include "sim.h"
+
+#define testLENGTH               8
+#define testREADERS              4
+#define testREJOINING_READER     3
+#define testNOTIFICATION_VALUE   0x5A5A1234UL
+
+typedef struct
+{
+    uint32_t ulSequence;
+    uint8_t ucPadding[ 5 ];
+    uint32_t ulCheck;
+} TestItem_t;
+
+typedef struct
+{
+    eBroadcastPolicy ePolicy;
+    uint32_t ulWorkCycles;
+    BroadcastReader_t xReaderBuffer;
+    BroadcastReaderHandle_t xReader;
+    TaskHandle_t xTask;
+    BaseType_t xFresh;
+    uint32_t ulLast;
+    unsigned long ulReceived;
+    unsigned long ulMissed;
+    unsigned long ulOverruns;
+    unsigned long ulEarlyTimeouts;
+    unsigned long ulRejoins;
+} TestReader_t;
+
+static const eBroadcastPolicy ePolicies[ testREADERS ] = { eBroadcastDropOldest, eBroadcastDropOldest, eBroadcastBackPressure, eBroadcastBackPressure };
+static const UBaseType_t uxPriorities[ testREADERS ] = { 1, 2, 3, 1 };
+static const uint32_t ulWorkCycles[ testREADERS ] = { 3000, 30000, 9000, 3000 };
+
+static TestReader_t xReaders[ testREADERS ];
+
+static BroadcastRingHandle_t xRing;
+static TaskHandle_t xProducer;
+static uint64_t ullStopTime;
+static unsigned long ulSent = 0, ulSendFailures = 0, ulBadItems = 0;
+static uint64_t ullRandomState = 88172645463325252ULL;
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    ullRandomState ^= ullRandomState << 13;
+    ullRandomState ^= ullRandomState >> 7;
+    ullRandomState ^= ullRandomState << 17;
+
+    return ( uint32_t ) ullRandomState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvProducerTask( void * pvParameters )
+{
+    TestItem_t xItem = { 0 };
+    BaseType_t xResult, xWoken;
+    TickType_t xTicksToWait;
+
+    ( void ) pvParameters;
+
+    while( ullSimTime < ullStopTime )
+    {
+        xItem.ulSequence = ( uint32_t ) ulSent;
+        xItem.ulCheck = xItem.ulSequence * 2654435761UL;
+
+        if( ( prvRandom() % 3U ) == 0U )
+        {
+            xWoken = pdFALSE;
+            vSimEnterISR();
+            xResult = xBroadcastRingSendFromISR( xRing, &xItem, &xWoken );
+            vSimExitISR( xWoken );
+        }
+        else
+        {
+            xTicksToWait = ( ( prvRandom() % 4U ) != 0U ) ? ( prvRandom() % 5U ) : portMAX_DELAY;
+            xResult = xBroadcastRingSend( xRing, &xItem, xTicksToWait );
+        }
+
+        if( xResult == pdPASS )
+        {
+            ulSent++;
+        }
+        else
+        {
+            ulSendFailures++;
+        }
+
+        vSimRun( prvRandom() % 4000U );
+
+        if( ( prvRandom() % 16U ) == 0U )
+        {
+            vTaskDelay( prvRandom() % 4U );
+        }
+    }
+
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReaderTask( void * pvParameters )
+{
+    TestReader_t * pxReader = ( TestReader_t * ) pvParameters;
+    TestItem_t xItem;
+    TickType_t xStart, xTicksToWait;
+
+    for( ; ; )
+    {
+        if( ( pxReader == &( xReaders[ testREJOINING_READER ] ) ) && ( ( prvRandom() % 200U ) == 0U ) )
+        {
+            pxReader->ulOverruns += uxBroadcastRingGetOverruns( pxReader->xReader, pdTRUE );
+            vBroadcastRingRemoveReader( pxReader->xReader );
+            vSimRun( prvRandom() % 200000U );
+            pxReader->xReader = xBroadcastRingAddReader( xRing, pxReader->ePolicy, &( pxReader->xReaderBuffer ) );
+            pxReader->xFresh = pdTRUE;
+            pxReader->ulRejoins++;
+            continue;
+        }
+
+        xStart = xTaskGetTickCount();
+        xTicksToWait = prvRandom() % 6U;
+
+        if( xBroadcastRingReceive( pxReader->xReader, &xItem, xTicksToWait ) == pdPASS )
+        {
+            if( xItem.ulCheck != ( uint32_t ) ( xItem.ulSequence * 2654435761UL ) )
+            {
+                ulBadItems++;
+            }
+            else if( pxReader->xFresh == pdFALSE )
+            {
+                if( xItem.ulSequence <= pxReader->ulLast )
+                {
+                    printf( "reader %d received item %lu after %lu\n", ( int ) ( pxReader - xReaders ), ( unsigned long ) xItem.ulSequence,
+                            ( unsigned long ) pxReader->ulLast );
+                    ulBadItems++;
+                }
+                else
+                {
+                    pxReader->ulMissed += xItem.ulSequence - pxReader->ulLast - 1U;
+                }
+            }
+
+            pxReader->xFresh = pdFALSE;
+            pxReader->ulLast = xItem.ulSequence;
+            pxReader->ulReceived++;
+        }
+        else if( ( TickType_t ) ( xTaskGetTickCount() - xStart ) < xTicksToWait )
+        {
+            pxReader->ulEarlyTimeouts++;
+        }
+
+        vSimRun( prvRandom() % pxReader->ulWorkCycles );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static int prvTestEnd( void )
+{
+    TestReader_t * pxReader;
+    unsigned long ulValue;
+    int i, iResult = 0;
+
+    printf( "%lu sent, %lu send failures, %lu bad items\n", ulSent, ulSendFailures, ulBadItems );
+
+    if( ( ulBadItems != 0 ) || ( ulSent == 0 ) )
+    {
+        iResult = 1;
+    }
+
+    for( i = 0; i < testREADERS; i++ )
+    {
+        pxReader = &( xReaders[ i ] );
+        pxReader->ulOverruns += uxBroadcastRingGetOverruns( pxReader->xReader, pdFALSE );
+
+        printf( "reader %d %s: %lu received, %lu missed, %lu overruns, %lu left, %lu early timeouts, %lu rejoins\n", i,
+                ( pxReader->ePolicy == eBroadcastDropOldest ) ? "drop oldest  " : "back-pressure", pxReader->ulReceived, pxReader->ulMissed,
+                pxReader->ulOverruns, ( unsigned long ) uxBroadcastRingItemsWaiting( pxReader->xReader ), pxReader->ulEarlyTimeouts, pxReader->ulRejoins );
+
+        if( pxReader->ulMissed != ( ( pxReader->ePolicy == eBroadcastDropOldest ) ? pxReader->ulOverruns : 0UL ) )
+        {
+            printf( "FAIL: reader %d missed items that were not counted as overruns\n", i );
+            iResult = 1;
+        }
+
+        if( ( i != testREJOINING_READER ) &&
+            ( ( ( pxReader->ulReceived + pxReader->ulOverruns ) != ulSent ) || ( uxBroadcastRingItemsWaiting( pxReader->xReader ) != 0 ) ) )
+        {
+            printf( "FAIL: reader %d did not account for every item sent\n", i );
+            iResult = 1;
+        }
+
+        if( pxReader->ulEarlyTimeouts != 0 )
+        {
+            printf( "FAIL: reader %d timed out before its block time\n", i );
+            iResult = 1;
+        }
+
+        ulValue = ulTaskNotifyValueClear( pxReader->xTask, 0 );
+
+        if( ulValue != testNOTIFICATION_VALUE )
+        {
+            printf( "FAIL: reader %d's notification value changed to 0x%08lx\n", i, ulValue );
+            iResult = 1;
+        }
+    }
+
+    ulValue = ulTaskNotifyValueClear( xProducer, 0 );
+
+    if( ulValue != testNOTIFICATION_VALUE )
+    {
+        printf( "FAIL: the producer's notification value changed to 0x%08lx\n", ulValue );
+        iResult = 1;
+    }
+
+    return iResult;
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    int i;
+
+    if( argc != 3 )
+    {
+        printf( "usage: %s <seconds> <seed>\n", argv[ 0 ] );
+        return 1;
+    }
+
+    ullRandomState ^= strtoull( argv[ 2 ], NULL, 0 ) * 0x9E3779B97F4A7C15ULL;
+    ullStopTime = simSECONDS( atof( argv[ 1 ] ) );
+
+    xRing = xBroadcastRingCreate( testLENGTH, sizeof( TestItem_t ) );
+    configASSERT( xRing != NULL );
+
+    ( void ) xTaskCreate( prvProducerTask, "Prod", configMINIMAL_STACK_SIZE, NULL, 2, &xProducer );
+    ( void ) xTaskNotify( xProducer, testNOTIFICATION_VALUE, eSetValueWithOverwrite );
+
+    for( i = 0; i < testREADERS; i++ )
+    {
+        xReaders[ i ].ePolicy = ePolicies[ i ];
+        xReaders[ i ].ulWorkCycles = ulWorkCycles[ i ];
+        xReaders[ i ].xReader = xBroadcastRingAddReader( xRing, xReaders[ i ].ePolicy, &( xReaders[ i ].xReaderBuffer ) );
+        xReaders[ i ].xFresh = pdTRUE;
+        ( void ) xTaskCreate( prvReaderTask, "Reader", configMINIMAL_STACK_SIZE, &( xReaders[ i ] ), uxPriorities[ i ], &( xReaders[ i ].xTask ) );
+        ( void ) xTaskNotify( xReaders[ i ].xTask, testNOTIFICATION_VALUE, eSetValueWithOverwrite );
+    }
+
+    vSimSetEndTime( ullStopTime + simSECONDS( 1 ), prvTestEnd );
+    vTaskStartScheduler();
+
+    return 1;
+}
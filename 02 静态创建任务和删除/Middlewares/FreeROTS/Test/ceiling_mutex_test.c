@@ -0,0 +1,346 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test of priority ceiling mutexes (configUSE_CEILING_MUTEXES) against
+ * priority inheritance mutexes, on the simulation port.
+ *
+ *   ceiling_mutex_test <seconds> <seed> ceiling|inheritance
+ *
+ * Four periodic tasks share two resources.  H (priority 4) uses R1, M
+ * (priority 3) uses R2, L (priority 2) takes R1 and then, on most releases,
+ * R2 inside it, and L2 (priority 1) takes R2 and then R1 inside it - the
+ * opposite order, which deadlocks L and L2 under priority inheritance.  With
+ * ceiling mutexes R1 has a ceiling of 4 and R2 a ceiling of 3.
+ *
+ * A ceiling run fails if any take times out (a deadlock), if two tasks are
+ * ever inside the same resource, if a task holding a resource runs below
+ * that resource's ceiling or ends a release at other than its own priority,
+ * or if H is ever blocked for longer than the longest section a lower task
+ * spends holding R1, which is the bound the ceiling protocol gives.  An
+ * inheritance run, which waits 40 ticks at most for each take, is only
+ * reported, for comparison.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "sim.h"
+
+#define testTASKS                   4
+#define testINHERITANCE_TIMEOUT     40
+
+/* Work is given in units of testWORK_SCALE cycles. */
+#define testWORK_SCALE              3U
+
+enum
+{
+    testH = 0,
+    testM,
+    testL,
+    testL2
+};
+
+static const char * const pcNames[ testTASKS ] = { "H", "M", "L", "L2" };
+static const UBaseType_t uxPriorities[ testTASKS ] = { 4, 3, 2, 1 };
+static const TickType_t xPeriods[ testTASKS ] = { 5, 7, 11, 13 };
+
+static SemaphoreHandle_t xR1, xR2;
+static BaseType_t xCeilingMode;
+static uint64_t ullRandomState = 88172645463325252ULL;
+
+/* The task inside each resource, or -1. */
+static volatile int iR1Owner = -1, iR2Owner = -1;
+
+static uint64_t ullWorkDone[ testTASKS ];
+static unsigned long ulTimeouts = 0, ulOverlaps = 0, ulBadPriorities = 0;
+static unsigned long ulReleases[ testTASKS ], ulFoundHeld[ testTASKS ];
+static uint64_t ullMaxResponse[ testTASKS ], ullMaxBlocked[ testTASKS ];
+static uint64_t ullMaxR1Section = 0, ullMaxR2Section = 0;
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    ullRandomState ^= ullRandomState << 13;
+    ullRandomState ^= ullRandomState >> 7;
+    ullRandomState ^= ullRandomState << 17;
+
+    return ( uint32_t ) ullRandomState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWork( int iTask,
+                     uint32_t ulUnits )
+{
+    uint64_t ullCycles = ( uint64_t ) ulUnits * testWORK_SCALE;
+
+    ullWorkDone[ iTask ] += ullCycles;
+    vSimRun( ullCycles );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTake( SemaphoreHandle_t xResource,
+                           int iTask )
+{
+    BaseType_t xTaken;
+
+    if( xSemaphoreGetMutexHolder( xResource ) != NULL )
+    {
+        ulFoundHeld[ iTask ]++;
+    }
+
+    xTaken = xSemaphoreTake( xResource, ( xCeilingMode != pdFALSE ) ? portMAX_DELAY : testINHERITANCE_TIMEOUT );
+
+    if( xTaken == pdFALSE )
+    {
+        ulTimeouts++;
+    }
+
+    return xTaken;
+}
+/*-----------------------------------------------------------*/
+
+static void prvEnter( volatile int * piOwner,
+                      int iTask,
+                      UBaseType_t uxCeiling )
+{
+    if( *piOwner != -1 )
+    {
+        ulOverlaps++;
+    }
+
+    *piOwner = iTask;
+
+    if( ( xCeilingMode != pdFALSE ) && ( uxTaskPriorityGet( NULL ) < uxCeiling ) )
+    {
+        ulBadPriorities++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvLeave( volatile int * piOwner,
+                      SemaphoreHandle_t xResource,
+                      uint64_t ullEntered,
+                      uint64_t * pullMaxSection )
+{
+    *piOwner = -1;
+    ( void ) xSemaphoreGive( xResource );
+
+    if( ( ullSimTime - ullEntered ) > *pullMaxSection )
+    {
+        *pullMaxSection = ullSimTime - ullEntered;
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Holds the first resource, and on two releases in three the second inside
+ * it, as L and L2 do. */
+static void prvNestedRelease( int iTask,
+                              SemaphoreHandle_t xOuter,
+                              volatile int * piOuterOwner,
+                              UBaseType_t uxOuterCeiling,
+                              uint64_t * pullMaxOuterSection,
+                              SemaphoreHandle_t xInner,
+                              volatile int * piInnerOwner,
+                              UBaseType_t uxInnerCeiling,
+                              uint64_t * pullMaxInnerSection )
+{
+    uint64_t ullOuterEntered, ullInnerEntered;
+    BaseType_t xNest = ( ( prvRandom() % 3U ) != 0U ) ? pdTRUE : pdFALSE;
+
+    prvWork( iTask, prvRandom() % 20000U );
+
+    if( prvTake( xOuter, iTask ) != pdFALSE )
+    {
+        ullOuterEntered = ullSimTime;
+        prvEnter( piOuterOwner, iTask, uxOuterCeiling );
+        prvWork( iTask, prvRandom() % 8000U );
+
+        if( ( xNest != pdFALSE ) && ( prvTake( xInner, iTask ) != pdFALSE ) )
+        {
+            ullInnerEntered = ullSimTime;
+            prvEnter( piInnerOwner, iTask, configMAX( uxOuterCeiling, uxInnerCeiling ) );
+            prvWork( iTask, prvRandom() % 8000U );
+            prvLeave( piInnerOwner, xInner, ullInnerEntered, pullMaxInnerSection );
+        }
+
+        prvWork( iTask, prvRandom() % 8000U );
+        prvLeave( piOuterOwner, xOuter, ullOuterEntered, pullMaxOuterSection );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvTask( void * pvParameters )
+{
+    int iTask = ( int ) ( intptr_t ) pvParameters;
+    TickType_t xLastWakeTime = xTaskGetTickCount();
+    uint64_t ullReleased, ullResponse;
+
+    for( ; ; )
+    {
+        vTaskDelayUntil( &xLastWakeTime, xPeriods[ iTask ] );
+        ullReleased = ( uint64_t ) xLastWakeTime * simCYCLES_PER_TICK;
+        ullWorkDone[ iTask ] = 0;
+
+        switch( iTask )
+        {
+            case testH:
+                prvWork( iTask, 5000U + ( prvRandom() % 10000U ) );
+
+                if( prvTake( xR1, iTask ) != pdFALSE )
+                {
+                    prvEnter( &iR1Owner, iTask, 4 );
+                    prvWork( iTask, 3000U + ( prvRandom() % 8000U ) );
+                    iR1Owner = -1;
+                    ( void ) xSemaphoreGive( xR1 );
+                }
+
+                break;
+
+            case testM:
+                prvWork( iTask, 8000U + ( prvRandom() % 10000U ) );
+
+                if( prvTake( xR2, iTask ) != pdFALSE )
+                {
+                    prvEnter( &iR2Owner, iTask, 3 );
+                    prvWork( iTask, 2000U + ( prvRandom() % 6000U ) );
+                    iR2Owner = -1;
+                    ( void ) xSemaphoreGive( xR2 );
+                }
+
+                break;
+
+            case testL:
+                prvNestedRelease( iTask, xR1, &iR1Owner, 4, &ullMaxR1Section, xR2, &iR2Owner, 3, &ullMaxR2Section );
+                break;
+
+            default:
+                prvNestedRelease( iTask, xR2, &iR2Owner, 3, &ullMaxR2Section, xR1, &iR1Owner, 4, &ullMaxR1Section );
+                break;
+        }
+
+        if( uxTaskPriorityGet( NULL ) != uxPriorities[ iTask ] )
+        {
+            ulBadPriorities++;
+        }
+
+        /* The time the release took beyond its own work is the time it was
+         * preempted or blocked. */
+        ullResponse = ullSimTime - ullReleased;
+        ullMaxResponse[ iTask ] = configMAX( ullMaxResponse[ iTask ], ullResponse );
+        ullMaxBlocked[ iTask ] = configMAX( ullMaxBlocked[ iTask ], ullResponse - ullWorkDone[ iTask ] );
+        ulReleases[ iTask ]++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static int prvEndHook( void )
+{
+    double dTick = ( double ) simCYCLES_PER_TICK;
+    int i, iResult = 0;
+
+    printf( "%-11s releases", ( xCeilingMode != pdFALSE ) ? "ceiling" : "inheritance" );
+
+    for( i = 0; i < testTASKS; i++ )
+    {
+        printf( " %s=%lu", pcNames[ i ], ulReleases[ i ] );
+    }
+
+    printf( ", timeouts %lu, overlaps %lu, wrong priorities %lu, H found R1 held %lu times\n", ulTimeouts, ulOverlaps, ulBadPriorities, ulFoundHeld[ testH ] );
+    printf( "    worst response (ticks)" );
+
+    for( i = 0; i < testTASKS; i++ )
+    {
+        printf( " %s=%.2f", pcNames[ i ], ullMaxResponse[ i ] / dTick );
+    }
+
+    printf( ", H blocked %.2f, M blocked %.2f, longest R1 section %.2f, R2 section %.2f\n",
+            ullMaxBlocked[ testH ] / dTick, ullMaxBlocked[ testM ] / dTick, ullMaxR1Section / dTick, ullMaxR2Section / dTick );
+
+    if( xCeilingMode != pdFALSE )
+    {
+        if( ( ulTimeouts != 0 ) || ( ulOverlaps != 0 ) || ( ulBadPriorities != 0 ) )
+        {
+            printf( "FAIL: a take timed out, a resource was shared or a priority was wrong\n" );
+            iResult = 1;
+        }
+
+        if( ullMaxBlocked[ testH ] > ullMaxR1Section )
+        {
+            printf( "FAIL: H was blocked for longer than one lower R1 section\n" );
+            iResult = 1;
+        }
+
+        for( i = 0; i < testTASKS; i++ )
+        {
+            if( ulReleases[ i ] == 0 )
+            {
+                printf( "FAIL: %s never completed a release\n", pcNames[ i ] );
+                iResult = 1;
+            }
+        }
+    }
+
+    return iResult;
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    int i;
+
+    if( ( argc != 4 ) || ( ( strcmp( argv[ 3 ], "ceiling" ) != 0 ) && ( strcmp( argv[ 3 ], "inheritance" ) != 0 ) ) )
+    {
+        printf( "usage: %s <seconds> <seed> ceiling|inheritance\n", argv[ 0 ] );
+        return 1;
+    }
+
+    ullRandomState ^= strtoull( argv[ 2 ], NULL, 0 ) * 0x9E3779B97F4A7C15ULL;
+    xCeilingMode = ( strcmp( argv[ 3 ], "ceiling" ) == 0 ) ? pdTRUE : pdFALSE;
+
+    if( xCeilingMode != pdFALSE )
+    {
+        xR1 = xSemaphoreCreateCeilingMutex( 4 );
+        xR2 = xSemaphoreCreateCeilingMutex( 3 );
+    }
+    else
+    {
+        xR1 = xSemaphoreCreateMutex();
+        xR2 = xSemaphoreCreateMutex();
+    }
+
+    for( i = 0; i < testTASKS; i++ )
+    {
+        ( void ) xTaskCreate( prvTask, pcNames[ i ], configMINIMAL_STACK_SIZE, ( void * ) ( intptr_t ) i, uxPriorities[ i ], NULL );
+    }
+
+    vSimSetEndTime( simSECONDS( atof( argv[ 1 ] ) ), prvEndHook );
+    vTaskStartScheduler();
+
+    return 1;
+}
@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test and benchmark of the blocked task bookkeeping in tasks.c, with either
+ * the sorted delayed lists or the delayed task wheel
+ * (configUSE_DELAYED_TASK_WHEEL).
+ *
+ *   delayed_task_wheel_test test <start tick> <ticks> <tasks>
+ *       Blocks the tasks with random delays, including 0, delays that cross
+ *       the tick count overflow and delays near portMAX_DELAY, then runs the
+ *       tick for the given number of ticks.  Each task must be readied at
+ *       exactly the tick it was due, and xNextTaskUnblockTime must never be
+ *       later than the earliest wake time.  Some tasks are also readied
+ *       early, as xTaskAbortDelay() would.
+ *
+ *   delayed_task_wheel_test bench <tasks> <ticks>
+ *       Host time taken to block a task, with the given number of tasks
+ *       already blocked, and to process one tick.
+ *
+ * The scheduler is not started.  The test includes tasks.c so it can block
+ * any task by making it the current task.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "tasks.c"
+
+#define testMAX_TASKS     1000
+#define testSTACK_SIZE    64
+
+static StaticTask_t xTaskBuffers[ testMAX_TASKS ];
+static StackType_t uxTaskStacks[ testMAX_TASKS ][ testSTACK_SIZE ];
+static TaskHandle_t xTasks[ testMAX_TASKS ];
+static TickType_t xWakeTimes[ testMAX_TASKS ];
+static BaseType_t xBlocked[ testMAX_TASKS ];
+static uint64_t ullRandomState = 88172645463325252ULL;
+
+static uint32_t prvRandom( void )
+{
+    ullRandomState ^= ullRandomState << 13;
+    ullRandomState ^= ullRandomState >> 7;
+    ullRandomState ^= ullRandomState << 17;
+
+    return ( uint32_t ) ullRandomState;
+}
+/*-----------------------------------------------------------*/
+
+static double prvNanoseconds( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( double ) xNow.tv_sec * 1e9 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskFunction( void * pvParameters )
+{
+    ( void ) pvParameters;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBlock( int iTask,
+                      TickType_t xTicksToDelay )
+{
+    pxCurrentTCB = ( TCB_t * ) xTasks[ iTask ];
+    prvAddCurrentTaskToDelayedList( xTicksToDelay, pdFALSE );
+
+    /* A delay of 0 still waits for the next tick. */
+    xWakeTimes[ iTask ] = xTickCount + ( ( xTicksToDelay != 0U ) ? xTicksToDelay : 1U );
+    xBlocked[ iTask ] = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvIsReady( int iTask )
+{
+    TCB_t * pxTCB = ( TCB_t * ) xTasks[ iTask ];
+
+    return listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) );
+}
+/*-----------------------------------------------------------*/
+
+static int prvTest( TickType_t xStartTick,
+                    long lTicks,
+                    int iTaskCount )
+{
+    long lTick, lWakes = 0;
+    int i;
+    TickType_t xNow, xDelay;
+    uint32_t ulKind;
+
+    xTickCount = xStartTick;
+    xNextTaskUnblockTime = portMAX_DELAY;
+
+    for( i = 0; i < iTaskCount; i++ )
+    {
+        ulKind = prvRandom() % 10U;
+
+        if( ulKind == 0U )
+        {
+            xDelay = 0;
+        }
+        else if( ulKind == 1U )
+        {
+            /* Just short of portMAX_DELAY, so the wake time wraps. */
+            xDelay = 0xFFFFFFF0UL + ( prvRandom() % 14U );
+        }
+        else if( ulKind == 2U )
+        {
+            xDelay = prvRandom() % 100000U;
+        }
+        else
+        {
+            xDelay = prvRandom() % 3000U;
+        }
+
+        prvBlock( i, xDelay );
+    }
+
+    for( lTick = 0; lTick < lTicks; lTick++ )
+    {
+        ( void ) xTaskIncrementTick();
+        xNow = xTickCount;
+
+        for( i = 0; i < iTaskCount; i++ )
+        {
+            if( xBlocked[ i ] == pdFALSE )
+            {
+                continue;
+            }
+
+            if( prvIsReady( i ) != pdFALSE )
+            {
+                if( xWakeTimes[ i ] != xNow )
+                {
+                    printf( "FAIL: task %d woke at %lu, due at %lu\n", i, ( unsigned long ) xNow, ( unsigned long ) xWakeTimes[ i ] );
+                    return 1;
+                }
+
+                xBlocked[ i ] = pdFALSE;
+                lWakes++;
+
+                ulKind = prvRandom() % 10U;
+                xDelay = ( ulKind == 0U ) ? 0U : ( ( ulKind == 1U ) ? ( prvRandom() % 50000U ) : ( prvRandom() % 700U ) );
+                prvBlock( i, xDelay );
+            }
+            else if( xWakeTimes[ i ] == xNow )
+            {
+                printf( "FAIL: task %d not woken at %lu\n", i, ( unsigned long ) xNow );
+                return 1;
+            }
+        }
+
+        for( i = 0; i < iTaskCount; i++ )
+        {
+            if( ( xBlocked[ i ] != pdFALSE ) && ( xWakeTimes[ i ] > xNow ) && ( xWakeTimes[ i ] < xNextTaskUnblockTime ) )
+            {
+                printf( "FAIL: next unblock time %lu is after task %d's wake time %lu at tick %lu\n",
+                        ( unsigned long ) xNextTaskUnblockTime, i, ( unsigned long ) xWakeTimes[ i ], ( unsigned long ) xNow );
+                return 1;
+            }
+        }
+
+        /* Now and then ready a blocked task early, as xTaskAbortDelay() does,
+         * and block it again. */
+        if( ( prvRandom() % 97U ) == 0U )
+        {
+            TCB_t * pxTCB;
+
+            i = ( int ) ( prvRandom() % ( uint32_t ) iTaskCount );
+            pxTCB = ( TCB_t * ) xTasks[ i ];
+
+            ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+            prvAddTaskToReadyList( pxTCB );
+            prvResetNextTaskUnblockTime();
+            prvBlock( i, prvRandom() % 700U );
+        }
+    }
+
+    printf( "wheel=%d start=0x%08lx tasks=%d: OK, %ld wakes, %ld tick overflows\n", configUSE_DELAYED_TASK_WHEEL,
+            ( unsigned long ) xStartTick, iTaskCount, lWakes, ( long ) xNumOfOverflows );
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+static int prvBench( int iTaskCount,
+                     long lTicks )
+{
+    double dStart, dInitialInsert, dTickTime = 0, dInsertTime = 0;
+    long lTick, lInserts = 0;
+    int i;
+
+    xNextTaskUnblockTime = portMAX_DELAY;
+
+    dStart = prvNanoseconds();
+
+    for( i = 0; i < iTaskCount; i++ )
+    {
+        prvBlock( i, 1U + ( prvRandom() % 2000U ) );
+    }
+
+    dInitialInsert = ( prvNanoseconds() - dStart ) / iTaskCount;
+
+    /* Steady state: each task that wakes blocks again with a delay drawn
+     * from the same range, so the number of blocked tasks stays the same. */
+    for( lTick = 0; lTick < lTicks; lTick++ )
+    {
+        dStart = prvNanoseconds();
+        ( void ) xTaskIncrementTick();
+        dTickTime += prvNanoseconds() - dStart;
+
+        for( i = 0; i < iTaskCount; i++ )
+        {
+            if( ( xBlocked[ i ] != pdFALSE ) && ( prvIsReady( i ) != pdFALSE ) )
+            {
+                xBlocked[ i ] = pdFALSE;
+                dStart = prvNanoseconds();
+                prvBlock( i, 1U + ( prvRandom() % 2000U ) );
+                dInsertTime += prvNanoseconds() - dStart;
+                lInserts++;
+            }
+        }
+    }
+
+    printf( "wheel=%d tasks=%4d: initial block %7.1f ns, steady block %7.1f ns, tick %7.1f ns\n", configUSE_DELAYED_TASK_WHEEL,
+            iTaskCount, dInitialInsert, dInsertTime / ( double ) lInserts, dTickTime / ( double ) lTicks );
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    int i, iTaskCount;
+
+    if( ( argc == 5 ) && ( strcmp( argv[ 1 ], "test" ) == 0 ) )
+    {
+        iTaskCount = atoi( argv[ 4 ] );
+    }
+    else if( ( argc == 4 ) && ( strcmp( argv[ 1 ], "bench" ) == 0 ) )
+    {
+        iTaskCount = atoi( argv[ 2 ] );
+    }
+    else
+    {
+        printf( "usage: %s test <start tick> <ticks> <tasks> | bench <tasks> <ticks>\n", argv[ 0 ] );
+        return 1;
+    }
+
+    if( ( iTaskCount < 1 ) || ( iTaskCount > testMAX_TASKS ) )
+    {
+        printf( "between 1 and %d tasks\n", testMAX_TASKS );
+        return 1;
+    }
+
+    for( i = 0; i < iTaskCount; i++ )
+    {
+        xTasks[ i ] = xTaskCreateStatic( prvTaskFunction, "T", testSTACK_SIZE, NULL, 1, uxTaskStacks[ i ], &( xTaskBuffers[ i ] ) );
+    }
+
+    if( strcmp( argv[ 1 ], "test" ) == 0 )
+    {
+        return prvTest( ( TickType_t ) strtoul( argv[ 2 ], NULL, 0 ), atol( argv[ 3 ] ), iTaskCount );
+    }
+
+    return prvBench( iTaskCount, atol( argv[ 3 ] ) );
+}
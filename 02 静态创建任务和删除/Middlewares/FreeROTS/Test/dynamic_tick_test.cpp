@@ -0,0 +1,351 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Runs a task set against the SysTick model in systick/ to check the dynamic
+ * tick (configUSE_DYNAMIC_TICK) against the periodic tick:
+ *
+ *   dynamic_tick_test <seconds> <slicing> [seed]
+ *
+ * The task set has two vTaskDelayUntil() tasks at the top priorities, a task
+ * that delays for random times, a task that an interrupt resumes at random
+ * times, and when <slicing> is 1 two busy tasks that share priority 1 so the
+ * tick has to time slice them.  A run fails if:
+ *
+ *   - a task wakes before the start of the tick it was delayed until;
+ *   - xTaskGetTickCount() is ever not the number of whole tick periods since
+ *     the SysTick started (or one less while the tick interrupt is pending);
+ *   - the tick count has drifted from that number by more than a tick at the
+ *     end of the run;
+ *   - the top priority task's wake times, measured from the start of the tick
+ *     it was delayed until, spread over more than a tenth of a tick period,
+ *     meaning vTaskDelayUntil() lost its phase.
+ *
+ * Each run prints the tick interrupt rate next to those figures, so the
+ * periodic and dynamic builds of run.sh can be compared.
+ */
+
+#include <vector>
+
+#include "systick_model.h"
+
+typedef enum
+{
+    eTaskDelayUntil,  /* Works, then blocks in vTaskDelayUntil(). */
+    eTaskDelay,       /* Works a random time, then delays a random time. */
+    eTaskSuspend,     /* Works, then suspends itself until an interrupt resumes it. */
+    eTaskBusy,        /* Works, and now and then delays. */
+    eTaskIdle         /* Only works. */
+} TaskKind_t;
+
+typedef struct
+{
+    TaskKind_t eKind;
+    UBaseType_t uxPriority;
+    TickType_t xPeriod;
+    uint64_t ullWork;
+    TaskHandle_t xHandle;
+    StaticTask_t xTCB;
+    StackType_t uxStack[ 64 ];
+
+    bool xStarted;
+    bool xBlocked;
+    uint64_t ullWorkLeft;     /* Cycles before the task next calls the kernel. */
+    TickType_t xLastWakeTime; /* For vTaskDelayUntil(). */
+    TickType_t xWakeTick;     /* The tick the task is blocked until. */
+    std::vector< int64_t > xPhases;
+} SimTask_t;
+
+static SimTask_t xTasks[ 8 ];
+static int iTasks = 0;
+
+static uint64_t ullRandomState = 88172645463325252ULL;
+
+static long lWakes = 0;
+static uint64_t ullMaxEarly = 0;
+static unsigned long ulTickChecks = 0, ulTickErrors = 0;
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    ullRandomState ^= ullRandomState << 13;
+    ullRandomState ^= ullRandomState >> 7;
+    ullRandomState ^= ullRandomState << 17;
+
+    return ( uint32_t ) ullRandomState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskFunction( void * pvParameters )
+{
+    ( void ) pvParameters;
+}
+/*-----------------------------------------------------------*/
+
+static SimTask_t * prvAddTask( TaskKind_t eKind,
+                               UBaseType_t uxPriority,
+                               TickType_t xPeriod,
+                               uint64_t ullWork )
+{
+    SimTask_t * pxTask = &xTasks[ iTasks++ ];
+
+    pxTask->eKind = eKind;
+    pxTask->uxPriority = uxPriority;
+    pxTask->xPeriod = xPeriod;
+    pxTask->ullWork = ullWork;
+    pxTask->xHandle = xTaskCreateStatic( prvTaskFunction, "sim", 64, NULL, uxPriority, pxTask->uxStack, &( pxTask->xTCB ) );
+
+    return pxTask;
+}
+/*-----------------------------------------------------------*/
+
+static SimTask_t * prvCurrentTask( void )
+{
+    void * pvCurrent = pvSimCurrentTask();
+
+    for( int i = 0; i < iTasks; i++ )
+    {
+        if( ( void * ) xTasks[ i ].xHandle == pvCurrent )
+        {
+            return &xTasks[ i ];
+        }
+    }
+
+    printf( "FAIL: the running task is not one of the test's\n" );
+    exit( 1 );
+}
+/*-----------------------------------------------------------*/
+
+/* Records the wake up of a task that was blocked until xWakeTick. */
+static void prvTaskWoken( SimTask_t * pxTask )
+{
+    uint64_t ullDue = ullSimTickBoundary( pxTask->xWakeTick );
+
+    pxTask->xBlocked = false;
+    lWakes++;
+
+    if( ullSimNow < ullDue )
+    {
+        ullMaxEarly = std::max( ullMaxEarly, ullDue - ullSimNow );
+    }
+    else if( pxTask->eKind == eTaskDelayUntil )
+    {
+        pxTask->xPhases.push_back( ( int64_t ) ( ullSimNow - ullDue ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Checks the kernel's tick count against the time since the SysTick started. */
+static void prvCheckTickCount( void )
+{
+    TickType_t xKernel = xTaskGetTickCount();
+    uint64_t ullIdeal = ullSimIdealTickCount();
+
+    ulTickChecks++;
+
+    if( ( xKernel != ullIdeal ) && ( ( xKernel + 1U != ullIdeal ) || !xSysTickPending ) )
+    {
+        if( ulTickErrors++ < 5 )
+        {
+            printf( "tick count %u at cycle %llu, expected %llu\n", ( unsigned ) xKernel, ( unsigned long long ) ullSimNow, ( unsigned long long ) ullIdeal );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Called when the running task has finished its work, to make its next
+ * kernel call. */
+static void prvTaskStep( SimTask_t * pxTask )
+{
+    TickType_t xDelay;
+
+    prvCheckTickCount();
+
+    switch( pxTask->eKind )
+    {
+        case eTaskDelayUntil:
+
+            if( !pxTask->xStarted )
+            {
+                pxTask->xStarted = true;
+                pxTask->xLastWakeTime = xTaskGetTickCount();
+                pxTask->ullWorkLeft = pxTask->ullWork;
+                break;
+            }
+
+            pxTask->xWakeTick = pxTask->xLastWakeTime + pxTask->xPeriod;
+            pxTask->xBlocked = true;
+            pxTask->ullWorkLeft = pxTask->ullWork;
+            ( void ) xTaskDelayUntil( &( pxTask->xLastWakeTime ), pxTask->xPeriod );
+            break;
+
+        case eTaskDelay:
+            xDelay = 1 + prvRandom() % 40;
+            pxTask->xWakeTick = xTaskGetTickCount() + xDelay;
+            pxTask->xBlocked = true;
+            pxTask->ullWorkLeft = prvRandom() % pxTask->ullWork;
+            vTaskDelay( xDelay );
+            break;
+
+        case eTaskSuspend:
+            pxTask->ullWorkLeft = pxTask->ullWork;
+            vTaskSuspend( NULL );
+            break;
+
+        case eTaskBusy:
+
+            if( prvRandom() % 4 == 0 )
+            {
+                xDelay = 1 + prvRandom() % 30;
+                pxTask->xWakeTick = xTaskGetTickCount() + xDelay;
+                pxTask->xBlocked = true;
+                pxTask->ullWorkLeft = prvRandom() % pxTask->ullWork;
+                vTaskDelay( xDelay );
+            }
+            else
+            {
+                pxTask->ullWorkLeft = pxTask->ullWork;
+            }
+
+            break;
+
+        case eTaskIdle:
+            pxTask->ullWorkLeft = pxTask->ullWork;
+            break;
+    }
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    double dSeconds;
+    int iSlicing;
+    uint64_t ullEnd, ullNextResume = 100000;
+    SimTask_t * pxTop, * pxSuspending, * pxTask;
+    int64_t llMinPhase = INT64_MAX, llMaxPhase = INT64_MIN, llDrift;
+    int iResult = 0;
+
+    if( argc < 3 )
+    {
+        printf( "usage: %s <seconds> <slicing> [seed]\n", argv[ 0 ] );
+        return 1;
+    }
+
+    dSeconds = atof( argv[ 1 ] );
+    iSlicing = atoi( argv[ 2 ] );
+
+    if( argc > 3 )
+    {
+        ullRandomState = strtoull( argv[ 3 ], NULL, 0 );
+    }
+
+    pxTop = prvAddTask( eTaskDelayUntil, 4, 7, 3000 );
+    ( void ) prvAddTask( eTaskDelayUntil, 3, 10, 50000 );
+    ( void ) prvAddTask( eTaskDelay, 2, 0, 200000 );
+
+    if( iSlicing != 0 )
+    {
+        ( void ) prvAddTask( eTaskBusy, 1, 0, 300000 );
+        ( void ) prvAddTask( eTaskBusy, 1, 0, 250000 );
+    }
+
+    pxSuspending = prvAddTask( eTaskSuspend, 1, 0, 20000 );
+    ( void ) prvAddTask( eTaskIdle, 0, 0, 1000000 );
+
+    vSimStart();
+    ullEnd = ( uint64_t ) ( dSeconds * configCPU_CLOCK_HZ );
+
+    while( ullSimNow < ullEnd )
+    {
+        if( eSimTakeInterrupt() != eSimNoInterrupt )
+        {
+            continue;
+        }
+
+        /* An interrupt that resumes the suspending task. */
+        if( ullSimNow >= ullNextResume )
+        {
+            vSimInterruptEntry();
+            portYIELD_FROM_ISR( xTaskResumeFromISR( pxSuspending->xHandle ) );
+            ullNextResume = ullSimNow + 20000 + prvRandom() % 3000000;
+            continue;
+        }
+
+        pxTask = prvCurrentTask();
+
+        if( pxTask->xBlocked )
+        {
+            prvTaskWoken( pxTask );
+        }
+
+        if( pxTask->ullWorkLeft != 0 )
+        {
+            pxTask->ullWorkLeft -= ullSimAdvance( std::min( pxTask->ullWorkLeft, ullNextResume - ullSimNow ) );
+        }
+
+        if( pxTask->ullWorkLeft == 0 )
+        {
+            prvTaskStep( pxTask );
+        }
+    }
+
+    for( int64_t llPhase : pxTop->xPhases )
+    {
+        llMinPhase = std::min( llMinPhase, llPhase );
+        llMaxPhase = std::max( llMaxPhase, llPhase );
+    }
+
+    llDrift = ( int64_t ) ullSimIdealTickCount() - ( int64_t ) xTaskGetTickCount();
+
+    printf( "dynamic=%d slicing=%d: %.1f tick interrupts/s, %.1f switches/s, %ld wakes, early %llu cycles, tick errors %lu/%lu, drift %lld ticks, phase %lld..%lld cycles over %zu periods\n",
+            configUSE_DYNAMIC_TICK, iSlicing, ulSimTickInterrupts / dSeconds, ulSimContextSwitches / dSeconds, lWakes,
+            ( unsigned long long ) ullMaxEarly, ulTickErrors, ulTickChecks, ( long long ) llDrift,
+            ( long long ) llMinPhase, ( long long ) llMaxPhase, pxTop->xPhases.size() );
+
+    if( ullMaxEarly != 0 )
+    {
+        printf( "FAIL: a task woke before its tick\n" );
+        iResult = 1;
+    }
+
+    if( ulTickErrors != 0 )
+    {
+        printf( "FAIL: xTaskGetTickCount() did not follow the SysTick\n" );
+        iResult = 1;
+    }
+
+    if( ( llDrift > 1 ) || ( llDrift < -1 ) )
+    {
+        printf( "FAIL: the tick count drifted\n" );
+        iResult = 1;
+    }
+
+    if( pxTop->xPhases.empty() || ( ( uint64_t ) ( llMaxPhase - llMinPhase ) > ullSimCyclesPerTick / 10U ) )
+    {
+        printf( "FAIL: vTaskDelayUntil() did not keep its phase\n" );
+        iResult = 1;
+    }
+
+    return iResult;
+}
@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Runs a random periodic task set against the SysTick model in systick/ to
+ * check deadline scheduling (configUSE_EDF_SCHEDULING):
+ *
+ *   edf_test <utilisation> <tasks> <seconds> <seed> [overheads]
+ *
+ * The task set has <tasks> tasks with periods of 2 to 50 ticks and
+ * utilisations drawn with UUniFast to add up to <utilisation>.  Every task
+ * works for its share of each period and then calls xTaskDelayUntil(), and a
+ * release that has not completed by the start of the next one misses its
+ * deadline.  When configUSE_EDF_SCHEDULING is 1 the tasks are created with
+ * xTaskCreateStaticWithDeadline(), and otherwise at rate monotonic
+ * priorities, for comparison.  With [overheads] 1 the model charges the
+ * interrupt and context switch cycles of the core, and with 0 it does not.
+ *
+ * A deadline scheduled run fails if the kernel's miss count differs from the
+ * misses the test saw, or if any deadline is missed at a utilisation of at
+ * most 1 without overheads, where deadline scheduling meets every deadline.
+ * A rate monotonic run is only reported.
+ */
+
+#include <cmath>
+#include <vector>
+
+#include "systick_model.h"
+
+typedef struct
+{
+    TaskHandle_t xHandle;
+    StaticTask_t xTCB;
+    StackType_t uxStack[ 64 ];
+    TickType_t xPeriod;
+    uint64_t ullWork;
+
+    bool xStarted;
+    uint64_t ullWorkLeft;     /* Cycles left in the current release. */
+    TickType_t xLastWakeTime; /* For vTaskDelayUntil(). */
+    long lReleases;
+    long lMisses;
+} SimTask_t;
+
+static SimTask_t xTasks[ configMAX_PRIORITIES ];
+static int iTasks = 0;
+
+static uint64_t ullRandomState = 88172645463325252ULL;
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    ullRandomState ^= ullRandomState << 13;
+    ullRandomState ^= ullRandomState >> 7;
+    ullRandomState ^= ullRandomState << 17;
+
+    return ( uint32_t ) ullRandomState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskFunction( void * pvParameters )
+{
+    ( void ) pvParameters;
+}
+/*-----------------------------------------------------------*/
+
+static SimTask_t * prvCurrentTask( void )
+{
+    void * pvCurrent = pvSimCurrentTask();
+
+    for( int i = 0; i < iTasks; i++ )
+    {
+        if( ( void * ) xTasks[ i ].xHandle == pvCurrent )
+        {
+            return &xTasks[ i ];
+        }
+    }
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+/* Called when the running task has finished the work of a release. */
+static void prvTaskStep( SimTask_t * pxTask )
+{
+    if( !pxTask->xStarted )
+    {
+        /* Every task was released at tick 0. */
+        pxTask->xStarted = true;
+        pxTask->xLastWakeTime = 0;
+        pxTask->ullWorkLeft = pxTask->ullWork;
+        return;
+    }
+
+    pxTask->lReleases++;
+
+    if( ullSimNow > ullSimTickBoundary( pxTask->xLastWakeTime + pxTask->xPeriod ) )
+    {
+        pxTask->lMisses++;
+    }
+
+    ( void ) xTaskDelayUntil( &( pxTask->xLastWakeTime ), pxTask->xPeriod );
+    pxTask->ullWorkLeft = pxTask->ullWork;
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    double dUtilisation, dSum, dNext, dActual = 0;
+    int iCount, iOverheads = 0;
+    double dSeconds;
+    uint64_t ullEnd, ullUsed;
+    std::vector< double > xUtilisations;
+    std::vector< TickType_t > xPeriods;
+    std::vector< int > xOrder;
+    static StaticTask_t xIdleTCB;
+    static StackType_t uxIdleStack[ 64 ];
+    TaskHandle_t xIdle;
+    SimTask_t * pxTask;
+    long lReleases = 0, lMisses = 0, lKernelMisses = 0;
+    int iResult = 0;
+
+    if( argc < 5 )
+    {
+        printf( "usage: %s <utilisation> <tasks> <seconds> <seed> [overheads]\n", argv[ 0 ] );
+        return 1;
+    }
+
+    dUtilisation = atof( argv[ 1 ] );
+    iCount = atoi( argv[ 2 ] );
+    dSeconds = atof( argv[ 3 ] );
+    ullRandomState = strtoull( argv[ 4 ], NULL, 0 );
+
+    if( argc > 5 )
+    {
+        iOverheads = atoi( argv[ 5 ] );
+    }
+
+    if( ( iCount < 1 ) || ( iCount > configMAX_PRIORITIES - 2 ) )
+    {
+        printf( "between 1 and %d tasks\n", configMAX_PRIORITIES - 2 );
+        return 1;
+    }
+
+    if( iOverheads == 0 )
+    {
+        xSimCosts.ullTimerStopped = 0;
+        xSimCosts.ullTickInterrupt = 0;
+        xSimCosts.ullContextSwitch = 0;
+        xSimCosts.ullInterruptEntry = 0;
+    }
+
+    /* UUniFast utilisations, and periods of 2 to 50 ticks. */
+    xUtilisations.resize( iCount );
+    xPeriods.resize( iCount );
+    dSum = dUtilisation;
+
+    for( int i = 0; i < iCount - 1; i++ )
+    {
+        dNext = dSum * pow( prvRandom() / 4294967296.0, 1.0 / ( iCount - 1 - i ) );
+        xUtilisations[ i ] = dSum - dNext;
+        dSum = dNext;
+    }
+
+    xUtilisations[ iCount - 1 ] = dSum;
+
+    for( int i = 0; i < iCount; i++ )
+    {
+        xPeriods[ i ] = 2 + prvRandom() % 49;
+        xOrder.push_back( i );
+    }
+
+    /* Longest period first, so the rate monotonic priority is 1 + the
+     * position in xOrder. */
+    std::sort( xOrder.begin(), xOrder.end(), [ & ]( int a, int b ) { return xPeriods[ a ] > xPeriods[ b ]; } );
+
+    for( int iRank = 0; iRank < iCount; iRank++ )
+    {
+        int i = xOrder[ iRank ];
+
+        pxTask = &xTasks[ iTasks++ ];
+        pxTask->xPeriod = xPeriods[ i ];
+        pxTask->ullWork = std::max< uint64_t >( 1, ( uint64_t ) ( xUtilisations[ i ] * xPeriods[ i ] * ullSimCyclesPerTick ) );
+        dActual += ( double ) pxTask->ullWork / ( double ) ( pxTask->xPeriod * ullSimCyclesPerTick );
+
+        #if ( configUSE_EDF_SCHEDULING == 1 )
+            pxTask->xHandle = xTaskCreateStaticWithDeadline( prvTaskFunction, "edf", 64, NULL, pxTask->xPeriod, pxTask->uxStack, &( pxTask->xTCB ) );
+        #else
+            pxTask->xHandle = xTaskCreateStatic( prvTaskFunction, "rm", 64, NULL, 1 + iRank, pxTask->uxStack, &( pxTask->xTCB ) );
+        #endif
+    }
+
+    xIdle = xTaskCreateStatic( prvTaskFunction, "idle", 64, NULL, 0, uxIdleStack, &xIdleTCB );
+
+    vSimStart();
+    ullEnd = ( uint64_t ) ( dSeconds * configCPU_CLOCK_HZ );
+
+    while( ullSimNow < ullEnd )
+    {
+        if( eSimTakeInterrupt() != eSimNoInterrupt )
+        {
+            continue;
+        }
+
+        if( pvSimCurrentTask() == ( void * ) xIdle )
+        {
+            ( void ) ullSimAdvance( std::min< uint64_t >( ullEnd - ullSimNow, 1000 ) );
+            continue;
+        }
+
+        pxTask = prvCurrentTask();
+
+        if( pxTask->ullWorkLeft != 0 )
+        {
+            ullUsed = ullSimAdvance( pxTask->ullWorkLeft );
+            pxTask->ullWorkLeft -= ullUsed;
+        }
+
+        if( pxTask->ullWorkLeft == 0 )
+        {
+            prvTaskStep( pxTask );
+        }
+    }
+
+    for( int i = 0; i < iTasks; i++ )
+    {
+        lReleases += xTasks[ i ].lReleases;
+        lMisses += xTasks[ i ].lMisses;
+
+        #if ( configUSE_EDF_SCHEDULING == 1 )
+            lKernelMisses += ( long ) uxTaskGetDeadlineMissCount( xTasks[ i ].xHandle );
+        #endif
+    }
+
+    printf( "%s utilisation=%.3f tasks=%d overheads=%d: %ld releases, %ld misses",
+            ( configUSE_EDF_SCHEDULING == 1 ) ? "EDF" : "RM ", dActual, iCount, iOverheads, lReleases, lMisses );
+
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+        printf( ", kernel counted %ld\n", lKernelMisses );
+
+        if( lKernelMisses != lMisses )
+        {
+            printf( "FAIL: uxTaskGetDeadlineMissCount() disagrees with the misses seen\n" );
+            iResult = 1;
+        }
+
+        if( ( iOverheads == 0 ) && ( dActual <= 1.0 ) && ( lMisses != 0 ) )
+        {
+            printf( "FAIL: a deadline was missed at a utilisation of at most 1\n" );
+            iResult = 1;
+        }
+    #else
+        printf( "\n" );
+        ( void ) lKernelMisses;
+    #endif
+
+    return iResult;
+}
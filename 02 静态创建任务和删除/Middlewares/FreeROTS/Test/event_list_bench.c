@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Benchmark of blocking on and waking from an event list, with the single
+ * priority ordered list or the per priority lists
+ * (configUSE_PRIORITY_EVENT_LISTS).
+ *
+ *   event_list_bench
+ *
+ * For 1 to 64 waiters, blocks every waiter on one event list with
+ * vTaskPlaceOnEventList() and then wakes them all with
+ * xTaskRemoveFromEventList(), as a queue or semaphore does, and prints the
+ * host time per waiter of each.  The waiters all have the same priority, have
+ * mixed priorities, or block in order of descending priority, which is the
+ * worst case of the ordered list as each one walks past all the others.
+ *
+ * The scheduler is not started.  The benchmark includes tasks.c so it can
+ * block any task by making it the current task.
+ */
+
+#include <stdio.h>
+#include <time.h>
+
+#include "tasks.c"
+
+#define benchMAX_WAITERS     64
+#define benchSTACK_SIZE      64
+#define benchBLOCKS          2000000
+#define benchORDERS          3
+
+static StaticTask_t xTaskBuffers[ benchORDERS ][ benchMAX_WAITERS ];
+static StackType_t uxTaskStacks[ benchORDERS ][ benchMAX_WAITERS ][ benchSTACK_SIZE ];
+static TaskHandle_t xTasks[ benchORDERS ][ benchMAX_WAITERS ];
+static EventList_t xWaitList;
+/*-----------------------------------------------------------*/
+
+static double prvNanoseconds( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( double ) xNow.tv_sec * 1e9 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskFunction( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvWaiterPriority( int iOrder,
+                                      int iWaiter )
+{
+    switch( iOrder )
+    {
+        case 0:
+            return 5;
+
+        case 1:
+            return 1 + ( ( iWaiter * 7 ) % 30 );
+
+        default:
+            return 30 - ( iWaiter % 30 );
+    }
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+    static const char * const pcOrders[ benchORDERS ] = { "same priority", "mixed priority", "descending" };
+    static const int iWaiterCounts[] = { 1, 2, 4, 8, 16, 32, 64 };
+    double dOverhead = 0, dStart, dPlaced, dPlaceTime, dWakeTime;
+    long lRound, lRounds;
+    int iOrder, iCount, iWaiters, i;
+
+    /* The cost of reading the clock, taken off each measurement. */
+    for( i = 0; i < 1000000; i++ )
+    {
+        dStart = prvNanoseconds();
+        dOverhead += prvNanoseconds() - dStart;
+    }
+
+    dOverhead /= 1000000.0;
+
+    taskEVENT_LIST_INITIALISE( &xWaitList );
+
+    for( iOrder = 0; iOrder < benchORDERS; iOrder++ )
+    {
+        for( i = 0; i < benchMAX_WAITERS; i++ )
+        {
+            xTasks[ iOrder ][ i ] = xTaskCreateStatic( prvTaskFunction, "W", benchSTACK_SIZE, NULL, prvWaiterPriority( iOrder, i ),
+                                                       uxTaskStacks[ iOrder ][ i ], &( xTaskBuffers[ iOrder ][ i ] ) );
+        }
+
+        for( iCount = 0; iCount < ( int ) ( sizeof( iWaiterCounts ) / sizeof( iWaiterCounts[ 0 ] ) ); iCount++ )
+        {
+            iWaiters = iWaiterCounts[ iCount ];
+            lRounds = benchBLOCKS / iWaiters;
+            dPlaceTime = 0;
+            dWakeTime = 0;
+
+            for( lRound = 0; lRound < lRounds; lRound++ )
+            {
+                dStart = prvNanoseconds();
+
+                for( i = 0; i < iWaiters; i++ )
+                {
+                    pxCurrentTCB = xTasks[ iOrder ][ i ];
+                    vTaskPlaceOnEventList( &xWaitList, portMAX_DELAY );
+                }
+
+                dPlaced = prvNanoseconds();
+
+                for( i = 0; i < iWaiters; i++ )
+                {
+                    ( void ) xTaskRemoveFromEventList( &xWaitList );
+                }
+
+                dWakeTime += prvNanoseconds() - dPlaced;
+                dPlaceTime += dPlaced - dStart;
+            }
+
+            printf( "priority event lists=%d %-14s waiters=%2d: block %6.1f ns, wake %6.1f ns\n", configUSE_PRIORITY_EVENT_LISTS, pcOrders[ iOrder ], iWaiters,
+                    ( ( dPlaceTime / ( double ) lRounds ) - dOverhead ) / iWaiters, ( ( dWakeTime / ( double ) lRounds ) - dOverhead ) / iWaiters );
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,561 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*-----------------------------------------------------------
+* Host simulation port.  Every task runs on its own ucontext on one host
+* thread and time is simulated, see sim.h.
+*----------------------------------------------------------*/
+
+#define _GNU_SOURCE
+#include <ucontext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "sim.h"
+
+/* The host stack given to each task.  Task stacks passed to the kernel only
+ * hold the pointer to the task's context, at the top, so tasks created on the
+ * same stack with xTaskCreateStaticSharedStack() overwrite each other's
+ * pointer as they would overwrite each other's context on the target. */
+#define portHOST_STACK_SIZE    ( 64U * 1024U )
+
+typedef struct HostTaskContext
+{
+    ucontext_t xContext;
+    TaskFunction_t pxCode;
+    void * pvParameters;
+    StackType_t * pxSlot;              /* Where the pointer to the context is kept, or NULL once another context was built there. */
+    void * pvOwnerTCB;                 /* The task that first ran on the context. */
+    struct HostTaskContext * pxNext;   /* The next context built. */
+} HostTaskContext_t;
+
+/* The first member of a TCB is its top of stack pointer. */
+extern void * volatile pxCurrentTCB;
+
+uint64_t ullSimTime = 0;
+
+static uint64_t ullEndTime = UINT64_MAX;
+static int ( * pxEndHook )( void ) = NULL;
+static ucontext_t xMainContext;
+static HostTaskContext_t * pxContexts = NULL;
+static HostTaskContext_t * pxRunningContext = NULL;
+static UBaseType_t uxCriticalNesting = 0;
+static UBaseType_t uxInterruptMask = 0;
+static BaseType_t xInsideInterrupt = pdFALSE;
+static BaseType_t xYieldPending = pdFALSE;
+static unsigned long ulMaskedSections = 0;
+static BaseType_t xTimeMaskedSections = pdFALSE;
+static uint64_t ullMaskedSince = 0, ullLongestMasked = 0;
+
+static void prvTaskEntry( unsigned int uiHigh,
+                          unsigned int uiLow );
+static HostTaskContext_t * prvGetContext( void * pvTCB );
+static HostTaskContext_t * prvGetOwnContext( void * pvTCB );
+static void prvSwitchContext( void );
+static void prvTickInterrupt( void );
+static void prvInterruptsMasked( void );
+static void prvInterruptsUnmasked( void );
+/*-----------------------------------------------------------*/
+
+#if ( portHAS_NATIVE_ATOMICS == 1 )
+
+/* Stand-ins for the armcc exclusive access intrinsics used by the Cortex-M3
+ * portatomic.h.  Each host thread has its own monitor.  A store fails if the
+ * monitor was cleared, as an exception entry or return clears it on the
+ * core, or if the word changed since the load, and also fails at random so
+ * the retry loops run. */
+    static __thread volatile uint32_t * pulExclusiveAddress = NULL;
+    static __thread uint32_t ulExclusiveValue;
+    static __thread uint32_t ulExclusiveRandom = 0;
+
+    uint32_t __ldrex( volatile uint32_t * pulAddress )
+    {
+        pulExclusiveAddress = pulAddress;
+        ulExclusiveValue = __atomic_load_n( pulAddress, __ATOMIC_SEQ_CST );
+
+        return ulExclusiveValue;
+    }
+
+    uint32_t __strex( uint32_t ulValue,
+                      volatile uint32_t * pulAddress )
+    {
+        uint32_t ulExpected = ulExclusiveValue;
+        BaseType_t xHeld = ( pulExclusiveAddress == pulAddress ) ? pdTRUE : pdFALSE;
+
+        pulExclusiveAddress = NULL;
+
+        if( ulExclusiveRandom == 0U )
+        {
+            ulExclusiveRandom = ( uint32_t ) ( uintptr_t ) &ulExclusiveRandom | 1U;
+        }
+
+        ulExclusiveRandom ^= ulExclusiveRandom << 13;
+        ulExclusiveRandom ^= ulExclusiveRandom >> 17;
+        ulExclusiveRandom ^= ulExclusiveRandom << 5;
+
+        if( ( xHeld == pdFALSE ) || ( ( ulExclusiveRandom & 7U ) == 0U ) ||
+            ( __atomic_compare_exchange_n( pulAddress, &ulExpected, ulValue, pdFALSE, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST ) == 0 ) )
+        {
+            return 1U;
+        }
+
+        return 0U;
+    }
+
+    void __clrex( void )
+    {
+        pulExclusiveAddress = NULL;
+    }
+
+    #define prvClearExclusive()    __clrex()
+
+#else /* portHAS_NATIVE_ATOMICS */
+
+    #define prvClearExclusive()
+
+#endif /* portHAS_NATIVE_ATOMICS */
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char * pcFile,
+                    int iLine )
+{
+    printf( "ASSERT %s:%d at tick %lu\n", pcFile, iLine, ( unsigned long ) ( ullSimTime / simCYCLES_PER_TICK ) );
+    fflush( stdout );
+    exit( 2 );
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    return malloc( xWantedSize );
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    free( pv );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskEntry( unsigned int uiHigh,
+                          unsigned int uiLow )
+{
+    HostTaskContext_t * pxContext = ( HostTaskContext_t * ) ( ( ( uintptr_t ) uiHigh << 32 ) | ( uintptr_t ) uiLow );
+
+    pxContext->pxCode( pxContext->pvParameters );
+
+    /* Tasks must not return. */
+    printf( "task returned\n" );
+    exit( 5 );
+}
+/*-----------------------------------------------------------*/
+
+StackType_t * pxPortInitialiseStack( StackType_t * pxTopOfStack,
+                                     TaskFunction_t pxCode,
+                                     void * pvParameters )
+{
+    HostTaskContext_t * pxContext = NULL;
+    HostTaskContext_t * pxOther;
+    void * pvHostStack;
+
+    pxTopOfStack -= sizeof( HostTaskContext_t * ) / sizeof( StackType_t );
+
+    /* A context built on the same stack before belongs to a task that was
+     * deleted or, on a shared stack, to a task that had finished its job, so
+     * it is never resumed and can be used again once nothing runs on it. */
+    for( pxOther = pxContexts; pxOther != NULL; pxOther = pxOther->pxNext )
+    {
+        if( pxOther->pxSlot == pxTopOfStack )
+        {
+            pxOther->pxSlot = NULL;
+        }
+
+        if( ( pxContext == NULL ) && ( pxOther->pxSlot == NULL ) && ( pxOther != pxRunningContext ) )
+        {
+            pxContext = pxOther;
+        }
+    }
+
+    if( pxContext == NULL )
+    {
+        pxContext = calloc( 1, sizeof( HostTaskContext_t ) );
+        configASSERT( pxContext != NULL );
+        pxContext->xContext.uc_stack.ss_sp = malloc( portHOST_STACK_SIZE );
+        configASSERT( pxContext->xContext.uc_stack.ss_sp != NULL );
+        pxContext->pxNext = pxContexts;
+        pxContexts = pxContext;
+    }
+
+    pxContext->pxCode = pxCode;
+    pxContext->pvParameters = pvParameters;
+    pxContext->pxSlot = pxTopOfStack;
+    pxContext->pvOwnerTCB = NULL;
+    pvHostStack = pxContext->xContext.uc_stack.ss_sp;
+    ( void ) getcontext( &( pxContext->xContext ) );
+    pxContext->xContext.uc_stack.ss_size = portHOST_STACK_SIZE;
+    pxContext->xContext.uc_stack.ss_sp = pvHostStack;
+    pxContext->xContext.uc_link = NULL;
+    makecontext( &( pxContext->xContext ), ( void ( * )( void ) ) prvTaskEntry, 2,
+                 ( unsigned int ) ( ( uintptr_t ) pxContext >> 32 ), ( unsigned int ) ( uintptr_t ) pxContext );
+
+    memcpy( pxTopOfStack, &pxContext, sizeof( HostTaskContext_t * ) );
+
+    return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+static HostTaskContext_t * prvGetContext( void * pvTCB )
+{
+    HostTaskContext_t * pxContext;
+    StackType_t * pxTopOfStack = *( ( StackType_t ** ) pvTCB );
+
+    memcpy( &pxContext, pxTopOfStack, sizeof( HostTaskContext_t * ) );
+
+    return pxContext;
+}
+/*-----------------------------------------------------------*/
+
+static HostTaskContext_t * prvGetOwnContext( void * pvTCB )
+{
+    HostTaskContext_t * pxContext = prvGetContext( pvTCB );
+
+    /* A task must only ever resume its own context.  Another context on its
+     * stack means that a task sharing the stack started while this one was
+     * part way through a job. */
+    if( pxContext->pvOwnerTCB == NULL )
+    {
+        pxContext->pvOwnerTCB = pvTCB;
+    }
+
+    configASSERT( pxContext->pvOwnerTCB == pvTCB );
+
+    return pxContext;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchContext( void )
+{
+    void * pvOldTCB = pxCurrentTCB;
+
+    /* Taken before the switch, as a task starting on the same shared stack
+     * builds its context in the place of this one. */
+    HostTaskContext_t * pxOldContext = pxRunningContext;
+
+    vTaskSwitchContext();
+
+    if( pxCurrentTCB != pvOldTCB )
+    {
+        prvClearExclusive();
+        pxRunningContext = prvGetOwnContext( pxCurrentTCB );
+        ( void ) swapcontext( &( pxOldContext->xContext ), &( pxRunningContext->xContext ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+    /* As with PendSV, the switch is held off until interrupts are unmasked
+     * and any interrupt has returned. */
+    if( ( uxCriticalNesting != 0U ) || ( uxInterruptMask != 0U ) || ( xInsideInterrupt != pdFALSE ) )
+    {
+        xYieldPending = pdTRUE;
+    }
+    else
+    {
+        xYieldPending = pdFALSE;
+        prvSwitchContext();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvHostNanoseconds( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInterruptsMasked( void )
+{
+    ulMaskedSections++;
+
+    if( xTimeMaskedSections != pdFALSE )
+    {
+        ullMaskedSince = prvHostNanoseconds();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvInterruptsUnmasked( void )
+{
+    uint64_t ullMasked;
+
+    if( xTimeMaskedSections != pdFALSE )
+    {
+        ullMasked = prvHostNanoseconds() - ullMaskedSince;
+
+        if( ullMasked > ullLongestMasked )
+        {
+            ullLongestMasked = ullMasked;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vSimStartMaskedCount( BaseType_t xTime )
+{
+    ulMaskedSections = 0;
+    ullLongestMasked = 0;
+    xTimeMaskedSections = xTime;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulSimMaskedSections( void )
+{
+    return ulMaskedSections;
+}
+/*-----------------------------------------------------------*/
+
+uint64_t ullSimLongestMaskedNanoseconds( void )
+{
+    return ullLongestMasked;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+    if( ( uxCriticalNesting == 0U ) && ( uxInterruptMask == 0U ) )
+    {
+        prvInterruptsMasked();
+    }
+
+    uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+    configASSERT( uxCriticalNesting != 0U );
+    uxCriticalNesting--;
+
+    if( ( uxCriticalNesting == 0U ) && ( uxInterruptMask == 0U ) )
+    {
+        prvInterruptsUnmasked();
+    }
+
+    if( ( uxCriticalNesting == 0U ) && ( uxInterruptMask == 0U ) && ( xInsideInterrupt == pdFALSE ) && ( xYieldPending != pdFALSE ) )
+    {
+        xYieldPending = pdFALSE;
+        prvSwitchContext();
+    }
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPortRaiseBASEPRI( void )
+{
+    uint32_t ulOriginalMask = ( uint32_t ) uxInterruptMask;
+
+    if( ( uxCriticalNesting == 0U ) && ( uxInterruptMask == 0U ) )
+    {
+        prvInterruptsMasked();
+    }
+
+    uxInterruptMask = 1U;
+
+    return ulOriginalMask;
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetBASEPRI( uint32_t ulNewMaskValue )
+{
+    if( ( uxCriticalNesting == 0U ) && ( uxInterruptMask != 0U ) && ( ulNewMaskValue == 0U ) )
+    {
+        prvInterruptsUnmasked();
+    }
+
+    uxInterruptMask = ulNewMaskValue;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortIsInsideInterrupt( void )
+{
+    return xInsideInterrupt;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPortGetCycleCount( void )
+{
+    return ( uint32_t ) ullSimTime;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTickInterrupt( void )
+{
+    BaseType_t xSwitchRequired;
+
+    if( ullSimTime >= ullEndTime )
+    {
+        int iResult = 0;
+
+        if( pxEndHook != NULL )
+        {
+            iResult = pxEndHook();
+        }
+
+        fflush( stdout );
+        exit( iResult );
+    }
+
+    /* The tick interrupt masks interrupts while it runs, as the port's
+     * SysTick handler does. */
+    xInsideInterrupt = pdTRUE;
+    prvClearExclusive();
+    prvInterruptsMasked();
+    uxInterruptMask = 1U;
+    xSwitchRequired = xTaskIncrementTick();
+    uxInterruptMask = 0U;
+    prvInterruptsUnmasked();
+    xInsideInterrupt = pdFALSE;
+
+    if( ( xSwitchRequired != pdFALSE ) || ( xYieldPending != pdFALSE ) )
+    {
+        xYieldPending = pdFALSE;
+        prvSwitchContext();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vSimRun( uint64_t ullCycles )
+{
+    uint64_t ullNextTick;
+
+    /* Tasks only run with interrupts unmasked, so every tick boundary
+     * crossed is taken where it falls. */
+    configASSERT( ( uxCriticalNesting == 0U ) && ( uxInterruptMask == 0U ) );
+
+    for( ; ; )
+    {
+        ullNextTick = ( ( ullSimTime / simCYCLES_PER_TICK ) + 1U ) * simCYCLES_PER_TICK;
+
+        if( ( ullSimTime + ullCycles ) < ullNextTick )
+        {
+            ullSimTime += ullCycles;
+            break;
+        }
+
+        ullCycles -= ullNextTick - ullSimTime;
+        ullSimTime = ullNextTick;
+        prvTickInterrupt();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vSimSetEndTime( uint64_t ullNewEndTime,
+                     int ( * pxNewEndHook )( void ) )
+{
+    ullEndTime = ullNewEndTime;
+    pxEndHook = pxNewEndHook;
+}
+/*-----------------------------------------------------------*/
+
+void vSimEnterISR( void )
+{
+    xInsideInterrupt = pdTRUE;
+    prvClearExclusive();
+}
+/*-----------------------------------------------------------*/
+
+void vSimExitISR( BaseType_t xSwitchRequired )
+{
+    xInsideInterrupt = pdFALSE;
+
+    if( xSwitchRequired != pdFALSE )
+    {
+        vPortYield();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+    /* Nothing can run until the next tick, so move time on to it. */
+    vSimRun( ( ( ( ullSimTime / simCYCLES_PER_TICK ) + 1U ) * simCYCLES_PER_TICK ) - ullSimTime );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+    /* vTaskStartScheduler() masked interrupts, and creating tasks used
+     * critical sections.  As on the target, the first task starts with
+     * interrupts unmasked and no critical section held. */
+    uxCriticalNesting = 0;
+    uxInterruptMask = 0;
+
+    pxRunningContext = prvGetOwnContext( pxCurrentTCB );
+    ( void ) swapcontext( &xMainContext, &( pxRunningContext->xContext ) );
+
+    return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                    StackType_t ** ppxIdleTaskStackBuffer,
+                                    uint32_t * pulIdleTaskStackSize )
+{
+    static StaticTask_t xIdleTaskTCB;
+    static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+    *ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+    *ppxIdleTaskStackBuffer = uxIdleTaskStack;
+    *pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMERS == 1 )
+
+    void vApplicationGetTimerTaskMemory( StaticTask_t ** ppxTimerTaskTCBBuffer,
+                                         StackType_t ** ppxTimerTaskStackBuffer,
+                                         uint32_t * pulTimerTaskStackSize )
+    {
+        static StaticTask_t xTimerTaskTCB;
+        static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
+
+        *ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+        *ppxTimerTaskStackBuffer = uxTimerTaskStack;
+        *pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+    }
+
+#endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
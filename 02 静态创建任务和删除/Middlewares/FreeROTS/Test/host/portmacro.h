@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+/*-----------------------------------------------------------
+ * Port specific definitions for the host simulation port in port.c.
+ *
+ * Each task runs on its own ucontext on a single host thread, and time is
+ * simulated, so a critical section only needs to stop the simulated tick
+ * interrupt from being taken.
+ *-----------------------------------------------------------
+ */
+
+#include <stdint.h>
+#include <stdatomic.h>
+
+/* Type definitions. */
+#define portCHAR          char
+#define portFLOAT         float
+#define portDOUBLE        double
+#define portLONG          long
+#define portSHORT         short
+#define portSTACK_TYPE    uint32_t
+#define portBASE_TYPE     long
+
+typedef portSTACK_TYPE   StackType_t;
+typedef long             BaseType_t;
+typedef unsigned long    UBaseType_t;
+
+#if ( configUSE_16_BIT_TICKS == 1 )
+    typedef uint16_t     TickType_t;
+    #define portMAX_DELAY              ( TickType_t ) 0xffff
+#else
+    typedef uint32_t     TickType_t;
+    #define portMAX_DELAY              ( TickType_t ) 0xffffffffUL
+    #define portTICK_TYPE_IS_ATOMIC    1
+#endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH         ( -1 )
+#define portTICK_PERIOD_MS       ( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT       8
+#define portPOINTER_SIZE_TYPE    uintptr_t
+
+/* A C11 fence, so code that relies on portMEMORY_BARRIER() can also be run
+ * from several host threads. */
+#define portMEMORY_BARRIER()    atomic_thread_fence( memory_order_seq_cst )
+/*-----------------------------------------------------------*/
+
+/* Scheduler utilities. */
+extern void vPortYield( void );
+
+#define portYIELD()                                 vPortYield()
+#define portEND_SWITCHING_ISR( xSwitchRequired )    do { if( ( xSwitchRequired ) != pdFALSE ) { portYIELD(); } } while( 0 )
+#define portYIELD_FROM_ISR( x )                     portEND_SWITCHING_ISR( x )
+/*-----------------------------------------------------------*/
+
+/* Critical section management. */
+extern void vPortEnterCritical( void );
+extern void vPortExitCritical( void );
+extern uint32_t ulPortRaiseBASEPRI( void );
+extern void vPortSetBASEPRI( uint32_t ulNewMaskValue );
+extern BaseType_t xPortIsInsideInterrupt( void );
+
+#define portDISABLE_INTERRUPTS()                  ( void ) ulPortRaiseBASEPRI()
+#define portENABLE_INTERRUPTS()                   vPortSetBASEPRI( 0 )
+#define portENTER_CRITICAL()                      vPortEnterCritical()
+#define portEXIT_CRITICAL()                       vPortExitCritical()
+#define portSET_INTERRUPT_MASK_FROM_ISR()         ulPortRaiseBASEPRI()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR( x )    vPortSetBASEPRI( x )
+/*-----------------------------------------------------------*/
+
+/* Built with -DportHAS_NATIVE_ATOMICS=1, atomic.h uses the Cortex-M3
+ * portatomic.h of the RVDS port, and port.c stands in for the armcc
+ * intrinsics it uses. */
+#ifndef portHAS_NATIVE_ATOMICS
+    #define portHAS_NATIVE_ATOMICS    0
+#endif
+
+#if ( portHAS_NATIVE_ATOMICS == 1 )
+    extern uint32_t __ldrex( volatile uint32_t * pulAddress );
+    extern uint32_t __strex( uint32_t ulValue,
+                             volatile uint32_t * pulAddress );
+    extern void __clrex( void );
+#endif
+/*-----------------------------------------------------------*/
+
+/* The simulated CPU cycle counter, for task budgets and the cyclic executive. */
+extern uint32_t ulPortGetCycleCount( void );
+
+#define portGET_BUDGET_COUNTER_VALUE()    ulPortGetCycleCount()
+/*-----------------------------------------------------------*/
+
+/* Port optimised task selection, using the compiler's count leading zeros. */
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+    #define configUSE_PORT_OPTIMISED_TASK_SELECTION    1
+#endif
+
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+    #if ( configMAX_PRIORITIES > 1024 )
+        #error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 1024.
+    #endif
+
+/* The macros operate on a single 32-bit word.  When configMAX_PRIORITIES is
+ * above 32 the kernel uses them on each level of a two level bit map. */
+    #define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities )    ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+    #define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )     ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+    #define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )    uxTopPriority = ( 31UL - ( uint32_t ) __builtin_clz( ( uint32_t ) ( uxReadyPriorities ) ) )
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters )    void vFunction( void * pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters )          void vFunction( void * pvParameters )
+
+#define portNOP()
+#define portINLINE          inline
+#define portFORCE_INLINE    inline __attribute__( ( always_inline ) )
+
+#endif /* PORTMACRO_H */
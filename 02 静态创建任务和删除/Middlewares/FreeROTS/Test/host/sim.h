@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+/* Interface of the host simulation port in port.c.
+ *
+ * Time only advances when a task calls vSimRun() or when every task is
+ * blocked, in which case the idle hook moves time on to the next tick.  A
+ * tick interrupt is taken at every tick boundary that is crossed, unless
+ * interrupts are masked, so tasks are preempted exactly as they would be on
+ * the target.  Results therefore do not depend on the speed of the host. */
+
+#include <stdint.h>
+
+/* Simulated CPU cycles in one tick period. */
+#define simCYCLES_PER_TICK    ( ( uint64_t ) ( configCPU_CLOCK_HZ / configTICK_RATE_HZ ) )
+
+/* Converts seconds of simulated time to cycles. */
+#define simSECONDS( x )       ( ( uint64_t ) ( ( double ) ( x ) * ( double ) configCPU_CLOCK_HZ ) )
+
+/* The simulated time in CPU cycles since the scheduler started. */
+extern uint64_t ullSimTime;
+
+/* Runs the calling task for ullCycles CPU cycles, taking the tick interrupts
+ * that fall due in that time. */
+void vSimRun( uint64_t ullCycles );
+
+/* Ends the test at the first tick at or after ullEndTime.  pxEndHook, if not
+ * NULL, is called first and its return value is the exit code of the test. */
+void vSimSetEndTime( uint64_t ullEndTime,
+                     int ( * pxEndHook )( void ) );
+
+/* Bracket a call to a FromISR API function from a task, so the call is made
+ * as if from an interrupt.  vSimExitISR() does the context switch requested
+ * through xSwitchRequired, as portYIELD_FROM_ISR() would. */
+void vSimEnterISR( void );
+void vSimExitISR( BaseType_t xSwitchRequired );
+
+/* Starts counting the sections of code run with interrupts masked: critical
+ * sections, masks raised by FromISR functions and the tick interrupt.  If
+ * xTime is pdTRUE the longest section is also timed, in host nanoseconds. */
+void vSimStartMaskedCount( BaseType_t xTime );
+unsigned long ulSimMaskedSections( void );
+uint64_t ullSimLongestMaskedNanoseconds( void );
+
+#endif /* SIM_H */
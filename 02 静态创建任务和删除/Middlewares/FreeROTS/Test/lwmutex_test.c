@@ -0,0 +1,573 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test and benchmark of the lightweight mutexes and binary semaphores of
+ * lwmutex.c on the simulation port.
+ *
+ *   lwmutex_test test <seconds> <seed>
+ *       First checks that taking and giving a free mutex, and giving and
+ *       taking a semaphore no task waits for, only mask interrupts for the
+ *       compare-and-swap of the fast path.  Then six tasks at priorities 1
+ *       to 4 take two lightweight mutexes alone, nested, and inside an
+ *       ordinary mutex, with random timeouts, while a task and an interrupt
+ *       give a lightweight semaphore that the same tasks take.  No two tasks
+ *       may ever hold a mutex at once, a task holding mutexes that higher
+ *       priority tasks wait for must run at least at their priority, every
+ *       task must be back at its own priority once it holds no mutex, a take
+ *       that fails must have waited its whole timeout, giving a mutex the
+ *       caller does not hold must fail, and every semaphore give must be
+ *       matched by a take.  The tasks stop at the given time, after which
+ *       both mutexes must be free and the fast paths must be taken again.
+ *
+ *   lwmutex_test bench
+ *       Host nanoseconds per uncontended take and give of an ordinary and a
+ *       lightweight mutex, and per give and take of an ordinary and a
+ *       lightweight binary semaphore.
+ *
+ * The pointer functions of portatomic.h cast pointers to 32 bits, so unlike
+ * atomic_test.c this test is only built with the generic functions of
+ * atomic.h, under which each compare-and-swap masks interrupts once.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "lwmutex.h"
+#include "sim.h"
+
+#define testTASKS        6
+#define testFAST_CALLS   1000
+
+/* The bits of the waiting and held masks of each task. */
+#define testMUTEX_A      1U
+#define testMUTEX_B      2U
+#define testMUTEX_K      4U
+
+static LightweightMutex_t xMutexA, xMutexB;
+static SemaphoreHandle_t xMutexK;
+static LightweightSemaphore_t xSemaphore;
+static uint64_t ullStopTime;
+
+static TaskHandle_t xTasks[ testTASKS ];
+static UBaseType_t uxBasePriorities[ testTASKS ];
+static volatile uint32_t ulWaiting[ testTASKS ];
+static volatile uint32_t ulHeld[ testTASKS ];
+static volatile int iOwnerA = -1, iOwnerB = -1;
+static volatile BaseType_t xStopped = pdFALSE;
+
+static unsigned long ulTakes = 0, ulNested = 0, ulInsideK = 0, ulTimeouts = 0, ulInheritanceChecks = 0, ulRaisedChecks = 0;
+static unsigned long ulSemaphoreGives = 0, ulSemaphoreGivesFromISR = 0, ulSemaphoreGiveFails = 0, ulSemaphoreTakes = 0;
+static unsigned long ulErrors = 0;
+static uint64_t ullRandomState = 88172645463325252ULL;
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    ullRandomState ^= ullRandomState << 13;
+    ullRandomState ^= ullRandomState >> 7;
+    ullRandomState ^= ullRandomState << 17;
+
+    return ( uint32_t ) ullRandomState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvError( const char * pcMessage,
+                      int iTask )
+{
+    if( ulErrors++ < 5 )
+    {
+        printf( "FAIL: task %d: %s at tick %lu\n", iTask, pcMessage, ( unsigned long ) xTaskGetTickCount() );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* A task only runs while every task of higher priority is blocked, so any task
+ * of higher priority than this one that is waiting for a mutex this one holds
+ * must be blocked on it, and must have passed its priority on. */
+static void prvCheckInheritance( int iTask )
+{
+    UBaseType_t uxPriority = uxTaskPriorityGet( NULL );
+    int i;
+
+    for( i = 0; i < testTASKS; i++ )
+    {
+        if( ( ( ulWaiting[ i ] & ulHeld[ iTask ] ) != 0U ) && ( uxBasePriorities[ i ] > uxPriority ) )
+        {
+            prvError( "holds a mutex a higher priority task waits for without inheriting its priority", iTask );
+        }
+    }
+
+    if( uxPriority > uxBasePriorities[ iTask ] )
+    {
+        ulRaisedChecks++;
+    }
+
+    ulInheritanceChecks++;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTake( int iTask,
+                           uint32_t ulMutex,
+                           TickType_t xTicksToWait )
+{
+    TickType_t xStart = xTaskGetTickCount();
+    BaseType_t xReturn;
+
+    ulWaiting[ iTask ] = ulMutex;
+
+    if( ulMutex == testMUTEX_K )
+    {
+        xReturn = xSemaphoreTake( xMutexK, xTicksToWait );
+    }
+    else
+    {
+        xReturn = xLightweightMutexTake( ( ulMutex == testMUTEX_A ) ? &xMutexA : &xMutexB, xTicksToWait );
+    }
+
+    ulWaiting[ iTask ] = 0;
+
+    if( xReturn == pdPASS )
+    {
+        ulHeld[ iTask ] |= ulMutex;
+        ulTakes++;
+    }
+    else
+    {
+        if( ( xTaskGetTickCount() - xStart ) < xTicksToWait )
+        {
+            prvError( "take gave up before its timeout", iTask );
+        }
+
+        ulTimeouts++;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvGive( int iTask,
+                     uint32_t ulMutex )
+{
+    BaseType_t xReturn;
+
+    ulHeld[ iTask ] &= ~ulMutex;
+
+    if( ulMutex == testMUTEX_K )
+    {
+        xReturn = xSemaphoreGive( xMutexK );
+    }
+    else
+    {
+        xReturn = xLightweightMutexGive( ( ulMutex == testMUTEX_A ) ? &xMutexA : &xMutexB );
+    }
+
+    if( xReturn != pdPASS )
+    {
+        prvError( "could not give a mutex it held", iTask );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Works while holding the mutex that iOwner protects. */
+static void prvCriticalSection( int iTask,
+                                volatile int * piOwner )
+{
+    if( *piOwner != -1 )
+    {
+        prvError( "took a mutex another task held", iTask );
+    }
+
+    *piOwner = iTask;
+    vSimRun( prvRandom() % 40000U );
+    prvCheckInheritance( iTask );
+
+    if( *piOwner != iTask )
+    {
+        prvError( "another task took a mutex it held", iTask );
+    }
+
+    *piOwner = -1;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void * pvParameters )
+{
+    int iTask = ( int ) ( intptr_t ) pvParameters;
+    TickType_t xTicksToWait;
+
+    while( ullSimTime < ullStopTime )
+    {
+        xTicksToWait = ( ( prvRandom() % 4U ) == 0U ) ? 0U : ( TickType_t ) ( 1U + ( prvRandom() % 5U ) );
+
+        switch( prvRandom() % 5U )
+        {
+            case 0:
+
+                if( prvTake( iTask, testMUTEX_A, xTicksToWait ) == pdPASS )
+                {
+                    prvCriticalSection( iTask, &iOwnerA );
+                    prvGive( iTask, testMUTEX_A );
+                }
+
+                break;
+
+            case 1:
+
+                if( prvTake( iTask, testMUTEX_B, xTicksToWait ) == pdPASS )
+                {
+                    prvCriticalSection( iTask, &iOwnerB );
+                    prvGive( iTask, testMUTEX_B );
+                }
+
+                break;
+
+            case 2:
+
+                /* B inside A, always in that order so there is no deadlock. */
+                if( prvTake( iTask, testMUTEX_A, xTicksToWait ) == pdPASS )
+                {
+                    if( iOwnerA != -1 )
+                    {
+                        prvError( "took a mutex another task held", iTask );
+                    }
+
+                    iOwnerA = iTask;
+
+                    if( prvTake( iTask, testMUTEX_B, xTicksToWait ) == pdPASS )
+                    {
+                        prvCriticalSection( iTask, &iOwnerB );
+                        prvGive( iTask, testMUTEX_B );
+                        ulNested++;
+                    }
+
+                    vSimRun( prvRandom() % 5000U );
+                    prvCheckInheritance( iTask );
+                    iOwnerA = -1;
+                    prvGive( iTask, testMUTEX_A );
+                }
+
+                break;
+
+            case 3:
+
+                /* A inside an ordinary mutex, so the two kinds share the
+                 * count of mutexes held that decides when an inherited
+                 * priority is returned. */
+                if( prvTake( iTask, testMUTEX_K, xTicksToWait ) == pdPASS )
+                {
+                    if( prvTake( iTask, testMUTEX_A, xTicksToWait ) == pdPASS )
+                    {
+                        prvCriticalSection( iTask, &iOwnerA );
+                        prvGive( iTask, testMUTEX_A );
+                        ulInsideK++;
+                    }
+
+                    vSimRun( prvRandom() % 5000U );
+                    prvCheckInheritance( iTask );
+                    prvGive( iTask, testMUTEX_K );
+                }
+
+                break;
+
+            default:
+
+                if( xLightweightMutexGive( &xMutexA ) != pdFAIL )
+                {
+                    prvError( "gave a mutex it did not hold", iTask );
+                }
+
+                if( xLightweightSemaphoreTake( &xSemaphore, xTicksToWait ) == pdPASS )
+                {
+                    ulSemaphoreTakes++;
+                }
+
+                break;
+        }
+
+        if( uxTaskPriorityGet( NULL ) != uxBasePriorities[ iTask ] )
+        {
+            prvError( "kept a priority after giving every mutex", iTask );
+        }
+
+        vSimRun( prvRandom() % 20000U );
+    }
+
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+/* pxMutex must be free, and pxSemaphore empty, with no task waiting for
+ * either. */
+static void prvCheckFastPaths( LightweightMutex_t * pxMutex,
+                               LightweightSemaphore_t * pxSemaphore,
+                               const char * pcWhen )
+{
+    unsigned long ulMutexSections, ulSemaphoreSections;
+    int i;
+
+    vSimStartMaskedCount( pdFALSE );
+
+    for( i = 0; i < testFAST_CALLS; i++ )
+    {
+        if( ( xLightweightMutexTake( pxMutex, portMAX_DELAY ) != pdPASS ) || ( xLightweightMutexGive( pxMutex ) != pdPASS ) )
+        {
+            prvError( "could not take and give a free mutex", -1 );
+        }
+    }
+
+    ulMutexSections = ulSimMaskedSections();
+    vSimStartMaskedCount( pdFALSE );
+
+    for( i = 0; i < testFAST_CALLS; i++ )
+    {
+        if( ( xLightweightSemaphoreGive( pxSemaphore ) != pdPASS ) || ( xLightweightSemaphoreTake( pxSemaphore, portMAX_DELAY ) != pdPASS ) )
+        {
+            prvError( "could not give and take a semaphore", -1 );
+        }
+    }
+
+    ulSemaphoreSections = ulSimMaskedSections();
+
+    /* One compare-and-swap each for the take and the give. */
+    if( ( ulMutexSections != ( 2UL * testFAST_CALLS ) ) || ( ulSemaphoreSections != ( 2UL * testFAST_CALLS ) ) )
+    {
+        printf( "FAIL: %s, %lu and %lu masked sections for %d uncontended mutex and semaphore pairs\n", pcWhen, ulMutexSections, ulSemaphoreSections,
+                testFAST_CALLS );
+        ulErrors++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvGiverTask( void * pvParameters )
+{
+    BaseType_t xWoken, xReturn;
+    int i;
+
+    ( void ) pvParameters;
+
+    prvCheckFastPaths( &xMutexA, &xSemaphore, "before any task waited" );
+
+    while( ullSimTime < ullStopTime )
+    {
+        if( ( prvRandom() % 2U ) == 0U )
+        {
+            xWoken = pdFALSE;
+            vSimEnterISR();
+            xReturn = xLightweightSemaphoreGiveFromISR( &xSemaphore, &xWoken );
+            vSimExitISR( xWoken );
+            ulSemaphoreGivesFromISR += ( xReturn == pdPASS ) ? 1U : 0U;
+        }
+        else
+        {
+            xReturn = xLightweightSemaphoreGive( &xSemaphore );
+        }
+
+        if( xReturn == pdPASS )
+        {
+            ulSemaphoreGives++;
+        }
+        else
+        {
+            ulSemaphoreGiveFails++;
+        }
+
+        vSimRun( prvRandom() % 2000U );
+        vTaskDelay( prvRandom() % 2U );
+    }
+
+    /* Wait for the workers to time out of any take, then take the semaphore
+     * if it was left available, so that every give is matched by a take. */
+    vTaskDelay( 10 );
+
+    if( xLightweightSemaphoreTake( &xSemaphore, 0 ) == pdPASS )
+    {
+        ulSemaphoreTakes++;
+    }
+
+    if( ( xLightweightSemaphoreGive( &xSemaphore ) != pdPASS ) || ( xLightweightSemaphoreGive( &xSemaphore ) != pdFAIL ) )
+    {
+        prvError( "a binary semaphore was given twice", -1 );
+    }
+
+    for( i = 0; i < testTASKS; i++ )
+    {
+        if( uxTaskPriorityGet( xTasks[ i ] ) != uxBasePriorities[ i ] )
+        {
+            prvError( "left at a raised priority", i );
+        }
+    }
+
+    if( ( xLightweightMutexTake( &xMutexA, 0 ) != pdPASS ) || ( xLightweightMutexTake( &xMutexB, 0 ) != pdPASS ) ||
+        ( xLightweightMutexGive( &xMutexB ) != pdPASS ) || ( xLightweightMutexGive( &xMutexA ) != pdPASS ) )
+    {
+        prvError( "a mutex was left taken", -1 );
+    }
+
+    /* Once no task waits, the fast paths must be used again. */
+    ( void ) xLightweightSemaphoreTake( &xSemaphore, 0 );
+    prvCheckFastPaths( &xMutexA, &xSemaphore, "after tasks waited" );
+    prvCheckFastPaths( &xMutexB, &xSemaphore, "after tasks waited" );
+
+    xStopped = pdTRUE;
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static int prvTestEnd( void )
+{
+    if( xStopped == pdFALSE )
+    {
+        prvError( "the giver did not finish", -1 );
+    }
+
+    if( ulSemaphoreGives != ulSemaphoreTakes )
+    {
+        printf( "FAIL: the semaphore was given %lu times and taken %lu times\n", ulSemaphoreGives, ulSemaphoreTakes );
+        ulErrors++;
+    }
+
+    printf( "%lu mutex takes, %lu nested, %lu inside an ordinary mutex, %lu timeouts, %lu inheritance checks, %lu of them raised, "
+            "semaphore %lu gives, %lu from interrupts, %lu already given, %lu takes, %lu errors\n",
+            ulTakes, ulNested, ulInsideK, ulTimeouts, ulInheritanceChecks, ulRaisedChecks, ulSemaphoreGives, ulSemaphoreGivesFromISR,
+            ulSemaphoreGiveFails, ulSemaphoreTakes, ulErrors );
+
+    return ( ( ulErrors != 0U ) || ( ulRaisedChecks == 0U ) || ( ulSemaphoreTakes == 0U ) ) ? 1 : 0;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Benchmark.
+ */
+
+#define benchPAIRS    20000000L
+
+static double prvNanoseconds( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( double ) xNow.tv_sec * 1e9 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void * pvParameters )
+{
+    SemaphoreHandle_t xMutex = xSemaphoreCreateMutex(), xBinary = xSemaphoreCreateBinary();
+    LightweightMutex_t xLightweightMutex;
+    LightweightSemaphore_t xLightweightBinary;
+    double dTimes[ 5 ];
+    long l;
+
+    ( void ) pvParameters;
+
+    vLightweightMutexInitialise( &xLightweightMutex );
+    vLightweightSemaphoreInitialise( &xLightweightBinary );
+
+    dTimes[ 0 ] = prvNanoseconds();
+
+    for( l = 0; l < benchPAIRS; l++ )
+    {
+        ( void ) xSemaphoreTake( xMutex, 0 );
+        ( void ) xSemaphoreGive( xMutex );
+    }
+
+    dTimes[ 1 ] = prvNanoseconds();
+
+    for( l = 0; l < benchPAIRS; l++ )
+    {
+        ( void ) xLightweightMutexTake( &xLightweightMutex, 0 );
+        ( void ) xLightweightMutexGive( &xLightweightMutex );
+    }
+
+    dTimes[ 2 ] = prvNanoseconds();
+
+    for( l = 0; l < benchPAIRS; l++ )
+    {
+        ( void ) xSemaphoreGive( xBinary );
+        ( void ) xSemaphoreTake( xBinary, 0 );
+    }
+
+    dTimes[ 3 ] = prvNanoseconds();
+
+    for( l = 0; l < benchPAIRS; l++ )
+    {
+        ( void ) xLightweightSemaphoreGive( &xLightweightBinary );
+        ( void ) xLightweightSemaphoreTake( &xLightweightBinary, 0 );
+    }
+
+    dTimes[ 4 ] = prvNanoseconds();
+
+    printf( "mutex take and give:            ordinary %6.1f ns, lightweight %6.1f ns\n",
+            ( dTimes[ 1 ] - dTimes[ 0 ] ) / benchPAIRS, ( dTimes[ 2 ] - dTimes[ 1 ] ) / benchPAIRS );
+    printf( "binary semaphore give and take: ordinary %6.1f ns, lightweight %6.1f ns\n",
+            ( dTimes[ 3 ] - dTimes[ 2 ] ) / benchPAIRS, ( dTimes[ 4 ] - dTimes[ 3 ] ) / benchPAIRS );
+
+    exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    int i;
+
+    if( ( argc == 4 ) && ( strcmp( argv[ 1 ], "test" ) == 0 ) )
+    {
+        ullRandomState ^= strtoull( argv[ 3 ], NULL, 0 ) * 0x9E3779B97F4A7C15ULL;
+        ullStopTime = simSECONDS( atof( argv[ 2 ] ) );
+        vLightweightMutexInitialise( &xMutexA );
+        vLightweightMutexInitialise( &xMutexB );
+        vLightweightSemaphoreInitialise( &xSemaphore );
+        xMutexK = xSemaphoreCreateMutex();
+
+        for( i = 0; i < testTASKS; i++ )
+        {
+            uxBasePriorities[ i ] = ( UBaseType_t ) ( 1 + ( i % 4 ) );
+            ( void ) xTaskCreate( prvWorkerTask, "Worker", configMINIMAL_STACK_SIZE, ( void * ) ( intptr_t ) i, uxBasePriorities[ i ], &( xTasks[ i ] ) );
+        }
+
+        /* Above every worker, so it runs the fast path checks first. */
+        ( void ) xTaskCreate( prvGiverTask, "Giver", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+        vSimSetEndTime( ullStopTime + simSECONDS( 1 ), prvTestEnd );
+    }
+    else if( ( argc == 2 ) && ( strcmp( argv[ 1 ], "bench" ) == 0 ) )
+    {
+        ( void ) xTaskCreate( prvBenchTask, "Bench", configMINIMAL_STACK_SIZE, NULL, 1, NULL );
+    }
+    else
+    {
+        printf( "usage: %s test <seconds> <seed> | bench\n", argv[ 0 ] );
+        return 1;
+    }
+
+    vTaskStartScheduler();
+
+    return 1;
+}
@@ -0,0 +1,879 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test and benchmark of priority queues (configUSE_PRIORITY_QUEUES) on the
+ * simulation port.
+ *
+ *   priority_queue_test model <seed>
+ *       One task makes random sends, batch sends, receives, batch receives,
+ *       peeks and resets, from the task and as if from interrupts, on
+ *       priority queues of random lengths and item sizes, created statically
+ *       and dynamically.  Every result, item and count is checked against a
+ *       reference model: the highest priority item first, and items of the
+ *       same priority in the order they were sent.
+ *
+ *   priority_queue_test stress <seconds> <seed>
+ *       Three producer tasks at different priorities and a consumer task
+ *       share one short priority queue, blocking on it and also using it as
+ *       if from interrupts.  Each producer numbers its items at each
+ *       priority, so the consumer checks that no item is lost, duplicated or
+ *       reordered, and that no receive returns a lower priority item ahead of
+ *       a higher one that was already queued.  The producers stop at the given
+ *       time and the consumer then has a second to drain the queue, after
+ *       which every item sent must have been received.
+ *
+ *   priority_queue_test latency fifo|prio
+ *       Simulated send to receive latency of urgent messages, sent every 3 to
+ *       20 ticks, through a queue kept nearly full by telemetry that arrives
+ *       faster than the consumer handles it, with an ordinary queue or with
+ *       the urgent messages sent at a higher priority.
+ *
+ *   priority_queue_test bench
+ *       Host time of a send and a receive on an ordinary and on a priority
+ *       queue already holding 1 to 128 items.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "sim.h"
+
+static uint64_t ullRandomState = 88172645463325252ULL;
+static unsigned long ulErrors = 0;
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    ullRandomState ^= ullRandomState << 13;
+    ullRandomState ^= ullRandomState >> 7;
+    ullRandomState ^= ullRandomState << 17;
+
+    return ( uint32_t ) ullRandomState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSeed( const char * pcSeed )
+{
+    ullRandomState ^= strtoull( pcSeed, NULL, 0 ) * 0x9E3779B97F4A7C15ULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvError( const char * pcFormat,
+                      ... )
+{
+    va_list xArgs;
+
+    if( ulErrors++ < 10 )
+    {
+        va_start( xArgs, pcFormat );
+        vprintf( pcFormat, xArgs );
+        va_end( xArgs );
+        printf( "\n" );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Model test.
+ */
+
+#define modelMAX_LENGTH       24
+#define modelMAX_ITEM_SIZE    16
+#define modelROUNDS           400
+#define modelOPERATIONS       5000
+
+typedef struct
+{
+    uint32_t ulPriority;
+    uint32_t ulSequence;
+} ModelItem_t;
+
+static ModelItem_t xModel[ modelMAX_LENGTH ];
+static int iModelCount;
+static uint8_t ucStaticStorage[ 4096 ] __attribute__( ( aligned( 8 ) ) );
+/*-----------------------------------------------------------*/
+
+static void prvModelAdd( uint32_t ulPriority,
+                         uint32_t ulSequence )
+{
+    xModel[ iModelCount ].ulPriority = ulPriority;
+    xModel[ iModelCount ].ulSequence = ulSequence;
+    iModelCount++;
+}
+/*-----------------------------------------------------------*/
+
+/* The index of the item a receive should return.  Items are added in the
+ * order they were sent, so the first of the highest priority is the one. */
+static int prvModelNext( void )
+{
+    int i, iNext = 0;
+
+    for( i = 1; i < iModelCount; i++ )
+    {
+        if( xModel[ i ].ulPriority > xModel[ iNext ].ulPriority )
+        {
+            iNext = i;
+        }
+    }
+
+    return iNext;
+}
+/*-----------------------------------------------------------*/
+
+static void prvModelRemove( int iIndex )
+{
+    memmove( &( xModel[ iIndex ] ), &( xModel[ iIndex + 1 ] ), ( size_t ) ( iModelCount - iIndex - 1 ) * sizeof( ModelItem_t ) );
+    iModelCount--;
+}
+/*-----------------------------------------------------------*/
+
+/* Fills an item of any size with bytes that identify it. */
+static void prvMakeItem( uint8_t * pucItem,
+                         size_t xSize,
+                         uint32_t ulPriority,
+                         uint32_t ulSequence )
+{
+    uint8_t ucPattern[ 16 ];
+    size_t i;
+
+    memcpy( ucPattern, &ulSequence, sizeof( ulSequence ) );
+    memcpy( &( ucPattern[ 4 ] ), &ulPriority, sizeof( ulPriority ) );
+
+    for( i = 8; i < sizeof( ucPattern ); i++ )
+    {
+        ucPattern[ i ] = ( uint8_t ) ( ( ulSequence * 7U ) + i );
+    }
+
+    for( i = 0; i < xSize; i++ )
+    {
+        pucItem[ i ] = ucPattern[ i % sizeof( ucPattern ) ] ^ ( uint8_t ) ( i / sizeof( ucPattern ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Checks a received item against the item the model says comes next, and
+ * takes that item out of the model. */
+static void prvModelReceived( const uint8_t * pucItem,
+                              size_t xSize,
+                              const char * pcHow )
+{
+    uint8_t ucExpected[ modelMAX_ITEM_SIZE ];
+    int iNext = prvModelNext();
+
+    prvMakeItem( ucExpected, xSize, xModel[ iNext ].ulPriority, xModel[ iNext ].ulSequence );
+
+    if( memcmp( pucItem, ucExpected, xSize ) != 0 )
+    {
+        prvError( "%s: item of size %u is not priority %lu sequence %lu", pcHow, ( unsigned ) xSize,
+                  ( unsigned long ) xModel[ iNext ].ulPriority, ( unsigned long ) xModel[ iNext ].ulSequence );
+    }
+
+    prvModelRemove( iNext );
+}
+/*-----------------------------------------------------------*/
+
+static void prvModelOperation( QueueHandle_t xQueue,
+                               int iLength,
+                               size_t xSize,
+                               uint32_t ulPriorities,
+                               uint32_t * pulSequence )
+{
+    uint8_t ucItems[ 8 * modelMAX_ITEM_SIZE ], ucPeeked[ modelMAX_ITEM_SIZE ];
+    uint32_t ulOperation = prvRandom() % 10U, ulPriority;
+    BaseType_t xResult, xWoken = pdFALSE;
+    UBaseType_t uxCount, uxExpected, i;
+    int iNext;
+
+    if( ulOperation < 4U )
+    {
+        /* Send one item, with a priority, as if from an interrupt, or with
+         * xQueueSend() at priority 0. */
+        ulPriority = prvRandom() % ulPriorities;
+
+        switch( prvRandom() % 3U )
+        {
+            case 0:
+                prvMakeItem( ucItems, xSize, ulPriority, *pulSequence );
+                xResult = xQueueSendWithPriority( xQueue, ucItems, ulPriority, 0 );
+                break;
+
+            case 1:
+                prvMakeItem( ucItems, xSize, ulPriority, *pulSequence );
+                vSimEnterISR();
+                xResult = xQueueSendWithPriorityFromISR( xQueue, ucItems, ulPriority, &xWoken );
+                vSimExitISR( xWoken );
+                break;
+
+            default:
+                ulPriority = 0;
+                prvMakeItem( ucItems, xSize, ulPriority, *pulSequence );
+                xResult = xQueueSend( xQueue, ucItems, 0 );
+                break;
+        }
+
+        if( ( xResult == pdPASS ) != ( iModelCount < iLength ) )
+        {
+            prvError( "send returned %ld with %d of %d queued", ( long ) xResult, iModelCount, iLength );
+        }
+
+        if( xResult == pdPASS )
+        {
+            prvModelAdd( ulPriority, *pulSequence );
+            ( *pulSequence )++;
+        }
+    }
+    else if( ulOperation < 5U )
+    {
+        /* A batch send, at priority 0. */
+        uxCount = 1U + ( prvRandom() % 5U );
+
+        for( i = 0; i < uxCount; i++ )
+        {
+            prvMakeItem( &( ucItems[ i * xSize ] ), xSize, 0, *pulSequence + ( uint32_t ) i );
+        }
+
+        uxExpected = configMIN( uxCount, ( UBaseType_t ) ( iLength - iModelCount ) );
+        i = uxQueueSendBatch( xQueue, ucItems, uxCount, 0 );
+
+        if( i != uxExpected )
+        {
+            prvError( "batch send of %lu sent %lu, expected %lu", ( unsigned long ) uxCount, ( unsigned long ) i, ( unsigned long ) uxExpected );
+        }
+
+        for( uxCount = 0; uxCount < i; uxCount++ )
+        {
+            prvModelAdd( 0, *pulSequence + ( uint32_t ) uxCount );
+        }
+
+        *pulSequence += 5U;
+    }
+    else if( ulOperation < 8U )
+    {
+        /* Receive one item, from the task or as if from an interrupt, or
+         * peek at it both ways. */
+        switch( prvRandom() % 3U )
+        {
+            case 0:
+                xResult = xQueueReceive( xQueue, ucItems, 0 );
+                break;
+
+            case 1:
+                vSimEnterISR();
+                xResult = xQueueReceiveFromISR( xQueue, ucItems, &xWoken );
+                vSimExitISR( xWoken );
+                break;
+
+            default:
+
+                if( xQueuePeek( xQueue, ucItems, 0 ) != pdFALSE )
+                {
+                    iNext = prvModelNext();
+                    prvMakeItem( ucPeeked, xSize, xModel[ iNext ].ulPriority, xModel[ iNext ].ulSequence );
+
+                    if( memcmp( ucItems, ucPeeked, xSize ) != 0 )
+                    {
+                        prvError( "xQueuePeek() returned the wrong item" );
+                    }
+
+                    vSimEnterISR();
+                    xResult = xQueuePeekFromISR( xQueue, ucItems );
+                    vSimExitISR( pdFALSE );
+
+                    if( ( xResult == pdFALSE ) || ( memcmp( ucItems, ucPeeked, xSize ) != 0 ) )
+                    {
+                        prvError( "xQueuePeekFromISR() returned the wrong item" );
+                    }
+                }
+                else if( iModelCount != 0 )
+                {
+                    prvError( "xQueuePeek() failed with %d queued", iModelCount );
+                }
+
+                return;
+        }
+
+        if( ( xResult == pdPASS ) != ( iModelCount > 0 ) )
+        {
+            prvError( "receive returned %ld with %d queued", ( long ) xResult, iModelCount );
+        }
+
+        if( xResult == pdPASS )
+        {
+            prvModelReceived( ucItems, xSize, "receive" );
+        }
+    }
+    else if( ulOperation < 9U )
+    {
+        uxCount = 1U + ( prvRandom() % 6U );
+        uxExpected = configMIN( uxCount, ( UBaseType_t ) iModelCount );
+        i = uxQueueReceiveBatch( xQueue, ucItems, uxCount, 0 );
+
+        if( i != uxExpected )
+        {
+            prvError( "batch receive of %lu received %lu, expected %lu", ( unsigned long ) uxCount, ( unsigned long ) i, ( unsigned long ) uxExpected );
+        }
+
+        for( uxCount = 0; uxCount < i; uxCount++ )
+        {
+            prvModelReceived( &( ucItems[ uxCount * xSize ] ), xSize, "batch receive" );
+        }
+    }
+    else if( ( prvRandom() % 50U ) == 0U )
+    {
+        ( void ) xQueueReset( xQueue );
+        iModelCount = 0;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvModelTask( void * pvParameters )
+{
+    static const size_t xSizes[] = { 1, 2, 3, 4, 8, 12, 16 };
+    static StaticQueue_t xStaticQueue;
+    QueueHandle_t xQueue;
+    BaseType_t xStatic;
+    int iRound, iOperation, iLength;
+    size_t xSize;
+    uint32_t ulPriorities, ulSequence;
+    unsigned long ulOperations = 0;
+
+    ( void ) pvParameters;
+
+    for( iRound = 0; iRound < modelROUNDS; iRound++ )
+    {
+        iLength = 1 + ( int ) ( prvRandom() % modelMAX_LENGTH );
+        xSize = xSizes[ prvRandom() % ( sizeof( xSizes ) / sizeof( xSizes[ 0 ] ) ) ];
+        xStatic = ( ( prvRandom() & 1U ) != 0U ) ? pdTRUE : pdFALSE;
+        ulPriorities = 1U + ( prvRandom() % 5U );
+
+        if( xStatic != pdFALSE )
+        {
+            configASSERT( queuePRIORITY_QUEUE_STORAGE_SIZE( iLength, xSize ) <= sizeof( ucStaticStorage ) );
+            xQueue = xQueueCreatePriorityStatic( iLength, xSize, ucStaticStorage, &xStaticQueue );
+        }
+        else
+        {
+            xQueue = xQueueCreatePriority( iLength, xSize );
+        }
+
+        configASSERT( xQueue != NULL );
+        iModelCount = 0;
+        ulSequence = 0;
+
+        for( iOperation = 0; iOperation < modelOPERATIONS; iOperation++, ulOperations++ )
+        {
+            prvModelOperation( xQueue, iLength, xSize, ulPriorities, &ulSequence );
+
+            if( uxQueueMessagesWaiting( xQueue ) != ( UBaseType_t ) iModelCount )
+            {
+                prvError( "%lu items waiting, expected %d", ( unsigned long ) uxQueueMessagesWaiting( xQueue ), iModelCount );
+            }
+
+            if( uxQueueSpacesAvailable( xQueue ) != ( UBaseType_t ) ( iLength - iModelCount ) )
+            {
+                prvError( "%lu spaces, expected %d", ( unsigned long ) uxQueueSpacesAvailable( xQueue ), iLength - iModelCount );
+            }
+        }
+
+        if( xStatic == pdFALSE )
+        {
+            vQueueDelete( xQueue );
+        }
+    }
+
+    printf( "model: %lu operations, %lu errors\n", ulOperations, ulErrors );
+    exit( ( ulErrors != 0 ) ? 1 : 0 );
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Stress test.
+ */
+
+#define stressPRODUCERS     3
+#define stressPRIORITIES    4
+#define stressLENGTH        12
+
+typedef struct
+{
+    uint16_t usProducer;
+    uint16_t usPriority;
+    uint32_t ulSequence;
+} StressItem_t;
+
+static QueueHandle_t xStressQueue;
+static uint64_t ullStressStop;
+static unsigned long ulSent[ stressPRODUCERS ][ stressPRIORITIES ];
+static unsigned long ulReceived[ stressPRODUCERS ][ stressPRIORITIES ];
+static unsigned long ulTotalSent = 0, ulTotalReceived = 0, ulInversions = 0;
+/*-----------------------------------------------------------*/
+
+static void prvStressReceived( const StressItem_t * pxItem )
+{
+    if( ( pxItem->usProducer >= stressPRODUCERS ) || ( pxItem->usPriority >= stressPRIORITIES ) )
+    {
+        prvError( "received an item that was never sent" );
+        return;
+    }
+
+    if( pxItem->ulSequence != ulReceived[ pxItem->usProducer ][ pxItem->usPriority ] )
+    {
+        prvError( "producer %u priority %u: received sequence %lu, expected %lu", pxItem->usProducer, pxItem->usPriority,
+                  ( unsigned long ) pxItem->ulSequence, ulReceived[ pxItem->usProducer ][ pxItem->usPriority ] );
+    }
+
+    ulReceived[ pxItem->usProducer ][ pxItem->usPriority ] = pxItem->ulSequence + 1U;
+    ulTotalReceived++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvStressProducer( void * pvParameters )
+{
+    uint16_t usProducer = ( uint16_t ) ( intptr_t ) pvParameters;
+    StressItem_t xItem, xBatch[ 4 ];
+    uint16_t usPriority;
+    UBaseType_t uxCount, uxSent, i;
+    BaseType_t xResult, xWoken;
+
+    while( ullSimTime < ullStressStop )
+    {
+        usPriority = ( uint16_t ) ( prvRandom() % stressPRIORITIES );
+        xItem.usProducer = usProducer;
+        xItem.usPriority = usPriority;
+        xItem.ulSequence = ( uint32_t ) ulSent[ usProducer ][ usPriority ];
+        xWoken = pdFALSE;
+
+        switch( prvRandom() % 4U )
+        {
+            case 0:
+                xResult = xQueueSendWithPriority( xStressQueue, &xItem, usPriority, prvRandom() % 4U );
+                break;
+
+            case 1:
+                vSimEnterISR();
+                xResult = xQueueSendWithPriorityFromISR( xStressQueue, &xItem, usPriority, &xWoken );
+                vSimExitISR( xWoken );
+                break;
+
+            case 2:
+                usPriority = 0;
+                xItem.usPriority = 0;
+                xItem.ulSequence = ( uint32_t ) ulSent[ usProducer ][ 0 ];
+                xResult = xQueueSend( xStressQueue, &xItem, prvRandom() % 3U );
+                break;
+
+            default:
+                uxCount = 1U + ( prvRandom() % 4U );
+
+                for( i = 0; i < uxCount; i++ )
+                {
+                    xBatch[ i ].usProducer = usProducer;
+                    xBatch[ i ].usPriority = 0;
+                    xBatch[ i ].ulSequence = ( uint32_t ) ( ulSent[ usProducer ][ 0 ] + i );
+                }
+
+                uxSent = uxQueueSendBatch( xStressQueue, xBatch, uxCount, prvRandom() % 3U );
+                ulSent[ usProducer ][ 0 ] += uxSent;
+                ulTotalSent += uxSent;
+                xResult = pdFAIL;
+                break;
+        }
+
+        if( xResult == pdPASS )
+        {
+            ulSent[ usProducer ][ usPriority ]++;
+            ulTotalSent++;
+        }
+
+        vSimRun( prvRandom() % ( ( usProducer == 0U ) ? 3000U : 20000U ) );
+    }
+
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStressConsumer( void * pvParameters )
+{
+    StressItem_t xItems[ 8 ], xPeeked;
+    UBaseType_t uxReceived, i;
+    BaseType_t xWoken;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        uxReceived = 0;
+        xWoken = pdFALSE;
+
+        switch( prvRandom() % 4U )
+        {
+            case 0:
+                uxReceived = ( xQueueReceive( xStressQueue, xItems, 5 ) == pdPASS ) ? 1U : 0U;
+                break;
+
+            case 1:
+                vSimEnterISR();
+                uxReceived = ( xQueueReceiveFromISR( xStressQueue, xItems, &xWoken ) == pdPASS ) ? 1U : 0U;
+                vSimExitISR( xWoken );
+                break;
+
+            case 2:
+                uxReceived = uxQueueReceiveBatch( xStressQueue, xItems, 1U + ( prvRandom() % 8U ), 5 );
+                break;
+
+            default:
+
+                /* An item that arrives between the peek and the receive can
+                 * only be of a higher priority than the one peeked. */
+                if( xQueuePeek( xStressQueue, &xPeeked, 5 ) == pdPASS )
+                {
+                    uxReceived = ( xQueueReceive( xStressQueue, xItems, 0 ) == pdPASS ) ? 1U : 0U;
+
+                    if( ( uxReceived != 0U ) && ( xItems[ 0 ].usPriority < xPeeked.usPriority ) )
+                    {
+                        ulInversions++;
+                    }
+                }
+
+                break;
+        }
+
+        for( i = 0; i < uxReceived; i++ )
+        {
+            if( ( i != 0U ) && ( xItems[ i ].usPriority > xItems[ i - 1U ].usPriority ) )
+            {
+                ulInversions++;
+            }
+
+            prvStressReceived( &( xItems[ i ] ) );
+        }
+
+        vSimRun( prvRandom() % 6000U );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static int prvStressEnd( void )
+{
+    unsigned long ulWaiting = ( unsigned long ) uxQueueMessagesWaiting( xStressQueue );
+
+    printf( "stress: %lu sent, %lu received, %lu left, %lu errors, %lu inversions\n", ulTotalSent, ulTotalReceived, ulWaiting, ulErrors, ulInversions );
+
+    if( ( ulTotalSent != ulTotalReceived ) || ( ulWaiting != 0 ) )
+    {
+        printf( "FAIL: items were lost\n" );
+    }
+
+    return ( ( ulErrors != 0 ) || ( ulInversions != 0 ) || ( ulTotalSent != ulTotalReceived ) || ( ulWaiting != 0 ) || ( ulTotalReceived == 0 ) ) ? 1 : 0;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Latency benchmark.
+ */
+
+#define latencyMAX_SAMPLES    100000
+#define latencyLENGTH         32
+
+typedef struct
+{
+    uint8_t ucUrgent;
+    uint32_t ulNumber;
+    uint64_t ullSent;
+} LatencyMessage_t;
+
+static QueueHandle_t xLatencyQueue;
+static BaseType_t xUrgentPriority;
+static uint64_t ullLatencies[ latencyMAX_SAMPLES ];
+static int iLatencies = 0;
+static unsigned long ulUrgentDropped = 0, ulTelemetryDropped = 0, ulTelemetryReceived = 0;
+/*-----------------------------------------------------------*/
+
+/* Four telemetry messages a tick, which is more than the consumer handles. */
+static void prvTelemetryTask( void * pvParameters )
+{
+    LatencyMessage_t xMessage = { 0 };
+    int i;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        for( i = 0; i < 4; i++ )
+        {
+            xMessage.ullSent = ullSimTime;
+
+            if( xQueueSend( xLatencyQueue, &xMessage, 0 ) != pdPASS )
+            {
+                ulTelemetryDropped++;
+            }
+        }
+
+        vTaskDelay( 1 );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvUrgentTask( void * pvParameters )
+{
+    LatencyMessage_t xMessage = { 0 };
+    BaseType_t xResult;
+
+    ( void ) pvParameters;
+    xMessage.ucUrgent = 1;
+
+    for( ; ; )
+    {
+        vTaskDelay( 3U + ( prvRandom() % 18U ) );
+        xMessage.ullSent = ullSimTime;
+
+        if( xUrgentPriority != pdFALSE )
+        {
+            xResult = xQueueSendWithPriority( xLatencyQueue, &xMessage, 1, 0 );
+        }
+        else
+        {
+            xResult = xQueueSend( xLatencyQueue, &xMessage, 0 );
+        }
+
+        if( xResult != pdPASS )
+        {
+            ulUrgentDropped++;
+        }
+
+        xMessage.ulNumber++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvLatencyConsumer( void * pvParameters )
+{
+    LatencyMessage_t xMessage;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) xQueueReceive( xLatencyQueue, &xMessage, portMAX_DELAY );
+
+        if( xMessage.ucUrgent != 0U )
+        {
+            if( iLatencies < latencyMAX_SAMPLES )
+            {
+                ullLatencies[ iLatencies++ ] = ullSimTime - xMessage.ullSent;
+            }
+        }
+        else
+        {
+            ulTelemetryReceived++;
+        }
+
+        vSimRun( ( simCYCLES_PER_TICK / 4U ) + ( prvRandom() % ( simCYCLES_PER_TICK / 16U ) ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static int prvCompareLatency( const void * pvA,
+                              const void * pvB )
+{
+    uint64_t ullA = *( const uint64_t * ) pvA, ullB = *( const uint64_t * ) pvB;
+
+    return ( ullA < ullB ) ? -1 : ( ullA > ullB ) ? 1 : 0;
+}
+/*-----------------------------------------------------------*/
+
+static int prvLatencyEnd( void )
+{
+    double dTick = ( double ) simCYCLES_PER_TICK, dSum = 0;
+    int i;
+
+    if( iLatencies == 0 )
+    {
+        printf( "no urgent message was received\n" );
+        return 1;
+    }
+
+    qsort( ullLatencies, ( size_t ) iLatencies, sizeof( ullLatencies[ 0 ] ), prvCompareLatency );
+
+    for( i = 0; i < iLatencies; i++ )
+    {
+        dSum += ( double ) ullLatencies[ i ];
+    }
+
+    printf( "%s: %d urgent messages, latency mean %.2f ms, p50 %.2f ms, p99 %.2f ms, max %.2f ms; %lu urgent and %lu telemetry dropped, %lu telemetry received\n",
+            ( xUrgentPriority != pdFALSE ) ? "prio" : "fifo", iLatencies, dSum / iLatencies / dTick, ullLatencies[ iLatencies / 2 ] / dTick,
+            ullLatencies[ ( iLatencies * 99 ) / 100 ] / dTick, ullLatencies[ iLatencies - 1 ] / dTick, ulUrgentDropped, ulTelemetryDropped, ulTelemetryReceived );
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Host benchmark.
+ */
+
+static double prvNanoseconds( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( double ) xNow.tv_sec * 1e9 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void * pvParameters )
+{
+    static const int iDepths[] = { 1, 8, 32, 128 };
+    const long lOperations = 1000000;
+    uint32_t ulItem[ 2 ] = { 0, 0 };
+    QueueHandle_t xQueue;
+    double dStart, dTime, dBest;
+    int iDepth, iPriority, iRepeat, i;
+    long l;
+
+    ( void ) pvParameters;
+
+    for( iDepth = 0; iDepth < ( int ) ( sizeof( iDepths ) / sizeof( iDepths[ 0 ] ) ); iDepth++ )
+    {
+        for( iPriority = 0; iPriority < 2; iPriority++ )
+        {
+            if( iPriority != 0 )
+            {
+                xQueue = xQueueCreatePriority( iDepths[ iDepth ] + 1, sizeof( ulItem ) );
+            }
+            else
+            {
+                xQueue = xQueueCreate( iDepths[ iDepth ] + 1, sizeof( ulItem ) );
+            }
+
+            configASSERT( xQueue != NULL );
+
+            for( i = 0; i < iDepths[ iDepth ]; i++ )
+            {
+                if( iPriority != 0 )
+                {
+                    ( void ) xQueueSendWithPriority( xQueue, ulItem, prvRandom() % 4U, 0 );
+                }
+                else
+                {
+                    ( void ) xQueueSend( xQueue, ulItem, 0 );
+                }
+            }
+
+            dBest = 1e18;
+
+            for( iRepeat = 0; iRepeat < 5; iRepeat++ )
+            {
+                dStart = prvNanoseconds();
+
+                for( l = 0; l < lOperations; l++ )
+                {
+                    if( iPriority != 0 )
+                    {
+                        ( void ) xQueueSendWithPriority( xQueue, ulItem, ( UBaseType_t ) ( l & 3 ), 0 );
+                    }
+                    else
+                    {
+                        ( void ) xQueueSend( xQueue, ulItem, 0 );
+                    }
+
+                    ( void ) xQueueReceive( xQueue, ulItem, 0 );
+                }
+
+                dTime = ( prvNanoseconds() - dStart ) / ( double ) lOperations;
+                dBest = ( dTime < dBest ) ? dTime : dBest;
+            }
+
+            printf( "depth %3d %s queue: %6.1f ns per send and receive\n", iDepths[ iDepth ], ( iPriority != 0 ) ? "priority" : "ordinary", dBest );
+            vQueueDelete( xQueue );
+        }
+    }
+
+    exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    int i;
+
+    if( ( argc == 3 ) && ( strcmp( argv[ 1 ], "model" ) == 0 ) )
+    {
+        prvSeed( argv[ 2 ] );
+        ( void ) xTaskCreate( prvModelTask, "Model", configMINIMAL_STACK_SIZE, NULL, 2, NULL );
+    }
+    else if( ( argc == 4 ) && ( strcmp( argv[ 1 ], "stress" ) == 0 ) )
+    {
+        prvSeed( argv[ 3 ] );
+        xStressQueue = xQueueCreatePriority( stressLENGTH, sizeof( StressItem_t ) );
+
+        for( i = 0; i < stressPRODUCERS; i++ )
+        {
+            ( void ) xTaskCreate( prvStressProducer, "Prod", configMINIMAL_STACK_SIZE, ( void * ) ( intptr_t ) i, 1 + i, NULL );
+        }
+
+        ( void ) xTaskCreate( prvStressConsumer, "Cons", configMINIMAL_STACK_SIZE, NULL, 2, NULL );
+        ullStressStop = simSECONDS( atof( argv[ 2 ] ) );
+        vSimSetEndTime( ullStressStop + simSECONDS( 1 ), prvStressEnd );
+    }
+    else if( ( argc == 3 ) && ( strcmp( argv[ 1 ], "latency" ) == 0 ) )
+    {
+        xUrgentPriority = ( strcmp( argv[ 2 ], "prio" ) == 0 ) ? pdTRUE : pdFALSE;
+
+        if( xUrgentPriority != pdFALSE )
+        {
+            xLatencyQueue = xQueueCreatePriority( latencyLENGTH, sizeof( LatencyMessage_t ) );
+        }
+        else
+        {
+            xLatencyQueue = xQueueCreate( latencyLENGTH, sizeof( LatencyMessage_t ) );
+        }
+
+        ( void ) xTaskCreate( prvTelemetryTask, "Tele", configMINIMAL_STACK_SIZE, NULL, 2, NULL );
+        ( void ) xTaskCreate( prvUrgentTask, "Urgent", configMINIMAL_STACK_SIZE, NULL, 3, NULL );
+        ( void ) xTaskCreate( prvLatencyConsumer, "Cons", configMINIMAL_STACK_SIZE, NULL, 1, NULL );
+        vSimSetEndTime( simSECONDS( 300 ), prvLatencyEnd );
+    }
+    else if( ( argc == 2 ) && ( strcmp( argv[ 1 ], "bench" ) == 0 ) )
+    {
+        ( void ) xTaskCreate( prvBenchTask, "Bench", configMINIMAL_STACK_SIZE, NULL, 2, NULL );
+    }
+    else
+    {
+        printf( "usage: %s model <seed> | stress <seconds> <seed> | latency fifo|prio | bench\n", argv[ 0 ] );
+        return 1;
+    }
+
+    vTaskStartScheduler();
+
+    return 1;
+}
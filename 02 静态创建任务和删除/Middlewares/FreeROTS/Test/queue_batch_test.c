@@ -0,0 +1,434 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test and benchmark of the batch queue functions, uxQueueSendBatch(),
+ * uxQueueReceiveBatch() and their FromISR versions, on the simulation port.
+ *
+ *   queue_batch_test stress <seconds> <seed>
+ *       A producer task sends numbered 3 byte items to a queue of 10 items,
+ *       mixing single sends, batch sends of 1 to 24 items and the FromISR
+ *       versions of both, while a higher and a lower priority consumer task
+ *       receive them in the same mixture of ways and peek between receives.
+ *       The odd item size and short queue make most batches wrap round the
+ *       end of the storage area.  Every item must be received exactly once,
+ *       each consumer must receive items in the order they were sent, and the
+ *       items of one batch receive must be consecutive, as it empties the
+ *       queue from the front in one go.  The producer stops at the given time
+ *       and the consumers then have a second to empty the queue.
+ *
+ *   queue_batch_test bench
+ *       Host items per second through a queue of 64 four byte items, sending
+ *       and receiving one item at a time or in batches of 1, 4, 16 and 64,
+ *       first filling and emptying the queue from one task and then sending
+ *       to a higher priority task blocked on the queue.  Critical sections
+ *       cost almost nothing on the host, so only the ratios mean anything.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "sim.h"
+
+#define stressLENGTH       10
+#define stressMAX_SEND     24
+#define stressMAX_RECEIVE  16
+#define stressMAX_ITEMS    ( 1UL << 24 )
+
+typedef struct
+{
+    uint8_t ucBytes[ 3 ];
+} StressItem_t;
+
+static QueueHandle_t xStressQueue;
+static uint64_t ullStopTime;
+static uint8_t ucReceived[ stressMAX_ITEMS / 8 ];
+static uint32_t ulLastReceived[ 2 ];
+static BaseType_t xReceivedAny[ 2 ];
+static unsigned long ulSent = 0, ulSentFromISR = 0, ulReceivedCount = 0, ulBadItems = 0, ulCalls = 0;
+static uint64_t ullRandomState = 88172645463325252ULL;
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    ullRandomState ^= ullRandomState << 13;
+    ullRandomState ^= ullRandomState >> 7;
+    ullRandomState ^= ullRandomState << 17;
+
+    return ( uint32_t ) ullRandomState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMakeItem( StressItem_t * pxItem,
+                         uint32_t ulSequence )
+{
+    pxItem->ucBytes[ 0 ] = ( uint8_t ) ulSequence;
+    pxItem->ucBytes[ 1 ] = ( uint8_t ) ( ulSequence >> 8 );
+    pxItem->ucBytes[ 2 ] = ( uint8_t ) ( ulSequence >> 16 );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvItemSequence( const StressItem_t * pxItem )
+{
+    return ( uint32_t ) pxItem->ucBytes[ 0 ] | ( ( uint32_t ) pxItem->ucBytes[ 1 ] << 8 ) | ( ( uint32_t ) pxItem->ucBytes[ 2 ] << 16 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvBadItem( const char * pcWhat,
+                        int iConsumer,
+                        uint32_t ulSequence )
+{
+    if( ulBadItems++ < 5 )
+    {
+        printf( "consumer %d: item %lu %s\n", iConsumer, ( unsigned long ) ulSequence, pcWhat );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckReceived( int iConsumer,
+                              const StressItem_t * pxItems,
+                              UBaseType_t uxCount )
+{
+    uint32_t ulSequence;
+    UBaseType_t i;
+
+    for( i = 0; i < uxCount; i++ )
+    {
+        ulSequence = prvItemSequence( &( pxItems[ i ] ) );
+
+        if( ( ucReceived[ ulSequence / 8U ] & ( 1U << ( ulSequence % 8U ) ) ) != 0U )
+        {
+            prvBadItem( "received twice", iConsumer, ulSequence );
+        }
+        else if( ( xReceivedAny[ iConsumer ] != pdFALSE ) && ( ulSequence <= ulLastReceived[ iConsumer ] ) )
+        {
+            prvBadItem( "received out of order", iConsumer, ulSequence );
+        }
+        else if( ( i != 0U ) && ( ulSequence != ( ulLastReceived[ iConsumer ] + 1U ) ) )
+        {
+            prvBadItem( "not consecutive in a batch", iConsumer, ulSequence );
+        }
+
+        ucReceived[ ulSequence / 8U ] |= ( uint8_t ) ( 1U << ( ulSequence % 8U ) );
+        ulLastReceived[ iConsumer ] = ulSequence;
+        xReceivedAny[ iConsumer ] = pdTRUE;
+        ulReceivedCount++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvProducerTask( void * pvParameters )
+{
+    StressItem_t xItems[ stressMAX_SEND ];
+    UBaseType_t uxCount, uxSent, i;
+    BaseType_t xWoken;
+
+    ( void ) pvParameters;
+
+    while( ( ullSimTime < ullStopTime ) && ( ulSent < ( stressMAX_ITEMS - stressMAX_SEND ) ) )
+    {
+        uxCount = 1U + ( prvRandom() % stressMAX_SEND );
+        xWoken = pdFALSE;
+
+        for( i = 0; i < uxCount; i++ )
+        {
+            prvMakeItem( &( xItems[ i ] ), ( uint32_t ) ( ulSent + i ) );
+        }
+
+        switch( prvRandom() % 5U )
+        {
+            case 0:
+                uxSent = ( xQueueSend( xStressQueue, xItems, prvRandom() % 3U ) == pdPASS ) ? 1U : 0U;
+                break;
+
+            case 1:
+                vSimEnterISR();
+                uxSent = ( xQueueSendFromISR( xStressQueue, xItems, &xWoken ) == pdPASS ) ? 1U : 0U;
+                vSimExitISR( xWoken );
+                ulSentFromISR += uxSent;
+                break;
+
+            case 2:
+                vSimEnterISR();
+                uxSent = uxQueueSendBatchFromISR( xStressQueue, xItems, uxCount, &xWoken );
+                vSimExitISR( xWoken );
+                ulSentFromISR += uxSent;
+                break;
+
+            default:
+                uxSent = uxQueueSendBatch( xStressQueue, xItems, uxCount, prvRandom() % 5U );
+                break;
+        }
+
+        ulSent += uxSent;
+        ulCalls++;
+        vSimRun( prvRandom() % 3000U );
+    }
+
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsumerTask( void * pvParameters )
+{
+    int iConsumer = ( int ) ( intptr_t ) pvParameters;
+    StressItem_t xItems[ stressMAX_RECEIVE ], xPeeked;
+    UBaseType_t uxReceived;
+    BaseType_t xWoken;
+
+    for( ; ; )
+    {
+        xWoken = pdFALSE;
+
+        switch( prvRandom() % 5U )
+        {
+            case 0:
+                uxReceived = ( xQueueReceive( xStressQueue, xItems, 7 ) == pdPASS ) ? 1U : 0U;
+                break;
+
+            case 1:
+                vSimEnterISR();
+                uxReceived = ( xQueueReceiveFromISR( xStressQueue, xItems, &xWoken ) == pdPASS ) ? 1U : 0U;
+                vSimExitISR( xWoken );
+                break;
+
+            case 2:
+                vSimEnterISR();
+                uxReceived = uxQueueReceiveBatchFromISR( xStressQueue, xItems, 1U + ( prvRandom() % stressMAX_RECEIVE ), &xWoken );
+                vSimExitISR( xWoken );
+                break;
+
+            default:
+                uxReceived = uxQueueReceiveBatch( xStressQueue, xItems, 1U + ( prvRandom() % stressMAX_RECEIVE ), 7 );
+                break;
+        }
+
+        prvCheckReceived( iConsumer, xItems, uxReceived );
+
+        /* The item at the front of the queue was sent after every item this
+         * consumer has received. */
+        if( ( uxReceived != 0U ) && ( xQueuePeek( xStressQueue, &xPeeked, 0 ) == pdPASS ) &&
+            ( prvItemSequence( &xPeeked ) <= ulLastReceived[ iConsumer ] ) )
+        {
+            prvBadItem( "peeked after a later item was received", iConsumer, prvItemSequence( &xPeeked ) );
+        }
+
+        vSimRun( prvRandom() % ( ( iConsumer == 0 ) ? 2500U : 9000U ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static int prvStressEnd( void )
+{
+    unsigned long ulMissing = 0, ulWaiting = ( unsigned long ) uxQueueMessagesWaiting( xStressQueue );
+    uint32_t ulSequence;
+
+    for( ulSequence = 0; ulSequence < ulSent; ulSequence++ )
+    {
+        if( ( ucReceived[ ulSequence / 8U ] & ( 1U << ( ulSequence % 8U ) ) ) == 0U )
+        {
+            ulMissing++;
+        }
+    }
+
+    printf( "priority event lists=%d: %lu sent in %lu calls, %lu of them from interrupts, %lu received, %lu missing, %lu left, %lu bad\n",
+            configUSE_PRIORITY_EVENT_LISTS, ulSent, ulCalls, ulSentFromISR, ulReceivedCount, ulMissing, ulWaiting, ulBadItems );
+
+    if( ( ulMissing != 0 ) || ( ulWaiting != 0 ) || ( ulReceivedCount != ulSent ) )
+    {
+        printf( "FAIL: items were lost\n" );
+    }
+
+    return ( ( ulBadItems != 0 ) || ( ulMissing != 0 ) || ( ulWaiting != 0 ) || ( ulReceivedCount != ulSent ) || ( ulSent == 0 ) ) ? 1 : 0;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Benchmark.
+ */
+
+#define benchLENGTH    64
+#define benchITEMS     4000000L
+
+static QueueHandle_t xBenchQueue;
+static BaseType_t xBenchBatches;
+static volatile unsigned long ulBenchReceived;
+/*-----------------------------------------------------------*/
+
+static double prvNanoseconds( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( double ) xNow.tv_sec * 1e9 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchConsumer( void * pvParameters )
+{
+    uint32_t ulItems[ benchLENGTH ];
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        if( xBenchBatches != pdFALSE )
+        {
+            ulBenchReceived += uxQueueReceiveBatch( xBenchQueue, ulItems, benchLENGTH, portMAX_DELAY );
+        }
+        else if( xQueueReceive( xBenchQueue, ulItems, portMAX_DELAY ) == pdPASS )
+        {
+            ulBenchReceived++;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void * pvParameters )
+{
+    static const int iBatchSizes[] = { 0, 1, 4, 16, 64 };
+    uint32_t ulItems[ benchLENGTH ];
+    TaskHandle_t xConsumer;
+    int iBlocked, iSize, iBatch, i;
+    double dStart, dTime;
+    long l;
+
+    ( void ) pvParameters;
+
+    for( i = 0; i < benchLENGTH; i++ )
+    {
+        ulItems[ i ] = ( uint32_t ) i;
+    }
+
+    for( iBlocked = 0; iBlocked < 2; iBlocked++ )
+    {
+        for( iSize = 0; iSize < ( int ) ( sizeof( iBatchSizes ) / sizeof( iBatchSizes[ 0 ] ) ); iSize++ )
+        {
+            /* A batch size of 0 sends and receives one item at a time, 64 at
+             * a time so the queue fills as it does for a batch of 64. */
+            iBatch = ( iBatchSizes[ iSize ] != 0 ) ? iBatchSizes[ iSize ] : benchLENGTH;
+            xBenchBatches = ( iBatchSizes[ iSize ] != 0 ) ? pdTRUE : pdFALSE;
+            xBenchQueue = xQueueCreate( benchLENGTH, sizeof( uint32_t ) );
+            xConsumer = NULL;
+            ulBenchReceived = 0;
+
+            if( iBlocked != 0 )
+            {
+                ( void ) xTaskCreate( prvBenchConsumer, "Cons", configMINIMAL_STACK_SIZE, NULL, 3, &xConsumer );
+            }
+
+            dStart = prvNanoseconds();
+
+            for( l = 0; l < benchITEMS; l += iBatch )
+            {
+                if( xBenchBatches != pdFALSE )
+                {
+                    ( void ) uxQueueSendBatch( xBenchQueue, ulItems, ( UBaseType_t ) iBatch, 0 );
+
+                    if( iBlocked == 0 )
+                    {
+                        ( void ) uxQueueReceiveBatch( xBenchQueue, ulItems, ( UBaseType_t ) iBatch, 0 );
+                    }
+                }
+                else
+                {
+                    for( i = 0; i < iBatch; i++ )
+                    {
+                        ( void ) xQueueSend( xBenchQueue, &( ulItems[ i ] ), 0 );
+                    }
+
+                    if( iBlocked == 0 )
+                    {
+                        for( i = 0; i < iBatch; i++ )
+                        {
+                            ( void ) xQueueReceive( xBenchQueue, &( ulItems[ i ] ), 0 );
+                        }
+                    }
+                }
+            }
+
+            dTime = prvNanoseconds() - dStart;
+
+            if( ( iBlocked != 0 ) && ( ulBenchReceived != ( unsigned long ) ( ( ( benchITEMS + iBatch - 1 ) / iBatch ) * iBatch ) ) )
+            {
+                printf( "FAIL: the consumer received %lu items\n", ulBenchReceived );
+            }
+
+            if( xBenchBatches != pdFALSE )
+            {
+                printf( "%s batches of %2d: %7.2f M items/s\n", ( iBlocked != 0 ) ? "to a blocked higher priority task," : "filled and emptied by one task,   ",
+                        iBatch, ( double ) benchITEMS / dTime * 1e3 );
+            }
+            else
+            {
+                printf( "%s one at a time: %7.2f M items/s\n", ( iBlocked != 0 ) ? "to a blocked higher priority task," : "filled and emptied by one task,   ",
+                        ( double ) benchITEMS / dTime * 1e3 );
+            }
+
+            if( xConsumer != NULL )
+            {
+                vTaskDelete( xConsumer );
+            }
+
+            vQueueDelete( xBenchQueue );
+        }
+    }
+
+    exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    if( ( argc == 4 ) && ( strcmp( argv[ 1 ], "stress" ) == 0 ) )
+    {
+        ullRandomState ^= strtoull( argv[ 3 ], NULL, 0 ) * 0x9E3779B97F4A7C15ULL;
+        ullStopTime = simSECONDS( atof( argv[ 2 ] ) );
+        xStressQueue = xQueueCreate( stressLENGTH, sizeof( StressItem_t ) );
+
+        ( void ) xTaskCreate( prvProducerTask, "Prod", configMINIMAL_STACK_SIZE, NULL, 2, NULL );
+        ( void ) xTaskCreate( prvConsumerTask, "Cons0", configMINIMAL_STACK_SIZE, ( void * ) 0, 3, NULL );
+        ( void ) xTaskCreate( prvConsumerTask, "Cons1", configMINIMAL_STACK_SIZE, ( void * ) 1, 1, NULL );
+        vSimSetEndTime( ullStopTime + simSECONDS( 1 ), prvStressEnd );
+    }
+    else if( ( argc == 2 ) && ( strcmp( argv[ 1 ], "bench" ) == 0 ) )
+    {
+        ( void ) xTaskCreate( prvBenchTask, "Bench", configMINIMAL_STACK_SIZE, NULL, 2, NULL );
+    }
+    else
+    {
+        printf( "usage: %s stress <seconds> <seed> | bench\n", argv[ 0 ] );
+        return 1;
+    }
+
+    vTaskStartScheduler();
+
+    return 1;
+}
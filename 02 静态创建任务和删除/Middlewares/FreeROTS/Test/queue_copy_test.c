@@ -0,0 +1,416 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test and benchmark of the direct copy of 1, 2, 4 and 8 byte queue items,
+ * on the simulation port.  queue.c is included to reach ucCopyType.
+ *
+ *   queue_copy_test test <seed>
+ *       For every item size from 1 to 12 bytes, with the storage area
+ *       allocated, static and aligned, and static and offset by 1, 2 and 4
+ *       bytes, checks the copy type chosen for the queue, then makes random
+ *       sends to the back and front, overwrites, peeks and receives, from the
+ *       task and as if from an interrupt, with the caller's buffer offset by 0
+ *       to 3 bytes.  Every item must match a model of the queue, and no byte
+ *       either side of the item in the caller's buffer may change.
+ *
+ *   queue_copy_test bench
+ *       Host time per xQueueSend() and xQueueReceive() pair for each item
+ *       size, with the storage area aligned, so 1, 2, 4 and 8 byte items are
+ *       copied directly, and offset by one byte, so every item is copied with
+ *       memcpy().  Sizes 3, 5 and 12 use memcpy() both times and show the
+ *       noise.  The cycle counts on the target come from
+ *       target/queue_copy_cycles.c.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "queue.c"
+#include "sim.h"
+
+#define testLENGTH       5
+#define testMAX_SIZE     12
+#define testGUARD        ( ( uint8_t ) 0xA5 )
+#define testROUNDS       400
+
+static uint8_t ucStorage[ ( 16 * testMAX_SIZE ) + 8 ] __attribute__( ( aligned( 8 ) ) );
+static StaticQueue_t xStaticQueue;
+static uint32_t ulModel[ testLENGTH ];
+static UBaseType_t uxModelHead, uxModelCount;
+static unsigned long ulOperations = 0, ulBadItems = 0, ulBadCopyTypes = 0;
+static uint64_t ullRandomState = 88172645463325252ULL;
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    ullRandomState ^= ullRandomState << 13;
+    ullRandomState ^= ullRandomState >> 7;
+    ullRandomState ^= ullRandomState << 17;
+
+    return ( uint32_t ) ullRandomState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMakeItem( uint8_t * pucItem,
+                         size_t xSize,
+                         uint32_t ulSequence )
+{
+    size_t i;
+
+    for( i = 0; i < xSize; i++ )
+    {
+        pucItem[ i ] = ( uint8_t ) ( ( ulSequence * 31U ) + ( i * 7U ) + 1U );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Checks an item copied out of the queue against the item at the front of the
+ * model, and the guard bytes around it. */
+static void prvCheckItem( const uint8_t * pucBuffer,
+                          size_t xOffset,
+                          size_t xSize,
+                          const char * pcOperation )
+{
+    uint8_t ucExpected[ testMAX_SIZE ];
+    size_t i;
+    BaseType_t xBad = pdFALSE;
+
+    prvMakeItem( ucExpected, xSize, ulModel[ uxModelHead ] );
+
+    if( memcmp( &( pucBuffer[ xOffset ] ), ucExpected, xSize ) != 0 )
+    {
+        xBad = pdTRUE;
+    }
+
+    for( i = 0; i < ( testMAX_SIZE + 8 ); i++ )
+    {
+        if( ( ( i < xOffset ) || ( i >= ( xOffset + xSize ) ) ) && ( pucBuffer[ i ] != testGUARD ) )
+        {
+            xBad = pdTRUE;
+        }
+    }
+
+    if( xBad != pdFALSE )
+    {
+        if( ulBadItems++ < 5 )
+        {
+            printf( "%s of a %u byte item to a buffer offset by %u copied the wrong bytes\n", pcOperation, ( unsigned ) xSize, ( unsigned ) xOffset );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestQueue( size_t xSize,
+                          int iStorageOffset )
+{
+    QueueHandle_t xQueue;
+    uint8_t ucItem[ testMAX_SIZE + 8 ] __attribute__( ( aligned( 8 ) ) );
+    uint8_t ucBuffer[ testMAX_SIZE + 8 ] __attribute__( ( aligned( 8 ) ) );
+    uint8_t * pucStorage = NULL;
+    uint8_t ucExpectedCopyType = queueCOPY_GENERIC;
+    uint32_t ulNextSequence = 0;
+    size_t xOffset;
+    BaseType_t xWoken, xResult;
+    int iRound;
+
+    if( iStorageOffset < 0 )
+    {
+        xQueue = xQueueCreate( testLENGTH, xSize );
+        pucStorage = ( uint8_t * ) ( ( Queue_t * ) xQueue )->pcHead;
+    }
+    else
+    {
+        pucStorage = &( ucStorage[ iStorageOffset ] );
+        xQueue = xQueueCreateStatic( testLENGTH, xSize, pucStorage, &xStaticQueue );
+    }
+
+    configASSERT( xQueue != NULL );
+
+    if( ( ( xSize == 1U ) || ( xSize == 2U ) || ( xSize == 4U ) || ( xSize == 8U ) ) &&
+        ( ( ( ( uintptr_t ) pucStorage ) & ( ( xSize - 1U ) & 3U ) ) == 0U ) )
+    {
+        ucExpectedCopyType = ( uint8_t ) xSize;
+    }
+
+    if( ( ( Queue_t * ) xQueue )->ucCopyType != ucExpectedCopyType )
+    {
+        printf( "a queue of %u byte items with storage offset by %d has copy type %u, not %u\n", ( unsigned ) xSize, iStorageOffset,
+                ( unsigned ) ( ( Queue_t * ) xQueue )->ucCopyType, ( unsigned ) ucExpectedCopyType );
+        ulBadCopyTypes++;
+    }
+
+    uxModelHead = 0;
+    uxModelCount = 0;
+
+    for( iRound = 0; iRound < testROUNDS; iRound++ )
+    {
+        xOffset = prvRandom() % 4U;
+        xWoken = pdFALSE;
+        memset( ucItem, 0, sizeof( ucItem ) );
+        memset( ucBuffer, testGUARD, sizeof( ucBuffer ) );
+        prvMakeItem( &( ucItem[ xOffset ] ), xSize, ulNextSequence );
+
+        switch( prvRandom() % 8U )
+        {
+            case 0:
+
+                if( xQueueSend( xQueue, &( ucItem[ xOffset ] ), 0 ) == pdPASS )
+                {
+                    ulModel[ ( uxModelHead + uxModelCount ) % testLENGTH ] = ulNextSequence++;
+                    uxModelCount++;
+                }
+
+                break;
+
+            case 1:
+
+                if( xQueueSendToFront( xQueue, &( ucItem[ xOffset ] ), 0 ) == pdPASS )
+                {
+                    uxModelHead = ( uxModelHead + testLENGTH - 1U ) % testLENGTH;
+                    ulModel[ uxModelHead ] = ulNextSequence++;
+                    uxModelCount++;
+                }
+
+                break;
+
+            case 2:
+                vSimEnterISR();
+                xResult = xQueueSendFromISR( xQueue, &( ucItem[ xOffset ] ), &xWoken );
+                vSimExitISR( xWoken );
+
+                if( xResult == pdPASS )
+                {
+                    ulModel[ ( uxModelHead + uxModelCount ) % testLENGTH ] = ulNextSequence++;
+                    uxModelCount++;
+                }
+
+                break;
+
+            case 3:
+
+                if( uxModelCount != 0U )
+                {
+                    if( xQueuePeek( xQueue, &( ucBuffer[ xOffset ] ), 0 ) != pdPASS )
+                    {
+                        ulBadItems++;
+                    }
+
+                    prvCheckItem( ucBuffer, xOffset, xSize, "peek" );
+                }
+
+                break;
+
+            case 4:
+                vSimEnterISR();
+                xResult = xQueueReceiveFromISR( xQueue, &( ucBuffer[ xOffset ] ), &xWoken );
+                vSimExitISR( xWoken );
+
+                if( xResult != ( ( uxModelCount != 0U ) ? pdPASS : pdFAIL ) )
+                {
+                    ulBadItems++;
+                }
+                else if( xResult == pdPASS )
+                {
+                    prvCheckItem( ucBuffer, xOffset, xSize, "receive from an interrupt" );
+                    uxModelHead = ( uxModelHead + 1U ) % testLENGTH;
+                    uxModelCount--;
+                }
+
+                break;
+
+            default:
+                xResult = xQueueReceive( xQueue, &( ucBuffer[ xOffset ] ), 0 );
+
+                if( xResult != ( ( uxModelCount != 0U ) ? pdPASS : pdFAIL ) )
+                {
+                    ulBadItems++;
+                }
+                else if( xResult == pdPASS )
+                {
+                    prvCheckItem( ucBuffer, xOffset, xSize, "receive" );
+                    uxModelHead = ( uxModelHead + 1U ) % testLENGTH;
+                    uxModelCount--;
+                }
+
+                break;
+        }
+
+        ulOperations++;
+    }
+
+    if( uxQueueMessagesWaiting( xQueue ) != uxModelCount )
+    {
+        ulBadItems++;
+    }
+
+    vQueueDelete( xQueue );
+}
+/*-----------------------------------------------------------*/
+
+/* xQueueOverwrite() only applies to queues of one item. */
+static void prvTestOverwrite( size_t xSize )
+{
+    QueueHandle_t xQueue = xQueueCreate( 1, xSize );
+    uint8_t ucItem[ testMAX_SIZE + 8 ] __attribute__( ( aligned( 8 ) ) );
+    uint8_t ucBuffer[ testMAX_SIZE + 8 ] __attribute__( ( aligned( 8 ) ) );
+    size_t xOffset;
+    int iRound;
+
+    uxModelHead = 0;
+
+    for( iRound = 0; iRound < 20; iRound++ )
+    {
+        xOffset = prvRandom() % 4U;
+        prvMakeItem( &( ucItem[ xOffset ] ), xSize, ( uint32_t ) iRound );
+        ( void ) xQueueOverwrite( xQueue, &( ucItem[ xOffset ] ) );
+
+        ulModel[ 0 ] = ( uint32_t ) iRound;
+        xOffset = prvRandom() % 4U;
+        memset( ucBuffer, testGUARD, sizeof( ucBuffer ) );
+        ( void ) xQueuePeek( xQueue, &( ucBuffer[ xOffset ] ), 0 );
+        prvCheckItem( ucBuffer, xOffset, xSize, "overwrite then peek" );
+        ulOperations++;
+    }
+
+    vQueueDelete( xQueue );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestTask( void * pvParameters )
+{
+    static const int iStorageOffsets[] = { -1, 0, 1, 2, 4 };
+    size_t xSize;
+    size_t i;
+
+    ( void ) pvParameters;
+
+    for( xSize = 1; xSize <= testMAX_SIZE; xSize++ )
+    {
+        for( i = 0; i < ( sizeof( iStorageOffsets ) / sizeof( iStorageOffsets[ 0 ] ) ); i++ )
+        {
+            prvTestQueue( xSize, iStorageOffsets[ i ] );
+        }
+
+        prvTestOverwrite( xSize );
+    }
+
+    printf( "%lu operations, %lu bad items, %lu bad copy types\n", ulOperations, ulBadItems, ulBadCopyTypes );
+
+    exit( ( ( ulBadItems != 0 ) || ( ulBadCopyTypes != 0 ) ) ? 1 : 0 );
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Benchmark.
+ */
+
+#define benchLENGTH    16
+#define benchPAIRS     1000000L
+#define benchRUNS      15
+
+static double prvNanoseconds( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( double ) xNow.tv_sec * 1e9 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static double prvBenchPair( size_t xSize,
+                            int iStorageOffset )
+{
+    QueueHandle_t xQueue = xQueueCreateStatic( benchLENGTH, xSize, &( ucStorage[ iStorageOffset ] ), &xStaticQueue );
+    uint64_t ullItem[ 2 ] = { 1, 2 }, ullBuffer[ 2 ];
+    double dStart, dTime, dBest = 1e30;
+    long l;
+    int iRun;
+
+    for( iRun = 0; iRun < benchRUNS; iRun++ )
+    {
+        dStart = prvNanoseconds();
+
+        for( l = 0; l < benchPAIRS; l++ )
+        {
+            ( void ) xQueueSend( xQueue, ullItem, 0 );
+            ( void ) xQueueReceive( xQueue, ullBuffer, 0 );
+        }
+
+        dTime = prvNanoseconds() - dStart;
+
+        if( dTime < dBest )
+        {
+            dBest = dTime;
+        }
+    }
+
+    vQueueDelete( xQueue );
+
+    return dBest / ( double ) benchPAIRS;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void * pvParameters )
+{
+    static const size_t xSizes[] = { 1, 2, 3, 4, 5, 8, 12 };
+    size_t i;
+
+    ( void ) pvParameters;
+
+    printf( "item bytes   aligned storage   storage offset by 1   (ns per send and receive, best of %d)\n", benchRUNS );
+
+    for( i = 0; i < ( sizeof( xSizes ) / sizeof( xSizes[ 0 ] ) ); i++ )
+    {
+        printf( "%10u   %15.2f   %19.2f\n", ( unsigned ) xSizes[ i ], prvBenchPair( xSizes[ i ], 0 ), prvBenchPair( xSizes[ i ], 1 ) );
+    }
+
+    exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    if( ( argc == 3 ) && ( strcmp( argv[ 1 ], "test" ) == 0 ) )
+    {
+        ullRandomState ^= strtoull( argv[ 2 ], NULL, 0 ) * 0x9E3779B97F4A7C15ULL;
+        ( void ) xTaskCreate( prvTestTask, "Test", configMINIMAL_STACK_SIZE, NULL, 1, NULL );
+    }
+    else if( ( argc == 2 ) && ( strcmp( argv[ 1 ], "bench" ) == 0 ) )
+    {
+        ( void ) xTaskCreate( prvBenchTask, "Bench", configMINIMAL_STACK_SIZE, NULL, 1, NULL );
+    }
+    else
+    {
+        printf( "usage: %s test <seed> | bench\n", argv[ 0 ] );
+        return 1;
+    }
+
+    vTaskStartScheduler();
+
+    return 1;
+}
@@ -0,0 +1,382 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test of the ready priority bit map of tasks.c, on the simulation port.  It
+ * includes tasks.c to reach uxTopReadyPriority and uxReadyPriorityWords[].
+ * run.sh builds it with 5, 32, 33, 200 and 1024 priorities, for each with
+ * configUSE_PORT_OPTIMISED_TASK_SELECTION 0 (the generic search), 1 (the
+ * port's count leading zeros, on one word or on the two level map of more
+ * than 32 priorities) and 2 (the de Bruijn search in tasks.c).
+ *
+ *   ready_bitmap_test test <seconds> <seed>
+ *       A controller at the top priority resumes workers and moves them to
+ *       random priorities each tick, favouring those either side of each
+ *       32 priority word.  Each worker that runs checks it is the highest
+ *       priority ready task, moves itself, resumes another or yields at
+ *       random, and suspends itself when done.  At each step the bit map
+ *       must match the ready lists exactly: a bit for each priority with
+ *       ready tasks and, with more than 32 priorities, a first level bit for
+ *       each word that is not zero.  With the generic search the top ready
+ *       priority must be at or above the highest priority with ready tasks.
+ *       With configUSE_PORT_OPTIMISED_TASK_SELECTION 2 the de Bruijn search
+ *       is first checked against __builtin_clz().  Prints the order in which
+ *       the workers ran as a hash, which must not depend on the search used.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tasks.c"
+#include "sim.h"
+
+#define testWORKERS          16
+#define testTOP_PRIORITY     ( ( UBaseType_t ) configMAX_PRIORITIES - 1U )
+
+static TaskHandle_t xWorkers[ testWORKERS ];
+static UBaseType_t uxModelPriority[ testWORKERS ];
+static BaseType_t xModelReady[ testWORKERS ];
+
+static unsigned long ulRounds = 0, ulRuns = 0, ulErrors = 0;
+static uint64_t ullTrace = 1469598103934665603ULL;
+static uint64_t ullRandomState = 88172645463325252ULL;
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    ullRandomState ^= ullRandomState << 13;
+    ullRandomState ^= ullRandomState >> 7;
+    ullRandomState ^= ullRandomState << 17;
+
+    return ( uint32_t ) ullRandomState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvError( const char * pcWhat )
+{
+    if( ulErrors++ < 5 )
+    {
+        printf( "%s at tick %lu\n", pcWhat, ( unsigned long ) xTaskGetTickCount() );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* A worker priority, half the time one either side of a word of the bit
+ * map. */
+static UBaseType_t prvInterestingPriority( void )
+{
+    UBaseType_t uxPriority;
+
+    if( ( prvRandom() % 2U ) == 0U )
+    {
+        uxPriority = ( ( UBaseType_t ) ( prvRandom() % ( ( configMAX_PRIORITIES / 32U ) + 1U ) ) * 32U ) + ( UBaseType_t ) ( prvRandom() % 3U ) - 1U;
+    }
+    else
+    {
+        uxPriority = ( UBaseType_t ) prvRandom();
+    }
+
+    /* Between the idle task and the controller. */
+    return 1U + ( uxPriority % ( testTOP_PRIORITY - 1U ) );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 2 )
+
+    static void prvCheckHighestSetBit( void )
+    {
+        /* Restored after, so the tasks see the same random numbers as with
+         * the other searches. */
+        const uint64_t ullSavedRandomState = ullRandomState;
+        uint32_t ulBits;
+        int iBit, i;
+
+        for( iBit = 0; iBit < 32; iBit++ )
+        {
+            for( i = 0; i < 10000; i++ )
+            {
+                ulBits = ( 1UL << iBit ) | ( prvRandom() & ( ( 1UL << iBit ) - 1UL ) );
+
+                if( i == 1 )
+                {
+                    ulBits = ( uint32_t ) ( ( 2ULL << iBit ) - 1ULL );
+                }
+                else if( i == 0 )
+                {
+                    ulBits = 1UL << iBit;
+                }
+
+                if( prvGetHighestSetBit( ulBits ) != ( UBaseType_t ) ( 31 - __builtin_clz( ulBits ) ) )
+                {
+                    printf( "highest set bit of 0x%08lx given as %lu\n", ( unsigned long ) ulBits, ( unsigned long ) prvGetHighestSetBit( ulBits ) );
+                    prvError( "FAIL: prvGetHighestSetBit() gave the wrong bit" );
+                }
+            }
+        }
+
+        ullRandomState = ullSavedRandomState;
+    }
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+/*-----------------------------------------------------------*/
+
+/* Checks the bit map against the ready lists, and returns the highest
+ * priority it gives. */
+static UBaseType_t prvCheckReadyBitmap( void )
+{
+    UBaseType_t uxPriority, uxHighestReady = 0, uxTopPriority;
+    BaseType_t xHasReadyTasks;
+
+    taskENTER_CRITICAL();
+    {
+        for( uxPriority = 0; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+        {
+            xHasReadyTasks = ( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxPriority ] ) ) == pdFALSE ) ? pdTRUE : pdFALSE;
+
+            if( xHasReadyTasks != pdFALSE )
+            {
+                uxHighestReady = uxPriority;
+            }
+
+            #if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION != 0 ) && ( configMAX_PRIORITIES > 32 ) )
+            {
+                if( ( ( ( uxReadyPriorityWords[ uxPriority >> 5 ] >> ( uxPriority & 31U ) ) & 1U ) != 0U ) != ( xHasReadyTasks != pdFALSE ) )
+                {
+                    printf( "priority %lu\n", ( unsigned long ) uxPriority );
+                    prvError( "FAIL: a second level bit does not match its ready list" );
+                }
+            }
+            #elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION != 0 )
+            {
+                if( ( ( ( uxTopReadyPriority >> uxPriority ) & 1U ) != 0U ) != ( xHasReadyTasks != pdFALSE ) )
+                {
+                    printf( "priority %lu\n", ( unsigned long ) uxPriority );
+                    prvError( "FAIL: a ready priority bit does not match its ready list" );
+                }
+            }
+            #endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+        }
+
+        #if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION != 0 ) && ( configMAX_PRIORITIES > 32 ) )
+        {
+            UBaseType_t uxWord;
+
+            for( uxWord = 0; uxWord < 32U; uxWord++ )
+            {
+                BaseType_t xWordInUse = ( uxWord < ( ( configMAX_PRIORITIES + 31U ) / 32U ) ) && ( uxReadyPriorityWords[ uxWord ] != 0U );
+
+                if( ( ( ( uxTopReadyPriority >> uxWord ) & 1U ) != 0U ) != ( xWordInUse != pdFALSE ) )
+                {
+                    printf( "word %lu\n", ( unsigned long ) uxWord );
+                    prvError( "FAIL: a first level bit does not match its second level word" );
+                }
+            }
+        }
+        #endif
+
+        #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION != 0 )
+        {
+            taskGET_HIGHEST_READY_PRIORITY( uxTopPriority );
+
+            if( uxTopPriority != uxHighestReady )
+            {
+                printf( "highest ready priority %lu given as %lu\n", ( unsigned long ) uxHighestReady, ( unsigned long ) uxTopPriority );
+                prvError( "FAIL: the bit map gave the wrong highest ready priority" );
+            }
+        }
+        #else
+        {
+            if( uxTopReadyPriority < uxHighestReady )
+            {
+                prvError( "FAIL: the top ready priority is below a priority with ready tasks" );
+            }
+
+            ( void ) uxTopPriority;
+        }
+        #endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+    }
+    taskEXIT_CRITICAL();
+
+    return uxHighestReady;
+}
+/*-----------------------------------------------------------*/
+
+/* Called by a worker each time it runs. */
+static void prvCheckRunning( int iWorker )
+{
+    UBaseType_t uxHighestModel = 0;
+    int i;
+
+    for( i = 0; i < testWORKERS; i++ )
+    {
+        if( ( xModelReady[ i ] != pdFALSE ) && ( uxModelPriority[ i ] > uxHighestModel ) )
+        {
+            uxHighestModel = uxModelPriority[ i ];
+        }
+    }
+
+    if( ( uxTaskPriorityGet( NULL ) != uxModelPriority[ iWorker ] ) || ( uxHighestModel != uxModelPriority[ iWorker ] ) )
+    {
+        printf( "worker at %lu ran with a worker at %lu ready\n", ( unsigned long ) uxTaskPriorityGet( NULL ), ( unsigned long ) uxHighestModel );
+        prvError( "FAIL: a worker ran while a higher priority worker was ready" );
+    }
+
+    if( prvCheckReadyBitmap() != uxModelPriority[ iWorker ] )
+    {
+        prvError( "FAIL: the ready lists do not match the model" );
+    }
+
+    ulRuns++;
+    ullTrace = ( ullTrace ^ ( ( uint64_t ) xTaskGetTickCount() << 16 ) ^ ( uint64_t ) iWorker ) * 1099511628211ULL;
+    ullTrace = ( ullTrace ^ uxModelPriority[ iWorker ] ) * 1099511628211ULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void * pvParameters )
+{
+    const int iWorker = ( int ) ( intptr_t ) pvParameters;
+    int iOther;
+
+    for( ; ; )
+    {
+        prvCheckRunning( iWorker );
+
+        switch( prvRandom() % 4U )
+        {
+            case 0:
+
+                /* The model is updated first, as a higher priority worker
+                 * runs before the call returns. */
+                iOther = ( int ) ( prvRandom() % testWORKERS );
+
+                if( xModelReady[ iOther ] == pdFALSE )
+                {
+                    xModelReady[ iOther ] = pdTRUE;
+                    vTaskResume( xWorkers[ iOther ] );
+                    prvCheckRunning( iWorker );
+                }
+
+                break;
+
+            case 1:
+                uxModelPriority[ iWorker ] = prvInterestingPriority();
+                vTaskPrioritySet( NULL, uxModelPriority[ iWorker ] );
+                prvCheckRunning( iWorker );
+                break;
+
+            case 2:
+                taskYIELD();
+                prvCheckRunning( iWorker );
+                break;
+
+            default:
+                break;
+        }
+
+        vSimRun( prvRandom() % 2000U );
+        xModelReady[ iWorker ] = pdFALSE;
+        vTaskSuspend( NULL );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvControllerTask( void * pvParameters )
+{
+    int i, iWorker;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        /* Workers the tick preempted are still ready. */
+        for( i = ( int ) ( prvRandom() % 8U ); i >= 0; i-- )
+        {
+            iWorker = ( int ) ( prvRandom() % testWORKERS );
+
+            if( ( prvRandom() % 2U ) == 0U )
+            {
+                uxModelPriority[ iWorker ] = prvInterestingPriority();
+                vTaskPrioritySet( xWorkers[ iWorker ], uxModelPriority[ iWorker ] );
+            }
+
+            if( xModelReady[ iWorker ] == pdFALSE )
+            {
+                xModelReady[ iWorker ] = pdTRUE;
+                vTaskResume( xWorkers[ iWorker ] );
+            }
+
+            if( prvCheckReadyBitmap() != testTOP_PRIORITY )
+            {
+                prvError( "FAIL: the controller is not the highest priority ready task" );
+            }
+        }
+
+        ulRounds++;
+        vTaskDelay( 1 );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static int prvEnd( void )
+{
+    printf( "%lu priorities: %lu rounds, %lu runs, order %016llx, %lu errors\n", ( unsigned long ) configMAX_PRIORITIES, ulRounds, ulRuns,
+            ( unsigned long long ) ullTrace, ulErrors );
+
+    return ( ulErrors != 0U ) ? 1 : 0;
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    int i;
+
+    if( ( argc != 4 ) || ( strcmp( argv[ 1 ], "test" ) != 0 ) )
+    {
+        printf( "usage: %s test <seconds> <seed>\n", argv[ 0 ] );
+        return 1;
+    }
+
+    ullRandomState ^= strtoull( argv[ 3 ], NULL, 0 ) * 0x9E3779B97F4A7C15ULL;
+    vSimSetEndTime( simSECONDS( atof( argv[ 2 ] ) ), prvEnd );
+
+    #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 2 )
+    {
+        prvCheckHighestSetBit();
+    }
+    #endif
+
+    for( i = 0; i < testWORKERS; i++ )
+    {
+        uxModelPriority[ i ] = prvInterestingPriority();
+        ( void ) xTaskCreate( prvWorkerTask, "Worker", configMINIMAL_STACK_SIZE, ( void * ) ( intptr_t ) i, uxModelPriority[ i ], &( xWorkers[ i ] ) );
+        vTaskSuspend( xWorkers[ i ] );
+    }
+
+    ( void ) xTaskCreate( prvControllerTask, "Controller", configMINIMAL_STACK_SIZE, NULL, testTOP_PRIORITY, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
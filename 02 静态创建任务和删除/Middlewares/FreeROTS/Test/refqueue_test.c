@@ -0,0 +1,526 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test of the reference queues of refqueue.c on the simulation port.
+ *
+ *   refqueue_test test <seconds> <seed> <static|dynamic>
+ *       Two producer tasks and an interrupt acquire slots from a queue of 4
+ *       slots of 37 bytes, fill each with a sequence number, the producer's
+ *       number and a pattern, and send it, now and then giving a slot back
+ *       unused instead.  A higher and a lower priority consumer task receive
+ *       the slots, hold them for a while and release them from the task or
+ *       from an interrupt, scribbling over them first.  Every item must be
+ *       received exactly once and intact, each consumer must receive each
+ *       producer's items in the order they were sent, no slot may be handed
+ *       to two owners at once, the slots must be aligned, inside the storage
+ *       and not overlap, and the free and waiting counts must never exceed a
+ *       model of the slot states.  The producers stop at the given time and
+ *       the consumers then have a second to empty the queue, after which
+ *       every slot must be back in the pool.
+ *
+ *   refqueue_test misuse <release-twice|send-received|middle|foreign>
+ *       Releases a slot twice, sends a slot that was received, releases a
+ *       pointer into the middle of a slot, or releases a pointer to memory
+ *       outside the queue.  Each must fail configASSERT(), so the test exits
+ *       with code 2; it exits with 1 if the misuse is not caught.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "refqueue.h"
+#include "sim.h"
+
+#define testSLOTS        4
+#define testSLOT_SIZE    37
+#define testPRODUCERS    3
+#define testMAX_ITEMS    ( 1UL << 20 )
+
+/* The states of the slots in the test's own model.  The model is updated
+ * before a slot is passed on and after it is taken, so the kernel's counts of
+ * free and waiting slots can only ever be lower than the model's. */
+#define testFREE         0
+#define testACQUIRED     1
+#define testQUEUED       2
+#define testRECEIVED     3
+
+typedef struct
+{
+    uint32_t ulSequence;
+    uint8_t ucProducer;
+} ItemHeader_t;
+
+static RefQueueHandle_t xRefQueue;
+static uint8_t ucStorage[ refqueueSTORAGE_SIZE( testSLOTS, testSLOT_SIZE ) ] __attribute__( ( aligned( portBYTE_ALIGNMENT ) ) );
+static RefQueue_t xRefQueueBuffer;
+static BaseType_t xStatic;
+static uint64_t ullStopTime;
+
+static uint8_t * pucSlots[ testSLOTS ];
+static UBaseType_t uxSlotsSeen = 0;
+static int iSlotStates[ testSLOTS ];
+
+static uint8_t ucReceived[ testPRODUCERS ][ testMAX_ITEMS / 8 ];
+static uint32_t ulSent[ testPRODUCERS ];
+static uint32_t ulReceivedCount[ testPRODUCERS ];
+static uint32_t ulLastReceived[ 2 ][ testPRODUCERS ];
+static BaseType_t xReceivedAny[ 2 ][ testPRODUCERS ];
+static unsigned long ulUnused = 0, ulAcquireTimeouts = 0, ulAcquireFailsFromISR = 0, ulReleasedFromISR = 0, ulCountChecks = 0;
+static unsigned long ulErrors = 0;
+static uint64_t ullRandomState = 88172645463325252ULL;
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    ullRandomState ^= ullRandomState << 13;
+    ullRandomState ^= ullRandomState >> 7;
+    ullRandomState ^= ullRandomState << 17;
+
+    return ( uint32_t ) ullRandomState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvError( const char * pcMessage,
+                      unsigned long ulValue )
+{
+    if( ulErrors++ < 5 )
+    {
+        printf( "FAIL: %s (%lu) at tick %lu\n", pcMessage, ulValue, ( unsigned long ) xTaskGetTickCount() );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Returns the number the test gives the slot at pucSlot, giving the next
+ * number to a slot not seen before after checking it is a slot of its own. */
+static int prvSlotIndex( uint8_t * pucSlot )
+{
+    UBaseType_t i;
+
+    for( i = 0; i < uxSlotsSeen; i++ )
+    {
+        if( pucSlots[ i ] == pucSlot )
+        {
+            return ( int ) i;
+        }
+    }
+
+    if( ( ( uintptr_t ) pucSlot % portBYTE_ALIGNMENT ) != 0U )
+    {
+        prvError( "slot not aligned", ( unsigned long ) ( ( uintptr_t ) pucSlot % portBYTE_ALIGNMENT ) );
+    }
+
+    if( ( xStatic != pdFALSE ) && ( ( pucSlot < ucStorage ) || ( ( pucSlot + testSLOT_SIZE ) > &( ucStorage[ sizeof( ucStorage ) ] ) ) ) )
+    {
+        prvError( "slot outside the storage", ( unsigned long ) ( pucSlot - ucStorage ) );
+    }
+
+    for( i = 0; i < uxSlotsSeen; i++ )
+    {
+        if( ( pucSlot < ( pucSlots[ i ] + testSLOT_SIZE ) ) && ( pucSlots[ i ] < ( pucSlot + testSLOT_SIZE ) ) )
+        {
+            prvError( "slots overlap", ( unsigned long ) i );
+        }
+    }
+
+    if( uxSlotsSeen == testSLOTS )
+    {
+        prvError( "more slots than the queue holds", ( unsigned long ) uxSlotsSeen );
+
+        return 0;
+    }
+
+    pucSlots[ uxSlotsSeen ] = pucSlot;
+
+    return ( int ) uxSlotsSeen++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMoveSlot( uint8_t * pucSlot,
+                         int iFrom,
+                         int iTo )
+{
+    int iSlot = prvSlotIndex( pucSlot );
+
+    if( iSlotStates[ iSlot ] != iFrom )
+    {
+        prvError( "slot handed over in the wrong state", ( unsigned long ) iSlotStates[ iSlot ] );
+    }
+
+    iSlotStates[ iSlot ] = iTo;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckCounts( void )
+{
+    UBaseType_t uxFree = 0, uxQueued = 0;
+    int i;
+
+    taskENTER_CRITICAL();
+    {
+        /* Slots not yet seen are free in the model. */
+        for( i = 0; i < testSLOTS; i++ )
+        {
+            uxFree += ( iSlotStates[ i ] == testFREE ) ? 1U : 0U;
+            uxQueued += ( iSlotStates[ i ] == testQUEUED ) ? 1U : 0U;
+        }
+
+        if( uxRefQueueSlotsFree( xRefQueue ) > uxFree )
+        {
+            prvError( "more slots free than were released", ( unsigned long ) uxRefQueueSlotsFree( xRefQueue ) );
+        }
+
+        if( uxRefQueueSlotsWaiting( xRefQueue ) > uxQueued )
+        {
+            prvError( "more slots waiting than were sent", ( unsigned long ) uxRefQueueSlotsWaiting( xRefQueue ) );
+        }
+
+        ulCountChecks++;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static uint8_t prvPattern( uint32_t ulSequence,
+                           int iProducer,
+                           size_t xByte )
+{
+    return ( uint8_t ) ( ( ulSequence * 31U ) + ( ( uint32_t ) iProducer * 7U ) + ( uint32_t ) xByte );
+}
+/*-----------------------------------------------------------*/
+
+static void prvFillSlot( uint8_t * pucSlot,
+                         int iProducer )
+{
+    ItemHeader_t xHeader;
+    size_t x;
+
+    xHeader.ulSequence = ulSent[ iProducer ];
+    xHeader.ucProducer = ( uint8_t ) iProducer;
+    memcpy( pucSlot, &xHeader, sizeof( xHeader ) );
+
+    for( x = sizeof( xHeader ); x < testSLOT_SIZE; x++ )
+    {
+        pucSlot[ x ] = prvPattern( xHeader.ulSequence, iProducer, x );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckSlot( int iConsumer,
+                          const uint8_t * pucSlot )
+{
+    ItemHeader_t xHeader;
+    size_t x;
+
+    memcpy( &xHeader, pucSlot, sizeof( xHeader ) );
+
+    if( ( xHeader.ucProducer >= testPRODUCERS ) || ( xHeader.ulSequence >= ulSent[ xHeader.ucProducer ] ) )
+    {
+        prvError( "received an item that was not sent", ( unsigned long ) xHeader.ulSequence );
+
+        return;
+    }
+
+    for( x = sizeof( xHeader ); x < testSLOT_SIZE; x++ )
+    {
+        if( pucSlot[ x ] != prvPattern( xHeader.ulSequence, xHeader.ucProducer, x ) )
+        {
+            prvError( "item damaged", ( unsigned long ) x );
+            break;
+        }
+    }
+
+    if( ( ucReceived[ xHeader.ucProducer ][ xHeader.ulSequence / 8U ] & ( 1U << ( xHeader.ulSequence % 8U ) ) ) != 0U )
+    {
+        prvError( "item received twice", ( unsigned long ) xHeader.ulSequence );
+    }
+    else if( ( xReceivedAny[ iConsumer ][ xHeader.ucProducer ] != pdFALSE ) &&
+             ( xHeader.ulSequence <= ulLastReceived[ iConsumer ][ xHeader.ucProducer ] ) )
+    {
+        prvError( "item received out of order", ( unsigned long ) xHeader.ulSequence );
+    }
+
+    ucReceived[ xHeader.ucProducer ][ xHeader.ulSequence / 8U ] |= ( uint8_t ) ( 1U << ( xHeader.ulSequence % 8U ) );
+    ulLastReceived[ iConsumer ][ xHeader.ucProducer ] = xHeader.ulSequence;
+    xReceivedAny[ iConsumer ][ xHeader.ucProducer ] = pdTRUE;
+    ulReceivedCount[ xHeader.ucProducer ]++;
+}
+/*-----------------------------------------------------------*/
+
+/* Sends a slot from the interrupt producer, if one is free. */
+static void prvInterruptProducer( void )
+{
+    uint8_t * pucSlot;
+    BaseType_t xWoken = pdFALSE;
+
+    vSimEnterISR();
+    pucSlot = ( uint8_t * ) pvRefQueueAcquireFromISR( xRefQueue );
+
+    if( pucSlot != NULL )
+    {
+        prvMoveSlot( pucSlot, testFREE, testACQUIRED );
+        prvFillSlot( pucSlot, 2 );
+        prvMoveSlot( pucSlot, testACQUIRED, testQUEUED );
+        ulSent[ 2 ]++;
+        vRefQueueSendFromISR( xRefQueue, pucSlot, &xWoken );
+    }
+    else
+    {
+        ulAcquireFailsFromISR++;
+    }
+
+    vSimExitISR( xWoken );
+}
+/*-----------------------------------------------------------*/
+
+static void prvProducerTask( void * pvParameters )
+{
+    int iProducer = ( int ) ( intptr_t ) pvParameters;
+    uint8_t * pucSlot;
+    TickType_t xWait, xStart;
+
+    while( ( ullSimTime < ullStopTime ) && ( ulSent[ iProducer ] < testMAX_ITEMS ) && ( ulSent[ 2 ] < testMAX_ITEMS ) )
+    {
+        xWait = ( ( prvRandom() % 4U ) == 0U ) ? portMAX_DELAY : ( TickType_t ) ( prvRandom() % 4U );
+        xStart = xTaskGetTickCount();
+        pucSlot = ( uint8_t * ) pvRefQueueAcquire( xRefQueue, xWait );
+
+        if( pucSlot == NULL )
+        {
+            if( ( xTaskGetTickCount() - xStart ) < xWait )
+            {
+                prvError( "acquire gave up before its timeout", ( unsigned long ) ( xTaskGetTickCount() - xStart ) );
+            }
+
+            ulAcquireTimeouts++;
+        }
+        else
+        {
+            prvMoveSlot( pucSlot, testFREE, testACQUIRED );
+            prvFillSlot( pucSlot, iProducer );
+            vSimRun( prvRandom() % 2000U );
+
+            if( ( prvRandom() % 16U ) == 0U )
+            {
+                prvMoveSlot( pucSlot, testACQUIRED, testFREE );
+                vRefQueueRelease( xRefQueue, pucSlot );
+                ulUnused++;
+            }
+            else
+            {
+                /* Counted first, as a consumer may receive the item before
+                 * vRefQueueSend() returns. */
+                prvMoveSlot( pucSlot, testACQUIRED, testQUEUED );
+                ulSent[ iProducer ]++;
+                vRefQueueSend( xRefQueue, pucSlot );
+            }
+        }
+
+        if( ( iProducer == 0 ) && ( ( prvRandom() % 3U ) == 0U ) )
+        {
+            prvInterruptProducer();
+        }
+
+        prvCheckCounts();
+        vSimRun( prvRandom() % 3000U );
+    }
+
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvConsumerTask( void * pvParameters )
+{
+    int iConsumer = ( int ) ( intptr_t ) pvParameters;
+    uint8_t * pucSlot;
+    BaseType_t xWoken;
+
+    for( ; ; )
+    {
+        pucSlot = ( uint8_t * ) pvRefQueueReceive( xRefQueue, ( ( prvRandom() % 2U ) == 0U ) ? portMAX_DELAY : 7U );
+
+        if( pucSlot != NULL )
+        {
+            prvMoveSlot( pucSlot, testQUEUED, testRECEIVED );
+            prvCheckSlot( iConsumer, pucSlot );
+
+            /* Sometimes held while blocked, as by a driver waiting for a
+             * transfer, so the producers run and use up the pool. */
+            if( ( prvRandom() % 4U ) == 0U )
+            {
+                vTaskDelay( 1U + ( prvRandom() % 2U ) );
+            }
+            else
+            {
+                vSimRun( prvRandom() % ( ( iConsumer == 0 ) ? 3000U : 8000U ) );
+            }
+
+            /* Scribbled over, so a slot received again without being filled
+             * again is seen as damaged. */
+            memset( pucSlot, 0xa5, testSLOT_SIZE );
+            prvMoveSlot( pucSlot, testRECEIVED, testFREE );
+
+            if( ( prvRandom() % 4U ) == 0U )
+            {
+                xWoken = pdFALSE;
+                vSimEnterISR();
+                vRefQueueReleaseFromISR( xRefQueue, pucSlot, &xWoken );
+                vSimExitISR( xWoken );
+                ulReleasedFromISR++;
+            }
+            else
+            {
+                vRefQueueRelease( xRefQueue, pucSlot );
+            }
+
+            prvCheckCounts();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static int prvTestEnd( void )
+{
+    unsigned long ulMissing = 0, ulSentTotal = 0, ulReceivedTotal = 0;
+    uint32_t ulSequence;
+    int i;
+
+    for( i = 0; i < testPRODUCERS; i++ )
+    {
+        for( ulSequence = 0; ulSequence < ulSent[ i ]; ulSequence++ )
+        {
+            if( ( ucReceived[ i ][ ulSequence / 8U ] & ( 1U << ( ulSequence % 8U ) ) ) == 0U )
+            {
+                ulMissing++;
+            }
+        }
+
+        ulSentTotal += ulSent[ i ];
+        ulReceivedTotal += ulReceivedCount[ i ];
+    }
+
+    for( i = 0; i < testSLOTS; i++ )
+    {
+        if( iSlotStates[ i ] != testFREE )
+        {
+            prvError( "slot still owned at the end", ( unsigned long ) i );
+        }
+    }
+
+    if( ( uxRefQueueSlotsFree( xRefQueue ) != testSLOTS ) || ( uxRefQueueSlotsWaiting( xRefQueue ) != 0U ) )
+    {
+        prvError( "slots not all back in the pool", ( unsigned long ) uxRefQueueSlotsFree( xRefQueue ) );
+    }
+
+    if( ( ulMissing != 0U ) || ( ulReceivedTotal != ulSentTotal ) )
+    {
+        prvError( "items lost", ulMissing );
+    }
+
+    printf( "%s: %lu sent, %lu of them from interrupts, %lu received, %lu missing, %lu given back unused, %lu released from interrupts, "
+            "%lu acquire timeouts, %lu interrupts found no slot, %lu count checks, %lu errors\n",
+            ( xStatic != pdFALSE ) ? "static" : "dynamic", ulSentTotal, ( unsigned long ) ulSent[ 2 ], ulReceivedTotal, ulMissing, ulUnused,
+            ulReleasedFromISR, ulAcquireTimeouts, ulAcquireFailsFromISR, ulCountChecks, ulErrors );
+
+    return ( ( ulErrors != 0U ) || ( ulSentTotal == 0U ) ) ? 1 : 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMisuseTask( void * pvParameters )
+{
+    const char * pcMisuse = ( const char * ) pvParameters;
+    uint8_t ucOutside[ testSLOT_SIZE ];
+    uint8_t * pucSlot;
+
+    pucSlot = ( uint8_t * ) pvRefQueueAcquire( xRefQueue, 0 );
+
+    if( strcmp( pcMisuse, "release-twice" ) == 0 )
+    {
+        vRefQueueSend( xRefQueue, pucSlot );
+        pucSlot = ( uint8_t * ) pvRefQueueReceive( xRefQueue, 0 );
+        vRefQueueRelease( xRefQueue, pucSlot );
+        vRefQueueRelease( xRefQueue, pucSlot );
+    }
+    else if( strcmp( pcMisuse, "send-received" ) == 0 )
+    {
+        vRefQueueSend( xRefQueue, pucSlot );
+        pucSlot = ( uint8_t * ) pvRefQueueReceive( xRefQueue, 0 );
+        vRefQueueSend( xRefQueue, pucSlot );
+    }
+    else if( strcmp( pcMisuse, "middle" ) == 0 )
+    {
+        vRefQueueRelease( xRefQueue, pucSlot + 1 );
+    }
+    else if( strcmp( pcMisuse, "foreign" ) == 0 )
+    {
+        vRefQueueRelease( xRefQueue, ucOutside );
+    }
+
+    printf( "FAIL: %s was not caught\n", pcMisuse );
+    exit( 1 );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    if( ( argc == 5 ) && ( strcmp( argv[ 1 ], "test" ) == 0 ) )
+    {
+        ullRandomState ^= strtoull( argv[ 3 ], NULL, 0 ) * 0x9E3779B97F4A7C15ULL;
+        ullStopTime = simSECONDS( atof( argv[ 2 ] ) );
+        xStatic = ( strcmp( argv[ 4 ], "static" ) == 0 ) ? pdTRUE : pdFALSE;
+
+        if( xStatic != pdFALSE )
+        {
+            xRefQueue = xRefQueueCreateStatic( testSLOTS, testSLOT_SIZE, ucStorage, &xRefQueueBuffer );
+        }
+        else
+        {
+            xRefQueue = xRefQueueCreate( testSLOTS, testSLOT_SIZE );
+        }
+
+        ( void ) xTaskCreate( prvProducerTask, "Prod0", configMINIMAL_STACK_SIZE, ( void * ) 0, 2, NULL );
+        ( void ) xTaskCreate( prvProducerTask, "Prod1", configMINIMAL_STACK_SIZE, ( void * ) 1, 1, NULL );
+        ( void ) xTaskCreate( prvConsumerTask, "Cons0", configMINIMAL_STACK_SIZE, ( void * ) 0, 3, NULL );
+        ( void ) xTaskCreate( prvConsumerTask, "Cons1", configMINIMAL_STACK_SIZE, ( void * ) 1, 1, NULL );
+        vSimSetEndTime( ullStopTime + simSECONDS( 1 ), prvTestEnd );
+    }
+    else if( ( argc == 3 ) && ( strcmp( argv[ 1 ], "misuse" ) == 0 ) )
+    {
+        xRefQueue = xRefQueueCreateStatic( testSLOTS, testSLOT_SIZE, ucStorage, &xRefQueueBuffer );
+        ( void ) xTaskCreate( prvMisuseTask, "Misuse", configMINIMAL_STACK_SIZE, argv[ 2 ], 1, NULL );
+    }
+    else
+    {
+        printf( "usage: %s test <seconds> <seed> <static|dynamic>\n", argv[ 0 ] );
+        printf( "       %s misuse <release-twice|send-received|middle|foreign>\n", argv[ 0 ] );
+        return 1;
+    }
+
+    vTaskStartScheduler();
+
+    return 1;
+}
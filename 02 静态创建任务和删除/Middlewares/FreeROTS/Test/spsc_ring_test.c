@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test of the lock free side of the single producer single consumer ring
+ * (configUSE_SPSC_RINGS) on two host threads.
+ *
+ *   spsc_ring_test <length> <items>
+ *
+ * A producer thread pushes the given number of items onto a ring of the
+ * given length with xSpscRingPush() while a consumer thread pops them with
+ * xSpscRingPop(), both spinning when the ring is full or empty.  Each item
+ * carries its sequence number in three words, so an item that is lost,
+ * repeated, reordered or read before it was completely written fails the
+ * test, as does an item left on the ring at the end.
+ *
+ * On a host with more than one core the threads run in parallel, so this
+ * checks the ring's ordering of the index and item accesses, which rely on
+ * portMEMORY_BARRIER().  The host port makes that a C11 sequentially
+ * consistent fence.  The scheduler is not started.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "spscring.h"
+
+typedef struct
+{
+    uint32_t ulSequence;
+    uint32_t ulInverse;
+    uint32_t ulHash;
+} TestItem_t;
+
+static SpscRingHandle_t xRing;
+static uint32_t ulItems;
+static unsigned long ulFull = 0, ulEmpty = 0;
+/*-----------------------------------------------------------*/
+
+static void prvFillItem( TestItem_t * pxItem,
+                         uint32_t ulSequence )
+{
+    pxItem->ulSequence = ulSequence;
+    pxItem->ulInverse = ~ulSequence;
+    pxItem->ulHash = ulSequence * 2654435761UL;
+}
+/*-----------------------------------------------------------*/
+
+static void * prvProducer( void * pvParameters )
+{
+    TestItem_t xItem;
+    uint32_t ulSequence = 0;
+
+    ( void ) pvParameters;
+
+    while( ulSequence < ulItems )
+    {
+        prvFillItem( &xItem, ulSequence );
+
+        if( xSpscRingPush( xRing, &xItem ) == pdPASS )
+        {
+            ulSequence++;
+        }
+        else
+        {
+            ulFull++;
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void * prvConsumer( void * pvParameters )
+{
+    TestItem_t xItem, xExpected;
+    uint32_t ulSequence = 0;
+    unsigned long ulBad = 0;
+
+    ( void ) pvParameters;
+
+    while( ulSequence < ulItems )
+    {
+        if( xSpscRingPop( xRing, &xItem ) == pdPASS )
+        {
+            prvFillItem( &xExpected, ulSequence );
+
+            if( ( xItem.ulSequence != xExpected.ulSequence ) || ( xItem.ulInverse != xExpected.ulInverse ) || ( xItem.ulHash != xExpected.ulHash ) )
+            {
+                if( ulBad++ < 5 )
+                {
+                    printf( "item %lu read as %lu\n", ( unsigned long ) ulSequence, ( unsigned long ) xItem.ulSequence );
+                }
+            }
+
+            ulSequence++;
+        }
+        else
+        {
+            ulEmpty++;
+            sched_yield();
+        }
+    }
+
+    return ( void * ) ulBad;
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    UBaseType_t uxLength;
+    UBaseType_t uxLeft;
+    pthread_t xProducer, xConsumer;
+    void * pvBad;
+
+    if( argc != 3 )
+    {
+        printf( "usage: %s <length> <items>\n", argv[ 0 ] );
+        return 1;
+    }
+
+    uxLength = ( UBaseType_t ) atol( argv[ 1 ] );
+    ulItems = ( uint32_t ) strtoul( argv[ 2 ], NULL, 0 );
+    xRing = xSpscRingCreate( uxLength, sizeof( TestItem_t ), 1 );
+
+    if( xRing == NULL )
+    {
+        printf( "FAIL: the ring could not be created\n" );
+        return 1;
+    }
+
+    if( ( pthread_create( &xConsumer, NULL, prvConsumer, NULL ) != 0 ) ||
+        ( pthread_create( &xProducer, NULL, prvProducer, NULL ) != 0 ) )
+    {
+        printf( "FAIL: the threads could not be created\n" );
+        return 1;
+    }
+
+    ( void ) pthread_join( xProducer, NULL );
+    ( void ) pthread_join( xConsumer, &pvBad );
+    uxLeft = uxSpscRingItemsWaiting( xRing );
+
+    printf( "length=%lu items=%lu: %lu bad, %lu left, producer found it full %lu times, consumer found it empty %lu times\n",
+            ( unsigned long ) uxLength, ( unsigned long ) ulItems, ( unsigned long ) pvBad, ( unsigned long ) uxLeft, ulFull, ulEmpty );
+
+    return ( ( pvBad != NULL ) || ( uxLeft != 0 ) ) ? 1 : 0;
+}
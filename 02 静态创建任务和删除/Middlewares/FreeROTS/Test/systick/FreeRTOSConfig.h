@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/* Configuration for the SysTick model.  It follows the demo project's
+ * FreeRTOSConfig.h (72MHz core clocking the SysTick, 1kHz tick), and the
+ * options a test may change are only defined here if they were not already
+ * given on the command line. */
+
+#define configUSE_PREEMPTION                       1
+#define configIDLE_SHOULD_YIELD                    1
+#define configUSE_IDLE_HOOK                        0
+#define configUSE_TICK_HOOK                        0
+#define configCPU_CLOCK_HZ                         ( ( unsigned long ) 72000000 )
+#define configTICK_RATE_HZ                         ( ( TickType_t ) 1000 )
+#define configMINIMAL_STACK_SIZE                   ( ( unsigned short ) 128 )
+#define configMAX_TASK_NAME_LEN                    ( 16 )
+#define configTOTAL_HEAP_SIZE                      ( ( size_t ) ( 17 * 1024 ) )
+#define configUSE_16_BIT_TICKS                     0
+#define configSUPPORT_STATIC_ALLOCATION            1
+#define configSUPPORT_DYNAMIC_ALLOCATION           1
+#define configUSE_TIMERS                           0
+#define configKERNEL_INTERRUPT_PRIORITY            255
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY       191
+
+#ifndef configUSE_DYNAMIC_TICK
+    #define configUSE_DYNAMIC_TICK                 0
+#endif
+
+#ifndef configMAX_PRIORITIES
+    #define configMAX_PRIORITIES                   ( 5 )
+#endif
+
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+    #define configUSE_PORT_OPTIMISED_TASK_SELECTION    1
+#endif
+
+#ifndef configUSE_EDF_SCHEDULING
+    #define configUSE_EDF_SCHEDULING               0
+#endif
+#define configEDF_TASK_PRIORITY                    2
+
+#define INCLUDE_vTaskPrioritySet                   1
+#define INCLUDE_uxTaskPriorityGet                  1
+#define INCLUDE_vTaskDelete                        1
+#define INCLUDE_vTaskSuspend                       1
+#define INCLUDE_xTaskDelayUntil                    1
+#define INCLUDE_vTaskDelay                         1
+#define INCLUDE_xTaskGetSchedulerState             1
+#define INCLUDE_xTaskResumeFromISR                 1
+
+/* A failed assert prints where it failed and ends the test with exit code 2. */
+extern void vAssertCalled( const char * pcFile, int iLine );
+#define configASSERT( x )    do { if( ( x ) == 0 ) { vAssertCalled( __FILE__, __LINE__ ); } } while( 0 )
+
+#endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+#
+# Copies the SysTick code of the RVDS ARM_CM3 port into port_systick.inc, so
+# systick_model.h can run the port's own tick handling instead of a copy of it.
+#
+#   extract_port.py <kernel dir> <output dir>
+#
+# The code is found by the comments and preprocessor lines around it in
+# port.c, and the script fails if any of them is no longer there.
+
+import os
+import sys
+
+
+def section(text, start, end, after=None):
+    """Returns text from the first start up to and including the first end,
+    looking for end after the string after if one is given."""
+    begin = text.index(start)
+    finish = text.index(end, text.index(after) if after else begin)
+
+    return text[begin:finish + len(end)]
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit("usage: extract_port.py <kernel dir> <output dir>")
+
+    port = os.path.join(sys.argv[1], "portable", "RVDS", "ARM_CM3", "port.c")
+
+    with open(port, encoding="utf-8") as f:
+        text = f.read()
+
+    try:
+        # The tick state, up to the interrupt priority checks that follow it.
+        state = text[text.index("/*\n * The number of SysTick increments"):
+                     text.index("/*\n * Used by the portASSERT_IF_INTERRUPT_PRIORITY_INVALID()")]
+
+        # The dynamic tick prototypes.
+        prototypes = section(text,
+                             "#if ( configUSE_DYNAMIC_TICK == 1 )\n\n/*\n * Return the number",
+                             "#endif /* configUSE_DYNAMIC_TICK */")
+
+        # The SysTick handler and the dynamic tick functions.
+        handler = section(text,
+                          "#if ( configUSE_DYNAMIC_TICK == 0 )\n\n    void xPortSysTickHandler",
+                          "#endif /* configUSE_DYNAMIC_TICK */",
+                          after="void vPortUpdateTickInterrupt")
+
+        # vPortSetupTimerInterrupt(), which is weak in port.c.
+        setup = text[text.index("#if ( configOVERRIDE_DEFAULT_TICK_CONFIGURATION == 0 )"):
+                     text.index("#endif /* configOVERRIDE_DEFAULT_TICK_CONFIGURATION */")]
+        setup = setup.replace("__weak ", "") + "#endif\n"
+    except ValueError:
+        sys.exit("extract_port.py: %s no longer has the expected layout" % port)
+
+    os.makedirs(sys.argv[2], exist_ok=True)
+
+    with open(os.path.join(sys.argv[2], "port_systick.inc"), "w", encoding="utf-8") as f:
+        f.write("\n".join((state, prototypes, handler, setup)))
+
+
+if __name__ == "__main__":
+    main()
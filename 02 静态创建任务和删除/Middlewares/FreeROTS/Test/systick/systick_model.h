@@ -0,0 +1,417 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef SYSTICK_MODEL_H
+#define SYSTICK_MODEL_H
+
+/*
+ * A cycle level model of the Cortex-M3 SysTick timer, the PendSV and SysTick
+ * pending bits and BASEPRI, which runs the tick code of the RVDS port
+ * unchanged.  extract_port.py copies that code out of port.c into
+ * port_systick.inc, which is compiled here against the registers below.
+ *
+ * Tasks do not execute.  A test keeps, for each task, the number of cycles
+ * of work it has left, and calls the kernel for the task when that work is
+ * done, while the model advances time, takes the tick interrupt when it is
+ * pending and unmasked, and runs vTaskSwitchContext() when PendSV is pending.
+ *
+ * Include this header from one C++ file only.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+extern "C" {
+#include "FreeRTOS.h"
+#include "task.h"
+
+void vSimStartScheduler( void );
+void * pvSimCurrentTask( void );
+}
+
+/* Cycles in one tick period. */
+static const uint64_t ullSimCyclesPerTick = configCPU_CLOCK_HZ / configTICK_RATE_HZ;
+
+/* Cycle costs of the core.  ullTimerStopped is the time the SysTick stands
+ * still each time the port stops and restarts it, and matches the port's
+ * portMISSED_COUNTS_FACTOR.  A test can set them all to 0. */
+static struct
+{
+    uint64_t ullTimerStopped;
+    uint64_t ullTickInterrupt;
+    uint64_t ullContextSwitch;
+    uint64_t ullInterruptEntry;
+} xSimCosts = { 94, 150, 60, 12 };
+
+/* The simulated time in cycles, and the time the first tick period started. */
+static uint64_t ullSimNow = 0;
+static uint64_t ullSimTickZero = 0;
+static bool xSimTickZeroSet = false;
+
+/* The SysTick counter. */
+static struct
+{
+    bool xEnabled;
+    bool xInterruptEnabled;
+    bool xCountFlag;
+    uint32_t ulLoad;
+    uint32_t ulValue;
+} xSysTick;
+
+static bool xSysTickPending = false;
+static bool xPendSVPending = false;
+static uint32_t ulBasePri = 0;
+static UBaseType_t uxCriticalNesting = 0;
+
+static unsigned long ulSimTickInterrupts = 0;
+static unsigned long ulSimContextSwitches = 0;
+/*-----------------------------------------------------------*/
+
+extern "C" void vAssertCalled( const char * pcFile,
+                               int iLine )
+{
+    printf( "ASSERT %s:%d at cycle %llu\n", pcFile, iLine, ( unsigned long long ) ullSimNow );
+    exit( 2 );
+}
+
+extern "C" void vPortYield( void )
+{
+    xPendSVPending = true;
+}
+
+extern "C" uint32_t ulPortRaiseBASEPRI( void )
+{
+    uint32_t ulOriginal = ulBasePri;
+
+    ulBasePri = 1;
+
+    return ulOriginal;
+}
+
+extern "C" void vPortSetBASEPRI( uint32_t ulNewMaskValue )
+{
+    ulBasePri = ulNewMaskValue;
+}
+
+extern "C" void vPortEnterCritical( void )
+{
+    ulBasePri = 1;
+    uxCriticalNesting++;
+}
+
+extern "C" void vPortExitCritical( void )
+{
+    uxCriticalNesting--;
+
+    if( uxCriticalNesting == 0 )
+    {
+        ulBasePri = 0;
+    }
+}
+
+static inline void vPortRaiseBASEPRI( void )
+{
+    ulBasePri = 1;
+}
+
+static inline void vPortClearBASEPRIFromISR( void )
+{
+    ulBasePri = 0;
+}
+/*-----------------------------------------------------------*/
+
+/* The SysTick control and status register.  Reading it clears COUNTFLAG, and
+ * restarting the counter costs xSimCosts.ullTimerStopped cycles. */
+struct SysTickCtrlReg
+{
+    operator uint32_t()
+    {
+        uint32_t ulValue = ( xSysTick.xEnabled ? 1UL : 0UL ) | ( xSysTick.xInterruptEnabled ? 2UL : 0UL ) | 4UL | ( xSysTick.xCountFlag ? ( 1UL << 16 ) : 0UL );
+
+        xSysTick.xCountFlag = false;
+
+        return ulValue;
+    }
+
+    SysTickCtrlReg & operator=( uint32_t ulValue )
+    {
+        bool xEnable = ( ulValue & 1UL ) != 0;
+
+        xSysTick.xInterruptEnabled = ( ulValue & 2UL ) != 0;
+
+        if( xEnable && !xSysTick.xEnabled )
+        {
+            if( xSimTickZeroSet )
+            {
+                ullSimNow += xSimCosts.ullTimerStopped;
+            }
+
+            xSysTick.xEnabled = true;
+
+            /* A counter at 0 reloads on the next clock. */
+            if( xSysTick.ulValue == 0 )
+            {
+                xSysTick.ulValue = xSysTick.ulLoad;
+                ullSimNow++;
+            }
+
+            if( !xSimTickZeroSet )
+            {
+                xSimTickZeroSet = true;
+                ullSimTickZero = ullSimNow - 1;
+            }
+        }
+        else
+        {
+            xSysTick.xEnabled = xEnable;
+        }
+
+        return *this;
+    }
+
+    SysTickCtrlReg & operator|=( uint32_t ulValue )
+    {
+        uint32_t ulCurrent = ( xSysTick.xEnabled ? 1UL : 0UL ) | ( xSysTick.xInterruptEnabled ? 2UL : 0UL ) | 4UL;
+
+        return *this = ( ulCurrent | ulValue );
+    }
+};
+
+struct SysTickLoadReg
+{
+    operator uint32_t()
+    {
+        return xSysTick.ulLoad;
+    }
+
+    SysTickLoadReg & operator=( uint32_t ulValue )
+    {
+        xSysTick.ulLoad = ulValue & 0xffffffUL;
+
+        return *this;
+    }
+};
+
+/* Any write clears the current value and COUNTFLAG. */
+struct SysTickValueReg
+{
+    operator uint32_t()
+    {
+        return xSysTick.ulValue;
+    }
+
+    SysTickValueReg & operator=( uint32_t )
+    {
+        xSysTick.ulValue = 0;
+        xSysTick.xCountFlag = false;
+
+        return *this;
+    }
+};
+
+/* The interrupt control and state register, for the PendSV and SysTick
+ * pending bits. */
+struct IntCtrlReg
+{
+    operator uint32_t()
+    {
+        return ( xSysTickPending ? ( 1UL << 26 ) : 0UL ) | ( xPendSVPending ? ( 1UL << 28 ) : 0UL );
+    }
+
+    IntCtrlReg & operator=( uint32_t ulValue )
+    {
+        if( ( ulValue & ( 1UL << 28 ) ) != 0 )
+        {
+            xPendSVPending = true;
+        }
+
+        if( ( ulValue & ( 1UL << 26 ) ) != 0 )
+        {
+            xSysTickPending = true;
+        }
+
+        if( ( ulValue & ( 1UL << 25 ) ) != 0 )
+        {
+            xSysTickPending = false;
+        }
+
+        return *this;
+    }
+};
+
+static SysTickCtrlReg xSysTickCtrlReg;
+static SysTickLoadReg xSysTickLoadReg;
+static SysTickValueReg xSysTickValueReg;
+static IntCtrlReg xIntCtrlReg;
+
+/* The definitions port.c uses, pointed at the model. */
+#define portNVIC_SYSTICK_CTRL_REG             xSysTickCtrlReg
+#define portNVIC_SYSTICK_LOAD_REG             xSysTickLoadReg
+#define portNVIC_SYSTICK_CURRENT_VALUE_REG    xSysTickValueReg
+#define portNVIC_INT_CTRL_REG                 xIntCtrlReg
+#define portNVIC_SYSTICK_CLK_BIT              ( 1UL << 2UL )
+#define portNVIC_SYSTICK_INT_BIT              ( 1UL << 1UL )
+#define portNVIC_SYSTICK_ENABLE_BIT           ( 1UL << 0UL )
+#define portNVIC_SYSTICK_COUNT_FLAG_BIT       ( 1UL << 16UL )
+#define portNVIC_PEND_SYSTICK_SET_BIT         ( 1UL << 26UL )
+#define portNVIC_PEND_SYSTICK_CLEAR_BIT       ( 1UL << 25UL )
+#define portMAX_24_BIT_NUMBER                 ( 0xffffffUL )
+#define portMISSED_COUNTS_FACTOR              ( 94UL )
+#define configSYSTICK_CLOCK_HZ                ( configCPU_CLOCK_HZ )
+#define portNVIC_SYSTICK_CLK_BIT_CONFIG       ( portNVIC_SYSTICK_CLK_BIT )
+
+extern "C" {
+#include "port_systick.inc"
+}
+/*-----------------------------------------------------------*/
+
+/* Advances time by up to ullCycles cycles while the SysTick counts, and
+ * returns the cycles used.  Stops early when the SysTick interrupt becomes
+ * pending and is not masked, so the caller can take it. */
+static uint64_t ullSimAdvance( uint64_t ullCycles )
+{
+    uint64_t ullUsed = 0, ullStep;
+
+    while( ullUsed < ullCycles )
+    {
+        if( !xSysTick.xEnabled )
+        {
+            ullSimNow += ullCycles - ullUsed;
+            ullUsed = ullCycles;
+            break;
+        }
+
+        if( xSysTick.ulValue == 0 )
+        {
+            xSysTick.ulValue = xSysTick.ulLoad;
+            ullSimNow++;
+            ullUsed++;
+            continue;
+        }
+
+        ullStep = std::min< uint64_t >( ullCycles - ullUsed, xSysTick.ulValue );
+        xSysTick.ulValue -= ( uint32_t ) ullStep;
+        ullSimNow += ullStep;
+        ullUsed += ullStep;
+
+        if( xSysTick.ulValue == 0 )
+        {
+            xSysTick.xCountFlag = true;
+
+            if( xSysTick.xInterruptEnabled )
+            {
+                if( xSysTickPending )
+                {
+                    printf( "FAIL: SysTick interrupt lost at cycle %llu\n", ( unsigned long long ) ullSimNow );
+                    exit( 3 );
+                }
+
+                xSysTickPending = true;
+            }
+
+            if( ulBasePri == 0 )
+            {
+                break;
+            }
+        }
+    }
+
+    return ullUsed;
+}
+/*-----------------------------------------------------------*/
+
+/* The cycle at which tick xTick started. */
+static inline uint64_t ullSimTickBoundary( TickType_t xTick )
+{
+    return ullSimTickZero + ( ( uint64_t ) xTick * ullSimCyclesPerTick );
+}
+
+/* The tick count the kernel should hold now. */
+static inline uint64_t ullSimIdealTickCount( void )
+{
+    return ( ullSimNow - ullSimTickZero ) / ullSimCyclesPerTick;
+}
+/*-----------------------------------------------------------*/
+
+/* Starts the scheduler and the SysTick, and pends a PendSV to select the
+ * first task. */
+static void vSimStart( void )
+{
+    vSimStartScheduler();
+    vPortSetupTimerInterrupt();
+    xPendSVPending = true;
+}
+/*-----------------------------------------------------------*/
+
+enum SimInterrupt
+{
+    eSimNoInterrupt,
+    eSimTickInterrupt,
+    eSimPendSV
+};
+
+/* Takes the SysTick interrupt, or else PendSV, if it is pending and not
+ * masked, and says which was taken. */
+static SimInterrupt eSimTakeInterrupt( void )
+{
+    if( ulBasePri != 0 )
+    {
+        return eSimNoInterrupt;
+    }
+
+    if( xSysTickPending )
+    {
+        ( void ) ullSimAdvance( xSimCosts.ullInterruptEntry );
+        xSysTickPending = false;
+        ulSimTickInterrupts++;
+        xPortSysTickHandler();
+        ( void ) ullSimAdvance( xSimCosts.ullTickInterrupt );
+
+        return eSimTickInterrupt;
+    }
+
+    if( xPendSVPending )
+    {
+        xPendSVPending = false;
+        vTaskSwitchContext();
+        ulSimContextSwitches++;
+        ( void ) ullSimAdvance( xSimCosts.ullContextSwitch );
+
+        return eSimPendSV;
+    }
+
+    return eSimNoInterrupt;
+}
+/*-----------------------------------------------------------*/
+
+/* An interrupt handler that calls the kernel, such as one that resumes a
+ * task, costs the interrupt entry time. */
+static inline void vSimInterruptEntry( void )
+{
+    ( void ) ullSimAdvance( xSimCosts.ullInterruptEntry );
+}
+/*-----------------------------------------------------------*/
+
+#endif /* SYSTICK_MODEL_H */
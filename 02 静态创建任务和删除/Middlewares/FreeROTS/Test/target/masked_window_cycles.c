@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Core clock cycles for which BASEPRI masks interrupts on the board, counted
+ * with the DWT cycle counter, for the same kernel calls as the host benchmark
+ * in atomic_test.c: the number of times each masks interrupts and the longest
+ * window, over cyclesCALLS calls.  Built once as it is and once with
+ * portHAS_NATIVE_ATOMICS set to 0 in FreeRTOSConfig.h, it shows what the
+ * LDREX/STREX functions of portatomic.h take off the masked time.
+ *
+ * Add this file to the Keil project, add the following to FreeRTOSConfig.h,
+ * and call vMaskedWindowCycles() from a task after the scheduler has started:
+ *
+ *     extern void vMaskedWindowRaised( void );
+ *     extern void vMaskedWindowCleared( void );
+ *     #define traceBASEPRI_RAISED()     vMaskedWindowRaised()
+ *     #define traceBASEPRI_CLEARED()    vMaskedWindowCleared()
+ *
+ * The results are printed with printf(), which the usart driver sends to
+ * USART1.  A window is timed from the first raise of BASEPRI to the next
+ * clear, so nested critical sections count as one.  The masking done by the
+ * context switch and SVC handlers is not seen, see portmacro.h.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#define cyclesDEMCR_REG            ( *( ( volatile uint32_t * ) 0xe000edfc ) )
+#define cyclesDEMCR_TRCENA_BIT     ( 1UL << 24UL )
+#define cyclesDWT_CTRL_REG         ( *( ( volatile uint32_t * ) 0xe0001000 ) )
+#define cyclesDWT_CYCCNTENA_BIT    ( 1UL << 0UL )
+#define cyclesDWT_CYCCNT_REG       ( *( ( volatile uint32_t * ) 0xe0001004 ) )
+
+#define cyclesCALLS                1000
+
+/* Only written with interrupts masked. */
+static BaseType_t xMasked = pdFALSE;
+static uint32_t ulMaskedSince = 0;
+static uint32_t ulLongestWindow = 0;
+static uint32_t ulWindows = 0;
+/*-----------------------------------------------------------*/
+
+void vMaskedWindowRaised( void )
+{
+    if( xMasked == pdFALSE )
+    {
+        xMasked = pdTRUE;
+        ulMaskedSince = cyclesDWT_CYCCNT_REG;
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vMaskedWindowCleared( void )
+{
+    uint32_t ulWindow;
+
+    if( xMasked != pdFALSE )
+    {
+        ulWindow = cyclesDWT_CYCCNT_REG - ulMaskedSince;
+        xMasked = pdFALSE;
+        ulWindows++;
+
+        if( ulWindow > ulLongestWindow )
+        {
+            ulLongestWindow = ulWindow;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvMaskedWindows( const char * pcName,
+                              QueueHandle_t xQueue,
+                              int iOperation )
+{
+    uint32_t ulItem = 0, ulSections, ulLongest;
+    int i;
+
+    taskENTER_CRITICAL();
+    {
+        ulWindows = 0;
+        ulLongestWindow = 0;
+    }
+    taskEXIT_CRITICAL();
+
+    for( i = 0; i < cyclesCALLS; i++ )
+    {
+        switch( iOperation )
+        {
+            case 0:
+                ( void ) xQueueSend( xQueue, &ulItem, 0 );
+                ( void ) xQueueReceive( xQueue, &ulItem, 0 );
+                break;
+
+            case 1:
+                ( void ) ulTaskNotifyValueClear( NULL, 1U );
+                break;
+
+            case 2:
+                ( void ) xTaskCatchUpTicks( 1 );
+                break;
+
+            case 3:
+                ( void ) uxTaskPriorityGet( NULL );
+                ( void ) uxQueueMessagesWaiting( xQueue );
+                break;
+
+            default:
+                /* Only the tick interrupt and any other interrupts that use
+                 * the kernel mask interrupts while the task waits a tick. */
+                vTaskDelay( 1 );
+                break;
+        }
+    }
+
+    /* The window that reset the counts ended after the reset, so is counted,
+     * while this one is not counted until after the copy. */
+    taskENTER_CRITICAL();
+    {
+        ulSections = ulWindows - 1U;
+        ulLongest = ulLongestWindow;
+    }
+    taskEXIT_CRITICAL();
+
+    printf( "%-50s %11lu.%03lu %14lu\r\n", pcName, ( unsigned long ) ( ulSections / cyclesCALLS ), ( unsigned long ) ( ulSections % cyclesCALLS ),
+            ( unsigned long ) ulLongest );
+}
+/*-----------------------------------------------------------*/
+
+void vMaskedWindowCycles( void )
+{
+    QueueHandle_t xQueue = xQueueCreate( 4, sizeof( uint32_t ) );
+
+    /* Started without a reset, as vPortConfigureBudgetCounter() does, in case
+     * a debugger is using the counter. */
+    cyclesDEMCR_REG |= cyclesDEMCR_TRCENA_BIT;
+    cyclesDWT_CTRL_REG |= cyclesDWT_CYCCNTENA_BIT;
+
+    printf( "%s atomic functions\r\n", ( portHAS_NATIVE_ATOMICS == 1 ) ? "native" : "generic" );
+    printf( "%-50s %15s %14s\r\n", "", "masked sections", "longest cycles" );
+
+    prvMaskedWindows( "xQueueSend() and xQueueReceive()", xQueue, 0 );
+    prvMaskedWindows( "ulTaskNotifyValueClear()", xQueue, 1 );
+    prvMaskedWindows( "xTaskCatchUpTicks( 1 )", xQueue, 2 );
+    prvMaskedWindows( "uxTaskPriorityGet() and uxQueueMessagesWaiting()", xQueue, 3 );
+    prvMaskedWindows( "vTaskDelay( 1 )", xQueue, 4 );
+
+    vQueueDelete( xQueue );
+}
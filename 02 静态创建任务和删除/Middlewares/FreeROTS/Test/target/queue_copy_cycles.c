@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Core clock cycles per xQueueSend() and xQueueReceive() pair on the board,
+ * counted with the DWT cycle counter, for the same item sizes and storage
+ * areas as the host benchmark in queue_copy_test.c: aligned storage, so 1, 2,
+ * 4 and 8 byte items are copied directly, and storage offset by one byte, so
+ * every item is copied with memcpy().
+ *
+ * Add this file to the Keil project and call vQueueCopyCycles() from a task
+ * after the scheduler has started.  The results are printed with printf(),
+ * which the usart driver sends to USART1.  Each figure is the lowest of
+ * cyclesPAIRS pairs, so a pair interrupted by the tick is not counted, less
+ * the cost of reading the counter.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#define cyclesDEMCR_REG            ( *( ( volatile uint32_t * ) 0xe000edfc ) )
+#define cyclesDEMCR_TRCENA_BIT     ( 1UL << 24UL )
+#define cyclesDWT_CTRL_REG         ( *( ( volatile uint32_t * ) 0xe0001000 ) )
+#define cyclesDWT_CYCCNTENA_BIT    ( 1UL << 0UL )
+#define cyclesDWT_CYCCNT_REG       ( *( ( volatile uint32_t * ) 0xe0001004 ) )
+
+#define cyclesLENGTH               16
+#define cyclesMAX_SIZE             12
+#define cyclesPAIRS                1000
+
+static uint8_t ucStorage[ ( cyclesLENGTH * cyclesMAX_SIZE ) + 8 ] __attribute__( ( aligned( 8 ) ) );
+static StaticQueue_t xStaticQueue;
+/*-----------------------------------------------------------*/
+
+static uint32_t prvCyclesPerPair( size_t xSize,
+                                  size_t xStorageOffset,
+                                  uint32_t ulOverhead )
+{
+    QueueHandle_t xQueue = xQueueCreateStatic( cyclesLENGTH, xSize, &( ucStorage[ xStorageOffset ] ), &xStaticQueue );
+    uint32_t ulItem[ 4 ] = { 1, 2, 3, 4 }, ulBuffer[ 4 ];
+    uint32_t ulStart, ulCycles, ulBest = UINT32_MAX;
+    int i;
+
+    for( i = 0; i < cyclesPAIRS; i++ )
+    {
+        ulStart = cyclesDWT_CYCCNT_REG;
+        ( void ) xQueueSend( xQueue, ulItem, 0 );
+        ( void ) xQueueReceive( xQueue, ulBuffer, 0 );
+        ulCycles = cyclesDWT_CYCCNT_REG - ulStart;
+
+        if( ulCycles < ulBest )
+        {
+            ulBest = ulCycles;
+        }
+    }
+
+    vQueueDelete( xQueue );
+
+    return ulBest - ulOverhead;
+}
+/*-----------------------------------------------------------*/
+
+void vQueueCopyCycles( void )
+{
+    static const size_t xSizes[] = { 1, 2, 3, 4, 5, 8, 12 };
+    uint32_t ulStart, ulCycles, ulOverhead = UINT32_MAX;
+    size_t i;
+
+    /* Started without a reset, as vPortConfigureBudgetCounter() does, in case
+     * a debugger is using the counter. */
+    cyclesDEMCR_REG |= cyclesDEMCR_TRCENA_BIT;
+    cyclesDWT_CTRL_REG |= cyclesDWT_CYCCNTENA_BIT;
+
+    for( i = 0; i < cyclesPAIRS; i++ )
+    {
+        ulStart = cyclesDWT_CYCCNT_REG;
+        ulCycles = cyclesDWT_CYCCNT_REG - ulStart;
+
+        if( ulCycles < ulOverhead )
+        {
+            ulOverhead = ulCycles;
+        }
+    }
+
+    printf( "item bytes  aligned storage  storage offset by 1  (cycles per send and receive)\r\n" );
+
+    for( i = 0; i < ( sizeof( xSizes ) / sizeof( xSizes[ 0 ] ) ); i++ )
+    {
+        printf( "%10u  %15lu  %19lu\r\n", ( unsigned ) xSizes[ i ], ( unsigned long ) prvCyclesPerPair( xSizes[ i ], 0, ulOverhead ),
+                ( unsigned long ) prvCyclesPerPair( xSizes[ i ], 1, ulOverhead ) );
+    }
+}
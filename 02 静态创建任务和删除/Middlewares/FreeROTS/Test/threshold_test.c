@@ -0,0 +1,331 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test of preemption thresholds and of run to completion tasks on a shared
+ * stack, on the simulation port.
+ *
+ *   threshold_test test <seconds> <seed>
+ *       Three run to completion tasks at priorities 2, 3 and 4 share a stack
+ *       with a threshold of 5, the one at 4 released every testPERIOD ticks
+ *       and the others by notifications.  A task with a stack of its own runs
+ *       at priority 1 with its threshold switched between 3 and 1, and tasks
+ *       at priorities 5 and 6 and a releaser at 7 complete the set.  Every
+ *       task works in sections of random length, during which interrupts and
+ *       the task itself release other tasks at random.
+ *
+ *       Whenever a task starts to run, no other task may be part way through
+ *       a section unless the running task's priority is above that section's
+ *       threshold, so tasks within a threshold never preempt each other.
+ *       Each job must run as its own task and finds the pattern it wrote to
+ *       the shared stack intact when it ends, and the simulation port asserts
+ *       that every task only resumes the context it was started on.  Tasks
+ *       above the thresholds must have preempted both the jobs and the task
+ *       on its own stack, and the periodic job must have run on time.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "sim.h"
+
+#define testSHARED_TASKS         3
+#define testSHARED_THRESHOLD     5
+#define testSHARED_STACK_SIZE    256
+#define testPATTERN_SIZE         200
+#define testPERIOD               5
+
+/* The tasks, in priority order, apart from the releaser. */
+typedef enum
+{
+    eOwnStack,   /* Priority 1, threshold 3 or 1. */
+    eShared1,    /* Priority 2, shared stack, threshold 5. */
+    eShared2,    /* Priority 3, shared stack, threshold 5. */
+    eShared3,    /* Priority 4, shared stack, threshold 5, periodic. */
+    eMiddle,     /* Priority 5. */
+    eHigh,       /* Priority 6. */
+    eTasks
+} TestTask_t;
+
+static const char * const pcTaskNames[ eTasks ] = { "own stack", "shared 1", "shared 2", "shared 3", "middle", "high" };
+static const UBaseType_t uxPriorities[ eTasks ] = { 1, 2, 3, 4, 5, 6 };
+
+static TaskHandle_t xTasks[ eTasks ];
+static StaticTask_t xSharedTaskBuffers[ testSHARED_TASKS ];
+static StackType_t uxSharedStack[ testSHARED_STACK_SIZE ];
+
+/* The threshold of each task that is part way through a section, or 0. */
+static UBaseType_t uxSectionThreshold[ eTasks ];
+
+static unsigned long ulSections[ eTasks ];
+static unsigned long ulPreemptedJobs = 0, ulPreemptedOwnStack = 0;
+static unsigned long ulErrors = 0;
+static uint64_t ullRandomState = 88172645463325252ULL;
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    ullRandomState ^= ullRandomState << 13;
+    ullRandomState ^= ullRandomState >> 7;
+    ullRandomState ^= ullRandomState << 17;
+
+    return ( uint32_t ) ullRandomState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvError( const char * pcWhat )
+{
+    if( ulErrors++ < 5 )
+    {
+        printf( "%s at tick %lu\n", pcWhat, ( unsigned long ) xTaskGetTickCount() );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Called each time a task starts to run after blocking, with the priority it
+ * runs at. */
+static void prvStarted( UBaseType_t uxPriority )
+{
+    int i;
+
+    for( i = 0; i < ( int ) eTasks; i++ )
+    {
+        if( uxSectionThreshold[ i ] == 0U )
+        {
+            continue;
+        }
+
+        if( uxPriority <= uxSectionThreshold[ i ] )
+        {
+            printf( "a task at priority %lu ran inside a section of %s with threshold %lu\n", ( unsigned long ) uxPriority, pcTaskNames[ i ],
+                    ( unsigned long ) uxSectionThreshold[ i ] );
+            prvError( "FAIL: a task preempted another within its threshold" );
+        }
+        else if( i == ( int ) eOwnStack )
+        {
+            ulPreemptedOwnStack++;
+        }
+        else if( ( i >= ( int ) eShared1 ) && ( i <= ( int ) eShared3 ) )
+        {
+            ulPreemptedJobs++;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Releases one of the tasks at random, from an interrupt or from the task. */
+static void prvReleaseTask( void )
+{
+    TaskHandle_t xTask = xTasks[ prvRandom() % ( uint32_t ) eTasks ];
+    BaseType_t xWoken = pdFALSE;
+
+    if( ( prvRandom() % 2U ) == 0U )
+    {
+        vSimEnterISR();
+        vTaskNotifyGiveFromISR( xTask, &xWoken );
+        vSimExitISR( xWoken );
+    }
+    else
+    {
+        ( void ) xTaskNotifyGive( xTask );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Works for up to about a tick without blocking, releasing other tasks on
+ * the way. */
+static void prvSection( TestTask_t eTask,
+                        UBaseType_t uxThreshold )
+{
+    uint32_t ulChunks = 1U + ( prvRandom() % 8U );
+
+    uxSectionThreshold[ eTask ] = uxThreshold;
+
+    while( ulChunks-- > 0U )
+    {
+        vSimRun( prvRandom() % 10000U );
+
+        if( ( prvRandom() % 4U ) == 0U )
+        {
+            prvReleaseTask();
+        }
+    }
+
+    uxSectionThreshold[ eTask ] = 0;
+    ulSections[ eTask ]++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSharedJob( void * pvParameters )
+{
+    TestTask_t eTask = ( TestTask_t ) ( intptr_t ) pvParameters;
+    StackType_t uxPattern = ( StackType_t ) ( ( ( uint32_t ) eTask * 0x01010101UL ) ^ prvRandom() );
+    int i;
+
+    prvStarted( uxPriorities[ eTask ] );
+
+    if( xTaskGetCurrentTaskHandle() != xTasks[ eTask ] )
+    {
+        prvError( "FAIL: a job ran as another task" );
+    }
+
+    /* Stands in for the job's own data on the stack, which no other job on
+     * the stack may touch until this one ends. */
+    for( i = 0; i < testPATTERN_SIZE; i++ )
+    {
+        uxSharedStack[ i ] = uxPattern + ( StackType_t ) i;
+    }
+
+    prvSection( eTask, testSHARED_THRESHOLD );
+
+    for( i = 0; i < testPATTERN_SIZE; i++ )
+    {
+        if( uxSharedStack[ i ] != ( uxPattern + ( StackType_t ) i ) )
+        {
+            prvError( "FAIL: another job wrote to the shared stack part way through a job" );
+            break;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvOwnStackTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, 1U + ( prvRandom() % 5U ) );
+        prvStarted( uxPriorities[ eOwnStack ] );
+
+        /* Half of the sections are run with a threshold of 3, so only the
+         * tasks at priority 4 and above can preempt them. */
+        vTaskPreemptionThresholdSet( NULL, ( ( prvRandom() % 2U ) == 0U ) ? 3U : 1U );
+        prvSection( eOwnStack, uxTaskPreemptionThresholdGet( NULL ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvOtherTask( void * pvParameters )
+{
+    TestTask_t eTask = ( TestTask_t ) ( intptr_t ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        prvStarted( uxPriorities[ eTask ] );
+        prvSection( eTask, uxPriorities[ eTask ] );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvReleaserTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        vTaskDelay( 1U + ( prvRandom() % 5U ) );
+        prvStarted( configMAX_PRIORITIES - 1 );
+        vSimRun( prvRandom() % 5000U );
+
+        while( ( prvRandom() % 3U ) != 0U )
+        {
+            prvReleaseTask();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static int prvEnd( void )
+{
+    TickType_t xTicks = xTaskGetTickCount();
+    unsigned long ulExpectedPeriodic = ( unsigned long ) ( xTicks / testPERIOD );
+    int i;
+
+    for( i = 0; i < ( int ) eTasks; i++ )
+    {
+        if( ulSections[ i ] == 0U )
+        {
+            prvError( "FAIL: a task never completed a section" );
+        }
+    }
+
+    if( ( ulPreemptedJobs == 0U ) || ( ulPreemptedOwnStack == 0U ) )
+    {
+        prvError( "FAIL: tasks above the thresholds did not preempt" );
+    }
+
+    /* Each periodic release runs one job, though not always in the tick it
+     * was released. */
+    if( ( ulSections[ eShared3 ] + 1U < ulExpectedPeriodic ) || ( ulSections[ eShared3 ] > ulExpectedPeriodic + 1U ) )
+    {
+        printf( "%lu periodic jobs in %lu ticks\n", ulSections[ eShared3 ], ( unsigned long ) xTicks );
+        prvError( "FAIL: the periodic job did not run once each period" );
+    }
+
+    printf( "sections %lu %lu %lu %lu %lu %lu, preempted jobs %lu, preempted own stack sections %lu, %lu errors\n",
+            ulSections[ 0 ], ulSections[ 1 ], ulSections[ 2 ], ulSections[ 3 ], ulSections[ 4 ], ulSections[ 5 ], ulPreemptedJobs,
+            ulPreemptedOwnStack, ulErrors );
+
+    return ( ulErrors != 0U ) ? 1 : 0;
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    int i;
+
+    if( ( argc != 4 ) || ( strcmp( argv[ 1 ], "test" ) != 0 ) )
+    {
+        printf( "usage: %s test <seconds> <seed>\n", argv[ 0 ] );
+        return 1;
+    }
+
+    ullRandomState ^= strtoull( argv[ 3 ], NULL, 0 ) * 0x9E3779B97F4A7C15ULL;
+    vSimSetEndTime( simSECONDS( atof( argv[ 2 ] ) ), prvEnd );
+
+    /* All the tasks on the shared stack are created before any of them
+     * runs. */
+    for( i = 0; i < testSHARED_TASKS; i++ )
+    {
+        TestTask_t eTask = ( TestTask_t ) ( ( int ) eShared1 + i );
+
+        xTasks[ eTask ] = xTaskCreateStaticSharedStack( prvSharedJob, pcTaskNames[ eTask ], testSHARED_STACK_SIZE, ( void * ) ( intptr_t ) eTask,
+                                                        uxPriorities[ eTask ], testSHARED_THRESHOLD, ( eTask == eShared3 ) ? testPERIOD : 0,
+                                                        uxSharedStack, &( xSharedTaskBuffers[ i ] ) );
+    }
+
+    ( void ) xTaskCreate( prvOwnStackTask, pcTaskNames[ eOwnStack ], configMINIMAL_STACK_SIZE, NULL, uxPriorities[ eOwnStack ], &( xTasks[ eOwnStack ] ) );
+    ( void ) xTaskCreate( prvOtherTask, pcTaskNames[ eMiddle ], configMINIMAL_STACK_SIZE, ( void * ) ( intptr_t ) eMiddle, uxPriorities[ eMiddle ], &( xTasks[ eMiddle ] ) );
+    ( void ) xTaskCreate( prvOtherTask, pcTaskNames[ eHigh ], configMINIMAL_STACK_SIZE, ( void * ) ( intptr_t ) eHigh, uxPriorities[ eHigh ], &( xTasks[ eHigh ] ) );
+    ( void ) xTaskCreate( prvReleaserTask, "Releaser", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+
+    vTaskStartScheduler();
+
+    return 1;
+}
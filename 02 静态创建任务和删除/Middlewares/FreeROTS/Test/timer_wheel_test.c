@@ -0,0 +1,334 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test and benchmark of the software timers with the sorted active timer
+ * lists or the timer wheel (configUSE_TIMER_WHEEL).
+ *
+ *   timer_wheel_test test <seconds> <seed>
+ *       Two tasks start, reset, stop and change the period of 300 one shot
+ *       and auto reload timers with periods of 1 to 3000 ticks at random,
+ *       from the tasks and as if from interrupts, and pend function calls to
+ *       the timer task.  Every callback adds its timer and tick to a hash that
+ *       does not depend on the order of callbacks due on the same tick.  The
+ *       run prints the hash with its counts, and run.sh checks that the
+ *       timer wheel, at every slot width, prints exactly what the sorted lists
+ *       print for the same seed and start tick.  The run also fails if the
+ *       tick seen by the callbacks ever goes backwards.
+ *
+ *   timer_wheel_test bench <timers>
+ *       Host time per command with the given number of timers active: first
+ *       resets of random timers that are mostly reset again before they
+ *       expire, as retransmission timeouts are, and then resets mixed with
+ *       short periods that do expire.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "sim.h"
+
+#define testTIMERS        300
+#define testMAX_PERIOD    3000
+
+static TimerHandle_t xTimers[ testTIMERS ];
+static uint64_t ullHash = 0;
+static unsigned long ulCallbacks = 0, ulCommands = 0, ulFailed = 0, ulPended = 0, ulBackwards = 0;
+static TickType_t xLastCallbackTick;
+static BaseType_t xCalledBack = pdFALSE;
+static uint64_t ullRandomState = 88172645463325252ULL;
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    ullRandomState ^= ullRandomState << 13;
+    ullRandomState ^= ullRandomState >> 7;
+    ullRandomState ^= ullRandomState << 17;
+
+    return ( uint32_t ) ullRandomState;
+}
+/*-----------------------------------------------------------*/
+
+/* Adds a value to the hash.  Adding makes the hash independent of order. */
+static void prvHash( uint64_t ullValue )
+{
+    ullValue *= 0x9E3779B97F4A7C15ULL;
+    ullValue ^= ullValue >> 29;
+    ullValue *= 0xBF58476D1CE4E5B9ULL;
+    ullValue ^= ullValue >> 32;
+    ullHash += ullValue;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+    TickType_t xNow = xTaskGetTickCount();
+
+    if( ( xCalledBack != pdFALSE ) && ( ( TickType_t ) ( xNow - xLastCallbackTick ) > ( portMAX_DELAY / 2U ) ) )
+    {
+        ulBackwards++;
+    }
+
+    xLastCallbackTick = xNow;
+    xCalledBack = pdTRUE;
+    prvHash( ( ( uint64_t ) ( uintptr_t ) pvTimerGetTimerID( xTimer ) << 32 ) | xNow );
+    ulCallbacks++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPendedFunction( void * pvParameter1,
+                               uint32_t ulParameter2 )
+{
+    ( void ) pvParameter1;
+
+    prvHash( 0xABCDEF0000000000ULL ^ ulParameter2 ^ ( ( uint64_t ) xTaskGetTickCount() << 20 ) );
+    ulPended++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCommandTask( void * pvParameters )
+{
+    BaseType_t xResult, xWoken;
+    TimerHandle_t xTimer;
+    TickType_t xTicksToWait;
+    uint32_t ulCommand;
+    int i;
+
+    /* The timer command queue is too short to start the timers before the
+     * scheduler, so the first task starts half of them. */
+    if( pvParameters == NULL )
+    {
+        for( i = 0; i < testTIMERS / 2; i++ )
+        {
+            ( void ) xTimerStart( xTimers[ i ], portMAX_DELAY );
+        }
+    }
+
+    for( ; ; )
+    {
+        xTimer = xTimers[ prvRandom() % testTIMERS ];
+        ulCommand = prvRandom() % 16U;
+        xTicksToWait = prvRandom() % 3U;
+        xResult = pdPASS;
+        xWoken = pdFALSE;
+
+        if( ulCommand < 6U )
+        {
+            xResult = xTimerReset( xTimer, xTicksToWait );
+        }
+        else if( ulCommand < 8U )
+        {
+            xResult = xTimerStart( xTimer, xTicksToWait );
+        }
+        else if( ulCommand < 10U )
+        {
+            xResult = xTimerStop( xTimer, xTicksToWait );
+        }
+        else if( ulCommand < 11U )
+        {
+            xResult = xTimerChangePeriod( xTimer, 1U + ( prvRandom() % testMAX_PERIOD ), xTicksToWait );
+        }
+        else if( ulCommand < 13U )
+        {
+            vSimEnterISR();
+            xResult = xTimerResetFromISR( xTimer, &xWoken );
+            vSimExitISR( xWoken );
+        }
+        else if( ulCommand < 14U )
+        {
+            vSimEnterISR();
+            xResult = xTimerStopFromISR( xTimer, &xWoken );
+            vSimExitISR( xWoken );
+        }
+        else if( ulCommand < 15U )
+        {
+            xResult = xTimerPendFunctionCall( prvPendedFunction, NULL, prvRandom(), xTicksToWait );
+        }
+        else
+        {
+            vTimerSetReloadMode( xTimer, ( BaseType_t ) ( prvRandom() & 1U ) );
+        }
+
+        if( xResult != pdPASS )
+        {
+            ulFailed++;
+        }
+
+        ulCommands++;
+
+        if( ( prvRandom() % 8U ) == 0U )
+        {
+            vTaskDelay( prvRandom() % 5U );
+        }
+        else
+        {
+            vSimRun( prvRandom() % ( ( pvParameters == NULL ) ? 8000U : 30000U ) );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static int prvTestEnd( void )
+{
+    printf( "%lu callbacks, %lu commands, %lu failed, %lu pended, hash %016llx\n", ulCallbacks, ulCommands, ulFailed, ulPended,
+            ( unsigned long long ) ullHash );
+
+    if( ulBackwards != 0 )
+    {
+        printf( "FAIL: the tick went backwards %lu times between callbacks\n", ulBackwards );
+    }
+
+    return ( ( ulBackwards != 0 ) || ( ulCallbacks == 0 ) ) ? 1 : 0;
+}
+/*-----------------------------------------------------------*/
+
+static int iBenchTimers;
+static volatile unsigned long ulBenchCallbacks = 0;
+/*-----------------------------------------------------------*/
+
+static double prvNanoseconds( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( double ) xNow.tv_sec * 1e9 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchCallback( TimerHandle_t xTimer )
+{
+    ( void ) xTimer;
+
+    ulBenchCallbacks++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void * pvParameters )
+{
+    const long lResets = 100000;
+    TimerHandle_t * pxTimers;
+    TickType_t xStartTick;
+    double dStart, dResetTime, dMixedTime;
+    unsigned long ulExpiries;
+    int i;
+    long l;
+
+    ( void ) pvParameters;
+
+    pxTimers = malloc( sizeof( TimerHandle_t ) * ( size_t ) iBenchTimers );
+    configASSERT( pxTimers != NULL );
+
+    for( i = 0; i < iBenchTimers; i++ )
+    {
+        pxTimers[ i ] = xTimerCreate( "Bench", 200U + ( prvRandom() % 4800U ), pdFALSE, NULL, prvBenchCallback );
+        configASSERT( pxTimers[ i ] != NULL );
+        ( void ) xTimerStart( pxTimers[ i ], portMAX_DELAY );
+    }
+
+    /* Most timers are reset again before they expire. */
+    xStartTick = xTaskGetTickCount();
+    dStart = prvNanoseconds();
+
+    for( l = 0; l < lResets; l++ )
+    {
+        ( void ) xTimerReset( pxTimers[ prvRandom() % ( uint32_t ) iBenchTimers ], portMAX_DELAY );
+
+        if( ( l & 15 ) == 0 )
+        {
+            vSimRun( 2000 );
+        }
+    }
+
+    dResetTime = ( prvNanoseconds() - dStart ) / ( double ) lResets;
+    xStartTick = xTaskGetTickCount() - xStartTick;
+
+    /* Short periods, so timers also expire. */
+    for( i = 0; i < iBenchTimers; i++ )
+    {
+        ( void ) xTimerChangePeriod( pxTimers[ i ], 1U + ( prvRandom() % 50U ), portMAX_DELAY );
+    }
+
+    ulExpiries = ulBenchCallbacks;
+    dStart = prvNanoseconds();
+
+    for( l = 0; l < lResets / 4; l++ )
+    {
+        ( void ) xTimerReset( pxTimers[ prvRandom() % ( uint32_t ) iBenchTimers ], portMAX_DELAY );
+
+        if( ( l & 3 ) == 0 )
+        {
+            vSimRun( 4000 );
+        }
+    }
+
+    dMixedTime = ( prvNanoseconds() - dStart ) / ( double ) ( lResets / 4 );
+    ulExpiries = ulBenchCallbacks - ulExpiries;
+
+    printf( "timer wheel=%d timers=%5d: reset %7.0f ns per command over %lu ticks, short periods %7.0f ns per command with %lu expiries\n",
+            configUSE_TIMER_WHEEL, iBenchTimers, dResetTime, ( unsigned long ) xStartTick, dMixedTime, ulExpiries );
+
+    exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    int i;
+
+    if( ( argc == 4 ) && ( strcmp( argv[ 1 ], "test" ) == 0 ) )
+    {
+        ullRandomState ^= strtoull( argv[ 3 ], NULL, 0 ) * 0x9E3779B97F4A7C15ULL;
+
+        for( i = 0; i < testTIMERS; i++ )
+        {
+            xTimers[ i ] = xTimerCreate( "Test", 1U + ( prvRandom() % testMAX_PERIOD ), ( BaseType_t ) ( prvRandom() & 1U ),
+                                         ( void * ) ( uintptr_t ) i, prvTimerCallback );
+            configASSERT( xTimers[ i ] != NULL );
+        }
+
+        ( void ) xTaskCreate( prvCommandTask, "Cmd0", configMINIMAL_STACK_SIZE, NULL, 2, NULL );
+        ( void ) xTaskCreate( prvCommandTask, "Cmd1", configMINIMAL_STACK_SIZE, ( void * ) 1, 1, NULL );
+        vSimSetEndTime( simSECONDS( atof( argv[ 2 ] ) ), prvTestEnd );
+    }
+    else if( ( argc == 3 ) && ( strcmp( argv[ 1 ], "bench" ) == 0 ) )
+    {
+        iBenchTimers = atoi( argv[ 2 ] );
+        ( void ) xTaskCreate( prvBenchTask, "Bench", configMINIMAL_STACK_SIZE, NULL, 1, NULL );
+    }
+    else
+    {
+        printf( "usage: %s test <seconds> <seed> | bench <timers>\n", argv[ 0 ] );
+        return 1;
+    }
+
+    vTaskStartScheduler();
+
+    return 1;
+}
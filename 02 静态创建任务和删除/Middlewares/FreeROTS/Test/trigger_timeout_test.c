@@ -0,0 +1,406 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test of the stream buffer trigger timeout, and of xTaskLimitNotifyWaitTime()
+ * that moves the waiting reader to its new position in the delayed task list
+ * or wheel, on the simulation port.
+ *
+ *   trigger_timeout_test test <seconds> <seed> <timeout|none>
+ *       A writer task sends bursts of 1 to 40 bytes to a stream buffer of 100
+ *       bytes with a trigger level of 32, from the task without and with a
+ *       block time, from an interrupt, and from an interrupt taken while the
+ *       scheduler is suspended.  A reader task above it reads whatever is
+ *       there when the buffer is not empty, and otherwise blocks, without a
+ *       timeout, so the kernel must move it from the suspended list, or with
+ *       a timeout shorter or longer than the trigger timeout, so the kernel
+ *       must bring its wake time forward or leave it.
+ *
+ *       The bytes must arrive whole and in order.  A reader woken by data
+ *       below the trigger level must wake exactly the trigger timeout after
+ *       the first byte was written, or at its own timeout if that is sooner,
+ *       except when the first byte was written from an interrupt with the
+ *       scheduler suspended, when it must wake straight away.  The wake
+ *       counts of vStreamBufferGetWakeCounts() must match the wakes seen.
+ *       With "none" the trigger timeout is left at portMAX_DELAY, and a
+ *       reader without a timeout must only wake at the trigger level.  The
+ *       writer stops at the given time, sends a last burst of the trigger
+ *       level, and the reader then has a second to empty the buffer.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "sim.h"
+
+#define testLENGTH           100
+#define testTRIGGER_LEVEL    32
+#define testHISTORY          256U
+
+/* How each byte was written, as far as the time the reader wakes goes. */
+#define testWRITTEN_BY_TASK    0U /* By the task, without waiting. */
+#define testWRITTEN_FROM_ISR   1U /* From an interrupt. */
+#define testWRITTEN_LATE       2U /* By a send that may have waited first. */
+#define testWRITTEN_AT_ONCE    3U /* From an interrupt with the scheduler suspended. */
+
+static StreamBufferHandle_t xBuffer;
+static TickType_t xTriggerTimeout;
+static uint64_t ullStopTime;
+
+/* The bytes written and read so far, and the tick at which, and the way in
+ * which, each of the last testHISTORY bytes was written. */
+static uint32_t ulWritten = 0, ulRead = 0;
+static TickType_t xWriteTick[ testHISTORY ];
+static uint8_t ucWriteKind[ testHISTORY ];
+
+static unsigned long ulTaskSends = 0, ulISRSends = 0, ulSuspendedSends = 0;
+static unsigned long ulBlockedReceives = 0, ulLevelWakes = 0, ulTimeoutWakes = 0, ulOwnTimeouts = 0, ulImmediateWakes = 0;
+
+/* Wakes at the trigger timeout of a reader blocked without a timeout, and
+ * with a longer timeout, indexed by the way the first byte was written, and
+ * wakes of a reader whose shorter timeout still ran out first. */
+static unsigned long ulSuspendedWakes[ 2 ] = { 0, 0 }, ulShortenedWakes[ 2 ] = { 0, 0 }, ulKeptWakes = 0;
+static unsigned long ulErrors = 0;
+static uint64_t ullRandomState = 88172645463325252ULL;
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    ullRandomState ^= ullRandomState << 13;
+    ullRandomState ^= ullRandomState >> 7;
+    ullRandomState ^= ullRandomState << 17;
+
+    return ( uint32_t ) ullRandomState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvError( const char * pcMessage,
+                      unsigned long ulValue )
+{
+    if( ulErrors++ < 5 )
+    {
+        printf( "FAIL: %s (%lu) at tick %lu\n", pcMessage, ulValue, ( unsigned long ) xTaskGetTickCount() );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static uint8_t prvByte( uint32_t ulIndex )
+{
+    return ( uint8_t ) ( ( ulIndex * 131U ) + ( ulIndex >> 7 ) );
+}
+/*-----------------------------------------------------------*/
+
+/* Records the next xCount bytes before they are sent, as the reader may run
+ * before the send returns. */
+static void prvRecord( uint8_t * pucData,
+                       size_t xCount,
+                       uint8_t ucKind )
+{
+    size_t x;
+
+    for( x = 0; x < xCount; x++ )
+    {
+        pucData[ x ] = prvByte( ulWritten + ( uint32_t ) x );
+        xWriteTick[ ( ulWritten + ( uint32_t ) x ) % testHISTORY ] = xTaskGetTickCount();
+        ucWriteKind[ ( ulWritten + ( uint32_t ) x ) % testHISTORY ] = ucKind;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriterTask( void * pvParameters )
+{
+    uint8_t ucData[ testLENGTH ];
+    size_t xCount;
+    TickType_t xTicksToWait;
+    BaseType_t xWoken = pdFALSE;
+
+    ( void ) pvParameters;
+
+    while( ullSimTime < ullStopTime )
+    {
+        xCount = ( ( prvRandom() % 4U ) != 0U ) ? ( 1U + ( prvRandom() % 8U ) ) : ( 1U + ( prvRandom() % 40U ) );
+
+        switch( prvRandom() % 5U )
+        {
+            case 0:
+                xTicksToWait = ( ( prvRandom() % 2U ) != 0U ) ? 0U : ( 1U + ( prvRandom() % 3U ) );
+                prvRecord( ucData, xCount, ( xTicksToWait == 0U ) ? testWRITTEN_BY_TASK : testWRITTEN_LATE );
+                ulWritten += ( uint32_t ) xStreamBufferSend( xBuffer, ucData, xCount, xTicksToWait );
+                ulTaskSends++;
+                break;
+
+            case 1:
+                /* The send cannot shorten the wait of the reader while the
+                 * scheduler is suspended, so wakes it instead, and the reader
+                 * runs as soon as the scheduler is resumed. */
+                vTaskSuspendAll();
+                {
+                    vSimEnterISR();
+                    prvRecord( ucData, xCount, testWRITTEN_AT_ONCE );
+                    ulWritten += ( uint32_t ) xStreamBufferSendFromISR( xBuffer, ucData, xCount, &xWoken );
+                    vSimExitISR( pdFALSE );
+                }
+                ( void ) xTaskResumeAll();
+                ulSuspendedSends++;
+                break;
+
+            default:
+                vSimEnterISR();
+                prvRecord( ucData, xCount, testWRITTEN_FROM_ISR );
+                ulWritten += ( uint32_t ) xStreamBufferSendFromISR( xBuffer, ucData, xCount, &xWoken );
+                vSimExitISR( xWoken );
+                ulISRSends++;
+                break;
+        }
+
+        xWoken = pdFALSE;
+
+        if( ( prvRandom() % 2U ) != 0U )
+        {
+            vTaskDelay( ( TickType_t ) ( prvRandom() % ( ( 2U * configMIN( xTriggerTimeout, 20U ) ) + 3U ) ) );
+        }
+        else
+        {
+            vSimRun( prvRandom() % 5000U );
+        }
+    }
+
+    /* Reaches the trigger level, so the last bytes are read even without a
+     * trigger timeout. */
+    prvRecord( ucData, testTRIGGER_LEVEL, testWRITTEN_LATE );
+    ulWritten += ( uint32_t ) xStreamBufferSend( xBuffer, ucData, testTRIGGER_LEVEL, portMAX_DELAY );
+
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+/* Checks the time at which a reader that blocked on an empty buffer at
+ * xStart, for at most xTicksToWait, woke with xCount bytes. */
+static void prvCheckWake( TickType_t xStart,
+                          TickType_t xTicksToWait,
+                          size_t xCount )
+{
+    const TickType_t xNow = xTaskGetTickCount();
+    const TickType_t xFirst = xWriteTick[ ulRead % testHISTORY ];
+    const uint8_t ucKind = ucWriteKind[ ulRead % testHISTORY ];
+    const BaseType_t xOwnTimeout = ( ( xTicksToWait != portMAX_DELAY ) && ( ( xNow - xStart ) >= xTicksToWait ) ) ? pdTRUE : pdFALSE;
+
+    ulBlockedReceives++;
+
+    if( ( xTicksToWait != portMAX_DELAY ) && ( ( xNow - xStart ) > xTicksToWait ) )
+    {
+        prvError( "reader woke after its own timeout", ( unsigned long ) ( xNow - xStart ) );
+    }
+
+    if( xCount >= testTRIGGER_LEVEL )
+    {
+        ulLevelWakes++;
+
+        return;
+    }
+
+    if( xTriggerTimeout == portMAX_DELAY )
+    {
+        /* Below the trigger level, only the reader's own timeout wakes it. */
+        if( xOwnTimeout == pdFALSE )
+        {
+            prvError( "reader woke below the trigger level without a trigger timeout", ( unsigned long ) xCount );
+        }
+
+        ulOwnTimeouts++;
+    }
+    else if( ucKind == testWRITTEN_AT_ONCE )
+    {
+        /* The wait cannot be shortened while the scheduler is suspended, so
+         * the reader is woken as if the trigger level had been reached. */
+        if( xNow != xFirst )
+        {
+            prvError( "reader not woken at once by a send with the scheduler suspended", ( unsigned long ) ( xNow - xFirst ) );
+        }
+
+        ulLevelWakes++;
+        ulImmediateWakes++;
+    }
+    else
+    {
+        if( ( ucKind != testWRITTEN_LATE ) && ( ( xNow - xFirst ) > xTriggerTimeout ) )
+        {
+            prvError( "reader woke after the trigger timeout", ( unsigned long ) ( xNow - xFirst ) );
+        }
+
+        if( ( ( xNow - xFirst ) < xTriggerTimeout ) && ( xOwnTimeout == pdFALSE ) )
+        {
+            prvError( "reader woke before the trigger timeout", ( unsigned long ) ( xNow - xFirst ) );
+        }
+
+        /* The kernel counts a timeout wake even if the reader's own timeout
+         * ran out first, once the trigger timeout was started. */
+        ulTimeoutWakes++;
+
+        if( ucKind != testWRITTEN_LATE )
+        {
+            if( xTicksToWait == portMAX_DELAY )
+            {
+                ulSuspendedWakes[ ucKind ]++;
+            }
+            else if( xOwnTimeout == pdFALSE )
+            {
+                ulShortenedWakes[ ucKind ]++;
+            }
+            else
+            {
+                ulKeptWakes++;
+            }
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvReaderTask( void * pvParameters )
+{
+    uint8_t ucData[ testLENGTH + 28 ];
+    size_t xCount, x;
+    TickType_t xTicksToWait, xStart;
+    BaseType_t xEmpty;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        xEmpty = xStreamBufferIsEmpty( xBuffer );
+
+        if( xEmpty != pdFALSE )
+        {
+            xTicksToWait = ( ( prvRandom() % 2U ) != 0U ) ? portMAX_DELAY : ( TickType_t ) ( 1U + ( prvRandom() % ( ( 2U * configMIN( xTriggerTimeout, 20U ) ) + 2U ) ) );
+        }
+        else
+        {
+            xTicksToWait = 0;
+        }
+
+        xStart = xTaskGetTickCount();
+        xCount = xStreamBufferReceive( xBuffer, ucData, sizeof( ucData ), xTicksToWait );
+
+        if( ( xEmpty != pdFALSE ) && ( xCount != 0U ) )
+        {
+            prvCheckWake( xStart, xTicksToWait, xCount );
+        }
+
+        for( x = 0; x < xCount; x++ )
+        {
+            if( ucData[ x ] != prvByte( ulRead ) )
+            {
+                prvError( "data damaged or out of order", ulRead );
+            }
+
+            ulRead++;
+        }
+
+        vSimRun( prvRandom() % 2000U );
+
+        /* Lets data build up, so it is also found without blocking. */
+        if( ( prvRandom() % 8U ) == 0U )
+        {
+            vTaskDelay( ( TickType_t ) ( 1U + ( prvRandom() % 3U ) ) );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static int prvTestEnd( void )
+{
+    uint32_t ulKernelLevelWakes = 0, ulKernelTimeoutWakes = 0;
+
+    if( ulRead != ulWritten )
+    {
+        printf( "FAIL: %lu bytes written and %lu read\n", ( unsigned long ) ulWritten, ( unsigned long ) ulRead );
+        ulErrors++;
+    }
+
+    vStreamBufferGetWakeCounts( xBuffer, &ulKernelLevelWakes, &ulKernelTimeoutWakes );
+
+    if( ( ulKernelLevelWakes != ulLevelWakes ) || ( ulKernelTimeoutWakes != ulTimeoutWakes ) )
+    {
+        printf( "FAIL: %lu level and %lu timeout wakes counted, %lu and %lu seen\n", ( unsigned long ) ulKernelLevelWakes,
+                ( unsigned long ) ulKernelTimeoutWakes, ulLevelWakes, ulTimeoutWakes );
+        ulErrors++;
+    }
+
+    if( xTriggerTimeout != portMAX_DELAY )
+    {
+        /* Each way of moving the reader must have been seen. */
+        if( ( ulSuspendedWakes[ testWRITTEN_BY_TASK ] == 0U ) || ( ulSuspendedWakes[ testWRITTEN_FROM_ISR ] == 0U ) ||
+            ( ulShortenedWakes[ testWRITTEN_BY_TASK ] == 0U ) || ( ulShortenedWakes[ testWRITTEN_FROM_ISR ] == 0U ) ||
+            ( ulKeptWakes == 0U ) || ( ulImmediateWakes == 0U ) )
+        {
+            printf( "FAIL: not every kind of wake was seen\n" );
+            ulErrors++;
+        }
+    }
+
+    printf( "timeout %ld: %lu bytes, %lu task sends, %lu interrupt sends, %lu with the scheduler suspended, %lu blocked receives, "
+            "%lu level wakes, %lu timeout wakes (from the suspended list %lu by the task and %lu from interrupts, shortened %lu and %lu, %lu kept), "
+            "%lu immediate wakes, %lu own timeouts, %lu errors\n",
+            ( xTriggerTimeout == portMAX_DELAY ) ? -1L : ( long ) xTriggerTimeout, ( unsigned long ) ulRead, ulTaskSends, ulISRSends, ulSuspendedSends,
+            ulBlockedReceives, ulLevelWakes, ulTimeoutWakes, ulSuspendedWakes[ 0 ], ulSuspendedWakes[ 1 ], ulShortenedWakes[ 0 ], ulShortenedWakes[ 1 ], ulKeptWakes,
+            ulImmediateWakes, ulOwnTimeouts,
+            ulErrors );
+
+    return ( ( ulErrors != 0U ) || ( ulRead == 0U ) ) ? 1 : 0;
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    if( ( argc == 5 ) && ( strcmp( argv[ 1 ], "test" ) == 0 ) )
+    {
+        ullRandomState ^= ( uint64_t ) strtoull( argv[ 3 ], NULL, 0 ) * 0x9E3779B97F4A7C15ULL;
+        ullStopTime = simSECONDS( atof( argv[ 2 ] ) );
+        xTriggerTimeout = ( strcmp( argv[ 4 ], "none" ) == 0 ) ? portMAX_DELAY : ( TickType_t ) strtoul( argv[ 4 ], NULL, 0 );
+
+        xBuffer = xStreamBufferCreate( testLENGTH, testTRIGGER_LEVEL );
+
+        if( xTriggerTimeout != portMAX_DELAY )
+        {
+            vStreamBufferSetTriggerTimeout( xBuffer, xTriggerTimeout );
+        }
+
+        ( void ) xTaskCreate( prvWriterTask, "Writer", configMINIMAL_STACK_SIZE, NULL, 1, NULL );
+        ( void ) xTaskCreate( prvReaderTask, "Reader", configMINIMAL_STACK_SIZE, NULL, 2, NULL );
+        vSimSetEndTime( ullStopTime + simSECONDS( 1 ), prvTestEnd );
+    }
+    else
+    {
+        printf( "usage: %s test <seconds> <seed> <timeout|none>\n", argv[ 0 ] );
+        return 1;
+    }
+
+    vTaskStartScheduler();
+
+    return 1;
+}
@@ -0,0 +1,693 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test and benchmark of xStreamBufferSendv() and xStreamBufferReceivev(), with
+ * their FromISR versions, on the simulation port.
+ *
+ *   vectors_test test <seconds> <seed> <stream|message>
+ *       A writer task passes data through a statically created buffer of
+ *       100 bytes to a reader task, mixing xStreamBufferSend() with sends of
+ *       up to five fragments, some of them empty, from the task and from an
+ *       interrupt, and when built with configUSE_STREAM_BUFFER_ZERO_COPY set
+ *       to 1 with reserves and commits, so that messages are also read
+ *       across the padding at the end of the storage area.  The reader mixes
+ *       xStreamBufferReceive() with receives into up to five fragments of
+ *       random capacity, from the task and from an interrupt.  The reader
+ *       runs above the writer with odd seeds and below it with even seeds,
+ *       and now and then sleeps for a tick or two so that the buffer fills.
+ *
+ *       A stream buffer carries a numbered byte sequence, which must arrive
+ *       whole and in order.  A message buffer carries numbered messages of
+ *       1 to 60 bytes, each of which must arrive once, in order and with its
+ *       length.  Received data must fill the fragments in order, leaving the
+ *       rest of each fragment and the fragments after the end of the data
+ *       untouched.  From an interrupt a send must write as much of a stream
+ *       as there is space for, or the whole of a message or nothing, and a
+ *       receive must read as much of a stream as the fragments hold, or the
+ *       whole of the next message only if it fits in them.  A message too
+ *       long for the buffer must fail without waiting, and a send or receive
+ *       that gives up must have waited its whole timeout.  The writer stops
+ *       at the given time and the reader then has a second to empty the
+ *       buffer.
+ *
+ *   vectors_test bench
+ *       Host nanoseconds per message of an 8 byte header, a payload and a 2
+ *       byte CRC sent and received through a message buffer, first copied
+ *       into and out of a contiguous buffer and then as three fragments.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+#include "sim.h"
+
+#define testLENGTH            100
+#define testMAX_WRITE         60
+#define testMAX_FRAGMENTS     5
+#define testMAX_MESSAGES      ( 1UL << 22 )
+#define testLENGTH_BYTES      sizeof( configMESSAGE_BUFFER_LENGTH_TYPE )
+#define testGUARD             0xc3U
+
+static StreamBufferHandle_t xBuffer;
+static uint8_t ucStorage[ testLENGTH + 1 ];
+static StaticStreamBuffer_t xStaticBuffer;
+static BaseType_t xMessages;
+static uint64_t ullStopTime;
+
+/* The bytes of the stream, or the messages, written and read so far. */
+static uint32_t ulWritten = 0, ulRead = 0;
+
+static unsigned long ulSends = 0, ulSendvs = 0, ulSendvsFromISR = 0, ulFailedSends = 0, ulTooLong = 0, ulReserves = 0;
+static unsigned long ulReceives = 0, ulReceivevs = 0, ulReceivevsFromISR = 0, ulNotFitting = 0;
+static unsigned long ulErrors = 0;
+static uint64_t ullRandomState = 88172645463325252ULL;
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    ullRandomState ^= ullRandomState << 13;
+    ullRandomState ^= ullRandomState >> 7;
+    ullRandomState ^= ullRandomState << 17;
+
+    return ( uint32_t ) ullRandomState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvError( const char * pcMessage,
+                      unsigned long ulValue )
+{
+    if( ulErrors++ < 5 )
+    {
+        printf( "FAIL: %s (%lu) at tick %lu\n", pcMessage, ulValue, ( unsigned long ) xTaskGetTickCount() );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Byte ulIndex of the stream, or byte ulIndex of message ulSequence. */
+static uint8_t prvByte( uint32_t ulSequence,
+                        uint32_t ulIndex )
+{
+    return ( uint8_t ) ( ( ( ulSequence * 7U ) + ( ulIndex * 13U ) + ( ulIndex >> 8 ) ) + 1U );
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvMessageLength( uint32_t ulSequence )
+{
+    return 1U + ( size_t ) ( ( ( ulSequence * 2654435761U ) >> 16 ) % testMAX_WRITE );
+}
+/*-----------------------------------------------------------*/
+
+/* Fills pucData with the next xCount bytes to be written. */
+static void prvFill( uint8_t * pucData,
+                     size_t xCount )
+{
+    size_t x;
+
+    for( x = 0; x < xCount; x++ )
+    {
+        pucData[ x ] = ( xMessages != pdFALSE ) ? prvByte( ulWritten, ( uint32_t ) x ) : prvByte( 0, ulWritten + ( uint32_t ) x );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Checks that xCount bytes at pucData are the next to be read, as the first
+ * xCount bytes of the stream or the whole of the next message, and if so
+ * counts them as read. */
+static void prvCheck( const uint8_t * pucData,
+                      size_t xCount )
+{
+    size_t x;
+
+    if( ( xMessages != pdFALSE ) && ( xCount != prvMessageLength( ulRead ) ) )
+    {
+        prvError( "message received with the wrong length", ulRead );
+
+        return;
+    }
+
+    for( x = 0; x < xCount; x++ )
+    {
+        if( pucData[ x ] != ( ( xMessages != pdFALSE ) ? prvByte( ulRead, ( uint32_t ) x ) : prvByte( 0, ulRead + ( uint32_t ) x ) ) )
+        {
+            prvError( "data damaged or out of order", ulRead );
+
+            return;
+        }
+    }
+
+    ulRead += ( xMessages != pdFALSE ) ? 1U : ( uint32_t ) xCount;
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvTicksToWait( void )
+{
+    switch( prvRandom() % 4U )
+    {
+        case 0:
+            return 0;
+
+        case 1:
+            return portMAX_DELAY;
+
+        default:
+            return ( TickType_t ) ( 1U + ( prvRandom() % 3U ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckTimeout( const char * pcWhat,
+                             TickType_t xStart,
+                             TickType_t xTicksToWait )
+{
+    if( ( xTicksToWait != portMAX_DELAY ) && ( ( xTaskGetTickCount() - xStart ) < xTicksToWait ) )
+    {
+        prvError( pcWhat, ( unsigned long ) ( xTaskGetTickCount() - xStart ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Splits the xCount bytes at pucData into up to testMAX_FRAGMENTS fragments,
+ * copied to separate rows of ucFragments so the sender cannot treat them as
+ * one block, and returns the number of fragments.  An empty fragment has no
+ * data pointer. */
+static UBaseType_t prvSplit( const uint8_t * pucData,
+                             size_t xCount,
+                             uint8_t ucFragments[ testMAX_FRAGMENTS ][ testLENGTH + 32 ],
+                             StreamBufferVector_t * pxVectors )
+{
+    UBaseType_t uxCount = 1U + ( prvRandom() % testMAX_FRAGMENTS ), ux;
+    size_t xLength;
+
+    for( ux = 0; ux < uxCount; ux++ )
+    {
+        xLength = ( ux == ( uxCount - 1U ) ) ? xCount : ( prvRandom() % ( xCount + 1U ) );
+        xCount -= xLength;
+
+        memcpy( ucFragments[ ux ], pucData, xLength );
+        pucData += xLength;
+
+        pxVectors[ ux ].pvData = ( xLength != 0U ) ? ( void * ) ucFragments[ ux ] : NULL;
+        pxVectors[ ux ].xDataLengthBytes = xLength;
+    }
+
+    return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSendv( BaseType_t xFromISR )
+{
+    static uint8_t ucFragments[ testMAX_FRAGMENTS ][ testLENGTH + 32 ];
+    uint8_t ucData[ testLENGTH + 32 ];
+    StreamBufferVector_t xVectors[ testMAX_FRAGMENTS ];
+    UBaseType_t uxCount;
+    size_t xCount, xSpace, xExpected, xSent;
+    TickType_t xTicksToWait = prvTicksToWait(), xStart = xTaskGetTickCount();
+    BaseType_t xWoken = pdFALSE;
+
+    if( ( xMessages != pdFALSE ) && ( xFromISR == pdFALSE ) && ( ( prvRandom() % 32U ) == 0U ) )
+    {
+        /* A message that cannot fit even in an empty buffer. */
+        xCount = ( testLENGTH - testLENGTH_BYTES ) + 1U + ( prvRandom() % 20U );
+        memset( ucData, 0, xCount );
+        uxCount = prvSplit( ucData, xCount, ucFragments, xVectors );
+
+        if( xStreamBufferSendv( xBuffer, xVectors, uxCount, portMAX_DELAY ) != 0U )
+        {
+            prvError( "message too long for the buffer was sent", ( unsigned long ) xCount );
+        }
+
+        if( xTaskGetTickCount() != xStart )
+        {
+            prvError( "waited to send a message too long for the buffer", ( unsigned long ) ( xTaskGetTickCount() - xStart ) );
+        }
+
+        ulTooLong++;
+
+        return;
+    }
+
+    xCount = ( xMessages != pdFALSE ) ? prvMessageLength( ulWritten ) : ( 1U + ( prvRandom() % testMAX_WRITE ) );
+    prvFill( ucData, xCount );
+    uxCount = prvSplit( ucData, xCount, ucFragments, xVectors );
+
+    if( xFromISR != pdFALSE )
+    {
+        vSimEnterISR();
+
+        /* Nothing else can change the buffer until the interrupt exits. */
+        xSpace = xStreamBufferSpacesAvailable( xBuffer );
+
+        if( xMessages != pdFALSE )
+        {
+            xExpected = ( xSpace >= ( xCount + testLENGTH_BYTES ) ) ? xCount : 0U;
+        }
+        else
+        {
+            xExpected = configMIN( xCount, xSpace );
+        }
+
+        ulWritten += ( xMessages != pdFALSE ) ? ( ( xExpected != 0U ) ? 1U : 0U ) : ( uint32_t ) xExpected;
+        xSent = xStreamBufferSendvFromISR( xBuffer, xVectors, uxCount, &xWoken );
+        vSimExitISR( xWoken );
+
+        if( xSent != xExpected )
+        {
+            prvError( "send from an interrupt wrote the wrong number of bytes", ( unsigned long ) xSent );
+        }
+
+        ulSendvsFromISR++;
+    }
+    else
+    {
+        /* A message is counted first, as the reader may run before the send
+         * returns, and a stream only afterwards, which is safe as the reader
+         * works out what it expects from ulRead. */
+        ulWritten += ( xMessages != pdFALSE ) ? 1U : 0U;
+        xSent = xStreamBufferSendv( xBuffer, xVectors, uxCount, xTicksToWait );
+
+        if( xMessages != pdFALSE )
+        {
+            if( xSent == 0U )
+            {
+                ulWritten--;
+            }
+            else if( xSent != xCount )
+            {
+                prvError( "message sent with the wrong length", ( unsigned long ) xSent );
+            }
+        }
+        else
+        {
+            if( xSent > xCount )
+            {
+                prvError( "sent more bytes than were given", ( unsigned long ) xSent );
+            }
+
+            ulWritten += ( uint32_t ) xSent;
+        }
+
+        if( xSent < xCount )
+        {
+            prvCheckTimeout( "send gave up before its timeout", xStart, xTicksToWait );
+        }
+
+        ulSendvs++;
+    }
+
+    ulFailedSends += ( xSent == 0U ) ? 1U : 0U;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+/* Reserves the next message, or some of the stream, in place so that
+ * messages are also written after padding at the end of the storage area. */
+    static void prvReserveAndCommit( void )
+    {
+        uint8_t * pucRegion = NULL;
+        size_t xCount;
+
+        xCount = ( xMessages != pdFALSE ) ? prvMessageLength( ulWritten ) : ( 1U + ( prvRandom() % testMAX_WRITE ) );
+        xCount = xStreamBufferSendReserve( xBuffer, ( void ** ) &pucRegion, xCount, prvTicksToWait() );
+
+        if( xCount != 0U )
+        {
+            prvFill( pucRegion, xCount );
+            ulWritten += ( xMessages != pdFALSE ) ? 1U : ( uint32_t ) xCount;
+            ( void ) xStreamBufferSendCommit( xBuffer, xCount );
+            ulReserves++;
+        }
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+static void prvWriterTask( void * pvParameters )
+{
+    uint8_t ucData[ testMAX_WRITE ];
+    size_t xCount;
+
+    ( void ) pvParameters;
+
+    while( ( ullSimTime < ullStopTime ) && ( ( xMessages == pdFALSE ) || ( ulWritten < ( testMAX_MESSAGES - 1U ) ) ) )
+    {
+        switch( prvRandom() % 5U )
+        {
+            case 0:
+                xCount = ( xMessages != pdFALSE ) ? prvMessageLength( ulWritten ) : ( 1U + ( prvRandom() % testMAX_WRITE ) );
+                prvFill( ucData, xCount );
+
+                if( xMessages != pdFALSE )
+                {
+                    ulWritten++;
+
+                    if( xStreamBufferSend( xBuffer, ucData, xCount, prvTicksToWait() ) == 0U )
+                    {
+                        ulWritten--;
+                    }
+                }
+                else
+                {
+                    ulWritten += ( uint32_t ) xStreamBufferSend( xBuffer, ucData, xCount, prvTicksToWait() );
+                }
+
+                ulSends++;
+                break;
+
+            case 1:
+                prvSendv( pdTRUE );
+                break;
+
+            case 2:
+                #if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+                {
+                    prvReserveAndCommit();
+                    break;
+                }
+                #endif
+
+            /* Falls through when reservations are not built in. */
+            default:
+                prvSendv( pdFALSE );
+                break;
+        }
+
+        vSimRun( prvRandom() % 3000U );
+    }
+
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReceivev( BaseType_t xFromISR )
+{
+    static uint8_t ucFragments[ testMAX_FRAGMENTS ][ testLENGTH + 32 ];
+    uint8_t ucData[ testLENGTH + 32 ];
+    StreamBufferVector_t xVectors[ testMAX_FRAGMENTS ];
+    UBaseType_t uxCount = 1U + ( prvRandom() % testMAX_FRAGMENTS ), ux;
+    size_t xCapacity = 0, xExpected = 0, xReceived, xCount, xRemaining, x;
+    TickType_t xTicksToWait = prvTicksToWait(), xStart = xTaskGetTickCount();
+    BaseType_t xWoken = pdFALSE;
+
+    for( ux = 0; ux < uxCount; ux++ )
+    {
+        xVectors[ ux ].xDataLengthBytes = prvRandom() % ( ( xMessages != pdFALSE ) ? 31U : 21U );
+        xVectors[ ux ].pvData = ( xVectors[ ux ].xDataLengthBytes != 0U ) ? ( void * ) ucFragments[ ux ] : NULL;
+        xCapacity += xVectors[ ux ].xDataLengthBytes;
+        memset( ucFragments[ ux ], testGUARD, sizeof( ucFragments[ ux ] ) );
+    }
+
+    if( xFromISR != pdFALSE )
+    {
+        vSimEnterISR();
+
+        if( xMessages != pdFALSE )
+        {
+            xExpected = xStreamBufferNextMessageLengthBytes( xBuffer );
+
+            if( xExpected > xCapacity )
+            {
+                xExpected = 0;
+                ulNotFitting++;
+            }
+        }
+        else
+        {
+            xExpected = configMIN( xStreamBufferBytesAvailable( xBuffer ), xCapacity );
+        }
+
+        xReceived = xStreamBufferReceivevFromISR( xBuffer, xVectors, uxCount, &xWoken );
+        vSimExitISR( xWoken );
+
+        if( xReceived != xExpected )
+        {
+            prvError( "receive from an interrupt read the wrong number of bytes", ( unsigned long ) xReceived );
+        }
+
+        ulReceivevsFromISR++;
+    }
+    else
+    {
+        xReceived = xStreamBufferReceivev( xBuffer, xVectors, uxCount, xTicksToWait );
+
+        /* Only an empty buffer is waited for, so a receive with no room for
+         * the stream, or for the next message, can return at once. */
+        if( ( xReceived == 0U ) && ( xCapacity >= ( ( xMessages != pdFALSE ) ? testMAX_WRITE : 1U ) ) )
+        {
+            prvCheckTimeout( "receive gave up before its timeout", xStart, xTicksToWait );
+        }
+
+        ulReceivevs++;
+    }
+
+    if( xReceived > xCapacity )
+    {
+        prvError( "received more bytes than the fragments hold", ( unsigned long ) xReceived );
+
+        return;
+    }
+
+    /* Gather what was received, checking that each fragment was filled before
+     * the next and that nothing was written after the end of the data. */
+    xRemaining = xReceived;
+    xCount = 0;
+
+    for( ux = 0; ux < uxCount; ux++ )
+    {
+        x = configMIN( xVectors[ ux ].xDataLengthBytes, xRemaining );
+        memcpy( &( ucData[ xCount ] ), ucFragments[ ux ], x );
+        xCount += x;
+        xRemaining -= x;
+
+        for( ; x < sizeof( ucFragments[ ux ] ); x++ )
+        {
+            if( ucFragments[ ux ][ x ] != testGUARD )
+            {
+                prvError( "fragment written beyond the data received into it", ( unsigned long ) ux );
+                break;
+            }
+        }
+    }
+
+    if( xReceived != 0U )
+    {
+        prvCheck( ucData, xReceived );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvReaderTask( void * pvParameters )
+{
+    uint8_t ucData[ testLENGTH ];
+    size_t xCount;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        switch( prvRandom() % 4U )
+        {
+            case 0:
+                xCount = xStreamBufferReceive( xBuffer, ucData, ( xMessages != pdFALSE ) ? sizeof( ucData ) : ( 1U + ( prvRandom() % testMAX_WRITE ) ),
+                                               prvTicksToWait() );
+
+                if( xCount != 0U )
+                {
+                    prvCheck( ucData, xCount );
+                }
+
+                ulReceives++;
+                break;
+
+            case 1:
+                prvReceivev( pdTRUE );
+                break;
+
+            default:
+                prvReceivev( pdFALSE );
+                break;
+        }
+
+        vSimRun( prvRandom() % 3000U );
+
+        /* Lets the writer fill the buffer, even when the reader runs above
+         * it. */
+        if( ( prvRandom() % 8U ) == 0U )
+        {
+            vTaskDelay( ( TickType_t ) ( 1U + ( prvRandom() % 2U ) ) );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static int prvTestEnd( void )
+{
+    if( ulRead != ulWritten )
+    {
+        printf( "FAIL: %lu %s written and %lu read\n", ( unsigned long ) ulWritten, ( xMessages != pdFALSE ) ? "messages" : "bytes", ( unsigned long ) ulRead );
+        ulErrors++;
+    }
+
+    if( xStreamBufferIsEmpty( xBuffer ) == pdFALSE )
+    {
+        prvError( "buffer not empty at the end", ( unsigned long ) xStreamBufferBytesAvailable( xBuffer ) );
+    }
+
+    printf( "%s: %lu %s, %lu sends, %lu vector sends, %lu from interrupts, %lu failed, %lu too long, %lu reserves, "
+            "%lu receives, %lu vector receives, %lu from interrupts, %lu not fitting, %lu errors\n",
+            ( xMessages != pdFALSE ) ? "message" : "stream", ( unsigned long ) ulRead, ( xMessages != pdFALSE ) ? "messages" : "bytes", ulSends,
+            ulSendvs, ulSendvsFromISR, ulFailedSends, ulTooLong, ulReserves, ulReceives, ulReceivevs, ulReceivevsFromISR, ulNotFitting, ulErrors );
+
+    return ( ( ulErrors != 0U ) || ( ulRead == 0U ) ) ? 1 : 0;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Benchmark.
+ */
+
+#define benchMESSAGES    2000000L
+
+static volatile uint8_t ucSink;
+
+static double prvNanoseconds( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( double ) xNow.tv_sec * 1e9 ) + ( double ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchTask( void * pvParameters )
+{
+    static const size_t xPayloads[] = { 16, 64, 256, 512 };
+    static uint8_t ucHeader[ 8 ], ucPayload[ 512 ], ucCRC[ 2 ], ucContiguous[ 8 + 512 + 2 ];
+    static uint8_t ucRxHeader[ 8 ], ucRxPayload[ 512 ], ucRxCRC[ 2 ];
+    MessageBufferHandle_t xMessageBuffer = xMessageBufferCreate( 2048 );
+    StreamBufferVector_t xTx[ 3 ], xRx[ 3 ];
+    double dTimes[ 3 ];
+    size_t xPayload, xCount;
+    long l;
+    int i;
+
+    ( void ) pvParameters;
+
+    for( i = 0; i < ( int ) ( sizeof( xPayloads ) / sizeof( xPayloads[ 0 ] ) ); i++ )
+    {
+        xPayload = xPayloads[ i ];
+        dTimes[ 0 ] = prvNanoseconds();
+
+        for( l = 0; l < benchMESSAGES; l++ )
+        {
+            memcpy( ucContiguous, ucHeader, sizeof( ucHeader ) );
+            memcpy( &( ucContiguous[ 8 ] ), ucPayload, xPayload );
+            memcpy( &( ucContiguous[ 8 + xPayload ] ), ucCRC, sizeof( ucCRC ) );
+            ( void ) xMessageBufferSend( xMessageBuffer, ucContiguous, xPayload + 10U, 0 );
+
+            xCount = xMessageBufferReceive( xMessageBuffer, ucContiguous, sizeof( ucContiguous ), 0 );
+            memcpy( ucRxHeader, ucContiguous, sizeof( ucRxHeader ) );
+            memcpy( ucRxPayload, &( ucContiguous[ 8 ] ), xCount - 10U );
+            memcpy( ucRxCRC, &( ucContiguous[ xCount - 2U ] ), sizeof( ucRxCRC ) );
+            ucSink = ucRxCRC[ 0 ];
+        }
+
+        dTimes[ 1 ] = prvNanoseconds();
+
+        for( l = 0; l < benchMESSAGES; l++ )
+        {
+            xTx[ 0 ].pvData = ucHeader;
+            xTx[ 0 ].xDataLengthBytes = sizeof( ucHeader );
+            xTx[ 1 ].pvData = ucPayload;
+            xTx[ 1 ].xDataLengthBytes = xPayload;
+            xTx[ 2 ].pvData = ucCRC;
+            xTx[ 2 ].xDataLengthBytes = sizeof( ucCRC );
+            ( void ) xMessageBufferSendv( xMessageBuffer, xTx, 3, 0 );
+
+            xRx[ 0 ].pvData = ucRxHeader;
+            xRx[ 0 ].xDataLengthBytes = sizeof( ucRxHeader );
+            xRx[ 1 ].pvData = ucRxPayload;
+            xRx[ 1 ].xDataLengthBytes = xPayload;
+            xRx[ 2 ].pvData = ucRxCRC;
+            xRx[ 2 ].xDataLengthBytes = sizeof( ucRxCRC );
+            ( void ) xMessageBufferReceivev( xMessageBuffer, xRx, 3, 0 );
+            ucSink = ucRxCRC[ 0 ];
+        }
+
+        dTimes[ 2 ] = prvNanoseconds();
+
+        printf( "payload %3u bytes: copied %6.1f ns, fragments %6.1f ns\n", ( unsigned ) xPayload,
+                ( dTimes[ 1 ] - dTimes[ 0 ] ) / benchMESSAGES, ( dTimes[ 2 ] - dTimes[ 1 ] ) / benchMESSAGES );
+    }
+
+    exit( 0 );
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    unsigned long ulSeed;
+
+    if( ( argc == 5 ) && ( strcmp( argv[ 1 ], "test" ) == 0 ) )
+    {
+        ulSeed = strtoul( argv[ 3 ], NULL, 0 );
+        ullRandomState ^= ( uint64_t ) ulSeed * 0x9E3779B97F4A7C15ULL;
+        ullStopTime = simSECONDS( atof( argv[ 2 ] ) );
+        xMessages = ( strcmp( argv[ 4 ], "message" ) == 0 ) ? pdTRUE : pdFALSE;
+
+        if( xMessages != pdFALSE )
+        {
+            xBuffer = xMessageBufferCreateStatic( testLENGTH, ucStorage, &xStaticBuffer );
+        }
+        else
+        {
+            xBuffer = xStreamBufferCreateStatic( testLENGTH, 1, ucStorage, &xStaticBuffer );
+        }
+
+        ( void ) xTaskCreate( prvWriterTask, "Writer", configMINIMAL_STACK_SIZE, NULL, 2, NULL );
+        ( void ) xTaskCreate( prvReaderTask, "Reader", configMINIMAL_STACK_SIZE, NULL, ( ( ulSeed % 2U ) != 0U ) ? 3 : 1, NULL );
+        vSimSetEndTime( ullStopTime + simSECONDS( 1 ), prvTestEnd );
+    }
+    else if( ( argc == 2 ) && ( strcmp( argv[ 1 ], "bench" ) == 0 ) )
+    {
+        ( void ) xTaskCreate( prvBenchTask, "Bench", configMINIMAL_STACK_SIZE, NULL, 1, NULL );
+    }
+    else
+    {
+        printf( "usage: %s test <seconds> <seed> <stream|message> | bench\n", argv[ 0 ] );
+        return 1;
+    }
+
+    vTaskStartScheduler();
+
+    return 1;
+}
@@ -0,0 +1,570 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*
+ * Test of the zero copy functions of stream and message buffers,
+ * xStreamBufferSendReserve() and xStreamBufferSendCommit() on the writing side
+ * and xStreamBufferReceiveAcquire() and xStreamBufferReceiveRelease() on the
+ * reading side, with their FromISR versions, on the simulation port.
+ *
+ *   zero_copy_test test <seconds> <seed> <stream|message>
+ *       A writer task passes data through a statically created buffer of
+ *       100 bytes to a reader task, mixing xStreamBufferSend() with reserves
+ *       and commits from the task and from an interrupt.  It fills each
+ *       reserved region with junk first and holds the region for a while
+ *       before writing the data, commits less than it reserved, and now and
+ *       then abandons a reservation with a commit of 0.  The reader mixes
+ *       xStreamBufferReceive() with acquires and releases from the task and
+ *       from an interrupt, holding acquired data before checking it and
+ *       scribbling over it before releasing it, and releasing only part of
+ *       the bytes acquired from a stream buffer.  The reader runs above the
+ *       writer with odd seeds and below it with even seeds, and now and then
+ *       sleeps for a tick or two so that the buffer fills.
+ *
+ *       A stream buffer carries a numbered byte sequence, which must arrive
+ *       whole and in order.  A message buffer carries numbered messages of
+ *       1 to 60 bytes, each of which must arrive once, in order, with the
+ *       length that was committed.  Every reserved and acquired region must
+ *       lie inside the storage area without wrapping, an acquire may only
+ *       return NULL for a message that was copied in and wraps, a message of
+ *       up to half the buffer less the length field must always be reserved
+ *       when waiting without a timeout, and a reserve or acquire that times
+ *       out must have waited its whole timeout.  The writer stops at the
+ *       given time and the reader then has a second to empty the buffer.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+#include "sim.h"
+
+#define testLENGTH            100
+#define testMAX_WRITE         60
+#define testMAX_MESSAGES      ( 1UL << 22 )
+#define testLENGTH_BYTES      sizeof( configMESSAGE_BUFFER_LENGTH_TYPE )
+#define testJUNK              0xeeU
+#define testSCRIBBLE          0x5aU
+
+static StreamBufferHandle_t xBuffer;
+static uint8_t ucStorage[ testLENGTH + 1 ];
+static StaticStreamBuffer_t xStaticBuffer;
+static BaseType_t xMessages;
+static uint64_t ullStopTime;
+
+/* The bytes of the stream, or the messages, written and read so far. */
+static uint32_t ulWritten = 0, ulRead = 0;
+
+/* Set for each message that was copied in with xStreamBufferSend(). */
+static uint8_t ucCopiedIn[ testMAX_MESSAGES / 8 ];
+
+static unsigned long ulSends = 0, ulReserves = 0, ulReservesFromISR = 0, ulAbandoned = 0, ulPartialCommits = 0, ulReserveFailures = 0;
+static unsigned long ulReceives = 0, ulAcquires = 0, ulAcquiresFromISR = 0, ulPartialReleases = 0, ulWrapped = 0;
+static unsigned long ulErrors = 0;
+static uint64_t ullRandomState = 88172645463325252ULL;
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRandom( void )
+{
+    ullRandomState ^= ullRandomState << 13;
+    ullRandomState ^= ullRandomState >> 7;
+    ullRandomState ^= ullRandomState << 17;
+
+    return ( uint32_t ) ullRandomState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvError( const char * pcMessage,
+                      unsigned long ulValue )
+{
+    if( ulErrors++ < 5 )
+    {
+        printf( "FAIL: %s (%lu) at tick %lu\n", pcMessage, ulValue, ( unsigned long ) xTaskGetTickCount() );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Byte ulIndex of the stream, or byte ulIndex of message ulSequence. */
+static uint8_t prvByte( uint32_t ulSequence,
+                        uint32_t ulIndex )
+{
+    return ( uint8_t ) ( ( ( ulSequence * 7U ) + ( ulIndex * 13U ) + ( ulIndex >> 8 ) ) + 1U );
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvMessageLength( uint32_t ulSequence )
+{
+    return 1U + ( size_t ) ( ( ( ulSequence * 2654435761U ) >> 16 ) % testMAX_WRITE );
+}
+/*-----------------------------------------------------------*/
+
+/* Fills pucData with the next xCount bytes to be written. */
+static void prvFill( uint8_t * pucData,
+                     size_t xCount )
+{
+    size_t x;
+
+    for( x = 0; x < xCount; x++ )
+    {
+        pucData[ x ] = ( xMessages != pdFALSE ) ? prvByte( ulWritten, ( uint32_t ) x ) : prvByte( 0, ulWritten + ( uint32_t ) x );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Checks that xCount bytes at pucData are the next to be read, as the first
+ * xCount bytes of the stream or the whole of the next message. */
+static BaseType_t prvCheck( const uint8_t * pucData,
+                            size_t xCount )
+{
+    size_t x;
+
+    if( ( xMessages != pdFALSE ) && ( xCount != prvMessageLength( ulRead ) ) )
+    {
+        prvError( "message received with the wrong length", ulRead );
+
+        return pdFALSE;
+    }
+
+    for( x = 0; x < xCount; x++ )
+    {
+        if( pucData[ x ] != ( ( xMessages != pdFALSE ) ? prvByte( ulRead, ( uint32_t ) x ) : prvByte( 0, ulRead + ( uint32_t ) x ) ) )
+        {
+            prvError( "data damaged or out of order", ulRead );
+
+            return pdFALSE;
+        }
+    }
+
+    return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckRegion( const char * pcWhat,
+                            const uint8_t * pucRegion,
+                            size_t xCount )
+{
+    if( ( pucRegion < ucStorage ) || ( ( pucRegion + xCount ) > &( ucStorage[ sizeof( ucStorage ) ] ) ) )
+    {
+        prvError( pcWhat, ( unsigned long ) ( pucRegion - ucStorage ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static TickType_t prvTicksToWait( void )
+{
+    switch( prvRandom() % 4U )
+    {
+        case 0:
+            return 0;
+
+        case 1:
+            return portMAX_DELAY;
+
+        default:
+            return ( TickType_t ) ( 1U + ( prvRandom() % 3U ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckTimeout( const char * pcWhat,
+                             TickType_t xStart,
+                             TickType_t xTicksToWait )
+{
+    if( ( xTicksToWait != portMAX_DELAY ) && ( ( xTaskGetTickCount() - xStart ) < xTicksToWait ) )
+    {
+        prvError( pcWhat, ( unsigned long ) ( xTaskGetTickCount() - xStart ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+/* Reserves, fills and commits a region from the task if xFromISR is pdFALSE,
+ * or from an interrupt. */
+static void prvReserveAndCommit( BaseType_t xFromISR )
+{
+    uint8_t * pucRegion = NULL;
+    size_t xWanted, xReserved, xCommitted;
+    TickType_t xTicksToWait = prvTicksToWait(), xStart = xTaskGetTickCount();
+    BaseType_t xWoken = pdFALSE;
+
+    /* A message is reserved with a few bytes to spare, and committed with its
+     * real length. */
+    xWanted = ( xMessages != pdFALSE ) ? ( prvMessageLength( ulWritten ) + ( prvRandom() % 4U ) ) : ( 1U + ( prvRandom() % testMAX_WRITE ) );
+
+    if( xFromISR != pdFALSE )
+    {
+        vSimEnterISR();
+        xReserved = xStreamBufferSendReserveFromISR( xBuffer, ( void ** ) &pucRegion, xWanted );
+    }
+    else
+    {
+        xReserved = xStreamBufferSendReserve( xBuffer, ( void ** ) &pucRegion, xWanted, xTicksToWait );
+    }
+
+    if( xReserved == 0U )
+    {
+        if( xFromISR == pdFALSE )
+        {
+            if( ( xMessages != pdFALSE ) && ( xTicksToWait == portMAX_DELAY ) && ( ( xWanted + testLENGTH_BYTES ) <= ( testLENGTH / 2U ) ) )
+            {
+                prvError( "short message not reserved", ( unsigned long ) xWanted );
+            }
+            else if( ( xMessages == pdFALSE ) || ( ( xWanted + testLENGTH_BYTES ) <= ( testLENGTH / 2U ) ) )
+            {
+                /* A longer message may not be reserved without waiting. */
+                prvCheckTimeout( "reserve gave up before its timeout", xStart, xTicksToWait );
+            }
+        }
+        else
+        {
+            vSimExitISR( pdFALSE );
+        }
+
+        ulReserveFailures++;
+
+        return;
+    }
+
+    if( ( xReserved > xWanted ) || ( ( xMessages != pdFALSE ) && ( xReserved != xWanted ) ) )
+    {
+        prvError( "reserved the wrong number of bytes", ( unsigned long ) xReserved );
+    }
+
+    prvCheckRegion( "reserved a region outside the storage area", pucRegion, xReserved );
+
+    /* The region is not visible to the reader until it is committed, so the
+     * junk must never be read. */
+    memset( pucRegion, testJUNK, xReserved );
+
+    if( xFromISR == pdFALSE )
+    {
+        vSimRun( prvRandom() % 2000U );
+    }
+
+    if( ( prvRandom() % 8U ) == 0U )
+    {
+        xCommitted = 0;
+        ulAbandoned++;
+    }
+    else
+    {
+        xCommitted = ( xMessages != pdFALSE ) ? prvMessageLength( ulWritten ) : ( 1U + ( prvRandom() % xReserved ) );
+        ulPartialCommits += ( xCommitted < xReserved ) ? 1U : 0U;
+        prvFill( pucRegion, xCommitted );
+    }
+
+    /* Counted first, as the reader may run before the commit returns. */
+    ulWritten += ( xMessages != pdFALSE ) ? ( ( xCommitted != 0U ) ? 1U : 0U ) : ( uint32_t ) xCommitted;
+
+    if( xFromISR != pdFALSE )
+    {
+        if( xStreamBufferSendCommitFromISR( xBuffer, xCommitted, &xWoken ) != xCommitted )
+        {
+            prvError( "commit returned the wrong count", ( unsigned long ) xCommitted );
+        }
+
+        vSimExitISR( xWoken );
+        ulReservesFromISR++;
+    }
+    else
+    {
+        if( xStreamBufferSendCommit( xBuffer, xCommitted ) != xCommitted )
+        {
+            prvError( "commit returned the wrong count", ( unsigned long ) xCommitted );
+        }
+
+        ulReserves++;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriterTask( void * pvParameters )
+{
+    uint8_t ucData[ testMAX_WRITE ];
+    size_t xCount;
+    uint32_t ulSequence;
+
+    ( void ) pvParameters;
+
+    while( ( ullSimTime < ullStopTime ) && ( ( xMessages == pdFALSE ) || ( ulWritten < ( testMAX_MESSAGES - 1U ) ) ) )
+    {
+        switch( prvRandom() % 4U )
+        {
+            case 0:
+                xCount = ( xMessages != pdFALSE ) ? prvMessageLength( ulWritten ) : ( 1U + ( prvRandom() % testMAX_WRITE ) );
+                ulSequence = ulWritten;
+                prvFill( ucData, xCount );
+
+                if( xMessages != pdFALSE )
+                {
+                    /* Marked first, as the reader may run before the send
+                     * returns. */
+                    ucCopiedIn[ ulSequence / 8U ] |= ( uint8_t ) ( 1U << ( ulSequence % 8U ) );
+                    ulWritten++;
+
+                    if( xStreamBufferSend( xBuffer, ucData, xCount, prvTicksToWait() ) == 0U )
+                    {
+                        ulWritten--;
+                        ucCopiedIn[ ulSequence / 8U ] &= ( uint8_t ) ~( 1U << ( ulSequence % 8U ) );
+                    }
+                }
+                else
+                {
+                    /* Not counted until it returns, which is only safe as
+                     * the reader works out what it expects from ulRead. */
+                    ulWritten += ( uint32_t ) xStreamBufferSend( xBuffer, ucData, xCount, prvTicksToWait() );
+                }
+
+                ulSends++;
+                break;
+
+            case 1:
+                prvReserveAndCommit( pdTRUE );
+                break;
+
+            default:
+                prvReserveAndCommit( pdFALSE );
+                break;
+        }
+
+        vSimRun( prvRandom() % 3000U );
+    }
+
+    vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+/* Acquires, checks and releases data from the task if xFromISR is pdFALSE, or
+ * from an interrupt. */
+static void prvAcquireAndRelease( BaseType_t xFromISR )
+{
+    uint8_t * pucData = NULL;
+    uint8_t ucCopy[ testLENGTH ];
+    size_t xAcquired, xRelease, xReleased;
+    TickType_t xTicksToWait = prvTicksToWait(), xStart = xTaskGetTickCount();
+    BaseType_t xWoken = pdFALSE;
+
+    if( xFromISR != pdFALSE )
+    {
+        vSimEnterISR();
+        xAcquired = xStreamBufferReceiveAcquireFromISR( xBuffer, ( void ** ) &pucData );
+    }
+    else
+    {
+        xAcquired = xStreamBufferReceiveAcquire( xBuffer, ( void ** ) &pucData, xTicksToWait );
+    }
+
+    if( xAcquired == 0U )
+    {
+        if( xFromISR != pdFALSE )
+        {
+            vSimExitISR( pdFALSE );
+        }
+        else
+        {
+            prvCheckTimeout( "acquire gave up before its timeout", xStart, xTicksToWait );
+        }
+
+        return;
+    }
+
+    if( pucData == NULL )
+    {
+        /* Only a message copied in by xStreamBufferSend() can wrap, and it
+         * must then be read by copying it out. */
+        if( ( xMessages == pdFALSE ) || ( ( ucCopiedIn[ ulRead / 8U ] & ( 1U << ( ulRead % 8U ) ) ) == 0U ) )
+        {
+            prvError( "acquire returned no data pointer", ulRead );
+        }
+
+        if( xFromISR != pdFALSE )
+        {
+            xReleased = xStreamBufferReceiveFromISR( xBuffer, ucCopy, sizeof( ucCopy ), &xWoken );
+        }
+        else
+        {
+            xReleased = xStreamBufferReceive( xBuffer, ucCopy, sizeof( ucCopy ), 0 );
+        }
+
+        if( xReleased != xAcquired )
+        {
+            prvError( "wrapped message could not be received", ulRead );
+        }
+
+        if( prvCheck( ucCopy, xAcquired ) != pdFALSE )
+        {
+            ulRead++;
+        }
+
+        ulWrapped++;
+
+        if( xFromISR != pdFALSE )
+        {
+            vSimExitISR( xWoken );
+        }
+
+        return;
+    }
+
+    prvCheckRegion( "acquired a region outside the storage area", pucData, xAcquired );
+
+    if( xFromISR == pdFALSE )
+    {
+        vSimRun( prvRandom() % 2000U );
+    }
+
+    /* All of a message, or some of the bytes of a stream. */
+    xRelease = ( xMessages != pdFALSE ) ? xAcquired : ( 1U + ( prvRandom() % xAcquired ) );
+
+    if( prvCheck( pucData, ( xMessages != pdFALSE ) ? xAcquired : xRelease ) != pdFALSE )
+    {
+        ulRead += ( xMessages != pdFALSE ) ? 1U : ( uint32_t ) xRelease;
+    }
+
+    ulPartialReleases += ( xRelease < xAcquired ) ? 1U : 0U;
+    memset( pucData, testSCRIBBLE, xRelease );
+
+    if( xFromISR != pdFALSE )
+    {
+        xReleased = xStreamBufferReceiveReleaseFromISR( xBuffer, xRelease, &xWoken );
+        vSimExitISR( xWoken );
+        ulAcquiresFromISR++;
+    }
+    else
+    {
+        xReleased = xStreamBufferReceiveRelease( xBuffer, xRelease );
+        ulAcquires++;
+    }
+
+    if( xReleased != xRelease )
+    {
+        prvError( "release returned the wrong count", ( unsigned long ) xReleased );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvReaderTask( void * pvParameters )
+{
+    uint8_t ucData[ testLENGTH ];
+    size_t xCount;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        switch( prvRandom() % 4U )
+        {
+            case 0:
+                xCount = xStreamBufferReceive( xBuffer, ucData, ( xMessages != pdFALSE ) ? sizeof( ucData ) : ( 1U + ( prvRandom() % testMAX_WRITE ) ),
+                                               prvTicksToWait() );
+
+                if( ( xCount != 0U ) && ( prvCheck( ucData, xCount ) != pdFALSE ) )
+                {
+                    ulRead += ( xMessages != pdFALSE ) ? 1U : ( uint32_t ) xCount;
+                }
+
+                ulReceives++;
+                break;
+
+            case 1:
+                prvAcquireAndRelease( pdTRUE );
+                break;
+
+            default:
+                prvAcquireAndRelease( pdFALSE );
+                break;
+        }
+
+        vSimRun( prvRandom() % 3000U );
+
+        /* Lets the writer fill the buffer, even when the reader runs above
+         * it. */
+        if( ( prvRandom() % 8U ) == 0U )
+        {
+            vTaskDelay( ( TickType_t ) ( 1U + ( prvRandom() % 2U ) ) );
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static int prvTestEnd( void )
+{
+    if( ulRead != ulWritten )
+    {
+        printf( "FAIL: %lu %s written and %lu read\n", ( unsigned long ) ulWritten, ( xMessages != pdFALSE ) ? "messages" : "bytes", ( unsigned long ) ulRead );
+        ulErrors++;
+    }
+
+    if( xStreamBufferIsEmpty( xBuffer ) == pdFALSE )
+    {
+        prvError( "buffer not empty at the end", ( unsigned long ) xStreamBufferBytesAvailable( xBuffer ) );
+    }
+
+    printf( "%s: %lu %s, %lu sends, %lu reserves, %lu from interrupts, %lu abandoned, %lu partly committed, %lu not reserved, "
+            "%lu receives, %lu acquires, %lu from interrupts, %lu partly released, %lu wrapped, %lu errors\n",
+            ( xMessages != pdFALSE ) ? "message" : "stream", ( unsigned long ) ulRead, ( xMessages != pdFALSE ) ? "messages" : "bytes", ulSends,
+            ulReserves, ulReservesFromISR, ulAbandoned, ulPartialCommits, ulReserveFailures, ulReceives, ulAcquires, ulAcquiresFromISR,
+            ulPartialReleases, ulWrapped, ulErrors );
+
+    return ( ( ulErrors != 0U ) || ( ulRead == 0U ) ) ? 1 : 0;
+}
+/*-----------------------------------------------------------*/
+
+int main( int argc,
+          char ** argv )
+{
+    unsigned long ulSeed;
+
+    if( ( argc == 5 ) && ( strcmp( argv[ 1 ], "test" ) == 0 ) )
+    {
+        ulSeed = strtoul( argv[ 3 ], NULL, 0 );
+        ullRandomState ^= ( uint64_t ) ulSeed * 0x9E3779B97F4A7C15ULL;
+        ullStopTime = simSECONDS( atof( argv[ 2 ] ) );
+        xMessages = ( strcmp( argv[ 4 ], "message" ) == 0 ) ? pdTRUE : pdFALSE;
+
+        if( xMessages != pdFALSE )
+        {
+            xBuffer = xMessageBufferCreateStatic( testLENGTH, ucStorage, &xStaticBuffer );
+        }
+        else
+        {
+            xBuffer = xStreamBufferCreateStatic( testLENGTH, 1, ucStorage, &xStaticBuffer );
+        }
+
+        ( void ) xTaskCreate( prvWriterTask, "Writer", configMINIMAL_STACK_SIZE, NULL, 2, NULL );
+        ( void ) xTaskCreate( prvReaderTask, "Reader", configMINIMAL_STACK_SIZE, NULL, ( ( ulSeed % 2U ) != 0U ) ? 3 : 1, NULL );
+        vSimSetEndTime( ullStopTime + simSECONDS( 1 ), prvTestEnd );
+    }
+    else
+    {
+        printf( "usage: %s test <seconds> <seed> <stream|message>\n", argv[ 0 ] );
+        return 1;
+    }
+
+    vTaskStartScheduler();
+
+    return 1;
+}
@@ -857,6 +857,47 @@
     #define configUSE_TICKLESS_IDLE    0
 #endif
 
+#ifndef configUSE_DYNAMIC_TICK
+
+/* Set to 1 to only generate tick interrupts when the kernel has work to do,
+ * even while tasks are running.  Requires support from the port layer. */
+    #define configUSE_DYNAMIC_TICK    0
+#endif
+
+#if ( configUSE_DYNAMIC_TICK == 1 )
+    #if ( configUSE_TICKLESS_IDLE != 0 )
+        #error configUSE_TICKLESS_IDLE must be 0 when configUSE_DYNAMIC_TICK is 1 as the dynamic tick already stops the tick interrupt while the idle task runs.
+    #endif
+
+    #if ( configUSE_TICK_HOOK == 1 )
+        #error configUSE_TICK_HOOK must be 0 when configUSE_DYNAMIC_TICK is 1 as the tick hook cannot be called for ticks that do not generate an interrupt.
+    #endif
+
+    #ifndef portSYNC_TICK_COUNT
+        #error configUSE_DYNAMIC_TICK is set to 1 but the port does not support a dynamic tick.
+    #endif
+#endif
+
+#ifndef portSYNC_TICK_COUNT
+    #define portSYNC_TICK_COUNT()
+#endif
+
+#ifndef portUPDATE_TICK_INTERRUPT
+    #define portUPDATE_TICK_INTERRUPT()
+#endif
+
+#ifndef configTICK_UNBLOCK_LIMIT
+
+/* The maximum number of tasks the tick interrupt moves out of the Blocked state
+ * while interrupts are masked.  Set to 0 to move every task that is due in one
+ * go.  A value greater than 0 requires support from the port layer. */
+    #define configTICK_UNBLOCK_LIMIT    0
+#endif
+
+#if ( ( configTICK_UNBLOCK_LIMIT > 0 ) && !defined( portTICK_UNBLOCK_DEFERRED ) )
+    #error configTICK_UNBLOCK_LIMIT is greater than 0 but the port does not call xTaskUnblockDeferred() from its tick interrupt.
+#endif
+
 #ifndef configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING
     #define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )
 #endif
@@ -889,6 +930,225 @@
     #define configUSE_TIME_SLICING    1
 #endif
 
+#ifndef configUSE_DELAYED_TASK_WHEEL
+
+/* Set to 1 to hold Blocked state tasks in a hierarchical timing wheel instead
+ * of the two sorted delayed task lists. */
+    #define configUSE_DELAYED_TASK_WHEEL    0
+#endif
+
+#ifndef configDELAYED_TASK_WHEEL_SLOT_BITS
+
+/* Each level of the delayed task wheel has ( 1 << configDELAYED_TASK_WHEEL_SLOT_BITS )
+ * slots, and enough levels are used to cover every bit of TickType_t. */
+    #define configDELAYED_TASK_WHEEL_SLOT_BITS    4
+#endif
+
+#if ( ( configDELAYED_TASK_WHEEL_SLOT_BITS < 1 ) || ( configDELAYED_TASK_WHEEL_SLOT_BITS > 5 ) )
+    #error configDELAYED_TASK_WHEEL_SLOT_BITS must be between 1 and 5 so the slots of one wheel level fit in a 32-bit occupancy map.
+#endif
+
+#ifndef configUSE_TIMER_WHEEL
+
+/* Set to 1 to hold active software timers in a hierarchical timing wheel
+ * instead of the sorted current timer list. */
+    #define configUSE_TIMER_WHEEL    0
+#endif
+
+#ifndef configTIMER_WHEEL_SLOT_BITS
+
+/* Each level of the timer wheel has ( 1 << configTIMER_WHEEL_SLOT_BITS ) slots,
+ * and enough levels are used to cover every bit of TickType_t. */
+    #define configTIMER_WHEEL_SLOT_BITS    4
+#endif
+
+#if ( ( configTIMER_WHEEL_SLOT_BITS < 1 ) || ( configTIMER_WHEEL_SLOT_BITS > 5 ) )
+    #error configTIMER_WHEEL_SLOT_BITS must be between 1 and 5 so the slots of one wheel level fit in a 32-bit occupancy map.
+#endif
+
+#ifndef configUSE_EDF_SCHEDULING
+
+/* Set to 1 to hold the tasks that run at configEDF_TASK_PRIORITY in order of
+ * absolute deadline, so the one with the earliest deadline runs, instead of
+ * time slicing between them. */
+    #define configUSE_EDF_SCHEDULING    0
+#endif
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    #ifndef configEDF_TASK_PRIORITY
+        #error configEDF_TASK_PRIORITY must be defined to the priority used by deadline scheduled tasks when configUSE_EDF_SCHEDULING is 1.
+    #endif
+
+    #if ( ( configEDF_TASK_PRIORITY <= 0 ) || ( configEDF_TASK_PRIORITY >= configMAX_PRIORITIES ) )
+        #error configEDF_TASK_PRIORITY must be above the idle priority and less than configMAX_PRIORITIES.
+    #endif
+#endif
+
+#ifndef configUSE_TASK_BUDGETS
+
+/* Set to 1 to allow tasks to be given an execution time budget that is
+ * replenished every period.  A task that uses up its budget is demoted to the
+ * idle priority, or blocked, until the budget is replenished. */
+    #define configUSE_TASK_BUDGETS    0
+#endif
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+    #ifndef portGET_BUDGET_COUNTER_VALUE
+        #error configUSE_TASK_BUDGETS is set to 1 but portGET_BUDGET_COUNTER_VALUE() is not defined.  portGET_BUDGET_COUNTER_VALUE() must return a free running 32-bit counter, such as a CPU cycle counter, that is used to measure task execution time.
+    #endif
+#endif
+
+#ifndef portCONFIGURE_BUDGET_COUNTER
+    #define portCONFIGURE_BUDGET_COUNTER()
+#endif
+
+#ifndef configUSE_PREEMPTION_THRESHOLD
+
+/* Set to 1 to allow a task to be given a preemption threshold above its
+ * priority.  While the task is running it can only be preempted by tasks whose
+ * priority is above its threshold. */
+    #define configUSE_PREEMPTION_THRESHOLD    0
+#endif
+
+#ifndef configUSE_SHARED_STACKS
+
+/* Set to 1 to allow run to completion tasks that cannot preempt each other to
+ * be created on the same stack with xTaskCreateStaticSharedStack(). */
+    #define configUSE_SHARED_STACKS    0
+#endif
+
+#if ( configUSE_SHARED_STACKS == 1 )
+    #if ( configUSE_PREEMPTION_THRESHOLD == 0 )
+        #error configUSE_PREEMPTION_THRESHOLD must be 1 when configUSE_SHARED_STACKS is 1 as tasks that share a stack must not preempt each other.
+    #endif
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 0 )
+        #error configSUPPORT_STATIC_ALLOCATION must be 1 when configUSE_SHARED_STACKS is 1 as a shared stack is always provided by the application.
+    #endif
+
+    #if ( ( portUSING_MPU_WRAPPERS == 1 ) || ( portHAS_STACK_OVERFLOW_CHECKING == 1 ) )
+        #error configUSE_SHARED_STACKS is not supported by ports that use MPU wrappers or that check the stack limit in hardware.
+    #endif
+
+    #if ( INCLUDE_xTaskDelayUntil == 0 )
+        #error INCLUDE_xTaskDelayUntil must be 1 when configUSE_SHARED_STACKS is 1 as periodic tasks on a shared stack are released by xTaskDelayUntil().
+    #endif
+#endif
+
+#ifndef configUSE_CYCLIC_EXECUTIVE
+
+/* Set to 1 to include the time triggered cyclic executive in cyclic.c, which
+ * dispatches the functions of a static schedule table from a single task. */
+    #define configUSE_CYCLIC_EXECUTIVE    0
+#endif
+
+#ifndef configUSE_CYCLIC_OVERRUN_HOOK
+    #define configUSE_CYCLIC_OVERRUN_HOOK    0
+#endif
+
+#if ( configUSE_CYCLIC_EXECUTIVE == 1 )
+    #if ( INCLUDE_xTaskDelayUntil == 0 )
+        #error INCLUDE_xTaskDelayUntil must be 1 when configUSE_CYCLIC_EXECUTIVE is 1 as the cyclic executive waits for each frame with xTaskDelayUntil().
+    #endif
+
+    #ifndef portGET_BUDGET_COUNTER_VALUE
+        #error configUSE_CYCLIC_EXECUTIVE is set to 1 but portGET_BUDGET_COUNTER_VALUE() is not defined.  portGET_BUDGET_COUNTER_VALUE() must return a free running 32-bit counter, such as a CPU cycle counter, that is used to measure the execution time of each slot.
+    #endif
+#endif
+
+#ifndef configUSE_PERIODIC_TASKS
+
+/* Set to 1 to include the periodic task functions in periodic.c, which create
+ * tasks that are released at fixed times and record their release jitter,
+ * response time and deadline misses. */
+    #define configUSE_PERIODIC_TASKS    0
+#endif
+
+#if ( ( configUSE_PERIODIC_TASKS == 1 ) && ( INCLUDE_xTaskDelayUntil == 0 ) )
+    #error INCLUDE_xTaskDelayUntil must be 1 when configUSE_PERIODIC_TASKS is 1 as periodic tasks wait for each release with xTaskDelayUntil().
+#endif
+
+#ifndef configUSE_REF_QUEUES
+
+/* Set to 1 to include the reference queue functions in refqueue.c, which pass
+ * items between tasks in slots taken from a fixed pool instead of copying
+ * them into and out of the queue. */
+    #define configUSE_REF_QUEUES    0
+#endif
+
+#ifndef configUSE_SPSC_RINGS
+
+/* Set to 1 to include the single producer, single consumer rings in
+ * spscring.c, which pass items from an interrupt to a task without masking
+ * interrupts. */
+    #define configUSE_SPSC_RINGS    0
+#endif
+
+#ifndef configUSE_LIGHTWEIGHT_MUTEXES
+
+/* Set to 1 to include the mutexes and binary semaphores in lwmutex.c, which
+ * are taken and given without entering the kernel when uncontended. */
+    #define configUSE_LIGHTWEIGHT_MUTEXES    0
+#endif
+
+#ifndef configUSE_CEILING_MUTEXES
+
+/* Set to 1 to include xSemaphoreCreateCeilingMutex(), which creates mutexes
+ * that use the immediate priority ceiling protocol. */
+    #define configUSE_CEILING_MUTEXES    0
+#endif
+
+#ifndef configUSE_WAITSETS
+
+/* Set to 1 to include the waitsets in waitset.c, which let a task block on
+ * any mix of queues, semaphores, stream buffers, event groups and task
+ * notifications at once. */
+    #define configUSE_WAITSETS    0
+#endif
+
+#ifndef configWAITSET_NOTIFICATION_INDEX
+
+/* The task notification index through which the members of a waitset post to
+ * the task that owns it.  The index must not be used for anything else. */
+    #define configWAITSET_NOTIFICATION_INDEX    ( configTASK_NOTIFICATION_ARRAY_ENTRIES - 1 )
+#endif
+
+#ifndef configUSE_PRIORITY_QUEUES
+
+/* Set to 1 to include xQueueCreatePriority(), which creates queues that
+ * deliver the highest priority item first. */
+    #define configUSE_PRIORITY_QUEUES    0
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_ZERO_COPY
+
+/* Set to 1 to include xStreamBufferSendReserve() and the other functions that
+ * let stream and message buffers be written and read in place. */
+    #define configUSE_STREAM_BUFFER_ZERO_COPY    0
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_VECTORS
+
+/* Set to 1 to include xStreamBufferSendv() and xStreamBufferReceivev(), which
+ * send and receive data held in several separate fragments. */
+    #define configUSE_STREAM_BUFFER_VECTORS    0
+#endif
+
+#ifndef configUSE_SB_TRIGGER_TIMEOUT
+
+/* Set to 1 to include vStreamBufferSetTriggerTimeout(), which unblocks a task
+ * waiting on a stream buffer a set time after data first arrives, even if the
+ * trigger level has not been reached. */
+    #define configUSE_SB_TRIGGER_TIMEOUT    0
+#endif
+
+#ifndef configUSE_BROADCAST_RINGS
+
+/* Set to 1 to include the broadcast rings in bcastring.c, which pass each item
+ * from one producer to several readers that each read it at their own pace. */
+    #define configUSE_BROADCAST_RINGS    0
+#endif
+
 #ifndef configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS
     #define configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS    0
 #endif
@@ -921,6 +1181,25 @@
     #define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
 #endif
 
+#ifndef configUSE_PRIORITY_EVENT_LISTS
+
+/* Set to 1 to give the event lists of queues, semaphores and mutexes one list
+ * of waiting tasks per priority and a bit map of the priorities that have
+ * waiting tasks, so blocking on and unblocking from them takes the same time
+ * however many tasks are waiting. */
+    #define configUSE_PRIORITY_EVENT_LISTS    0
+#endif
+
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+    #if ( configMAX_PRIORITIES > 32 )
+        #error configMAX_PRIORITIES must be less than or equal to 32 when configUSE_PRIORITY_EVENT_LISTS is 1 as the waiting priorities of each event list are held in a single word bit map.
+    #endif
+
+    #if ( configUSE_CO_ROUTINES == 1 )
+        #error configUSE_CO_ROUTINES must be 0 when configUSE_PRIORITY_EVENT_LISTS is 1 as co-routines block on queue event lists that are ordinary lists.
+    #endif
+#endif
+
 #ifndef configAPPLICATION_ALLOCATED_HEAP
     #define configAPPLICATION_ALLOCATED_HEAP    0
 #endif
@@ -929,6 +1208,10 @@
     #define configUSE_TASK_NOTIFICATIONS    1
 #endif
 
+#if ( ( configUSE_SHARED_STACKS == 1 ) && ( configUSE_TASK_NOTIFICATIONS == 0 ) )
+    #error configUSE_TASK_NOTIFICATIONS must be 1 when configUSE_SHARED_STACKS is 1 as tasks on a shared stack that are not periodic are released by task notifications.
+#endif
+
 #ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
     #define configTASK_NOTIFICATION_ARRAY_ENTRIES    1
 #endif
@@ -961,6 +1244,34 @@
     #define configSUPPORT_DYNAMIC_ALLOCATION    1
 #endif
 
+#if ( ( configUSE_REF_QUEUES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION != 1 ) )
+    #error configSUPPORT_STATIC_ALLOCATION must be 1 when configUSE_REF_QUEUES is 1 as the queues of a reference queue are always created in its control block.
+#endif
+
+#if ( ( configUSE_SPSC_RINGS == 1 ) && ( configUSE_TASK_NOTIFICATIONS != 1 ) )
+    #error configUSE_TASK_NOTIFICATIONS must be 1 when configUSE_SPSC_RINGS is 1 as the consumer of a ring is woken with a task notification.
+#endif
+
+#if ( ( configUSE_BROADCAST_RINGS == 1 ) && ( configUSE_TASK_NOTIFICATIONS != 1 ) )
+    #error configUSE_TASK_NOTIFICATIONS must be 1 when configUSE_BROADCAST_RINGS is 1 as the readers and producer of a ring are woken with a task notification.
+#endif
+
+#if ( ( configUSE_LIGHTWEIGHT_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be 1 when configUSE_LIGHTWEIGHT_MUTEXES is 1 as a contended lightweight mutex uses the priority inheritance of the kernel mutexes.
+#endif
+
+#if ( ( configUSE_CEILING_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be 1 when configUSE_CEILING_MUTEXES is 1 as priority ceiling mutexes are a type of mutex.
+#endif
+
+#if ( ( configUSE_WAITSETS == 1 ) && ( configUSE_TASK_NOTIFICATIONS != 1 ) )
+    #error configUSE_TASK_NOTIFICATIONS must be 1 when configUSE_WAITSETS is 1 as the members of a waitset post to it with a task notification.
+#endif
+
+#if ( ( configUSE_WAITSETS == 1 ) && ( ( configWAITSET_NOTIFICATION_INDEX < 1 ) || ( configWAITSET_NOTIFICATION_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES ) ) )
+    #error configWAITSET_NOTIFICATION_INDEX must be between 1 and configTASK_NOTIFICATION_ARRAY_ENTRIES - 1, as index 0 is used by stream buffers and xTaskNotify().  Set configTASK_NOTIFICATION_ARRAY_ENTRIES to at least 2.
+#endif
+
 #if ( ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) )
     #error configUSE_STATS_FORMATTING_FUNCTIONS cannot be used without dynamic allocation, but configSUPPORT_DYNAMIC_ALLOCATION is not set to 1.
 #endif
@@ -1240,6 +1551,25 @@ typedef struct xSTATIC_LIST
     #endif
 } StaticList_t;
 
+/*
+ * In line with software engineering best practice, especially when supplying a
+ * library that is likely to change in future versions, FreeRTOS implements a
+ * strict data hiding policy.  This means the event list structure used
+ * internally by FreeRTOS is not accessible to application code.  The
+ * StaticEventList_t structure below only exists so StaticQueue_t matches the
+ * size of the genuine queue structure, whose event lists are ordinary lists
+ * unless configUSE_PRIORITY_EVENT_LISTS is 1.
+ */
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+    typedef struct xSTATIC_EVENT_LIST
+    {
+        StaticList_t xDummy1[ configMAX_PRIORITIES ];
+        UBaseType_t uxDummy2;
+    } StaticEventList_t;
+#else
+    typedef StaticList_t StaticEventList_t;
+#endif
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
@@ -1301,6 +1631,29 @@ typedef struct xSTATIC_TCB
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iDummy22;
     #endif
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+        TickType_t xDummy23[ 2 ];
+        UBaseType_t uxDummy24;
+    #endif
+    #if ( configUSE_TASK_BUDGETS == 1 )
+        StaticListItem_t xDummy25;
+        uint32_t ulDummy26[ 3 ];
+        TickType_t xDummy27[ 2 ];
+        UBaseType_t uxDummy28[ 2 ];
+        uint8_t ucDummy29[ 2 ];
+    #endif
+    #if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+        UBaseType_t uxDummy30;
+        void * pxDummy31;
+    #endif
+    #if ( configUSE_SHARED_STACKS == 1 )
+        void * pxDummy32[ 3 ];
+        TickType_t xDummy33[ 2 ];
+        uint8_t ucDummy34;
+    #endif
+    #if ( configUSE_WAITSETS == 1 )
+        uint32_t ulDummy35[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+    #endif
 } StaticTask_t;
 
 /*
@@ -1327,9 +1680,17 @@ typedef struct xSTATIC_QUEUE
         UBaseType_t uxDummy2;
     } u;
 
-    StaticList_t xDummy3[ 2 ];
+    #if ( configUSE_CEILING_MUTEXES == 1 )
+        UBaseType_t uxDummy2a;
+    #endif
+
+    StaticEventList_t xDummy3[ 2 ];
     UBaseType_t uxDummy4[ 3 ];
-    uint8_t ucDummy5[ 2 ];
+    uint8_t ucDummy5[ 3 ];
+
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+        uint8_t ucDummy5a;
+    #endif
 
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucDummy6;
@@ -1343,6 +1704,11 @@ typedef struct xSTATIC_QUEUE
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
     #endif
+
+    #if ( configUSE_WAITSETS == 1 )
+        void * pvDummy10;
+        uint32_t ulDummy11;
+    #endif
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1372,6 +1738,12 @@ typedef struct xSTATIC_EVENT_GROUP
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucDummy4;
     #endif
+
+    #if ( configUSE_WAITSETS == 1 )
+        void * pvDummy5;
+        TickType_t xDummy6;
+        uint32_t ulDummy7;
+    #endif
 } StaticEventGroup_t;
 
 /*
@@ -1426,6 +1798,18 @@ typedef struct xSTATIC_STREAM_BUFFER
     #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
         void * pvDummy5[ 2 ];
     #endif
+    #if ( configUSE_WAITSETS == 1 )
+        void * pvDummy6;
+        uint32_t ulDummy7;
+    #endif
+    #if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+        size_t uxDummy8;
+    #endif
+    #if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+        TickType_t xDummy9;
+        BaseType_t xDummy10;
+        uint32_t ulDummy11[ 2 ];
+    #endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
@@ -4,20 +4,48 @@
 /* 调度器配置 */
 #define configUSE_PREEMPTION            1   // 启用抢占式调度器(1=启用, 0=协作式)
 #define configIDLE_SHOULD_YIELD         1   // 空闲任务在有同优先级任务时主动让出CPU(1=允许, 0=不允许)
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1   // 就绪优先级查找方式(1=位图+__clz指令, 2=位图+可移植de Bruijn查表, 0=通用线性扫描)，1和2在优先级数超过32时使用两级位图，最多支持1024个优先级
+#define configUSE_EDF_SCHEDULING        0   // 最早截止期优先调度(1=启用, 0=禁用)，启用后configEDF_TASK_PRIORITY优先级上的任务按绝对截止期排序运行，不再时间片轮转
+#define configEDF_TASK_PRIORITY         2   // 截止期调度任务所在的优先级，xTaskCreateStaticWithDeadline()创建的任务使用此优先级
+#define configUSE_TASK_BUDGETS          0   // 任务执行时间预算(1=启用, 0=禁用)，启用后可用vTaskSetBudget()限制任务每个周期占用的CPU周期数(DWT周期计数器计量)，用完后降到空闲优先级或阻塞到下个周期
+#define configUSE_PREEMPTION_THRESHOLD  0   // 抢占阈值(1=启用, 0=禁用)，启用后可用vTaskPreemptionThresholdSet()设置任务运行时只能被优先级高于阈值的任务抢占
+#define configUSE_SHARED_STACKS         0   // 共享栈(1=启用, 0=禁用)，需抢占阈值，启用后可用xTaskCreateStaticSharedStack()让互不抢占的运行到完成型任务共用一块栈
+#define configUSE_CYCLIC_EXECUTIVE      0   // 时间触发循环执行器(1=启用, 0=禁用)，启用后可用xCyclicExecutiveCreateStatic()按静态调度表在每个小帧起始节拍依次调用表中函数
+#define configUSE_PERIODIC_TASKS        0   // 周期任务(1=启用, 0=禁用)，启用后可用xPeriodicTaskCreateStatic()创建按固定时刻释放的周期任务，同周期任务可自动错开相位，并统计释放抖动、响应时间和截止期错过次数
 
 /* 钩子函数配置 */
 #define configUSE_IDLE_HOOK             0   // 禁用空闲任务钩子函数(1=启用, 0=禁用)，启用需实现vApplicationIdleHook()
 #define configUSE_TICK_HOOK             0   // 禁用时钟节拍钩子函数(1=启用, 0=禁用)，启用需实现vApplicationTickHook()
+#define configUSE_CYCLIC_OVERRUN_HOOK   0   // 禁用循环执行器帧超时钩子函数(1=启用, 0=禁用)，启用需实现vApplicationCyclicOverrunHook()
 
 /* 系统时钟配置 */
 #define configCPU_CLOCK_HZ              ( ( unsigned long ) 72000000 )  // CPU核心时钟频率，此处为72MHz
 #define configTICK_RATE_HZ              ( ( TickType_t ) 1000 )        // 系统时钟节拍频率，1000Hz表示时钟节拍周期1ms
+#define configUSE_DYNAMIC_TICK          0   // 动态节拍(1=启用, 0=周期节拍)，启用后SysTick只在任务超时或同优先级任务时间片轮转时产生中断，需configUSE_TICK_HOOK为0
+#define configTICK_UNBLOCK_LIMIT        0   // 节拍中断关中断期间最多唤醒的任务数(0=不限制)，超出的到期任务在同一次节拍中断内开中断后分批唤醒，缩短高优先级中断(如ADC)的最长响应延迟
 
 /* 任务配置 */
 #define configMAX_PRIORITIES            ( 5 )   // 系统支持的最大任务优先级数，优先级范围0~4(数值越大优先级越高)
 #define configMINIMAL_STACK_SIZE        ( ( unsigned short ) 128 )    // 空闲任务的最小栈空间大小，单位：字(32位系统下1字=4字节)
 #define configMAX_TASK_NAME_LEN         ( 16 )  // 任务名最大长度，包含结束符'\0'
 
+/* 延时任务管理配置 */
+#define configUSE_DELAYED_TASK_WHEEL        0   // 阻塞任务使用分层时间轮管理(1=启用, 0=使用有序延时列表)，启用后任务进入阻塞态的插入开销为O(1)，与阻塞任务数量无关
+#define configDELAYED_TASK_WHEEL_SLOT_BITS  4   // 时间轮每层槽位数为2^4=16，32位节拍共8层128个槽，约占用2.5KB RAM
+
+/* 队列与信号量配置 */
+#define configUSE_PRIORITY_EVENT_LISTS      0   // 队列/信号量/互斥量的等待任务按优先级分列表存放(1=启用, 0=使用按优先级排序的单个等待列表)，启用后任务阻塞和唤醒的开销为O(1)，与等待任务数量无关，5个优先级时每个队列约多占用168字节RAM，不能与协程同时使用
+#define configUSE_REF_QUEUES                0   // 引用队列(1=启用, 0=禁用)，启用后可用xRefQueueCreateStatic()创建零拷贝队列，发送方从固定槽池取槽原地填写后只传递槽指针，接收方用完后归还，适合较大的传感器数据帧
+#define configUSE_SPSC_RINGS                0   // 单生产者单消费者环形缓冲区(1=启用, 0=禁用)，启用后中断可用xSpscRingPush()无锁地向任务传递数据，不屏蔽中断，可用于优先级高于configMAX_SYSCALL_INTERRUPT_PRIORITY的中断
+#define configUSE_LIGHTWEIGHT_MUTEXES       0   // 轻量级互斥量和二值信号量(1=启用, 0=禁用)，无竞争时获取/释放只需一次原子比较交换，不进入内核，需要configUSE_MUTEXES=1
+#define configUSE_CEILING_MUTEXES           0   // 优先级天花板互斥量(1=启用, 0=禁用)，启用后可用xSemaphoreCreateCeilingMutex()创建互斥量，获取时持有者立即升到天花板优先级，不做优先级继承，需要configUSE_MUTEXES=1
+#define configUSE_WAITSETS                  0   // 等待集(1=启用, 0=禁用)，启用后一个任务可同时阻塞等待多个队列、信号量、流缓冲区、事件组和任务通知，需要configTASK_NOTIFICATION_ARRAY_ENTRIES>=2
+#define configUSE_PRIORITY_QUEUES           0   // 优先级消息队列(1=启用, 0=禁用)，启用后可用xQueueCreatePriority()创建队列，用xQueueSendWithPriority()发送的消息按优先级出队，同优先级先进先出，发送和接收的开销为O(log n)
+#define configUSE_STREAM_BUFFER_ZERO_COPY   0   // 流缓冲区/消息缓冲区零拷贝接口(1=启用, 0=禁用)，启用后可用xStreamBufferSendReserve()在缓冲区内预留连续空间原地写入再提交，用xStreamBufferReceiveAcquire()原地读取再释放，唤醒方式与普通发送/接收相同
+#define configUSE_STREAM_BUFFER_VECTORS     0   // 流缓冲区/消息缓冲区分散/聚集收发(1=启用, 0=禁用)，启用后可用xMessageBufferSendv()把协议头、负载、CRC等多个不连续片段作为一条消息发送，只写一个长度前缀，无需先拼接到临时缓冲区，接收时可用xMessageBufferReceivev()把一条消息拆分到多个片段
+#define configUSE_SB_TRIGGER_TIMEOUT        0   // 流缓冲区触发超时(1=启用, 0=禁用)，启用后可用vStreamBufferSetTriggerTimeout()设置超时，等待数据的任务在缓冲区数据达到触发水平或第一个未读字节到达后经过设定的节拍数时被唤醒(以先到者为准)，由内核直接调整任务的阻塞时间，不需要额外的定时器任务
+#define configUSE_BROADCAST_RINGS           0   // 广播环形缓冲区(1=启用, 0=禁用)，启用后一个生产者(如日志任务)发送的每条数据只保存一份，可由多个读者(如串口、Flash记录、OLED显示)各自按自己的进度读取，每个读者可选择丢弃最旧数据(并计入该读者的溢出计数)或让生产者等待
+
 /* 内存配置 */
 #define configTOTAL_HEAP_SIZE           ( ( size_t ) ( 17 * 1024 ) )  // 动态内存堆总大小，17KB，用于动态创建任务/队列/信号量等
 
@@ -58,5 +86,7 @@
 #define configTIMER_TASK_PRIORITY           ( configMAX_PRIORITIES - 1 )    // 软件定时器任务优先级，设为次最高
 #define configTIMER_QUEUE_LENGTH            5   // 软件定时器命令队列长度，支持5个未处理命令
 #define configTIMER_TASK_STACK_DEPTH        ( configMINIMAL_STACK_SIZE * 2) // 软件定时器任务栈大小，2倍最小栈空间
+#define configUSE_TIMER_WHEEL               0   // 活动定时器使用分层时间轮管理(1=启用, 0=使用有序定时器列表)，启用后启动/复位/停止定时器的开销为O(1)，与活动定时器数量无关，适合大量频繁重启的协议重传/超时定时器
+#define configTIMER_WHEEL_SLOT_BITS         4   // 定时器时间轮每层槽位数为2^4=16，32位节拍共8层128个槽，约占用2.5KB RAM
 
 #endif /* FREERTOS_CONFIG_H */
@@ -32,7 +32,9 @@
  *
  * This file implements atomic functions by disabling interrupts globally.
  * Implementations with architecture specific atomic instructions can be
- * provided under each compiler directory.
+ * provided under each compiler directory.  A port that does so defines
+ * portHAS_NATIVE_ATOMICS to 1 in portmacro.h and provides the same set of
+ * functions in a portatomic.h header in its port directory.
  */
 
 #ifndef ATOMIC_H
@@ -87,9 +89,21 @@
     #define portFORCE_INLINE
 #endif
 
+#ifndef portHAS_NATIVE_ATOMICS
+    #define portHAS_NATIVE_ATOMICS    0
+#endif
+
 #define ATOMIC_COMPARE_AND_SWAP_SUCCESS    0x1U     /**< Compare and swap succeeded, swapped. */
 #define ATOMIC_COMPARE_AND_SWAP_FAILURE    0x0U     /**< Compare and swap failed, did not swap. */
 
+#if ( portHAS_NATIVE_ATOMICS == 1 )
+
+/* The port implements every function below with its own atomic
+ * instructions. */
+    #include "portatomic.h"
+
+#else /* portHAS_NATIVE_ATOMICS */
+
 /*----------------------------- Swap && CAS ------------------------------*/
 
 /**
@@ -410,6 +424,8 @@ static portFORCE_INLINE uint32_t Atomic_XOR_u32( uint32_t volatile * pulDestinat
     return ulCurrent;
 }
 
+#endif /* portHAS_NATIVE_ATOMICS */
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
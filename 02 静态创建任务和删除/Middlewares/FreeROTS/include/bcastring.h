@@ -0,0 +1,404 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef BCASTRING_H
+#define BCASTRING_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include bcastring.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+#include "task.h"
+
+/*-----------------------------------------------------------
+* MACROS AND DEFINITIONS
+*----------------------------------------------------------*/
+
+/* The number of bytes of storage that must be passed to
+ * xBroadcastRingCreateStatic() to hold uxLength items of xItemSize bytes.  The
+ * items are held once however many readers the ring has. */
+#define bcastringSTORAGE_SIZE( uxLength, xItemSize ) \
+    ( ( size_t ) ( uxLength ) * ( size_t ) ( xItemSize ) )
+
+/*
+ * What the producer does when a reader has not yet read any of the items the
+ * ring can hold.
+ */
+typedef enum
+{
+    eBroadcastDropOldest = 0, /* The oldest item the reader has not read is discarded and counted as an overrun for that reader. */
+    eBroadcastBackPressure    /* The item is not sent until the reader has read at least one item. */
+} eBroadcastPolicy;
+
+struct xBROADCAST_RING;
+
+/*
+ * The state of one reader of a broadcast ring.  The application provides the
+ * memory for it when the reader is added to a ring, but its members are
+ * private to bcastring.c and must only be accessed through the API functions
+ * below.
+ */
+typedef struct xBROADCAST_READER
+{
+    struct xBROADCAST_READER * pxNext;   /*< The next reader of the same ring. */
+    struct xBROADCAST_RING * pxRing;     /*< The ring being read. */
+    UBaseType_t uxTail;                  /*< The index of the next item this reader will read. */
+    UBaseType_t uxWaiting;               /*< The number of items this reader has not yet read. */
+    UBaseType_t uxOverruns;              /*< The number of items discarded before this reader read them. */
+    eBroadcastPolicy ePolicy;            /*< What the producer does when this reader has the ring full. */
+    TaskHandle_t xTaskWaiting;           /*< The task blocked in xBroadcastRingReceive() on this reader, otherwise NULL. */
+} BroadcastReader_t;
+
+/*
+ * The control block of a broadcast ring.  The application provides the memory
+ * for it when the ring is created statically, but its members are private to
+ * bcastring.c and must only be accessed through the API functions below.
+ */
+typedef struct xBROADCAST_RING
+{
+    BroadcastReader_t * pxReaders;       /*< The readers of the ring, or NULL if it has none. */
+    UBaseType_t uxHead;                  /*< The index of the next item to write. */
+    UBaseType_t uxLength;                /*< The number of items the storage can hold. */
+    size_t xItemSize;                    /*< The size of each item in bytes. */
+    uint8_t * pucStorage;                /*< The first item. */
+    TaskHandle_t xTaskWaitingToSend;     /*< The producer while it is blocked in xBroadcastRingSend(), otherwise NULL. */
+} BroadcastRing_t;
+
+/**
+ * Type by which broadcast rings are referenced.  For example, a call to
+ * xBroadcastRingCreate() returns a BroadcastRingHandle_t variable that can
+ * then be used as a parameter to xBroadcastRingSend(),
+ * xBroadcastRingAddReader(), etc.
+ */
+typedef BroadcastRing_t * BroadcastRingHandle_t;
+
+/**
+ * Type by which the readers of a broadcast ring are referenced.  A call to
+ * xBroadcastRingAddReader() returns a BroadcastReaderHandle_t variable that
+ * can then be used as a parameter to xBroadcastRingReceive(), etc.
+ */
+typedef BroadcastReader_t * BroadcastReaderHandle_t;
+
+/*-----------------------------------------------------------
+* API FUNCTIONS
+*----------------------------------------------------------*/
+
+/**
+ * bcastring. h
+ * @code{c}
+ * BroadcastRingHandle_t xBroadcastRingCreateStatic( UBaseType_t uxLength,
+ *                                                   size_t xItemSize,
+ *                                                   uint8_t * pucStorage,
+ *                                                   BroadcastRing_t * pxRingBuffer );
+ * @endcode
+ *
+ * Creates a ring that passes fixed size items from one producer to any number
+ * of readers, each of which receives every item - for example a logger that
+ * feeds a UART, a flash recorder and a status display.
+ *
+ * Each item is copied into the ring once, however many readers there are.
+ * Every reader has its own read position in the ring, so a reader that falls
+ * behind does not hold up the others unless it was added with the
+ * eBroadcastBackPressure policy.  Once a reader has not read any of the
+ * uxLength items the ring can hold the ring is full for that reader, and what
+ * happens to the next item depends on the policy the reader was added with:
+ *
+ * - eBroadcastDropOldest: the oldest item the reader has not read is
+ *   discarded for that reader only, and counted in its overrun counter.  The
+ *   producer never waits for the reader.
+ *
+ * - eBroadcastBackPressure: the item is not sent to any reader until the
+ *   reader has read an item.  xBroadcastRingSend() blocks for up to its block
+ *   time waiting for that, and xBroadcastRingSendFromISR() fails.
+ *
+ * Readers block in xBroadcastRingReceive() using their task's notification at
+ * index 0, as stream buffers do, and so does a producer blocked by a
+ * back-pressure reader.  As with stream buffers, the notification is sent
+ * with eNoAction and waited for without clearing any bits, so the ring never
+ * changes the notification value.
+ *
+ * Only one task or interrupt may send to a ring at a time, and only one task
+ * may receive through a reader at a time.  Items are copied with interrupts
+ * masked, as they are by queues, so the ring is intended for small items.
+ *
+ * @param uxLength The maximum number of items the ring can hold for each
+ * reader.
+ *
+ * @param xItemSize The size of each item in bytes.
+ *
+ * @param pucStorage Memory of at least bcastringSTORAGE_SIZE( uxLength,
+ * xItemSize ) bytes in which the items are held.
+ *
+ * @param pxRingBuffer Memory in which the control block of the ring is held.
+ *
+ * @return The handle of the ring, or NULL if either buffer was NULL.
+ *
+ * Example usage:
+ * @code{c}
+ * #define LOG_LINES    16
+ *
+ * typedef struct
+ * {
+ *  TickType_t xTime;
+ *  char cText[ 44 ];
+ * } LogLine_t;
+ *
+ * static uint8_t ucLogStorage[ bcastringSTORAGE_SIZE( LOG_LINES, sizeof( LogLine_t ) ) ];
+ * static BroadcastRing_t xLogRingBuffer;
+ * static BroadcastRingHandle_t xLogRing;
+ *
+ * static BroadcastReader_t xUartReaderBuffer, xFlashReaderBuffer;
+ * static BroadcastReaderHandle_t xUartReader, xFlashReader;
+ *
+ * void vUartTask( void * pvParameters )
+ * {
+ *  LogLine_t xLine;
+ *
+ *  for( ;; )
+ *  {
+ *      if( xBroadcastRingReceive( xUartReader, &xLine, portMAX_DELAY ) == pdPASS )
+ *      {
+ *          vUartWrite( xLine.cText );
+ *      }
+ *  }
+ * }
+ *
+ * void vAFunction( void )
+ * {
+ *  xLogRing = xBroadcastRingCreateStatic( LOG_LINES, sizeof( LogLine_t ), ucLogStorage, &xLogRingBuffer );
+ *
+ *  // The UART is too slow to keep up with a burst of log lines and can lose
+ *  // some, but the flash record must be complete.
+ *  xUartReader = xBroadcastRingAddReader( xLogRing, eBroadcastDropOldest, &xUartReaderBuffer );
+ *  xFlashReader = xBroadcastRingAddReader( xLogRing, eBroadcastBackPressure, &xFlashReaderBuffer );
+ * }
+ * @endcode
+ * \defgroup xBroadcastRingCreateStatic xBroadcastRingCreateStatic
+ * \ingroup BroadcastRingManagement
+ */
+BroadcastRingHandle_t xBroadcastRingCreateStatic( UBaseType_t uxLength,
+                                                  size_t xItemSize,
+                                                  uint8_t * pucStorage,
+                                                  BroadcastRing_t * pxRingBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * bcastring. h
+ * @code{c}
+ * BroadcastRingHandle_t xBroadcastRingCreate( UBaseType_t uxLength,
+ *                                             size_t xItemSize );
+ * @endcode
+ *
+ * As xBroadcastRingCreateStatic(), but the control block and storage are
+ * allocated from the FreeRTOS heap in a single allocation.
+ *
+ * @return The handle of the ring, or NULL if there was not enough heap memory
+ * available.
+ *
+ * \defgroup xBroadcastRingCreate xBroadcastRingCreate
+ * \ingroup BroadcastRingManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    BroadcastRingHandle_t xBroadcastRingCreate( UBaseType_t uxLength,
+                                                size_t xItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * bcastring. h
+ * @code{c}
+ * BroadcastReaderHandle_t xBroadcastRingAddReader( BroadcastRingHandle_t xRing,
+ *                                                  eBroadcastPolicy ePolicy,
+ *                                                  BroadcastReader_t * pxReaderBuffer );
+ * @endcode
+ *
+ * Adds a reader to a ring.  The reader receives every item sent after it was
+ * added, but none of the items already on the ring.  Readers can be added and
+ * removed while the ring is in use.
+ *
+ * @param xRing The ring to read.
+ *
+ * @param ePolicy eBroadcastDropOldest if items the reader falls too far
+ * behind to read are discarded, or eBroadcastBackPressure if the producer
+ * waits for the reader instead.  See xBroadcastRingCreateStatic().
+ *
+ * @param pxReaderBuffer Memory in which the state of the reader is held.  It
+ * must remain valid until the reader is removed.
+ *
+ * @return The handle of the reader, or NULL if pxReaderBuffer was NULL.
+ *
+ * \defgroup xBroadcastRingAddReader xBroadcastRingAddReader
+ * \ingroup BroadcastRingManagement
+ */
+BroadcastReaderHandle_t xBroadcastRingAddReader( BroadcastRingHandle_t xRing,
+                                                 eBroadcastPolicy ePolicy,
+                                                 BroadcastReader_t * pxReaderBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * bcastring. h
+ * @code{c}
+ * void vBroadcastRingRemoveReader( BroadcastReaderHandle_t xReader );
+ * @endcode
+ *
+ * Removes a reader from its ring, discarding any items it has not read.  If
+ * the producer was blocked waiting for the reader it is woken.  No task may
+ * be blocked receiving through the reader.
+ *
+ * @param xReader The reader to remove.
+ *
+ * \defgroup vBroadcastRingRemoveReader vBroadcastRingRemoveReader
+ * \ingroup BroadcastRingManagement
+ */
+void vBroadcastRingRemoveReader( BroadcastReaderHandle_t xReader ) PRIVILEGED_FUNCTION;
+
+/**
+ * bcastring. h
+ * @code{c}
+ * BaseType_t xBroadcastRingSend( BroadcastRingHandle_t xRing,
+ *                                const void * pvItem,
+ *                                TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies an item onto a ring for every reader of the ring, waking any reader
+ * blocked in xBroadcastRingReceive().  Readers that have the ring full are
+ * handled according to their policy.  Must only be called from a task.
+ *
+ * @param xRing The ring onto which the item is copied.
+ *
+ * @param pvItem A pointer to the item to copy.
+ *
+ * @param xTicksToWait The maximum amount of time to block waiting for a
+ * reader added with the eBroadcastBackPressure policy to read an item, if
+ * such a reader has the ring full.
+ *
+ * @return pdPASS if the item was copied, or pdFAIL if a back-pressure reader
+ * still had the ring full when xTicksToWait expired.
+ *
+ * \defgroup xBroadcastRingSend xBroadcastRingSend
+ * \ingroup BroadcastRingManagement
+ */
+BaseType_t xBroadcastRingSend( BroadcastRingHandle_t xRing,
+                               const void * pvItem,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * bcastring. h
+ * @code{c}
+ * BaseType_t xBroadcastRingSendFromISR( BroadcastRingHandle_t xRing,
+ *                                       const void * pvItem,
+ *                                       BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xBroadcastRingSend() that can be called from an interrupt
+ * service routine.  It never blocks.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the item woke a
+ * reader with a priority above the interrupted task, in which case a context
+ * switch should be requested before the interrupt is exited.
+ *
+ * @return pdPASS if the item was copied, or pdFAIL if a back-pressure reader
+ * had the ring full.
+ *
+ * \defgroup xBroadcastRingSendFromISR xBroadcastRingSendFromISR
+ * \ingroup BroadcastRingManagement
+ */
+BaseType_t xBroadcastRingSendFromISR( BroadcastRingHandle_t xRing,
+                                      const void * pvItem,
+                                      BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * bcastring. h
+ * @code{c}
+ * BaseType_t xBroadcastRingReceive( BroadcastReaderHandle_t xReader,
+ *                                   void * pvBuffer,
+ *                                   TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies the oldest item the reader has not yet read off the ring.  If the
+ * reader has read every item the calling task blocks until one is sent, or
+ * until xTicksToWait expires.  Must only be called from a task.
+ *
+ * @param xReader The reader through which the item is read.
+ *
+ * @param pvBuffer The buffer into which the item is copied.
+ *
+ * @param xTicksToWait The maximum amount of time to block waiting for an item
+ * if the reader has read every item.
+ *
+ * @return pdPASS if an item was copied, or pdFAIL if there was still no item
+ * when xTicksToWait expired.
+ *
+ * \defgroup xBroadcastRingReceive xBroadcastRingReceive
+ * \ingroup BroadcastRingManagement
+ */
+BaseType_t xBroadcastRingReceive( BroadcastReaderHandle_t xReader,
+                                  void * pvBuffer,
+                                  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * bcastring. h
+ * @code{c}
+ * UBaseType_t uxBroadcastRingItemsWaiting( BroadcastReaderHandle_t xReader );
+ * @endcode
+ *
+ * @return The number of items the reader has not yet read.
+ *
+ * \defgroup uxBroadcastRingItemsWaiting uxBroadcastRingItemsWaiting
+ * \ingroup BroadcastRingManagement
+ */
+UBaseType_t uxBroadcastRingItemsWaiting( BroadcastReaderHandle_t xReader ) PRIVILEGED_FUNCTION;
+
+/**
+ * bcastring. h
+ * @code{c}
+ * UBaseType_t uxBroadcastRingGetOverruns( BroadcastReaderHandle_t xReader,
+ *                                         BaseType_t xClear );
+ * @endcode
+ *
+ * Returns the number of items that were discarded before the reader read
+ * them because it had the ring full.  Only readers added with the
+ * eBroadcastDropOldest policy can overrun.
+ *
+ * @param xReader The reader to query.
+ *
+ * @param xClear pdTRUE to reset the count to zero after reading it.
+ *
+ * @return The number of items discarded since the reader was added, or since
+ * the count was last cleared.
+ *
+ * \defgroup uxBroadcastRingGetOverruns uxBroadcastRingGetOverruns
+ * \ingroup BroadcastRingManagement
+ */
+UBaseType_t uxBroadcastRingGetOverruns( BroadcastReaderHandle_t xReader,
+                                        BaseType_t xClear ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+#endif /* BCASTRING_H */
@@ -0,0 +1,259 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef CYCLIC_H
+#define CYCLIC_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include cyclic.h"
+#endif
+
+/*lint -save -e537 This headers are only multiply included if the application code
+ * happens to also be including task.h. */
+#include "task.h"
+/*lint -restore */
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/*-----------------------------------------------------------
+* MACROS AND DEFINITIONS
+*----------------------------------------------------------*/
+
+/*
+ * Defines the prototype to which functions called from a cyclic executive
+ * schedule table must conform.  The function is called once each time its
+ * slot is dispatched and must return - it must not block.
+ */
+typedef void (* CyclicFunction_t)( void * );
+
+/*
+ * One entry in a cyclic executive schedule table.  The slot's function is
+ * called at the start of minor frame uxMinorFrame of every major frame.  A
+ * function that has to run more than once per major frame is given one slot for
+ * each minor frame it runs in.
+ */
+typedef struct xCYCLIC_SLOT
+{
+    UBaseType_t uxMinorFrame;     /*< The minor frame, within the major frame, in which the function is called. */
+    CyclicFunction_t pxFunction;  /*< The function to call. */
+    void * pvParameters;          /*< The value passed into pxFunction. */
+} CyclicSlot_t;
+
+/*
+ * Execution time statistics kept for each slot of a schedule table.  Times are
+ * in counts of portGET_BUDGET_COUNTER_VALUE(), which is the core clock cycle
+ * counter on ports that provide one.
+ */
+typedef struct xCYCLIC_SLOT_STATS
+{
+    uint32_t ulRuns;              /*< The number of times the slot's function has been called. */
+    uint32_t ulSkips;             /*< The number of times the slot was not called because its minor frame had already passed when the preceding frame completed. */
+    uint32_t ulLastTime;          /*< The execution time of the most recent call. */
+    uint32_t ulMinTime;           /*< The shortest execution time measured. */
+    uint32_t ulMaxTime;           /*< The longest execution time measured. */
+} CyclicSlotStats_t;
+
+/*
+ * A complete, normally const, cyclic executive schedule.  The slots must be
+ * listed in the order in which they run, so in ascending minor frame order.
+ * Slots that share a minor frame run one after the other in the order listed.
+ */
+typedef struct xCYCLIC_SCHEDULE
+{
+    const CyclicSlot_t * pxSlots;            /*< The schedule table. */
+    UBaseType_t uxNumberOfSlots;             /*< The number of entries in pxSlots. */
+    TickType_t xMinorFramePeriod;            /*< The length of one minor frame in ticks. */
+    UBaseType_t uxMinorFramesPerMajorFrame;  /*< The number of minor frames that make up one major frame, after which the table repeats. */
+    CyclicSlotStats_t * pxSlotStats;         /*< Either NULL, or an array of uxNumberOfSlots structures in RAM in which the execution time statistics of each slot are kept. */
+} CyclicSchedule_t;
+
+/*-----------------------------------------------------------
+* API FUNCTIONS
+*----------------------------------------------------------*/
+
+/**
+ * cyclic. h
+ * @code{c}
+ * BaseType_t xCyclicExecutiveCreate( const CyclicSchedule_t * pxSchedule,
+ *                                    UBaseType_t uxPriority,
+ *                                    const configSTACK_DEPTH_TYPE usStackDepth );
+ * @endcode
+ *
+ * Creates the task that dispatches a time triggered schedule table, and returns
+ * pdPASS if it was created.  Only one cyclic executive can exist.
+ *
+ * The executive is released by the tick interrupt at the start of each minor
+ * frame that has at least one slot in the table, and calls the functions of
+ * those slots one after the other in table order before blocking again.  Minor
+ * frames without slots do not cause the executive to run at all.  Frame start
+ * times are fixed multiples of the minor frame period, measured from the tick
+ * at which the executive first runs, so they do not drift with the execution
+ * time of the slots.
+ *
+ * To be dispatched without jitter the executive must be the only task at its
+ * priority and no higher priority task may be ready at a frame start - normally
+ * it is given the highest priority in the system.  Periodic work that is moved
+ * into the table no longer needs a task of its own, so the stacks of those
+ * tasks, and the context switches made each time they wake, are saved.
+ *
+ * If the functions of a minor frame are still running when the next minor
+ * frame starts the frame has overrun.  The overrun is counted, and if
+ * configUSE_CYCLIC_OVERRUN_HOOK is set to 1 vApplicationCyclicOverrunHook() is
+ * called from the executive with the number of the minor frame that overran.
+ * The executive then carries on with the first frame that has not started yet,
+ * so every slot in a frame that was overrun is skipped for that major frame
+ * rather than run late.
+ *
+ * The execution time of each slot is measured with
+ * portGET_BUDGET_COUNTER_VALUE() and, if pxSchedule->pxSlotStats is not NULL,
+ * recorded there.  The measurement includes any time during which the
+ * executive was preempted.
+ *
+ * @param pxSchedule The schedule to dispatch.  The structure, and the table it
+ * references, are used in place so must remain valid for as long as the
+ * executive exists.
+ *
+ * @param uxPriority The priority of the executive task.
+ *
+ * @param usStackDepth The size of the executive's stack in words.  The
+ * functions in the table run on this stack.
+ *
+ * @return pdPASS if the executive was created, pdFAIL if an executive already
+ * exists, or errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY.
+ *
+ * Example usage:
+ * @code{c}
+ * // Two control loops and a logger sharing a 10ms minor frame and 40ms major
+ * // frame.  The fast loop runs every 10ms, the slow loop every 20ms and the
+ * // logger every 40ms.
+ * static const CyclicSlot_t xSlots[] =
+ * {
+ *  { 0, vFastLoop, NULL }, { 0, vSlowLoop, NULL }, { 0, vLogger, NULL },
+ *  { 1, vFastLoop, NULL },
+ *  { 2, vFastLoop, NULL }, { 2, vSlowLoop, NULL },
+ *  { 3, vFastLoop, NULL }
+ * };
+ * static CyclicSlotStats_t xStats[ sizeof( xSlots ) / sizeof( xSlots[ 0 ] ) ];
+ * static const CyclicSchedule_t xSchedule =
+ * {
+ *  xSlots, sizeof( xSlots ) / sizeof( xSlots[ 0 ] ), pdMS_TO_TICKS( 10 ), 4, xStats
+ * };
+ *
+ * void vAFunction( void )
+ * {
+ *  xCyclicExecutiveCreate( &xSchedule, configMAX_PRIORITIES - 1, configMINIMAL_STACK_SIZE );
+ *  vTaskStartScheduler();
+ * }
+ * @endcode
+ * \defgroup xCyclicExecutiveCreate xCyclicExecutiveCreate
+ * \ingroup CyclicExecutive
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    BaseType_t xCyclicExecutiveCreate( const CyclicSchedule_t * pxSchedule,
+                                       UBaseType_t uxPriority,
+                                       const configSTACK_DEPTH_TYPE usStackDepth ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * cyclic. h
+ * @code{c}
+ * TaskHandle_t xCyclicExecutiveCreateStatic( const CyclicSchedule_t * pxSchedule,
+ *                                            UBaseType_t uxPriority,
+ *                                            const uint32_t ulStackDepth,
+ *                                            StackType_t * const puxStackBuffer,
+ *                                            StaticTask_t * const pxTaskBuffer );
+ * @endcode
+ *
+ * As xCyclicExecutiveCreate(), but the memory used by the executive task is
+ * provided by the application, as for xTaskCreateStatic().
+ *
+ * @return The handle of the executive task, or NULL if either buffer was NULL
+ * or an executive already exists.
+ *
+ * \defgroup xCyclicExecutiveCreateStatic xCyclicExecutiveCreateStatic
+ * \ingroup CyclicExecutive
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    TaskHandle_t xCyclicExecutiveCreateStatic( const CyclicSchedule_t * pxSchedule,
+                                               UBaseType_t uxPriority,
+                                               const uint32_t ulStackDepth,
+                                               StackType_t * const puxStackBuffer,
+                                               StaticTask_t * const pxTaskBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * cyclic. h
+ * @code{c}
+ * uint32_t ulCyclicExecutiveGetFrameOverruns( void );
+ * @endcode
+ *
+ * @return The number of minor frames that have overrun since the executive was
+ * created.
+ *
+ * \defgroup ulCyclicExecutiveGetFrameOverruns ulCyclicExecutiveGetFrameOverruns
+ * \ingroup CyclicExecutive
+ */
+uint32_t ulCyclicExecutiveGetFrameOverruns( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * cyclic. h
+ * @code{c}
+ * BaseType_t xCyclicExecutiveGetSlotStats( UBaseType_t uxSlot, CyclicSlotStats_t * pxSlotStats );
+ * @endcode
+ *
+ * Takes a consistent copy of the execution time statistics of one slot while
+ * the executive may be updating them.
+ *
+ * @param uxSlot The index of the slot in the schedule table.
+ *
+ * @param pxSlotStats The structure into which the statistics are copied.
+ *
+ * @return pdPASS if the statistics were copied, or pdFAIL if there is no
+ * executive, the schedule does not keep statistics, or uxSlot is out of range.
+ *
+ * \defgroup xCyclicExecutiveGetSlotStats xCyclicExecutiveGetSlotStats
+ * \ingroup CyclicExecutive
+ */
+BaseType_t xCyclicExecutiveGetSlotStats( UBaseType_t uxSlot,
+                                         CyclicSlotStats_t * pxSlotStats ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called from the executive when a minor frame overruns, if
+ * configUSE_CYCLIC_OVERRUN_HOOK is set to 1.  uxMinorFrame is the frame that
+ * was still running when the following frame should have started.
+ */
+#if ( configUSE_CYCLIC_OVERRUN_HOOK == 1 )
+    void vApplicationCyclicOverrunHook( UBaseType_t uxMinorFrame );
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+#endif /* CYCLIC_H */
@@ -767,6 +767,19 @@ void vEventGroupSetBitsCallback( void * pvEventGroup,
 void vEventGroupClearBitsCallback( void * pvEventGroup,
                                    const uint32_t ulBitsToClear ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Called by waitset.c to add xEventGroup to the
+ * waitset owned by xOwner if ulBits is not 0, in which case ulBits is posted
+ * to the owner each time any of uxBitsToWaitFor are set, or to remove
+ * xEventGroup from the waitset if ulBits is 0.
+ */
+#if ( configUSE_WAITSETS == 1 )
+    BaseType_t xEventGroupSetWaitSetMember( EventGroupHandle_t xEventGroup,
+                                            const EventBits_t uxBitsToWaitFor,
+                                            TaskHandle_t xOwner,
+                                            uint32_t ulBits ) PRIVILEGED_FUNCTION;
+#endif
+
 
 #if ( configUSE_TRACE_FACILITY == 1 )
     UBaseType_t uxEventGroupGetNumber( void * xEventGroup ) PRIVILEGED_FUNCTION;
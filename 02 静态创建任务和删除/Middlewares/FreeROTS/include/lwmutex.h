@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef LWMUTEX_H
+#define LWMUTEX_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include lwmutex.h"
+#endif
+
+/*lint -save -e537 This headers are only multiply included if the application code
+ * happens to also be including task.h. */
+#include "task.h"
+/*lint -restore */
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/*-----------------------------------------------------------
+* MACROS AND DEFINITIONS
+*----------------------------------------------------------*/
+
+/*
+ * A lightweight mutex.  The application provides the memory for it, but its
+ * members are private to lwmutex.c and must only be accessed through the API
+ * functions below.
+ */
+typedef struct xLIGHTWEIGHT_MUTEX
+{
+    void * volatile pvHolder;   /*< The handle of the task holding the mutex, or NULL if it is free, with the lowest bit set while tasks are waiting for it. */
+    EventList_t xTasksWaiting;  /*< The tasks blocked waiting to take the mutex, in priority order. */
+} LightweightMutex_t;
+
+/*
+ * A lightweight binary semaphore.  The application provides the memory for
+ * it, but its members are private to lwmutex.c and must only be accessed
+ * through the API functions below.
+ */
+typedef struct xLIGHTWEIGHT_SEMAPHORE
+{
+    volatile uint32_t ulState;  /*< Whether the semaphore is available, and whether tasks are waiting for it. */
+    EventList_t xTasksWaiting;  /*< The tasks blocked waiting to take the semaphore, in priority order. */
+} LightweightSemaphore_t;
+
+/*-----------------------------------------------------------
+* API FUNCTIONS
+*----------------------------------------------------------*/
+
+/**
+ * lwmutex. h
+ * @code{c}
+ * void vLightweightMutexInitialise( LightweightMutex_t * pxMutex );
+ * @endcode
+ *
+ * Initialises a lightweight mutex, which starts free.
+ *
+ * A mutex created with xSemaphoreCreateMutex() is a queue, so every take and
+ * give runs the queue code in a critical section even when no other task
+ * wants the mutex.  A lightweight mutex holds the handle of the task that
+ * holds it in a single word instead.  When the mutex is free
+ * xLightweightMutexTake() takes it with one atomic compare-and-swap of that
+ * word, and when no other task is waiting xLightweightMutexGive() releases it
+ * with another - neither enters a critical section, which on ports that
+ * implement atomic.h with exclusive load and store instructions means no
+ * interrupts are masked.  Only when the mutex is contended do the functions
+ * fall back to the kernel to block the caller, wake a waiting task, and apply
+ * priority inheritance exactly as for a mutex created with
+ * xSemaphoreCreateMutex().
+ *
+ * Lightweight mutexes cannot be taken recursively, cannot be added to a queue
+ * set, and must not be used from an interrupt.
+ *
+ * @param pxMutex The mutex to initialise.
+ *
+ * Example usage:
+ * @code{c}
+ * static LightweightMutex_t xBusMutex;
+ *
+ * void vBusWrite( const uint8_t * pucData, size_t xLength )
+ * {
+ *  xLightweightMutexTake( &xBusMutex, portMAX_DELAY );
+ *  vBusTransfer( pucData, xLength );
+ *  xLightweightMutexGive( &xBusMutex );
+ * }
+ *
+ * void vAFunction( void )
+ * {
+ *  vLightweightMutexInitialise( &xBusMutex );
+ * }
+ * @endcode
+ * \defgroup vLightweightMutexInitialise vLightweightMutexInitialise
+ * \ingroup LightweightMutexes
+ */
+void vLightweightMutexInitialise( LightweightMutex_t * pxMutex ) PRIVILEGED_FUNCTION;
+
+/**
+ * lwmutex. h
+ * @code{c}
+ * BaseType_t xLightweightMutexTake( LightweightMutex_t * pxMutex,
+ *                                   TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Takes a lightweight mutex.  If another task holds the mutex the calling task
+ * blocks until it is given, and the holder inherits the priority of the
+ * calling task if that is higher than its own.
+ *
+ * @param pxMutex The mutex to take.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for the mutex to be given.
+ *
+ * @return pdPASS if the mutex was taken, or pdFAIL if xTicksToWait expired
+ * first.
+ *
+ * \defgroup xLightweightMutexTake xLightweightMutexTake
+ * \ingroup LightweightMutexes
+ */
+BaseType_t xLightweightMutexTake( LightweightMutex_t * pxMutex,
+                                  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * lwmutex. h
+ * @code{c}
+ * BaseType_t xLightweightMutexGive( LightweightMutex_t * pxMutex );
+ * @endcode
+ *
+ * Gives a lightweight mutex taken by the calling task.  If other tasks are
+ * waiting for the mutex the highest priority one is unblocked, and any
+ * priority the calling task inherited is returned.
+ *
+ * @param pxMutex The mutex to give.
+ *
+ * @return pdPASS if the mutex was given, or pdFAIL if the calling task did not
+ * hold it.
+ *
+ * \defgroup xLightweightMutexGive xLightweightMutexGive
+ * \ingroup LightweightMutexes
+ */
+BaseType_t xLightweightMutexGive( LightweightMutex_t * pxMutex ) PRIVILEGED_FUNCTION;
+
+/**
+ * lwmutex. h
+ * @code{c}
+ * void vLightweightSemaphoreInitialise( LightweightSemaphore_t * pxSemaphore );
+ * @endcode
+ *
+ * Initialises a lightweight binary semaphore, which starts empty as one
+ * created with xSemaphoreCreateBinary() does.  As with a lightweight mutex,
+ * taking a semaphore that is available, or giving one no task is waiting for,
+ * is a single atomic compare-and-swap.
+ *
+ * @param pxSemaphore The semaphore to initialise.
+ *
+ * \defgroup vLightweightSemaphoreInitialise vLightweightSemaphoreInitialise
+ * \ingroup LightweightMutexes
+ */
+void vLightweightSemaphoreInitialise( LightweightSemaphore_t * pxSemaphore ) PRIVILEGED_FUNCTION;
+
+/**
+ * lwmutex. h
+ * @code{c}
+ * BaseType_t xLightweightSemaphoreTake( LightweightSemaphore_t * pxSemaphore,
+ *                                       TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Takes a lightweight binary semaphore, blocking until it is given if it is
+ * not available.
+ *
+ * @param pxSemaphore The semaphore to take.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for the semaphore to be given.
+ *
+ * @return pdPASS if the semaphore was taken, or pdFAIL if xTicksToWait expired
+ * first.
+ *
+ * \defgroup xLightweightSemaphoreTake xLightweightSemaphoreTake
+ * \ingroup LightweightMutexes
+ */
+BaseType_t xLightweightSemaphoreTake( LightweightSemaphore_t * pxSemaphore,
+                                      TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * lwmutex. h
+ * @code{c}
+ * BaseType_t xLightweightSemaphoreGive( LightweightSemaphore_t * pxSemaphore );
+ * @endcode
+ *
+ * Gives a lightweight binary semaphore, unblocking the highest priority task
+ * waiting for it, if any.
+ *
+ * @param pxSemaphore The semaphore to give.
+ *
+ * @return pdPASS if the semaphore was given, or pdFAIL if it was already
+ * available.
+ *
+ * \defgroup xLightweightSemaphoreGive xLightweightSemaphoreGive
+ * \ingroup LightweightMutexes
+ */
+BaseType_t xLightweightSemaphoreGive( LightweightSemaphore_t * pxSemaphore ) PRIVILEGED_FUNCTION;
+
+/**
+ * lwmutex. h
+ * @code{c}
+ * BaseType_t xLightweightSemaphoreGiveFromISR( LightweightSemaphore_t * pxSemaphore,
+ *                                              BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xLightweightSemaphoreGive() that can be called from an
+ * interrupt service routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if giving the semaphore
+ * unblocked a task of higher priority than the interrupted task, in which case
+ * a context switch should be requested before the interrupt is exited, as for
+ * xSemaphoreGiveFromISR().
+ *
+ * \defgroup xLightweightSemaphoreGiveFromISR xLightweightSemaphoreGiveFromISR
+ * \ingroup LightweightMutexes
+ */
+BaseType_t xLightweightSemaphoreGiveFromISR( LightweightSemaphore_t * pxSemaphore,
+                                             BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* LWMUTEX_H */
@@ -847,6 +847,144 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
 #define xMessageBufferReceiveCompletedFromISR( xMessageBuffer, pxHigherPriorityTaskWoken ) \
     xStreamBufferReceiveCompletedFromISR( ( xMessageBuffer ), ( pxHigherPriorityTaskWoken ) )
 
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferSendReserve( MessageBufferHandle_t xMessageBuffer,
+ *                                   void ** ppvTxData,
+ *                                   size_t xDataLengthBytes,
+ *                                   TickType_t xTicksToWait );
+ * size_t xMessageBufferSendReserveFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                          void ** ppvTxData,
+ *                                          size_t xDataLengthBytes );
+ * size_t xMessageBufferSendCommit( MessageBufferHandle_t xMessageBuffer,
+ *                                  size_t xDataLengthBytes );
+ * size_t xMessageBufferSendCommitFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                         size_t xDataLengthBytes,
+ *                                         BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Reserve space for one message, write it in place, then commit it.  The
+ * message is not visible to the reader until it is committed, and the
+ * committed length becomes the length of the message.  See
+ * xStreamBufferSendReserve() and xStreamBufferSendCommit() for details.
+ *
+ * \defgroup xMessageBufferSendReserve xMessageBufferSendReserve
+ * \ingroup MessageBufferManagement
+ */
+    #define xMessageBufferSendReserve( xMessageBuffer, ppvTxData, xDataLengthBytes, xTicksToWait ) \
+    xStreamBufferSendReserve( ( xMessageBuffer ), ( ppvTxData ), ( xDataLengthBytes ), ( xTicksToWait ) )
+
+    #define xMessageBufferSendReserveFromISR( xMessageBuffer, ppvTxData, xDataLengthBytes ) \
+    xStreamBufferSendReserveFromISR( ( xMessageBuffer ), ( ppvTxData ), ( xDataLengthBytes ) )
+
+    #define xMessageBufferSendCommit( xMessageBuffer, xDataLengthBytes ) \
+    xStreamBufferSendCommit( ( xMessageBuffer ), ( xDataLengthBytes ) )
+
+    #define xMessageBufferSendCommitFromISR( xMessageBuffer, xDataLengthBytes, pxHigherPriorityTaskWoken ) \
+    xStreamBufferSendCommitFromISR( ( xMessageBuffer ), ( xDataLengthBytes ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferReceiveAcquire( MessageBufferHandle_t xMessageBuffer,
+ *                                      void ** ppvRxData,
+ *                                      TickType_t xTicksToWait );
+ * size_t xMessageBufferReceiveAcquireFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                             void ** ppvRxData );
+ * size_t xMessageBufferReceiveRelease( MessageBufferHandle_t xMessageBuffer,
+ *                                      size_t xDataLengthBytes );
+ * size_t xMessageBufferReceiveReleaseFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                             size_t xDataLengthBytes,
+ *                                             BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Read the next message in place, then release it.  The acquire returns the
+ * length of the message and sets *ppvRxData to point to it, or to NULL if the
+ * message was sent with xMessageBufferSend() and wraps around the end of the
+ * buffer, in which case it must be read with xMessageBufferReceive().  See
+ * xStreamBufferReceiveAcquire() and xStreamBufferReceiveRelease() for details.
+ *
+ * \defgroup xMessageBufferReceiveAcquire xMessageBufferReceiveAcquire
+ * \ingroup MessageBufferManagement
+ */
+    #define xMessageBufferReceiveAcquire( xMessageBuffer, ppvRxData, xTicksToWait ) \
+    xStreamBufferReceiveAcquire( ( xMessageBuffer ), ( ppvRxData ), ( xTicksToWait ) )
+
+    #define xMessageBufferReceiveAcquireFromISR( xMessageBuffer, ppvRxData ) \
+    xStreamBufferReceiveAcquireFromISR( ( xMessageBuffer ), ( ppvRxData ) )
+
+    #define xMessageBufferReceiveRelease( xMessageBuffer, xDataLengthBytes ) \
+    xStreamBufferReceiveRelease( ( xMessageBuffer ), ( xDataLengthBytes ) )
+
+    #define xMessageBufferReceiveReleaseFromISR( xMessageBuffer, xDataLengthBytes, pxHigherPriorityTaskWoken ) \
+    xStreamBufferReceiveReleaseFromISR( ( xMessageBuffer ), ( xDataLengthBytes ), ( pxHigherPriorityTaskWoken ) )
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
+#if ( configUSE_STREAM_BUFFER_VECTORS == 1 )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferSendv( MessageBufferHandle_t xMessageBuffer,
+ *                             const StreamBufferVector_t * pxVectors,
+ *                             UBaseType_t uxVectorCount,
+ *                             TickType_t xTicksToWait );
+ * size_t xMessageBufferSendvFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                    const StreamBufferVector_t * pxVectors,
+ *                                    UBaseType_t uxVectorCount,
+ *                                    BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Sends one message made up of several separate fragments, such as a
+ * protocol header, payload and CRC, with a single length and without first
+ * copying the fragments into a temporary buffer.  The message is written in
+ * full or not at all.  See xStreamBufferSendv() for details.
+ *
+ * \defgroup xMessageBufferSendv xMessageBufferSendv
+ * \ingroup MessageBufferManagement
+ */
+    #define xMessageBufferSendv( xMessageBuffer, pxVectors, uxVectorCount, xTicksToWait ) \
+    xStreamBufferSendv( ( xMessageBuffer ), ( pxVectors ), ( uxVectorCount ), ( xTicksToWait ) )
+
+    #define xMessageBufferSendvFromISR( xMessageBuffer, pxVectors, uxVectorCount, pxHigherPriorityTaskWoken ) \
+    xStreamBufferSendvFromISR( ( xMessageBuffer ), ( pxVectors ), ( uxVectorCount ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferReceivev( MessageBufferHandle_t xMessageBuffer,
+ *                                const StreamBufferVector_t * pxVectors,
+ *                                UBaseType_t uxVectorCount,
+ *                                TickType_t xTicksToWait );
+ * size_t xMessageBufferReceivevFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                       const StreamBufferVector_t * pxVectors,
+ *                                       UBaseType_t uxVectorCount,
+ *                                       BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Receives the next message split across several separate fragments, filling
+ * each in turn.  The message is received only if it fits in the total length
+ * of the fragments.  See xStreamBufferReceivev() for details.
+ *
+ * \defgroup xMessageBufferReceivev xMessageBufferReceivev
+ * \ingroup MessageBufferManagement
+ */
+    #define xMessageBufferReceivev( xMessageBuffer, pxVectors, uxVectorCount, xTicksToWait ) \
+    xStreamBufferReceivev( ( xMessageBuffer ), ( pxVectors ), ( uxVectorCount ), ( xTicksToWait ) )
+
+    #define xMessageBufferReceivevFromISR( xMessageBuffer, pxVectors, uxVectorCount, pxHigherPriorityTaskWoken ) \
+    xStreamBufferReceivevFromISR( ( xMessageBuffer ), ( pxVectors ), ( uxVectorCount ), ( pxHigherPriorityTaskWoken ) )
+
+#endif /* configUSE_STREAM_BUFFER_VECTORS */
+
 /* *INDENT-OFF* */
 #if defined( __cplusplus )
     } /* extern "C" */
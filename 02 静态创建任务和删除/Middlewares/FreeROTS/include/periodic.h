@@ -0,0 +1,256 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef PERIODIC_H
+#define PERIODIC_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include periodic.h"
+#endif
+
+/*lint -save -e537 This headers are only multiply included if the application code
+ * happens to also be including task.h. */
+#include "task.h"
+/*lint -restore */
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/*-----------------------------------------------------------
+* MACROS AND DEFINITIONS
+*----------------------------------------------------------*/
+
+/* Pass as the xPhase parameter of xPeriodicTaskCreate() or
+ * xPeriodicTaskCreateStatic() to have the phase chosen automatically. */
+#define periodicAUTO_PHASE    ( ( TickType_t ) portMAX_DELAY )
+
+/*
+ * Timing statistics kept for each periodic task.  All times are in ticks and
+ * are measured from the nominal release time of the job, which is an exact
+ * multiple of the period after the task's phase.
+ */
+typedef struct xPERIODIC_TASK_STATS
+{
+    uint32_t ulReleases;             /*< The number of jobs that have completed. */
+    uint32_t ulDeadlineMisses;       /*< The number of jobs that completed on or after their deadline. */
+    TickType_t xLastReleaseJitter;   /*< The delay between the release of the most recent job and it starting to run. */
+    TickType_t xMaxReleaseJitter;    /*< The longest release jitter measured. */
+    TickType_t xLastResponseTime;    /*< The time from the release of the most recent job to its completion. */
+    TickType_t xMaxResponseTime;     /*< The longest response time measured. */
+} PeriodicTaskStats_t;
+
+/*
+ * The control block of a periodic task.  The application provides the memory
+ * for it, which must remain valid for as long as the task exists, but its
+ * members are private to periodic.c and must only be read through the API
+ * functions below.
+ */
+typedef struct xPERIODIC_TASK
+{
+    struct xPERIODIC_TASK * pxNext;             /*< The next periodic task created, used to choose automatic phases. */
+    TaskFunction_t pxJobCode;                   /*< The function called once per period. */
+    void * pvParameters;                        /*< The value passed into pxJobCode. */
+    TickType_t xPeriod;                         /*< The time between releases. */
+    TickType_t xPhase;                          /*< The offset of the releases from the tick count at which the scheduler started. */
+    TickType_t xDeadline;                       /*< The time after each release by which the job must complete. */
+    uint8_t ucFlags;                            /*< periodicFLAG_ bits, see periodic.c. */
+    volatile UBaseType_t uxStatsSequence;       /*< Incremented each time xStats[] is updated - selects which of the two copies is current. */
+    volatile PeriodicTaskStats_t xStats[ 2 ];   /*< Two copies of the statistics, so they can be read without locking while the task writes the other copy. */
+} PeriodicTask_t;
+
+/*-----------------------------------------------------------
+* API FUNCTIONS
+*----------------------------------------------------------*/
+
+/**
+ * periodic. h
+ * @code{c}
+ * TaskHandle_t xPeriodicTaskCreateStatic( TaskFunction_t pxJobCode,
+ *                                         const char * const pcName,
+ *                                         const uint32_t ulStackDepth,
+ *                                         void * const pvParameters,
+ *                                         UBaseType_t uxPriority,
+ *                                         TickType_t xPeriod,
+ *                                         TickType_t xPhase,
+ *                                         TickType_t xDeadline,
+ *                                         StackType_t * const puxStackBuffer,
+ *                                         StaticTask_t * const pxTaskBuffer,
+ *                                         PeriodicTask_t * const pxPeriodicTaskBuffer );
+ * @endcode
+ *
+ * Creates a task that calls pxJobCode once per period, and returns its handle.
+ * The parameters that are common to xTaskCreateStatic() have the same meaning.
+ *
+ * Releases occur at fixed times, ( xTaskGetTickCount() at scheduler start ) +
+ * xPhase + ( n * xPeriod ), and the task waits for them with xTaskDelayUntil(),
+ * so unlike a loop around vTaskDelay() the period does not stretch by the
+ * execution time of each job and tasks that share a period keep the same
+ * relative phase.  If a job is still running when its next release occurs the
+ * next job starts as soon as it returns, as with xTaskDelayUntil().
+ *
+ * Tasks with the same period and the same phase are all released on the same
+ * tick, so the one with the lowest priority waits for all the others before it
+ * runs.  Giving tasks of the same period periodicAUTO_PHASE as their phase
+ * spreads their releases evenly across the period instead: each time such a
+ * task is created the phases of all the auto phased tasks with its period that
+ * have not yet started running are recalculated, so tasks that are all created
+ * before the scheduler is started are released xPeriod / N ticks apart.
+ *
+ * For each job the task records the release jitter (the time from the release
+ * to the job starting), the response time (the time from the release to the
+ * job returning), and whether the job missed its deadline.  These statistics
+ * can be read by any task at any time with vPeriodicTaskGetStats().
+ *
+ * @param pxJobCode The function called at each release.  It must return once
+ * the work of the job is done, and should not delay itself.
+ *
+ * @param xPeriod The time between releases in ticks.  Must be greater than 0.
+ *
+ * @param xPhase The offset of the first release, in ticks, which must be less
+ * than xPeriod, or periodicAUTO_PHASE.
+ *
+ * @param xDeadline The time after each release by which the job must have
+ * returned, in ticks, or 0 to use xPeriod.
+ *
+ * @param pxPeriodicTaskBuffer Memory in which the task's periodic control block
+ * and statistics are held.
+ *
+ * @return The handle of the created task, or NULL if any buffer was NULL.
+ *
+ * Example usage:
+ * @code{c}
+ * static StackType_t xStack[ 2 ][ 200 ];
+ * static StaticTask_t xTaskBuffer[ 2 ];
+ * static PeriodicTask_t xPeriodicBuffer[ 2 ];
+ *
+ * void vAFunction( void )
+ * {
+ *  // Both loops run every 10ms, 5ms apart.
+ *  xPeriodicTaskCreateStatic( vControlLoop1, "Loop1", 200, NULL, 2, pdMS_TO_TICKS( 10 ), periodicAUTO_PHASE, 0,
+ *                             xStack[ 0 ], &xTaskBuffer[ 0 ], &xPeriodicBuffer[ 0 ] );
+ *  xPeriodicTaskCreateStatic( vControlLoop2, "Loop2", 200, NULL, 2, pdMS_TO_TICKS( 10 ), periodicAUTO_PHASE, 0,
+ *                             xStack[ 1 ], &xTaskBuffer[ 1 ], &xPeriodicBuffer[ 1 ] );
+ *  vTaskStartScheduler();
+ * }
+ * @endcode
+ * \defgroup xPeriodicTaskCreateStatic xPeriodicTaskCreateStatic
+ * \ingroup PeriodicTasks
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    TaskHandle_t xPeriodicTaskCreateStatic( TaskFunction_t pxJobCode,
+                                            const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                            const uint32_t ulStackDepth,
+                                            void * const pvParameters,
+                                            UBaseType_t uxPriority,
+                                            TickType_t xPeriod,
+                                            TickType_t xPhase,
+                                            TickType_t xDeadline,
+                                            StackType_t * const puxStackBuffer,
+                                            StaticTask_t * const pxTaskBuffer,
+                                            PeriodicTask_t * const pxPeriodicTaskBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * periodic. h
+ * @code{c}
+ * BaseType_t xPeriodicTaskCreate( TaskFunction_t pxJobCode,
+ *                                 const char * const pcName,
+ *                                 const configSTACK_DEPTH_TYPE usStackDepth,
+ *                                 void * const pvParameters,
+ *                                 UBaseType_t uxPriority,
+ *                                 TickType_t xPeriod,
+ *                                 TickType_t xPhase,
+ *                                 TickType_t xDeadline,
+ *                                 PeriodicTask_t * const pxPeriodicTaskBuffer,
+ *                                 TaskHandle_t * const pxCreatedTask );
+ * @endcode
+ *
+ * As xPeriodicTaskCreateStatic(), but the task's stack and TCB are allocated
+ * from the FreeRTOS heap, as for xTaskCreate().  The periodic control block is
+ * still provided by the application so its statistics remain readable after
+ * the task has been deleted.
+ *
+ * @return pdPASS if the task was created, otherwise
+ * errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY.
+ *
+ * \defgroup xPeriodicTaskCreate xPeriodicTaskCreate
+ * \ingroup PeriodicTasks
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    BaseType_t xPeriodicTaskCreate( TaskFunction_t pxJobCode,
+                                    const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                    const configSTACK_DEPTH_TYPE usStackDepth,
+                                    void * const pvParameters,
+                                    UBaseType_t uxPriority,
+                                    TickType_t xPeriod,
+                                    TickType_t xPhase,
+                                    TickType_t xDeadline,
+                                    PeriodicTask_t * const pxPeriodicTaskBuffer,
+                                    TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * periodic. h
+ * @code{c}
+ * void vPeriodicTaskGetStats( const PeriodicTask_t * pxPeriodicTask, PeriodicTaskStats_t * pxStats );
+ * @endcode
+ *
+ * Copies the statistics of a periodic task.  The copy is consistent - all its
+ * members were written by the same job - but no lock is taken, so it can be
+ * called from any task, at any priority, while the periodic task is running.
+ *
+ * @param pxPeriodicTask The control block passed in when the task was created.
+ *
+ * @param pxStats The structure into which the statistics are copied.
+ *
+ * \defgroup vPeriodicTaskGetStats vPeriodicTaskGetStats
+ * \ingroup PeriodicTasks
+ */
+void vPeriodicTaskGetStats( const PeriodicTask_t * pxPeriodicTask,
+                            PeriodicTaskStats_t * pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * periodic. h
+ * @code{c}
+ * TickType_t xPeriodicTaskGetPhase( const PeriodicTask_t * pxPeriodicTask );
+ * @endcode
+ *
+ * @return The phase of the task's releases, which for a task created with
+ * periodicAUTO_PHASE is the phase that was chosen for it.  The phase of an
+ * auto phased task can change until the task first runs.
+ *
+ * \defgroup xPeriodicTaskGetPhase xPeriodicTaskGetPhase
+ * \ingroup PeriodicTasks
+ */
+TickType_t xPeriodicTaskGetPhase( const PeriodicTask_t * pxPeriodicTask ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+#endif /* PERIODIC_H */
@@ -0,0 +1,391 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef REFQUEUE_H
+#define REFQUEUE_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include refqueue.h"
+#endif
+
+/*lint -save -e537 This headers are only multiply included if the application code
+ * happens to also be including queue.h. */
+#include "queue.h"
+/*lint -restore */
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/*-----------------------------------------------------------
+* MACROS AND DEFINITIONS
+*----------------------------------------------------------*/
+
+/* The distance between the starts of adjacent slots.  Each slot is rounded up
+ * to portBYTE_ALIGNMENT so every slot is aligned as the first one is. */
+#define refqueueSLOT_STRIDE( xSlotSize )                                             \
+    ( ( ( size_t ) ( xSlotSize ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* The number of bytes of storage that must be passed to
+ * xRefQueueCreateStatic() to hold uxSlotCount slots of xSlotSize bytes, along
+ * with the free and queued references to them and the state of each slot. */
+#define refqueueSTORAGE_SIZE( uxSlotCount, xSlotSize ) \
+    ( ( size_t ) ( uxSlotCount ) * ( refqueueSLOT_STRIDE( xSlotSize ) + ( 2U * sizeof( void * ) ) + 1U ) )
+
+/*
+ * The control block of a reference queue.  The application provides the memory
+ * for it when the queue is created statically, but its members are private to
+ * refqueue.c and must only be accessed through the API functions below.
+ */
+typedef struct xREF_QUEUE
+{
+    QueueHandle_t xFreeSlots;          /*< Holds a reference to each slot that is not in use. */
+    QueueHandle_t xQueuedSlots;        /*< Holds a reference to each slot that has been sent but not yet received, in the order they were sent. */
+    uint8_t * pucSlots;                /*< The first slot. */
+    size_t xSlotStride;                /*< The distance between the starts of adjacent slots. */
+    UBaseType_t uxSlotCount;           /*< The number of slots. */
+    uint8_t * pucSlotStates;           /*< The refqueueSLOT_ state of each slot, see refqueue.c. */
+    StaticQueue_t xFreeSlotsBuffer;    /*< The memory used by xFreeSlots. */
+    StaticQueue_t xQueuedSlotsBuffer;  /*< The memory used by xQueuedSlots. */
+} RefQueue_t;
+
+/**
+ * Type by which reference queues are referenced.  For example, a call to
+ * xRefQueueCreate() returns a RefQueueHandle_t variable that can then be used
+ * as a parameter to pvRefQueueAcquire(), vRefQueueSend(), etc.
+ */
+typedef RefQueue_t * RefQueueHandle_t;
+
+/*-----------------------------------------------------------
+* API FUNCTIONS
+*----------------------------------------------------------*/
+
+/**
+ * refqueue. h
+ * @code{c}
+ * RefQueueHandle_t xRefQueueCreateStatic( UBaseType_t uxSlotCount,
+ *                                         size_t xSlotSize,
+ *                                         uint8_t * pucStorage,
+ *                                         RefQueue_t * pxRefQueueBuffer );
+ * @endcode
+ *
+ * Creates a reference queue, which passes items between tasks without copying
+ * them.  A queue created with xQueueCreate() copies each item into the queue
+ * when it is sent and out again when it is received, so the time spent in the
+ * critical sections of the queue grows with the size of an item.  A reference
+ * queue instead owns a fixed pool of uxSlotCount slots of xSlotSize bytes:
+ *
+ * 1. The sender takes a free slot with pvRefQueueAcquire() and writes the item
+ *    directly into it.
+ * 2. The sender passes the slot to the queue with vRefQueueSend().  Only the
+ *    pointer to the slot is copied.
+ * 3. The receiver takes the oldest slot from the queue with pvRefQueueReceive()
+ *    and reads the item directly from it.
+ * 4. The receiver returns the slot to the pool with vRefQueueRelease().
+ *
+ * The free slots and the sent slots are each held in an ordinary queue of
+ * pointers, so pvRefQueueAcquire() blocks while all the slots are in use, and
+ * pvRefQueueReceive() blocks while no slots have been sent, exactly as
+ * xQueueReceive() blocks on an empty queue - with the same priority ordering
+ * and timeout behaviour.  As the queue can hold every slot vRefQueueSend()
+ * never has to block.
+ *
+ * Between pvRefQueueAcquire() and vRefQueueSend() a slot belongs to the
+ * sender, and between pvRefQueueReceive() and vRefQueueRelease() it belongs to
+ * the receiver.  The state of every slot is recorded so that sending or
+ * releasing a slot that is not owned by the caller, releasing a slot twice, or
+ * passing a pointer that is not the start of a slot fails configASSERT().
+ *
+ * @param uxSlotCount The number of slots in the pool.
+ *
+ * @param xSlotSize The size of each slot in bytes.
+ *
+ * @param pucStorage Memory of at least
+ * refqueueSTORAGE_SIZE( uxSlotCount, xSlotSize ) bytes, aligned to
+ * portBYTE_ALIGNMENT.  The slots are held at the start of it.
+ *
+ * @param pxRefQueueBuffer Memory in which the control block of the reference
+ * queue is held.
+ *
+ * @return The handle of the reference queue, or NULL if either buffer was
+ * NULL.
+ *
+ * Example usage:
+ * @code{c}
+ * #define FRAME_SIZE     128
+ * #define FRAME_COUNT    4
+ *
+ * static uint8_t ucFrameStorage[ refqueueSTORAGE_SIZE( FRAME_COUNT, FRAME_SIZE ) ] __attribute__( ( aligned( portBYTE_ALIGNMENT ) ) );
+ * static RefQueue_t xFrameQueueBuffer;
+ * static RefQueueHandle_t xFrameQueue;
+ *
+ * void vSensorTask( void * pvParameters )
+ * {
+ *  uint8_t * pucFrame;
+ *
+ *  for( ;; )
+ *  {
+ *      pucFrame = pvRefQueueAcquire( xFrameQueue, portMAX_DELAY );
+ *      vReadSensorFrame( pucFrame );
+ *      vRefQueueSend( xFrameQueue, pucFrame );
+ *  }
+ * }
+ *
+ * void vProcessTask( void * pvParameters )
+ * {
+ *  uint8_t * pucFrame;
+ *
+ *  for( ;; )
+ *  {
+ *      pucFrame = pvRefQueueReceive( xFrameQueue, portMAX_DELAY );
+ *      vProcessFrame( pucFrame );
+ *      vRefQueueRelease( xFrameQueue, pucFrame );
+ *  }
+ * }
+ *
+ * void vAFunction( void )
+ * {
+ *  xFrameQueue = xRefQueueCreateStatic( FRAME_COUNT, FRAME_SIZE, ucFrameStorage, &xFrameQueueBuffer );
+ * }
+ * @endcode
+ * \defgroup xRefQueueCreateStatic xRefQueueCreateStatic
+ * \ingroup RefQueueManagement
+ */
+RefQueueHandle_t xRefQueueCreateStatic( UBaseType_t uxSlotCount,
+                                        size_t xSlotSize,
+                                        uint8_t * pucStorage,
+                                        RefQueue_t * pxRefQueueBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * refqueue. h
+ * @code{c}
+ * RefQueueHandle_t xRefQueueCreate( UBaseType_t uxSlotCount,
+ *                                   size_t xSlotSize );
+ * @endcode
+ *
+ * As xRefQueueCreateStatic(), but the control block and storage are
+ * allocated from the FreeRTOS heap in a single allocation.
+ *
+ * @return The handle of the reference queue, or NULL if there was not enough
+ * heap memory available.
+ *
+ * \defgroup xRefQueueCreate xRefQueueCreate
+ * \ingroup RefQueueManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    RefQueueHandle_t xRefQueueCreate( UBaseType_t uxSlotCount,
+                                      size_t xSlotSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * refqueue. h
+ * @code{c}
+ * void * pvRefQueueAcquire( RefQueueHandle_t xRefQueue,
+ *                           TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Takes a free slot from the pool of a reference queue, so the item to be sent
+ * can be written directly into it.  The slot belongs to the caller until it
+ * is passed to vRefQueueSend(), or returned unused with vRefQueueRelease().
+ *
+ * @param xRefQueue The reference queue from which to take a slot.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for a slot to become free if they are all in use.
+ *
+ * @return A pointer to the start of the slot, or NULL if no slot became free
+ * before xTicksToWait expired.
+ *
+ * \defgroup pvRefQueueAcquire pvRefQueueAcquire
+ * \ingroup RefQueueManagement
+ */
+void * pvRefQueueAcquire( RefQueueHandle_t xRefQueue,
+                          TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * refqueue. h
+ * @code{c}
+ * void * pvRefQueueAcquireFromISR( RefQueueHandle_t xRefQueue );
+ * @endcode
+ *
+ * A version of pvRefQueueAcquire() that can be called from an interrupt
+ * service routine.  It never blocks.
+ *
+ * @return A pointer to the start of the slot, or NULL if all the slots are in
+ * use.
+ *
+ * \defgroup pvRefQueueAcquireFromISR pvRefQueueAcquireFromISR
+ * \ingroup RefQueueManagement
+ */
+void * pvRefQueueAcquireFromISR( RefQueueHandle_t xRefQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * refqueue. h
+ * @code{c}
+ * void vRefQueueSend( RefQueueHandle_t xRefQueue,
+ *                     void * pvSlot );
+ * @endcode
+ *
+ * Sends a slot obtained from pvRefQueueAcquire() to the back of a reference
+ * queue.  The slot then belongs to the queue, and the caller must not access
+ * it again.  The queue has room for every slot, so this never blocks.
+ *
+ * @param xRefQueue The reference queue to which the slot is sent.
+ *
+ * @param pvSlot The pointer returned by pvRefQueueAcquire().
+ *
+ * \defgroup vRefQueueSend vRefQueueSend
+ * \ingroup RefQueueManagement
+ */
+void vRefQueueSend( RefQueueHandle_t xRefQueue,
+                    void * pvSlot ) PRIVILEGED_FUNCTION;
+
+/**
+ * refqueue. h
+ * @code{c}
+ * void vRefQueueSendFromISR( RefQueueHandle_t xRefQueue,
+ *                            void * pvSlot,
+ *                            BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of vRefQueueSend() that can be called from an interrupt service
+ * routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the slot unblocked
+ * a task of higher priority than the interrupted task, in which case a context
+ * switch should be requested before the interrupt is exited, as for
+ * xQueueSendFromISR().
+ *
+ * \defgroup vRefQueueSendFromISR vRefQueueSendFromISR
+ * \ingroup RefQueueManagement
+ */
+void vRefQueueSendFromISR( RefQueueHandle_t xRefQueue,
+                           void * pvSlot,
+                           BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * refqueue. h
+ * @code{c}
+ * void * pvRefQueueReceive( RefQueueHandle_t xRefQueue,
+ *                           TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Receives the slot that was sent to a reference queue least recently.  The
+ * slot belongs to the caller until it is returned with vRefQueueRelease().
+ *
+ * @param xRefQueue The reference queue from which to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for a slot to be sent if the queue is empty.
+ *
+ * @return A pointer to the start of the slot, or NULL if no slot was sent
+ * before xTicksToWait expired.
+ *
+ * \defgroup pvRefQueueReceive pvRefQueueReceive
+ * \ingroup RefQueueManagement
+ */
+void * pvRefQueueReceive( RefQueueHandle_t xRefQueue,
+                          TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * refqueue. h
+ * @code{c}
+ * void vRefQueueRelease( RefQueueHandle_t xRefQueue,
+ *                        void * pvSlot );
+ * @endcode
+ *
+ * Returns a slot to the pool of a reference queue.  The slot must either have
+ * been received with pvRefQueueReceive(), or have been acquired with
+ * pvRefQueueAcquire() and not sent.  If a task is blocked in
+ * pvRefQueueAcquire() it is given the slot.
+ *
+ * @param xRefQueue The reference queue that owns the slot.
+ *
+ * @param pvSlot The pointer to the start of the slot.
+ *
+ * \defgroup vRefQueueRelease vRefQueueRelease
+ * \ingroup RefQueueManagement
+ */
+void vRefQueueRelease( RefQueueHandle_t xRefQueue,
+                       void * pvSlot ) PRIVILEGED_FUNCTION;
+
+/**
+ * refqueue. h
+ * @code{c}
+ * void vRefQueueReleaseFromISR( RefQueueHandle_t xRefQueue,
+ *                               void * pvSlot,
+ *                               BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of vRefQueueRelease() that can be called from an interrupt
+ * service routine, for example when a DMA transfer out of a received slot
+ * completes.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if releasing the slot
+ * unblocked a task of higher priority than the interrupted task, as for
+ * vRefQueueSendFromISR().
+ *
+ * \defgroup vRefQueueReleaseFromISR vRefQueueReleaseFromISR
+ * \ingroup RefQueueManagement
+ */
+void vRefQueueReleaseFromISR( RefQueueHandle_t xRefQueue,
+                              void * pvSlot,
+                              BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * refqueue. h
+ * @code{c}
+ * UBaseType_t uxRefQueueSlotsWaiting( RefQueueHandle_t xRefQueue );
+ * @endcode
+ *
+ * @return The number of slots that have been sent to the reference queue and
+ * not yet received.
+ *
+ * \defgroup uxRefQueueSlotsWaiting uxRefQueueSlotsWaiting
+ * \ingroup RefQueueManagement
+ */
+UBaseType_t uxRefQueueSlotsWaiting( RefQueueHandle_t xRefQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * refqueue. h
+ * @code{c}
+ * UBaseType_t uxRefQueueSlotsFree( RefQueueHandle_t xRefQueue );
+ * @endcode
+ *
+ * @return The number of slots in the pool of the reference queue that can be
+ * acquired without blocking.
+ *
+ * \defgroup uxRefQueueSlotsFree uxRefQueueSlotsFree
+ * \ingroup RefQueueManagement
+ */
+UBaseType_t uxRefQueueSlotsFree( RefQueueHandle_t xRefQueue ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+#endif /* REFQUEUE_H */
@@ -798,6 +798,88 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreCreateMutexStatic( pxMutexBuffer )    xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
 #endif
 
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateCeilingMutex( UBaseType_t uxCeilingPriority );
+ * @endcode
+ *
+ * Creates a mutex that uses the immediate priority ceiling protocol instead
+ * of priority inheritance, and returns a handle by which the mutex can be
+ * referenced.  configUSE_CEILING_MUTEXES must be set to 1 in FreeRTOSConfig.h
+ * for this macro to be available.
+ *
+ * A task that takes the mutex is raised to uxCeilingPriority straight away,
+ * rather than only when a higher priority task tries to take the mutex while
+ * it is held.  uxCeilingPriority must be at least the priority of every task
+ * that takes the mutex, so none of them can preempt the holder - a task can
+ * then only be blocked by a lower priority task for the length of one
+ * critical section, before it starts running, and tasks that share several
+ * ceiling mutexes cannot deadlock on them.  The holder returns to its own
+ * priority when it gives back the last mutex it holds, as it does from an
+ * inherited priority.
+ *
+ * Mutexes created using this function are taken and given with the
+ * xSemaphoreTake() and xSemaphoreGive() macros.  They cannot be taken
+ * recursively or used from within interrupt service routines.  A task that
+ * blocks while holding the mutex gives up the protection of the ceiling until
+ * it runs again.
+ *
+ * @param uxCeilingPriority The priority a task holding the mutex runs at.
+ * Must be above tskIDLE_PRIORITY and below configMAX_PRIORITIES.
+ *
+ * @return If the mutex was successfully created then a handle to the created
+ * mutex is returned.  If there was not enough heap to allocate the mutex data
+ * structures then NULL is returned.
+ *
+ * Example usage:
+ * @code{c}
+ * SemaphoreHandle_t xBusMutex;
+ *
+ * void vATask( void * pvParameters )
+ * {
+ *  // The highest priority task that writes to the bus runs at priority 3.
+ *  xBusMutex = xSemaphoreCreateCeilingMutex( 3 );
+ *
+ *  if( xSemaphoreTake( xBusMutex, portMAX_DELAY ) == pdTRUE )
+ *  {
+ *      // Running at priority 3 here.
+ *      xSemaphoreGive( xBusMutex );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xSemaphoreCreateCeilingMutex xSemaphoreCreateCeilingMutex
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_CEILING_MUTEXES == 1 ) )
+    #define xSemaphoreCreateCeilingMutex( uxCeilingPriority )    xQueueCreateCeilingMutex( ( uxCeilingPriority ) )
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateCeilingMutexStatic( UBaseType_t uxCeilingPriority,
+ *                                                       StaticSemaphore_t *pxMutexBuffer );
+ * @endcode
+ *
+ * Creates a priority ceiling mutex, as xSemaphoreCreateCeilingMutex(), in
+ * memory provided by the application.
+ *
+ * @param uxCeilingPriority The priority a task holding the mutex runs at.
+ *
+ * @param pxMutexBuffer Must point to a variable of type StaticSemaphore_t,
+ * which will be used to hold the mutex's data structure.
+ *
+ * @return If the mutex was successfully created then a handle to the created
+ * mutex is returned.  If pxMutexBuffer was NULL then NULL is returned.
+ *
+ * \defgroup xSemaphoreCreateCeilingMutexStatic xSemaphoreCreateCeilingMutexStatic
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_CEILING_MUTEXES == 1 ) )
+    #define xSemaphoreCreateCeilingMutexStatic( uxCeilingPriority, pxMutexBuffer )    xQueueCreateCeilingMutexStatic( ( uxCeilingPriority ), ( pxMutexBuffer ) )
+#endif
+
 
 /**
  * semphr. h
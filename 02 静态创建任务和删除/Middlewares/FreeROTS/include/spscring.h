@@ -0,0 +1,322 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include spscring.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+#include "task.h"
+
+/*-----------------------------------------------------------
+* MACROS AND DEFINITIONS
+*----------------------------------------------------------*/
+
+/* The number of bytes of storage that must be passed to
+ * xSpscRingCreateStatic() to hold uxLength items of xItemSize bytes.  One
+ * extra item is needed so a full ring can be told apart from an empty one
+ * without a shared count. */
+#define spscringSTORAGE_SIZE( uxLength, xItemSize ) \
+    ( ( ( size_t ) ( uxLength ) + ( size_t ) 1U ) * ( size_t ) ( xItemSize ) )
+
+/*
+ * The control block of a single producer, single consumer ring.  The
+ * application provides the memory for it when the ring is created statically,
+ * but its members are private to spscring.c and must only be accessed through
+ * the API functions below.
+ */
+typedef struct xSPSC_RING
+{
+    volatile UBaseType_t uxHead;          /*< The index of the next item to write.  Only written by the producer. */
+    volatile UBaseType_t uxTail;          /*< The index of the next item to read.  Only written by the consumer. */
+    UBaseType_t uxSlots;                  /*< The number of items the storage can hold, which is one more than the length of the ring. */
+    size_t xItemSize;                     /*< The size of each item in bytes. */
+    uint8_t * pucStorage;                 /*< The first item. */
+    UBaseType_t uxWakeLevel;              /*< The number of waiting items at which xSpscRingPushFromISR() wakes the consumer. */
+    TaskHandle_t volatile xTaskWaiting;   /*< The consumer while it is blocked in xSpscRingReceive(), otherwise NULL.  Only written by the consumer. */
+} SpscRing_t;
+
+/**
+ * Type by which single producer, single consumer rings are referenced.  For
+ * example, a call to xSpscRingCreate() returns an SpscRingHandle_t variable
+ * that can then be used as a parameter to xSpscRingPush(), xSpscRingPop(),
+ * etc.
+ */
+typedef SpscRing_t * SpscRingHandle_t;
+
+/*-----------------------------------------------------------
+* API FUNCTIONS
+*----------------------------------------------------------*/
+
+/**
+ * spscring. h
+ * @code{c}
+ * SpscRingHandle_t xSpscRingCreateStatic( UBaseType_t uxLength,
+ *                                         size_t xItemSize,
+ *                                         UBaseType_t uxWakeLevel,
+ *                                         uint8_t * pucStorage,
+ *                                         SpscRing_t * pxRingBuffer );
+ * @endcode
+ *
+ * Creates a ring that passes fixed size items, by copy, from exactly one
+ * producer to exactly one consumer - typically from an interrupt to a task.
+ *
+ * Unlike a queue, the ring needs no critical section.  The producer only ever
+ * writes the head index and the consumer only ever writes the tail index, so
+ * xSpscRingPush() and xSpscRingPop() are wait-free and never mask interrupts.
+ * That means xSpscRingPush() can be called from an interrupt whose priority
+ * is above configMAX_SYSCALL_INTERRUPT_PRIORITY, which must not call any other
+ * FreeRTOS API function.
+ *
+ * The consumer can block in xSpscRingReceive() until an item arrives.  It is
+ * woken by xSpscRingPushFromISR() once uxWakeLevel items are waiting, using
+ * the task's notification at index 0 as stream buffers do, so data that
+ * arrives one item at a time can be processed in bursts.  xSpscRingPush()
+ * never wakes the consumer, so an interrupt above the maximum system call
+ * priority either leaves the consumer to poll or hands waking it on to a lower
+ * priority interrupt.
+ *
+ * Only one context may push and only one context may pop or receive.  Using
+ * the same ring from two producers, or from two consumers, corrupts it.
+ *
+ * @param uxLength The maximum number of items the ring can hold.
+ *
+ * @param xItemSize The size of each item in bytes.
+ *
+ * @param uxWakeLevel The number of items that must be waiting before
+ * xSpscRingPushFromISR() wakes a consumer blocked in xSpscRingReceive().
+ * Must be between 1 and uxLength.
+ *
+ * @param pucStorage Memory of at least spscringSTORAGE_SIZE( uxLength,
+ * xItemSize ) bytes in which the items are held.
+ *
+ * @param pxRingBuffer Memory in which the control block of the ring is held.
+ *
+ * @return The handle of the ring, or NULL if either buffer was NULL.
+ *
+ * Example usage:
+ * @code{c}
+ * #define SAMPLE_COUNT    32
+ *
+ * static uint8_t ucSampleStorage[ spscringSTORAGE_SIZE( SAMPLE_COUNT, sizeof( uint16_t ) ) ];
+ * static SpscRing_t xSampleRingBuffer;
+ * static SpscRingHandle_t xSampleRing;
+ *
+ * // Runs above configMAX_SYSCALL_INTERRUPT_PRIORITY, so never masked by the
+ * // kernel.
+ * void ADC_IRQHandler( void )
+ * {
+ *  uint16_t usSample = ADC1->DR;
+ *
+ *  if( xSpscRingPush( xSampleRing, &usSample ) == pdFAIL )
+ *  {
+ *      ulOverruns++;
+ *  }
+ * }
+ *
+ * void vFilterTask( void * pvParameters )
+ * {
+ *  uint16_t usSample;
+ *
+ *  for( ;; )
+ *  {
+ *      // Poll every millisecond, then drain the ring.
+ *      vTaskDelay( pdMS_TO_TICKS( 1 ) );
+ *
+ *      while( xSpscRingPop( xSampleRing, &usSample ) == pdPASS )
+ *      {
+ *          vFilterSample( usSample );
+ *      }
+ *  }
+ * }
+ *
+ * void vAFunction( void )
+ * {
+ *  xSampleRing = xSpscRingCreateStatic( SAMPLE_COUNT, sizeof( uint16_t ), 1, ucSampleStorage, &xSampleRingBuffer );
+ * }
+ * @endcode
+ * \defgroup xSpscRingCreateStatic xSpscRingCreateStatic
+ * \ingroup SpscRingManagement
+ */
+SpscRingHandle_t xSpscRingCreateStatic( UBaseType_t uxLength,
+                                        size_t xItemSize,
+                                        UBaseType_t uxWakeLevel,
+                                        uint8_t * pucStorage,
+                                        SpscRing_t * pxRingBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * spscring. h
+ * @code{c}
+ * SpscRingHandle_t xSpscRingCreate( UBaseType_t uxLength,
+ *                                   size_t xItemSize,
+ *                                   UBaseType_t uxWakeLevel );
+ * @endcode
+ *
+ * As xSpscRingCreateStatic(), but the control block and storage are
+ * allocated from the FreeRTOS heap in a single allocation.
+ *
+ * @return The handle of the ring, or NULL if there was not enough heap memory
+ * available.
+ *
+ * \defgroup xSpscRingCreate xSpscRingCreate
+ * \ingroup SpscRingManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    SpscRingHandle_t xSpscRingCreate( UBaseType_t uxLength,
+                                      size_t xItemSize,
+                                      UBaseType_t uxWakeLevel ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * spscring. h
+ * @code{c}
+ * BaseType_t xSpscRingPush( SpscRingHandle_t xRing,
+ *                           const void * pvItem );
+ * @endcode
+ *
+ * Copies an item onto the ring.  This is the producer side of the ring.  It
+ * never blocks, never masks interrupts and never calls into the kernel, so it
+ * can be called from any task or interrupt, including interrupts above
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY.  It does not wake the consumer.
+ *
+ * @param xRing The ring onto which the item is copied.
+ *
+ * @param pvItem A pointer to the item to copy.
+ *
+ * @return pdPASS if the item was copied, or pdFAIL if the ring was full.
+ *
+ * \defgroup xSpscRingPush xSpscRingPush
+ * \ingroup SpscRingManagement
+ */
+BaseType_t xSpscRingPush( SpscRingHandle_t xRing,
+                          const void * pvItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * spscring. h
+ * @code{c}
+ * BaseType_t xSpscRingPushFromISR( SpscRingHandle_t xRing,
+ *                                  const void * pvItem,
+ *                                  BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * As xSpscRingPush(), but if the consumer is blocked in xSpscRingReceive()
+ * and the item brings the number waiting up to the wake level, the consumer
+ * is notified.  As that calls into the kernel this must only be called from
+ * an interrupt at or below configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the consumer was woken and
+ * has a priority above the interrupted task, in which case a context switch
+ * should be requested before the interrupt is exited.
+ *
+ * @return pdPASS if the item was copied, or pdFAIL if the ring was full.
+ *
+ * \defgroup xSpscRingPushFromISR xSpscRingPushFromISR
+ * \ingroup SpscRingManagement
+ */
+BaseType_t xSpscRingPushFromISR( SpscRingHandle_t xRing,
+                                 const void * pvItem,
+                                 BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * spscring. h
+ * @code{c}
+ * BaseType_t xSpscRingPop( SpscRingHandle_t xRing,
+ *                          void * pvBuffer );
+ * @endcode
+ *
+ * Copies the oldest item off the ring.  This is the consumer side of the
+ * ring.  Like xSpscRingPush() it never blocks, never masks interrupts and
+ * never calls into the kernel.
+ *
+ * @param xRing The ring from which the item is copied.
+ *
+ * @param pvBuffer The buffer into which the item is copied.
+ *
+ * @return pdPASS if an item was copied, or pdFAIL if the ring was empty.
+ *
+ * \defgroup xSpscRingPop xSpscRingPop
+ * \ingroup SpscRingManagement
+ */
+BaseType_t xSpscRingPop( SpscRingHandle_t xRing,
+                         void * pvBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * spscring. h
+ * @code{c}
+ * BaseType_t xSpscRingReceive( SpscRingHandle_t xRing,
+ *                              void * pvBuffer,
+ *                              TickType_t xTicksToWait );
+ * @endcode
+ *
+ * As xSpscRingPop(), but if the ring is empty the calling task blocks until
+ * xSpscRingPushFromISR() wakes it, or until xTicksToWait expires.  The task
+ * is only woken once the wake level given when the ring was created is
+ * reached, but if the block time expires first any item that has arrived is
+ * still returned.  Must only be called from a task.
+ *
+ * @param xRing The ring from which the item is copied.
+ *
+ * @param pvBuffer The buffer into which the item is copied.
+ *
+ * @param xTicksToWait The maximum amount of time to block waiting for items
+ * if the ring is empty.
+ *
+ * @return pdPASS if an item was copied, or pdFAIL if the ring was still empty
+ * when xTicksToWait expired.
+ *
+ * \defgroup xSpscRingReceive xSpscRingReceive
+ * \ingroup SpscRingManagement
+ */
+BaseType_t xSpscRingReceive( SpscRingHandle_t xRing,
+                             void * pvBuffer,
+                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * spscring. h
+ * @code{c}
+ * UBaseType_t uxSpscRingItemsWaiting( SpscRingHandle_t xRing );
+ * @endcode
+ *
+ * @return The number of items on the ring.  If called by the producer the
+ * ring may hold fewer items by the time the value is used, and if called by
+ * the consumer it may hold more, but never the other way round.
+ *
+ * \defgroup uxSpscRingItemsWaiting uxSpscRingItemsWaiting
+ * \ingroup SpscRingManagement
+ */
+UBaseType_t uxSpscRingItemsWaiting( SpscRingHandle_t xRing ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+#endif /* SPSCRING_H */
@@ -56,6 +56,12 @@
     #error "include FreeRTOS.h must appear in source files before include stream_buffer.h"
 #endif
 
+#if ( configUSE_WAITSETS == 1 )
+
+/* The waitset functions below take a task handle. */
+    #include "task.h"
+#endif
+
 /* *INDENT-OFF* */
 #if defined( __cplusplus )
     extern "C" {
@@ -78,6 +84,19 @@ typedef void (* StreamBufferCallbackFunction_t)( StreamBufferHandle_t xStreamBuf
                                                  BaseType_t xIsInsideISR,
                                                  BaseType_t * const pxHigherPriorityTaskWoken );
 
+#if ( configUSE_STREAM_BUFFER_VECTORS == 1 )
+
+/**
+ * Type used by xStreamBufferSendv() and xStreamBufferReceivev() to describe
+ * one fragment of the data being sent or received.
+ */
+    typedef struct xSTREAM_BUFFER_VECTOR
+    {
+        void * pvData;           /* The start of the fragment. */
+        size_t xDataLengthBytes; /* The number of bytes in the fragment, which can be 0. */
+    } StreamBufferVector_t;
+#endif
+
 /**
  * stream_buffer.h
  *
@@ -879,6 +898,494 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer,
                                                  BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendReserve( StreamBufferHandle_t xStreamBuffer,
+ *                                  void ** ppvTxData,
+ *                                  size_t xDataLengthBytes,
+ *                                  TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Reserves a contiguous region of free space inside a stream buffer or message
+ * buffer so the data can be written in place, rather than being copied in by
+ * xStreamBufferSend().  The data becomes visible to the reader only when it is
+ * committed by xStreamBufferSendCommit().  configUSE_STREAM_BUFFER_ZERO_COPY
+ * must be set to 1 in FreeRTOSConfig.h for this function to be available.
+ *
+ * Only one region can be reserved at a time, and nothing else may be written
+ * to the buffer between the reserve and the commit.
+ *
+ * For a stream buffer the region starts at the current write position and
+ * ends at the read position or at the end of the storage area, whichever comes
+ * first, so it can be shorter than xDataLengthBytes even when the buffer has
+ * that much free space in total.  Write the rest with a second reserve after
+ * committing the first region.
+ *
+ * For a message buffer the whole message must fit in the region.  When the
+ * message would otherwise wrap around the end of the storage area the rest of
+ * the storage area is skipped, which costs that many bytes of space until the
+ * message is read.  A message of up to half the size of the buffer can always
+ * be reserved, a larger message can only be reserved if it fits given the
+ * current write position, and otherwise 0 is returned without blocking.
+ *
+ * @param xStreamBuffer The handle of the stream buffer or message buffer.
+ *
+ * @param ppvTxData Set to point to the start of the reserved region.  Not
+ * changed if 0 is returned.
+ *
+ * @param xDataLengthBytes The number of bytes wanted.  For a message buffer
+ * this is the length of the message.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for space to become available.  A stream
+ * buffer waits for a contiguous region of xDataLengthBytes, or for the rest of
+ * the storage area if that is shorter.
+ *
+ * @return The number of bytes reserved, which is never more than
+ * xDataLengthBytes.  0 is returned if the space did not become available before
+ * xTicksToWait expired.
+ *
+ * Example use:
+ * @code{c}
+ * void vAFunction( MessageBufferHandle_t xMessageBuffer )
+ * {
+ * SensorFrame_t * pxFrame;
+ *
+ *  // Reserve room for one frame and fill it in place.
+ *  if( xMessageBufferSendReserve( xMessageBuffer, ( void ** ) &pxFrame,
+ *                                 sizeof( SensorFrame_t ),
+ *                                 pdMS_TO_TICKS( 100 ) ) == sizeof( SensorFrame_t ) )
+ *  {
+ *      vFillFrame( pxFrame );
+ *
+ *      // Make the frame visible to the reader and wake it if it is blocked.
+ *      ( void ) xMessageBufferSendCommit( xMessageBuffer, sizeof( SensorFrame_t ) );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xStreamBufferSendReserve xStreamBufferSendReserve
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferSendReserve( StreamBufferHandle_t xStreamBuffer,
+                                     void ** ppvTxData,
+                                     size_t xDataLengthBytes,
+                                     TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                         void ** ppvTxData,
+ *                                         size_t xDataLengthBytes );
+ * @endcode
+ *
+ * A version of xStreamBufferSendReserve() that can be called from an interrupt
+ * service routine (ISR).  It never blocks.
+ *
+ * \defgroup xStreamBufferSendReserveFromISR xStreamBufferSendReserveFromISR
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferSendReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            void ** ppvTxData,
+                                            size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer,
+ *                                 size_t xDataLengthBytes );
+ * @endcode
+ *
+ * Commits the first xDataLengthBytes bytes of the region reserved by
+ * xStreamBufferSendReserve(), making them available to the reader.  A task
+ * waiting to receive is unblocked exactly as if the bytes had been sent with
+ * xStreamBufferSend(), that is, through sbSEND_COMPLETED() or the send
+ * completed callback once the trigger level is reached.
+ *
+ * @param xStreamBuffer The handle of the stream buffer or message buffer.
+ *
+ * @param xDataLengthBytes The number of bytes written into the region, which
+ * must not be more than were reserved.  For a message buffer this is the length
+ * of the message.  Passing 0 abandons the reservation without sending anything.
+ *
+ * @return The number of bytes committed.
+ *
+ * \defgroup xStreamBufferSendCommit xStreamBufferSendCommit
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer,
+                                    size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                        size_t xDataLengthBytes,
+ *                                        BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xStreamBufferSendCommit() that can be called from an interrupt
+ * service routine (ISR).  *pxHigherPriorityTaskWoken is set to pdTRUE if
+ * committing the data unblocked a task that has a priority above the
+ * interrupted task, in which case a context switch should be requested before
+ * the interrupt is exited.
+ *
+ * \defgroup xStreamBufferSendCommitFromISR xStreamBufferSendCommitFromISR
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+                                           size_t xDataLengthBytes,
+                                           BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceiveAcquire( StreamBufferHandle_t xStreamBuffer,
+ *                                     void ** ppvRxData,
+ *                                     TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Returns a pointer to the data at the read position of a stream buffer or
+ * message buffer so it can be read in place, rather than being copied out by
+ * xStreamBufferReceive().  The data stays in the buffer until it is released
+ * by xStreamBufferReceiveRelease().  configUSE_STREAM_BUFFER_ZERO_COPY must be
+ * set to 1 in FreeRTOSConfig.h for this function to be available.
+ *
+ * For a stream buffer the bytes returned end at the write position or at the
+ * end of the storage area, whichever comes first.  For a message buffer the
+ * next whole message is returned.  A message that was written with
+ * xStreamBufferSend() can wrap around the end of the storage area, in which
+ * case its length is returned but *ppvRxData is set to NULL, and the message
+ * must be read with xStreamBufferReceive() instead.  Messages written with
+ * xStreamBufferSendReserve() never wrap.
+ *
+ * @param xStreamBuffer The handle of the stream buffer or message buffer.
+ *
+ * @param ppvRxData Set to point to the data.  Not changed if 0 is returned.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for data to become available.
+ *
+ * @return The number of bytes that can be read in place, or for a message
+ * buffer the length of the next message.  0 is returned if no data became
+ * available before xTicksToWait expired.
+ *
+ * \defgroup xStreamBufferReceiveAcquire xStreamBufferReceiveAcquire
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferReceiveAcquire( StreamBufferHandle_t xStreamBuffer,
+                                        void ** ppvRxData,
+                                        TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceiveAcquireFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                            void ** ppvRxData );
+ * @endcode
+ *
+ * A version of xStreamBufferReceiveAcquire() that can be called from an
+ * interrupt service routine (ISR).  It never blocks.
+ *
+ * \defgroup xStreamBufferReceiveAcquireFromISR xStreamBufferReceiveAcquireFromISR
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferReceiveAcquireFromISR( StreamBufferHandle_t xStreamBuffer,
+                                               void ** ppvRxData ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceiveRelease( StreamBufferHandle_t xStreamBuffer,
+ *                                     size_t xDataLengthBytes );
+ * @endcode
+ *
+ * Removes data that was read in place after a call to
+ * xStreamBufferReceiveAcquire().  A task waiting for space is unblocked exactly
+ * as if the data had been read with xStreamBufferReceive(), that is, through
+ * sbRECEIVE_COMPLETED() or the receive completed callback.
+ *
+ * @param xStreamBuffer The handle of the stream buffer or message buffer.
+ *
+ * @param xDataLengthBytes For a stream buffer, the number of bytes to remove,
+ * which must not be more than were returned by xStreamBufferReceiveAcquire().
+ * For a message buffer, the length of the message, which is always removed in
+ * full.
+ *
+ * @return The number of bytes removed.
+ *
+ * \defgroup xStreamBufferReceiveRelease xStreamBufferReceiveRelease
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferReceiveRelease( StreamBufferHandle_t xStreamBuffer,
+                                        size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceiveReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                            size_t xDataLengthBytes,
+ *                                            BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xStreamBufferReceiveRelease() that can be called from an
+ * interrupt service routine (ISR).  *pxHigherPriorityTaskWoken is set to
+ * pdTRUE if releasing the data unblocked a task that has a priority above the
+ * interrupted task, in which case a context switch should be requested before
+ * the interrupt is exited.
+ *
+ * \defgroup xStreamBufferReceiveReleaseFromISR xStreamBufferReceiveReleaseFromISR
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferReceiveReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+                                               size_t xDataLengthBytes,
+                                               BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
+#if ( configUSE_STREAM_BUFFER_VECTORS == 1 )
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendv( StreamBufferHandle_t xStreamBuffer,
+ *                            const StreamBufferVector_t * pxVectors,
+ *                            UBaseType_t uxVectorCount,
+ *                            TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Sends the data held in uxVectorCount separate fragments as if it had first
+ * been copied into one contiguous buffer and sent with xStreamBufferSend(), so
+ * a protocol header, payload and CRC can be sent without being assembled in a
+ * temporary buffer first.  configUSE_STREAM_BUFFER_VECTORS must be set to 1 in
+ * FreeRTOSConfig.h for this function to be available.
+ *
+ * For a message buffer the fragments form a single message with a single
+ * length, and the message is either written in full or not at all.  For a
+ * stream buffer as many bytes as there is space for are written, taken from
+ * the fragments in order.  Either way the reader cannot see any of the data
+ * until all of it has been written.
+ *
+ * The blocking behaviour, and the way a task waiting to receive is unblocked,
+ * are the same as xStreamBufferSend().
+ *
+ * @param xStreamBuffer The handle of the stream buffer or message buffer.
+ *
+ * @param pxVectors An array of uxVectorCount fragments, sent in array order.
+ * Fragments can have a length of 0.
+ *
+ * @param uxVectorCount The number of fragments in pxVectors.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for enough space to become available.
+ *
+ * @return The total number of bytes written, which for a message buffer is
+ * either the length of the whole message or 0.
+ *
+ * Example use:
+ * @code{c}
+ * void vSendFrame( MessageBufferHandle_t xMessageBuffer,
+ *                  FrameHeader_t * pxHeader,
+ *                  uint8_t * pucPayload,
+ *                  size_t xPayloadLength,
+ *                  uint16_t * pusCRC )
+ * {
+ * StreamBufferVector_t xFragments[ 3 ];
+ *
+ *  xFragments[ 0 ].pvData = pxHeader;
+ *  xFragments[ 0 ].xDataLengthBytes = sizeof( FrameHeader_t );
+ *  xFragments[ 1 ].pvData = pucPayload;
+ *  xFragments[ 1 ].xDataLengthBytes = xPayloadLength;
+ *  xFragments[ 2 ].pvData = pusCRC;
+ *  xFragments[ 2 ].xDataLengthBytes = sizeof( uint16_t );
+ *
+ *  // Send the three fragments as one message.
+ *  ( void ) xMessageBufferSendv( xMessageBuffer, xFragments, 3, pdMS_TO_TICKS( 100 ) );
+ * }
+ * @endcode
+ * \defgroup xStreamBufferSendv xStreamBufferSendv
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferSendv( StreamBufferHandle_t xStreamBuffer,
+                               const StreamBufferVector_t * pxVectors,
+                               UBaseType_t uxVectorCount,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendvFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                   const StreamBufferVector_t * pxVectors,
+ *                                   UBaseType_t uxVectorCount,
+ *                                   BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xStreamBufferSendv() that can be called from an interrupt
+ * service routine (ISR).  *pxHigherPriorityTaskWoken is set to pdTRUE if
+ * sending the data unblocked a task that has a priority above the interrupted
+ * task, in which case a context switch should be requested before the
+ * interrupt is exited.
+ *
+ * \defgroup xStreamBufferSendvFromISR xStreamBufferSendvFromISR
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferSendvFromISR( StreamBufferHandle_t xStreamBuffer,
+                                      const StreamBufferVector_t * pxVectors,
+                                      UBaseType_t uxVectorCount,
+                                      BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceivev( StreamBufferHandle_t xStreamBuffer,
+ *                               const StreamBufferVector_t * pxVectors,
+ *                               UBaseType_t uxVectorCount,
+ *                               TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Receives data into uxVectorCount separate fragments, filling each fragment
+ * in turn before moving on to the next, as if the data had been received into
+ * one contiguous buffer with xStreamBufferReceive() and then split.  For
+ * example the fixed size header of a message can be received into one
+ * structure and the payload into another buffer.
+ *
+ * For a message buffer the next message is received only if it fits in the
+ * total length of the fragments, otherwise 0 is returned and the message is
+ * left in the buffer, as with xStreamBufferReceive().  Fragments that follow
+ * the end of the message are not written.
+ *
+ * @param xStreamBuffer The handle of the stream buffer or message buffer.
+ *
+ * @param pxVectors An array of uxVectorCount fragments, filled in array
+ * order.  The length of each fragment is its capacity and is not changed.
+ *
+ * @param uxVectorCount The number of fragments in pxVectors.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for data to become available.
+ *
+ * @return The total number of bytes received.
+ *
+ * \defgroup xStreamBufferReceivev xStreamBufferReceivev
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferReceivev( StreamBufferHandle_t xStreamBuffer,
+                                  const StreamBufferVector_t * pxVectors,
+                                  UBaseType_t uxVectorCount,
+                                  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferReceivevFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                      const StreamBufferVector_t * pxVectors,
+ *                                      UBaseType_t uxVectorCount,
+ *                                      BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xStreamBufferReceivev() that can be called from an interrupt
+ * service routine (ISR).  *pxHigherPriorityTaskWoken is set to pdTRUE if
+ * receiving the data unblocked a task that has a priority above the
+ * interrupted task, in which case a context switch should be requested before
+ * the interrupt is exited.
+ *
+ * \defgroup xStreamBufferReceivevFromISR xStreamBufferReceivevFromISR
+ * \ingroup StreamBufferManagement
+ */
+    size_t xStreamBufferReceivevFromISR( StreamBufferHandle_t xStreamBuffer,
+                                         const StreamBufferVector_t * pxVectors,
+                                         UBaseType_t uxVectorCount,
+                                         BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_VECTORS */
+
+#if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * void vStreamBufferSetTriggerTimeout( StreamBufferHandle_t xStreamBuffer, TickType_t xTriggerTimeout );
+ * @endcode
+ *
+ * Sets the longest time a task that is blocked on a read of an empty stream
+ * buffer stays in the Blocked state after the first byte is written to the
+ * buffer.  The task is unblocked when the trigger level is reached or when
+ * xTriggerTimeout ticks have passed since the first unread byte was written,
+ * whichever comes first, and then receives however many bytes are available.
+ * The task's own block time still applies if it expires sooner.
+ *
+ * This lets a high trigger level be used to batch bytes that arrive in bursts,
+ * such as from a UART, without leaving the last bytes of a burst unread until
+ * more data arrives.  The kernel shortens the block time of the waiting task
+ * when the first byte is written, so no timer is needed.  If that is not
+ * possible, because the scheduler is suspended when the byte is written from
+ * an interrupt, the task is unblocked straight away instead.
+ *
+ * A read that finds data already in the buffer returns it without blocking, as
+ * it does without a trigger timeout.  configUSE_SB_TRIGGER_TIMEOUT must be set
+ * to 1 in FreeRTOSConfig.h for this function to be available.  It cannot be
+ * used with a message buffer.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being updated.
+ *
+ * @param xTriggerTimeout The trigger timeout in ticks.  portMAX_DELAY, the
+ * value set when the stream buffer is created, waits for the trigger level
+ * alone.
+ *
+ * \defgroup vStreamBufferSetTriggerTimeout vStreamBufferSetTriggerTimeout
+ * \ingroup StreamBufferManagement
+ */
+    void vStreamBufferSetTriggerTimeout( StreamBufferHandle_t xStreamBuffer,
+                                         TickType_t xTriggerTimeout ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * void vStreamBufferGetWakeCounts( StreamBufferHandle_t xStreamBuffer, uint32_t * pulLevelWakes, uint32_t * pulTimeoutWakes );
+ * @endcode
+ *
+ * Queries how many times the task reading from a stream buffer has been
+ * unblocked since the stream buffer was created or last reset, which can be
+ * used to tune the trigger level and trigger timeout.  Reads that found data
+ * without blocking are not counted.  configUSE_SB_TRIGGER_TIMEOUT must be set
+ * to 1 in FreeRTOSConfig.h for this function to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being queried.
+ *
+ * @param pulLevelWakes Set to the number of times the reading task was
+ * unblocked by a write, normally because the trigger level was reached.  Can
+ * be NULL.
+ *
+ * @param pulTimeoutWakes Set to the number of times the reading task was
+ * unblocked by its block time expiring with data below the trigger level in
+ * the buffer, normally the trigger timeout.  Can be NULL.
+ *
+ * \defgroup vStreamBufferGetWakeCounts vStreamBufferGetWakeCounts
+ * \ingroup StreamBufferManagement
+ */
+    void vStreamBufferGetWakeCounts( StreamBufferHandle_t xStreamBuffer,
+                                     uint32_t * pulLevelWakes,
+                                     uint32_t * pulTimeoutWakes ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_SB_TRIGGER_TIMEOUT */
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
                                                  size_t xTriggerLevelBytes,
@@ -904,6 +1411,18 @@ size_t xStreamBufferNextMessageLengthBytes( StreamBufferHandle_t xStreamBuffer )
     uint8_t ucStreamBufferGetStreamBufferType( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
 #endif
 
+/*
+ * For internal use only.  Called by waitset.c to add xStreamBuffer to the
+ * waitset owned by xOwner if ulBits is not 0, in which case ulBits is posted
+ * to the owner each time a send leaves at least the trigger level in the
+ * buffer, or to remove xStreamBuffer from the waitset if ulBits is 0.
+ */
+#if ( configUSE_WAITSETS == 1 )
+    BaseType_t xStreamBufferSetWaitSetMember( StreamBufferHandle_t xStreamBuffer,
+                                              TaskHandle_t xOwner,
+                                              uint32_t ulBits ) PRIVILEGED_FUNCTION;
+#endif
+
 /* *INDENT-OFF* */
 #if defined( __cplusplus )
     }
@@ -168,6 +168,45 @@ typedef struct xTASK_STATUS
     configSTACK_DEPTH_TYPE usStackHighWaterMark;  /* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } TaskStatus_t;
 
+/* Actions that vTaskSetBudget() can be told to take when a task uses up its
+ * execution time budget. */
+typedef enum
+{
+    eBudgetDemote = 0, /* The task runs at the idle priority until its budget is replenished. */
+    eBudgetSuspend     /* The task is held in the Blocked state until its budget is replenished. */
+} eBudgetAction;
+
+/* Used with the uxTaskGetBudgetState() function to return the execution time
+ * budget state of each task that has a budget. */
+typedef struct xTASK_BUDGET_STATUS
+{
+    TaskHandle_t xHandle;       /* The handle of the task to which the rest of the information in the structure relates. */
+    const char * pcTaskName;    /* A pointer to the task's name.  This value will be invalid if the task was deleted since the structure was populated! */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    uint32_t ulBudget;          /* The execution time the task may use in each period, in units of the budget counter. */
+    uint32_t ulBudgetUsed;      /* The execution time the task has used in the current period. */
+    uint32_t ulPeakBudgetUsed;  /* The most execution time the task has used in any one period since its budget was set. */
+    TickType_t xPeriod;         /* The number of ticks between budget replenishments. */
+    UBaseType_t uxOverruns;     /* The number of periods in which the task used up its budget. */
+    BaseType_t xThrottled;      /* pdTRUE if the task has used up its budget and is being demoted or held until it is replenished. */
+} TaskBudgetStatus_t;
+
+/* The tasks that are blocked on a queue, semaphore or mutex.  When
+ * configUSE_PRIORITY_EVENT_LISTS is 1 each priority has its own list of
+ * waiting tasks, held in the order in which the tasks blocked, and bit n of
+ * uxWaitingPriorities is set when a task blocked in xWaitingLists[ n ].  Tasks
+ * that time out leave their list without the bit map being updated, so a bit
+ * can remain set after its list has become empty.  Such bits are cleared the
+ * next time they are found to be the highest set bit. */
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+    typedef struct xEVENT_LIST
+    {
+        List_t xWaitingLists[ configMAX_PRIORITIES ];
+        UBaseType_t uxWaitingPriorities;
+    } EventList_t;
+#else
+    typedef List_t EventList_t;
+#endif
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -478,6 +517,177 @@ typedef enum
                                     StaticTask_t * const pxTaskBuffer ) PRIVILEGED_FUNCTION;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * task. h
+ * @code{c}
+ * TaskHandle_t xTaskCreateStaticWithDeadline( TaskFunction_t pxTaskCode,
+ *                                           const char *pcName,
+ *                                           uint32_t ulStackDepth,
+ *                                           void *pvParameters,
+ *                                           TickType_t xRelativeDeadline,
+ *                                           StackType_t *puxStackBuffer,
+ *                                           StaticTask_t *pxTaskBuffer );
+ * @endcode
+ *
+ * configSUPPORT_STATIC_ALLOCATION and configUSE_EDF_SCHEDULING must both be
+ * set to 1 for this function to be available.
+ *
+ * Create a new deadline scheduled task and add it to the list of tasks that
+ * are ready to run.  The task is created at priority configEDF_TASK_PRIORITY.
+ * Tasks at that priority are selected earliest deadline first instead of
+ * time slicing: the ready task with the earliest absolute deadline runs, and
+ * preempts a running task at that priority whose deadline is later.  Tasks
+ * at other priorities are scheduled as normal, so higher priorities still
+ * preempt deadline scheduled tasks.
+ *
+ * A deadline scheduled task is expected to be periodic, calling
+ * xTaskDelayUntil() at the end of each release.  Each call sets the absolute
+ * deadline of the next release to the next wake time plus
+ * xRelativeDeadline, and counts the release that just ended as a deadline
+ * miss if it completed on or after its deadline - see
+ * uxTaskGetDeadlineMissCount().  The deadline of the first release is the
+ * time at which the task is created plus xRelativeDeadline.
+ *
+ * Tasks created at configEDF_TASK_PRIORITY by other means, or that inherit
+ * that priority, have no deadline and run after all the tasks that do.
+ *
+ * @param xRelativeDeadline The deadline of each release, in ticks, measured
+ * from the time of the release.  For a periodic task this is normally the
+ * period passed to xTaskDelayUntil().  Must not be zero.
+ *
+ * See xTaskCreateStatic() for a description of the other parameters and the
+ * return value.
+ *
+ * Example usage:
+ * @code{c}
+ *  StaticTask_t xControlTaskBuffer;
+ *  StackType_t xControlStack[ 200 ];
+ *
+ *  void vControlTask( void * pvParameters )
+ *  {
+ *  TickType_t xLastWakeTime = xTaskGetTickCount();
+ *
+ *      for( ;; )
+ *      {
+ *          // Run one control cycle, which must finish within 5 ticks of
+ *          // its release.
+ *          vRunControlCycle();
+ *
+ *          // Release again 5 ticks after the last release.
+ *          xTaskDelayUntil( &xLastWakeTime, 5 );
+ *      }
+ *  }
+ *
+ *  void vOtherFunction( void )
+ *  {
+ *      xTaskCreateStaticWithDeadline( vControlTask, "Ctrl", 200, NULL, 5, xControlStack, &xControlTaskBuffer );
+ *  }
+ * @endcode
+ * \defgroup xTaskCreateStaticWithDeadline xTaskCreateStaticWithDeadline
+ * \ingroup Tasks
+ */
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_EDF_SCHEDULING == 1 ) )
+    TaskHandle_t xTaskCreateStaticWithDeadline( TaskFunction_t pxTaskCode,
+                                                const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                                const uint32_t ulStackDepth,
+                                                void * const pvParameters,
+                                                const TickType_t xRelativeDeadline,
+                                                StackType_t * const puxStackBuffer,
+                                                StaticTask_t * const pxTaskBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * TaskHandle_t xTaskCreateStaticSharedStack( TaskFunction_t pxJobCode,
+ *                                          const char *pcName,
+ *                                          uint32_t ulStackDepth,
+ *                                          void *pvParameters,
+ *                                          UBaseType_t uxPriority,
+ *                                          UBaseType_t uxPreemptionThreshold,
+ *                                          TickType_t xPeriod,
+ *                                          StackType_t *puxSharedStackBuffer,
+ *                                          StaticTask_t *pxTaskBuffer );
+ * @endcode
+ *
+ * configUSE_SHARED_STACKS must be set to 1 for this function to be available.
+ *
+ * Create a run to completion task that uses a stack shared with other run to
+ * completion tasks.  Instead of looping forever, the task runs pxJobCode once
+ * each time it is released, and pxJobCode must return before the task can be
+ * released again.  While pxJobCode is running nothing of any other task on the
+ * same stack can be on the stack, so one stack, sized for the deepest of the
+ * jobs, is enough for all of them.
+ *
+ * For that to be true the tasks that share a stack must never preempt each
+ * other, so:
+ *
+ * + All the tasks that share a stack must be created with the same
+ *   uxPreemptionThreshold, and their priorities must not be above it.
+ *
+ * + pxJobCode must not call any API function that can enter the Blocked
+ *   state, other than with a block time of zero, and must not suspend itself.
+ *   configASSERT() is called if it does.
+ *
+ * + The tasks must not be given a budget that uses eBudgetSuspend.
+ *
+ * + The tasks that share a stack must all be created before any of them
+ *   starts to run, as creating a task writes to its stack.
+ *
+ * A task on a shared stack is preempted only by tasks above its preemption
+ * threshold, which have stacks of their own.  If it is preempted it runs again
+ * before any task at or below its threshold, so it always completes before
+ * the next job on its stack starts.
+ *
+ * @param pxJobCode The function run each time the task is released.
+ *
+ * @param uxPreemptionThreshold The preemption threshold of the task - see
+ * vTaskPreemptionThresholdSet().
+ *
+ * @param xPeriod If not zero, the task is released every xPeriod ticks,
+ * starting when it is created.  If zero, the task is released once each time
+ * it is sent a notification with xTaskNotifyGive() or vTaskNotifyGiveFromISR().
+ *
+ * @param puxSharedStackBuffer The stack shared by the tasks, which must hold
+ * ulStackDepth indexes and must be passed to each task that shares it.
+ *
+ * See xTaskCreateStatic() for a description of the other parameters and the
+ * return value.
+ *
+ * Example usage:
+ * @code{c}
+ *  StaticTask_t xLedTaskBuffer, xLogTaskBuffer;
+ *  StackType_t xSharedStack[ 200 ];
+ *
+ *  void vLedJob( void * pvParameters )
+ *  {
+ *      // Runs every 500 ticks, and returns when it is done.
+ *      vToggleLed();
+ *  }
+ *
+ *  void vOtherFunction( void )
+ *  {
+ *      // Both tasks run with a threshold of 3, so neither can preempt the
+ *      // other and they can share xSharedStack.
+ *      xTaskCreateStaticSharedStack( vLedJob, "LED", 200, NULL, 1, 3, 500, xSharedStack, &xLedTaskBuffer );
+ *      xTaskCreateStaticSharedStack( vLogJob, "Log", 200, NULL, 3, 3, 0, xSharedStack, &xLogTaskBuffer );
+ *  }
+ * @endcode
+ * \defgroup xTaskCreateStaticSharedStack xTaskCreateStaticSharedStack
+ * \ingroup Tasks
+ */
+#if ( configUSE_SHARED_STACKS == 1 )
+    TaskHandle_t xTaskCreateStaticSharedStack( TaskFunction_t pxJobCode,
+                                               const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                               const uint32_t ulStackDepth,
+                                               void * const pvParameters,
+                                               UBaseType_t uxPriority,
+                                               UBaseType_t uxPreemptionThreshold,
+                                               const TickType_t xPeriod,
+                                               StackType_t * const puxSharedStackBuffer,
+                                               StaticTask_t * const pxTaskBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -962,6 +1172,80 @@ UBaseType_t uxTaskPriorityGet( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
  */
 UBaseType_t uxTaskPriorityGetFromISR( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetDeadlineMissCount( const TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_EDF_SCHEDULING must be set to 1 for this function to be available.
+ *
+ * Obtain the number of releases of a task created with
+ * xTaskCreateStaticWithDeadline() that completed, by calling
+ * xTaskDelayUntil(), on or after their deadline.
+ *
+ * @param xTask Handle of the task to be queried.  Passing a NULL
+ * handle results in the count of the calling task being returned.
+ *
+ * @return The number of deadlines missed by xTask.
+ *
+ * \defgroup uxTaskGetDeadlineMissCount uxTaskGetDeadlineMissCount
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    UBaseType_t uxTaskGetDeadlineMissCount( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetBudget( TaskHandle_t xTask, uint32_t ulBudget, TickType_t xPeriod, eBudgetAction eAction );
+ * @endcode
+ *
+ * configUSE_TASK_BUDGETS must be set to 1 for this function to be available.
+ *
+ * Limit the execution time a task can use in each period, so a task that
+ * misbehaves cannot starve the tasks that run at lower priorities.
+ *
+ * The time a task spends in the Running state is measured using
+ * portGET_BUDGET_COUNTER_VALUE(), which on Cortex-M3 is the DWT cycle counter,
+ * and the budget is checked each tick interrupt and each context switch.  A
+ * task can therefore overrun its budget by up to one tick period before
+ * eAction is taken.  The budget is replenished every xPeriod ticks, counted
+ * from when vTaskSetBudget() is called.
+ *
+ * @param xTask Handle of the task to which the budget applies.  Passing a
+ * NULL handle results in the budget of the calling task being set.  The idle
+ * task cannot be given a budget.
+ *
+ * @param ulBudget The execution time the task may use in each period, in
+ * units of the budget counter (CPU cycles on Cortex-M3).  Passing 0 removes
+ * any budget the task has.
+ *
+ * @param xPeriod The number of ticks between budget replenishments.
+ *
+ * @param eAction eBudgetDemote to run the task at the idle priority until its
+ * budget is replenished, or eBudgetSuspend to hold the task in the Blocked
+ * state until its budget is replenished.
+ *
+ * Example usage:
+ * @code{c}
+ * void vAFunction( TaskHandle_t xKeyScanTask )
+ * {
+ *   // Allow the key scan task 2ms of a 72MHz CPU in every 100ms.
+ *   vTaskSetBudget( xKeyScanTask, 72000000UL / 500UL, pdMS_TO_TICKS( 100 ), eBudgetDemote );
+ * }
+ * @endcode
+ * \defgroup vTaskSetBudget vTaskSetBudget
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_TASK_BUDGETS == 1 )
+    void vTaskSetBudget( TaskHandle_t xTask,
+                         uint32_t ulBudget,
+                         TickType_t xPeriod,
+                         eBudgetAction eAction ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -1088,6 +1372,76 @@ void vTaskGetInfo( TaskHandle_t xTask,
 void vTaskPrioritySet( TaskHandle_t xTask,
                        UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskPreemptionThresholdSet( TaskHandle_t xTask, UBaseType_t uxNewThreshold );
+ * @endcode
+ *
+ * configUSE_PREEMPTION_THRESHOLD must be set to 1 for this function to be
+ * available.
+ *
+ * Set the preemption threshold of a task.  A task still competes for the
+ * processor at its priority, but once it is running it can only be preempted
+ * by a task whose priority is above its threshold.  If it is preempted by
+ * such a task it resumes before any task at or below its threshold runs.
+ * Tasks whose priorities lie between a task's priority and its threshold
+ * therefore never preempt it, which removes the context switches between
+ * them and means they cannot be part way through at the same time - see
+ * xTaskCreateStaticSharedStack().
+ *
+ * A task that is running with a threshold above its priority does not time
+ * slice, and taskYIELD() does not let tasks at or below its threshold run.
+ *
+ * The threshold of a task is its priority when it is created.  The threshold
+ * in effect is never below the priority of the task, so raising a task's
+ * priority, including by priority inheritance, can raise it too.
+ *
+ * @param xTask Handle of the task whose threshold is being set.  Passing a
+ * NULL handle results in the threshold of the calling task being set.
+ *
+ * @param uxNewThreshold The new preemption threshold of the task.
+ *
+ * Example usage:
+ * @code{c}
+ * void vAFunction( TaskHandle_t xLedTask )
+ * {
+ *   // The LED task runs at priority 1, but once it is running it cannot be
+ *   // preempted by the tasks at priorities 2 and 3.
+ *   vTaskPreemptionThresholdSet( xLedTask, 3 );
+ * }
+ * @endcode
+ * \defgroup vTaskPreemptionThresholdSet vTaskPreemptionThresholdSet
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+    void vTaskPreemptionThresholdSet( TaskHandle_t xTask,
+                                      UBaseType_t uxNewThreshold ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskPreemptionThresholdGet( const TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_PREEMPTION_THRESHOLD must be set to 1 for this function to be
+ * available.
+ *
+ * Obtain the preemption threshold of any task.
+ *
+ * @param xTask Handle of the task to be queried.  Passing a NULL
+ * handle results in the threshold of the calling task being returned.
+ *
+ * @return The preemption threshold last set for xTask.
+ *
+ * \defgroup uxTaskPreemptionThresholdGet uxTaskPreemptionThresholdGet
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+    UBaseType_t uxTaskPreemptionThresholdGet( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -1460,6 +1814,27 @@ TickType_t xTaskGetTickCount( void ) PRIVILEGED_FUNCTION;
  */
 TickType_t xTaskGetTickCountFromISR( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * TickType_t xTaskGetTickCountIncludingPended( void );
+ * @endcode
+ *
+ * @return The count of ticks since vTaskStartScheduler was called, including
+ * any ticks that occurred while the scheduler was suspended and that
+ * xTaskResumeAll() has not yet processed.
+ *
+ * xTaskGetTickCount() does not change while the scheduler is suspended, as
+ * ticks are only pended then.  This function keeps counting, so it can be used
+ * for a time base that must keep running inside vTaskSuspendAll(), such as
+ * the HAL tick.  It can be called from a task or an ISR, subject to the same
+ * conditions as xTaskGetTickCountFromISR().
+ *
+ * \defgroup xTaskGetTickCountIncludingPended xTaskGetTickCountIncludingPended
+ * \ingroup TaskUtils
+ */
+TickType_t xTaskGetTickCountIncludingPended( void ) PRIVILEGED_FUNCTION;
+
 /**
  * task. h
  * @code{c}
@@ -1809,6 +2184,58 @@ UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray,
                                   const UBaseType_t uxArraySize,
                                   configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetBudgetState( TaskBudgetStatus_t * const pxBudgetStatusArray, const UBaseType_t uxArraySize );
+ * @endcode
+ *
+ * configUSE_TASK_BUDGETS must be set to 1 for this function to be available.
+ *
+ * uxTaskGetBudgetState() populates a TaskBudgetStatus_t structure for each
+ * task that has been given a budget by vTaskSetBudget().  TaskBudgetStatus_t
+ * structures contain, among other things, the budget of the task, the
+ * execution time it has used in the current period, and the number of
+ * periods in which it used up its budget.
+ *
+ * @param pxBudgetStatusArray A pointer to an array of TaskBudgetStatus_t
+ * structures.  The array must contain at least one TaskBudgetStatus_t
+ * structure for each task that has a budget.
+ *
+ * @param uxArraySize The size of the array pointed to by the
+ * pxBudgetStatusArray parameter.  The size is specified as the number of
+ * indexes in the array, or the number of TaskBudgetStatus_t structures
+ * contained in the array, not by the number of bytes in the array.
+ *
+ * @return The number of TaskBudgetStatus_t structures that were populated by
+ * uxTaskGetBudgetState().  This is zero if the array is too small to hold an
+ * entry for each task that has a budget.
+ *
+ * Example usage:
+ * @code{c}
+ *  void vAFunction( void )
+ *  {
+ *  TaskBudgetStatus_t xBudgets[ 4 ];
+ *  UBaseType_t uxTasks, x;
+ *
+ *      uxTasks = uxTaskGetBudgetState( xBudgets, 4 );
+ *
+ *      for( x = 0; x < uxTasks; x++ )
+ *      {
+ *          printf( "%s used %u of %u, %u overruns\r\n",
+ *                  xBudgets[ x ].pcTaskName,
+ *                  ( unsigned ) xBudgets[ x ].ulPeakBudgetUsed,
+ *                  ( unsigned ) xBudgets[ x ].ulBudget,
+ *                  ( unsigned ) xBudgets[ x ].uxOverruns );
+ *      }
+ *  }
+ *  @endcode
+ */
+#if ( configUSE_TASK_BUDGETS == 1 )
+    UBaseType_t uxTaskGetBudgetState( TaskBudgetStatus_t * const pxBudgetStatusArray,
+                                      const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -2954,7 +3381,7 @@ BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
  * portTICK_PERIOD_MS can be used to convert kernel ticks into a real time
  * period.
  */
-void vTaskPlaceOnEventList( List_t * const pxEventList,
+void vTaskPlaceOnEventList( EventList_t * const pxEventList,
                             const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
                                      const TickType_t xItemValue,
@@ -2971,7 +3398,7 @@ void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
  * indefinitely, whereas vTaskPlaceOnEventList() does.
  *
  */
-void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
+void vTaskPlaceOnEventListRestricted( EventList_t * const pxEventList,
                                       TickType_t xTicksToWait,
                                       const BaseType_t xWaitIndefinitely ) PRIVILEGED_FUNCTION;
 
@@ -2999,10 +3426,36 @@ void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
  * @return pdTRUE if the task being removed has a higher priority than the task
  * making the call, otherwise pdFALSE.
  */
-BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskRemoveFromEventList( EventList_t * const pxEventList ) PRIVILEGED_FUNCTION;
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
                                         const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THE EMPTY CHECK AND HIGHEST PRIORITY FUNCTIONS MUST BE CALLED WITH
+ * INTERRUPTS DISABLED.
+ *
+ * Initialise an event list, check whether any tasks are waiting on it, and
+ * get the priority of the task that xTaskRemoveFromEventList() would remove
+ * next.  uxTaskEventListGetHighestPriority() returns tskIDLE_PRIORITY if no
+ * tasks are waiting.  When configUSE_PRIORITY_EVENT_LISTS is 0 an event list
+ * is an ordinary list, so the taskEVENT_LIST_ macros use the list macros
+ * directly.
+ */
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+    void vTaskEventListInitialise( EventList_t * const pxEventList ) PRIVILEGED_FUNCTION;
+    BaseType_t xTaskEventListIsEmpty( EventList_t * const pxEventList ) PRIVILEGED_FUNCTION;
+    UBaseType_t uxTaskEventListGetHighestPriority( EventList_t * const pxEventList ) PRIVILEGED_FUNCTION;
+
+    #define taskEVENT_LIST_INITIALISE( pxEventList )    vTaskEventListInitialise( pxEventList )
+    #define taskEVENT_LIST_IS_EMPTY( pxEventList )      xTaskEventListIsEmpty( pxEventList )
+#else
+    #define taskEVENT_LIST_INITIALISE( pxEventList )    vListInitialise( pxEventList )
+    #define taskEVENT_LIST_IS_EMPTY( pxEventList )      listLIST_IS_EMPTY( pxEventList )
+#endif
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
@@ -3059,6 +3512,15 @@ BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder ) PRIVILEGE
 void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
                                           UBaseType_t uxHighestPriorityWaitingTask ) PRIVILEGED_FUNCTION;
 
+/*
+ * Raises the priority of the calling task to the ceiling priority of a
+ * priority ceiling mutex it has just taken, if it is not already running at
+ * or above it.  The priority is returned by xTaskPriorityDisinherit() once the
+ * task gives back the last mutex it holds.  Must be called with interrupts
+ * masked.
+ */
+void vTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+
 /*
  * Get the uxTaskNumber assigned to the task referenced by the xTask parameter.
  */
@@ -3097,12 +3559,83 @@ void vTaskStepTick( TickType_t xTicksToJump ) PRIVILEGED_FUNCTION;
  */
 eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Only available when configUSE_DYNAMIC_TICK is set to 1.
+ * Returns the number of ticks, counted from the current tick count, until the
+ * kernel next needs a tick interrupt - either because a Blocked task may need
+ * to be unblocked or because Ready state tasks need to time slice.  The port
+ * uses the value to program its tick timer.  Must be called with interrupts
+ * masked.
+ */
+TickType_t xTaskGetTicksToNextEvent( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Only available when configUSE_DYNAMIC_TICK is set to 1.
+ * Moves the tick count forward by up to xTicksToStep ticks that have passed
+ * without a tick interrupt, without ever reaching the time at which a task
+ * may need to be unblocked - that tick is always left for xTaskIncrementTick()
+ * to process.  Returns the number of ticks the tick count actually moved, which
+ * is 0 while the scheduler is suspended.  Must be called with interrupts
+ * masked.
+ */
+TickType_t xTaskStepTickDynamic( TickType_t xTicksToStep ) PRIVILEGED_FUNCTION;
+
+/*
+ * Only available when configTICK_UNBLOCK_LIMIT is greater than 0.
+ * xTaskIncrementTick() moves at most configTICK_UNBLOCK_LIMIT tasks from the
+ * Blocked state to the Ready state, so the time for which the tick interrupt
+ * keeps interrupts masked does not grow with the number of tasks that are due
+ * at the same tick.  Any further tasks that are due are left for this function,
+ * which moves at most configTICK_UNBLOCK_LIMIT more each time it is called.
+ *
+ * The port must call it repeatedly after xTaskIncrementTick(), unmasking
+ * interrupts between calls, until it returns pdFALSE to indicate no due tasks
+ * remain.  All the calls must be made before the tick interrupt returns, so
+ * that no task can run while a task of higher priority that is due is still
+ * Blocked.  *pxSwitchRequired is set to pdTRUE if a context switch is
+ * required, and is otherwise left unchanged.  Must be called with interrupts
+ * masked.
+ */
+BaseType_t xTaskUnblockDeferred( BaseType_t * const pxSwitchRequired ) PRIVILEGED_FUNCTION;
+
 /*
  * For internal use only.  Increment the mutex held count when a mutex is
  * taken and return the handle of the task that has taken the mutex.
  */
 TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Increment the mutex held count of a task other than
+ * the calling task, for a lightweight mutex that the task took without
+ * entering the kernel and that another task has now had to wait for.  Must be
+ * called with interrupts masked.
+ */
+void vTaskIncrementMutexHeldCountOf( TaskHandle_t xMutexHolder ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Called by waitset.c to make notification index
+ * uxIndexToWaitOn of xTask a member of the waitset of xTask if ulBits is not
+ * 0, in which case ulBits is posted to configWAITSET_NOTIFICATION_INDEX each
+ * time the index is notified, or to remove the index from the waitset if
+ * ulBits is 0.  Returns pdFAIL if the index is already a member when adding,
+ * or is not a member when removing.
+ */
+BaseType_t xTaskSetWaitSetMember( TaskHandle_t xTask,
+                                  UBaseType_t uxIndexToWaitOn,
+                                  uint32_t ulBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Called by stream_buffer.c to bring forward the time
+ * at which xTask, which is blocked waiting for a notification on the default
+ * notification index, times out, so that it times out no more than
+ * xTicksToWait ticks from now.  The block time is never extended.  Returns
+ * pdFALSE, without changing anything, if xTask is not blocked waiting for a
+ * notification or if the scheduler is suspended, otherwise pdTRUE.  Must be
+ * called with interrupts masked.
+ */
+BaseType_t xTaskLimitNotifyWaitTime( TaskHandle_t xTask,
+                                     TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /*
  * For internal use only.  Same as vTaskSetTimeOutState(), but without a critical
  * section.
@@ -0,0 +1,423 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef WAITSET_H
+#define WAITSET_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include waitset.h"
+#endif
+
+/*lint -save -e537 This headers are only multiply included if the application code
+ * happens to also be including task.h, queue.h, stream_buffer.h or event_groups.h. */
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+#include "event_groups.h"
+/*lint -restore */
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/*-----------------------------------------------------------
+* MACROS AND DEFINITIONS
+*----------------------------------------------------------*/
+
+/*
+ * A waitset.  The application provides the memory for it when the waitset is
+ * created statically, but its members are private to waitset.c and must only
+ * be accessed through the API functions below.
+ */
+typedef struct xWAIT_SET
+{
+    TaskHandle_t xOwner; /*< The only task that can wait on the waitset.  Members post to its notification at index configWAITSET_NOTIFICATION_INDEX. */
+} WaitSet_t;
+
+/**
+ * Type by which waitsets are referenced.  For example, a call to
+ * xWaitSetCreate() returns a WaitSetHandle_t variable that can then be used
+ * as a parameter to xWaitSetAddQueue(), ulWaitSetWait(), etc.
+ */
+typedef WaitSet_t * WaitSetHandle_t;
+
+/*-----------------------------------------------------------
+* API FUNCTIONS
+*----------------------------------------------------------*/
+
+/**
+ * waitset. h
+ * @code{c}
+ * WaitSetHandle_t xWaitSetCreateStatic( TaskHandle_t xOwner,
+ *                                       WaitSet_t * pxWaitSetBuffer );
+ * @endcode
+ *
+ * Creates a waitset, which lets one task block on any mix of queues,
+ * semaphores, mutexes, stream buffers, message buffers, event groups and its
+ * own task notification indexes at the same time.
+ *
+ * Each member of the waitset is given a mask of bits when it is added.  When
+ * a member becomes ready its bits are posted to the task notification of the
+ * owner at index configWAITSET_NOTIFICATION_INDEX, and ulWaitSetWait() returns
+ * the bits posted by every member that became ready since the last call, so
+ * the owner learns which members to read without testing each of them.
+ * Unlike a queue set, posting costs one task notification rather than a
+ * second queue send, and the members need not be empty when they are added.
+ *
+ * A member is ready:
+ * - For a queue, each time an item is sent to it while it is empty.
+ * - For a semaphore or mutex, each time it is given while it is not
+ *   available.
+ * - For a stream or message buffer, each time a send leaves at least the
+ *   trigger level of bytes in the buffer.
+ * - For an event group, each time any of the bits it was added with are set.
+ * - For a notification index, each time the index is notified.
+ *
+ * The bits are posted once per event, not held while the member stays ready,
+ * so when ulWaitSetWait() reports a member the owner should read it with a
+ * block time of 0 until it is empty.  A member that is already ready when it
+ * is added has its bits posted at once.
+ *
+ * Each member can be in at most one waitset.  Several members can share the
+ * same bits, in which case the owner must check each of them.  Members must be
+ * removed from the waitset before they, or the owner, are deleted.
+ *
+ * configUSE_WAITSETS must be set to 1 in FreeRTOSConfig.h for the waitset
+ * functions to be available, and configTASK_NOTIFICATION_ARRAY_ENTRIES must be
+ * at least 2 so the waitset has a notification index of its own.
+ *
+ * @param xOwner The task that waits on the waitset, or NULL to use the
+ * calling task.
+ *
+ * @param pxWaitSetBuffer Memory in which the waitset is held.
+ *
+ * @return The handle of the waitset, or NULL if pxWaitSetBuffer was NULL.
+ *
+ * Example usage:
+ * @code{c}
+ * #define GATEWAY_UART_RX    ( 1UL << 0 )
+ * #define GATEWAY_TIMER      ( 1UL << 1 )
+ * #define GATEWAY_KEYS       ( 1UL << 2 )
+ *
+ * void vGatewayTask( void * pvParameters )
+ * {
+ *  static WaitSet_t xWaitSetBuffer;
+ *  WaitSetHandle_t xWaitSet;
+ *  uint32_t ulReady;
+ *  uint8_t ucRx[ 32 ];
+ *  size_t xReceived;
+ *  TimerEvent_t xTimerEvent;
+ *
+ *  xWaitSet = xWaitSetCreateStatic( NULL, &xWaitSetBuffer );
+ *
+ *  xWaitSetAddStreamBuffer( xWaitSet, xUartRxStream, GATEWAY_UART_RX );
+ *  xWaitSetAddQueue( xWaitSet, xTimerEventQueue, GATEWAY_TIMER );
+ *  xWaitSetAddEventGroup( xWaitSet, xKeyEvents, KEY_ANY_BITS, GATEWAY_KEYS );
+ *
+ *  for( ;; )
+ *  {
+ *      ulReady = ulWaitSetWait( xWaitSet, portMAX_DELAY );
+ *
+ *      if( ( ulReady & GATEWAY_UART_RX ) != 0 )
+ *      {
+ *          while( ( xReceived = xStreamBufferReceive( xUartRxStream, ucRx, sizeof( ucRx ), 0 ) ) > 0 )
+ *          {
+ *              vForwardUart( ucRx, xReceived );
+ *          }
+ *      }
+ *
+ *      if( ( ulReady & GATEWAY_TIMER ) != 0 )
+ *      {
+ *          while( xQueueReceive( xTimerEventQueue, &xTimerEvent, 0 ) == pdPASS )
+ *          {
+ *              vForwardTimer( &xTimerEvent );
+ *          }
+ *      }
+ *
+ *      if( ( ulReady & GATEWAY_KEYS ) != 0 )
+ *      {
+ *          vForwardKeys( xEventGroupClearBits( xKeyEvents, KEY_ANY_BITS ) );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xWaitSetCreateStatic xWaitSetCreateStatic
+ * \ingroup WaitSetManagement
+ */
+WaitSetHandle_t xWaitSetCreateStatic( TaskHandle_t xOwner,
+                                      WaitSet_t * pxWaitSetBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * waitset. h
+ * @code{c}
+ * WaitSetHandle_t xWaitSetCreate( TaskHandle_t xOwner );
+ * @endcode
+ *
+ * As xWaitSetCreateStatic(), but the waitset is allocated from the FreeRTOS
+ * heap.
+ *
+ * @return The handle of the waitset, or NULL if there was not enough heap
+ * memory available.
+ *
+ * \defgroup xWaitSetCreate xWaitSetCreate
+ * \ingroup WaitSetManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    WaitSetHandle_t xWaitSetCreate( TaskHandle_t xOwner ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * waitset. h
+ * @code{c}
+ * BaseType_t xWaitSetAddQueue( WaitSetHandle_t xWaitSet,
+ *                              QueueSetMemberHandle_t xQueueOrSemaphore,
+ *                              uint32_t ulBits );
+ * @endcode
+ *
+ * Adds a queue, semaphore or mutex to a waitset.  ulBits is posted to the
+ * waitset each time an item is sent to the queue while it is empty, or the
+ * semaphore is given while it is not available, from a task or an interrupt.
+ * A queue set cannot be added.
+ *
+ * @param xWaitSet The waitset to which the queue or semaphore is added.
+ *
+ * @param xQueueOrSemaphore The queue or semaphore to add.
+ *
+ * @param ulBits The bits to post.  Must not be 0.
+ *
+ * @return pdPASS if the queue or semaphore was added, or pdFAIL if it was
+ * already in a waitset.
+ *
+ * \defgroup xWaitSetAddQueue xWaitSetAddQueue
+ * \ingroup WaitSetManagement
+ */
+BaseType_t xWaitSetAddQueue( WaitSetHandle_t xWaitSet,
+                             QueueSetMemberHandle_t xQueueOrSemaphore,
+                             uint32_t ulBits ) PRIVILEGED_FUNCTION;
+
+/**
+ * waitset. h
+ * @code{c}
+ * BaseType_t xWaitSetRemoveQueue( WaitSetHandle_t xWaitSet,
+ *                                 QueueSetMemberHandle_t xQueueOrSemaphore );
+ * @endcode
+ *
+ * Removes a queue, semaphore or mutex from a waitset.  Bits it has already
+ * posted are not withdrawn.
+ *
+ * @return pdPASS if the queue or semaphore was removed, or pdFAIL if it was
+ * not in the waitset.
+ *
+ * \defgroup xWaitSetRemoveQueue xWaitSetRemoveQueue
+ * \ingroup WaitSetManagement
+ */
+BaseType_t xWaitSetRemoveQueue( WaitSetHandle_t xWaitSet,
+                                QueueSetMemberHandle_t xQueueOrSemaphore ) PRIVILEGED_FUNCTION;
+
+/**
+ * waitset. h
+ * @code{c}
+ * BaseType_t xWaitSetAddStreamBuffer( WaitSetHandle_t xWaitSet,
+ *                                     StreamBufferHandle_t xStreamBuffer,
+ *                                     uint32_t ulBits );
+ * @endcode
+ *
+ * Adds a stream buffer or message buffer to a waitset.  ulBits is posted to
+ * the waitset each time a send, from a task or an interrupt, leaves at least
+ * the trigger level of bytes in the buffer.  The buffer can still be read
+ * with a block time by a task other than the owner.
+ *
+ * @param xWaitSet The waitset to which the buffer is added.
+ *
+ * @param xStreamBuffer The stream buffer or message buffer to add.
+ *
+ * @param ulBits The bits to post.  Must not be 0.
+ *
+ * @return pdPASS if the buffer was added, or pdFAIL if it was already in a
+ * waitset.
+ *
+ * \defgroup xWaitSetAddStreamBuffer xWaitSetAddStreamBuffer
+ * \ingroup WaitSetManagement
+ */
+BaseType_t xWaitSetAddStreamBuffer( WaitSetHandle_t xWaitSet,
+                                    StreamBufferHandle_t xStreamBuffer,
+                                    uint32_t ulBits ) PRIVILEGED_FUNCTION;
+
+/**
+ * waitset. h
+ * @code{c}
+ * BaseType_t xWaitSetRemoveStreamBuffer( WaitSetHandle_t xWaitSet,
+ *                                        StreamBufferHandle_t xStreamBuffer );
+ * @endcode
+ *
+ * Removes a stream buffer or message buffer from a waitset.  Bits it has
+ * already posted are not withdrawn.
+ *
+ * @return pdPASS if the buffer was removed, or pdFAIL if it was not in the
+ * waitset.
+ *
+ * \defgroup xWaitSetRemoveStreamBuffer xWaitSetRemoveStreamBuffer
+ * \ingroup WaitSetManagement
+ */
+BaseType_t xWaitSetRemoveStreamBuffer( WaitSetHandle_t xWaitSet,
+                                       StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * waitset. h
+ * @code{c}
+ * BaseType_t xWaitSetAddEventGroup( WaitSetHandle_t xWaitSet,
+ *                                   EventGroupHandle_t xEventGroup,
+ *                                   const EventBits_t uxBitsToWaitFor,
+ *                                   uint32_t ulBits );
+ * @endcode
+ *
+ * Adds an event group to a waitset.  ulBits is posted to the waitset each
+ * time any of uxBitsToWaitFor are set, including from an interrupt through
+ * xEventGroupSetBitsFromISR().  The event group bits are not cleared, so the
+ * owner reads and clears them itself, for example with
+ * xEventGroupClearBits().
+ *
+ * @param xWaitSet The waitset to which the event group is added.
+ *
+ * @param xEventGroup The event group to add.
+ *
+ * @param uxBitsToWaitFor The event group bits that make the member ready.
+ * Must not be 0.
+ *
+ * @param ulBits The bits to post.  Must not be 0.
+ *
+ * @return pdPASS if the event group was added, or pdFAIL if it was already
+ * in a waitset.
+ *
+ * \defgroup xWaitSetAddEventGroup xWaitSetAddEventGroup
+ * \ingroup WaitSetManagement
+ */
+BaseType_t xWaitSetAddEventGroup( WaitSetHandle_t xWaitSet,
+                                  EventGroupHandle_t xEventGroup,
+                                  const EventBits_t uxBitsToWaitFor,
+                                  uint32_t ulBits ) PRIVILEGED_FUNCTION;
+
+/**
+ * waitset. h
+ * @code{c}
+ * BaseType_t xWaitSetRemoveEventGroup( WaitSetHandle_t xWaitSet,
+ *                                      EventGroupHandle_t xEventGroup );
+ * @endcode
+ *
+ * Removes an event group from a waitset.  Bits it has already posted are not
+ * withdrawn.
+ *
+ * @return pdPASS if the event group was removed, or pdFAIL if it was not in
+ * the waitset.
+ *
+ * \defgroup xWaitSetRemoveEventGroup xWaitSetRemoveEventGroup
+ * \ingroup WaitSetManagement
+ */
+BaseType_t xWaitSetRemoveEventGroup( WaitSetHandle_t xWaitSet,
+                                     EventGroupHandle_t xEventGroup ) PRIVILEGED_FUNCTION;
+
+/**
+ * waitset. h
+ * @code{c}
+ * BaseType_t xWaitSetAddNotification( WaitSetHandle_t xWaitSet,
+ *                                     UBaseType_t uxIndexToWaitOn,
+ *                                     uint32_t ulBits );
+ * @endcode
+ *
+ * Adds one of the owner's own task notification indexes to a waitset.  ulBits
+ * is posted to the waitset each time the index is notified, by any of the
+ * xTaskNotify...() functions from a task or an interrupt.  The notification
+ * value and state of the index are left for the owner to read with
+ * xTaskNotifyWaitIndexed() or ulTaskNotifyTakeIndexed() and a block time of 0.
+ *
+ * @param xWaitSet The waitset to which the index is added.
+ *
+ * @param uxIndexToWaitOn The notification index to add.  Must be less than
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES and must not be
+ * configWAITSET_NOTIFICATION_INDEX.
+ *
+ * @param ulBits The bits to post.  Must not be 0.
+ *
+ * @return pdPASS if the index was added, or pdFAIL if it was already in the
+ * waitset.
+ *
+ * \defgroup xWaitSetAddNotification xWaitSetAddNotification
+ * \ingroup WaitSetManagement
+ */
+BaseType_t xWaitSetAddNotification( WaitSetHandle_t xWaitSet,
+                                    UBaseType_t uxIndexToWaitOn,
+                                    uint32_t ulBits ) PRIVILEGED_FUNCTION;
+
+/**
+ * waitset. h
+ * @code{c}
+ * BaseType_t xWaitSetRemoveNotification( WaitSetHandle_t xWaitSet,
+ *                                        UBaseType_t uxIndexToWaitOn );
+ * @endcode
+ *
+ * Removes a notification index from a waitset.  Bits it has already posted
+ * are not withdrawn.
+ *
+ * @return pdPASS if the index was removed, or pdFAIL if it was not in the
+ * waitset.
+ *
+ * \defgroup xWaitSetRemoveNotification xWaitSetRemoveNotification
+ * \ingroup WaitSetManagement
+ */
+BaseType_t xWaitSetRemoveNotification( WaitSetHandle_t xWaitSet,
+                                       UBaseType_t uxIndexToWaitOn ) PRIVILEGED_FUNCTION;
+
+/**
+ * waitset. h
+ * @code{c}
+ * uint32_t ulWaitSetWait( WaitSetHandle_t xWaitSet,
+ *                         TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Blocks the owner of a waitset until at least one member has posted its
+ * bits, or until xTicksToWait expires.  The bits posted since the last call
+ * are returned and cleared in one operation, so no post is lost between a
+ * call returning and the next call.  Must only be called by the owner.
+ *
+ * @param xWaitSet The waitset to wait on.
+ *
+ * @param xTicksToWait The maximum amount of time to block if no member has
+ * posted.  0 returns at once, so the waitset can also be polled.
+ *
+ * @return The bits posted by the members that became ready, or 0 if none
+ * posted before xTicksToWait expired.
+ *
+ * \defgroup ulWaitSetWait ulWaitSetWait
+ * \ingroup WaitSetManagement
+ */
+uint32_t ulWaitSetWait( WaitSetHandle_t xWaitSet,
+                        TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+#endif /* WAITSET_H */
@@ -68,6 +68,13 @@
 #define portNVIC_PENDSV_PRI                   ( ( ( uint32_t ) configKERNEL_INTERRUPT_PRIORITY ) << 16UL )
 #define portNVIC_SYSTICK_PRI                  ( ( ( uint32_t ) configKERNEL_INTERRUPT_PRIORITY ) << 24UL )
 
+/* Constants required to start the DWT cycle counter used to measure task
+ * execution time budgets. */
+#define portDEMCR_REG                         ( *( ( volatile uint32_t * ) 0xe000edfc ) )
+#define portDEMCR_TRCENA_BIT                  ( 1UL << 24UL )
+#define portDWT_CTRL_REG                      ( *( ( volatile uint32_t * ) 0xe0001000 ) )
+#define portDWT_CTRL_CYCCNTENA_BIT            ( 1UL << 0UL )
+
 /* Constants required to check the validity of an interrupt priority. */
 #define portFIRST_USER_INTERRUPT_NUMBER       ( 16 )
 #define portNVIC_IP_REGISTERS_OFFSET_16       ( 0xE000E3F0 )
@@ -132,6 +139,39 @@ static void prvStartFirstTask( void );
  */
 static void prvTaskExitError( void );
 
+#if ( configUSE_DYNAMIC_TICK == 1 )
+
+/*
+ * Return the number of SysTick counts of the current SysTick period that have
+ * elapsed.  Called with interrupts masked.
+ */
+    static uint32_t prvDynamicTickElapsedCounts( void );
+
+/*
+ * Add the ticks of the current SysTick period that have elapsed, but not yet
+ * been accounted for, to the tick count.  Called with interrupts masked.
+ */
+    static void prvDynamicTickStep( void );
+
+/*
+ * Move the end of the current SysTick period to the next tick at which the
+ * kernel needs a tick interrupt.  Called with interrupts masked.
+ */
+    static void prvDynamicTickReprogram( void );
+
+#endif /* configUSE_DYNAMIC_TICK */
+
+#if ( configTICK_UNBLOCK_LIMIT > 0 )
+
+/*
+ * Move the tasks that xTaskIncrementTick() left due in batches, unmasking
+ * interrupts between batches.  Called from the tick interrupt with interrupts
+ * unmasked.
+ */
+    static void prvTickUnblockDeferred( void );
+
+#endif /* configTICK_UNBLOCK_LIMIT */
+
 /*-----------------------------------------------------------*/
 
 /* Each task maintains its own interrupt status in the critical nesting
@@ -141,25 +181,43 @@ static UBaseType_t uxCriticalNesting = 0xaaaaaaaa;
 /*
  * The number of SysTick increments that make up one tick period.
  */
-#if ( configUSE_TICKLESS_IDLE == 1 )
+#if ( ( configUSE_TICKLESS_IDLE == 1 ) || ( configUSE_DYNAMIC_TICK == 1 ) )
     static uint32_t ulTimerCountsForOneTick = 0;
-#endif /* configUSE_TICKLESS_IDLE */
+#endif /* configUSE_TICKLESS_IDLE || configUSE_DYNAMIC_TICK */
 
 /*
  * The maximum number of tick periods that can be suppressed is limited by the
  * 24 bit resolution of the SysTick timer.
  */
-#if ( configUSE_TICKLESS_IDLE == 1 )
+#if ( ( configUSE_TICKLESS_IDLE == 1 ) || ( configUSE_DYNAMIC_TICK == 1 ) )
     static uint32_t xMaximumPossibleSuppressedTicks = 0;
-#endif /* configUSE_TICKLESS_IDLE */
+#endif /* configUSE_TICKLESS_IDLE || configUSE_DYNAMIC_TICK */
 
 /*
  * Compensate for the CPU cycles that pass while the SysTick is stopped (low
  * power functionality only.
  */
-#if ( configUSE_TICKLESS_IDLE == 1 )
+#if ( ( configUSE_TICKLESS_IDLE == 1 ) || ( configUSE_DYNAMIC_TICK == 1 ) )
     static uint32_t ulStoppedTimerCompensation = 0;
-#endif /* configUSE_TICKLESS_IDLE */
+#endif /* configUSE_TICKLESS_IDLE || configUSE_DYNAMIC_TICK */
+
+/*
+ * Dynamic tick state.  The SysTick period in progress started on a tick
+ * boundary and generates its interrupt ulDynamicTickPeriod ticks later.  The
+ * SysTick counter was last started ulDynamicTickCountsAtStart counts before
+ * the end of the period, at which point ulDynamicTickCountsBeforeStart counts
+ * of the period had already elapsed.  ulDynamicTicksStepped ticks of the
+ * period have already been added to the tick count.  After the period ends
+ * the SysTick reloads with a single tick period, so the state is reset to
+ * that in the tick interrupt.
+ */
+#if ( configUSE_DYNAMIC_TICK == 1 )
+    static uint32_t ulDynamicTickPeriod = 1UL;
+    static uint32_t ulDynamicTickCountsAtStart = 0UL;
+    static uint32_t ulDynamicTickCountsBeforeStart = 0UL;
+    static uint32_t ulDynamicTicksStepped = 0UL;
+    static BaseType_t xDynamicTickInHandler = pdFALSE;
+#endif /* configUSE_DYNAMIC_TICK */
 
 /*
  * Used by the portASSERT_IF_INTERRUPT_PRIORITY_INVALID() macro to ensure
@@ -427,17 +485,270 @@ __asm void xPortPendSVHandler( void )
 }
 /*-----------------------------------------------------------*/
 
-void xPortSysTickHandler( void )
-{
-    /* The SysTick runs at the lowest interrupt priority, so when this interrupt
-     * executes all interrupts must be unmasked.  There is therefore no need to
-     * save and then restore the interrupt mask value as its value is already
-     * known - therefore the slightly faster vPortRaiseBASEPRI() function is used
-     * in place of portSET_INTERRUPT_MASK_FROM_ISR(). */
-    vPortRaiseBASEPRI();
+#if ( configUSE_DYNAMIC_TICK == 0 )
+
+    void xPortSysTickHandler( void )
+    {
+        /* The SysTick runs at the lowest interrupt priority, so when this interrupt
+         * executes all interrupts must be unmasked.  There is therefore no need to
+         * save and then restore the interrupt mask value as its value is already
+         * known - therefore the slightly faster vPortRaiseBASEPRI() function is used
+         * in place of portSET_INTERRUPT_MASK_FROM_ISR(). */
+        vPortRaiseBASEPRI();
+        {
+            /* Increment the RTOS tick. */
+            if( xTaskIncrementTick() != pdFALSE )
+            {
+                /* A context switch is required.  Context switching is performed in
+                 * the PendSV interrupt.  Pend the PendSV interrupt. */
+                portNVIC_INT_CTRL_REG = portNVIC_PENDSVSET_BIT;
+            }
+        }
+
+        vPortClearBASEPRIFromISR();
+
+        #if ( configTICK_UNBLOCK_LIMIT > 0 )
+        {
+            prvTickUnblockDeferred();
+        }
+        #endif
+    }
+
+#else /* configUSE_DYNAMIC_TICK */
+
+    void xPortSysTickHandler( void )
+    {
+        uint32_t ulTicksToProcess;
+        BaseType_t xSwitchRequired = pdFALSE;
+
+        /* See the comments in the configUSE_DYNAMIC_TICK == 0 version above. */
+        vPortRaiseBASEPRI();
+        {
+            /* Stop vPortSyncTickCount() and vPortUpdateTickInterrupt() being
+             * called from within xTaskIncrementTick() while the state of the
+             * period is being changed. */
+            xDynamicTickInHandler = pdTRUE;
+
+            /* The ticks of the period that has just ended that have not already
+             * been added to the tick count.  All but the last can be stepped, the
+             * last has to be processed by xTaskIncrementTick(). */
+            ulTicksToProcess = ulDynamicTickPeriod - ulDynamicTicksStepped;
+            ulTicksToProcess -= ( uint32_t ) xTaskStepTickDynamic( ( TickType_t ) ( ulTicksToProcess - 1UL ) );
+
+            /* The SysTick reloaded with a single tick period on the tick boundary
+             * at which the period ended. */
+            ulDynamicTickPeriod = 1UL;
+            ulDynamicTickCountsAtStart = ulTimerCountsForOneTick;
+            ulDynamicTickCountsBeforeStart = 0UL;
+            ulDynamicTicksStepped = 0UL;
+
+            /* xTaskStepTickDynamic() does not move the tick count while the
+             * scheduler is suspended, in which case each tick is pended. */
+            while( ulTicksToProcess > 0UL )
+            {
+                if( xTaskIncrementTick() != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+
+                ulTicksToProcess--;
+            }
+
+            xDynamicTickInHandler = pdFALSE;
+
+            /* Generate the next interrupt when the kernel next needs it. */
+            prvDynamicTickReprogram();
+
+            if( xSwitchRequired != pdFALSE )
+            {
+                /* A context switch is required.  Context switching is performed in
+                 * the PendSV interrupt.  Pend the PendSV interrupt. */
+                portNVIC_INT_CTRL_REG = portNVIC_PENDSVSET_BIT;
+            }
+        }
+
+        vPortClearBASEPRIFromISR();
+
+        #if ( configTICK_UNBLOCK_LIMIT > 0 )
+        {
+            /* xTaskUnblockDeferred() reprograms the SysTick for the next
+             * event once the last of the due tasks has been moved. */
+            prvTickUnblockDeferred();
+        }
+        #endif
+    }
+/*-----------------------------------------------------------*/
+
+    static uint32_t prvDynamicTickElapsedCounts( void )
+    {
+        uint32_t ulCurrentValue = portNVIC_SYSTICK_CURRENT_VALUE_REG;
+
+        /* The SysTick reads ( LOAD + 1 ) - n once it has counted n times since
+         * it was started or reloaded, and reads 0 for the one count after it
+         * reaches the end of a period and before it reloads.  With the tick
+         * interrupt not pending that can only be seen when the tick interrupt
+         * is taken immediately, at the very start of the next period. */
+        if( ulCurrentValue == 0UL )
+        {
+            ulCurrentValue = ulDynamicTickCountsAtStart;
+        }
+
+        return ulDynamicTickCountsBeforeStart + ( ulDynamicTickCountsAtStart - ulCurrentValue );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvDynamicTickStep( void )
+    {
+        uint32_t ulElapsedTicks;
+
+        if( ( portNVIC_INT_CTRL_REG & portNVIC_PEND_SYSTICK_SET_BIT ) != 0 )
+        {
+            /* The period has ended but the tick interrupt has not executed yet.
+             * Leave the last tick of the period for the tick interrupt. */
+            ulElapsedTicks = ulDynamicTickPeriod - 1UL;
+        }
+        else
+        {
+            /* If the SysTick reloads between the pending bit being read and
+             * the current value being read, the calculation still cannot give
+             * more than ulDynamicTickPeriod - 1 ticks. */
+            ulElapsedTicks = prvDynamicTickElapsedCounts() / ulTimerCountsForOneTick;
+        }
+
+        if( ulElapsedTicks > ulDynamicTicksStepped )
+        {
+            ulDynamicTicksStepped += ( uint32_t ) xTaskStepTickDynamic( ( TickType_t ) ( ulElapsedTicks - ulDynamicTicksStepped ) );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvDynamicTickReprogram( void )
     {
-        /* Increment the RTOS tick. */
-        if( xTaskIncrementTick() != pdFALSE )
+        uint32_t ulTicksToNextEvent, ulNewPeriod, ulElapsedCounts, ulCountsLeft;
+
+        prvDynamicTickStep();
+
+        /* The period is measured from its start, the tick count from the last
+         * tick stepped.  Limit the period to what the 24-bit SysTick can time. */
+        ulTicksToNextEvent = ( uint32_t ) xTaskGetTicksToNextEvent();
+
+        if( ulTicksToNextEvent > ( xMaximumPossibleSuppressedTicks - ulDynamicTicksStepped ) )
+        {
+            ulTicksToNextEvent = xMaximumPossibleSuppressedTicks - ulDynamicTicksStepped;
+        }
+
+        ulNewPeriod = ulDynamicTicksStepped + ulTicksToNextEvent;
+
+        if( ulNewPeriod != ulDynamicTickPeriod )
+        {
+            /* Stop the SysTick momentarily.  The time the SysTick is stopped for
+             * is accounted for as best it can be, but using the tickless mode will
+             * inevitably result in some tiny drift of the time maintained by the
+             * kernel with respect to calendar time. */
+            portNVIC_SYSTICK_CTRL_REG = ( portNVIC_SYSTICK_CLK_BIT_CONFIG | portNVIC_SYSTICK_INT_BIT );
+
+            if( ( portNVIC_INT_CTRL_REG & portNVIC_PEND_SYSTICK_SET_BIT ) == 0 )
+            {
+                ulElapsedCounts = prvDynamicTickElapsedCounts();
+
+                /* The new period cannot end on a tick boundary that has
+                 * already passed. */
+                if( ulNewPeriod <= ( ulElapsedCounts / ulTimerCountsForOneTick ) )
+                {
+                    ulNewPeriod = ( ulElapsedCounts / ulTimerCountsForOneTick ) + 1UL;
+                }
+
+                ulCountsLeft = ( ulNewPeriod * ulTimerCountsForOneTick ) - ulElapsedCounts;
+
+                if( ulCountsLeft > ( ulStoppedTimerCompensation + 1UL ) )
+                {
+                    ulCountsLeft -= ulStoppedTimerCompensation;
+                }
+                else if( ulCountsLeft < 2UL )
+                {
+                    /* A reload value of 0 would stop the SysTick. */
+                    ulCountsLeft = 2UL;
+                }
+
+                /* Restart the SysTick from ulCountsLeft - 1, then set the reload
+                 * value back to a single tick period for the periods that follow
+                 * this one. */
+                portNVIC_SYSTICK_LOAD_REG = ulCountsLeft - 1UL;
+                portNVIC_SYSTICK_CURRENT_VALUE_REG = 0UL;
+                portNVIC_SYSTICK_CTRL_REG |= portNVIC_SYSTICK_ENABLE_BIT;
+                portNVIC_SYSTICK_LOAD_REG = ulTimerCountsForOneTick - 1UL;
+
+                ulDynamicTickPeriod = ulNewPeriod;
+                ulDynamicTickCountsAtStart = ulCountsLeft;
+                ulDynamicTickCountsBeforeStart = ( ulNewPeriod * ulTimerCountsForOneTick ) - ulCountsLeft;
+            }
+            else
+            {
+                /* The period ended while the kernel was deciding on a new one.
+                 * Leave the change to the tick interrupt. */
+                portNVIC_SYSTICK_CTRL_REG |= portNVIC_SYSTICK_ENABLE_BIT;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortSyncTickCount( void )
+    {
+        uint32_t ulSavedInterruptStatus;
+
+        ulSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            /* Nothing to do before the scheduler has started, or while the tick
+             * interrupt is bringing the tick count up to date itself. */
+            if( ( ulTimerCountsForOneTick != 0UL ) && ( xDynamicTickInHandler == pdFALSE ) )
+            {
+                prvDynamicTickStep();
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( ulSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortUpdateTickInterrupt( void )
+    {
+        uint32_t ulSavedInterruptStatus;
+
+        ulSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            /* The tick interrupt reprograms the SysTick itself before it exits. */
+            if( ( ulTimerCountsForOneTick != 0UL ) && ( xDynamicTickInHandler == pdFALSE ) )
+            {
+                prvDynamicTickReprogram();
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( ulSavedInterruptStatus );
+    }
+
+#endif /* configUSE_DYNAMIC_TICK */
+/*-----------------------------------------------------------*/
+
+#if ( configTICK_UNBLOCK_LIMIT > 0 )
+
+    static void prvTickUnblockDeferred( void )
+    {
+        BaseType_t xSwitchRequired = pdFALSE;
+        BaseType_t xMoreDue;
+
+        /* The tick interrupt runs at the lowest priority, the same as PendSV,
+         * so the context switch cannot happen before the last batch has been
+         * moved.  Each batch keeps interrupts masked for no longer than
+         * xTaskIncrementTick() does when configTICK_UNBLOCK_LIMIT tasks are
+         * due, and interrupts above the tick priority run between batches. */
+        do
+        {
+            vPortRaiseBASEPRI();
+            {
+                xMoreDue = xTaskUnblockDeferred( &xSwitchRequired );
+            }
+            vPortClearBASEPRIFromISR();
+        } while( xMoreDue != pdFALSE );
+
+        if( xSwitchRequired != pdFALSE )
         {
             /* A context switch is required.  Context switching is performed in
              * the PendSV interrupt.  Pend the PendSV interrupt. */
@@ -445,8 +756,22 @@ void xPortSysTickHandler( void )
         }
     }
 
-    vPortClearBASEPRIFromISR();
-}
+#endif /* configTICK_UNBLOCK_LIMIT */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TASK_BUDGETS == 1 ) || ( configUSE_CYCLIC_EXECUTIVE == 1 ) )
+
+    void vPortConfigureBudgetCounter( void )
+    {
+        /* The DWT unit is only clocked once trace is enabled in the DEMCR.  A
+         * debugger may already be using the cycle counter, so it is started
+         * without being reset - the kernel only uses differences between
+         * readings. */
+        portDEMCR_REG |= portDEMCR_TRCENA_BIT;
+        portDWT_CTRL_REG |= portDWT_CTRL_CYCCNTENA_BIT;
+    }
+
+#endif /* ( configUSE_TASK_BUDGETS == 1 ) || ( configUSE_CYCLIC_EXECUTIVE == 1 ) */
 /*-----------------------------------------------------------*/
 
 #if ( configUSE_TICKLESS_IDLE == 1 )
@@ -680,13 +1005,23 @@ void xPortSysTickHandler( void )
     __weak void vPortSetupTimerInterrupt( void )
     {
         /* Calculate the constants required to configure the tick interrupt. */
-        #if ( configUSE_TICKLESS_IDLE == 1 )
+        #if ( ( configUSE_TICKLESS_IDLE == 1 ) || ( configUSE_DYNAMIC_TICK == 1 ) )
         {
             ulTimerCountsForOneTick = ( configSYSTICK_CLOCK_HZ / configTICK_RATE_HZ );
             xMaximumPossibleSuppressedTicks = portMAX_24_BIT_NUMBER / ulTimerCountsForOneTick;
             ulStoppedTimerCompensation = portMISSED_COUNTS_FACTOR / ( configCPU_CLOCK_HZ / configSYSTICK_CLOCK_HZ );
         }
-        #endif /* configUSE_TICKLESS_IDLE */
+        #endif /* configUSE_TICKLESS_IDLE || configUSE_DYNAMIC_TICK */
+
+        #if ( configUSE_DYNAMIC_TICK == 1 )
+        {
+            /* The SysTick starts with a single tick period. */
+            ulDynamicTickPeriod = 1UL;
+            ulDynamicTickCountsAtStart = ulTimerCountsForOneTick;
+            ulDynamicTickCountsBeforeStart = 0UL;
+            ulDynamicTicksStepped = 0UL;
+        }
+        #endif /* configUSE_DYNAMIC_TICK */
 
         /* Stop and clear the SysTick. */
         portNVIC_SYSTICK_CTRL_REG = 0UL;
@@ -0,0 +1,220 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+#ifndef PORTATOMIC_H
+#define PORTATOMIC_H
+
+#ifndef ATOMIC_H
+    #error "include atomic.h instead of portatomic.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/*-----------------------------------------------------------
+ * Cortex-M3 implementation of the functions declared in atomic.h.
+ *
+ * Each function loads the value with LDREX and writes the result back with
+ * STREX, retrying if the store fails.  A store fails if anything - including
+ * any exception entry or return - broke the exclusive access since the load,
+ * so no interrupts are masked at any point.  See atomic.h for the
+ * description of each function.  Every address must be 4 byte aligned.
+ *-----------------------------------------------------------
+ */
+
+/* armcc 5.05 and later mark __ldrex() and __strex() as deprecated.  The
+ * inline assembler does not accept the exclusive instructions, so the
+ * intrinsics are still the way to reach them from C.  Suppress the warning in
+ * this file only, as CMSIS does. */
+#pragma push
+#pragma diag_suppress 3731
+
+/* portSTORE_EXCLUSIVE() evaluates to 0 if the value was stored. */
+#define portLOAD_EXCLUSIVE( pulAddress )              ( ( uint32_t ) __ldrex( pulAddress ) )
+#define portSTORE_EXCLUSIVE( pulAddress, ulValue )    ( ( uint32_t ) __strex( ( ulValue ), ( pulAddress ) ) )
+#define portCLEAR_EXCLUSIVE()                         __clrex()
+
+/*----------------------------- Swap && CAS ------------------------------*/
+
+static portFORCE_INLINE uint32_t Atomic_CompareAndSwap_u32( uint32_t volatile * pulDestination,
+                                                            uint32_t ulExchange,
+                                                            uint32_t ulComparand )
+{
+    uint32_t ulReturnValue;
+
+    for( ; ; )
+    {
+        if( portLOAD_EXCLUSIVE( pulDestination ) != ulComparand )
+        {
+            /* Nothing is stored, so release the exclusive monitor. */
+            portCLEAR_EXCLUSIVE();
+            ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
+            break;
+        }
+
+        if( portSTORE_EXCLUSIVE( pulDestination, ulExchange ) == 0U )
+        {
+            ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+            break;
+        }
+    }
+
+    return ulReturnValue;
+}
+/*-----------------------------------------------------------*/
+
+static portFORCE_INLINE void * Atomic_SwapPointers_p32( void * volatile * ppvDestination,
+                                                        void * pvExchange )
+{
+    uint32_t volatile * const pulDestination = ( uint32_t volatile * ) ppvDestination; /*lint !e9087 Pointers are 32-bit on this architecture. */
+    uint32_t ulCurrent;
+
+    do
+    {
+        ulCurrent = portLOAD_EXCLUSIVE( pulDestination );
+    } while( portSTORE_EXCLUSIVE( pulDestination, ( uint32_t ) pvExchange ) != 0U ); /*lint !e923 Pointers are 32-bit on this architecture. */
+
+    return ( void * ) ulCurrent; /*lint !e923 Pointers are 32-bit on this architecture. */
+}
+/*-----------------------------------------------------------*/
+
+static portFORCE_INLINE uint32_t Atomic_CompareAndSwapPointers_p32( void * volatile * ppvDestination,
+                                                                    void * pvExchange,
+                                                                    void * pvComparand )
+{
+    return Atomic_CompareAndSwap_u32( ( uint32_t volatile * ) ppvDestination, /*lint !e9087 !e923 Pointers are 32-bit on this architecture. */
+                                      ( uint32_t ) pvExchange,
+                                      ( uint32_t ) pvComparand );
+}
+
+/*----------------------------- Arithmetic ------------------------------*/
+
+static portFORCE_INLINE uint32_t Atomic_Add_u32( uint32_t volatile * pulAddend,
+                                                 uint32_t ulCount )
+{
+    uint32_t ulCurrent;
+
+    do
+    {
+        ulCurrent = portLOAD_EXCLUSIVE( pulAddend );
+    } while( portSTORE_EXCLUSIVE( pulAddend, ulCurrent + ulCount ) != 0U );
+
+    return ulCurrent;
+}
+/*-----------------------------------------------------------*/
+
+static portFORCE_INLINE uint32_t Atomic_Subtract_u32( uint32_t volatile * pulAddend,
+                                                      uint32_t ulCount )
+{
+    uint32_t ulCurrent;
+
+    do
+    {
+        ulCurrent = portLOAD_EXCLUSIVE( pulAddend );
+    } while( portSTORE_EXCLUSIVE( pulAddend, ulCurrent - ulCount ) != 0U );
+
+    return ulCurrent;
+}
+/*-----------------------------------------------------------*/
+
+static portFORCE_INLINE uint32_t Atomic_Increment_u32( uint32_t volatile * pulAddend )
+{
+    return Atomic_Add_u32( pulAddend, 1U );
+}
+/*-----------------------------------------------------------*/
+
+static portFORCE_INLINE uint32_t Atomic_Decrement_u32( uint32_t volatile * pulAddend )
+{
+    return Atomic_Subtract_u32( pulAddend, 1U );
+}
+
+/*----------------------------- Bitwise Logical ------------------------------*/
+
+static portFORCE_INLINE uint32_t Atomic_OR_u32( uint32_t volatile * pulDestination,
+                                                uint32_t ulValue )
+{
+    uint32_t ulCurrent;
+
+    do
+    {
+        ulCurrent = portLOAD_EXCLUSIVE( pulDestination );
+    } while( portSTORE_EXCLUSIVE( pulDestination, ulCurrent | ulValue ) != 0U );
+
+    return ulCurrent;
+}
+/*-----------------------------------------------------------*/
+
+static portFORCE_INLINE uint32_t Atomic_AND_u32( uint32_t volatile * pulDestination,
+                                                 uint32_t ulValue )
+{
+    uint32_t ulCurrent;
+
+    do
+    {
+        ulCurrent = portLOAD_EXCLUSIVE( pulDestination );
+    } while( portSTORE_EXCLUSIVE( pulDestination, ulCurrent & ulValue ) != 0U );
+
+    return ulCurrent;
+}
+/*-----------------------------------------------------------*/
+
+static portFORCE_INLINE uint32_t Atomic_NAND_u32( uint32_t volatile * pulDestination,
+                                                  uint32_t ulValue )
+{
+    uint32_t ulCurrent;
+
+    do
+    {
+        ulCurrent = portLOAD_EXCLUSIVE( pulDestination );
+    } while( portSTORE_EXCLUSIVE( pulDestination, ~( ulCurrent & ulValue ) ) != 0U );
+
+    return ulCurrent;
+}
+/*-----------------------------------------------------------*/
+
+static portFORCE_INLINE uint32_t Atomic_XOR_u32( uint32_t volatile * pulDestination,
+                                                 uint32_t ulValue )
+{
+    uint32_t ulCurrent;
+
+    do
+    {
+        ulCurrent = portLOAD_EXCLUSIVE( pulDestination );
+    } while( portSTORE_EXCLUSIVE( pulDestination, ulCurrent ^ ulValue ) != 0U );
+
+    return ulCurrent;
+}
+
+#pragma pop
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* PORTATOMIC_H */
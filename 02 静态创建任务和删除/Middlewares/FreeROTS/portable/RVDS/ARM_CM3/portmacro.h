@@ -80,6 +80,19 @@
 /* Constants used with memory barrier intrinsics. */
     #define portSY_FULL_READ_WRITE    ( 15 )
 
+/* Orders memory accesses for code that shares data with interrupts without a
+ * critical section, such as the rings in spscring.c.  A single core Cortex-M3
+ * does not strictly need the DMB, but it is also a compiler barrier and keeps
+ * the code within the architecture's specified behaviour. */
+    #define portMEMORY_BARRIER()      __dmb( portSY_FULL_READ_WRITE )
+
+/* The functions in atomic.h use the exclusive load and store instructions
+ * (see portatomic.h) instead of masking interrupts.  FreeRTOSConfig.h can set
+ * it to 0 to use the generic functions, to compare the two. */
+    #ifndef portHAS_NATIVE_ATOMICS
+        #define portHAS_NATIVE_ATOMICS    1
+    #endif
+
 /*-----------------------------------------------------------*/
 
 /* Scheduler utilities. */
@@ -121,6 +134,34 @@
     #endif
 /*-----------------------------------------------------------*/
 
+/* Dynamic tick functionality. */
+    #if ( configUSE_DYNAMIC_TICK == 1 )
+        extern void vPortSyncTickCount( void );
+        extern void vPortUpdateTickInterrupt( void );
+        #define portSYNC_TICK_COUNT()          vPortSyncTickCount()
+        #define portUPDATE_TICK_INTERRUPT()    vPortUpdateTickInterrupt()
+    #endif
+/*-----------------------------------------------------------*/
+
+/* Bounded tick interrupt functionality.  xPortSysTickHandler() moves tasks
+ * that xTaskIncrementTick() left due in batches, with interrupts unmasked
+ * between them. */
+    #if ( configTICK_UNBLOCK_LIMIT > 0 )
+        #define portTICK_UNBLOCK_DEFERRED    1
+    #endif
+/*-----------------------------------------------------------*/
+
+/* Task execution time budget and cyclic executive slot statistics
+ * functionality.  Execution time is measured in core clock cycles using the DWT
+ * cycle counter. */
+    #if ( ( configUSE_TASK_BUDGETS == 1 ) || ( configUSE_CYCLIC_EXECUTIVE == 1 ) )
+        extern void vPortConfigureBudgetCounter( void );
+        #define portDWT_CYCCNT_REG                ( *( ( volatile uint32_t * ) 0xe0001004 ) )
+        #define portCONFIGURE_BUDGET_COUNTER()    vPortConfigureBudgetCounter()
+        #define portGET_BUDGET_COUNTER_VALUE()    ( portDWT_CYCCNT_REG )
+    #endif
+/*-----------------------------------------------------------*/
+
 /* Port specific optimisations. */
     #ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
         #define configUSE_PORT_OPTIMISED_TASK_SELECTION    1
@@ -129,11 +170,13 @@
     #if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
 
 /* Check the configuration. */
-        #if ( configMAX_PRIORITIES > 32 )
-            #error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 32.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
+        #if ( configMAX_PRIORITIES > 1024 )
+            #error configUSE_PORT_OPTIMISED_TASK_SELECTION can only be set to 1 when configMAX_PRIORITIES is less than or equal to 1024.  It is very rare that a system requires more than 10 to 15 difference priorities as tasks that share a priority will time slice.
         #endif
 
-/* Store/clear the ready priorities in a bit map. */
+/* Store/clear the ready priorities in a bit map.  The macros operate on a
+ * single 32-bit word; when configMAX_PRIORITIES is above 32 the kernel uses
+ * them on each level of a two level bit map. */
         #define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities )    ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
         #define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )     ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
 
@@ -165,10 +208,27 @@
         #define portFORCE_INLINE    __forceinline
     #endif
 
+/* Called with interrupts masked each time BASEPRI is raised, even if it was
+ * already raised, and each time it is set back to 0, so FreeRTOSConfig.h can
+ * define them to time how long interrupts stay masked.  The masking done in
+ * the assembly of xPortPendSVHandler() and vPortSVCHandler() is not seen. */
+    #ifndef traceBASEPRI_RAISED
+        #define traceBASEPRI_RAISED()
+    #endif
+
+    #ifndef traceBASEPRI_CLEARED
+        #define traceBASEPRI_CLEARED()
+    #endif
+
 /*-----------------------------------------------------------*/
 
     static portFORCE_INLINE void vPortSetBASEPRI( uint32_t ulBASEPRI )
     {
+        if( ulBASEPRI == 0U )
+        {
+            traceBASEPRI_CLEARED();
+        }
+
         __asm
         {
             /* Barrier instructions are not used as this function is only used to
@@ -194,11 +254,15 @@
             isb
 /* *INDENT-ON* */
         }
+
+        traceBASEPRI_RAISED();
     }
 /*-----------------------------------------------------------*/
 
     static portFORCE_INLINE void vPortClearBASEPRIFromISR( void )
     {
+        traceBASEPRI_CLEARED();
+
         __asm
         {
             /* Set BASEPRI to 0 so no interrupts are masked.  This function is only
@@ -227,6 +291,8 @@
 /* *INDENT-ON* */
         }
 
+        traceBASEPRI_RAISED();
+
         return ulReturn;
     }
 /*-----------------------------------------------------------*/
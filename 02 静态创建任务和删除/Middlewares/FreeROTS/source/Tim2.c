@@ -8,12 +8,15 @@
  *   - TIM2配置为1ms中断间隔
  *   - 优先级设置为15，不高于FreeRTOS内核优先级
  *   - 提供系统Tick时钟支持
+ *   - SYS_SUPPORT_OS与SYS_HAL_TICK_USE_OS均为1时HAL时基改由SysTick/FreeRTOS节拍提供，TIM2不再初始化，可另作他用
  */
 
 #include "./FreeROTS/source/Tim2.h"
 
+#if !(SYS_SUPPORT_OS && SYS_HAL_TICK_USE_OS)
 /* TIM2句柄定义 */
 TIM_HandleTypeDef htim2;
+#endif
 
 /**
  * @brief   错误处理函数
@@ -33,6 +36,7 @@ void Error_Handler(void)
     }
 }
 
+#if !(SYS_SUPPORT_OS && SYS_HAL_TICK_USE_OS)
 /**
  * @brief   TIM2初始化函数
  * @param   void
@@ -111,14 +115,15 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
         HAL_IncTick();
     }
 }
+#endif
 
 /**
  * @brief   HAL库Tick初始化函数
  * @param   TickPriority: 中断优先级（此处未使用）
  * @return  HAL_StatusTypeDef: 初始化状态
  * @note    
- *   - 告知HAL库由TIM2提供系统时基
- *   - 防止HAL库使用SysTick
+ *   - 告知HAL库时基已由外部提供(TIM2或与FreeRTOS共用的SysTick)
+ *   - 防止HAL库重新配置SysTick，SysTick统一由delay_init()和FreeRTOS配置
  */
 HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
 {
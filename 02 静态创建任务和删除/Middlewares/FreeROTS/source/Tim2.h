@@ -2,12 +2,15 @@
 #define __TIM2_H
 
 #include "stm32f1xx_hal.h"
+#include "./SYSTEM/sys/sys.h"
 #include "FreeRTOS.h"
 #include "task.h"
 
+#if !(SYS_SUPPORT_OS && SYS_HAL_TICK_USE_OS)
 extern TIM_HandleTypeDef htim2;
 
 void MX_TIM2_Init(void);
+#endif
 
 #endif /* __TIM2_H */
 
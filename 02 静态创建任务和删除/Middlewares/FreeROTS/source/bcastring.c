@@ -0,0 +1,533 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "bcastring.h"
+
+/* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e9021 !e961 !e750. */
+
+
+/* This entire source file will be skipped if the application is not configured
+ * to include broadcast rings.  This #if is closed at the very bottom of this
+ * file.  If you want to include the rings then ensure configUSE_BROADCAST_RINGS
+ * is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_BROADCAST_RINGS == 1 )
+
+/*
+ * The items are held once, at the index given by the head of the ring, and
+ * each reader keeps its own tail index and count of unread items.  Sending an
+ * item therefore only has to walk the readers to count it - and to discard an
+ * item for any drop oldest reader that has the ring full - rather than copy it
+ * once per reader.  All the indices and counts are updated, and items copied,
+ * inside a critical section, as queues do, so readers and the producer can be
+ * preempted by each other at any point.
+ */
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns pdTRUE if a reader added with the eBroadcastBackPressure policy has
+ * the ring full, in which case no item can be sent.  Called with interrupts
+ * masked.
+ */
+    static BaseType_t prvBlockedByReader( const BroadcastRing_t * pxRing ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies an item onto the ring for every reader and wakes any reader blocked
+ * waiting for one.  pxHigherPriorityTaskWoken is NULL when called from a task.
+ * Called with interrupts masked after prvBlockedByReader() returned pdFALSE.
+ */
+    static void prvWriteItem( BroadcastRing_t * const pxRing,
+                              const void * pvItem,
+                              BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the index that follows uxIndex in a ring of uxLength items.
+ */
+    static UBaseType_t prvNextIndex( UBaseType_t uxIndex,
+                                     UBaseType_t uxLength ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    BroadcastRingHandle_t xBroadcastRingCreateStatic( UBaseType_t uxLength,
+                                                      size_t xItemSize,
+                                                      uint8_t * pucStorage,
+                                                      BroadcastRing_t * pxRingBuffer )
+    {
+        BroadcastRing_t * pxReturn = NULL;
+
+        configASSERT( uxLength > ( UBaseType_t ) 0U );
+        configASSERT( xItemSize > ( size_t ) 0U );
+        configASSERT( pucStorage != NULL );
+        configASSERT( pxRingBuffer != NULL );
+
+        if( ( pucStorage != NULL ) && ( pxRingBuffer != NULL ) )
+        {
+            pxRingBuffer->pxReaders = NULL;
+            pxRingBuffer->uxHead = ( UBaseType_t ) 0U;
+            pxRingBuffer->uxLength = uxLength;
+            pxRingBuffer->xItemSize = xItemSize;
+            pxRingBuffer->pucStorage = pucStorage;
+            pxRingBuffer->xTaskWaitingToSend = NULL;
+
+            pxReturn = pxRingBuffer;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        BroadcastRingHandle_t xBroadcastRingCreate( UBaseType_t uxLength,
+                                                    size_t xItemSize )
+        {
+            BroadcastRing_t * pxReturn = NULL;
+            uint8_t * pucAllocation;
+
+            /* The control block and storage are allocated together, with the
+             * storage after the control block.  Items are copied with memcpy()
+             * so the storage needs no particular alignment. */
+            pucAllocation = ( uint8_t * ) pvPortMalloc( sizeof( BroadcastRing_t ) + bcastringSTORAGE_SIZE( uxLength, xItemSize ) ); /*lint !e9087 !e9079 see comment above. */
+
+            if( pucAllocation != NULL )
+            {
+                pxReturn = xBroadcastRingCreateStatic( uxLength, xItemSize, &( pucAllocation[ sizeof( BroadcastRing_t ) ] ), ( BroadcastRing_t * ) pucAllocation ); /*lint !e9087 !e826 The allocation is aligned for the control block. */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return pxReturn;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    BroadcastReaderHandle_t xBroadcastRingAddReader( BroadcastRingHandle_t xRing,
+                                                     eBroadcastPolicy ePolicy,
+                                                     BroadcastReader_t * pxReaderBuffer )
+    {
+        BroadcastReader_t * pxReturn = NULL;
+
+        configASSERT( xRing );
+        configASSERT( ( ePolicy == eBroadcastDropOldest ) || ( ePolicy == eBroadcastBackPressure ) );
+        configASSERT( pxReaderBuffer != NULL );
+
+        if( pxReaderBuffer != NULL )
+        {
+            pxReaderBuffer->pxRing = xRing;
+            pxReaderBuffer->uxWaiting = ( UBaseType_t ) 0U;
+            pxReaderBuffer->uxOverruns = ( UBaseType_t ) 0U;
+            pxReaderBuffer->ePolicy = ePolicy;
+            pxReaderBuffer->xTaskWaiting = NULL;
+
+            taskENTER_CRITICAL();
+            {
+                /* The reader starts with nothing to read, so its tail is the
+                 * current head. */
+                pxReaderBuffer->uxTail = xRing->uxHead;
+                pxReaderBuffer->pxNext = xRing->pxReaders;
+                xRing->pxReaders = pxReaderBuffer;
+            }
+            taskEXIT_CRITICAL();
+
+            pxReturn = pxReaderBuffer;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vBroadcastRingRemoveReader( BroadcastReaderHandle_t xReader )
+    {
+        BroadcastRing_t * pxRing;
+        BroadcastReader_t ** ppxLink;
+
+        configASSERT( xReader );
+        configASSERT( xReader->xTaskWaiting == NULL );
+
+        pxRing = xReader->pxRing;
+
+        taskENTER_CRITICAL();
+        {
+            for( ppxLink = &( pxRing->pxReaders ); *ppxLink != NULL; ppxLink = &( ( *ppxLink )->pxNext ) )
+            {
+                if( *ppxLink == xReader )
+                {
+                    *ppxLink = xReader->pxNext;
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            /* The producer may have been waiting for this reader.  If it was
+             * waiting for another reader too it just checks again and goes
+             * back to waiting. */
+            if( pxRing->xTaskWaitingToSend != NULL )
+            {
+                ( void ) xTaskNotify( pxRing->xTaskWaitingToSend, ( uint32_t ) 0, eNoAction );
+                pxRing->xTaskWaitingToSend = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        xReader->pxRing = NULL;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xBroadcastRingSend( BroadcastRingHandle_t xRing,
+                                   const void * pvItem,
+                                   TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn = pdFAIL;
+        TimeOut_t xTimeOut;
+
+        configASSERT( xRing );
+        configASSERT( pvItem != NULL );
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( prvBlockedByReader( xRing ) == pdFALSE )
+                {
+                    prvWriteItem( xRing, pvItem, NULL );
+                    xReturn = pdPASS;
+                }
+                else if( xTicksToWait != ( TickType_t ) 0 )
+                {
+                    /* Registered inside the same critical section as the
+                     * check, so a reader that reads an item after the check
+                     * sees the registration and gives the notification. */
+                    xRing->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( ( xReturn == pdPASS ) || ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE ) )
+            {
+                break;
+            }
+            else
+            {
+                /* The notification value is left unchanged, as stream
+                 * buffers leave it.  A notification left over from an earlier
+                 * wake only causes one extra pass round the loop. */
+                ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            }
+        }
+
+        xRing->xTaskWaitingToSend = NULL;
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xBroadcastRingSendFromISR( BroadcastRingHandle_t xRing,
+                                          const void * pvItem,
+                                          BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        BaseType_t xReturn = pdFAIL;
+        UBaseType_t uxSavedInterruptStatus;
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+        configASSERT( xRing );
+        configASSERT( pvItem != NULL );
+
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            if( prvBlockedByReader( xRing ) == pdFALSE )
+            {
+                prvWriteItem( xRing, pvItem, &xHigherPriorityTaskWoken );
+                xReturn = pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        if( pxHigherPriorityTaskWoken != NULL )
+        {
+            if( xHigherPriorityTaskWoken != pdFALSE )
+            {
+                *pxHigherPriorityTaskWoken = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xBroadcastRingReceive( BroadcastReaderHandle_t xReader,
+                                      void * pvBuffer,
+                                      TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn = pdFAIL;
+        BroadcastRing_t * pxRing;
+        TimeOut_t xTimeOut;
+
+        configASSERT( xReader );
+        configASSERT( xReader->pxRing != NULL );
+        configASSERT( pvBuffer != NULL );
+
+        pxRing = xReader->pxRing;
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( xReader->uxWaiting > ( UBaseType_t ) 0U )
+                {
+                    ( void ) memcpy( pvBuffer, ( const void * ) &( pxRing->pucStorage[ ( size_t ) xReader->uxTail * pxRing->xItemSize ] ), pxRing->xItemSize ); /*lint !e961 !e418 !e9087 Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+
+                    xReader->uxTail = prvNextIndex( xReader->uxTail, pxRing->uxLength );
+
+                    /* Only a back-pressure reader that had the ring full can
+                     * be what the producer is waiting for. */
+                    if( ( xReader->ePolicy == eBroadcastBackPressure ) &&
+                        ( xReader->uxWaiting == pxRing->uxLength ) &&
+                        ( pxRing->xTaskWaitingToSend != NULL ) )
+                    {
+                        ( void ) xTaskNotify( pxRing->xTaskWaitingToSend, ( uint32_t ) 0, eNoAction );
+                        pxRing->xTaskWaitingToSend = NULL;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    ( xReader->uxWaiting )--;
+                    xReturn = pdPASS;
+                }
+                else if( xTicksToWait != ( TickType_t ) 0 )
+                {
+                    /* Registered inside the same critical section as the
+                     * check, so the producer sees the registration for any
+                     * item sent after the check. */
+                    xReader->xTaskWaiting = xTaskGetCurrentTaskHandle();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( ( xReturn == pdPASS ) || ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE ) )
+            {
+                break;
+            }
+            else
+            {
+                /* The notification value is left unchanged, as stream
+                 * buffers leave it.  A notification left over from an earlier
+                 * wake only causes one extra pass round the loop. */
+                ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            }
+        }
+
+        xReader->xTaskWaiting = NULL;
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxBroadcastRingItemsWaiting( BroadcastReaderHandle_t xReader )
+    {
+        configASSERT( xReader );
+
+        return xReader->uxWaiting;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxBroadcastRingGetOverruns( BroadcastReaderHandle_t xReader,
+                                            BaseType_t xClear )
+    {
+        UBaseType_t uxOverruns;
+
+        configASSERT( xReader );
+
+        taskENTER_CRITICAL();
+        {
+            uxOverruns = xReader->uxOverruns;
+
+            if( xClear != pdFALSE )
+            {
+                xReader->uxOverruns = ( UBaseType_t ) 0U;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return uxOverruns;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvBlockedByReader( const BroadcastRing_t * pxRing )
+    {
+        const BroadcastReader_t * pxReader;
+        BaseType_t xReturn = pdFALSE;
+
+        for( pxReader = pxRing->pxReaders; pxReader != NULL; pxReader = pxReader->pxNext )
+        {
+            if( ( pxReader->ePolicy == eBroadcastBackPressure ) && ( pxReader->uxWaiting == pxRing->uxLength ) )
+            {
+                xReturn = pdTRUE;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvWriteItem( BroadcastRing_t * const pxRing,
+                              const void * pvItem,
+                              BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        BroadcastReader_t * pxReader;
+        TaskHandle_t xTaskWaiting;
+
+        ( void ) memcpy( ( void * ) &( pxRing->pucStorage[ ( size_t ) pxRing->uxHead * pxRing->xItemSize ] ), pvItem, pxRing->xItemSize ); /*lint !e961 !e418 !e9087 Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        pxRing->uxHead = prvNextIndex( pxRing->uxHead, pxRing->uxLength );
+
+        for( pxReader = pxRing->pxReaders; pxReader != NULL; pxReader = pxReader->pxNext )
+        {
+            if( pxReader->uxWaiting == pxRing->uxLength )
+            {
+                /* The new item has overwritten the oldest item this reader
+                 * had not read, so it now starts one item later.  Only a drop
+                 * oldest reader can have the ring full here. */
+                configASSERT( pxReader->ePolicy == eBroadcastDropOldest );
+                pxReader->uxTail = prvNextIndex( pxReader->uxTail, pxRing->uxLength );
+                ( pxReader->uxOverruns )++;
+            }
+            else
+            {
+                ( pxReader->uxWaiting )++;
+            }
+
+            xTaskWaiting = pxReader->xTaskWaiting;
+
+            if( xTaskWaiting != NULL )
+            {
+                /* Clear the registration so a burst of items only wakes the
+                 * reader once. */
+                pxReader->xTaskWaiting = NULL;
+
+                if( pxHigherPriorityTaskWoken == NULL )
+                {
+                    ( void ) xTaskNotify( xTaskWaiting, ( uint32_t ) 0, eNoAction );
+                }
+                else
+                {
+                    ( void ) xTaskNotifyFromISR( xTaskWaiting, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvNextIndex( UBaseType_t uxIndex,
+                                     UBaseType_t uxLength )
+    {
+        UBaseType_t uxNextIndex = uxIndex + ( UBaseType_t ) 1U;
+
+        if( uxNextIndex == uxLength )
+        {
+            uxNextIndex = ( UBaseType_t ) 0U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxNextIndex;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include broadcast rings.  If you want to include the rings then ensure
+ * configUSE_BROADCAST_RINGS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_BROADCAST_RINGS == 1 */
@@ -0,0 +1,460 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "atomic.h"
+#include "cyclic.h"
+
+/* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e9021 !e961 !e750. */
+
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the cyclic executive.  This #if is closed at the very bottom of
+ * this file.  If you want to include the cyclic executive then ensure
+ * configUSE_CYCLIC_EXECUTIVE is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_CYCLIC_EXECUTIVE == 1 )
+
+/* The name assigned to the executive task.  This can be overridden by defining
+ * configCYCLIC_EXECUTIVE_TASK_NAME in FreeRTOSConfig.h. */
+    #ifndef configCYCLIC_EXECUTIVE_TASK_NAME
+        #define configCYCLIC_EXECUTIVE_TASK_NAME    "Cyclic"
+    #endif
+
+/*lint -save -e956 A manual analysis and inspection has been used to determine
+ * which static variables must be declared volatile. */
+
+/* The schedule being dispatched, or NULL if no executive has been created. */
+    PRIVILEGED_DATA static const CyclicSchedule_t * volatile pxCyclicSchedule = NULL;
+
+/* The number of minor frames that have overrun. */
+    PRIVILEGED_DATA static volatile uint32_t ulCyclicFrameOverruns = 0U;
+
+/*lint -restore */
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Checks pxSchedule, claims the single executive for it and clears its
+ * statistics.  Returns pdFAIL if an executive already exists.
+ */
+    static BaseType_t prvCyclicExecutiveInitialise( const CyclicSchedule_t * pxSchedule ) PRIVILEGED_FUNCTION;
+
+/*
+ * The executive task itself.
+ */
+    static portTASK_FUNCTION_PROTO( prvCyclicExecutiveTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Calls the functions of every slot in the minor frame of slot *puxSlot,
+ * starting with that slot, and leaves *puxSlot indexing the first slot of the
+ * following frame.
+ */
+    static void prvCyclicRunFrame( const CyclicSchedule_t * pxSchedule,
+                                   UBaseType_t * puxSlot ) PRIVILEGED_FUNCTION;
+
+/*
+ * Marks every slot in the minor frame of slot *puxSlot as skipped, and leaves
+ * *puxSlot indexing the first slot of the following frame.
+ */
+    static void prvCyclicSkipFrame( const CyclicSchedule_t * pxSchedule,
+                                    UBaseType_t * puxSlot ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        BaseType_t xCyclicExecutiveCreate( const CyclicSchedule_t * pxSchedule,
+                                           UBaseType_t uxPriority,
+                                           const configSTACK_DEPTH_TYPE usStackDepth )
+        {
+            BaseType_t xReturn;
+
+            xReturn = prvCyclicExecutiveInitialise( pxSchedule );
+
+            if( xReturn == pdPASS )
+            {
+                xReturn = xTaskCreate( prvCyclicExecutiveTask,
+                                       configCYCLIC_EXECUTIVE_TASK_NAME,
+                                       usStackDepth,
+                                       ( void * ) pxSchedule, /*lint !e9005 The schedule is not written to, the cast is required by the task function prototype. */
+                                       uxPriority,
+                                       NULL );
+
+                if( xReturn != pdPASS )
+                {
+                    /* Release the executive so creation can be retried. */
+                    pxCyclicSchedule = NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xReturn;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        TaskHandle_t xCyclicExecutiveCreateStatic( const CyclicSchedule_t * pxSchedule,
+                                                   UBaseType_t uxPriority,
+                                                   const uint32_t ulStackDepth,
+                                                   StackType_t * const puxStackBuffer,
+                                                   StaticTask_t * const pxTaskBuffer )
+        {
+            TaskHandle_t xReturn = NULL;
+
+            configASSERT( puxStackBuffer != NULL );
+            configASSERT( pxTaskBuffer != NULL );
+
+            if( ( puxStackBuffer != NULL ) && ( pxTaskBuffer != NULL ) )
+            {
+                if( prvCyclicExecutiveInitialise( pxSchedule ) == pdPASS )
+                {
+                    xReturn = xTaskCreateStatic( prvCyclicExecutiveTask,
+                                                 configCYCLIC_EXECUTIVE_TASK_NAME,
+                                                 ulStackDepth,
+                                                 ( void * ) pxSchedule, /*lint !e9005 The schedule is not written to, the cast is required by the task function prototype. */
+                                                 uxPriority,
+                                                 puxStackBuffer,
+                                                 pxTaskBuffer );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xReturn;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvCyclicExecutiveInitialise( const CyclicSchedule_t * pxSchedule )
+    {
+        BaseType_t xReturn = pdFAIL;
+        UBaseType_t uxSlot;
+
+        configASSERT( pxSchedule != NULL );
+        configASSERT( pxSchedule->pxSlots != NULL );
+        configASSERT( pxSchedule->uxNumberOfSlots > ( UBaseType_t ) 0U );
+        configASSERT( pxSchedule->xMinorFramePeriod > ( TickType_t ) 0U );
+        configASSERT( pxSchedule->uxMinorFramesPerMajorFrame > ( UBaseType_t ) 0U );
+
+        /* The major frame must fit in half the tick range so frame start times
+         * can be compared across a tick count overflow. */
+        configASSERT( ( pxSchedule->xMinorFramePeriod * ( TickType_t ) pxSchedule->uxMinorFramesPerMajorFrame ) / ( TickType_t ) pxSchedule->uxMinorFramesPerMajorFrame == pxSchedule->xMinorFramePeriod );
+        configASSERT( ( pxSchedule->xMinorFramePeriod * ( TickType_t ) pxSchedule->uxMinorFramesPerMajorFrame ) <= ( portMAX_DELAY >> 1 ) );
+
+        /* The executive walks the table in order, so the slots must be sorted
+         * by minor frame, and every frame must lie within the major frame. */
+        for( uxSlot = ( UBaseType_t ) 0U; uxSlot < pxSchedule->uxNumberOfSlots; uxSlot++ )
+        {
+            configASSERT( pxSchedule->pxSlots[ uxSlot ].pxFunction != NULL );
+            configASSERT( pxSchedule->pxSlots[ uxSlot ].uxMinorFrame < pxSchedule->uxMinorFramesPerMajorFrame );
+            configASSERT( ( uxSlot == ( UBaseType_t ) 0U ) || ( pxSchedule->pxSlots[ uxSlot - 1U ].uxMinorFrame <= pxSchedule->pxSlots[ uxSlot ].uxMinorFrame ) );
+        }
+
+        taskENTER_CRITICAL();
+        {
+            if( pxCyclicSchedule == NULL )
+            {
+                pxCyclicSchedule = pxSchedule;
+                ulCyclicFrameOverruns = 0U;
+                xReturn = pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( ( xReturn == pdPASS ) && ( pxSchedule->pxSlotStats != NULL ) )
+        {
+            for( uxSlot = ( UBaseType_t ) 0U; uxSlot < pxSchedule->uxNumberOfSlots; uxSlot++ )
+            {
+                pxSchedule->pxSlotStats[ uxSlot ].ulRuns = 0U;
+                pxSchedule->pxSlotStats[ uxSlot ].ulSkips = 0U;
+                pxSchedule->pxSlotStats[ uxSlot ].ulLastTime = 0U;
+                pxSchedule->pxSlotStats[ uxSlot ].ulMinTime = ( uint32_t ) 0xffffffffUL;
+                pxSchedule->pxSlotStats[ uxSlot ].ulMaxTime = 0U;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static portTASK_FUNCTION( prvCyclicExecutiveTask, pvParameters )
+    {
+        const CyclicSchedule_t * const pxSchedule = ( const CyclicSchedule_t * ) pvParameters;
+        const TickType_t xMajorFramePeriod = pxSchedule->xMinorFramePeriod * ( TickType_t ) pxSchedule->uxMinorFramesPerMajorFrame;
+        TickType_t xMajorFrameStart, xFrameStart, xNextFrameStart;
+        UBaseType_t uxSlot = ( UBaseType_t ) 0U;
+        BaseType_t xOverrun;
+
+        #if ( configUSE_CYCLIC_OVERRUN_HOOK == 1 )
+            UBaseType_t uxMinorFrame;
+        #endif
+
+        portCONFIGURE_BUDGET_COUNTER();
+
+        /* The first major frame starts now.  Every later frame start is a
+         * fixed offset from here, so the time taken to run the slots cannot
+         * make the schedule drift. */
+        xMajorFrameStart = xTaskGetTickCount();
+        xFrameStart = xMajorFrameStart;
+
+        #if ( configUSE_CYCLIC_OVERRUN_HOOK == 1 )
+        {
+            uxMinorFrame = pxSchedule->pxSlots[ uxSlot ].uxMinorFrame;
+        }
+        #endif
+
+        for( ; ; )
+        {
+            /* Block until the next frame that has slots starts.  If it has
+             * started already the frame just run has overrun, and frames are
+             * skipped until one is found that has not started yet. */
+            xOverrun = pdFALSE;
+
+            for( ; ; )
+            {
+                xNextFrameStart = xMajorFrameStart + ( pxSchedule->xMinorFramePeriod * ( TickType_t ) pxSchedule->pxSlots[ uxSlot ].uxMinorFrame );
+
+                if( xNextFrameStart == xFrameStart )
+                {
+                    /* Only possible on entry, when the first slot is in
+                     * minor frame 0, which starts now. */
+                    break;
+                }
+
+                if( xTaskDelayUntil( &xFrameStart, xNextFrameStart - xFrameStart ) != pdFALSE )
+                {
+                    break;
+                }
+
+                if( xOverrun == pdFALSE )
+                {
+                    xOverrun = pdTRUE;
+                    ulCyclicFrameOverruns++;
+
+                    #if ( configUSE_CYCLIC_OVERRUN_HOOK == 1 )
+                    {
+                        vApplicationCyclicOverrunHook( uxMinorFrame );
+                    }
+                    #endif
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                prvCyclicSkipFrame( pxSchedule, &uxSlot );
+
+                if( uxSlot == ( UBaseType_t ) 0U )
+                {
+                    xMajorFrameStart += xMajorFramePeriod;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            #if ( configUSE_CYCLIC_OVERRUN_HOOK == 1 )
+            {
+                uxMinorFrame = pxSchedule->pxSlots[ uxSlot ].uxMinorFrame;
+            }
+            #endif
+
+            prvCyclicRunFrame( pxSchedule, &uxSlot );
+
+            if( uxSlot == ( UBaseType_t ) 0U )
+            {
+                xMajorFrameStart += xMajorFramePeriod;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCyclicRunFrame( const CyclicSchedule_t * pxSchedule,
+                                   UBaseType_t * puxSlot )
+    {
+        const CyclicSlot_t * pxSlot;
+        CyclicSlotStats_t * pxStats;
+        UBaseType_t uxSlot = *puxSlot;
+        const UBaseType_t uxMinorFrame = pxSchedule->pxSlots[ uxSlot ].uxMinorFrame;
+        uint32_t ulStartTime, ulTime;
+
+        do
+        {
+            pxSlot = &( pxSchedule->pxSlots[ uxSlot ] );
+
+            ulStartTime = portGET_BUDGET_COUNTER_VALUE();
+            pxSlot->pxFunction( pxSlot->pvParameters );
+            ulTime = portGET_BUDGET_COUNTER_VALUE() - ulStartTime;
+
+            if( pxSchedule->pxSlotStats != NULL )
+            {
+                pxStats = &( pxSchedule->pxSlotStats[ uxSlot ] );
+
+                /* xCyclicExecutiveGetSlotStats() reads the statistics in a
+                 * critical section, so update them in one too. */
+                taskENTER_CRITICAL();
+                {
+                    pxStats->ulRuns++;
+                    pxStats->ulLastTime = ulTime;
+
+                    if( ulTime < pxStats->ulMinTime )
+                    {
+                        pxStats->ulMinTime = ulTime;
+                    }
+
+                    if( ulTime > pxStats->ulMaxTime )
+                    {
+                        pxStats->ulMaxTime = ulTime;
+                    }
+                }
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            uxSlot++;
+
+            if( uxSlot == pxSchedule->uxNumberOfSlots )
+            {
+                uxSlot = ( UBaseType_t ) 0U;
+            }
+        } while( ( uxSlot != ( UBaseType_t ) 0U ) && ( pxSchedule->pxSlots[ uxSlot ].uxMinorFrame == uxMinorFrame ) );
+
+        *puxSlot = uxSlot;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCyclicSkipFrame( const CyclicSchedule_t * pxSchedule,
+                                    UBaseType_t * puxSlot )
+    {
+        UBaseType_t uxSlot = *puxSlot;
+        const UBaseType_t uxMinorFrame = pxSchedule->pxSlots[ uxSlot ].uxMinorFrame;
+
+        do
+        {
+            if( pxSchedule->pxSlotStats != NULL )
+            {
+                /* A single counter, so it only needs to be updated
+                 * atomically to be consistent with the copy taken by
+                 * xCyclicExecutiveGetSlotStats(). */
+                ( void ) Atomic_Increment_u32( &( pxSchedule->pxSlotStats[ uxSlot ].ulSkips ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            uxSlot++;
+
+            if( uxSlot == pxSchedule->uxNumberOfSlots )
+            {
+                uxSlot = ( UBaseType_t ) 0U;
+            }
+        } while( ( uxSlot != ( UBaseType_t ) 0U ) && ( pxSchedule->pxSlots[ uxSlot ].uxMinorFrame == uxMinorFrame ) );
+
+        *puxSlot = uxSlot;
+    }
+/*-----------------------------------------------------------*/
+
+    uint32_t ulCyclicExecutiveGetFrameOverruns( void )
+    {
+        return ulCyclicFrameOverruns;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xCyclicExecutiveGetSlotStats( UBaseType_t uxSlot,
+                                             CyclicSlotStats_t * pxSlotStats )
+    {
+        const CyclicSchedule_t * const pxSchedule = pxCyclicSchedule;
+        BaseType_t xReturn = pdFAIL;
+
+        configASSERT( pxSlotStats != NULL );
+
+        if( ( pxSchedule != NULL ) && ( pxSchedule->pxSlotStats != NULL ) && ( uxSlot < pxSchedule->uxNumberOfSlots ) )
+        {
+            taskENTER_CRITICAL();
+            {
+                *pxSlotStats = pxSchedule->pxSlotStats[ uxSlot ];
+            }
+            taskEXIT_CRITICAL();
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the cyclic executive.  If you want to include the cyclic executive
+ * then ensure configUSE_CYCLIC_EXECUTIVE is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_CYCLIC_EXECUTIVE == 1 */
@@ -73,6 +73,12 @@ typedef struct EventGroupDef_t
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the event group is statically allocated to ensure no attempt is made to free the memory. */
     #endif
+
+    #if ( configUSE_WAITSETS == 1 )
+        TaskHandle_t xWaitSetOwner;           /*< The task that owns the waitset the event group is a member of, or NULL if the event group is not in a waitset. */
+        EventBits_t uxWaitSetBitsToWaitFor;   /*< Setting any of these bits posts to the waitset. */
+        uint32_t ulWaitSetBits;               /*< The bits posted to the waitset. */
+    #endif
 } EventGroup_t;
 
 /*-----------------------------------------------------------*/
@@ -89,6 +95,16 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
                                         const EventBits_t uxBitsToWaitFor,
                                         const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_WAITSETS == 1 )
+
+/*
+ * Checks to see if an event group is a member of a waitset, and if so, posts
+ * the bits of the event group to the task that owns the waitset.  Called with
+ * the scheduler suspended each time any of uxWaitSetBitsToWaitFor are set.
+ */
+    static void prvNotifyWaitSet( const EventGroup_t * const pxEventBits ) PRIVILEGED_FUNCTION;
+#endif
+
 /*-----------------------------------------------------------*/
 
 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -118,6 +134,14 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
             pxEventBits->uxEventBits = 0;
             vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+            #if ( configUSE_WAITSETS == 1 )
+            {
+                pxEventBits->xWaitSetOwner = NULL;
+                pxEventBits->uxWaitSetBitsToWaitFor = 0;
+                pxEventBits->ulWaitSetBits = 0UL;
+            }
+            #endif
+
             #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
             {
                 /* Both static and dynamic allocation can be used, so note that
@@ -169,6 +193,14 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
             pxEventBits->uxEventBits = 0;
             vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
 
+            #if ( configUSE_WAITSETS == 1 )
+            {
+                pxEventBits->xWaitSetOwner = NULL;
+                pxEventBits->uxWaitSetBitsToWaitFor = 0;
+                pxEventBits->ulWaitSetBits = 0UL;
+            }
+            #endif
+
             #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
             {
                 /* Both static and dynamic allocation can be used, so note this
@@ -520,11 +552,13 @@ EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup )
     EventGroup_t const * const pxEventBits = xEventGroup;
     EventBits_t uxReturn;
 
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    /* The event bits are of type TickType_t, so interrupts only need to be
+     * masked on ports that cannot read a TickType_t in a single access. */
+    uxSavedInterruptStatus = portTICK_TYPE_SET_INTERRUPT_MASK_FROM_ISR();
     {
         uxReturn = pxEventBits->uxEventBits;
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    portTICK_TYPE_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
     return uxReturn;
 } /*lint !e818 EventGroupHandle_t is a typedef used in other functions to so can't be pointer to const. */
@@ -557,6 +591,19 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
         /* Set the bits. */
         pxEventBits->uxEventBits |= uxBitsToSet;
 
+        #if ( configUSE_WAITSETS == 1 )
+        {
+            if( ( uxBitsToSet & pxEventBits->uxWaitSetBitsToWaitFor ) != ( EventBits_t ) 0 )
+            {
+                prvNotifyWaitSet( pxEventBits );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
         /* See if the new bit value should unblock any tasks. */
         while( pxListItem != pxListEnd )
         {
@@ -776,3 +823,92 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
 
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_WAITSETS == 1 )
+
+    static void prvNotifyWaitSet( const EventGroup_t * const pxEventBits )
+    {
+        if( pxEventBits->xWaitSetOwner != NULL )
+        {
+            ( void ) xTaskNotifyIndexed( pxEventBits->xWaitSetOwner, configWAITSET_NOTIFICATION_INDEX, pxEventBits->ulWaitSetBits, eSetBits );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_WAITSETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WAITSETS == 1 )
+
+    BaseType_t xEventGroupSetWaitSetMember( EventGroupHandle_t xEventGroup,
+                                            const EventBits_t uxBitsToWaitFor,
+                                            TaskHandle_t xOwner,
+                                            uint32_t ulBits )
+    {
+        EventGroup_t * pxEventBits = xEventGroup;
+        BaseType_t xReturn = pdFAIL;
+
+        configASSERT( xEventGroup );
+        configASSERT( xOwner );
+        configASSERT( ( uxBitsToWaitFor & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+        /* Event group bits are only ever set by tasks (or by the timer
+         * service task on behalf of interrupts), so suspending the scheduler is
+         * enough to keep the owner, bits and mask consistent. */
+        vTaskSuspendAll();
+        {
+            if( ulBits != 0UL )
+            {
+                configASSERT( uxBitsToWaitFor != 0 );
+
+                if( pxEventBits->xWaitSetOwner == NULL )
+                {
+                    pxEventBits->xWaitSetOwner = xOwner;
+                    pxEventBits->uxWaitSetBitsToWaitFor = uxBitsToWaitFor;
+                    pxEventBits->ulWaitSetBits = ulBits;
+
+                    /* Bits that were set before the event group was added are
+                     * posted now, so they are not missed. */
+                    if( ( pxEventBits->uxEventBits & uxBitsToWaitFor ) != ( EventBits_t ) 0 )
+                    {
+                        prvNotifyWaitSet( pxEventBits );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    /* The event group is already in a waitset. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                if( pxEventBits->xWaitSetOwner == xOwner )
+                {
+                    pxEventBits->xWaitSetOwner = NULL;
+                    pxEventBits->uxWaitSetBitsToWaitFor = 0;
+                    pxEventBits->ulWaitSetBits = 0UL;
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    /* The event group is not in this waitset. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_WAITSETS */
+/*-----------------------------------------------------------*/
@@ -0,0 +1,591 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "atomic.h"
+#include "lwmutex.h"
+
+/* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e9021 !e961 !e750. */
+
+
+/* This entire source file will be skipped if the application is not configured
+ * to include lightweight mutexes.  This #if is closed at the very bottom of
+ * this file.  If you want to include lightweight mutexes then ensure
+ * configUSE_LIGHTWEIGHT_MUTEXES is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_LIGHTWEIGHT_MUTEXES == 1 )
+
+/*
+ * The fast paths only ever change the state word of a mutex or semaphore with
+ * Atomic_CompareAndSwap...(), and only between the states in which no task is
+ * waiting.  Once a task has to wait, the lwmutexHAS_WAITERS bit (or
+ * lwmutexSEMAPHORE_HAS_WAITERS) is set, so every compare-and-swap of the fast
+ * paths fails and all further changes are made by the functions below in a
+ * critical section, together with the list of waiting tasks.  The bit is only
+ * cleared, in a critical section, once the list is empty.
+ *
+ * A waiting task is unblocked when the mutex or semaphore is given, but is not
+ * handed it - it takes it when it next runs, in the same way as any other
+ * task, and blocks again for the rest of its timeout if another task got there
+ * first.
+ *
+ * The holder of a mutex that other tasks are waiting for is counted in its
+ * uxMutexesHeld, so that it only returns an inherited priority once it has
+ * given every mutex that another task is waiting for.  An uncontended holder
+ * is not counted, as no task can have passed its priority on to it through
+ * that mutex.
+ */
+
+/* Set in pvHolder of a mutex while tasks are waiting for it. */
+    #define lwmutexHAS_WAITERS                   ( ( portPOINTER_SIZE_TYPE ) 1U )
+
+/* Values of ulState of a semaphore. */
+    #define lwmutexSEMAPHORE_EMPTY               ( ( uint32_t ) 0U )
+    #define lwmutexSEMAPHORE_AVAILABLE           ( ( uint32_t ) 1U )
+    #define lwmutexSEMAPHORE_HAS_WAITERS         ( ( uint32_t ) 2U )
+
+/* The holder recorded in a pvHolder value, and a pvHolder value for xHolder
+ * with lwmutexHAS_WAITERS set. */
+    #define lwmutexGET_HOLDER( pvHolder )        ( ( TaskHandle_t ) ( ( portPOINTER_SIZE_TYPE ) ( pvHolder ) & ~lwmutexHAS_WAITERS ) )
+    #define lwmutexWITH_WAITERS( xHolder )       ( ( void * ) ( ( portPOINTER_SIZE_TYPE ) ( xHolder ) | lwmutexHAS_WAITERS ) )
+
+/* Returned by the body of the loops of the blocking functions when the calling
+ * task has blocked and has to try again once it is unblocked. */
+    #define lwmutexBLOCKED                       ( ( BaseType_t ) 2 )
+
+    #if ( configUSE_PREEMPTION == 0 )
+
+/* If the cooperative scheduler is being used then a yield should not be
+ * performed just because a higher priority task has been woken. */
+        #define lwmutexYIELD_IF_USING_PREEMPTION()
+    #else
+        #define lwmutexYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
+    #endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The parts of xLightweightMutexTake() and xLightweightMutexGive() that run
+ * when the mutex is contended.
+ */
+    static BaseType_t prvMutexTakeContended( LightweightMutex_t * pxMutex,
+                                             TaskHandle_t xCurrentTask,
+                                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvMutexGiveContended( LightweightMutex_t * pxMutex,
+                                             TaskHandle_t xCurrentTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * The part of xLightweightSemaphoreTake() that runs when the semaphore is not
+ * available.
+ */
+    static BaseType_t prvSemaphoreTakeContended( LightweightSemaphore_t * pxSemaphore,
+                                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Makes the semaphore available and unblocks the highest priority task waiting
+ * for it.  Returns pdFAIL if the semaphore was already available, otherwise
+ * pdPASS, and sets *pxYieldRequired to pdTRUE if the unblocked task has a
+ * higher priority than the calling task.  Must be called with interrupts
+ * masked.
+ */
+    static BaseType_t prvSemaphoreGiveContended( LightweightSemaphore_t * pxSemaphore,
+                                                 BaseType_t * pxYieldRequired ) PRIVILEGED_FUNCTION;
+
+/*
+ * The priority of the highest priority task waiting for the mutex, or
+ * tskIDLE_PRIORITY if none are.  Must be called with interrupts masked.
+ */
+    static UBaseType_t prvGetHighestWaitingPriority( LightweightMutex_t * pxMutex ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    void vLightweightMutexInitialise( LightweightMutex_t * pxMutex )
+    {
+        configASSERT( pxMutex );
+
+        pxMutex->pvHolder = NULL;
+        taskEVENT_LIST_INITIALISE( &( pxMutex->xTasksWaiting ) );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xLightweightMutexTake( LightweightMutex_t * pxMutex,
+                                      TickType_t xTicksToWait )
+    {
+        TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+        BaseType_t xReturn;
+
+        configASSERT( pxMutex );
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+
+        if( Atomic_CompareAndSwapPointers_p32( &( pxMutex->pvHolder ), xCurrentTask, NULL ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+        {
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = prvMutexTakeContended( pxMutex, xCurrentTask, xTicksToWait );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvMutexTakeContended( LightweightMutex_t * pxMutex,
+                                             TaskHandle_t xCurrentTask,
+                                             TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn, xEntryTimeSet = pdFALSE, xInheritanceOccurred = pdFALSE;
+        TimeOut_t xTimeOut;
+        void * pvHolder;
+        TaskHandle_t xHolder;
+
+        do
+        {
+            taskENTER_CRITICAL();
+            {
+                pvHolder = pxMutex->pvHolder;
+                xHolder = lwmutexGET_HOLDER( pvHolder );
+
+                /* Lightweight mutexes cannot be taken recursively. */
+                configASSERT( xHolder != xCurrentTask );
+
+                if( xHolder == NULL )
+                {
+                    /* The mutex is free, although a task that was unblocked when
+                     * it was given may not have run yet.  Take it, and count it
+                     * as held if tasks are still waiting for it. */
+                    if( taskEVENT_LIST_IS_EMPTY( &( pxMutex->xTasksWaiting ) ) != pdFALSE )
+                    {
+                        pxMutex->pvHolder = xCurrentTask;
+                    }
+                    else
+                    {
+                        pxMutex->pvHolder = lwmutexWITH_WAITERS( xCurrentTask );
+                        ( void ) pvTaskIncrementMutexHeldCount();
+                    }
+
+                    xReturn = pdPASS;
+                }
+                else if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    xReturn = pdFAIL;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                    xReturn = lwmutexBLOCKED;
+                }
+                else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+                {
+                    xReturn = lwmutexBLOCKED;
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
+                if( xReturn == lwmutexBLOCKED )
+                {
+                    /* The first task to wait makes the holder count the mutex as
+                     * held, and sends its give down the contended path. */
+                    if( ( ( portPOINTER_SIZE_TYPE ) pvHolder & lwmutexHAS_WAITERS ) == 0U )
+                    {
+                        pxMutex->pvHolder = lwmutexWITH_WAITERS( xHolder );
+                        vTaskIncrementMutexHeldCountOf( xHolder );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( xTaskPriorityInherit( xHolder ) != pdFALSE )
+                    {
+                        xInheritanceOccurred = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    vTaskPlaceOnEventList( &( pxMutex->xTasksWaiting ), xTicksToWait );
+
+                    /* The switch happens when the critical section is exited. */
+                    portYIELD_WITHIN_API();
+                }
+                else if( ( xReturn == pdFAIL ) &&
+                         ( xInheritanceOccurred != pdFALSE ) &&
+                         ( ( ( portPOINTER_SIZE_TYPE ) pvHolder & lwmutexHAS_WAITERS ) != 0U ) )
+                {
+                    /* This task timed out after raising the priority of a
+                     * holder.  The current holder keeps the priority of the
+                     * highest priority task still waiting.  If the waiting bit
+                     * is clear the holder took the mutex uncontended, after the
+                     * holder this task waited for gave it back along with the
+                     * inherited priority, so is not counted as holding it. */
+                    vTaskPriorityDisinheritAfterTimeout( xHolder, prvGetHighestWaitingPriority( pxMutex ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        } while( xReturn == lwmutexBLOCKED );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xLightweightMutexGive( LightweightMutex_t * pxMutex )
+    {
+        TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+        BaseType_t xReturn;
+
+        configASSERT( pxMutex );
+
+        if( Atomic_CompareAndSwapPointers_p32( &( pxMutex->pvHolder ), NULL, xCurrentTask ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+        {
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = prvMutexGiveContended( pxMutex, xCurrentTask );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvMutexGiveContended( LightweightMutex_t * pxMutex,
+                                             TaskHandle_t xCurrentTask )
+    {
+        BaseType_t xReturn, xYieldRequired = pdFALSE;
+
+        taskENTER_CRITICAL();
+        {
+            if( lwmutexGET_HOLDER( pxMutex->pvHolder ) == xCurrentTask )
+            {
+                /* The fast path failed although the caller holds the mutex, so
+                 * other tasks have waited for it and it is counted as held. */
+                configASSERT( ( ( portPOINTER_SIZE_TYPE ) pxMutex->pvHolder & lwmutexHAS_WAITERS ) != 0U );
+
+                if( taskEVENT_LIST_IS_EMPTY( &( pxMutex->xTasksWaiting ) ) == pdFALSE )
+                {
+                    /* Leave the bit set so the unblocked task, or any other
+                     * task, takes the mutex through the contended path. */
+                    pxMutex->pvHolder = lwmutexWITH_WAITERS( NULL );
+
+                    if( xTaskRemoveFromEventList( &( pxMutex->xTasksWaiting ) ) != pdFALSE )
+                    {
+                        xYieldRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The tasks that waited have all timed out. */
+                    pxMutex->pvHolder = NULL;
+                }
+
+                /* Return any priority inherited through this mutex, if no other
+                 * mutex this task holds is still wanted. */
+                if( xTaskPriorityDisinherit( xCurrentTask ) != pdFALSE )
+                {
+                    xYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( xYieldRequired != pdFALSE )
+                {
+                    lwmutexYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                /* The calling task does not hold the mutex. */
+                xReturn = pdFAIL;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvGetHighestWaitingPriority( LightweightMutex_t * pxMutex )
+    {
+        UBaseType_t uxHighestPriorityOfWaitingTasks;
+
+        #if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+        {
+            uxHighestPriorityOfWaitingTasks = uxTaskEventListGetHighestPriority( &( pxMutex->xTasksWaiting ) );
+        }
+        #else
+        {
+            if( listCURRENT_LIST_LENGTH( &( pxMutex->xTasksWaiting ) ) > 0U )
+            {
+                uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxMutex->xTasksWaiting ) );
+            }
+            else
+            {
+                uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+            }
+        }
+        #endif /* configUSE_PRIORITY_EVENT_LISTS */
+
+        return uxHighestPriorityOfWaitingTasks;
+    }
+/*-----------------------------------------------------------*/
+
+    void vLightweightSemaphoreInitialise( LightweightSemaphore_t * pxSemaphore )
+    {
+        configASSERT( pxSemaphore );
+
+        pxSemaphore->ulState = lwmutexSEMAPHORE_EMPTY;
+        taskEVENT_LIST_INITIALISE( &( pxSemaphore->xTasksWaiting ) );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xLightweightSemaphoreTake( LightweightSemaphore_t * pxSemaphore,
+                                          TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn;
+
+        configASSERT( pxSemaphore );
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+
+        if( Atomic_CompareAndSwap_u32( &( pxSemaphore->ulState ), lwmutexSEMAPHORE_EMPTY, lwmutexSEMAPHORE_AVAILABLE ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+        {
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = prvSemaphoreTakeContended( pxSemaphore, xTicksToWait );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvSemaphoreTakeContended( LightweightSemaphore_t * pxSemaphore,
+                                                 TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn, xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+
+        do
+        {
+            taskENTER_CRITICAL();
+            {
+                if( ( pxSemaphore->ulState & lwmutexSEMAPHORE_AVAILABLE ) != 0U )
+                {
+                    xReturn = pdPASS;
+                }
+                else if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    xReturn = pdFAIL;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                    xReturn = lwmutexBLOCKED;
+                }
+                else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+                {
+                    xReturn = lwmutexBLOCKED;
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
+                if( xReturn == lwmutexBLOCKED )
+                {
+                    pxSemaphore->ulState = lwmutexSEMAPHORE_HAS_WAITERS;
+                    vTaskPlaceOnEventList( &( pxSemaphore->xTasksWaiting ), xTicksToWait );
+
+                    /* The switch happens when the critical section is exited. */
+                    portYIELD_WITHIN_API();
+                }
+                else if( taskEVENT_LIST_IS_EMPTY( &( pxSemaphore->xTasksWaiting ) ) != pdFALSE )
+                {
+                    /* Taken, or timed out, and no other task is waiting, so the
+                     * fast paths can be used again. */
+                    pxSemaphore->ulState = lwmutexSEMAPHORE_EMPTY;
+                }
+                else
+                {
+                    pxSemaphore->ulState = lwmutexSEMAPHORE_HAS_WAITERS;
+                }
+            }
+            taskEXIT_CRITICAL();
+        } while( xReturn == lwmutexBLOCKED );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xLightweightSemaphoreGive( LightweightSemaphore_t * pxSemaphore )
+    {
+        BaseType_t xReturn, xYieldRequired = pdFALSE;
+
+        configASSERT( pxSemaphore );
+
+        if( Atomic_CompareAndSwap_u32( &( pxSemaphore->ulState ), lwmutexSEMAPHORE_AVAILABLE, lwmutexSEMAPHORE_EMPTY ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+        {
+            xReturn = pdPASS;
+        }
+        else
+        {
+            taskENTER_CRITICAL();
+            {
+                xReturn = prvSemaphoreGiveContended( pxSemaphore, &xYieldRequired );
+
+                if( xYieldRequired != pdFALSE )
+                {
+                    lwmutexYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xLightweightSemaphoreGiveFromISR( LightweightSemaphore_t * pxSemaphore,
+                                                 BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        BaseType_t xReturn, xYieldRequired = pdFALSE;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( pxSemaphore );
+
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum system call (or maximum API call) interrupt priority.
+         * Interrupts that are above the maximum system call priority are kept
+         * permanently enabled, even when the RTOS kernel is in a critical section,
+         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+         * is defined in FreeRTOSConfig.h then
+         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+         * failure if a FreeRTOS API function is called from an interrupt that has
+         * been assigned a priority above the configured maximum system call
+         * priority. */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        if( Atomic_CompareAndSwap_u32( &( pxSemaphore->ulState ), lwmutexSEMAPHORE_AVAILABLE, lwmutexSEMAPHORE_EMPTY ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+        {
+            xReturn = pdPASS;
+        }
+        else
+        {
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+            {
+                xReturn = prvSemaphoreGiveContended( pxSemaphore, &xYieldRequired );
+            }
+            portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+            if( ( xYieldRequired != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+            {
+                *pxHigherPriorityTaskWoken = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvSemaphoreGiveContended( LightweightSemaphore_t * pxSemaphore,
+                                                 BaseType_t * pxYieldRequired )
+    {
+        BaseType_t xReturn;
+
+        if( ( pxSemaphore->ulState & lwmutexSEMAPHORE_AVAILABLE ) != 0U )
+        {
+            /* A binary semaphore can only be given once. */
+            xReturn = pdFAIL;
+        }
+        else
+        {
+            /* The fast path failed so tasks are waiting.  Leave the waiting bit
+             * set, so whichever task takes the semaphore does so through the
+             * contended path and decides whether it can be cleared. */
+            pxSemaphore->ulState = lwmutexSEMAPHORE_AVAILABLE | lwmutexSEMAPHORE_HAS_WAITERS;
+
+            if( taskEVENT_LIST_IS_EMPTY( &( pxSemaphore->xTasksWaiting ) ) == pdFALSE )
+            {
+                if( xTaskRemoveFromEventList( &( pxSemaphore->xTasksWaiting ) ) != pdFALSE )
+                {
+                    *pxYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xReturn = pdPASS;
+        }
+
+        return xReturn;
+    }
+
+/* This entire source file will be skipped if the application is not configured
+ * to include lightweight mutexes.  If you want to include lightweight mutexes
+ * then ensure configUSE_LIGHTWEIGHT_MUTEXES is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_LIGHTWEIGHT_MUTEXES == 1 */
@@ -0,0 +1,387 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "periodic.h"
+
+/* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e9021 !e961 !e750. */
+
+
+/* This entire source file will be skipped if the application is not configured
+ * to include periodic tasks.  This #if is closed at the very bottom of this
+ * file.  If you want to include periodic tasks then ensure
+ * configUSE_PERIODIC_TASKS is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_PERIODIC_TASKS == 1 )
+
+/* Bit definitions used in the ucFlags member of a periodic control block. */
+    #define periodicFLAG_AUTO_PHASE    ( ( uint8_t ) 0x01 )
+    #define periodicFLAG_STARTED       ( ( uint8_t ) 0x02 )
+
+/*lint -save -e956 A manual analysis and inspection has been used to determine
+ * which static variables must be declared volatile. */
+
+/* Every periodic control block that has been initialised, in the order the
+ * tasks were created.  Only accessed from within critical sections. */
+    PRIVILEGED_DATA static PeriodicTask_t * pxPeriodicTasks = NULL;
+
+/*lint -restore */
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Fills in a periodic control block and adds it to pxPeriodicTasks, choosing
+ * its phase if it is auto phased.
+ */
+    static void prvInitialisePeriodicTask( PeriodicTask_t * pxPeriodicTask,
+                                           TaskFunction_t pxJobCode,
+                                           void * pvParameters,
+                                           TickType_t xPeriod,
+                                           TickType_t xPhase,
+                                           TickType_t xDeadline ) PRIVILEGED_FUNCTION;
+
+/*
+ * Spreads the phases of the auto phased tasks with period xPeriod that have
+ * not started running evenly across the period.  Called from a critical
+ * section.
+ */
+    static void prvSpreadAutoPhases( TickType_t xPeriod ) PRIVILEGED_FUNCTION;
+
+/*
+ * Records the release jitter and response time of a job that has completed.
+ * Only called by the periodic task itself, which is the only writer.
+ */
+    static void prvRecordJob( PeriodicTask_t * pxPeriodicTask,
+                              TickType_t xReleaseJitter,
+                              TickType_t xResponseTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * The function run by every periodic task.
+ */
+    static portTASK_FUNCTION_PROTO( prvPeriodicTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        TaskHandle_t xPeriodicTaskCreateStatic( TaskFunction_t pxJobCode,
+                                                const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                                const uint32_t ulStackDepth,
+                                                void * const pvParameters,
+                                                UBaseType_t uxPriority,
+                                                TickType_t xPeriod,
+                                                TickType_t xPhase,
+                                                TickType_t xDeadline,
+                                                StackType_t * const puxStackBuffer,
+                                                StaticTask_t * const pxTaskBuffer,
+                                                PeriodicTask_t * const pxPeriodicTaskBuffer )
+        {
+            TaskHandle_t xReturn = NULL;
+
+            configASSERT( puxStackBuffer != NULL );
+            configASSERT( pxTaskBuffer != NULL );
+            configASSERT( pxPeriodicTaskBuffer != NULL );
+
+            if( ( puxStackBuffer != NULL ) && ( pxTaskBuffer != NULL ) && ( pxPeriodicTaskBuffer != NULL ) )
+            {
+                prvInitialisePeriodicTask( pxPeriodicTaskBuffer, pxJobCode, pvParameters, xPeriod, xPhase, xDeadline );
+
+                xReturn = xTaskCreateStatic( prvPeriodicTask,
+                                             pcName,
+                                             ulStackDepth,
+                                             ( void * ) pxPeriodicTaskBuffer,
+                                             uxPriority,
+                                             puxStackBuffer,
+                                             pxTaskBuffer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xReturn;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        BaseType_t xPeriodicTaskCreate( TaskFunction_t pxJobCode,
+                                        const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                        const configSTACK_DEPTH_TYPE usStackDepth,
+                                        void * const pvParameters,
+                                        UBaseType_t uxPriority,
+                                        TickType_t xPeriod,
+                                        TickType_t xPhase,
+                                        TickType_t xDeadline,
+                                        PeriodicTask_t * const pxPeriodicTaskBuffer,
+                                        TaskHandle_t * const pxCreatedTask )
+        {
+            configASSERT( pxPeriodicTaskBuffer != NULL );
+
+            prvInitialisePeriodicTask( pxPeriodicTaskBuffer, pxJobCode, pvParameters, xPeriod, xPhase, xDeadline );
+
+            return xTaskCreate( prvPeriodicTask,
+                                pcName,
+                                usStackDepth,
+                                ( void * ) pxPeriodicTaskBuffer,
+                                uxPriority,
+                                pxCreatedTask );
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    static void prvInitialisePeriodicTask( PeriodicTask_t * pxPeriodicTask,
+                                           TaskFunction_t pxJobCode,
+                                           void * pvParameters,
+                                           TickType_t xPeriod,
+                                           TickType_t xPhase,
+                                           TickType_t xDeadline )
+    {
+        PeriodicTask_t ** ppxLink;
+        BaseType_t xStats;
+
+        configASSERT( pxJobCode != NULL );
+        configASSERT( xPeriod > ( TickType_t ) 0U );
+        configASSERT( ( xPhase == periodicAUTO_PHASE ) || ( xPhase < xPeriod ) );
+
+        taskENTER_CRITICAL();
+        {
+            /* Unlink the control block in case it is being reused for a task
+             * that replaces one that was deleted. */
+            for( ppxLink = &pxPeriodicTasks; *ppxLink != NULL; ppxLink = &( ( *ppxLink )->pxNext ) )
+            {
+                if( *ppxLink == pxPeriodicTask )
+                {
+                    *ppxLink = pxPeriodicTask->pxNext;
+                    break;
+                }
+            }
+
+            pxPeriodicTask->pxNext = NULL;
+            pxPeriodicTask->pxJobCode = pxJobCode;
+            pxPeriodicTask->pvParameters = pvParameters;
+            pxPeriodicTask->xPeriod = xPeriod;
+            pxPeriodicTask->xDeadline = ( xDeadline == ( TickType_t ) 0U ) ? xPeriod : xDeadline;
+            pxPeriodicTask->uxStatsSequence = ( UBaseType_t ) 0U;
+
+            for( xStats = 0; xStats < ( BaseType_t ) 2; xStats++ )
+            {
+                pxPeriodicTask->xStats[ xStats ].ulReleases = 0U;
+                pxPeriodicTask->xStats[ xStats ].ulDeadlineMisses = 0U;
+                pxPeriodicTask->xStats[ xStats ].xLastReleaseJitter = ( TickType_t ) 0U;
+                pxPeriodicTask->xStats[ xStats ].xMaxReleaseJitter = ( TickType_t ) 0U;
+                pxPeriodicTask->xStats[ xStats ].xLastResponseTime = ( TickType_t ) 0U;
+                pxPeriodicTask->xStats[ xStats ].xMaxResponseTime = ( TickType_t ) 0U;
+            }
+
+            if( xPhase == periodicAUTO_PHASE )
+            {
+                pxPeriodicTask->xPhase = ( TickType_t ) 0U;
+                pxPeriodicTask->ucFlags = periodicFLAG_AUTO_PHASE;
+            }
+            else
+            {
+                pxPeriodicTask->xPhase = xPhase;
+                pxPeriodicTask->ucFlags = ( uint8_t ) 0U;
+            }
+
+            /* ppxLink now references the pxNext member of the last block, or
+             * pxPeriodicTasks if the list is empty. */
+            *ppxLink = pxPeriodicTask;
+
+            if( xPhase == periodicAUTO_PHASE )
+            {
+                prvSpreadAutoPhases( xPeriod );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvSpreadAutoPhases( TickType_t xPeriod )
+    {
+        PeriodicTask_t * pxIterator;
+        TickType_t xCount = ( TickType_t ) 0U, xIndex = ( TickType_t ) 0U;
+
+        for( pxIterator = pxPeriodicTasks; pxIterator != NULL; pxIterator = pxIterator->pxNext )
+        {
+            if( ( pxIterator->xPeriod == xPeriod ) && ( pxIterator->ucFlags == periodicFLAG_AUTO_PHASE ) )
+            {
+                xCount++;
+            }
+        }
+
+        for( pxIterator = pxPeriodicTasks; pxIterator != NULL; pxIterator = pxIterator->pxNext )
+        {
+            if( ( pxIterator->xPeriod == xPeriod ) && ( pxIterator->ucFlags == periodicFLAG_AUTO_PHASE ) )
+            {
+                /* xPeriod * xIndex / xCount, arranged so it cannot overflow. */
+                pxIterator->xPhase = ( ( xPeriod / xCount ) * xIndex ) + ( ( ( xPeriod % xCount ) * xIndex ) / xCount );
+                xIndex++;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRecordJob( PeriodicTask_t * pxPeriodicTask,
+                              TickType_t xReleaseJitter,
+                              TickType_t xResponseTime )
+    {
+        const UBaseType_t uxSequence = pxPeriodicTask->uxStatsSequence;
+        volatile PeriodicTaskStats_t * const pxStats = &( pxPeriodicTask->xStats[ ( uxSequence + 1U ) & 1U ] );
+
+        /* Readers only read the copy selected by uxStatsSequence, so the other
+         * copy can be brought up to date without locking, then published by
+         * incrementing uxStatsSequence. */
+        *pxStats = pxPeriodicTask->xStats[ uxSequence & 1U ];
+
+        pxStats->ulReleases++;
+        pxStats->xLastReleaseJitter = xReleaseJitter;
+        pxStats->xLastResponseTime = xResponseTime;
+
+        if( xReleaseJitter > pxStats->xMaxReleaseJitter )
+        {
+            pxStats->xMaxReleaseJitter = xReleaseJitter;
+        }
+
+        if( xResponseTime > pxStats->xMaxResponseTime )
+        {
+            pxStats->xMaxResponseTime = xResponseTime;
+        }
+
+        if( xResponseTime >= pxPeriodicTask->xDeadline )
+        {
+            pxStats->ulDeadlineMisses++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxPeriodicTask->uxStatsSequence = uxSequence + 1U;
+    }
+/*-----------------------------------------------------------*/
+
+    static portTASK_FUNCTION( prvPeriodicTask, pvParameters )
+    {
+        PeriodicTask_t * const pxPeriodicTask = ( PeriodicTask_t * ) pvParameters;
+        const TickType_t xPeriod = pxPeriodicTask->xPeriod;
+        TickType_t xPhase, xNow, xOffset, xRelease, xStart;
+
+        /* Fix the phase - auto phased tasks are not moved once they run. */
+        taskENTER_CRITICAL();
+        {
+            pxPeriodicTask->ucFlags |= periodicFLAG_STARTED;
+            xPhase = pxPeriodicTask->xPhase;
+        }
+        taskEXIT_CRITICAL();
+
+        /* The first release is the next time, not before now, that lies a
+         * whole number of periods after the scheduler start time plus the
+         * phase. */
+        xNow = xTaskGetTickCount();
+        xOffset = ( TickType_t ) ( xNow - ( TickType_t ) configINITIAL_TICK_COUNT ) % xPeriod;
+
+        if( xOffset <= xPhase )
+        {
+            xRelease = xNow + ( xPhase - xOffset );
+        }
+        else
+        {
+            xRelease = xNow + ( xPeriod - xOffset ) + xPhase;
+        }
+
+        /* xTaskDelayUntil() adds the period to the previous release. */
+        xRelease -= xPeriod;
+
+        for( ; ; )
+        {
+            ( void ) xTaskDelayUntil( &xRelease, xPeriod );
+
+            xStart = xTaskGetTickCount();
+            pxPeriodicTask->pxJobCode( pxPeriodicTask->pvParameters );
+
+            prvRecordJob( pxPeriodicTask, ( TickType_t ) ( xStart - xRelease ), ( TickType_t ) ( xTaskGetTickCount() - xRelease ) );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vPeriodicTaskGetStats( const PeriodicTask_t * pxPeriodicTask,
+                                PeriodicTaskStats_t * pxStats )
+    {
+        UBaseType_t uxSequence;
+
+        configASSERT( pxPeriodicTask != NULL );
+        configASSERT( pxStats != NULL );
+
+        /* The writer only ever modifies the copy that uxStatsSequence does not
+         * select, so the copy read here is consistent unless the writer
+         * published an update, and then started on this copy, while it was
+         * being read - in which case it is read again. */
+        do
+        {
+            uxSequence = pxPeriodicTask->uxStatsSequence;
+            *pxStats = pxPeriodicTask->xStats[ uxSequence & 1U ];
+        } while( uxSequence != pxPeriodicTask->uxStatsSequence );
+    }
+/*-----------------------------------------------------------*/
+
+    TickType_t xPeriodicTaskGetPhase( const PeriodicTask_t * pxPeriodicTask )
+    {
+        TickType_t xReturn;
+
+        configASSERT( pxPeriodicTask != NULL );
+
+        taskENTER_CRITICAL();
+        {
+            xReturn = pxPeriodicTask->xPhase;
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include periodic tasks.  If you want to include periodic tasks then
+ * ensure configUSE_PERIODIC_TASKS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_PERIODIC_TASKS == 1 */
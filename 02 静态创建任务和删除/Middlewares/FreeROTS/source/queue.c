@@ -54,6 +54,14 @@
 #define queueLOCKED_UNMODIFIED    ( ( int8_t ) 0 )
 #define queueINT8_MAX             ( ( int8_t ) 127 )
 
+/* Values for the ucCopyType structure member, chosen when the queue is
+ * created.  Queues of 1, 2, 4 or 8 byte items whose storage area is suitably
+ * aligned store the item size, and their items are copied with direct loads
+ * and stores instead of memcpy().  Eight byte items are copied as two 32-bit
+ * words so they only need 32-bit alignment. */
+#define queueCOPY_GENERIC                        ( ( uint8_t ) 0U )
+#define queueCOPY_ALIGNMENT_MASK( uxCopyType )    ( ( ( portPOINTER_SIZE_TYPE ) ( uxCopyType ) - ( portPOINTER_SIZE_TYPE ) 1U ) & ( portPOINTER_SIZE_TYPE ) 3U )
+
 /* When the Queue_t structure is used to represent a base queue its pcHead and
  * pcTail members are used as pointers into the queue storage area.  When the
  * Queue_t structure is used to represent a mutex pcHead and pcTail pointers are
@@ -76,8 +84,56 @@ typedef struct SemaphoreData
 {
     TaskHandle_t xMutexHolder;        /*< The handle of the task that holds the mutex. */
     UBaseType_t uxRecursiveCallCount; /*< Maintains a count of the number of times a recursive mutex has been recursively 'taken' when the structure is used as a mutex. */
+
+    #if ( configUSE_CEILING_MUTEXES == 1 )
+        UBaseType_t uxCeilingPriority; /*< The priority the holder of a priority ceiling mutex runs at, or queueNO_CEILING_PRIORITY for a mutex that uses priority inheritance. */
+    #endif
 } SemaphoreData_t;
 
+#if ( configUSE_CEILING_MUTEXES == 1 )
+
+/* A ceiling at the idle priority would never raise the holder, so it marks a
+ * mutex that uses priority inheritance instead. */
+    #define queueNO_CEILING_PRIORITY                   ( ( UBaseType_t ) tskIDLE_PRIORITY )
+    #define queueUSES_PRIORITY_INHERITANCE( pxQueue )    ( ( pxQueue )->u.xSemaphore.uxCeilingPriority == queueNO_CEILING_PRIORITY )
+#else
+    #define queueUSES_PRIORITY_INHERITANCE( pxQueue )    ( pdTRUE )
+#endif
+
+#if ( configUSE_PRIORITY_QUEUES == 1 )
+
+/* A priority queue keeps its items in the storage area at pcHead, as a FIFO
+ * queue does, but receives them in the order given by a binary heap of
+ * PriorityQueueEntry_t that follows the items.  Entries 0 to
+ * uxMessagesWaiting - 1 form the heap.  The remaining entries hold the indexes
+ * of the free item slots, so taking a free slot and returning one are both
+ * constant time, and only the three word entries move as the heap is
+ * reordered. */
+    typedef struct PriorityQueueEntry
+    {
+        UBaseType_t uxPriority;  /*< The priority the item was sent with. */
+        UBaseType_t uxSequence;  /*< Orders items of equal priority by the time they were sent. */
+        UBaseType_t uxItemIndex; /*< The slot in the storage area that holds the item. */
+    } PriorityQueueEntry_t;
+
+    typedef struct PriorityQueueData
+    {
+        PriorityQueueEntry_t * pxHeap; /*< Points to the heap, which follows the items in the storage area. */
+        UBaseType_t uxNextSequence;    /*< The sequence number of the next item sent. */
+    } PriorityQueueData_t;
+
+/* Entry A is received before entry B if its priority is higher, or if the
+ * priorities are equal and A was sent first.  Sequence numbers are compared
+ * as a signed difference so they can wrap, which is safe as at most
+ * uxLength of them are in use at once. */
+    #define queuePRIORITY_ENTRY_FIRST( pxA, pxB )                                      \
+    ( ( ( pxA )->uxPriority > ( pxB )->uxPriority ) ||                                 \
+      ( ( ( pxA )->uxPriority == ( pxB )->uxPriority ) &&                              \
+        ( ( BaseType_t ) ( ( pxA )->uxSequence - ( pxB )->uxSequence ) < ( BaseType_t ) 0 ) ) )
+
+    #define queuePRIORITY_ITEM( pxQueue, uxItemIndex )    ( ( pxQueue )->pcHead + ( ( uxItemIndex ) * ( pxQueue )->uxItemSize ) )
+#endif /* configUSE_PRIORITY_QUEUES */
+
 /* Semaphores do not actually store or copy data, so have an item size of
  * zero. */
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH    ( ( UBaseType_t ) 0 )
@@ -106,10 +162,14 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
     {
         QueuePointers_t xQueue;     /*< Data required exclusively when this structure is used as a queue. */
         SemaphoreData_t xSemaphore; /*< Data required exclusively when this structure is used as a semaphore. */
+
+        #if ( configUSE_PRIORITY_QUEUES == 1 )
+            PriorityQueueData_t xPriority; /*< Data required exclusively when this structure is used as a priority queue. */
+        #endif
     } u;
 
-    List_t xTasksWaitingToSend;             /*< List of tasks that are blocked waiting to post onto this queue.  Stored in priority order. */
-    List_t xTasksWaitingToReceive;          /*< List of tasks that are blocked waiting to read from this queue.  Stored in priority order. */
+    EventList_t xTasksWaitingToSend;        /*< List of tasks that are blocked waiting to post onto this queue.  Stored in priority order. */
+    EventList_t xTasksWaitingToReceive;     /*< List of tasks that are blocked waiting to read from this queue.  Stored in priority order. */
 
     volatile UBaseType_t uxMessagesWaiting; /*< The number of items currently in the queue. */
     UBaseType_t uxLength;                   /*< The length of the queue defined as the number of items it will hold, not the number of bytes. */
@@ -117,6 +177,11 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
 
     volatile int8_t cRxLock;                /*< Stores the number of items received from the queue (removed from the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
     volatile int8_t cTxLock;                /*< Stores the number of items transmitted to the queue (added to the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
+    uint8_t ucCopyType;                     /*< The item size if items are copied with direct loads and stores, otherwise queueCOPY_GENERIC. */
+
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+        uint8_t ucIsPriorityQueue; /*< Set to pdTRUE if the queue was created by xQueueCreatePriority(). */
+    #endif
 
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the memory used by the queue was statically allocated to ensure no attempt is made to free the memory. */
@@ -130,6 +195,11 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
     #endif
+
+    #if ( configUSE_WAITSETS == 1 )
+        TaskHandle_t xWaitSetOwner; /*< The task that owns the waitset the queue is a member of, or NULL if the queue is not in a waitset. */
+        uint32_t ulWaitSetBits;     /*< The bits posted to the waitset when an item is sent to the queue while it is empty. */
+    #endif
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -203,6 +273,93 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
 static void prvCopyDataFromQueue( Queue_t * const pxQueue,
                                   void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copies the item at the front of the queue without removing it.
+ */
+static void prvPeekDataFromQueue( Queue_t * const pxQueue,
+                                  void * const pvBuffer ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_PRIORITY_QUEUES == 1 )
+
+/*
+ * Copies an item into a free slot of a priority queue and sifts its heap
+ * entry up to its place.  uxMessagesWaiting is the number of items the heap
+ * held before the call; the caller must update the queue's count.
+ */
+    static void prvPriorityQueueInsert( Queue_t * const pxQueue,
+                                        const void * pvItemToQueue,
+                                        const UBaseType_t uxPriority,
+                                        const UBaseType_t uxMessagesWaiting ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies the highest priority item out of a priority queue, frees its slot
+ * and sifts the last heap entry down into the gap.  uxMessagesWaiting is the
+ * number of items the heap held before the call; the caller must update the
+ * queue's count.
+ */
+    static void prvPriorityQueueRemove( Queue_t * const pxQueue,
+                                        void * const pvBuffer,
+                                        const UBaseType_t uxMessagesWaiting ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( ( configUSE_PRIORITY_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+/*
+ * Returns pdFALSE if ucQueueType is a priority queue and the storage it needs,
+ * queuePRIORITY_QUEUE_STORAGE_SIZE() bytes, would overflow a size_t once the
+ * Queue_t is added to it.  The caller has already checked that
+ * uxQueueLength * uxItemSize does not overflow.
+ */
+    static BaseType_t prvPriorityQueueSizeIsValid( const UBaseType_t uxQueueLength,
+                                                   const UBaseType_t uxItemSize,
+                                                   const uint8_t ucQueueType ) PRIVILEGED_FUNCTION;
+#else
+    #define prvPriorityQueueSizeIsValid( uxQueueLength, uxItemSize, ucQueueType )    pdTRUE
+#endif
+
+/*
+ * Copies one item between the queue storage area and a caller's buffer, using
+ * direct loads and stores if the queue's copy type allows it and both
+ * pointers are suitably aligned, otherwise using memcpy().
+ */
+static void prvCopyItem( const Queue_t * const pxQueue,
+                         void * const pvDestination,
+                         const void * const pvSource ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies uxItemCount items onto the back of the queue, using at most two
+ * memcpy() calls as the copy can wrap around the end of the storage area at
+ * most once.  The caller must have checked there is space for every item.
+ */
+static void prvCopyBatchToQueue( Queue_t * const pxQueue,
+                                 const int8_t * pcItems,
+                                 const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies uxItemCount items off the front of the queue in the same way.  The
+ * caller must have checked that many items are waiting, and must update
+ * uxMessagesWaiting itself.
+ */
+static void prvCopyBatchFromQueue( Queue_t * const pxQueue,
+                                   int8_t * pcBuffer,
+                                   const UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called from a critical section after uxItemCount items have been posted
+ * to an unlocked queue.  Unblocks one waiting receiver per item posted (or
+ * notifies the queue set once per item if the queue is in a set), and returns
+ * pdTRUE if any task unblocked has a priority above the calling task.
+ */
+static BaseType_t prvUnblockReceiversAfterBatch( Queue_t * const pxQueue,
+                                                 UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * The equivalent of prvUnblockReceiversAfterBatch() for tasks waiting to send
+ * after uxItemCount items have been removed from an unlocked queue.
+ */
+static BaseType_t prvUnblockSendersAfterBatch( Queue_t * const pxQueue,
+                                               UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
 /*
@@ -212,6 +369,19 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
     static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( configUSE_WAITSETS == 1 )
+
+/*
+ * Checks to see if a queue is a member of a waitset, and if so, posts the
+ * bits of the queue to the task that owns the waitset if the queue is empty.
+ * Called each time an item is sent to the queue, before the item is copied,
+ * from a critical section or, in the FromISR version, with interrupts masked.
+ */
+    static void prvNotifyWaitSet( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+    static void prvNotifyWaitSetFromISR( const Queue_t * const pxQueue,
+                                         BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Called after a Queue_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -240,7 +410,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
  * other tasks that are waiting for the same mutex.  This function returns
  * that priority.
  */
-    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
 /*-----------------------------------------------------------*/
 
@@ -308,10 +478,22 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
     {
         taskENTER_CRITICAL();
         {
-            pxQueue->u.xQueue.pcTail = pxQueue->pcHead + ( pxQueue->uxLength * pxQueue->uxItemSize ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+            #if ( configUSE_PRIORITY_QUEUES == 1 )
+                if( pxQueue->ucIsPriorityQueue != pdFALSE )
+                {
+                    /* The heap entries past uxMessagesWaiting always hold the
+                     * free slots, so emptying the heap frees every slot. */
+                    pxQueue->u.xPriority.uxNextSequence = ( UBaseType_t ) 0U;
+                }
+                else
+            #endif /* configUSE_PRIORITY_QUEUES */
+            {
+                pxQueue->u.xQueue.pcTail = pxQueue->pcHead + ( pxQueue->uxLength * pxQueue->uxItemSize );                 /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+                pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead + ( ( pxQueue->uxLength - 1U ) * pxQueue->uxItemSize ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+            }
+
             pxQueue->uxMessagesWaiting = ( UBaseType_t ) 0U;
             pxQueue->pcWriteTo = pxQueue->pcHead;
-            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead + ( ( pxQueue->uxLength - 1U ) * pxQueue->uxItemSize ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
             pxQueue->cRxLock = queueUNLOCKED;
             pxQueue->cTxLock = queueUNLOCKED;
 
@@ -322,7 +504,7 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
                  * will still be empty.  If there are tasks blocked waiting to write to
                  * the queue, then one should be unblocked as after this function exits
                  * it will be possible to write to it. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                if( taskEVENT_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
                 {
                     if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
                     {
@@ -341,8 +523,8 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             else
             {
                 /* Ensure the event queues start in the correct state. */
-                vListInitialise( &( pxQueue->xTasksWaitingToSend ) );
-                vListInitialise( &( pxQueue->xTasksWaitingToReceive ) );
+                taskEVENT_LIST_INITIALISE( &( pxQueue->xTasksWaitingToSend ) );
+                taskEVENT_LIST_INITIALISE( &( pxQueue->xTasksWaitingToReceive ) );
             }
         }
         taskEXIT_CRITICAL();
@@ -437,13 +619,29 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
             /* Check for multiplication overflow. */
             ( ( SIZE_MAX / uxQueueLength ) >= uxItemSize ) &&
             /* Check for addition overflow. */
-            ( ( SIZE_MAX - sizeof( Queue_t ) ) >= ( uxQueueLength * uxItemSize ) ) )
+            ( ( SIZE_MAX - sizeof( Queue_t ) ) >= ( uxQueueLength * uxItemSize ) ) &&
+            /* Check the heap of a priority queue cannot overflow the size. */
+            ( prvPriorityQueueSizeIsValid( uxQueueLength, uxItemSize, ucQueueType ) != pdFALSE ) )
         {
             /* Allocate enough space to hold the maximum number of items that
              * can be in the queue at any time.  It is valid for uxItemSize to be
              * zero in the case the queue is used as a semaphore. */
             xQueueSizeInBytes = ( size_t ) ( uxQueueLength * uxItemSize ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
+            #if ( configUSE_PRIORITY_QUEUES == 1 )
+            {
+                if( ucQueueType == queueQUEUE_TYPE_PRIORITY )
+                {
+                    /* A priority queue also stores its heap. */
+                    xQueueSizeInBytes = queuePRIORITY_QUEUE_STORAGE_SIZE( uxQueueLength, uxItemSize );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_PRIORITY_QUEUES */
+
             /* Allocate the queue and storage area.  Justification for MISRA
              * deviation as follows:  pvPortMalloc() always ensures returned memory
              * blocks are aligned per the requirements of the MCU stack.  In this case
@@ -519,8 +717,63 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
      * defined. */
     pxNewQueue->uxLength = uxQueueLength;
     pxNewQueue->uxItemSize = uxItemSize;
+
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+    {
+        if( ucQueueType == queueQUEUE_TYPE_PRIORITY )
+        {
+            UBaseType_t uxItemIndex;
+            size_t xItemBytes = ( size_t ) ( uxQueueLength * uxItemSize );
+
+            /* The heap follows the items, on the next UBaseType_t boundary. */
+            configASSERT( uxItemSize != ( UBaseType_t ) 0U );
+            configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pucQueueStorage ) & ( ( portPOINTER_SIZE_TYPE ) sizeof( UBaseType_t ) - 1U ) ) == 0U ); /*lint !e923 !e9078 MISRA exception.  Avoiding casts between pointers and integers is not practical. */
+            configASSERT( sizeof( PriorityQueueEntry_t ) == ( 3U * sizeof( UBaseType_t ) ) );
+
+            xItemBytes = ( xItemBytes + sizeof( UBaseType_t ) - 1U ) & ~( sizeof( UBaseType_t ) - 1U );
+            pxNewQueue->u.xPriority.pxHeap = ( PriorityQueueEntry_t * ) &( pucQueueStorage[ xItemBytes ] ); /*lint !e9087 !e826 Alignment checked above. */
+
+            /* The heap starts empty, so every entry holds a free slot. */
+            for( uxItemIndex = 0; uxItemIndex < uxQueueLength; uxItemIndex++ )
+            {
+                pxNewQueue->u.xPriority.pxHeap[ uxItemIndex ].uxItemIndex = uxItemIndex;
+            }
+
+            pxNewQueue->ucIsPriorityQueue = pdTRUE;
+        }
+        else
+        {
+            pxNewQueue->ucIsPriorityQueue = pdFALSE;
+        }
+    }
+    #endif /* configUSE_PRIORITY_QUEUES */
+
     ( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
 
+    /* Items of 1, 2, 4 or 8 bytes can be copied with direct loads and stores
+     * if the storage area is aligned for them.  Every item is then aligned, as
+     * each starts a multiple of the item size from pcHead. */
+    pxNewQueue->ucCopyType = queueCOPY_GENERIC;
+
+    if( ( uxItemSize == ( UBaseType_t ) sizeof( uint8_t ) ) ||
+        ( uxItemSize == ( UBaseType_t ) sizeof( uint16_t ) ) ||
+        ( uxItemSize == ( UBaseType_t ) sizeof( uint32_t ) ) ||
+        ( uxItemSize == ( UBaseType_t ) ( sizeof( uint32_t ) * 2U ) ) )
+    {
+        if( ( ( ( portPOINTER_SIZE_TYPE ) pucQueueStorage ) & queueCOPY_ALIGNMENT_MASK( uxItemSize ) ) == 0U ) /*lint !e923 !e9078 MISRA exception.  Avoiding casts between pointers and integers is not practical.  Size differences accounted for using portPOINTER_SIZE_TYPE type. */
+        {
+            pxNewQueue->ucCopyType = ( uint8_t ) uxItemSize;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
     #if ( configUSE_TRACE_FACILITY == 1 )
     {
         pxNewQueue->ucQueueType = ucQueueType;
@@ -533,6 +786,13 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
     }
     #endif /* configUSE_QUEUE_SETS */
 
+    #if ( configUSE_WAITSETS == 1 )
+    {
+        pxNewQueue->xWaitSetOwner = NULL;
+        pxNewQueue->ulWaitSetBits = 0UL;
+    }
+    #endif /* configUSE_WAITSETS */
+
     traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -553,6 +813,13 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
             /* In case this is a recursive mutex. */
             pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
 
+            #if ( configUSE_CEILING_MUTEXES == 1 )
+            {
+                /* xQueueCreateCeilingMutex() sets the ceiling afterwards. */
+                pxNewQueue->u.xSemaphore.uxCeilingPriority = queueNO_CEILING_PRIORITY;
+            }
+            #endif
+
             traceCREATE_MUTEX( pxNewQueue );
 
             /* Start with the semaphore in the expected state. */
@@ -604,6 +871,57 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_CEILING_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateCeilingMutex( const UBaseType_t uxCeilingPriority )
+    {
+        QueueHandle_t xNewQueue;
+
+        configASSERT( ( uxCeilingPriority > tskIDLE_PRIORITY ) && ( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES ) );
+
+        xNewQueue = xQueueCreateMutex( queueQUEUE_TYPE_MUTEX );
+
+        if( xNewQueue != NULL )
+        {
+            ( ( Queue_t * ) xNewQueue )->u.xSemaphore.uxCeilingPriority = uxCeilingPriority;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xNewQueue;
+    }
+
+#endif /* ( ( configUSE_CEILING_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_CEILING_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateCeilingMutexStatic( const UBaseType_t uxCeilingPriority,
+                                                  StaticQueue_t * pxStaticQueue )
+    {
+        QueueHandle_t xNewQueue;
+
+        configASSERT( ( uxCeilingPriority > tskIDLE_PRIORITY ) && ( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES ) );
+
+        xNewQueue = xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, pxStaticQueue );
+
+        if( xNewQueue != NULL )
+        {
+            ( ( Queue_t * ) xNewQueue )->u.xSemaphore.uxCeilingPriority = uxCeilingPriority;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xNewQueue;
+    }
+
+#endif /* ( ( configUSE_CEILING_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
 
     TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
@@ -844,6 +1162,13 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
     configASSERT( pxQueue );
     configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
     configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+    {
+        /* Only priority queues take a priority, and they only take a
+         * priority or queueSEND_TO_BACK. */
+        configASSERT( ( xCopyPosition == queueSEND_TO_BACK ) || ( ( xCopyPosition >= queueSEND_WITH_PRIORITY( 0 ) ) == ( pxQueue->ucIsPriorityQueue != pdFALSE ) ) );
+    }
+    #endif
     #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
     {
         configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
@@ -865,6 +1190,12 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
             {
                 traceQUEUE_SEND( pxQueue );
 
+                #if ( configUSE_WAITSETS == 1 )
+                {
+                    prvNotifyWaitSet( pxQueue );
+                }
+                #endif
+
                 #if ( configUSE_QUEUE_SETS == 1 )
                 {
                     const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
@@ -896,7 +1227,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                     {
                         /* If there was a task waiting for data to arrive on the
                          * queue then unblock it now. */
-                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        if( taskEVENT_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                         {
                             if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                             {
@@ -931,7 +1262,7 @@ BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
 
                     /* If there was a task waiting for data to arrive on the
                      * queue then unblock it now. */
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    if( taskEVENT_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
                         if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                         {
@@ -1056,6 +1387,13 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
     configASSERT( pxQueue );
     configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
     configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+    {
+        /* Only priority queues take a priority, and they only take a
+         * priority or queueSEND_TO_BACK. */
+        configASSERT( ( xCopyPosition == queueSEND_TO_BACK ) || ( ( xCopyPosition >= queueSEND_WITH_PRIORITY( 0 ) ) == ( pxQueue->ucIsPriorityQueue != pdFALSE ) ) );
+    }
+    #endif
 
     /* RTOS ports that support interrupt nesting have the concept of a maximum
      * system call (or maximum API call) interrupt priority.  Interrupts that are
@@ -1087,6 +1425,12 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
 
             traceQUEUE_SEND_FROM_ISR( pxQueue );
 
+            #if ( configUSE_WAITSETS == 1 )
+            {
+                prvNotifyWaitSetFromISR( pxQueue, pxHigherPriorityTaskWoken );
+            }
+            #endif
+
             /* Semaphores use xQueueGiveFromISR(), so pxQueue will not be a
              *  semaphore or mutex.  That means prvCopyDataToQueue() cannot result
              *  in a task disinheriting a priority and prvCopyDataToQueue() can be
@@ -1130,7 +1474,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
                     }
                     else
                     {
-                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        if( taskEVENT_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                         {
                             if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                             {
@@ -1158,7 +1502,7 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
                 }
                 #else /* configUSE_QUEUE_SETS */
                 {
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    if( taskEVENT_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
                         if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                         {
@@ -1262,6 +1606,12 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
 
             traceQUEUE_SEND_FROM_ISR( pxQueue );
 
+            #if ( configUSE_WAITSETS == 1 )
+            {
+                prvNotifyWaitSetFromISR( pxQueue, pxHigherPriorityTaskWoken );
+            }
+            #endif
+
             /* A task can only have an inherited priority if it is a mutex
              * holder - and if there is a mutex holder then the mutex cannot be
              * given from an ISR.  As this is the ISR version of the function it
@@ -1299,7 +1649,7 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
                     }
                     else
                     {
-                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        if( taskEVENT_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                         {
                             if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                             {
@@ -1327,7 +1677,7 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
                 }
                 #else /* configUSE_QUEUE_SETS */
                 {
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    if( taskEVENT_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
                         if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                         {
@@ -1375,59 +1725,67 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueReceive( QueueHandle_t xQueue,
-                          void * const pvBuffer,
-                          TickType_t xTicksToWait )
+UBaseType_t uxQueueSendBatch( QueueHandle_t xQueue,
+                              const void * const pvItemsToQueue,
+                              const UBaseType_t uxItemCount,
+                              TickType_t xTicksToWait )
 {
     BaseType_t xEntryTimeSet = pdFALSE;
     TimeOut_t xTimeOut;
+    UBaseType_t uxItemsToCopy;
     Queue_t * const pxQueue = xQueue;
 
-    /* Check the pointer is not NULL. */
-    configASSERT( ( pxQueue ) );
-
-    /* The buffer into which data is received can only be NULL if the data size
-     * is zero (so no data is copied into the buffer). */
-    configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    configASSERT( pxQueue );
+    configASSERT( pvItemsToQueue != NULL );
+    configASSERT( uxItemCount > ( UBaseType_t ) 0 );
 
-    /* Cannot block if the scheduler is suspended. */
+    /* Semaphores and mutexes carry no data, so cannot be given in batches. */
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
     #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
     {
         configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
     }
     #endif
 
-    /*lint -save -e904  This function relaxes the coding standard somewhat to
+    /*lint -save -e904 This function relaxes the coding standard somewhat to
      * allow return statements within the function itself.  This is done in the
      * interest of execution time efficiency. */
     for( ; ; )
     {
         taskENTER_CRITICAL();
         {
-            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
-
-            /* Is there data in the queue now?  To be running the calling task
-             * must be the highest priority task wanting to access the queue. */
-            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            /* Is there room for at least one item?  If so post as many items
+             * as there is room for, then wake the receivers and make the yield
+             * decision once for the whole batch. */
+            if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
             {
-                /* Data available, remove one item. */
-                prvCopyDataFromQueue( pxQueue, pvBuffer );
-                traceQUEUE_RECEIVE( pxQueue );
-                pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+                uxItemsToCopy = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
 
-                /* There is now space in the queue, were any tasks waiting to
-                 * post to the queue?  If so, unblock the highest priority waiting
-                 * task. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                if( uxItemsToCopy > uxItemCount )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
-                    {
-                        queueYIELD_IF_USING_PREEMPTION();
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                    uxItemsToCopy = uxItemCount;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                traceQUEUE_SEND( pxQueue );
+
+                #if ( configUSE_WAITSETS == 1 )
+                {
+                    prvNotifyWaitSet( pxQueue );
+                }
+                #endif
+
+                prvCopyBatchToQueue( pxQueue, ( const int8_t * ) pvItemsToQueue, uxItemsToCopy );
+
+                if( prvUnblockReceiversAfterBatch( pxQueue, uxItemsToCopy ) != pdFALSE )
+                {
+                    /* A task with a priority higher than our own was unblocked,
+                     * so yield.  Yes it is ok to do this from within the
+                     * critical section - the kernel takes care of that. */
+                    queueYIELD_IF_USING_PREEMPTION();
                 }
                 else
                 {
@@ -1435,21 +1793,21 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                 }
 
                 taskEXIT_CRITICAL();
-                return pdPASS;
+                return uxItemsToCopy;
             }
             else
             {
                 if( xTicksToWait == ( TickType_t ) 0 )
                 {
-                    /* The queue was empty and no block time is specified (or
+                    /* The queue was full and no block time is specified (or
                      * the block time has expired) so leave now. */
                     taskEXIT_CRITICAL();
-                    traceQUEUE_RECEIVE_FAILED( pxQueue );
-                    return errQUEUE_EMPTY;
+                    traceQUEUE_SEND_FAILED( pxQueue );
+                    return ( UBaseType_t ) 0;
                 }
                 else if( xEntryTimeSet == pdFALSE )
                 {
-                    /* The queue was empty and a block time was specified so
+                    /* The queue was full and a block time was specified so
                      * configure the timeout structure. */
                     vTaskInternalSetTimeOutState( &xTimeOut );
                     xEntryTimeSet = pdTRUE;
@@ -1472,12 +1830,10 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
         /* Update the timeout state to see if it has expired yet. */
         if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
         {
-            /* The timeout has not expired.  If the queue is still empty place
-             * the task on the list of tasks waiting to receive from the queue. */
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            if( prvIsQueueFull( pxQueue ) != pdFALSE )
             {
-                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
                 prvUnlockQueue( pxQueue );
 
                 if( xTaskResumeAll() == pdFALSE )
@@ -1491,56 +1847,278 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
             }
             else
             {
-                /* The queue contains data again.  Loop back to try and read the
-                 * data. */
+                /* Try again. */
                 prvUnlockQueue( pxQueue );
                 ( void ) xTaskResumeAll();
             }
         }
         else
         {
-            /* Timed out.  If there is no data in the queue exit, otherwise loop
-             * back and attempt to read the data. */
+            /* The timeout has expired. */
             prvUnlockQueue( pxQueue );
             ( void ) xTaskResumeAll();
 
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
-            {
-                traceQUEUE_RECEIVE_FAILED( pxQueue );
-                return errQUEUE_EMPTY;
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+            traceQUEUE_SEND_FAILED( pxQueue );
+            return ( UBaseType_t ) 0;
         }
     } /*lint -restore */
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
-                                TickType_t xTicksToWait )
+UBaseType_t uxQueueSendBatchFromISR( QueueHandle_t xQueue,
+                                     const void * const pvItemsToQueue,
+                                     const UBaseType_t uxItemCount,
+                                     BaseType_t * const pxHigherPriorityTaskWoken )
 {
-    BaseType_t xEntryTimeSet = pdFALSE;
-    TimeOut_t xTimeOut;
+    UBaseType_t uxReturn = ( UBaseType_t ) 0;
+    UBaseType_t uxSavedInterruptStatus, uxLockIncrements;
     Queue_t * const pxQueue = xQueue;
 
-    #if ( configUSE_MUTEXES == 1 )
-        BaseType_t xInheritanceOccurred = pdFALSE;
-    #endif
-
-    /* Check the queue pointer is not NULL. */
-    configASSERT( ( pxQueue ) );
+    configASSERT( pxQueue );
+    configASSERT( pvItemsToQueue != NULL );
+    configASSERT( uxItemCount > ( UBaseType_t ) 0 );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
 
-    /* Check this really is a semaphore, in which case the item size will be
-     * 0. */
-    configASSERT( pxQueue->uxItemSize == 0 );
+    /* See the comment in xQueueGenericSendFromISR(). */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    /* Cannot block if the scheduler is suspended. */
-    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
     {
-        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
-    }
+        if( pxQueue->uxMessagesWaiting < pxQueue->uxLength )
+        {
+            int8_t cTxLock = pxQueue->cTxLock;
+
+            uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+
+            if( uxReturn > uxItemCount )
+            {
+                uxReturn = uxItemCount;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+            #if ( configUSE_WAITSETS == 1 )
+            {
+                prvNotifyWaitSetFromISR( pxQueue, pxHigherPriorityTaskWoken );
+            }
+            #endif
+
+            /* pxQueue is not a mutex, so no priority can be disinherited. */
+            prvCopyBatchToQueue( pxQueue, ( const int8_t * ) pvItemsToQueue, uxReturn );
+
+            /* The event list is not altered if the queue is locked.  This will
+             * be done when the queue is unlocked later. */
+            if( cTxLock == queueUNLOCKED )
+            {
+                if( prvUnblockReceiversAfterBatch( pxQueue, uxReturn ) != pdFALSE )
+                {
+                    if( pxHigherPriorityTaskWoken != NULL )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* Increment the lock count once per item so the task that
+                 * unlocks the queue unblocks as many receivers as an item at a
+                 * time post would have. */
+                for( uxLockIncrements = ( UBaseType_t ) 0; uxLockIncrements < uxReturn; uxLockIncrements++ )
+                {
+                    prvIncrementQueueTxLock( pxQueue, cTxLock );
+                    cTxLock = pxQueue->cTxLock;
+                }
+            }
+        }
+        else
+        {
+            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceive( QueueHandle_t xQueue,
+                          void * const pvBuffer,
+                          TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    Queue_t * const pxQueue = xQueue;
+
+    /* Check the pointer is not NULL. */
+    configASSERT( ( pxQueue ) );
+
+    /* The buffer into which data is received can only be NULL if the data size
+     * is zero (so no data is copied into the buffer). */
+    configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
+
+    /* Cannot block if the scheduler is suspended. */
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    /*lint -save -e904  This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself.  This is done in the
+     * interest of execution time efficiency. */
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+            /* Is there data in the queue now?  To be running the calling task
+             * must be the highest priority task wanting to access the queue. */
+            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            {
+                /* Data available, remove one item. */
+                prvCopyDataFromQueue( pxQueue, pvBuffer );
+                traceQUEUE_RECEIVE( pxQueue );
+                pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+
+                /* There is now space in the queue, were any tasks waiting to
+                 * post to the queue?  If so, unblock the highest priority waiting
+                 * task. */
+                if( taskEVENT_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                taskEXIT_CRITICAL();
+                return pdPASS;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue was empty and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    taskEXIT_CRITICAL();
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    return errQUEUE_EMPTY;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    /* The queue was empty and a block time was specified so
+                     * configure the timeout structure. */
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /* Interrupts and other tasks can send to and receive from the queue
+         * now the critical section has been exited. */
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        /* Update the timeout state to see if it has expired yet. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            /* The timeout has not expired.  If the queue is still empty place
+             * the task on the list of tasks waiting to receive from the queue. */
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* The queue contains data again.  Loop back to try and read the
+                 * data. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* Timed out.  If there is no data in the queue exit, otherwise loop
+             * back and attempt to read the data. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceQUEUE_RECEIVE_FAILED( pxQueue );
+                return errQUEUE_EMPTY;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
+                                TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    Queue_t * const pxQueue = xQueue;
+
+    #if ( configUSE_MUTEXES == 1 )
+        BaseType_t xInheritanceOccurred = pdFALSE;
+    #endif
+
+    /* Check the queue pointer is not NULL. */
+    configASSERT( ( pxQueue ) );
+
+    /* Check this really is a semaphore, in which case the item size will be
+     * 0. */
+    configASSERT( pxQueue->uxItemSize == 0 );
+
+    /* Cannot block if the scheduler is suspended. */
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
     #endif
 
     /*lint -save -e904 This function relaxes the coding standard somewhat to allow return
@@ -1571,6 +2149,23 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
                         /* Record the information required to implement
                          * priority inheritance should it become necessary. */
                         pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+
+                        #if ( configUSE_CEILING_MUTEXES == 1 )
+                        {
+                            /* The holder of a priority ceiling mutex runs at the
+                             * ceiling from now until it gives back the last mutex
+                             * it holds, so no task that uses the mutex can
+                             * preempt it, and it never has to inherit. */
+                            if( queueUSES_PRIORITY_INHERITANCE( pxQueue ) == pdFALSE )
+                            {
+                                vTaskPriorityRaiseToCeiling( pxQueue->u.xSemaphore.uxCeilingPriority );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif /* configUSE_CEILING_MUTEXES */
                     }
                     else
                     {
@@ -1581,7 +2176,7 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
 
                 /* Check to see if other tasks are blocked waiting to give the
                  * semaphore, and if so, unblock the highest priority such task. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                if( taskEVENT_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
                 {
                     if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
                     {
@@ -1645,7 +2240,9 @@ BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
 
                 #if ( configUSE_MUTEXES == 1 )
                 {
-                    if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                    /* The holder of a priority ceiling mutex already runs at
+                     * or above the priority of any task that can take it. */
+                    if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( queueUSES_PRIORITY_INHERITANCE( pxQueue ) != pdFALSE ) )
                     {
                         taskENTER_CRITICAL();
                         {
@@ -1734,7 +2331,6 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
 {
     BaseType_t xEntryTimeSet = pdFALSE;
     TimeOut_t xTimeOut;
-    int8_t * pcOriginalReadPosition;
     Queue_t * const pxQueue = xQueue;
 
     /* Check the pointer is not NULL. */
@@ -1764,20 +2360,14 @@ BaseType_t xQueuePeek( QueueHandle_t xQueue,
              * must be the highest priority task wanting to access the queue. */
             if( uxMessagesWaiting > ( UBaseType_t ) 0 )
             {
-                /* Remember the read position so it can be reset after the data
-                 * is read from the queue as this function is only peeking the
-                 * data, not removing it. */
-                pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
-
-                prvCopyDataFromQueue( pxQueue, pvBuffer );
+                /* The data is not being removed, so the read position is
+                 * left unchanged. */
+                prvPeekDataFromQueue( pxQueue, pvBuffer );
                 traceQUEUE_PEEK( pxQueue );
 
-                /* The data is not being removed, so reset the read pointer. */
-                pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
-
                 /* The data is being left in the queue, so see if there are
                  * any other tasks waiting for the data. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                if( taskEVENT_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                 {
                     if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                     {
@@ -1926,7 +2516,7 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
              * locked. */
             if( cRxLock == queueUNLOCKED )
             {
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                if( taskEVENT_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
                 {
                     if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
                     {
@@ -1972,29 +2562,254 @@ BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
-                              void * const pvBuffer )
+UBaseType_t uxQueueReceiveBatch( QueueHandle_t xQueue,
+                                 void * const pvBuffer,
+                                 const UBaseType_t uxMaxItems,
+                                 TickType_t xTicksToWait )
 {
-    BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
-    int8_t * pcOriginalReadPosition;
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    UBaseType_t uxItemsToCopy;
     Queue_t * const pxQueue = xQueue;
 
-    configASSERT( pxQueue );
-    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
-    configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
+    configASSERT( ( pxQueue ) );
+    configASSERT( pvBuffer != NULL );
+    configASSERT( uxMaxItems > ( UBaseType_t ) 0 );
 
-    /* RTOS ports that support interrupt nesting have the concept of a maximum
-     * system call (or maximum API call) interrupt priority.  Interrupts that are
-     * above the maximum system call priority are kept permanently enabled, even
-     * when the RTOS kernel is in a critical section, but cannot make any calls to
-     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-     * failure if a FreeRTOS API function is called from an interrupt that has been
-     * assigned a priority above the configured maximum system call priority.
-     * Only FreeRTOS functions that end in FromISR can be called from interrupts
-     * that have been assigned a priority at or (logically) below the maximum
-     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
+    /* Semaphores and mutexes carry no data, so cannot be taken in batches. */
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+    /* Cannot block if the scheduler is suspended. */
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    /*lint -save -e904  This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself.  This is done in the
+     * interest of execution time efficiency. */
+    for( ; ; )
+    {
+        taskENTER_CRITICAL();
+        {
+            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+            /* Is there data in the queue now?  If so remove as many items as
+             * will fit in the buffer, then wake the senders and make the yield
+             * decision once for the whole batch. */
+            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            {
+                if( uxMessagesWaiting < uxMaxItems )
+                {
+                    uxItemsToCopy = uxMessagesWaiting;
+                }
+                else
+                {
+                    uxItemsToCopy = uxMaxItems;
+                }
+
+                prvCopyBatchFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxItemsToCopy );
+                traceQUEUE_RECEIVE( pxQueue );
+                pxQueue->uxMessagesWaiting = uxMessagesWaiting - uxItemsToCopy;
+
+                if( prvUnblockSendersAfterBatch( pxQueue, uxItemsToCopy ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                taskEXIT_CRITICAL();
+                return uxItemsToCopy;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue was empty and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    taskEXIT_CRITICAL();
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    return ( UBaseType_t ) 0;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    /* The queue was empty and a block time was specified so
+                     * configure the timeout structure. */
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        /* Interrupts and other tasks can send to and receive from the queue
+         * now the critical section has been exited. */
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        /* Update the timeout state to see if it has expired yet. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            /* The timeout has not expired.  If the queue is still empty place
+             * the task on the list of tasks waiting to receive from the queue. */
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* The queue contains data again.  Loop back to try and read the
+                 * data. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* Timed out.  If there is no data in the queue exit, otherwise loop
+             * back and attempt to read the data. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceQUEUE_RECEIVE_FAILED( pxQueue );
+                return ( UBaseType_t ) 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueReceiveBatchFromISR( QueueHandle_t xQueue,
+                                        void * const pvBuffer,
+                                        const UBaseType_t uxMaxItems,
+                                        BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    UBaseType_t uxReturn = ( UBaseType_t ) 0;
+    UBaseType_t uxSavedInterruptStatus, uxLockIncrements;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    configASSERT( pvBuffer != NULL );
+    configASSERT( uxMaxItems > ( UBaseType_t ) 0 );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+    /* See the comment in xQueueReceiveFromISR(). */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+        /* Cannot block in an ISR, so check there is data available. */
+        if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+        {
+            int8_t cRxLock = pxQueue->cRxLock;
+
+            if( uxMessagesWaiting < uxMaxItems )
+            {
+                uxReturn = uxMessagesWaiting;
+            }
+            else
+            {
+                uxReturn = uxMaxItems;
+            }
+
+            traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+            prvCopyBatchFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxReturn );
+            pxQueue->uxMessagesWaiting = uxMessagesWaiting - uxReturn;
+
+            /* If the queue is locked the event list will not be modified.
+             * Instead update the lock count once per item so the task that
+             * unlocks the queue will unblock as many senders as an item at a
+             * time receive would have. */
+            if( cRxLock == queueUNLOCKED )
+            {
+                if( prvUnblockSendersAfterBatch( pxQueue, uxReturn ) != pdFALSE )
+                {
+                    if( pxHigherPriorityTaskWoken != NULL )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                for( uxLockIncrements = ( UBaseType_t ) 0; uxLockIncrements < uxReturn; uxLockIncrements++ )
+                {
+                    prvIncrementQueueRxLock( pxQueue, cRxLock );
+                    cRxLock = pxQueue->cRxLock;
+                }
+            }
+        }
+        else
+        {
+            traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
+                              void * const pvBuffer )
+{
+    BaseType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
+
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+     * failure if a FreeRTOS API function is called from an interrupt that has been
+     * assigned a priority above the configured maximum system call priority.
+     * Only FreeRTOS functions that end in FromISR can be called from interrupts
+     * that have been assigned a priority at or (logically) below the maximum
+     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
      * safe API to ensure interrupt entry is as fast and as simple as possible.
      * More information (albeit Cortex-M specific) is provided on the following
      * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
@@ -2007,11 +2822,9 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
         {
             traceQUEUE_PEEK_FROM_ISR( pxQueue );
 
-            /* Remember the read position so it can be reset as nothing is
-             * actually being removed from the queue. */
-            pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
-            prvCopyDataFromQueue( pxQueue, pvBuffer );
-            pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+            /* Nothing is actually being removed from the queue, so the read
+             * position is left unchanged. */
+            prvPeekDataFromQueue( pxQueue, pvBuffer );
 
             xReturn = pdPASS;
         }
@@ -2029,34 +2842,23 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
 
 UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
 {
-    UBaseType_t uxReturn;
-
     configASSERT( xQueue );
 
-    taskENTER_CRITICAL();
-    {
-        uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
-    }
-    taskEXIT_CRITICAL();
-
-    return uxReturn;
+    /* A critical section is not required because the count is of type
+     * UBaseType_t. */
+    return ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
 } /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
 /*-----------------------------------------------------------*/
 
 UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
 {
-    UBaseType_t uxReturn;
     Queue_t * const pxQueue = xQueue;
 
     configASSERT( pxQueue );
 
-    taskENTER_CRITICAL();
-    {
-        uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
-    }
-    taskEXIT_CRITICAL();
-
-    return uxReturn;
+    /* A critical section is not required because the length does not change
+     * and the count is of type UBaseType_t. */
+    return pxQueue->uxLength - pxQueue->uxMessagesWaiting;
 } /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
 /*-----------------------------------------------------------*/
 
@@ -2065,214 +2867,651 @@ UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
     UBaseType_t uxReturn;
     Queue_t * const pxQueue = xQueue;
 
-    configASSERT( pxQueue );
-    uxReturn = pxQueue->uxMessagesWaiting;
+    configASSERT( pxQueue );
+    uxReturn = pxQueue->uxMessagesWaiting;
+
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( QueueHandle_t xQueue )
+{
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    traceQUEUE_DELETE( pxQueue );
+
+    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+    {
+        vQueueUnregisterQueue( pxQueue );
+    }
+    #endif
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+    {
+        /* The queue can only have been allocated dynamically - free it
+         * again. */
+        vPortFree( pxQueue );
+    }
+    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    {
+        /* The queue could have been allocated statically or dynamically, so
+         * check before attempting to free the memory. */
+        if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+        {
+            vPortFree( pxQueue );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
+    {
+        /* The queue must have been statically allocated, so is not going to be
+         * deleted.  Avoid compiler warnings about the unused parameter. */
+        ( void ) pxQueue;
+    }
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
+    {
+        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    void vQueueSetQueueNumber( QueueHandle_t xQueue,
+                               UBaseType_t uxQueueNumber )
+    {
+        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+    {
+        return ( ( Queue_t * ) xQueue )->ucQueueType;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( Queue_t * const pxQueue )
+    {
+        UBaseType_t uxHighestPriorityOfWaitingTasks;
+
+        /* If a task waiting for a mutex causes the mutex holder to inherit a
+         * priority, but the waiting task times out, then the holder should
+         * disinherit the priority - but only down to the highest priority of any
+         * other tasks that are waiting for the same mutex.  For this purpose,
+         * return the priority of the highest priority task that is waiting for the
+         * mutex. */
+        #if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+        {
+            uxHighestPriorityOfWaitingTasks = uxTaskEventListGetHighestPriority( &( pxQueue->xTasksWaitingToReceive ) );
+        }
+        #else
+        {
+            if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
+            {
+                uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) );
+            }
+            else
+            {
+                uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+            }
+        }
+        #endif /* configUSE_PRIORITY_EVENT_LISTS */
+
+        return uxHighestPriorityOfWaitingTasks;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
+                                      const void * pvItemToQueue,
+                                      const BaseType_t xPosition )
+{
+    BaseType_t xReturn = pdFALSE;
+    UBaseType_t uxMessagesWaiting;
+
+    /* This function is called from a critical section. */
+
+    uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+    if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
+    {
+        #if ( configUSE_MUTEXES == 1 )
+        {
+            if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+            {
+                /* The mutex is no longer being held.  This also returns the
+                 * holder from the ceiling of a priority ceiling mutex. */
+                xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+                pxQueue->u.xSemaphore.xMutexHolder = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_MUTEXES */
+    }
+
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+        else if( pxQueue->ucIsPriorityQueue != pdFALSE )
+        {
+            /* queueSEND_TO_BACK, as used by xQueueSend(), sends at the lowest
+             * priority. */
+            if( xPosition >= queueSEND_WITH_PRIORITY( 0 ) )
+            {
+                prvPriorityQueueInsert( pxQueue, pvItemToQueue, ( UBaseType_t ) ( xPosition - queueSEND_WITH_PRIORITY( 0 ) ), uxMessagesWaiting );
+            }
+            else
+            {
+                prvPriorityQueueInsert( pxQueue, pvItemToQueue, ( UBaseType_t ) 0U, uxMessagesWaiting );
+            }
+        }
+    #endif /* configUSE_PRIORITY_QUEUES */
+    else if( xPosition == queueSEND_TO_BACK )
+    {
+        prvCopyItem( pxQueue, ( void * ) pxQueue->pcWriteTo, pvItemToQueue );
+        pxQueue->pcWriteTo += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+        {
+            pxQueue->pcWriteTo = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        prvCopyItem( pxQueue, ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue );
+        pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
+
+        if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+        {
+            pxQueue->u.xQueue.pcReadFrom = ( pxQueue->u.xQueue.pcTail - pxQueue->uxItemSize );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xPosition == queueOVERWRITE )
+        {
+            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            {
+                /* An item is not being added but overwritten, so subtract
+                 * one from the recorded number of items in the queue so when
+                 * one is added again below the number of recorded items remains
+                 * correct. */
+                --uxMessagesWaiting;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyDataFromQueue( Queue_t * const pxQueue,
+                                  void * const pvBuffer )
+{
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+        if( pxQueue->ucIsPriorityQueue != pdFALSE )
+        {
+            prvPriorityQueueRemove( pxQueue, pvBuffer, pxQueue->uxMessagesWaiting );
+        }
+        else
+    #endif /* configUSE_PRIORITY_QUEUES */
+    if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+    {
+        pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;           /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+        if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+        {
+            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        prvCopyItem( pxQueue, pvBuffer, ( const void * ) pxQueue->u.xQueue.pcReadFrom );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeekDataFromQueue( Queue_t * const pxQueue,
+                                  void * const pvBuffer )
+{
+    int8_t * pcOriginalReadPosition;
+
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+        if( pxQueue->ucIsPriorityQueue != pdFALSE )
+        {
+            /* The highest priority item is at the root of the heap. */
+            prvCopyItem( pxQueue, pvBuffer, ( const void * ) queuePRIORITY_ITEM( pxQueue, pxQueue->u.xPriority.pxHeap[ 0 ].uxItemIndex ) );
+        }
+        else
+    #endif /* configUSE_PRIORITY_QUEUES */
+    {
+        /* Remember the read position so it can be reset after the data is
+         * read from the queue, as the data is only being peeked, not
+         * removed. */
+        pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
+        prvCopyDataFromQueue( pxQueue, pvBuffer );
+        pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_QUEUES == 1 )
+
+    static void prvPriorityQueueInsert( Queue_t * const pxQueue,
+                                        const void * pvItemToQueue,
+                                        const UBaseType_t uxPriority,
+                                        const UBaseType_t uxMessagesWaiting )
+    {
+        PriorityQueueEntry_t * const pxHeap = pxQueue->u.xPriority.pxHeap;
+        PriorityQueueEntry_t xNewEntry;
+        UBaseType_t uxHole = uxMessagesWaiting, uxParent;
+
+        /* This function is called from a critical section.  The first entry
+         * past the heap holds a free slot, which the new item takes. */
+        xNewEntry.uxPriority = uxPriority;
+        xNewEntry.uxSequence = pxQueue->u.xPriority.uxNextSequence;
+        xNewEntry.uxItemIndex = pxHeap[ uxHole ].uxItemIndex;
+        pxQueue->u.xPriority.uxNextSequence++;
+
+        prvCopyItem( pxQueue, ( void * ) queuePRIORITY_ITEM( pxQueue, xNewEntry.uxItemIndex ), pvItemToQueue );
+
+        /* Move parents the new entry comes before down into the hole until
+         * the entry's place is found. */
+        while( uxHole > ( UBaseType_t ) 0U )
+        {
+            uxParent = ( uxHole - ( UBaseType_t ) 1U ) >> 1;
+
+            if( queuePRIORITY_ENTRY_FIRST( &xNewEntry, &( pxHeap[ uxParent ] ) ) )
+            {
+                pxHeap[ uxHole ] = pxHeap[ uxParent ];
+                uxHole = uxParent;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        pxHeap[ uxHole ] = xNewEntry;
+    }
+
+#endif /* configUSE_PRIORITY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_QUEUES == 1 )
+
+    static void prvPriorityQueueRemove( Queue_t * const pxQueue,
+                                        void * const pvBuffer,
+                                        const UBaseType_t uxMessagesWaiting )
+    {
+        PriorityQueueEntry_t * const pxHeap = pxQueue->u.xPriority.pxHeap;
+        const UBaseType_t uxNewCount = uxMessagesWaiting - ( UBaseType_t ) 1U;
+        const PriorityQueueEntry_t xRemovedEntry = pxHeap[ 0 ];
+        const PriorityQueueEntry_t xLastEntry = pxHeap[ uxNewCount ];
+        UBaseType_t uxHole = 0U, uxChild;
+
+        /* This function is called from a critical section. */
+        prvCopyItem( pxQueue, pvBuffer, ( const void * ) queuePRIORITY_ITEM( pxQueue, xRemovedEntry.uxItemIndex ) );
+
+        if( uxNewCount > ( UBaseType_t ) 0U )
+        {
+            /* Move children that come before the last entry up into the hole
+             * left at the root until the last entry's place is found. */
+            for( ; ; )
+            {
+                uxChild = ( uxHole << 1 ) + ( UBaseType_t ) 1U;
+
+                if( uxChild >= uxNewCount )
+                {
+                    break;
+                }
+
+                if( ( ( uxChild + ( UBaseType_t ) 1U ) < uxNewCount ) &&
+                    ( queuePRIORITY_ENTRY_FIRST( &( pxHeap[ uxChild + 1U ] ), &( pxHeap[ uxChild ] ) ) ) )
+                {
+                    uxChild++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( queuePRIORITY_ENTRY_FIRST( &( pxHeap[ uxChild ] ), &xLastEntry ) )
+                {
+                    pxHeap[ uxHole ] = pxHeap[ uxChild ];
+                    uxHole = uxChild;
+                }
+                else
+                {
+                    break;
+                }
+            }
+
+            pxHeap[ uxHole ] = xLastEntry;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The entry that was last in the heap is now the first free entry,
+         * and keeps the slot the removed item was in. */
+        pxHeap[ uxNewCount ].uxItemIndex = xRemovedEntry.uxItemIndex;
+    }
 
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+#endif /* configUSE_PRIORITY_QUEUES */
 /*-----------------------------------------------------------*/
 
-void vQueueDelete( QueueHandle_t xQueue )
-{
-    Queue_t * const pxQueue = xQueue;
-
-    configASSERT( pxQueue );
-    traceQUEUE_DELETE( pxQueue );
+#if ( ( configUSE_PRIORITY_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
-    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+    static BaseType_t prvPriorityQueueSizeIsValid( const UBaseType_t uxQueueLength,
+                                                   const UBaseType_t uxItemSize,
+                                                   const uint8_t ucQueueType )
     {
-        vQueueUnregisterQueue( pxQueue );
-    }
-    #endif
+        BaseType_t xReturn = pdTRUE;
+        size_t xBytesLeft;
 
-    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
-    {
-        /* The queue can only have been allocated dynamically - free it
-         * again. */
-        vPortFree( pxQueue );
-    }
-    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
-    {
-        /* The queue could have been allocated statically or dynamically, so
-         * check before attempting to free the memory. */
-        if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+        if( ucQueueType == queueQUEUE_TYPE_PRIORITY )
         {
-            vPortFree( pxQueue );
+            /* Rounding the items up to a UBaseType_t boundary adds less than
+             * one UBaseType_t, so the heap entries must fit in what is left
+             * after the Queue_t, the items and one UBaseType_t. */
+            xBytesLeft = SIZE_MAX - sizeof( Queue_t ) - ( ( size_t ) uxQueueLength * ( size_t ) uxItemSize );
+
+            if( ( xBytesLeft < sizeof( UBaseType_t ) ) ||
+                ( ( ( xBytesLeft - sizeof( UBaseType_t ) ) / ( 3U * sizeof( UBaseType_t ) ) ) < ( size_t ) uxQueueLength ) )
+            {
+                xReturn = pdFALSE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
-    }
-    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
-    {
-        /* The queue must have been statically allocated, so is not going to be
-         * deleted.  Avoid compiler warnings about the unused parameter. */
-        ( void ) pxQueue;
-    }
-    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-}
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_TRACE_FACILITY == 1 )
 
-    UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
-    {
-        return ( ( Queue_t * ) xQueue )->uxQueueNumber;
+        return xReturn;
     }
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* ( ( configUSE_PRIORITY_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+static void prvCopyItem( const Queue_t * const pxQueue,
+                         void * const pvDestination,
+                         const void * const pvSource )
+{
+    const uint8_t ucCopyType = pxQueue->ucCopyType;
 
-    void vQueueSetQueueNumber( QueueHandle_t xQueue,
-                               UBaseType_t uxQueueNumber )
+    /* The storage area was checked when the queue was created, but the
+     * caller's buffer can have any alignment. */
+    if( ( ucCopyType != queueCOPY_GENERIC ) &&
+        ( ( ( ( portPOINTER_SIZE_TYPE ) pvDestination | ( portPOINTER_SIZE_TYPE ) pvSource ) & queueCOPY_ALIGNMENT_MASK( ucCopyType ) ) == 0U ) ) /*lint !e923 !e9078 MISRA exception.  Avoiding casts between pointers and integers is not practical.  Size differences accounted for using portPOINTER_SIZE_TYPE type. */
     {
-        ( ( Queue_t * ) xQueue )->uxQueueNumber = uxQueueNumber;
-    }
+        switch( ucCopyType )
+        {
+            case sizeof( uint8_t ):
+                *( ( uint8_t * ) pvDestination ) = *( ( const uint8_t * ) pvSource );
+                break;
 
-#endif /* configUSE_TRACE_FACILITY */
-/*-----------------------------------------------------------*/
+            case sizeof( uint16_t ):
+                *( ( uint16_t * ) pvDestination ) = *( ( const uint16_t * ) pvSource ); /*lint !e9087 Alignment checked above. */
+                break;
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+            case sizeof( uint32_t ):
+                *( ( uint32_t * ) pvDestination ) = *( ( const uint32_t * ) pvSource ); /*lint !e9087 Alignment checked above. */
+                break;
 
-    uint8_t ucQueueGetQueueType( QueueHandle_t xQueue )
+            default:
+                /* Two 32-bit words, as only 32-bit alignment was checked. */
+                ( ( uint32_t * ) pvDestination )[ 0 ] = ( ( const uint32_t * ) pvSource )[ 0 ]; /*lint !e9087 Alignment checked above. */
+                ( ( uint32_t * ) pvDestination )[ 1 ] = ( ( const uint32_t * ) pvSource )[ 1 ]; /*lint !e9087 Alignment checked above. */
+                break;
+        }
+    }
+    else
     {
-        return ( ( Queue_t * ) xQueue )->ucQueueType;
+        ( void ) memcpy( pvDestination, pvSource, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Previous logic ensures a null pointer can only be passed to memcpy() when the item size is 0, in which case this function is not called. */
     }
-
-#endif /* configUSE_TRACE_FACILITY */
+}
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+static void prvCopyBatchToQueue( Queue_t * const pxQueue,
+                                 const int8_t * pcItems,
+                                 const UBaseType_t uxItemCount )
+{
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+        if( pxQueue->ucIsPriorityQueue != pdFALSE )
+        {
+            UBaseType_t uxItem;
+
+            /* Items sent in a batch take the lowest priority, like items
+             * sent with xQueueSend(). */
+            for( uxItem = 0; uxItem < uxItemCount; uxItem++ )
+            {
+                prvPriorityQueueInsert( pxQueue, ( const void * ) &( pcItems[ uxItem * pxQueue->uxItemSize ] ), ( UBaseType_t ) 0U, pxQueue->uxMessagesWaiting + uxItem );
+            }
 
-    static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
+            pxQueue->uxMessagesWaiting += uxItemCount;
+        }
+        else
+    #endif /* configUSE_PRIORITY_QUEUES */
     {
-        UBaseType_t uxHighestPriorityOfWaitingTasks;
+        size_t xBytes = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+        const size_t xBytesToEnd = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo ); /*lint !e946 !e947 !e9033 Pointer subtraction within the same storage area. */
 
-        /* If a task waiting for a mutex causes the mutex holder to inherit a
-         * priority, but the waiting task times out, then the holder should
-         * disinherit the priority - but only down to the highest priority of any
-         * other tasks that are waiting for the same mutex.  For this purpose,
-         * return the priority of the highest priority task that is waiting for the
-         * mutex. */
-        if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) ) > 0U )
+        /* This function is called from a critical section. */
+
+        if( xBytes >= xBytesToEnd )
         {
-            uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToReceive ) );
+            /* Fill to the end of the storage area, then continue from the start.
+             * Wrapping when the copy ends exactly at the tail leaves pcWriteTo at
+             * pcHead, as prvCopyDataToQueue() would. */
+            ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, xBytesToEnd ); /*lint !e961 !e418 !e9087 Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+            pcItems += xBytesToEnd;                                                                  /*lint !e9016 Pointer arithmetic on char types ok. */
+            xBytes -= xBytesToEnd;
+            pxQueue->pcWriteTo = pxQueue->pcHead;
         }
         else
         {
-            uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        return uxHighestPriorityOfWaitingTasks;
-    }
+        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, xBytes ); /*lint !e961 !e418 !e9087 Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        pxQueue->pcWriteTo += xBytes;                                                       /*lint !e9016 Pointer arithmetic on char types ok. */
 
-#endif /* configUSE_MUTEXES */
+        pxQueue->uxMessagesWaiting += uxItemCount;
+    }
+}
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
-                                      const void * pvItemToQueue,
-                                      const BaseType_t xPosition )
+static void prvCopyBatchFromQueue( Queue_t * const pxQueue,
+                                   int8_t * pcBuffer,
+                                   const UBaseType_t uxItemCount )
 {
-    BaseType_t xReturn = pdFALSE;
-    UBaseType_t uxMessagesWaiting;
-
-    /* This function is called from a critical section. */
-
-    uxMessagesWaiting = pxQueue->uxMessagesWaiting;
-
-    if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
-    {
-        #if ( configUSE_MUTEXES == 1 )
+    #if ( configUSE_PRIORITY_QUEUES == 1 )
+        if( pxQueue->ucIsPriorityQueue != pdFALSE )
         {
-            if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
-            {
-                /* The mutex is no longer being held. */
-                xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
-                pxQueue->u.xSemaphore.xMutexHolder = NULL;
-            }
-            else
+            UBaseType_t uxItem;
+
+            /* Items are removed one at a time, highest priority first. */
+            for( uxItem = 0; uxItem < uxItemCount; uxItem++ )
             {
-                mtCOVERAGE_TEST_MARKER();
+                prvPriorityQueueRemove( pxQueue, ( void * ) &( pcBuffer[ uxItem * pxQueue->uxItemSize ] ), pxQueue->uxMessagesWaiting - uxItem );
             }
         }
-        #endif /* configUSE_MUTEXES */
-    }
-    else if( xPosition == queueSEND_TO_BACK )
+        else
+    #endif /* configUSE_PRIORITY_QUEUES */
     {
-        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
-        pxQueue->pcWriteTo += pxQueue->uxItemSize;                                                       /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+        size_t xBytes = ( size_t ) uxItemCount * ( size_t ) pxQueue->uxItemSize;
+        int8_t * pcReadFrom = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok. */
+        size_t xBytesToEnd;
 
-        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )                                             /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+        /* This function is called from a critical section.  pcReadFrom points
+         * to the last item read, so the first item to read follows it. */
+        if( pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
         {
-            pxQueue->pcWriteTo = pxQueue->pcHead;
+            pcReadFrom = pxQueue->pcHead;
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
-    }
-    else
-    {
-        ( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
-        pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
 
-        if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+        xBytesToEnd = ( size_t ) ( pxQueue->u.xQueue.pcTail - pcReadFrom ); /*lint !e946 !e947 !e9033 Pointer subtraction within the same storage area. */
+
+        /* Only wrap if data remains to be read after the end of the storage area,
+         * so pcReadFrom is always left pointing at the last item read. */
+        if( xBytes > xBytesToEnd )
         {
-            pxQueue->u.xQueue.pcReadFrom = ( pxQueue->u.xQueue.pcTail - pxQueue->uxItemSize );
+            ( void ) memcpy( ( void * ) pcBuffer, ( const void * ) pcReadFrom, xBytesToEnd ); /*lint !e961 !e418 !e9087 Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+            pcBuffer += xBytesToEnd;                                                          /*lint !e9016 Pointer arithmetic on char types ok. */
+            xBytes -= xBytesToEnd;
+            pcReadFrom = pxQueue->pcHead;
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        if( xPosition == queueOVERWRITE )
+        ( void ) memcpy( ( void * ) pcBuffer, ( const void * ) pcReadFrom, xBytes ); /*lint !e961 !e418 !e9087 Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        pxQueue->u.xQueue.pcReadFrom = pcReadFrom + ( xBytes - ( size_t ) pxQueue->uxItemSize ); /*lint !e9016 Pointer arithmetic on char types ok. */
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockReceiversAfterBatch( Queue_t * const pxQueue,
+                                                 UBaseType_t uxItemCount )
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    /* This function is called from a critical section, and only when the
+     * queue is not locked. */
+
+    #if ( configUSE_QUEUE_SETS == 1 )
+    {
+        if( pxQueue->pxQueueSetContainer != NULL )
         {
-            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
-            {
-                /* An item is not being added but overwritten, so subtract
-                 * one from the recorded number of items in the queue so when
-                 * one is added again below the number of recorded items remains
-                 * correct. */
-                --uxMessagesWaiting;
-            }
-            else
+            /* The queue set holds one copy of the queue handle per item in
+             * the queue, so notify it once per item. */
+            while( uxItemCount > ( UBaseType_t ) 0 )
             {
-                mtCOVERAGE_TEST_MARKER();
+                if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                {
+                    xHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                --uxItemCount;
             }
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            /* Each item posted can satisfy one waiting receiver. */
+            while( ( uxItemCount > ( UBaseType_t ) 0 ) && ( taskEVENT_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+            {
+                if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                {
+                    xHigherPriorityTaskWoken = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                --uxItemCount;
+            }
         }
     }
+    #else /* configUSE_QUEUE_SETS */
+    {
+        /* Each item posted can satisfy one waiting receiver. */
+        while( ( uxItemCount > ( UBaseType_t ) 0 ) && ( taskEVENT_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+        {
+            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+            {
+                xHigherPriorityTaskWoken = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-    pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+            --uxItemCount;
+        }
+    }
+    #endif /* configUSE_QUEUE_SETS */
 
-    return xReturn;
+    return xHigherPriorityTaskWoken;
 }
 /*-----------------------------------------------------------*/
 
-static void prvCopyDataFromQueue( Queue_t * const pxQueue,
-                                  void * const pvBuffer )
+static BaseType_t prvUnblockSendersAfterBatch( Queue_t * const pxQueue,
+                                               UBaseType_t uxItemCount )
 {
-    if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
-    {
-        pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;           /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
-        if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+    /* This function is called from a critical section, and only when the
+     * queue is not locked. */
+    while( ( uxItemCount > ( UBaseType_t ) 0 ) && ( taskEVENT_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) )
+    {
+        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
         {
-            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+            xHigherPriorityTaskWoken = pdTRUE;
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        --uxItemCount;
     }
+
+    return xHigherPriorityTaskWoken;
 }
 /*-----------------------------------------------------------*/
 
@@ -2314,7 +3553,7 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
                     /* Tasks that are removed from the event list will get
                      * added to the pending ready list as the scheduler is still
                      * suspended. */
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    if( taskEVENT_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                     {
                         if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                         {
@@ -2337,7 +3576,7 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
             {
                 /* Tasks that are removed from the event list will get added to
                  * the pending ready list as the scheduler is still suspended. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                if( taskEVENT_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
                 {
                     if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
                     {
@@ -2371,7 +3610,7 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
 
         while( cRxLock > queueLOCKED_UNMODIFIED )
         {
-            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+            if( taskEVENT_LIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
             {
                 if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
                 {
@@ -3054,7 +4293,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 
             if( cTxLock == queueUNLOCKED )
             {
-                if( listLIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) == pdFALSE )
+                if( taskEVENT_LIST_IS_EMPTY( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) == pdFALSE )
                 {
                     if( xTaskRemoveFromEventList( &( pxQueueSetContainer->xTasksWaitingToReceive ) ) != pdFALSE )
                     {
@@ -3085,3 +4324,107 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
     }
 
 #endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WAITSETS == 1 )
+
+    static void prvNotifyWaitSet( const Queue_t * const pxQueue )
+    {
+        /* The owner is only notified when the queue becomes non-empty.  It
+         * reads the queue until it is empty each time it is notified, so any
+         * item sent to a queue that already holds items is read without a
+         * notification of its own. */
+        if( ( pxQueue->xWaitSetOwner != NULL ) && ( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 ) )
+        {
+            ( void ) xTaskNotifyIndexed( pxQueue->xWaitSetOwner, configWAITSET_NOTIFICATION_INDEX, pxQueue->ulWaitSetBits, eSetBits );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_WAITSETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WAITSETS == 1 )
+
+    static void prvNotifyWaitSetFromISR( const Queue_t * const pxQueue,
+                                         BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        /* Unlike the event lists, the owner is notified even when the queue is
+         * locked, as notifying a task does not touch the queue. */
+        if( ( pxQueue->xWaitSetOwner != NULL ) && ( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 ) )
+        {
+            ( void ) xTaskNotifyIndexedFromISR( pxQueue->xWaitSetOwner, configWAITSET_NOTIFICATION_INDEX, pxQueue->ulWaitSetBits, eSetBits, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_WAITSETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WAITSETS == 1 )
+
+    BaseType_t xQueueSetWaitSetMember( QueueHandle_t xQueue,
+                                       TaskHandle_t xOwner,
+                                       uint32_t ulBits )
+    {
+        Queue_t * const pxQueue = xQueue;
+        BaseType_t xReturn = pdFAIL;
+
+        configASSERT( pxQueue );
+        configASSERT( xOwner );
+
+        taskENTER_CRITICAL();
+        {
+            if( ulBits != 0UL )
+            {
+                if( pxQueue->xWaitSetOwner == NULL )
+                {
+                    pxQueue->xWaitSetOwner = xOwner;
+                    pxQueue->ulWaitSetBits = ulBits;
+
+                    /* Items that were sent before the queue was added are
+                     * posted now, so they are not missed. */
+                    if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+                    {
+                        ( void ) xTaskNotifyIndexed( xOwner, configWAITSET_NOTIFICATION_INDEX, ulBits, eSetBits );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    /* The queue is already in a waitset. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                if( pxQueue->xWaitSetOwner == xOwner )
+                {
+                    pxQueue->xWaitSetOwner = NULL;
+                    pxQueue->ulWaitSetBits = 0UL;
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    /* The queue is not in this waitset. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_WAITSETS */
@@ -0,0 +1,385 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "refqueue.h"
+
+/* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e9021 !e961 !e750. */
+
+
+/* This entire source file will be skipped if the application is not configured
+ * to include reference queues.  This #if is closed at the very bottom of this
+ * file.  If you want to include reference queues then ensure
+ * configUSE_REF_QUEUES is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_REF_QUEUES == 1 )
+
+/* The states held in pucSlotStates.  A slot moves from free to acquired to
+ * queued to received and back to free, or from acquired straight back to free
+ * if the sender releases it unused.  Each state is only written by the owner
+ * of the slot in the previous state, before the slot is passed on. */
+    #define refqueueSLOT_FREE        ( ( uint8_t ) 0 )
+    #define refqueueSLOT_ACQUIRED    ( ( uint8_t ) 1 )
+    #define refqueueSLOT_QUEUED      ( ( uint8_t ) 2 )
+    #define refqueueSLOT_RECEIVED    ( ( uint8_t ) 3 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the index of the slot that starts at pvSlot.  Fails configASSERT()
+ * if pvSlot is not the start of one of the slots of pxRefQueue.
+ */
+    static UBaseType_t prvGetSlotIndex( const RefQueue_t * pxRefQueue,
+                                        const void * pvSlot ) PRIVILEGED_FUNCTION;
+
+/*
+ * Checks that the slot at pvSlot is in state ucExpectedState, and if so moves
+ * it to state ucNewState.  Fails configASSERT() if it is in any other state.
+ * Returns the pointer to pass through the queue of free or queued slots.
+ */
+    static uint8_t * prvMoveSlot( const RefQueue_t * pxRefQueue,
+                                  void * pvSlot,
+                                  uint8_t ucExpectedState,
+                                  uint8_t ucNewState ) PRIVILEGED_FUNCTION;
+
+/*
+ * Moves the slot at pvSlot back to the free state, from either the received
+ * state or the acquired state, and returns the pointer to pass back to the
+ * queue of free slots.
+ */
+    static uint8_t * prvReleaseSlot( const RefQueue_t * pxRefQueue,
+                                     void * pvSlot ) PRIVILEGED_FUNCTION;
+
+/*
+ * Marks the slot taken from the queue of free or queued slots as belonging to
+ * the caller, or returns NULL if no slot was taken.
+ */
+    static void * prvTakeSlot( const RefQueue_t * pxRefQueue,
+                               BaseType_t xTaken,
+                               uint8_t * pucSlot,
+                               uint8_t ucExpectedState,
+                               uint8_t ucNewState ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    RefQueueHandle_t xRefQueueCreateStatic( UBaseType_t uxSlotCount,
+                                            size_t xSlotSize,
+                                            uint8_t * pucStorage,
+                                            RefQueue_t * pxRefQueueBuffer )
+    {
+        RefQueue_t * pxReturn = NULL;
+        uint8_t ** ppucFreeSlotStorage;
+        uint8_t * pucSlot;
+        UBaseType_t uxSlot;
+
+        configASSERT( uxSlotCount > ( UBaseType_t ) 0U );
+        configASSERT( xSlotSize > ( size_t ) 0U );
+        configASSERT( pucStorage != NULL );
+        configASSERT( pxRefQueueBuffer != NULL );
+
+        /* The slots are at the start of the storage, so they are aligned as
+         * the storage is. */
+        configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pucStorage ) & ( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) ) == 0U );
+
+        if( ( pucStorage != NULL ) && ( pxRefQueueBuffer != NULL ) )
+        {
+            pxRefQueueBuffer->pucSlots = pucStorage;
+            pxRefQueueBuffer->xSlotStride = refqueueSLOT_STRIDE( xSlotSize );
+            pxRefQueueBuffer->uxSlotCount = uxSlotCount;
+
+            /* The storage for the references held by the two queues follows
+             * the slots, which all have a stride that is a multiple of
+             * portBYTE_ALIGNMENT, so it is aligned for pointers.  The slot
+             * states follow the references. */
+            ppucFreeSlotStorage = ( uint8_t ** ) &( pucStorage[ uxSlotCount * pxRefQueueBuffer->xSlotStride ] ); /*lint !e9087 !e826 The storage is aligned for pointers, as explained above. */
+            pxRefQueueBuffer->pucSlotStates = ( uint8_t * ) &( ppucFreeSlotStorage[ 2U * uxSlotCount ] );
+
+            pxRefQueueBuffer->xFreeSlots = xQueueCreateStatic( uxSlotCount,
+                                                               ( UBaseType_t ) sizeof( uint8_t * ),
+                                                               ( uint8_t * ) ppucFreeSlotStorage,
+                                                               &( pxRefQueueBuffer->xFreeSlotsBuffer ) );
+            pxRefQueueBuffer->xQueuedSlots = xQueueCreateStatic( uxSlotCount,
+                                                                 ( UBaseType_t ) sizeof( uint8_t * ),
+                                                                 ( uint8_t * ) &( ppucFreeSlotStorage[ uxSlotCount ] ),
+                                                                 &( pxRefQueueBuffer->xQueuedSlotsBuffer ) );
+
+            /* Every slot starts in the pool.  The queue of free slots is
+             * created with room for all of them, so this cannot fail. */
+            for( uxSlot = ( UBaseType_t ) 0U; uxSlot < uxSlotCount; uxSlot++ )
+            {
+                pxRefQueueBuffer->pucSlotStates[ uxSlot ] = refqueueSLOT_FREE;
+                pucSlot = &( pucStorage[ uxSlot * pxRefQueueBuffer->xSlotStride ] );
+                ( void ) xQueueSendToBack( pxRefQueueBuffer->xFreeSlots, &pucSlot, ( TickType_t ) 0 );
+            }
+
+            pxReturn = pxRefQueueBuffer;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        RefQueueHandle_t xRefQueueCreate( UBaseType_t uxSlotCount,
+                                          size_t xSlotSize )
+        {
+            RefQueue_t * pxReturn = NULL;
+            uint8_t * pucAllocation;
+            size_t xControlBlockSize;
+
+            /* The control block and storage are allocated together, with the
+             * storage after the control block.  Round the size of the control
+             * block up so the storage is aligned to portBYTE_ALIGNMENT, as
+             * pvPortMalloc() aligns the allocation itself. */
+            xControlBlockSize = refqueueSLOT_STRIDE( sizeof( RefQueue_t ) );
+            pucAllocation = ( uint8_t * ) pvPortMalloc( xControlBlockSize + refqueueSTORAGE_SIZE( uxSlotCount, xSlotSize ) ); /*lint !e9087 !e9079 see comment above. */
+
+            if( pucAllocation != NULL )
+            {
+                pxReturn = xRefQueueCreateStatic( uxSlotCount, xSlotSize, &( pucAllocation[ xControlBlockSize ] ), ( RefQueue_t * ) pucAllocation ); /*lint !e9087 !e826 The allocation is aligned for the control block. */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return pxReturn;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    void * pvRefQueueAcquire( RefQueueHandle_t xRefQueue,
+                              TickType_t xTicksToWait )
+    {
+        uint8_t * pucSlot = NULL;
+        BaseType_t xTaken;
+
+        configASSERT( xRefQueue != NULL );
+
+        xTaken = xQueueReceive( xRefQueue->xFreeSlots, &pucSlot, xTicksToWait );
+
+        return prvTakeSlot( xRefQueue, xTaken, pucSlot, refqueueSLOT_FREE, refqueueSLOT_ACQUIRED );
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvRefQueueAcquireFromISR( RefQueueHandle_t xRefQueue )
+    {
+        uint8_t * pucSlot = NULL;
+        BaseType_t xTaken;
+
+        configASSERT( xRefQueue != NULL );
+
+        /* Nothing ever blocks waiting to send to the queue of free slots, so
+         * taking a slot from it cannot unblock a task. */
+        xTaken = xQueueReceiveFromISR( xRefQueue->xFreeSlots, &pucSlot, NULL );
+
+        return prvTakeSlot( xRefQueue, xTaken, pucSlot, refqueueSLOT_FREE, refqueueSLOT_ACQUIRED );
+    }
+/*-----------------------------------------------------------*/
+
+    void vRefQueueSend( RefQueueHandle_t xRefQueue,
+                        void * pvSlot )
+    {
+        uint8_t * pucSlot;
+
+        configASSERT( xRefQueue != NULL );
+
+        /* The state is updated before the slot is sent as the receiver may
+         * run, and update it again, before xQueueSendToBack() returns. */
+        pucSlot = prvMoveSlot( xRefQueue, pvSlot, refqueueSLOT_ACQUIRED, refqueueSLOT_QUEUED );
+
+        /* There is room in the queue for every slot, so this never has to
+         * block. */
+        ( void ) xQueueSendToBack( xRefQueue->xQueuedSlots, &pucSlot, ( TickType_t ) 0 );
+    }
+/*-----------------------------------------------------------*/
+
+    void vRefQueueSendFromISR( RefQueueHandle_t xRefQueue,
+                               void * pvSlot,
+                               BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        uint8_t * pucSlot;
+
+        configASSERT( xRefQueue != NULL );
+
+        pucSlot = prvMoveSlot( xRefQueue, pvSlot, refqueueSLOT_ACQUIRED, refqueueSLOT_QUEUED );
+
+        ( void ) xQueueSendToBackFromISR( xRefQueue->xQueuedSlots, &pucSlot, pxHigherPriorityTaskWoken );
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvRefQueueReceive( RefQueueHandle_t xRefQueue,
+                              TickType_t xTicksToWait )
+    {
+        uint8_t * pucSlot = NULL;
+        BaseType_t xTaken;
+
+        configASSERT( xRefQueue != NULL );
+
+        xTaken = xQueueReceive( xRefQueue->xQueuedSlots, &pucSlot, xTicksToWait );
+
+        return prvTakeSlot( xRefQueue, xTaken, pucSlot, refqueueSLOT_QUEUED, refqueueSLOT_RECEIVED );
+    }
+/*-----------------------------------------------------------*/
+
+    void vRefQueueRelease( RefQueueHandle_t xRefQueue,
+                           void * pvSlot )
+    {
+        uint8_t * pucSlot;
+
+        configASSERT( xRefQueue != NULL );
+
+        pucSlot = prvReleaseSlot( xRefQueue, pvSlot );
+
+        /* The pool has room for every slot, so this never has to block. */
+        ( void ) xQueueSendToBack( xRefQueue->xFreeSlots, &pucSlot, ( TickType_t ) 0 );
+    }
+/*-----------------------------------------------------------*/
+
+    void vRefQueueReleaseFromISR( RefQueueHandle_t xRefQueue,
+                                  void * pvSlot,
+                                  BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        uint8_t * pucSlot;
+
+        configASSERT( xRefQueue != NULL );
+
+        pucSlot = prvReleaseSlot( xRefQueue, pvSlot );
+
+        ( void ) xQueueSendToBackFromISR( xRefQueue->xFreeSlots, &pucSlot, pxHigherPriorityTaskWoken );
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxRefQueueSlotsWaiting( RefQueueHandle_t xRefQueue )
+    {
+        configASSERT( xRefQueue != NULL );
+
+        return uxQueueMessagesWaiting( xRefQueue->xQueuedSlots );
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxRefQueueSlotsFree( RefQueueHandle_t xRefQueue )
+    {
+        configASSERT( xRefQueue != NULL );
+
+        return uxQueueMessagesWaiting( xRefQueue->xFreeSlots );
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvGetSlotIndex( const RefQueue_t * pxRefQueue,
+                                        const void * pvSlot )
+    {
+        size_t xOffset;
+
+        /* Check pvSlot lies within the slots before subtracting, so a pointer
+         * into some other object cannot produce a valid looking offset. */
+        configASSERT( ( const uint8_t * ) pvSlot >= pxRefQueue->pucSlots );
+        configASSERT( ( const uint8_t * ) pvSlot < &( pxRefQueue->pucSlots[ pxRefQueue->uxSlotCount * pxRefQueue->xSlotStride ] ) );
+
+        xOffset = ( size_t ) ( ( const uint8_t * ) pvSlot - pxRefQueue->pucSlots );
+        configASSERT( ( xOffset % pxRefQueue->xSlotStride ) == 0U );
+
+        return ( UBaseType_t ) ( xOffset / pxRefQueue->xSlotStride );
+    }
+/*-----------------------------------------------------------*/
+
+    static uint8_t * prvMoveSlot( const RefQueue_t * pxRefQueue,
+                                  void * pvSlot,
+                                  uint8_t ucExpectedState,
+                                  uint8_t ucNewState )
+    {
+        const UBaseType_t uxSlot = prvGetSlotIndex( pxRefQueue, pvSlot );
+
+        /* A slot in any other state is owned by another task or interrupt, or
+         * is still in one of the queues. */
+        configASSERT( pxRefQueue->pucSlotStates[ uxSlot ] == ucExpectedState );
+        pxRefQueue->pucSlotStates[ uxSlot ] = ucNewState;
+
+        return ( uint8_t * ) pvSlot;
+    }
+/*-----------------------------------------------------------*/
+
+    static uint8_t * prvReleaseSlot( const RefQueue_t * pxRefQueue,
+                                     void * pvSlot )
+    {
+        uint8_t ucState;
+
+        /* A slot is normally released by its receiver, but the sender may
+         * also give back a slot it acquired and then did not need. */
+        if( pxRefQueue->pucSlotStates[ prvGetSlotIndex( pxRefQueue, pvSlot ) ] == refqueueSLOT_ACQUIRED )
+        {
+            ucState = refqueueSLOT_ACQUIRED;
+        }
+        else
+        {
+            ucState = refqueueSLOT_RECEIVED;
+        }
+
+        return prvMoveSlot( pxRefQueue, pvSlot, ucState, refqueueSLOT_FREE );
+    }
+/*-----------------------------------------------------------*/
+
+    static void * prvTakeSlot( const RefQueue_t * pxRefQueue,
+                               BaseType_t xTaken,
+                               uint8_t * pucSlot,
+                               uint8_t ucExpectedState,
+                               uint8_t ucNewState )
+    {
+        void * pvReturn = NULL;
+
+        if( xTaken != pdFALSE )
+        {
+            pvReturn = ( void * ) prvMoveSlot( pxRefQueue, pucSlot, ucExpectedState, ucNewState );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include reference queues.  If you want to include reference queues then
+ * ensure configUSE_REF_QUEUES is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_REF_QUEUES == 1 */
@@ -0,0 +1,331 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "spscring.h"
+
+/* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e9021 !e961 !e750. */
+
+
+/* This entire source file will be skipped if the application is not configured
+ * to include single producer, single consumer rings.  This #if is closed at the
+ * very bottom of this file.  If you want to include the rings then ensure
+ * configUSE_SPSC_RINGS is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_SPSC_RINGS == 1 )
+
+/*
+ * The ring needs no lock because each index has a single writer: the head is
+ * only written by the producer and the tail only by the consumer, and both are
+ * written with a single aligned store.  The producer writes an item before
+ * publishing it by advancing the head, and the consumer reads an item before
+ * freeing its slot by advancing the tail, with a memory barrier between the
+ * two in each case so neither the compiler nor the processor can reorder them.
+ * No read-modify-write of shared data is needed, so neither side ever retries
+ * and no exclusive access (LDREX/STREX) or interrupt masking is required.
+ */
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the number of items between the tail and the head.
+ */
+    static UBaseType_t prvItemsWaiting( const SpscRing_t * pxRing ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    SpscRingHandle_t xSpscRingCreateStatic( UBaseType_t uxLength,
+                                            size_t xItemSize,
+                                            UBaseType_t uxWakeLevel,
+                                            uint8_t * pucStorage,
+                                            SpscRing_t * pxRingBuffer )
+    {
+        SpscRing_t * pxReturn = NULL;
+
+        configASSERT( uxLength > ( UBaseType_t ) 0U );
+        configASSERT( xItemSize > ( size_t ) 0U );
+        configASSERT( ( uxWakeLevel > ( UBaseType_t ) 0U ) && ( uxWakeLevel <= uxLength ) );
+        configASSERT( pucStorage != NULL );
+        configASSERT( pxRingBuffer != NULL );
+
+        if( ( pucStorage != NULL ) && ( pxRingBuffer != NULL ) )
+        {
+            pxRingBuffer->uxHead = ( UBaseType_t ) 0U;
+            pxRingBuffer->uxTail = ( UBaseType_t ) 0U;
+            pxRingBuffer->uxSlots = uxLength + ( UBaseType_t ) 1U;
+            pxRingBuffer->xItemSize = xItemSize;
+            pxRingBuffer->pucStorage = pucStorage;
+            pxRingBuffer->uxWakeLevel = uxWakeLevel;
+            pxRingBuffer->xTaskWaiting = NULL;
+
+            pxReturn = pxRingBuffer;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        SpscRingHandle_t xSpscRingCreate( UBaseType_t uxLength,
+                                          size_t xItemSize,
+                                          UBaseType_t uxWakeLevel )
+        {
+            SpscRing_t * pxReturn = NULL;
+            uint8_t * pucAllocation;
+
+            /* The control block and storage are allocated together, with the
+             * storage after the control block.  Items are copied with memcpy()
+             * so the storage needs no particular alignment. */
+            pucAllocation = ( uint8_t * ) pvPortMalloc( sizeof( SpscRing_t ) + spscringSTORAGE_SIZE( uxLength, xItemSize ) ); /*lint !e9087 !e9079 see comment above. */
+
+            if( pucAllocation != NULL )
+            {
+                pxReturn = xSpscRingCreateStatic( uxLength, xItemSize, uxWakeLevel, &( pucAllocation[ sizeof( SpscRing_t ) ] ), ( SpscRing_t * ) pucAllocation ); /*lint !e9087 !e826 The allocation is aligned for the control block. */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return pxReturn;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    BaseType_t xSpscRingPush( SpscRingHandle_t xRing,
+                              const void * pvItem )
+    {
+        BaseType_t xReturn = pdFAIL;
+        UBaseType_t uxHead, uxNextHead;
+
+        configASSERT( xRing );
+        configASSERT( pvItem != NULL );
+
+        uxHead = xRing->uxHead;
+        uxNextHead = uxHead + ( UBaseType_t ) 1U;
+
+        if( uxNextHead == xRing->uxSlots )
+        {
+            uxNextHead = ( UBaseType_t ) 0U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The ring is full if advancing the head would make it equal to the
+         * tail, which would look the same as an empty ring. */
+        if( uxNextHead != xRing->uxTail )
+        {
+            ( void ) memcpy( ( void * ) &( xRing->pucStorage[ ( size_t ) uxHead * xRing->xItemSize ] ), pvItem, xRing->xItemSize ); /*lint !e961 !e418 !e9087 Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+
+            /* The item must be complete in memory before the consumer can see
+             * the new head. */
+            portMEMORY_BARRIER();
+            xRing->uxHead = uxNextHead;
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xSpscRingPushFromISR( SpscRingHandle_t xRing,
+                                     const void * pvItem,
+                                     BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        BaseType_t xReturn;
+        TaskHandle_t xTaskWaiting;
+
+        xReturn = xSpscRingPush( xRing, pvItem );
+
+        if( xReturn == pdPASS )
+        {
+            /* Only read the waiting task after publishing the item.  Either
+             * the consumer registered itself before the item was published, in
+             * which case it is seen here, or it will see the item when it
+             * checks the ring after registering - see xSpscRingReceive().  The
+             * consumer does not pop while it is registered, so the number of
+             * items waiting rises by one per push and passes the wake level
+             * exactly once. */
+            portMEMORY_BARRIER();
+            xTaskWaiting = xRing->xTaskWaiting;
+
+            if( ( xTaskWaiting != NULL ) && ( prvItemsWaiting( xRing ) == xRing->uxWakeLevel ) )
+            {
+                vTaskNotifyGiveFromISR( xTaskWaiting, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xSpscRingPop( SpscRingHandle_t xRing,
+                             void * pvBuffer )
+    {
+        BaseType_t xReturn = pdFAIL;
+        UBaseType_t uxTail, uxNextTail;
+
+        configASSERT( xRing );
+        configASSERT( pvBuffer != NULL );
+
+        uxTail = xRing->uxTail;
+
+        if( uxTail != xRing->uxHead )
+        {
+            /* Do not read the item until after the head that published it has
+             * been read. */
+            portMEMORY_BARRIER();
+            ( void ) memcpy( pvBuffer, ( const void * ) &( xRing->pucStorage[ ( size_t ) uxTail * xRing->xItemSize ] ), xRing->xItemSize ); /*lint !e961 !e418 !e9087 Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+
+            uxNextTail = uxTail + ( UBaseType_t ) 1U;
+
+            if( uxNextTail == xRing->uxSlots )
+            {
+                uxNextTail = ( UBaseType_t ) 0U;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The item must be read before the producer can overwrite it. */
+            portMEMORY_BARRIER();
+            xRing->uxTail = uxNextTail;
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xSpscRingReceive( SpscRingHandle_t xRing,
+                                 void * pvBuffer,
+                                 TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn;
+        TimeOut_t xTimeOut;
+
+        xReturn = xSpscRingPop( xRing, pvBuffer );
+
+        if( ( xReturn == pdFAIL ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+        {
+            vTaskSetTimeOutState( &xTimeOut );
+
+            /* Register to be woken, then check the ring again.  An item
+             * published before the registration is seen by the check, and the
+             * producer sees the registration for any item published after it. */
+            xRing->xTaskWaiting = xTaskGetCurrentTaskHandle();
+            portMEMORY_BARRIER();
+
+            while( ( prvItemsWaiting( xRing ) < xRing->uxWakeLevel ) &&
+                   ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) )
+            {
+                /* A notification left over from an earlier wake only causes
+                 * one extra pass round the loop, as it is cleared here. */
+                ( void ) ulTaskNotifyTake( pdTRUE, xTicksToWait );
+            }
+
+            xRing->xTaskWaiting = NULL;
+
+            /* Return an item if any arrived, even if the block time expired
+             * before the wake level was reached. */
+            xReturn = xSpscRingPop( xRing, pvBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxSpscRingItemsWaiting( SpscRingHandle_t xRing )
+    {
+        configASSERT( xRing );
+
+        return prvItemsWaiting( xRing );
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvItemsWaiting( const SpscRing_t * pxRing )
+    {
+        const UBaseType_t uxHead = pxRing->uxHead;
+        const UBaseType_t uxTail = pxRing->uxTail;
+        UBaseType_t uxItems;
+
+        if( uxHead >= uxTail )
+        {
+            uxItems = uxHead - uxTail;
+        }
+        else
+        {
+            uxItems = ( pxRing->uxSlots - uxTail ) + uxHead;
+        }
+
+        return uxItems;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include single producer, single consumer rings.  If you want to include
+ * the rings then ensure configUSE_SPSC_RINGS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_SPSC_RINGS == 1 */
@@ -217,6 +217,14 @@
 #define sbFLAGS_IS_MESSAGE_BUFFER          ( ( uint8_t ) 1 ) /* Set if the stream buffer was created as a message buffer, in which case it holds discrete messages rather than a stream. */
 #define sbFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 2 ) /* Set if the stream buffer was created using statically allocated memory. */
 
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+/* Stored in place of a message length to tell the reader that the rest of the
+ * storage area was skipped so a reserved message did not wrap, and that the
+ * next message starts at the beginning of the storage area. */
+    #define sbMESSAGE_PADDING    ( ( configMESSAGE_BUFFER_LENGTH_TYPE ) ~( ( configMESSAGE_BUFFER_LENGTH_TYPE ) 0 ) )
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* Structure that hold state information on the buffer. */
@@ -239,6 +247,22 @@ typedef struct StreamBufferDef_t                 /*lint !e9058 Style convention
         StreamBufferCallbackFunction_t pxSendCompletedCallback;    /* Optional callback called on send complete. sbSEND_COMPLETED is called if this is NULL. */
         StreamBufferCallbackFunction_t pxReceiveCompletedCallback; /* Optional callback called on receive complete.  sbRECEIVE_COMPLETED is called if this is NULL. */
     #endif
+
+    #if ( configUSE_WAITSETS == 1 )
+        TaskHandle_t xWaitSetOwner; /* The task that owns the waitset the stream buffer is a member of, or NULL if the stream buffer is not in a waitset. */
+        uint32_t ulWaitSetBits;     /* The bits posted to the waitset each time a send leaves at least the trigger level in the buffer. */
+    #endif
+
+    #if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+        size_t xReservedBytes; /* The number of bytes reserved by xStreamBufferSendReserve() and not yet committed. */
+    #endif
+
+    #if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+        TickType_t xTriggerTimeoutTicks;   /* The most ticks a task waiting for data stays blocked after the first byte arrives, or portMAX_DELAY to wait for the trigger level alone. */
+        BaseType_t xTriggerTimeoutStarted; /* Set once the block time of the task waiting for data has been limited to xTriggerTimeoutTicks. */
+        uint32_t ulLevelWakes;             /* The number of times a task waiting for data was unblocked by a send. */
+        uint32_t ulTimeoutWakes;           /* The number of times a task waiting for data was unblocked by the trigger timeout with less than the trigger level in the buffer. */
+    #endif
 } StreamBuffer_t;
 
 /*
@@ -304,6 +328,131 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
                                       size_t xCount,
                                       size_t xTail ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_WAITSETS == 1 )
+
+/*
+ * Checks to see if a stream buffer is a member of a waitset, and if so, posts
+ * the bits of the stream buffer to the task that owns the waitset.  Called
+ * each time a send leaves at least the trigger level in the buffer.
+ */
+    static void prvNotifyWaitSet( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+    static void prvNotifyWaitSetFromISR( const StreamBuffer_t * const pxStreamBuffer,
+                                         BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+/*
+ * Works out where a region of xDataLengthBytes would be reserved, given the
+ * current write position, and returns the amount of free space needed before
+ * it can be reserved.  For a message buffer this includes the message length
+ * and any padding needed to stop the message wrapping.  *pxOffset is set to
+ * the index of the region within the storage area.
+ */
+    static size_t prvPrepareReservation( const StreamBuffer_t * const pxStreamBuffer,
+                                         size_t xDataLengthBytes,
+                                         size_t * const pxOffset ) PRIVILEGED_FUNCTION;
+
+/*
+ * The free space that counts towards a reservation - all the free space in a
+ * message buffer, but only the free space that follows the write position
+ * without wrapping in a stream buffer.
+ */
+    static size_t prvSpaceForReservation( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Reserves the region prepared by prvPrepareReservation() if there is now
+ * enough space, and returns the number of bytes reserved.
+ */
+    static size_t prvReserve( StreamBuffer_t * const pxStreamBuffer,
+                              void ** ppvTxData,
+                              size_t xDataLengthBytes,
+                              size_t xRequiredSpace,
+                              size_t xOffset ) PRIVILEGED_FUNCTION;
+
+/*
+ * Writes the message length, if any, and moves the write position past the
+ * first xDataLengthBytes of the reserved region.
+ */
+    static void prvCommitReservation( StreamBuffer_t * const pxStreamBuffer,
+                                      size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/*
+ * Finds the data at the read position, of which there must be some.  Returns
+ * the number of bytes that can be read in place, or the length of the message
+ * for a message buffer, and sets *pxOffset to the index of the first byte, or
+ * to the buffer length if the message wraps.  For a message buffer
+ * *pxNextTail is set to the read position that follows the message.
+ */
+    static size_t prvAcquireData( StreamBuffer_t * const pxStreamBuffer,
+                                  size_t xBytesAvailable,
+                                  size_t * const pxOffset,
+                                  size_t * const pxNextTail ) PRIVILEGED_FUNCTION;
+
+/*
+ * Moves the read position past xDataLengthBytes of acquired data, or past the
+ * whole message for a message buffer.  Returns the number of bytes removed.
+ */
+    static size_t prvReleaseData( StreamBuffer_t * const pxStreamBuffer,
+                                  size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
+#if ( configUSE_STREAM_BUFFER_VECTORS == 1 )
+
+/*
+ * Returns the total length of uxVectorCount fragments.
+ */
+    static size_t prvVectorsLength( const StreamBufferVector_t * pxVectors,
+                                    UBaseType_t uxVectorCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * The scatter-gather versions of prvWriteMessageToBuffer() and
+ * prvReadMessageFromBuffer(), which gather the data from, or scatter it to,
+ * uxVectorCount fragments in turn.  As with the contiguous versions the head
+ * or tail is updated once, after all the fragments have been copied.
+ */
+    static size_t prvWriteVectorsToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                           const StreamBufferVector_t * pxVectors,
+                                           UBaseType_t uxVectorCount,
+                                           size_t xDataLengthBytes,
+                                           size_t xSpace,
+                                           size_t xRequiredSpace ) PRIVILEGED_FUNCTION;
+    static size_t prvReadVectorsFromBuffer( StreamBuffer_t * pxStreamBuffer,
+                                            const StreamBufferVector_t * pxVectors,
+                                            UBaseType_t uxVectorCount,
+                                            size_t xBufferLengthBytes,
+                                            size_t xBytesAvailable ) PRIVILEGED_FUNCTION;
+#endif /* configUSE_STREAM_BUFFER_VECTORS */
+
+#if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+
+/*
+ * Called when a send leaves less than the trigger level in the buffer.  If a
+ * task is waiting for data, and its block time has not already been limited,
+ * the task is made to time out no more than the trigger timeout from now.  If
+ * the block time cannot be changed the task is unblocked straight away, as
+ * though the trigger level had been reached, rather than risk leaving the data
+ * unread.
+ */
+    static void prvStartTriggerTimeout( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+    static void prvStartTriggerTimeoutFromISR( StreamBuffer_t * const pxStreamBuffer,
+                                               BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Used by the above to limit the block time of the task waiting for data.
+ * Returns pdTRUE if the task must be unblocked instead.  Must be called with
+ * interrupts masked.
+ */
+    static BaseType_t prvLimitReceiveWaitTime( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the task waiting for data once it has been unblocked, in place of
+ * clearing xTaskWaitingToReceive.  Counts the wake and, if the trigger timeout
+ * was started, resets it for the next wait.
+ */
+    static void prvEndReceiveWait( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+#endif /* configUSE_SB_TRIGGER_TIMEOUT */
+
 /*
  * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
  * initialise the members of the newly created stream buffer structure.
@@ -517,6 +666,15 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
         UBaseType_t uxStreamBufferNumber;
     #endif
 
+    #if ( configUSE_WAITSETS == 1 )
+        TaskHandle_t xWaitSetOwner;
+        uint32_t ulWaitSetBits;
+    #endif
+
+    #if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+        TickType_t xTriggerTimeoutTicks;
+    #endif
+
     configASSERT( pxStreamBuffer );
 
     #if ( configUSE_TRACE_FACILITY == 1 )
@@ -539,6 +697,22 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
             }
             #endif
 
+            #if ( configUSE_WAITSETS == 1 )
+            {
+                /* Resetting the buffer does not remove it from its waitset. */
+                xWaitSetOwner = pxStreamBuffer->xWaitSetOwner;
+                ulWaitSetBits = pxStreamBuffer->ulWaitSetBits;
+            }
+            #endif
+
+            #if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+            {
+                /* The trigger timeout is kept, as the trigger level is, but the
+                 * wake counts start again from zero. */
+                xTriggerTimeoutTicks = pxStreamBuffer->xTriggerTimeoutTicks;
+            }
+            #endif
+
             prvInitialiseNewStreamBuffer( pxStreamBuffer,
                                           pxStreamBuffer->pucBuffer,
                                           pxStreamBuffer->xLength,
@@ -553,6 +727,19 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
             }
             #endif
 
+            #if ( configUSE_WAITSETS == 1 )
+            {
+                pxStreamBuffer->xWaitSetOwner = xWaitSetOwner;
+                pxStreamBuffer->ulWaitSetBits = ulWaitSetBits;
+            }
+            #endif
+
+            #if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+            {
+                pxStreamBuffer->xTriggerTimeoutTicks = xTriggerTimeoutTicks;
+            }
+            #endif
+
             traceSTREAM_BUFFER_RESET( xStreamBuffer );
 
             xReturn = pdPASS;
@@ -754,10 +941,24 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
         {
             prvSEND_COMPLETED( pxStreamBuffer );
+
+            #if ( configUSE_WAITSETS == 1 )
+            {
+                prvNotifyWaitSet( pxStreamBuffer );
+            }
+            #endif
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            #if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+            {
+                prvStartTriggerTimeout( pxStreamBuffer );
+            }
+            #else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+            #endif
         }
     }
     else
@@ -804,10 +1005,24 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
         if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
         {
             prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+
+            #if ( configUSE_WAITSETS == 1 )
+            {
+                prvNotifyWaitSetFromISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+            }
+            #endif
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            #if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+            {
+                prvStartTriggerTimeoutFromISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+            }
+            #else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+            #endif
         }
     }
     else
@@ -840,6 +1055,13 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
         /* Ensure the data length given fits within configMESSAGE_BUFFER_LENGTH_TYPE. */
         configASSERT( ( size_t ) xMessageLength == xDataLengthBytes );
 
+        #if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+        {
+            /* The largest length is reserved to mark padding. */
+            configASSERT( xMessageLength != sbMESSAGE_PADDING );
+        }
+        #endif
+
         if( xSpace >= xRequiredSpace )
         {
             /* There is enough space to write both the message length and the message
@@ -930,7 +1152,16 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
             /* Wait for data to be available. */
             traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
             ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
-            pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+            #if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+            {
+                prvEndReceiveWait( pxStreamBuffer );
+            }
+            #else
+            {
+                pxStreamBuffer->xTaskWaitingToReceive = NULL;
+            }
+            #endif
 
             /* Recheck the data available after blocking. */
             xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
@@ -994,6 +1225,21 @@ size_t xStreamBufferNextMessageLengthBytes( StreamBufferHandle_t xStreamBuffer )
              * required to hold the length of the next message, so another message
              * is available. */
             ( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempReturn, sbBYTES_TO_STORE_MESSAGE_LENGTH, pxStreamBuffer->xTail );
+
+            #if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+            {
+                if( xTempReturn == sbMESSAGE_PADDING )
+                {
+                    /* The message starts at the beginning of the storage area. */
+                    ( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempReturn, sbBYTES_TO_STORE_MESSAGE_LENGTH, ( size_t ) 0 );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+
             xReturn = ( size_t ) xTempReturn;
         }
         else
@@ -1086,6 +1332,23 @@ static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
         /* A discrete message is being received.  First receive the length
          * of the message. */
         xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextTail );
+
+        #if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+        {
+            if( xTempNextMessageLength == sbMESSAGE_PADDING )
+            {
+                /* xStreamBufferSendCommit() skipped the rest of the storage
+                 * area, so the message starts at the beginning of it. */
+                xBytesAvailable -= pxStreamBuffer->xLength - pxStreamBuffer->xTail;
+                xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, ( size_t ) 0 );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
         xNextMessageLength = ( size_t ) xTempNextMessageLength;
 
         /* Reduce the number of bytes available by the number of bytes just
@@ -1124,117 +1387,1412 @@ static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer )
-{
-    const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-    BaseType_t xReturn;
-    size_t xTail;
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
 
-    configASSERT( pxStreamBuffer );
+    size_t xStreamBufferSendReserve( StreamBufferHandle_t xStreamBuffer,
+                                     void ** ppvTxData,
+                                     size_t xDataLengthBytes,
+                                     TickType_t xTicksToWait )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xRequiredSpace, xOffset;
+        TimeOut_t xTimeOut;
 
-    /* True if no bytes are available. */
-    xTail = pxStreamBuffer->xTail;
+        configASSERT( ppvTxData );
+        configASSERT( pxStreamBuffer );
 
-    if( pxStreamBuffer->xHead == xTail )
-    {
-        xReturn = pdTRUE;
-    }
-    else
-    {
-        xReturn = pdFALSE;
-    }
+        /* Only one region can be reserved at a time. */
+        configASSERT( pxStreamBuffer->xReservedBytes == ( size_t ) 0 );
 
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
+        xRequiredSpace = prvPrepareReservation( pxStreamBuffer, xDataLengthBytes, &xOffset );
 
-BaseType_t xStreamBufferIsFull( StreamBufferHandle_t xStreamBuffer )
-{
-    BaseType_t xReturn;
-    size_t xBytesToStoreMessageLength;
-    const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        if( xRequiredSpace > ( pxStreamBuffer->xLength - ( size_t ) 1 ) )
+        {
+            /* The message would not fit even if the entire buffer was empty,
+             * so don't wait for space. */
+            xTicksToWait = ( TickType_t ) 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-    configASSERT( pxStreamBuffer );
+        if( xTicksToWait != ( TickType_t ) 0 )
+        {
+            vTaskSetTimeOutState( &xTimeOut );
 
-    /* This generic version of the receive function is used by both message
-     * buffers, which store discrete messages, and stream buffers, which store a
-     * continuous stream of bytes.  Discrete messages include an additional
-     * sbBYTES_TO_STORE_MESSAGE_LENGTH bytes that hold the length of the message. */
-    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
-    {
-        xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
-    }
-    else
-    {
-        xBytesToStoreMessageLength = 0;
-    }
+            do
+            {
+                /* Wait until the required number of bytes are free in the
+                 * buffer.  This is the same handshake as xStreamBufferSend(), so
+                 * the receive side wakes the task the same way. */
+                taskENTER_CRITICAL();
+                {
+                    if( prvSpaceForReservation( pxStreamBuffer ) < xRequiredSpace )
+                    {
+                        /* Clear notification state as going to wait for space. */
+                        ( void ) xTaskNotifyStateClear( NULL );
+
+                        /* Should only be one writer. */
+                        configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+                        pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+                    }
+                    else
+                    {
+                        taskEXIT_CRITICAL();
+                        break;
+                    }
+                }
+                taskEXIT_CRITICAL();
 
-    /* True if the available space equals zero. */
-    if( xStreamBufferSpacesAvailable( xStreamBuffer ) <= xBytesToStoreMessageLength )
-    {
-        xReturn = pdTRUE;
+                traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+                ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+                pxStreamBuffer->xTaskWaitingToSend = NULL;
+            } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return prvReserve( pxStreamBuffer, ppvTxData, xDataLengthBytes, xRequiredSpace, xOffset );
     }
-    else
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    size_t xStreamBufferSendReserveFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            void ** ppvTxData,
+                                            size_t xDataLengthBytes )
     {
-        xReturn = pdFALSE;
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xRequiredSpace, xOffset;
+
+        configASSERT( ppvTxData );
+        configASSERT( pxStreamBuffer );
+        configASSERT( pxStreamBuffer->xReservedBytes == ( size_t ) 0 );
+
+        xRequiredSpace = prvPrepareReservation( pxStreamBuffer, xDataLengthBytes, &xOffset );
+
+        return prvReserve( pxStreamBuffer, ppvTxData, xDataLengthBytes, xRequiredSpace, xOffset );
     }
 
-    return xReturn;
-}
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
 /*-----------------------------------------------------------*/
 
-BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer,
-                                              BaseType_t * pxHigherPriorityTaskWoken )
-{
-    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-    BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
-
-    configASSERT( pxStreamBuffer );
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
 
-    uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+    size_t xStreamBufferSendCommit( StreamBufferHandle_t xStreamBuffer,
+                                    size_t xDataLengthBytes )
     {
-        if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        configASSERT( pxStreamBuffer );
+
+        /* Cannot commit more than was reserved. */
+        configASSERT( xDataLengthBytes <= pxStreamBuffer->xReservedBytes );
+
+        if( xDataLengthBytes > ( size_t ) 0 )
         {
-            ( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToReceive,
-                                         ( uint32_t ) 0,
-                                         eNoAction,
-                                         pxHigherPriorityTaskWoken );
-            ( pxStreamBuffer )->xTaskWaitingToReceive = NULL;
-            xReturn = pdTRUE;
+            prvCommitReservation( pxStreamBuffer, xDataLengthBytes );
+
+            traceSTREAM_BUFFER_SEND( xStreamBuffer, xDataLengthBytes );
+
+            /* Was a task waiting for the data? */
+            if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+            {
+                prvSEND_COMPLETED( pxStreamBuffer );
+
+                #if ( configUSE_WAITSETS == 1 )
+                {
+                    prvNotifyWaitSet( pxStreamBuffer );
+                }
+                #endif
+            }
+            else
+            {
+                #if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+                {
+                    prvStartTriggerTimeout( pxStreamBuffer );
+                }
+                #else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+                #endif
+            }
         }
         else
         {
-            xReturn = pdFALSE;
+            mtCOVERAGE_TEST_MARKER();
         }
+
+        pxStreamBuffer->xReservedBytes = 0;
+
+        return xDataLengthBytes;
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-    return xReturn;
-}
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
 /*-----------------------------------------------------------*/
 
-BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer,
-                                                 BaseType_t * pxHigherPriorityTaskWoken )
-{
-    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-    BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
-
-    configASSERT( pxStreamBuffer );
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
 
-    uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+    size_t xStreamBufferSendCommitFromISR( StreamBufferHandle_t xStreamBuffer,
+                                           size_t xDataLengthBytes,
+                                           BaseType_t * const pxHigherPriorityTaskWoken )
     {
-        if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )
-        {
-            ( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToSend,
-                                         ( uint32_t ) 0,
-                                         eNoAction,
-                                         pxHigherPriorityTaskWoken );
-            ( pxStreamBuffer )->xTaskWaitingToSend = NULL;
-            xReturn = pdTRUE;
-        }
-        else
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        configASSERT( pxStreamBuffer );
+        configASSERT( xDataLengthBytes <= pxStreamBuffer->xReservedBytes );
+
+        if( xDataLengthBytes > ( size_t ) 0 )
+        {
+            prvCommitReservation( pxStreamBuffer, xDataLengthBytes );
+
+            /* Was a task waiting for the data? */
+            if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+            {
+                prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+
+                #if ( configUSE_WAITSETS == 1 )
+                {
+                    prvNotifyWaitSetFromISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+                }
+                #endif
+            }
+            else
+            {
+                #if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+                {
+                    prvStartTriggerTimeoutFromISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+                }
+                #else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+                #endif
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxStreamBuffer->xReservedBytes = 0;
+
+        traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xDataLengthBytes );
+
+        return xDataLengthBytes;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    size_t xStreamBufferReceiveAcquire( StreamBufferHandle_t xStreamBuffer,
+                                        void ** ppvRxData,
+                                        TickType_t xTicksToWait )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn = 0, xBytesAvailable, xBytesToStoreMessageLength, xOffset, xNextTail;
+
+        configASSERT( ppvRxData );
+        configASSERT( pxStreamBuffer );
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        }
+        else
+        {
+            xBytesToStoreMessageLength = 0;
+        }
+
+        if( xTicksToWait != ( TickType_t ) 0 )
+        {
+            /* Checking if there is data and clearing the notification state
+             * must be performed atomically. */
+            taskENTER_CRITICAL();
+            {
+                xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+                if( xBytesAvailable <= xBytesToStoreMessageLength )
+                {
+                    /* Clear notification state as going to wait for data. */
+                    ( void ) xTaskNotifyStateClear( NULL );
+
+                    /* Should only be one reader. */
+                    configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+                    pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xBytesAvailable <= xBytesToStoreMessageLength )
+            {
+                /* Wait for data to be available. */
+                traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+                ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+
+                #if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+                {
+                    prvEndReceiveWait( pxStreamBuffer );
+                }
+                #else
+                {
+                    pxStreamBuffer->xTaskWaitingToReceive = NULL;
+                }
+                #endif
+
+                /* Recheck the data available after blocking. */
+                xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+        }
+
+        if( xBytesAvailable > xBytesToStoreMessageLength )
+        {
+            xReturn = prvAcquireData( pxStreamBuffer, xBytesAvailable, &xOffset, &xNextTail );
+
+            if( xOffset < pxStreamBuffer->xLength )
+            {
+                *ppvRxData = ( void * ) &( pxStreamBuffer->pucBuffer[ xOffset ] );
+            }
+            else
+            {
+                /* The message wraps so cannot be read in place. */
+                *ppvRxData = NULL;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    size_t xStreamBufferReceiveAcquireFromISR( StreamBufferHandle_t xStreamBuffer,
+                                               void ** ppvRxData )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn = 0, xBytesAvailable, xBytesToStoreMessageLength, xOffset, xNextTail;
+
+        configASSERT( ppvRxData );
+        configASSERT( pxStreamBuffer );
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        }
+        else
+        {
+            xBytesToStoreMessageLength = 0;
+        }
+
+        xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+        if( xBytesAvailable > xBytesToStoreMessageLength )
+        {
+            xReturn = prvAcquireData( pxStreamBuffer, xBytesAvailable, &xOffset, &xNextTail );
+
+            if( xOffset < pxStreamBuffer->xLength )
+            {
+                *ppvRxData = ( void * ) &( pxStreamBuffer->pucBuffer[ xOffset ] );
+            }
+            else
+            {
+                /* The message wraps so cannot be read in place. */
+                *ppvRxData = NULL;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    size_t xStreamBufferReceiveRelease( StreamBufferHandle_t xStreamBuffer,
+                                        size_t xDataLengthBytes )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReceivedLength;
+
+        configASSERT( pxStreamBuffer );
+
+        xReceivedLength = prvReleaseData( pxStreamBuffer, xDataLengthBytes );
+
+        /* Was a task waiting for space in the buffer? */
+        if( xReceivedLength != ( size_t ) 0 )
+        {
+            traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
+            prvRECEIVE_COMPLETED( xStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReceivedLength;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    size_t xStreamBufferReceiveReleaseFromISR( StreamBufferHandle_t xStreamBuffer,
+                                               size_t xDataLengthBytes,
+                                               BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReceivedLength;
+
+        configASSERT( pxStreamBuffer );
+
+        xReceivedLength = prvReleaseData( pxStreamBuffer, xDataLengthBytes );
+
+        /* Was a task waiting for space in the buffer? */
+        if( xReceivedLength != ( size_t ) 0 )
+        {
+            prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength );
+
+        return xReceivedLength;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    static size_t prvPrepareReservation( const StreamBuffer_t * const pxStreamBuffer,
+                                         size_t xDataLengthBytes,
+                                         size_t * const pxOffset )
+    {
+        size_t xRequiredSpace, xBytesToEnd;
+        const size_t xHead = pxStreamBuffer->xHead;
+
+        /* Only the writer moves the write position, so the region stays valid
+         * while waiting for the reader to free space. */
+        xBytesToEnd = pxStreamBuffer->xLength - xHead;
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            /* Ensure the data length given fits within
+             * configMESSAGE_BUFFER_LENGTH_TYPE, and is not the padding marker. */
+            configASSERT( ( size_t ) ( configMESSAGE_BUFFER_LENGTH_TYPE ) xDataLengthBytes == xDataLengthBytes );
+            configASSERT( ( configMESSAGE_BUFFER_LENGTH_TYPE ) xDataLengthBytes != sbMESSAGE_PADDING );
+
+            xRequiredSpace = xDataLengthBytes + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+            /* Overflow? */
+            configASSERT( xRequiredSpace > xDataLengthBytes );
+
+            if( ( xBytesToEnd > sbBYTES_TO_STORE_MESSAGE_LENGTH ) && ( xBytesToEnd < xRequiredSpace ) )
+            {
+                /* The length fits before the end of the storage area but the
+                 * data does not, so skip the rest of the storage area and put
+                 * the whole message at the start. */
+                *pxOffset = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+                if( xRequiredSpace < pxStreamBuffer->xLength )
+                {
+                    xRequiredSpace += xBytesToEnd;
+                }
+                else
+                {
+                    /* Would not fit anyway, and adding could overflow. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* The data follows the length without wrapping, although the
+                 * length itself may wrap. */
+                *pxOffset = xHead + sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+                if( *pxOffset >= pxStreamBuffer->xLength )
+                {
+                    *pxOffset -= pxStreamBuffer->xLength;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            /* A stream buffer waits for as much of the request as can be
+             * written before the end of the storage area. */
+            *pxOffset = xHead;
+            xRequiredSpace = configMIN( xDataLengthBytes, xBytesToEnd );
+            xRequiredSpace = configMIN( xRequiredSpace, pxStreamBuffer->xLength - ( size_t ) 1 );
+        }
+
+        return xRequiredSpace;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    static size_t prvSpaceForReservation( StreamBuffer_t * const pxStreamBuffer )
+    {
+        size_t xSpace;
+        const size_t xHead = pxStreamBuffer->xHead;
+        const size_t xTail = pxStreamBuffer->xTail;
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+        }
+        else if( xTail > xHead )
+        {
+            xSpace = ( xTail - xHead ) - ( size_t ) 1;
+        }
+        else if( xTail == ( size_t ) 0 )
+        {
+            /* One byte is always left free so a full buffer can be told
+             * apart from an empty one. */
+            xSpace = ( pxStreamBuffer->xLength - xHead ) - ( size_t ) 1;
+        }
+        else
+        {
+            xSpace = pxStreamBuffer->xLength - xHead;
+        }
+
+        return xSpace;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    static size_t prvReserve( StreamBuffer_t * const pxStreamBuffer,
+                              void ** ppvTxData,
+                              size_t xDataLengthBytes,
+                              size_t xRequiredSpace,
+                              size_t xOffset )
+    {
+        size_t xReturn, xSpace;
+
+        xSpace = prvSpaceForReservation( pxStreamBuffer );
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            /* It must be possible to reserve the whole message. */
+            if( xSpace >= xRequiredSpace )
+            {
+                xReturn = xDataLengthBytes;
+            }
+            else
+            {
+                xReturn = 0;
+            }
+        }
+        else
+        {
+            xReturn = configMIN( xDataLengthBytes, xSpace );
+        }
+
+        if( xReturn != ( size_t ) 0 )
+        {
+            pxStreamBuffer->xReservedBytes = xReturn;
+            *ppvTxData = ( void * ) &( pxStreamBuffer->pucBuffer[ xOffset ] );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    static void prvCommitReservation( StreamBuffer_t * const pxStreamBuffer,
+                                      size_t xDataLengthBytes )
+    {
+        size_t xNextHead = pxStreamBuffer->xHead;
+        size_t xBytesToEnd;
+        configMESSAGE_BUFFER_LENGTH_TYPE xMessageLength;
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            /* The layout is decided by the number of bytes reserved, not the
+             * number committed, as the data is already in place. */
+            xBytesToEnd = pxStreamBuffer->xLength - xNextHead;
+
+            if( ( xBytesToEnd > sbBYTES_TO_STORE_MESSAGE_LENGTH ) && ( xBytesToEnd < ( pxStreamBuffer->xReservedBytes + sbBYTES_TO_STORE_MESSAGE_LENGTH ) ) )
+            {
+                /* The message was put at the start of the storage area, so tell
+                 * the reader to skip the rest of it. */
+                xMessageLength = sbMESSAGE_PADDING;
+                ( void ) prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xMessageLength ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextHead );
+                xNextHead = 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xMessageLength = ( configMESSAGE_BUFFER_LENGTH_TYPE ) xDataLengthBytes;
+            xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xMessageLength ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextHead );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xNextHead += xDataLengthBytes;
+
+        if( xNextHead >= pxStreamBuffer->xLength )
+        {
+            xNextHead -= pxStreamBuffer->xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The data becomes visible to the reader only when the write position
+         * is updated, after the length has been written. */
+        pxStreamBuffer->xHead = xNextHead;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    static size_t prvAcquireData( StreamBuffer_t * const pxStreamBuffer,
+                                  size_t xBytesAvailable,
+                                  size_t * const pxOffset,
+                                  size_t * const pxNextTail )
+    {
+        size_t xCount, xNextTail = pxStreamBuffer->xTail;
+        configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextTail );
+
+            if( xTempNextMessageLength == sbMESSAGE_PADDING )
+            {
+                /* The message starts at the beginning of the storage area. */
+                xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, ( size_t ) 0 );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xCount = ( size_t ) xTempNextMessageLength;
+
+            if( ( xNextTail + xCount ) <= pxStreamBuffer->xLength )
+            {
+                *pxOffset = xNextTail;
+            }
+            else
+            {
+                /* Only a message written by xStreamBufferSend() can wrap. */
+                *pxOffset = pxStreamBuffer->xLength;
+            }
+
+            xNextTail += xCount;
+
+            if( xNextTail >= pxStreamBuffer->xLength )
+            {
+                xNextTail -= pxStreamBuffer->xLength;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            /* Return the bytes that can be read before the end of the storage
+             * area. */
+            *pxOffset = xNextTail;
+            xCount = configMIN( xBytesAvailable, pxStreamBuffer->xLength - xNextTail );
+        }
+
+        *pxNextTail = xNextTail;
+
+        return xCount;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+    static size_t prvReleaseData( StreamBuffer_t * const pxStreamBuffer,
+                                  size_t xDataLengthBytes )
+    {
+        size_t xBytesAvailable, xOffset, xNextTail;
+
+        xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            if( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH )
+            {
+                /* The whole message, and any padding before it, is removed. */
+                xDataLengthBytes = prvAcquireData( pxStreamBuffer, xBytesAvailable, &xOffset, &xNextTail );
+                pxStreamBuffer->xTail = xNextTail;
+            }
+            else
+            {
+                xDataLengthBytes = 0;
+            }
+        }
+        else
+        {
+            /* Cannot release more than there is. */
+            configASSERT( xDataLengthBytes <= xBytesAvailable );
+
+            if( xDataLengthBytes != ( size_t ) 0 )
+            {
+                xNextTail = pxStreamBuffer->xTail + xDataLengthBytes;
+
+                if( xNextTail >= pxStreamBuffer->xLength )
+                {
+                    xNextTail -= pxStreamBuffer->xLength;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxStreamBuffer->xTail = xNextTail;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xDataLengthBytes;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_VECTORS == 1 )
+
+    size_t xStreamBufferSendv( StreamBufferHandle_t xStreamBuffer,
+                               const StreamBufferVector_t * pxVectors,
+                               UBaseType_t uxVectorCount,
+                               TickType_t xTicksToWait )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn, xSpace = 0;
+        size_t xDataLengthBytes, xRequiredSpace;
+        TimeOut_t xTimeOut;
+        size_t xMaxReportedSpace = 0;
+
+        configASSERT( pxVectors );
+        configASSERT( pxStreamBuffer );
+
+        xDataLengthBytes = prvVectorsLength( pxVectors, uxVectorCount );
+        xRequiredSpace = xDataLengthBytes;
+
+        /* The maximum amount of space a stream buffer will ever report is its
+         * length minus 1. */
+        xMaxReportedSpace = pxStreamBuffer->xLength - ( size_t ) 1;
+
+        /* The fragments are sent as one message with one length, so the space
+         * needed is calculated as in xStreamBufferSend(). */
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+            /* Overflow? */
+            configASSERT( xRequiredSpace > xDataLengthBytes );
+
+            if( xRequiredSpace > xMaxReportedSpace )
+            {
+                /* The message would not fit even if the entire buffer was
+                 * empty, so don't wait for space. */
+                xTicksToWait = ( TickType_t ) 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            if( xRequiredSpace > xMaxReportedSpace )
+            {
+                xRequiredSpace = xMaxReportedSpace;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( xTicksToWait != ( TickType_t ) 0 )
+        {
+            vTaskSetTimeOutState( &xTimeOut );
+
+            do
+            {
+                /* Wait until the required number of bytes are free in the
+                 * buffer. */
+                taskENTER_CRITICAL();
+                {
+                    xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+                    if( xSpace < xRequiredSpace )
+                    {
+                        /* Clear notification state as going to wait for space. */
+                        ( void ) xTaskNotifyStateClear( NULL );
+
+                        /* Should only be one writer. */
+                        configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+                        pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+                    }
+                    else
+                    {
+                        taskEXIT_CRITICAL();
+                        break;
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+                ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+                pxStreamBuffer->xTaskWaitingToSend = NULL;
+            } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xSpace == ( size_t ) 0 )
+        {
+            xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = prvWriteVectorsToBuffer( pxStreamBuffer, pxVectors, uxVectorCount, xDataLengthBytes, xSpace, xRequiredSpace );
+
+        if( xReturn > ( size_t ) 0 )
+        {
+            traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+
+            /* Was a task waiting for the data? */
+            if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+            {
+                prvSEND_COMPLETED( pxStreamBuffer );
+
+                #if ( configUSE_WAITSETS == 1 )
+                {
+                    prvNotifyWaitSet( pxStreamBuffer );
+                }
+                #endif
+            }
+            else
+            {
+                #if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+                {
+                    prvStartTriggerTimeout( pxStreamBuffer );
+                }
+                #else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+                #endif
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+            traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_VECTORS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_VECTORS == 1 )
+
+    size_t xStreamBufferSendvFromISR( StreamBufferHandle_t xStreamBuffer,
+                                      const StreamBufferVector_t * pxVectors,
+                                      UBaseType_t uxVectorCount,
+                                      BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReturn, xSpace;
+        size_t xDataLengthBytes, xRequiredSpace;
+
+        configASSERT( pxVectors );
+        configASSERT( pxStreamBuffer );
+
+        xDataLengthBytes = prvVectorsLength( pxVectors, uxVectorCount );
+        xRequiredSpace = xDataLengthBytes;
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+        xReturn = prvWriteVectorsToBuffer( pxStreamBuffer, pxVectors, uxVectorCount, xDataLengthBytes, xSpace, xRequiredSpace );
+
+        if( xReturn > ( size_t ) 0 )
+        {
+            /* Was a task waiting for the data? */
+            if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+            {
+                prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+
+                #if ( configUSE_WAITSETS == 1 )
+                {
+                    prvNotifyWaitSetFromISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+                }
+                #endif
+            }
+            else
+            {
+                #if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+                {
+                    prvStartTriggerTimeoutFromISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+                }
+                #else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+                #endif
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_VECTORS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_VECTORS == 1 )
+
+    size_t xStreamBufferReceivev( StreamBufferHandle_t xStreamBuffer,
+                                  const StreamBufferVector_t * pxVectors,
+                                  UBaseType_t uxVectorCount,
+                                  TickType_t xTicksToWait )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
+
+        configASSERT( pxVectors );
+        configASSERT( pxStreamBuffer );
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        }
+        else
+        {
+            xBytesToStoreMessageLength = 0;
+        }
+
+        if( xTicksToWait != ( TickType_t ) 0 )
+        {
+            /* Checking if there is data and clearing the notification state
+             * must be performed atomically. */
+            taskENTER_CRITICAL();
+            {
+                xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+                if( xBytesAvailable <= xBytesToStoreMessageLength )
+                {
+                    /* Clear notification state as going to wait for data. */
+                    ( void ) xTaskNotifyStateClear( NULL );
+
+                    /* Should only be one reader. */
+                    configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+                    pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xBytesAvailable <= xBytesToStoreMessageLength )
+            {
+                /* Wait for data to be available. */
+                traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+                ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+
+                #if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+                {
+                    prvEndReceiveWait( pxStreamBuffer );
+                }
+                #else
+                {
+                    pxStreamBuffer->xTaskWaitingToReceive = NULL;
+                }
+                #endif
+
+                /* Recheck the data available after blocking. */
+                xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+        }
+
+        if( xBytesAvailable > xBytesToStoreMessageLength )
+        {
+            xReceivedLength = prvReadVectorsFromBuffer( pxStreamBuffer, pxVectors, uxVectorCount, prvVectorsLength( pxVectors, uxVectorCount ), xBytesAvailable );
+
+            /* Was a task waiting for space in the buffer? */
+            if( xReceivedLength != ( size_t ) 0 )
+            {
+                traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
+                prvRECEIVE_COMPLETED( xStreamBuffer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReceivedLength;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_VECTORS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_VECTORS == 1 )
+
+    size_t xStreamBufferReceivevFromISR( StreamBufferHandle_t xStreamBuffer,
+                                         const StreamBufferVector_t * pxVectors,
+                                         UBaseType_t uxVectorCount,
+                                         BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
+
+        configASSERT( pxVectors );
+        configASSERT( pxStreamBuffer );
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        }
+        else
+        {
+            xBytesToStoreMessageLength = 0;
+        }
+
+        xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+        if( xBytesAvailable > xBytesToStoreMessageLength )
+        {
+            xReceivedLength = prvReadVectorsFromBuffer( pxStreamBuffer, pxVectors, uxVectorCount, prvVectorsLength( pxVectors, uxVectorCount ), xBytesAvailable );
+
+            /* Was a task waiting for space in the buffer? */
+            if( xReceivedLength != ( size_t ) 0 )
+            {
+                prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength );
+
+        return xReceivedLength;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_VECTORS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_VECTORS == 1 )
+
+    static size_t prvVectorsLength( const StreamBufferVector_t * pxVectors,
+                                    UBaseType_t uxVectorCount )
+    {
+        size_t xLength = 0;
+        UBaseType_t uxVector;
+
+        for( uxVector = 0; uxVector < uxVectorCount; uxVector++ )
+        {
+            xLength += pxVectors[ uxVector ].xDataLengthBytes;
+
+            /* Overflow? */
+            configASSERT( xLength >= pxVectors[ uxVector ].xDataLengthBytes );
+        }
+
+        return xLength;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_VECTORS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_VECTORS == 1 )
+
+    static size_t prvWriteVectorsToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                           const StreamBufferVector_t * pxVectors,
+                                           UBaseType_t uxVectorCount,
+                                           size_t xDataLengthBytes,
+                                           size_t xSpace,
+                                           size_t xRequiredSpace )
+    {
+        size_t xNextHead = pxStreamBuffer->xHead;
+        size_t xBytesRemaining, xCount;
+        UBaseType_t uxVector;
+        configMESSAGE_BUFFER_LENGTH_TYPE xMessageLength;
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            /* This is a message buffer, so the fragments share one length. */
+            xMessageLength = ( configMESSAGE_BUFFER_LENGTH_TYPE ) xDataLengthBytes;
+
+            /* Ensure the data length given fits within configMESSAGE_BUFFER_LENGTH_TYPE. */
+            configASSERT( ( size_t ) xMessageLength == xDataLengthBytes );
+
+            #if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+            {
+                /* The largest length is reserved to mark padding. */
+                configASSERT( xMessageLength != sbMESSAGE_PADDING );
+            }
+            #endif
+
+            if( xSpace >= xRequiredSpace )
+            {
+                xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xMessageLength ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextHead );
+            }
+            else
+            {
+                /* Not enough space, so do not write data to the buffer. */
+                xDataLengthBytes = 0;
+            }
+        }
+        else
+        {
+            /* This is a stream buffer, so write as many bytes as possible. */
+            xDataLengthBytes = configMIN( xDataLengthBytes, xSpace );
+        }
+
+        /* Gather the fragments in order, chaining the head through each write
+         * so the reader cannot see any of them yet. */
+        xBytesRemaining = xDataLengthBytes;
+
+        for( uxVector = 0; ( uxVector < uxVectorCount ) && ( xBytesRemaining > ( size_t ) 0 ); uxVector++ )
+        {
+            xCount = configMIN( pxVectors[ uxVector ].xDataLengthBytes, xBytesRemaining );
+
+            if( xCount > ( size_t ) 0 )
+            {
+                configASSERT( pxVectors[ uxVector ].pvData );
+                xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pxVectors[ uxVector ].pvData, xCount, xNextHead ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alignment and access. */
+                xBytesRemaining -= xCount;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        if( xDataLengthBytes != ( size_t ) 0 )
+        {
+            /* Publish the whole message with a single update of the head. */
+            pxStreamBuffer->xHead = xNextHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xDataLengthBytes;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_VECTORS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_VECTORS == 1 )
+
+    static size_t prvReadVectorsFromBuffer( StreamBuffer_t * pxStreamBuffer,
+                                            const StreamBufferVector_t * pxVectors,
+                                            UBaseType_t uxVectorCount,
+                                            size_t xBufferLengthBytes,
+                                            size_t xBytesAvailable )
+    {
+        size_t xCount, xNextMessageLength, xBytesRemaining, xFragment;
+        configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
+        size_t xNextTail = pxStreamBuffer->xTail;
+        UBaseType_t uxVector;
+
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+        {
+            /* A discrete message is being received.  First receive the length
+             * of the message. */
+            xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextTail );
+
+            #if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+            {
+                if( xTempNextMessageLength == sbMESSAGE_PADDING )
+                {
+                    /* xStreamBufferSendCommit() skipped the rest of the
+                     * storage area, so the message starts at the beginning of
+                     * it. */
+                    xBytesAvailable -= pxStreamBuffer->xLength - pxStreamBuffer->xTail;
+                    xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, ( size_t ) 0 );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+
+            xNextMessageLength = ( size_t ) xTempNextMessageLength;
+            xBytesAvailable -= sbBYTES_TO_STORE_MESSAGE_LENGTH;
+
+            /* Check the message fits in the fragments provided. */
+            if( xNextMessageLength > xBufferLengthBytes )
+            {
+                xNextMessageLength = 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            /* A stream of bytes is being received, so read as many bytes as
+             * the fragments can hold. */
+            xNextMessageLength = xBufferLengthBytes;
+        }
+
+        xCount = configMIN( xNextMessageLength, xBytesAvailable );
+
+        if( xCount != ( size_t ) 0 )
+        {
+            /* Scatter the data across the fragments in order. */
+            xBytesRemaining = xCount;
+
+            for( uxVector = 0; ( uxVector < uxVectorCount ) && ( xBytesRemaining > ( size_t ) 0 ); uxVector++ )
+            {
+                xFragment = configMIN( pxVectors[ uxVector ].xDataLengthBytes, xBytesRemaining );
+
+                if( xFragment > ( size_t ) 0 )
+                {
+                    configASSERT( pxVectors[ uxVector ].pvData );
+                    xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pxVectors[ uxVector ].pvData, xFragment, xNextTail ); /*lint !e9079 Data storage area is implemented as uint8_t array for ease of sizing, indexing and alignment. */
+                    xBytesRemaining -= xFragment;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            /* Update the tail to mark the data as officially consumed. */
+            pxStreamBuffer->xTail = xNextTail;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xCount;
+    }
+
+#endif /* configUSE_STREAM_BUFFER_VECTORS */
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer )
+{
+    const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    BaseType_t xReturn;
+    size_t xTail;
+
+    configASSERT( pxStreamBuffer );
+
+    /* True if no bytes are available. */
+    xTail = pxStreamBuffer->xTail;
+
+    if( pxStreamBuffer->xHead == xTail )
+    {
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferIsFull( StreamBufferHandle_t xStreamBuffer )
+{
+    BaseType_t xReturn;
+    size_t xBytesToStoreMessageLength;
+    const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+    configASSERT( pxStreamBuffer );
+
+    /* This generic version of the receive function is used by both message
+     * buffers, which store discrete messages, and stream buffers, which store a
+     * continuous stream of bytes.  Discrete messages include an additional
+     * sbBYTES_TO_STORE_MESSAGE_LENGTH bytes that hold the length of the message. */
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+    }
+    else
+    {
+        xBytesToStoreMessageLength = 0;
+    }
+
+    /* True if the available space equals zero. */
+    if( xStreamBufferSpacesAvailable( xStreamBuffer ) <= xBytesToStoreMessageLength )
+    {
+        xReturn = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer,
+                                              BaseType_t * pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    BaseType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
+
+    configASSERT( pxStreamBuffer );
+
+    uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )
+        {
+            ( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToReceive,
+                                         ( uint32_t ) 0,
+                                         eNoAction,
+                                         pxHigherPriorityTaskWoken );
+            ( pxStreamBuffer )->xTaskWaitingToReceive = NULL;
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer,
+                                                 BaseType_t * pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    BaseType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
+
+    configASSERT( pxStreamBuffer );
+
+    uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )
+        {
+            ( void ) xTaskNotifyFromISR( ( pxStreamBuffer )->xTaskWaitingToSend,
+                                         ( uint32_t ) 0,
+                                         eNoAction,
+                                         pxHigherPriorityTaskWoken );
+            ( pxStreamBuffer )->xTaskWaitingToSend = NULL;
+            xReturn = pdTRUE;
+        }
+        else
         {
             xReturn = pdFALSE;
         }
@@ -1393,6 +2951,13 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
         ( void ) pxReceiveCompletedCallback;
     }
     #endif
+
+    #if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+    {
+        /* By default a task waiting for data waits for the trigger level. */
+        pxStreamBuffer->xTriggerTimeoutTicks = portMAX_DELAY;
+    }
+    #endif
 }
 
 #if ( configUSE_TRACE_FACILITY == 1 )
@@ -1425,3 +2990,296 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_WAITSETS == 1 )
+
+    static void prvNotifyWaitSet( const StreamBuffer_t * const pxStreamBuffer )
+    {
+        /* The owner and bits are read in a critical section as they are
+         * written together by xStreamBufferSetWaitSetMember(). */
+        taskENTER_CRITICAL();
+        {
+            if( pxStreamBuffer->xWaitSetOwner != NULL )
+            {
+                ( void ) xTaskNotifyIndexed( pxStreamBuffer->xWaitSetOwner, configWAITSET_NOTIFICATION_INDEX, pxStreamBuffer->ulWaitSetBits, eSetBits );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_WAITSETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WAITSETS == 1 )
+
+    static void prvNotifyWaitSetFromISR( const StreamBuffer_t * const pxStreamBuffer,
+                                         BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            if( pxStreamBuffer->xWaitSetOwner != NULL )
+            {
+                ( void ) xTaskNotifyIndexedFromISR( pxStreamBuffer->xWaitSetOwner, configWAITSET_NOTIFICATION_INDEX, pxStreamBuffer->ulWaitSetBits, eSetBits, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+
+#endif /* configUSE_WAITSETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WAITSETS == 1 )
+
+    BaseType_t xStreamBufferSetWaitSetMember( StreamBufferHandle_t xStreamBuffer,
+                                              TaskHandle_t xOwner,
+                                              uint32_t ulBits )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        BaseType_t xReturn = pdFAIL;
+
+        configASSERT( pxStreamBuffer );
+        configASSERT( xOwner );
+
+        taskENTER_CRITICAL();
+        {
+            if( ulBits != 0UL )
+            {
+                if( pxStreamBuffer->xWaitSetOwner == NULL )
+                {
+                    pxStreamBuffer->xWaitSetOwner = xOwner;
+                    pxStreamBuffer->ulWaitSetBits = ulBits;
+
+                    /* Data that was sent before the stream buffer was added is
+                     * posted now, so it is not missed. */
+                    if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+                    {
+                        prvNotifyWaitSet( pxStreamBuffer );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    /* The stream buffer is already in a waitset. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                if( pxStreamBuffer->xWaitSetOwner == xOwner )
+                {
+                    pxStreamBuffer->xWaitSetOwner = NULL;
+                    pxStreamBuffer->ulWaitSetBits = 0UL;
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    /* The stream buffer is not in this waitset. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_WAITSETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+
+    static BaseType_t prvLimitReceiveWaitTime( StreamBuffer_t * const pxStreamBuffer )
+    {
+        BaseType_t xUnblockNow = pdFALSE;
+
+        if( ( pxStreamBuffer->xTaskWaitingToReceive != NULL ) &&
+            ( pxStreamBuffer->xTriggerTimeoutStarted == pdFALSE ) &&
+            ( pxStreamBuffer->xTriggerTimeoutTicks != portMAX_DELAY ) )
+        {
+            /* The reading task only blocks when the buffer is empty, so this is
+             * the send that wrote the first unread byte. */
+            if( xTaskLimitNotifyWaitTime( pxStreamBuffer->xTaskWaitingToReceive, pxStreamBuffer->xTriggerTimeoutTicks ) != pdFALSE )
+            {
+                pxStreamBuffer->xTriggerTimeoutStarted = pdTRUE;
+            }
+            else
+            {
+                /* The task has not blocked yet, or the scheduler is suspended
+                 * so its block time cannot be changed. */
+                xUnblockNow = pdTRUE;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xUnblockNow;
+    }
+
+#endif /* configUSE_SB_TRIGGER_TIMEOUT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+
+    static void prvStartTriggerTimeout( StreamBuffer_t * const pxStreamBuffer )
+    {
+        BaseType_t xUnblockNow;
+
+        /* Most sends below the trigger level find the timeout already started,
+         * or nothing waiting, so check before entering a critical section. */
+        if( ( pxStreamBuffer->xTaskWaitingToReceive != NULL ) && ( pxStreamBuffer->xTriggerTimeoutStarted == pdFALSE ) )
+        {
+            taskENTER_CRITICAL();
+            {
+                xUnblockNow = prvLimitReceiveWaitTime( pxStreamBuffer );
+            }
+            taskEXIT_CRITICAL();
+
+            if( xUnblockNow != pdFALSE )
+            {
+                prvSEND_COMPLETED( pxStreamBuffer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_SB_TRIGGER_TIMEOUT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+
+    static void prvStartTriggerTimeoutFromISR( StreamBuffer_t * const pxStreamBuffer,
+                                               BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        BaseType_t xUnblockNow;
+
+        if( ( pxStreamBuffer->xTaskWaitingToReceive != NULL ) && ( pxStreamBuffer->xTriggerTimeoutStarted == pdFALSE ) )
+        {
+            uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+            {
+                xUnblockNow = prvLimitReceiveWaitTime( pxStreamBuffer );
+            }
+            portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+            if( xUnblockNow != pdFALSE )
+            {
+                prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_SB_TRIGGER_TIMEOUT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+
+    static void prvEndReceiveWait( StreamBuffer_t * const pxStreamBuffer )
+    {
+        /* Sends clear xTaskWaitingToReceive when they unblock the task, so it
+         * is still set if the task timed out. */
+        taskENTER_CRITICAL();
+        {
+            if( pxStreamBuffer->xTaskWaitingToReceive == NULL )
+            {
+                pxStreamBuffer->ulLevelWakes++;
+            }
+            else if( pxStreamBuffer->xTriggerTimeoutStarted != pdFALSE )
+            {
+                pxStreamBuffer->ulTimeoutWakes++;
+            }
+            else
+            {
+                /* The block time passed to the receive function expired
+                 * without any data arriving. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxStreamBuffer->xTriggerTimeoutStarted = pdFALSE;
+            pxStreamBuffer->xTaskWaitingToReceive = NULL;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_SB_TRIGGER_TIMEOUT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+
+    void vStreamBufferSetTriggerTimeout( StreamBufferHandle_t xStreamBuffer,
+                                         TickType_t xTriggerTimeout )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        configASSERT( pxStreamBuffer );
+
+        /* A message buffer unblocks the task waiting for data on every
+         * message, so has no use for a trigger timeout. */
+        configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+        /* The new timeout is used from the next time the first byte is sent to
+         * an empty buffer. */
+        pxStreamBuffer->xTriggerTimeoutTicks = xTriggerTimeout;
+    }
+
+#endif /* configUSE_SB_TRIGGER_TIMEOUT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+
+    void vStreamBufferGetWakeCounts( StreamBufferHandle_t xStreamBuffer,
+                                     uint32_t * pulLevelWakes,
+                                     uint32_t * pulTimeoutWakes )
+    {
+        const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        configASSERT( pxStreamBuffer );
+
+        taskENTER_CRITICAL();
+        {
+            if( pulLevelWakes != NULL )
+            {
+                *pulLevelWakes = pxStreamBuffer->ulLevelWakes;
+            }
+
+            if( pulTimeoutWakes != NULL )
+            {
+                *pulTimeoutWakes = pxStreamBuffer->ulTimeoutWakes;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_SB_TRIGGER_TIMEOUT */
+/*-----------------------------------------------------------*/
@@ -40,6 +40,7 @@
 #include "task.h"
 #include "timers.h"
 #include "stack_macros.h"
+#include "atomic.h"
 
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
  * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
@@ -146,26 +147,102 @@
                                                                               \
         /* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of \
          * the  same priority get an equal share of the processor time. */                    \
-        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) ); \
+        taskGET_OWNER_OF_READY_LIST( uxTopPriority );                                         \
         uxTopReadyPriority = uxTopPriority;                                                   \
     } /* taskSELECT_HIGHEST_PRIORITY_TASK */
 
 /*-----------------------------------------------------------*/
 
-/* Define away taskRESET_READY_PRIORITY() and portRESET_READY_PRIORITY() as
+/* Find the highest priority that has ready tasks without selecting a task or
+ * updating uxTopReadyPriority, which may be above it. */
+    #define taskGET_HIGHEST_READY_PRIORITY( uxTopPriority )                                                                      \
+    {                                                                                                                            \
+        ( uxTopPriority ) = uxTopReadyPriority;                                                                                  \
+                                                                                                                                 \
+        while( ( ( uxTopPriority ) > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxReadyTasksLists[ ( uxTopPriority ) ] ) ) != pdFALSE ) ) \
+        {                                                                                                                        \
+            --( uxTopPriority );                                                                                                 \
+        }                                                                                                                        \
+    } /* taskGET_HIGHEST_READY_PRIORITY */
+
+/*-----------------------------------------------------------*/
+
+/* Define away taskRESET_READY_PRIORITY() and taskCLEAR_READY_PRIORITY() as
  * they are only required when a port optimised method of task selection is
  * being used. */
     #define taskRESET_READY_PRIORITY( uxPriority )
-    #define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )
+    #define taskCLEAR_READY_PRIORITY( uxPriority )
 
 #else /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 1 then task selection is
  * performed in a way that is tailored to the particular microcontroller
- * architecture being used. */
+ * architecture being used.  If it is 2 then the same bit map based selection
+ * is used, but the highest set bit is found using the portable de Bruijn
+ * sequence method below rather than a port provided count leading zeros
+ * instruction, so it can be used by ports and host builds that do not
+ * provide the port macros. */
+    #if ( configMAX_PRIORITIES > 1024 )
+        #error configMAX_PRIORITIES must be less than or equal to 1024 when configUSE_PORT_OPTIMISED_TASK_SELECTION is not 0.
+    #endif
+
+    #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 2 )
+        #define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities )      ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+        #define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )       ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+        #define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )    uxTopPriority = prvGetHighestSetBit( ( uint32_t ) ( uxReadyPriorities ) )
+    #endif
+
+    #if ( configMAX_PRIORITIES <= 32 )
+
+/* uxTopReadyPriority is used as a bit map with one bit per priority.  Call
+ * the port defined macros directly. */
+        #define taskRECORD_READY_PRIORITY( uxPriority )         portRECORD_READY_PRIORITY( ( uxPriority ), uxTopReadyPriority )
+        #define taskCLEAR_READY_PRIORITY( uxPriority )          portRESET_READY_PRIORITY( ( uxPriority ), uxTopReadyPriority )
+        #define taskGET_HIGHEST_READY_PRIORITY( uxTopPriority )    portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority )
+
+    #else /* configMAX_PRIORITIES */
+
+/* More priorities than bits in a word are held in a two level bit map.  Bit n
+ * of uxReadyPriorityWords[ g ] is set when priority ( g * 32 ) + n has ready
+ * tasks, and bit g of uxTopReadyPriority is set when uxReadyPriorityWords[ g ]
+ * is not zero.  Each level is a single word, so the port macros find the
+ * highest ready priority in two steps no matter how many priorities are in
+ * use. */
+        #define taskREADY_PRIORITY_WORD_SHIFT    ( 5U )
+        #define taskREADY_PRIORITY_BIT_MASK      ( ( UBaseType_t ) 0x1fU )
+
+        #define taskRECORD_READY_PRIORITY( uxPriority )                                                                                      \
+    {                                                                                                                                    \
+        portRECORD_READY_PRIORITY( ( ( uxPriority ) & taskREADY_PRIORITY_BIT_MASK ), uxReadyPriorityWords[ ( uxPriority ) >> taskREADY_PRIORITY_WORD_SHIFT ] ); \
+        portRECORD_READY_PRIORITY( ( ( uxPriority ) >> taskREADY_PRIORITY_WORD_SHIFT ), uxTopReadyPriority );                            \
+    } /* taskRECORD_READY_PRIORITY */
 
-/* A port optimised version is provided.  Call the port defined macros. */
-    #define taskRECORD_READY_PRIORITY( uxPriority )    portRECORD_READY_PRIORITY( ( uxPriority ), uxTopReadyPriority )
+/*-----------------------------------------------------------*/
+
+        #define taskCLEAR_READY_PRIORITY( uxPriority )                                                                       \
+    {                                                                                                                    \
+        const UBaseType_t uxReadyWord = ( uxPriority ) >> taskREADY_PRIORITY_WORD_SHIFT;                                 \
+                                                                                                                         \
+        portRESET_READY_PRIORITY( ( ( uxPriority ) & taskREADY_PRIORITY_BIT_MASK ), uxReadyPriorityWords[ uxReadyWord ] ); \
+                                                                                                                         \
+        if( uxReadyPriorityWords[ uxReadyWord ] == ( UBaseType_t ) 0 )                                                   \
+        {                                                                                                                \
+            portRESET_READY_PRIORITY( uxReadyWord, uxTopReadyPriority );                                                 \
+        }                                                                                                                \
+    } /* taskCLEAR_READY_PRIORITY */
+
+/*-----------------------------------------------------------*/
+
+        #define taskGET_HIGHEST_READY_PRIORITY( uxTopPriority )                                \
+    {                                                                                      \
+        UBaseType_t uxTopWord;                                                             \
+                                                                                           \
+        portGET_HIGHEST_PRIORITY( uxTopWord, uxTopReadyPriority );                         \
+        portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorityWords[ uxTopWord ] );      \
+        ( uxTopPriority ) += ( uxTopWord << taskREADY_PRIORITY_WORD_SHIFT );               \
+    } /* taskGET_HIGHEST_READY_PRIORITY */
+
+    #endif /* configMAX_PRIORITIES */
 
 /*-----------------------------------------------------------*/
 
@@ -174,9 +251,9 @@
         UBaseType_t uxTopPriority;                                                              \
                                                                                                 \
         /* Find the highest priority list that contains ready tasks. */                         \
-        portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );                          \
+        taskGET_HIGHEST_READY_PRIORITY( uxTopPriority );                                        \
         configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 ); \
-        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );   \
+        taskGET_OWNER_OF_READY_LIST( uxTopPriority );                                           \
     } /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
 /*-----------------------------------------------------------*/
@@ -188,7 +265,7 @@
     {                                                                                                  \
         if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == ( UBaseType_t ) 0 ) \
         {                                                                                              \
-            portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );                        \
+            taskCLEAR_READY_PRIORITY( ( uxPriority ) );                                                \
         }                                                                                              \
     }
 
@@ -196,6 +273,46 @@
 
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+/* Dimensions of the delayed task wheel.  Level n of the wheel holds the tasks
+ * whose wake time first differs from the tick count in the n'th group of
+ * taskWHEEL_SLOT_BITS bits, indexed by the value of that bit group in the wake
+ * time.  Enough levels are used to cover every bit of TickType_t, so the top
+ * level may have fewer than taskWHEEL_SLOTS usable slots. */
+    #if ( configUSE_16_BIT_TICKS == 1 )
+        #define taskWHEEL_TICK_BITS    ( 16U )
+    #else
+        #define taskWHEEL_TICK_BITS    ( 32U )
+    #endif
+
+    #define taskWHEEL_SLOT_BITS        ( ( UBaseType_t ) configDELAYED_TASK_WHEEL_SLOT_BITS )
+    #define taskWHEEL_SLOTS            ( ( UBaseType_t ) 1U << taskWHEEL_SLOT_BITS )
+    #define taskWHEEL_SLOT_MASK        ( taskWHEEL_SLOTS - ( UBaseType_t ) 1U )
+    #define taskWHEEL_LEVELS           ( ( taskWHEEL_TICK_BITS + configDELAYED_TASK_WHEEL_SLOT_BITS - 1U ) / configDELAYED_TASK_WHEEL_SLOT_BITS )
+    #define taskWHEEL_LEVEL_MASK( uxLevel )                                                       \
+    ( ( ( ( uxLevel ) + 1U ) * taskWHEEL_SLOT_BITS > taskWHEEL_TICK_BITS ) ?                      \
+      ( ( ( UBaseType_t ) 1U << ( taskWHEEL_TICK_BITS - ( ( uxLevel ) * taskWHEEL_SLOT_BITS ) ) ) - 1U ) : \
+      taskWHEEL_SLOT_MASK )
+
+/* Wake times that lie beyond a tick count overflow are held in the wheel with
+ * all the others, so when the tick count overflows there are no lists to
+ * switch.  Setting xNextTaskUnblockTime to 0 forces the wheel to be visited on
+ * the overflow tick, which recalculates xNextTaskUnblockTime in the new tick
+ * count epoch. */
+    #define taskSWITCH_DELAYED_LISTS()                \
+    {                                                 \
+        xNumOfOverflows++;                            \
+        xNextTaskUnblockTime = ( TickType_t ) 0U;     \
+    }
+
+/* Is pxList one of the delayed task wheel slots? */
+    #define taskLIST_IS_DELAYED_LIST( pxList )                                                   \
+    ( ( ( pxList ) >= &( xDelayedTaskWheel[ 0 ][ 0 ] ) ) &&                                     \
+      ( ( pxList ) <= &( xDelayedTaskWheel[ taskWHEEL_LEVELS - 1U ][ taskWHEEL_SLOTS - 1U ] ) ) )
+
+#else /* configUSE_DELAYED_TASK_WHEEL */
+
 /* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
  * count overflows. */
 #define taskSWITCH_DELAYED_LISTS()                                                \
@@ -212,16 +329,138 @@
         prvResetNextTaskUnblockTime();                                            \
     }
 
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+/* The running task can only be preempted by a task whose priority is above the
+ * threshold in effect for the running task, which is never below its
+ * priority.  A task holds its threshold from when it starts running until it
+ * leaves the Ready state, so if it is preempted it is resumed ahead of the
+ * ready tasks at or below its threshold.  Tasks on a shared stack hold their
+ * threshold even when it is equal to their priority, so that a task at the
+ * same priority cannot be time sliced in while a job is part way through. */
+    #define taskPREEMPTION_THRESHOLD( pxTCB )                              \
+    ( ( ( pxTCB )->uxPreemptionThreshold > ( pxTCB )->uxPriority ) ?       \
+      ( pxTCB )->uxPreemptionThreshold : ( pxTCB )->uxPriority )
+
+    #if ( configUSE_SHARED_STACKS == 1 )
+        #define taskHOLDS_PREEMPTION_THRESHOLD( pxTCB )                      \
+    ( ( ( pxTCB )->uxPreemptionThreshold > ( pxTCB )->uxPriority ) ||        \
+      ( ( pxTCB )->ucJobState != taskJOB_NONE ) )
+    #else
+        #define taskHOLDS_PREEMPTION_THRESHOLD( pxTCB )    ( ( pxTCB )->uxPreemptionThreshold > ( pxTCB )->uxPriority )
+    #endif
+
+#else /* configUSE_PREEMPTION_THRESHOLD */
+
+    #define taskPREEMPTION_THRESHOLD( pxTCB )          ( ( pxTCB )->uxPriority )
+    #define taskHOLDS_PREEMPTION_THRESHOLD( pxTCB )    ( pdFALSE )
+
+#endif /* configUSE_PREEMPTION_THRESHOLD */
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+/* The ready list for configEDF_TASK_PRIORITY is kept in order of absolute
+ * deadline, with tasks that do not have a deadline after those that do.  The
+ * task at the head of the list is always the one selected to run, so that
+ * priority is not time sliced.  A task that becomes ready at that priority
+ * preempts the running task if its deadline is earlier. */
+    #define taskIS_EDF_PRIORITY( uxPriority )    ( ( uxPriority ) == ( UBaseType_t ) configEDF_TASK_PRIORITY )
+
+    #define taskINSERT_READY_LIST( pxTCB )                                                                 \
+    if( taskIS_EDF_PRIORITY( ( pxTCB )->uxPriority ) )                                                     \
+    {                                                                                                      \
+        prvInsertTaskByDeadline( pxTCB );                                                                  \
+    }                                                                                                      \
+    else                                                                                                   \
+    {                                                                                                      \
+        listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+    }
+
+    #define taskGET_OWNER_OF_READY_LIST( uxPriority )                                                       \
+    if( taskIS_EDF_PRIORITY( uxPriority ) )                                                                 \
+    {                                                                                                       \
+        pxCurrentTCB = listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ ( uxPriority ) ] ) );             \
+    }                                                                                                       \
+    else                                                                                                    \
+    {                                                                                                       \
+        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) );              \
+    }
+
+    #define taskPREEMPTS_CURRENT_TASK( pxTCB )                                    \
+    ( ( ( pxTCB )->uxPriority > taskPREEMPTION_THRESHOLD( pxCurrentTCB ) ) ||     \
+      ( ( ( pxTCB )->uxPriority == pxCurrentTCB->uxPriority ) &&                  \
+        taskIS_EDF_PRIORITY( ( pxTCB )->uxPriority ) &&                           \
+        ( taskHOLDS_PREEMPTION_THRESHOLD( pxCurrentTCB ) == pdFALSE ) &&          \
+        ( prvDeadlineIsEarlier( ( pxTCB ), pxCurrentTCB ) != pdFALSE ) ) )
+
+#else /* configUSE_EDF_SCHEDULING */
+
+    #define taskIS_EDF_PRIORITY( uxPriority )            ( pdFALSE )
+    #define taskINSERT_READY_LIST( pxTCB )               listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) )
+    #define taskGET_OWNER_OF_READY_LIST( uxPriority )    listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+    #define taskPREEMPTS_CURRENT_TASK( pxTCB )           ( ( pxTCB )->uxPriority > taskPREEMPTION_THRESHOLD( pxCurrentTCB ) )
+
+#endif /* configUSE_EDF_SCHEDULING */
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DYNAMIC_TICK == 1 )
+
+/* Without a periodic tick interrupt xTickCount is only brought up to date when
+ * it is read, so any code that needs the current time must read it through
+ * this macro. */
+    #define taskSYNCED_TICK_COUNT()    ( portSYNC_TICK_COUNT(), xTickCount )
+
+/* A task that becomes ready at a priority that is time slicing needs tick
+ * interrupts to be generated on every tick again. */
+    #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+        #define taskUPDATE_TICK_INTERRUPT_FOR_TIME_SLICE( pxTCB )                                                     \
+    if( ( xSchedulerRunning != pdFALSE ) &&                                                                           \
+        ( ( pxTCB )->uxPriority >= pxCurrentTCB->uxPriority ) &&                                                      \
+        ( taskIS_EDF_PRIORITY( ( pxTCB )->uxPriority ) == pdFALSE ) &&                                                \
+        ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ) ) > ( UBaseType_t ) 1 ) ) \
+    {                                                                                                                 \
+        portUPDATE_TICK_INTERRUPT();                                                                                  \
+    }
+    #else
+        #define taskUPDATE_TICK_INTERRUPT_FOR_TIME_SLICE( pxTCB )
+    #endif
+
+#else /* configUSE_DYNAMIC_TICK */
+
+    #define taskSYNCED_TICK_COUNT()    ( xTickCount )
+    #define taskUPDATE_TICK_INTERRUPT_FOR_TIME_SLICE( pxTCB )
+
+#endif /* configUSE_DYNAMIC_TICK */
+
+/*-----------------------------------------------------------*/
+
+#if ( configTICK_UNBLOCK_LIMIT > 0 )
+
+/* Passed to prvUnblockDeferredTasks() where every task that is due has to be
+ * moved before returning, whatever configTICK_UNBLOCK_LIMIT is set to. */
+    #define taskUNBLOCK_ALL    ( ( UBaseType_t ) ~( ( UBaseType_t ) 0U ) )
+
+#endif
+
 /*-----------------------------------------------------------*/
 
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
- * the task.  It is inserted at the end of the list.
+ * the task.  It is inserted at the end of the list, or in deadline order if
+ * the list is scheduled earliest deadline first.
  */
-#define prvAddTaskToReadyList( pxTCB )                                                                 \
-    traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
-    taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
-    listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+#define prvAddTaskToReadyList( pxTCB )                    \
+    traceMOVED_TASK_TO_READY_STATE( pxTCB );              \
+    taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );   \
+    taskINSERT_READY_LIST( pxTCB );                       \
+    taskUPDATE_TICK_INTERRUPT_FOR_TIME_SLICE( pxTCB );    \
     tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
 /*-----------------------------------------------------------*/
 
@@ -247,6 +486,47 @@
     #define taskEVENT_LIST_ITEM_VALUE_IN_USE    0x80000000UL
 #endif
 
+/* xPendedTicks is also incremented by the tick interrupt.  A 32-bit tick
+ * count is added to with an atomic operation, which does not mask interrupts
+ * on ports that implement atomic.h natively. */
+#if ( configUSE_16_BIT_TICKS == 1 )
+    #define taskADD_PENDED_TICKS( xTicks )  \
+    {                                       \
+        taskENTER_CRITICAL();               \
+        {                                   \
+            xPendedTicks += ( xTicks );     \
+        }                                   \
+        taskEXIT_CRITICAL();                \
+    }
+#else
+    #define taskADD_PENDED_TICKS( xTicks )    ( void ) Atomic_Add_u32( ( uint32_t volatile * ) &xPendedTicks, ( uint32_t ) ( xTicks ) )
+#endif
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+/* Values that can be assigned to the ucBudgetState member of the TCB. */
+    #define taskBUDGET_AVAILABLE    ( ( uint8_t ) 0 ) /* The task has not used up its budget for the current period. */
+    #define taskBUDGET_EXHAUSTED    ( ( uint8_t ) 1 ) /* The task has used up its budget, and is blocked if it runs on when eBudgetSuspend is used. */
+    #define taskBUDGET_DEMOTED      ( ( uint8_t ) 2 ) /* The task has used up its budget and is running at the idle priority. */
+
+/* Evaluates to pdTRUE if the period of pxTCB's budget ended at or before
+ * xTime.  The budget is replenished lazily, so the end of the period can be
+ * any amount of time in the past, but it is never more than one period in the
+ * future. */
+    #define taskBUDGET_PERIOD_ENDED( pxTCB, xTime )    ( ( TickType_t ) ( ( pxTCB )->xBudgetReplenishTime - ( xTime ) - ( TickType_t ) 1 ) >= ( pxTCB )->xBudgetPeriod )
+
+#endif /* configUSE_TASK_BUDGETS */
+
+#if ( configUSE_SHARED_STACKS == 1 )
+
+/* Values that can be assigned to the ucJobState member of the TCB. */
+    #define taskJOB_NONE       ( ( uint8_t ) 0 ) /* The task has a stack of its own. */
+    #define taskJOB_IDLE       ( ( uint8_t ) 1 ) /* The task is on a shared stack and is not running its job code, so it can block. */
+    #define taskJOB_RUNNING    ( ( uint8_t ) 2 ) /* The task is running its job code, so must not block. */
+    #define taskJOB_WAITING    ( ( uint8_t ) 3 ) /* The task blocked between jobs, so its context is not needed and is rebuilt when it next runs. */
+
+#endif /* configUSE_SHARED_STACKS */
+
 /*
  * Task control block.  A task control block (TCB) is allocated for each task,
  * and stores task state information, including a pointer to the task's context
@@ -318,6 +598,43 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
+
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+        TickType_t xRelativeDeadline; /*< The deadline of each release relative to the release time, or 0 if the task is not deadline scheduled. */
+        TickType_t xAbsoluteDeadline; /*< The tick count by which the current release must complete. */
+        UBaseType_t uxDeadlineMisses; /*< The number of releases that completed after their deadline. */
+    #endif
+
+    #if ( configUSE_TASK_BUDGETS == 1 )
+        ListItem_t xBudgetListItem;       /*< Used to reference the task from xBudgetedTaskList. */
+        uint32_t ulBudget;                /*< The budget counter time the task may run for in each period, or 0 if the task does not have a budget. */
+        uint32_t ulBudgetUsed;            /*< The budget counter time the task has run for in the current period. */
+        uint32_t ulPeakBudgetUsed;        /*< The most budget counter time the task has run for in a period. */
+        TickType_t xBudgetPeriod;         /*< The number of ticks between budget replenishments. */
+        TickType_t xBudgetReplenishTime;  /*< The tick count at which the current period ends. */
+        UBaseType_t uxBudgetOverruns;     /*< The number of periods in which the task used up its budget. */
+        UBaseType_t uxBudgetPriority;     /*< The priority the task was running at when it was demoted. */
+        uint8_t ucBudgetAction;           /*< The eBudgetAction taken when the task uses up its budget. */
+        uint8_t ucBudgetState;            /*< One of the taskBUDGET_ values. */
+    #endif
+
+    #if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+        UBaseType_t uxPreemptionThreshold;                 /*< Once the task is running it can only be preempted by tasks above this priority. */
+        struct tskTaskControlBlock * pxNextPreemptedTask;  /*< The task below this one in the pxPreemptedTasks stack. */
+    #endif
+
+    #if ( configUSE_SHARED_STACKS == 1 )
+        TaskFunction_t pxJobCode;      /*< The function run each time a task on a shared stack is released. */
+        void * pvJobParameters;        /*< The parameter passed to pxJobCode. */
+        StackType_t * pxJobStackTop;   /*< The top of the shared stack, from which the context of the task is rebuilt. */
+        TickType_t xJobPeriod;         /*< The number of ticks between releases, or 0 if the task is released by notifications. */
+        TickType_t xJobReleaseTime;    /*< The time of the last periodic release. */
+        uint8_t ucJobState;            /*< One of the taskJOB_ values. */
+    #endif
+
+    #if ( configUSE_WAITSETS == 1 )
+        uint32_t ulWaitSetBits[ configTASK_NOTIFICATION_ARRAY_ENTRIES ]; /*< The bits posted to the waitset of the task when a notification index is notified, or 0 if the index is not a member. */
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -333,10 +650,17 @@ portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
  * doing so breaks some kernel aware debuggers and debuggers that rely on removing
  * the static qualifier. */
 PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ]; /*< Prioritised ready tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList1;                         /*< Delayed tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList2;                         /*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;      /*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+    PRIVILEGED_DATA static List_t xDelayedTaskWheel[ taskWHEEL_LEVELS ][ taskWHEEL_SLOTS ]; /*< Delayed tasks, unsorted within each slot. */
+    PRIVILEGED_DATA static uint32_t ulDelayedTaskWheelMap[ taskWHEEL_LEVELS ];               /*< Bit n is set if slot n of the level may hold a task.  Bits are cleared lazily, so a set bit can refer to an empty slot. */
+#else
+    PRIVILEGED_DATA static List_t xDelayedTaskList1;                    /*< Delayed tasks. */
+    PRIVILEGED_DATA static List_t xDelayedTaskList2;                    /*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+    PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;         /*< Points to the delayed task list currently being used. */
+    PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList; /*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#endif
+
 PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if ( INCLUDE_vTaskDelete == 1 )
@@ -362,6 +686,11 @@ PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tas
 PRIVILEGED_DATA static volatile UBaseType_t uxCurrentNumberOfTasks = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
 PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
+
+#if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION != 0 ) && ( configMAX_PRIORITIES > 32 ) )
+    PRIVILEGED_DATA static volatile UBaseType_t uxReadyPriorityWords[ ( configMAX_PRIORITIES + 31 ) / 32 ]; /*< Second level of the ready priority bit map, see taskRECORD_READY_PRIORITY(). */
+#endif
+
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning = pdFALSE;
 PRIVILEGED_DATA static volatile TickType_t xPendedTicks = ( TickType_t ) 0U;
 PRIVILEGED_DATA static volatile BaseType_t xYieldPending = pdFALSE;
@@ -394,6 +723,27 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t
 
 #endif
 
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+    PRIVILEGED_DATA static List_t xBudgetedTaskList;                               /*< Tasks that have been given an execution time budget. */
+    PRIVILEGED_DATA static uint32_t ulBudgetChargedTime = 0UL;                     /*< Holds the budget counter value the last time the running task was charged for its execution time. */
+    PRIVILEGED_DATA static UBaseType_t uxBudgetDemotedTasks = ( UBaseType_t ) 0U;   /*< The number of tasks that are demoted until their budget is replenished. */
+    PRIVILEGED_DATA static TickType_t xNextBudgetReplenishTime = ( TickType_t ) 0U; /*< The earliest tick count at which a demoted task's budget is replenished. */
+
+#endif
+
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+    PRIVILEGED_DATA static TCB_t * pxPreemptedTasks = NULL; /*< Ready tasks that were preempted while holding their preemption threshold, most recently preempted first.  Each task's threshold is below the priority of the task above it. */
+
+#endif
+
+#if ( configTICK_UNBLOCK_LIMIT > 0 )
+
+    PRIVILEGED_DATA static volatile BaseType_t xTickUnblocksDeferred = pdFALSE; /*< Set when xTaskIncrementTick() reached configTICK_UNBLOCK_LIMIT with tasks still due at the current tick count.  Cleared once xTaskUnblockDeferred() has moved them all. */
+
+#endif
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -510,12 +860,97 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 
 #endif
 
+/*
+ * Return the bit number of the most significant set bit in ulBits, which
+ * must not be zero.  Used in place of a count leading zeros instruction when
+ * configUSE_PORT_OPTIMISED_TASK_SELECTION is 2, and to search the waiting
+ * priorities of event lists when the port does not provide one.
+ */
+#if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 2 ) || ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_PRIORITY_EVENT_LISTS == 1 ) ) )
+
+    static UBaseType_t prvGetHighestSetBit( uint32_t ulBits ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+
+/*
+ * Place an event list item, whose value holds the owning task's priority in
+ * the same form used to sort ordinary event lists, at the end of the waiting
+ * list for that priority.
+ */
+    static void prvEventListInsert( EventList_t * const pxEventList,
+                                    ListItem_t * const pxEventListItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the highest priority waiting list of pxEventList that is not empty,
+ * or NULL if no tasks are waiting.  Clears the bits of any higher priority
+ * waiting lists that have been emptied by tasks timing out.
+ */
+    static List_t * prvEventListGetHighestWaitingList( EventList_t * const pxEventList ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Set xNextTaskUnblockTime to the time at which the next Blocked state task
  * will exit the Blocked state.
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Moves the tasks whose wake time has been reached at xTimeNow from the delayed
+ * task list, or wheel, to the ready lists, then recalculates xNextTaskUnblockTime.  If
+ * configTICK_UNBLOCK_LIMIT is greater than 0 no more than uxUnblockLimit tasks
+ * are moved - if tasks are still due after that xTickUnblocksDeferred is set
+ * and xNextTaskUnblockTime is left at xTimeNow.  Returns pdTRUE if a context
+ * switch is required.
+ */
+static BaseType_t prvUnblockDueTasks( const TickType_t xTimeNow,
+                                      UBaseType_t uxUnblockLimit ) PRIVILEGED_FUNCTION;
+
+#if ( configTICK_UNBLOCK_LIMIT > 0 )
+
+/*
+ * Clears xTickUnblocksDeferred and carries on moving the tasks that are due at
+ * the current tick count, up to uxUnblockLimit of them.  Returns pdTRUE if a
+ * context switch is required.
+ */
+    static BaseType_t prvUnblockDeferredTasks( UBaseType_t uxUnblockLimit ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+/*
+ * Place the state list item of a Blocked task, which already holds the task's
+ * wake time, into the delayed task wheel slot chosen by comparing the wake time
+ * with xTimeNow.  Returns the number of ticks until that slot is next visited.
+ */
+    static TickType_t prvDelayedTaskWheelInsert( ListItem_t * const pxStateListItem,
+                                                 const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called from the tick interrupt when the tick count reaches
+ * xNextTaskUnblockTime.  Moves tasks down the wheel levels whose slot boundary
+ * has been reached, unblocks the tasks whose wake time is xTimeNow, then
+ * recalculates xNextTaskUnblockTime.  Returns pdTRUE if a context switch is
+ * required.  If configTICK_UNBLOCK_LIMIT is greater than 0 it stops after
+ * uxMoveLimit tasks have been moved, counting moves between levels as well as
+ * unblocks, and can be called again with the same xTimeNow to continue.
+ */
+    static BaseType_t prvDelayedTaskWheelAdvance( const TickType_t xTimeNow,
+                                                  UBaseType_t uxMoveLimit ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the tick count at which the delayed task wheel next needs to be
+ * visited, or portMAX_DELAY if that is not before the tick count overflows.
+ * The returned time may be earlier than the next wake time of any task, but
+ * is never later.
+ */
+    static TickType_t prvDelayedTaskWheelNextVisitTime( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
 /*
@@ -546,6 +981,128 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
  */
 static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
+/*
+ * Create a task using the statically allocated TCB and stack, without adding
+ * it to a ready list.  Returns NULL if either buffer is NULL.
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    static TCB_t * prvCreateStaticTask( TaskFunction_t pxTaskCode,
+                                        const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                        const uint32_t ulStackDepth,
+                                        void * const pvParameters,
+                                        UBaseType_t uxPriority,
+                                        StackType_t * const puxStackBuffer,
+                                        StaticTask_t * const pxTaskBuffer,
+                                        TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+/*
+ * Returns pdTRUE if pxTCB should run before pxOtherTCB within the deadline
+ * scheduled priority - that is if pxTCB has a deadline and pxOtherTCB either
+ * has a later deadline or no deadline at all.
+ */
+    static BaseType_t prvDeadlineIsEarlier( const TCB_t * const pxTCB,
+                                            const TCB_t * const pxOtherTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Insert pxTCB into the ready list of configEDF_TASK_PRIORITY after all the
+ * tasks that have an earlier or equal deadline.
+ */
+    static void prvInsertTaskByDeadline( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+/*
+ * Add the budget counter time that has passed since the running task was
+ * last charged to the budget used by the running task, first replenishing
+ * its budget if its period has ended.
+ */
+    static void prvBudgetCharge( const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Start the next period of pxTCB's budget.
+ */
+    static void prvBudgetReplenish( TCB_t * const pxTCB,
+                                    const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move pxTCB to uxNewPriority, in the same way vTaskPrioritySet() changes the
+ * priority being used by a task.
+ */
+    static void prvBudgetSetPriority( TCB_t * const pxTCB,
+                                      const UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return a demoted task to the priority it was demoted from.
+ */
+    static void prvBudgetRestorePriority( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called from the tick interrupt and on each context switch.  Restores demoted
+ * tasks whose budget is due to be replenished, charges the running task for
+ * the time it has run, and demotes or blocks the running task if it has used
+ * up its budget.  Returns pdTRUE if a context switch is required as a result.
+ */
+    static BaseType_t prvBudgetEnforce( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+
+/*
+ * Select the task to run next in place of taskSELECT_HIGHEST_PRIORITY_TASK().
+ * The running task is added to pxPreemptedTasks if it is still ready and
+ * holds its preemption threshold, and the most recently preempted task is
+ * resumed unless a ready task has a priority above that task's threshold.
+ */
+    static void prvSelectTaskWithThreshold( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove pxTCB from pxPreemptedTasks, if it is there, because it is leaving
+ * the Ready state other than by blocking itself.
+ */
+    static void prvRemovePreemptedTask( const TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_SHARED_STACKS == 1 )
+
+/*
+ * The task function of every task created by xTaskCreateStaticSharedStack().
+ * Runs the job code of the task each time the task is released.
+ */
+    static portTASK_FUNCTION_PROTO( prvSharedStackTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called when pxCurrentTCB is about to start running.  If the task is on a
+ * shared stack and blocked between jobs then its context was not kept, so it
+ * is rebuilt at the top of the shared stack to start prvSharedStackTask()
+ * again.
+ */
+    static void prvSharedStackPrepareTask( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_WAITSETS == 1 )
+
+/*
+ * Called when notification index uxIndexToNotify of pxTCB is notified.  If the
+ * index is a member of the waitset of the task then the bits of the member
+ * are posted to configWAITSET_NOTIFICATION_INDEX.  Returns pdTRUE if the task
+ * was blocked waiting on its waitset, in which case the caller must unblock
+ * it.  Must be called with interrupts masked.
+ */
+    static BaseType_t prvNotifyWaitSet( TCB_t * const pxTCB,
+                                        UBaseType_t uxIndexToNotify ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * freertos_tasks_c_additions_init() should only be called if the user definable
  * macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is the only macro
@@ -561,16 +1118,16 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 
-    TaskHandle_t xTaskCreateStatic( TaskFunction_t pxTaskCode,
-                                    const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-                                    const uint32_t ulStackDepth,
-                                    void * const pvParameters,
-                                    UBaseType_t uxPriority,
-                                    StackType_t * const puxStackBuffer,
-                                    StaticTask_t * const pxTaskBuffer )
+    static TCB_t * prvCreateStaticTask( TaskFunction_t pxTaskCode,
+                                        const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                        const uint32_t ulStackDepth,
+                                        void * const pvParameters,
+                                        UBaseType_t uxPriority,
+                                        StackType_t * const puxStackBuffer,
+                                        StaticTask_t * const pxTaskBuffer,
+                                        TaskHandle_t * const pxCreatedTask )
     {
         TCB_t * pxNewTCB;
-        TaskHandle_t xReturn;
 
         configASSERT( puxStackBuffer != NULL );
         configASSERT( pxTaskBuffer != NULL );
@@ -602,79 +1159,214 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
             }
             #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
 
-            prvInitialiseNewTask( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, &xReturn, pxNewTCB, NULL );
-            prvAddNewTaskToReadyList( pxNewTCB );
+            prvInitialiseNewTask( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
         }
         else
         {
-            xReturn = NULL;
+            pxNewTCB = NULL;
         }
 
-        return xReturn;
+        return pxNewTCB;
     }
-
-#endif /* SUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
-#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
-
-    BaseType_t xTaskCreateRestrictedStatic( const TaskParameters_t * const pxTaskDefinition,
-                                            TaskHandle_t * pxCreatedTask )
+    TaskHandle_t xTaskCreateStatic( TaskFunction_t pxTaskCode,
+                                    const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                    const uint32_t ulStackDepth,
+                                    void * const pvParameters,
+                                    UBaseType_t uxPriority,
+                                    StackType_t * const puxStackBuffer,
+                                    StaticTask_t * const pxTaskBuffer )
     {
         TCB_t * pxNewTCB;
-        BaseType_t xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+        TaskHandle_t xReturn = NULL;
 
-        configASSERT( pxTaskDefinition->puxStackBuffer != NULL );
-        configASSERT( pxTaskDefinition->pxTaskBuffer != NULL );
+        pxNewTCB = prvCreateStaticTask( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, puxStackBuffer, pxTaskBuffer, &xReturn );
 
-        if( ( pxTaskDefinition->puxStackBuffer != NULL ) && ( pxTaskDefinition->pxTaskBuffer != NULL ) )
+        if( pxNewTCB != NULL )
         {
-            /* Allocate space for the TCB.  Where the memory comes from depends
-             * on the implementation of the port malloc function and whether or
-             * not static allocation is being used. */
-            pxNewTCB = ( TCB_t * ) pxTaskDefinition->pxTaskBuffer;
-            memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
-
-            /* Store the stack location in the TCB. */
-            pxNewTCB->pxStack = pxTaskDefinition->puxStackBuffer;
-
-            #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
-            {
-                /* Tasks can be created statically or dynamically, so note this
-                 * task was created statically in case the task is later deleted. */
-                pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
-            }
-            #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
-
-            prvInitialiseNewTask( pxTaskDefinition->pvTaskCode,
-                                  pxTaskDefinition->pcName,
-                                  ( uint32_t ) pxTaskDefinition->usStackDepth,
-                                  pxTaskDefinition->pvParameters,
-                                  pxTaskDefinition->uxPriority,
-                                  pxCreatedTask, pxNewTCB,
-                                  pxTaskDefinition->xRegions );
-
             prvAddNewTaskToReadyList( pxNewTCB );
-            xReturn = pdPASS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
 
         return xReturn;
     }
 
-#endif /* ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+#endif /* SUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
-#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_EDF_SCHEDULING == 1 ) )
 
-    BaseType_t xTaskCreateRestricted( const TaskParameters_t * const pxTaskDefinition,
-                                      TaskHandle_t * pxCreatedTask )
+    TaskHandle_t xTaskCreateStaticWithDeadline( TaskFunction_t pxTaskCode,
+                                                const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                                const uint32_t ulStackDepth,
+                                                void * const pvParameters,
+                                                const TickType_t xRelativeDeadline,
+                                                StackType_t * const puxStackBuffer,
+                                                StaticTask_t * const pxTaskBuffer )
     {
         TCB_t * pxNewTCB;
-        BaseType_t xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+        TaskHandle_t xReturn = NULL;
 
-        configASSERT( pxTaskDefinition->puxStackBuffer );
+        /* Deadlines are compared relative to each other, so must be less than
+         * half the range of the tick count apart. */
+        configASSERT( xRelativeDeadline > ( TickType_t ) 0 );
+        configASSERT( xRelativeDeadline <= ( portMAX_DELAY >> 2 ) );
 
-        if( pxTaskDefinition->puxStackBuffer != NULL )
+        pxNewTCB = prvCreateStaticTask( pxTaskCode, pcName, ulStackDepth, pvParameters, ( UBaseType_t ) configEDF_TASK_PRIORITY, puxStackBuffer, pxTaskBuffer, &xReturn );
+
+        if( pxNewTCB != NULL )
+        {
+            /* The first release is the time at which the task is created. */
+            pxNewTCB->xRelativeDeadline = xRelativeDeadline;
+            pxNewTCB->xAbsoluteDeadline = taskSYNCED_TICK_COUNT() + xRelativeDeadline;
+
+            prvAddNewTaskToReadyList( pxNewTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_EDF_SCHEDULING == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_SHARED_STACKS == 1 )
+
+    TaskHandle_t xTaskCreateStaticSharedStack( TaskFunction_t pxJobCode,
+                                               const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                               const uint32_t ulStackDepth,
+                                               void * const pvParameters,
+                                               UBaseType_t uxPriority,
+                                               UBaseType_t uxPreemptionThreshold,
+                                               const TickType_t xPeriod,
+                                               StackType_t * const puxSharedStackBuffer,
+                                               StaticTask_t * const pxTaskBuffer )
+    {
+        TCB_t * pxNewTCB;
+        TaskHandle_t xReturn = NULL;
+
+        configASSERT( pxJobCode != NULL );
+        configASSERT( uxPreemptionThreshold < configMAX_PRIORITIES );
+
+        if( uxPreemptionThreshold >= ( UBaseType_t ) configMAX_PRIORITIES )
+        {
+            uxPreemptionThreshold = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxNewTCB = prvCreateStaticTask( prvSharedStackTask, pcName, ulStackDepth, pvParameters, uxPriority, puxSharedStackBuffer, pxTaskBuffer, &xReturn );
+
+        if( pxNewTCB != NULL )
+        {
+            pxNewTCB->uxPreemptionThreshold = uxPreemptionThreshold;
+            pxNewTCB->pxJobCode = pxJobCode;
+            pxNewTCB->pvJobParameters = pvParameters;
+            pxNewTCB->xJobPeriod = xPeriod;
+
+            /* The first periodic release is the time at which the task is
+             * created. */
+            pxNewTCB->xJobReleaseTime = taskSYNCED_TICK_COUNT();
+
+            /* The context of the task is rebuilt from the same top of stack
+             * each time it starts a job after blocking. */
+            #if ( portSTACK_GROWTH < 0 )
+            {
+                pxNewTCB->pxJobStackTop = &( puxSharedStackBuffer[ ulStackDepth - ( uint32_t ) 1 ] );
+                pxNewTCB->pxJobStackTop = ( StackType_t * ) ( ( ( portPOINTER_SIZE_TYPE ) pxNewTCB->pxJobStackTop ) & ( ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) ) ); /*lint !e923 !e9033 !e9078 MISRA exception.  Avoiding casts between pointers and integers is not practical.  Size differences accounted for using portPOINTER_SIZE_TYPE type. */
+            }
+            #else /* portSTACK_GROWTH */
+            {
+                pxNewTCB->pxJobStackTop = puxSharedStackBuffer;
+            }
+            #endif /* portSTACK_GROWTH */
+
+            /* Creating another task on the same stack overwrites the context
+             * built when this task was created, so build it again when the task
+             * first runs. */
+            pxNewTCB->ucJobState = taskJOB_WAITING;
+
+            prvAddNewTaskToReadyList( pxNewTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_SHARED_STACKS */
+/*-----------------------------------------------------------*/
+
+#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    BaseType_t xTaskCreateRestrictedStatic( const TaskParameters_t * const pxTaskDefinition,
+                                            TaskHandle_t * pxCreatedTask )
+    {
+        TCB_t * pxNewTCB;
+        BaseType_t xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+
+        configASSERT( pxTaskDefinition->puxStackBuffer != NULL );
+        configASSERT( pxTaskDefinition->pxTaskBuffer != NULL );
+
+        if( ( pxTaskDefinition->puxStackBuffer != NULL ) && ( pxTaskDefinition->pxTaskBuffer != NULL ) )
+        {
+            /* Allocate space for the TCB.  Where the memory comes from depends
+             * on the implementation of the port malloc function and whether or
+             * not static allocation is being used. */
+            pxNewTCB = ( TCB_t * ) pxTaskDefinition->pxTaskBuffer;
+            memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+
+            /* Store the stack location in the TCB. */
+            pxNewTCB->pxStack = pxTaskDefinition->puxStackBuffer;
+
+            #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
+            {
+                /* Tasks can be created statically or dynamically, so note this
+                 * task was created statically in case the task is later deleted. */
+                pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+            }
+            #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+
+            prvInitialiseNewTask( pxTaskDefinition->pvTaskCode,
+                                  pxTaskDefinition->pcName,
+                                  ( uint32_t ) pxTaskDefinition->usStackDepth,
+                                  pxTaskDefinition->pvParameters,
+                                  pxTaskDefinition->uxPriority,
+                                  pxCreatedTask, pxNewTCB,
+                                  pxTaskDefinition->xRegions );
+
+            prvAddNewTaskToReadyList( pxNewTCB );
+            xReturn = pdPASS;
+        }
+
+        return xReturn;
+    }
+
+#endif /* ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    BaseType_t xTaskCreateRestricted( const TaskParameters_t * const pxTaskDefinition,
+                                      TaskHandle_t * pxCreatedTask )
+    {
+        TCB_t * pxNewTCB;
+        BaseType_t xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+
+        configASSERT( pxTaskDefinition->puxStackBuffer );
+
+        if( pxTaskDefinition->puxStackBuffer != NULL )
         {
             /* Allocate space for the TCB.  Where the memory comes from depends
              * on the implementation of the port malloc function and whether or
@@ -940,6 +1632,27 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
     listSET_LIST_ITEM_OWNER( &( pxNewTCB->xEventListItem ), pxNewTCB );
 
+    #if ( configUSE_TASK_BUDGETS == 1 )
+    {
+        vListInitialiseItem( &( pxNewTCB->xBudgetListItem ) );
+        listSET_LIST_ITEM_OWNER( &( pxNewTCB->xBudgetListItem ), pxNewTCB );
+    }
+    #endif
+
+    #if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+    {
+        pxNewTCB->uxPreemptionThreshold = uxPriority;
+        pxNewTCB->pxNextPreemptedTask = NULL;
+    }
+    #endif
+
+    #if ( configUSE_SHARED_STACKS == 1 )
+    {
+        pxNewTCB->pxJobCode = NULL;
+        pxNewTCB->ucJobState = taskJOB_NONE;
+    }
+    #endif
+
     #if ( portUSING_MPU_WRAPPERS == 1 )
     {
         vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
@@ -1091,7 +1804,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     {
         /* If the created task is of a higher priority than the current task
          * then it should run now. */
-        if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+        if( taskPREEMPTS_CURRENT_TASK( pxNewTCB ) )
         {
             taskYIELD_IF_USING_PREEMPTION();
         }
@@ -1106,154 +1819,287 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     }
 }
 /*-----------------------------------------------------------*/
+#if ( configUSE_EDF_SCHEDULING == 1 )
 
-#if ( INCLUDE_vTaskDelete == 1 )
+    static BaseType_t prvDeadlineIsEarlier( const TCB_t * const pxTCB,
+                                            const TCB_t * const pxOtherTCB )
+    {
+        BaseType_t xReturn = pdFALSE;
+        TickType_t xDifference;
 
-    void vTaskDelete( TaskHandle_t xTaskToDelete )
+        if( pxTCB->xRelativeDeadline != ( TickType_t ) 0 )
+        {
+            if( pxOtherTCB->xRelativeDeadline == ( TickType_t ) 0 )
+            {
+                /* Tasks without a deadline run after all those with one. */
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                /* Compare the deadlines relative to each other, rather than
+                 * as absolute values, so the order is still correct when the
+                 * tick count overflows. */
+                xDifference = ( TickType_t ) ( pxOtherTCB->xAbsoluteDeadline - pxTCB->xAbsoluteDeadline );
+
+                if( ( xDifference != ( TickType_t ) 0 ) && ( xDifference <= ( portMAX_DELAY >> 1 ) ) )
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInsertTaskByDeadline( TCB_t * const pxTCB )
     {
-        TCB_t * pxTCB;
+        List_t * const pxList = &( pxReadyTasksLists[ pxTCB->uxPriority ] );
+        ListItem_t * const pxNewListItem = &( pxTCB->xStateListItem );
+        ListItem_t * pxIterator;
 
-        taskENTER_CRITICAL();
+        /* Find the first task that should run after the task being inserted,
+         * so tasks with equal deadlines run in the order they became ready. */
+        for( pxIterator = listGET_HEAD_ENTRY( pxList ); pxIterator != listGET_END_MARKER( pxList ); pxIterator = listGET_NEXT( pxIterator ) ) /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
         {
-            /* If null is passed in here then it is the calling task that is
-             * being deleted. */
-            pxTCB = prvGetTCBFromHandle( xTaskToDelete );
+            if( prvDeadlineIsEarlier( pxTCB, listGET_LIST_ITEM_OWNER( pxIterator ) ) != pdFALSE )
+            {
+                break;
+            }
+        }
 
-            /* Remove task from the ready/delayed list. */
-            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+        /* Insert the new list item in front of pxIterator. */
+        pxNewListItem->pxNext = pxIterator;
+        pxNewListItem->pxPrevious = pxIterator->pxPrevious;
+        pxIterator->pxPrevious->pxNext = pxNewListItem;
+        pxIterator->pxPrevious = pxNewListItem;
+
+        pxNewListItem->pxContainer = pxList;
+        ( pxList->uxNumberOfItems )++;
+    }
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+    static void prvBudgetCharge( const TickType_t xConstTickCount )
+    {
+        const uint32_t ulCounterValue = portGET_BUDGET_COUNTER_VALUE();
+        TCB_t * const pxTCB = pxCurrentTCB;
+
+        if( pxTCB->ulBudget != 0UL )
+        {
+            /* The budget of a demoted task is replenished by prvBudgetEnforce()
+             * as its priority has to be restored at the same time. */
+            if( ( pxTCB->ucBudgetState != taskBUDGET_DEMOTED ) && ( taskBUDGET_PERIOD_ENDED( pxTCB, xConstTickCount ) != pdFALSE ) )
             {
-                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+                prvBudgetReplenish( pxTCB, xConstTickCount );
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
 
-            /* Is the task waiting on an event also? */
-            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+            /* The counter is free running so the subtraction gives the
+             * correct result when it wraps, provided the task is charged at
+             * least once per counter period. */
+            pxTCB->ulBudgetUsed += ulCounterValue - ulBudgetChargedTime;
+
+            if( ( pxTCB->ulBudgetUsed >= pxTCB->ulBudget ) && ( pxTCB->ucBudgetState == taskBUDGET_AVAILABLE ) )
             {
-                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+                pxTCB->ucBudgetState = taskBUDGET_EXHAUSTED;
+                ( pxTCB->uxBudgetOverruns )++;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-            /* Increment the uxTaskNumber also so kernel aware debuggers can
-             * detect that the task lists need re-generating.  This is done before
-             * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
-             * not return. */
-            uxTaskNumber++;
+        ulBudgetChargedTime = ulCounterValue;
+    }
+/*-----------------------------------------------------------*/
 
-            if( pxTCB == pxCurrentTCB )
-            {
-                /* A task is deleting itself.  This cannot complete within the
-                 * task itself, as a context switch to another task is required.
-                 * Place the task in the termination list.  The idle task will
-                 * check the termination list and free up any memory allocated by
-                 * the scheduler for the TCB and stack of the deleted task. */
-                vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
+    static void prvBudgetReplenish( TCB_t * const pxTCB,
+                                    const TickType_t xConstTickCount )
+    {
+        if( pxTCB->ulBudgetUsed > pxTCB->ulPeakBudgetUsed )
+        {
+            pxTCB->ulPeakBudgetUsed = pxTCB->ulBudgetUsed;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-                /* Increment the ucTasksDeleted variable so the idle task knows
-                 * there is a task that has been deleted and that it should therefore
-                 * check the xTasksWaitingTermination list. */
-                ++uxDeletedTasksWaitingCleanUp;
+        pxTCB->ulBudgetUsed = 0UL;
+        pxTCB->ucBudgetState = taskBUDGET_AVAILABLE;
 
-                /* Call the delete hook before portPRE_TASK_DELETE_HOOK() as
-                 * portPRE_TASK_DELETE_HOOK() does not return in the Win32 port. */
-                traceTASK_DELETE( pxTCB );
+        /* Move to the period that contains xConstTickCount, skipping any the
+         * task did not run in, so the periods stay aligned to when the budget
+         * was set. */
+        pxTCB->xBudgetReplenishTime += ( ( ( TickType_t ) ( xConstTickCount - pxTCB->xBudgetReplenishTime ) / pxTCB->xBudgetPeriod ) + ( TickType_t ) 1 ) * pxTCB->xBudgetPeriod;
+    }
+/*-----------------------------------------------------------*/
 
-                /* The pre-delete hook is primarily for the Windows simulator,
-                 * in which Windows specific clean up operations are performed,
-                 * after which it is not possible to yield away from this task -
-                 * hence xYieldPending is used to latch that a context switch is
-                 * required. */
-                portPRE_TASK_DELETE_HOOK( pxTCB, &xYieldPending );
-            }
-            else
-            {
-                --uxCurrentNumberOfTasks;
-                traceTASK_DELETE( pxTCB );
+    static void prvBudgetSetPriority( TCB_t * const pxTCB,
+                                      const UBaseType_t uxNewPriority )
+    {
+        const UBaseType_t uxPriorityUsedOnEntry = pxTCB->uxPriority;
 
-                /* Reset the next expected unblock time in case it referred to
-                 * the task that has just been deleted. */
-                prvResetNextTaskUnblockTime();
-            }
-        }
-        taskEXIT_CRITICAL();
+        pxTCB->uxPriority = uxNewPriority;
 
-        /* If the task is not deleting itself, call prvDeleteTCB from outside of
-         * critical section. If a task deletes itself, prvDeleteTCB is called
-         * from prvCheckTasksWaitingTermination which is called from Idle task. */
-        if( pxTCB != pxCurrentTCB )
+        /* Only reset the event list item value if the value is not being used
+         * for anything else. */
+        if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
         {
-            prvDeleteTCB( pxTCB );
+            listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        /* Force a reschedule if it is the currently running task that has just
-         * been deleted. */
-        if( xSchedulerRunning != pdFALSE )
+        /* A task that is in a ready list has to be moved to the ready list of
+         * its new priority. */
+        if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
         {
-            if( pxTCB == pxCurrentTCB )
+            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
             {
-                configASSERT( uxSchedulerSuspended == 0 );
-                portYIELD_WITHIN_API();
+                taskCLEAR_READY_PRIORITY( uxPriorityUsedOnEntry );
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
+
+            prvAddTaskToReadyList( pxTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
     }
-
-#endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskDelayUntil == 1 )
-
-    BaseType_t xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
-                                const TickType_t xTimeIncrement )
+    static void prvBudgetRestorePriority( TCB_t * const pxTCB )
     {
-        TickType_t xTimeToWake;
-        BaseType_t xAlreadyYielded, xShouldDelay = pdFALSE;
+        UBaseType_t uxNewPriority;
 
-        configASSERT( pxPreviousWakeTime );
-        configASSERT( ( xTimeIncrement > 0U ) );
-        configASSERT( uxSchedulerSuspended == 0 );
+        --uxBudgetDemotedTasks;
 
-        vTaskSuspendAll();
+        /* If the priority of the task was changed while it was demoted, by
+         * vTaskPrioritySet() or by priority inheritance, the new priority is
+         * left in place. */
+        if( pxTCB->uxPriority == tskIDLE_PRIORITY )
         {
-            /* Minor optimisation.  The tick count cannot change in this
-             * block. */
-            const TickType_t xConstTickCount = xTickCount;
-
-            /* Generate the tick time at which the task wants to wake. */
-            xTimeToWake = *pxPreviousWakeTime + xTimeIncrement;
-
-            if( xConstTickCount < *pxPreviousWakeTime )
+            #if ( configUSE_MUTEXES == 1 )
             {
-                /* The tick count has overflowed since this function was
-                 * lasted called.  In this case the only time we should ever
-                 * actually delay is if the wake time has also  overflowed,
-                 * and the wake time is greater than the tick time.  When this
-                 * is the case it is as if neither time had overflowed. */
-                if( ( xTimeToWake < *pxPreviousWakeTime ) && ( xTimeToWake > xConstTickCount ) )
+                /* Return to the base priority, which vTaskPrioritySet() may
+                 * have changed while the task was demoted, unless the task
+                 * was using a higher inherited priority that it may still
+                 * need. */
+                uxNewPriority = pxTCB->uxBasePriority;
+
+                if( ( pxTCB->uxMutexesHeld > ( UBaseType_t ) 0U ) && ( pxTCB->uxBudgetPriority > uxNewPriority ) )
                 {
-                    xShouldDelay = pdTRUE;
+                    uxNewPriority = pxTCB->uxBudgetPriority;
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
+            #else
+            {
+                uxNewPriority = pxTCB->uxBudgetPriority;
+            }
+            #endif /* configUSE_MUTEXES */
+
+            if( uxNewPriority != tskIDLE_PRIORITY )
+            {
+                prvBudgetSetPriority( pxTCB, uxNewPriority );
+            }
             else
             {
-                /* The tick time has not overflowed.  In this case we will
-                 * delay if either the wake time has overflowed, and/or the
-                 * tick time is less than the wake time. */
-                if( ( xTimeToWake < *pxPreviousWakeTime ) || ( xTimeToWake > xConstTickCount ) )
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvBudgetEnforce( void )
+    {
+        TCB_t * pxTCB;
+        const ListItem_t * pxIterator;
+        const ListItem_t * const pxEndMarker = listGET_END_MARKER( &xBudgetedTaskList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+        const TickType_t xConstTickCount = xTickCount;
+        TickType_t xTicksToReplenish, xTicksToNextReplenish;
+        BaseType_t xSwitchRequired = pdFALSE;
+
+        /* Restore the demoted tasks whose period has ended.  This list is only
+         * walked when at least one of them is due. */
+        if( ( uxBudgetDemotedTasks > ( UBaseType_t ) 0U ) &&
+            ( ( TickType_t ) ( xConstTickCount - xNextBudgetReplenishTime ) <= ( portMAX_DELAY >> 1 ) ) )
+        {
+            xTicksToNextReplenish = portMAX_DELAY;
+
+            for( pxIterator = listGET_HEAD_ENTRY( &xBudgetedTaskList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+            {
+                pxTCB = listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                if( pxTCB->ucBudgetState == taskBUDGET_DEMOTED )
                 {
-                    xShouldDelay = pdTRUE;
+                    if( taskBUDGET_PERIOD_ENDED( pxTCB, xConstTickCount ) != pdFALSE )
+                    {
+                        prvBudgetRestorePriority( pxTCB );
+                        prvBudgetReplenish( pxTCB, xConstTickCount );
+
+                        #if ( configUSE_PREEMPTION == 1 )
+                        {
+                            if( ( pxTCB != pxCurrentTCB ) &&
+                                ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) &&
+                                ( taskPREEMPTS_CURRENT_TASK( pxTCB ) ) )
+                            {
+                                xSwitchRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif /* configUSE_PREEMPTION */
+                    }
+                    else
+                    {
+                        xTicksToReplenish = pxTCB->xBudgetReplenishTime - xConstTickCount;
+
+                        if( xTicksToReplenish < xTicksToNextReplenish )
+                        {
+                            xTicksToNextReplenish = xTicksToReplenish;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
                 }
                 else
                 {
@@ -1261,429 +2107,290 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 }
             }
 
-            /* Update the wake time ready for the next call. */
-            *pxPreviousWakeTime = xTimeToWake;
+            xNextBudgetReplenishTime = xConstTickCount + xTicksToNextReplenish;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-            if( xShouldDelay != pdFALSE )
+        prvBudgetCharge( xConstTickCount );
+
+        /* Nothing needs to be done if the running task is leaving the Ready
+         * state anyway.  If it becomes ready again before its budget is
+         * replenished it is caught the next time it is charged. */
+        pxTCB = pxCurrentTCB;
+
+        if( ( pxTCB->ucBudgetState == taskBUDGET_EXHAUSTED ) &&
+            ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+        {
+            if( pxTCB->ucBudgetAction == ( uint8_t ) eBudgetDemote )
             {
-                traceTASK_DELAY_UNTIL( xTimeToWake );
+                pxTCB->uxBudgetPriority = pxTCB->uxPriority;
+                pxTCB->ucBudgetState = taskBUDGET_DEMOTED;
 
-                /* prvAddCurrentTaskToDelayedList() needs the block time, not
-                 * the time to wake, so subtract the current tick count. */
-                prvAddCurrentTaskToDelayedList( xTimeToWake - xConstTickCount, pdFALSE );
+                if( pxTCB->uxPriority != tskIDLE_PRIORITY )
+                {
+                    prvBudgetSetPriority( pxTCB, tskIDLE_PRIORITY );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( ( uxBudgetDemotedTasks == ( UBaseType_t ) 0U ) ||
+                    ( ( TickType_t ) ( pxTCB->xBudgetReplenishTime - xConstTickCount ) < ( TickType_t ) ( xNextBudgetReplenishTime - xConstTickCount ) ) )
+                {
+                    xNextBudgetReplenishTime = pxTCB->xBudgetReplenishTime;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                uxBudgetDemotedTasks++;
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                /* The budget was replenished when the task was charged if the
+                 * period had ended, so the replenish time is in the future. */
+                prvAddCurrentTaskToDelayedList( pxTCB->xBudgetReplenishTime - xConstTickCount, pdFALSE );
             }
-        }
-        xAlreadyYielded = xTaskResumeAll();
 
-        /* Force a reschedule if xTaskResumeAll has not already done so, we may
-         * have put ourselves to sleep. */
-        if( xAlreadyYielded == pdFALSE )
-        {
-            portYIELD_WITHIN_API();
+            xSwitchRequired = pdTRUE;
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        return xShouldDelay;
+        return xSwitchRequired;
     }
 
-#endif /* INCLUDE_xTaskDelayUntil */
+#endif /* configUSE_TASK_BUDGETS */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskDelay == 1 )
+#if ( configUSE_PREEMPTION_THRESHOLD == 1 )
 
-    void vTaskDelay( const TickType_t xTicksToDelay )
+    static void prvSelectTaskWithThreshold( void )
     {
-        BaseType_t xAlreadyYielded = pdFALSE;
+        TCB_t * const pxOutgoingTCB = pxCurrentTCB;
+        BaseType_t xKeepsThreshold = ( BaseType_t ) taskHOLDS_PREEMPTION_THRESHOLD( pxOutgoingTCB );
+        UBaseType_t uxTopPriority;
 
-        /* A delay time of zero just forces a reschedule. */
-        if( xTicksToDelay > ( TickType_t ) 0U )
+        #if ( configUSE_TASK_BUDGETS == 1 )
         {
-            configASSERT( uxSchedulerSuspended == 0 );
-            vTaskSuspendAll();
+            /* A task demoted for using up its budget gives its threshold up. */
+            if( pxOutgoingTCB->ucBudgetState == taskBUDGET_DEMOTED )
             {
-                traceTASK_DELAY();
-
-                /* A task that is removed from the event list while the
-                 * scheduler is suspended will not get placed in the ready
-                 * list or removed from the blocked list until the scheduler
-                 * is resumed.
-                 *
-                 * This task cannot be in an event list as it is the currently
-                 * executing task. */
-                prvAddCurrentTaskToDelayedList( xTicksToDelay, pdFALSE );
+                xKeepsThreshold = pdFALSE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
-            xAlreadyYielded = xTaskResumeAll();
+        }
+        #endif
+
+        /* A task that is switched out while it is still ready was preempted,
+         * or yielded, part way through its work, so it keeps its threshold. */
+        if( ( xKeepsThreshold != pdFALSE ) &&
+            ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxOutgoingTCB->uxPriority ] ), &( pxOutgoingTCB->xStateListItem ) ) != pdFALSE ) )
+        {
+            pxOutgoingTCB->pxNextPreemptedTask = pxPreemptedTasks;
+            pxPreemptedTasks = pxOutgoingTCB;
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        /* Force a reschedule if xTaskResumeAll has not already done so, we may
-         * have put ourselves to sleep. */
-        if( xAlreadyYielded == pdFALSE )
+        taskGET_HIGHEST_READY_PRIORITY( uxTopPriority );
+
+        if( ( pxPreemptedTasks != NULL ) && ( uxTopPriority <= taskPREEMPTION_THRESHOLD( pxPreemptedTasks ) ) )
         {
-            portYIELD_WITHIN_API();
+            /* No ready task has a priority above the threshold of the most
+             * recently preempted task, so it resumes.  The tasks below it in
+             * pxPreemptedTasks have lower thresholds. */
+            pxCurrentTCB = pxPreemptedTasks;
+            pxPreemptedTasks = pxCurrentTCB->pxNextPreemptedTask;
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            /* The selected task can only be in pxPreemptedTasks if its
+             * priority was raised while it was preempted. */
+            if( pxPreemptedTasks != NULL )
+            {
+                prvRemovePreemptedTask( pxCurrentTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
     }
-
-#endif /* INCLUDE_vTaskDelay */
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) )
+    static void prvRemovePreemptedTask( const TCB_t * const pxTCB )
+    {
+        TCB_t ** ppxLink;
 
-    eTaskState eTaskGetState( TaskHandle_t xTask )
+        for( ppxLink = &pxPreemptedTasks; *ppxLink != NULL; ppxLink = &( ( *ppxLink )->pxNextPreemptedTask ) )
+        {
+            if( *ppxLink == pxTCB )
+            {
+                *ppxLink = pxTCB->pxNextPreemptedTask;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskPreemptionThresholdSet( TaskHandle_t xTask,
+                                      UBaseType_t uxNewThreshold )
     {
-        eTaskState eReturn;
-        List_t const * pxStateList;
-        List_t const * pxDelayedList;
-        List_t const * pxOverflowedDelayedList;
-        const TCB_t * const pxTCB = xTask;
+        TCB_t * pxTCB;
+        UBaseType_t uxTopPriority;
 
-        configASSERT( pxTCB );
+        configASSERT( uxNewThreshold < configMAX_PRIORITIES );
 
-        if( pxTCB == pxCurrentTCB )
+        /* Ensure the new threshold is valid. */
+        if( uxNewThreshold >= ( UBaseType_t ) configMAX_PRIORITIES )
         {
-            /* The task calling this function is querying its own state. */
-            eReturn = eRunning;
+            uxNewThreshold = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
         }
         else
         {
-            taskENTER_CRITICAL();
-            {
-                pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
-                pxDelayedList = pxDelayedTaskList;
-                pxOverflowedDelayedList = pxOverflowDelayedTaskList;
-            }
-            taskEXIT_CRITICAL();
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the threshold of the calling
+             * task that is being changed. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+            pxTCB->uxPreemptionThreshold = uxNewThreshold;
 
-            if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+            /* Lowering the threshold of the running task can allow a ready
+             * task to preempt it.  The threshold of a task that is not running
+             * is only used once it runs. */
+            if( ( pxTCB == pxCurrentTCB ) && ( xSchedulerRunning != pdFALSE ) )
             {
-                /* The task being queried is referenced from one of the Blocked
-                 * lists. */
-                eReturn = eBlocked;
-            }
+                taskGET_HIGHEST_READY_PRIORITY( uxTopPriority );
 
-            #if ( INCLUDE_vTaskSuspend == 1 )
-                else if( pxStateList == &xSuspendedTaskList )
+                if( uxTopPriority > taskPREEMPTION_THRESHOLD( pxTCB ) )
                 {
-                    /* The task being queried is referenced from the suspended
-                     * list.  Is it genuinely suspended or is it blocked
-                     * indefinitely? */
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL )
-                    {
-                        #if ( configUSE_TASK_NOTIFICATIONS == 1 )
-                        {
-                            BaseType_t x;
-
-                            /* The task does not appear on the event list item of
-                             * and of the RTOS objects, but could still be in the
-                             * blocked state if it is waiting on its notification
-                             * rather than waiting on an object.  If not, is
-                             * suspended. */
-                            eReturn = eSuspended;
-
-                            for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
-                            {
-                                if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
-                                {
-                                    eReturn = eBlocked;
-                                    break;
-                                }
-                            }
-                        }
-                        #else /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
-                        {
-                            eReturn = eSuspended;
-                        }
-                        #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
-                    }
-                    else
-                    {
-                        eReturn = eBlocked;
-                    }
+                    taskYIELD_IF_USING_PREEMPTION();
                 }
-            #endif /* if ( INCLUDE_vTaskSuspend == 1 ) */
-
-            #if ( INCLUDE_vTaskDelete == 1 )
-                else if( ( pxStateList == &xTasksWaitingTermination ) || ( pxStateList == NULL ) )
+                else
                 {
-                    /* The task being queried is referenced from the deleted
-                     * tasks list, or it is not referenced from any lists at
-                     * all. */
-                    eReturn = eDeleted;
+                    mtCOVERAGE_TEST_MARKER();
                 }
-            #endif
-
-            else /*lint !e525 Negative indentation is intended to make use of pre-processor clearer. */
+            }
+            else
             {
-                /* If the task is not in any other state, it must be in the
-                 * Ready (including pending ready) state. */
-                eReturn = eReady;
+                mtCOVERAGE_TEST_MARKER();
             }
         }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
 
-        return eReturn;
-    } /*lint !e818 xTask cannot be a pointer to const because it is a typedef. */
-
-#endif /* INCLUDE_eTaskGetState */
-/*-----------------------------------------------------------*/
-
-#if ( INCLUDE_uxTaskPriorityGet == 1 )
-
-    UBaseType_t uxTaskPriorityGet( const TaskHandle_t xTask )
+    UBaseType_t uxTaskPreemptionThresholdGet( const TaskHandle_t xTask )
     {
         TCB_t const * pxTCB;
         UBaseType_t uxReturn;
 
         taskENTER_CRITICAL();
         {
-            /* If null is passed in here then it is the priority of the task
-             * that called uxTaskPriorityGet() that is being queried. */
+            /* If null is passed in here then it is the threshold of the task
+             * that called uxTaskPreemptionThresholdGet() that is being
+             * queried. */
             pxTCB = prvGetTCBFromHandle( xTask );
-            uxReturn = pxTCB->uxPriority;
+            uxReturn = pxTCB->uxPreemptionThreshold;
         }
         taskEXIT_CRITICAL();
 
         return uxReturn;
     }
 
-#endif /* INCLUDE_uxTaskPriorityGet */
+#endif /* configUSE_PREEMPTION_THRESHOLD */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_uxTaskPriorityGet == 1 )
+#if ( configUSE_SHARED_STACKS == 1 )
 
-    UBaseType_t uxTaskPriorityGetFromISR( const TaskHandle_t xTask )
+    static portTASK_FUNCTION( prvSharedStackTask, pvParameters )
     {
-        TCB_t const * pxTCB;
-        UBaseType_t uxReturn, uxSavedInterruptState;
-
-        /* RTOS ports that support interrupt nesting have the concept of a
-         * maximum  system call (or maximum API call) interrupt priority.
-         * Interrupts that are  above the maximum system call priority are keep
-         * permanently enabled, even when the RTOS kernel is in a critical section,
-         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
-         * is defined in FreeRTOSConfig.h then
-         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-         * failure if a FreeRTOS API function is called from an interrupt that has
-         * been assigned a priority above the configured maximum system call
-         * priority.  Only FreeRTOS functions that end in FromISR can be called
-         * from interrupts  that have been assigned a priority at or (logically)
-         * below the maximum system call interrupt priority.  FreeRTOS maintains a
-         * separate interrupt safe API to ensure interrupt entry is as fast and as
-         * simple as possible.  More information (albeit Cortex-M specific) is
-         * provided on the following link:
-         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+        TCB_t * const pxTCB = pxCurrentTCB;
 
-        uxSavedInterruptState = portSET_INTERRUPT_MASK_FROM_ISR();
+        for( ; ; )
         {
-            /* If null is passed in here then it is the priority of the calling
-             * task that is being queried. */
-            pxTCB = prvGetTCBFromHandle( xTask );
-            uxReturn = pxTCB->uxPriority;
-        }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptState );
+            if( pxTCB->xJobPeriod == ( TickType_t ) 0 )
+            {
+                /* Wait to be released by a notification.  If the task blocks
+                 * here its context is not kept, so when it is released it
+                 * starts again from the top of this function and takes the
+                 * notification then. */
+                ( void ) ulTaskGenericNotifyTake( tskDEFAULT_INDEX_TO_NOTIFY, pdFALSE, portMAX_DELAY );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-        return uxReturn;
-    }
+            pxTCB->ucJobState = taskJOB_RUNNING;
+            pxTCB->pxJobCode( pvParameters );
+            pxTCB->ucJobState = taskJOB_IDLE;
 
-#endif /* INCLUDE_uxTaskPriorityGet */
+            if( pxTCB->xJobPeriod != ( TickType_t ) 0 )
+            {
+                /* Nothing needs to be done after the delay, so the task
+                 * can start again from the top of this function. */
+                ( void ) xTaskDelayUntil( &( pxTCB->xJobReleaseTime ), pxTCB->xJobPeriod );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskPrioritySet == 1 )
-
-    void vTaskPrioritySet( TaskHandle_t xTask,
-                           UBaseType_t uxNewPriority )
+    static void prvSharedStackPrepareTask( TCB_t * const pxTCB )
     {
-        TCB_t * pxTCB;
-        UBaseType_t uxCurrentBasePriority, uxPriorityUsedOnEntry;
-        BaseType_t xYieldRequired = pdFALSE;
-
-        configASSERT( uxNewPriority < configMAX_PRIORITIES );
-
-        /* Ensure the new priority is valid. */
-        if( uxNewPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
+        if( pxTCB->ucJobState == taskJOB_WAITING )
         {
-            uxNewPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+            pxTCB->pxTopOfStack = pxPortInitialiseStack( pxTCB->pxJobStackTop, prvSharedStackTask, pxTCB->pvJobParameters );
+            pxTCB->ucJobState = taskJOB_IDLE;
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
-
-        taskENTER_CRITICAL();
-        {
-            /* If null is passed in here then it is the priority of the calling
-             * task that is being changed. */
-            pxTCB = prvGetTCBFromHandle( xTask );
-
-            traceTASK_PRIORITY_SET( pxTCB, uxNewPriority );
-
-            #if ( configUSE_MUTEXES == 1 )
-            {
-                uxCurrentBasePriority = pxTCB->uxBasePriority;
-            }
-            #else
-            {
-                uxCurrentBasePriority = pxTCB->uxPriority;
-            }
-            #endif
-
-            if( uxCurrentBasePriority != uxNewPriority )
-            {
-                /* The priority change may have readied a task of higher
-                 * priority than the calling task. */
-                if( uxNewPriority > uxCurrentBasePriority )
-                {
-                    if( pxTCB != pxCurrentTCB )
-                    {
-                        /* The priority of a task other than the currently
-                         * running task is being raised.  Is the priority being
-                         * raised above that of the running task? */
-                        if( uxNewPriority >= pxCurrentTCB->uxPriority )
-                        {
-                            xYieldRequired = pdTRUE;
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                    }
-                    else
-                    {
-                        /* The priority of the running task is being raised,
-                         * but the running task must already be the highest
-                         * priority task able to run so no yield is required. */
-                    }
-                }
-                else if( pxTCB == pxCurrentTCB )
-                {
-                    /* Setting the priority of the running task down means
-                     * there may now be another task of higher priority that
-                     * is ready to execute. */
-                    xYieldRequired = pdTRUE;
-                }
-                else
-                {
-                    /* Setting the priority of any other task down does not
-                     * require a yield as the running task must be above the
-                     * new priority of the task being modified. */
-                }
-
-                /* Remember the ready list the task might be referenced from
-                 * before its uxPriority member is changed so the
-                 * taskRESET_READY_PRIORITY() macro can function correctly. */
-                uxPriorityUsedOnEntry = pxTCB->uxPriority;
-
-                #if ( configUSE_MUTEXES == 1 )
-                {
-                    /* Only change the priority being used if the task is not
-                     * currently using an inherited priority. */
-                    if( pxTCB->uxBasePriority == pxTCB->uxPriority )
-                    {
-                        pxTCB->uxPriority = uxNewPriority;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* The base priority gets set whatever. */
-                    pxTCB->uxBasePriority = uxNewPriority;
-                }
-                #else /* if ( configUSE_MUTEXES == 1 ) */
-                {
-                    pxTCB->uxPriority = uxNewPriority;
-                }
-                #endif /* if ( configUSE_MUTEXES == 1 ) */
-
-                /* Only reset the event list item value if the value is not
-                 * being used for anything else. */
-                if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
-                {
-                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-
-                /* If the task is in the blocked or suspended list we need do
-                 * nothing more than change its priority variable. However, if
-                 * the task is in a ready list it needs to be removed and placed
-                 * in the list appropriate to its new priority. */
-                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
-                {
-                    /* The task is currently in its ready list - remove before
-                     * adding it to its new ready list.  As we are in a critical
-                     * section we can do this even if the scheduler is suspended. */
-                    if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-                    {
-                        /* It is known that the task is in its ready list so
-                         * there is no need to check again and the port level
-                         * reset macro can be called directly. */
-                        portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    prvAddTaskToReadyList( pxTCB );
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-
-                if( xYieldRequired != pdFALSE )
-                {
-                    taskYIELD_IF_USING_PREEMPTION();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-
-                /* Remove compiler warning about unused variables when the port
-                 * optimised task selection is not being used. */
-                ( void ) uxPriorityUsedOnEntry;
-            }
-        }
-        taskEXIT_CRITICAL();
     }
 
-#endif /* INCLUDE_vTaskPrioritySet */
+#endif /* configUSE_SHARED_STACKS */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskSuspend == 1 )
+#if ( INCLUDE_vTaskDelete == 1 )
 
-    void vTaskSuspend( TaskHandle_t xTaskToSuspend )
+    void vTaskDelete( TaskHandle_t xTaskToDelete )
     {
         TCB_t * pxTCB;
 
         taskENTER_CRITICAL();
         {
-            /* If null is passed in here then it is the running task that is
-             * being suspended. */
-            pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
-
-            traceTASK_SUSPEND( pxTCB );
+            /* If null is passed in here then it is the calling task that is
+             * being deleted. */
+            pxTCB = prvGetTCBFromHandle( xTaskToDelete );
 
-            /* Remove task from the ready/delayed list and place in the
-             * suspended list. */
+            /* Remove task from the ready/delayed list. */
             if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
             {
                 taskRESET_READY_PRIORITY( pxTCB->uxPriority );
@@ -1693,6 +2400,12 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 mtCOVERAGE_TEST_MARKER();
             }
 
+            #if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+            {
+                prvRemovePreemptedTask( pxTCB );
+            }
+            #endif
+
             /* Is the task waiting on an event also? */
             if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
             {
@@ -1703,101 +2416,134 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 mtCOVERAGE_TEST_MARKER();
             }
 
-            vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
-
-            #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+            #if ( configUSE_TASK_BUDGETS == 1 )
             {
-                BaseType_t x;
-
-                for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+                /* Does the task have an execution time budget? */
+                if( listLIST_ITEM_CONTAINER( &( pxTCB->xBudgetListItem ) ) != NULL )
                 {
-                    if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+                    ( void ) uxListRemove( &( pxTCB->xBudgetListItem ) );
+
+                    if( pxTCB->ucBudgetState == taskBUDGET_DEMOTED )
                     {
-                        /* The task was blocked to wait for a notification, but is
-                         * now suspended, so no notification was received. */
-                        pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+                        --uxBudgetDemotedTasks;
                     }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* Stop the task being charged or demoted again. */
+                    pxTCB->ulBudget = 0UL;
+                    pxTCB->ucBudgetState = taskBUDGET_AVAILABLE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
                 }
             }
-            #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
-        }
-        taskEXIT_CRITICAL();
+            #endif /* configUSE_TASK_BUDGETS */
 
-        if( xSchedulerRunning != pdFALSE )
-        {
-            /* Reset the next expected unblock time in case it referred to the
-             * task that is now in the Suspended state. */
-            taskENTER_CRITICAL();
+            /* Increment the uxTaskNumber also so kernel aware debuggers can
+             * detect that the task lists need re-generating.  This is done before
+             * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
+             * not return. */
+            uxTaskNumber++;
+
+            if( pxTCB == pxCurrentTCB )
             {
+                /* A task is deleting itself.  This cannot complete within the
+                 * task itself, as a context switch to another task is required.
+                 * Place the task in the termination list.  The idle task will
+                 * check the termination list and free up any memory allocated by
+                 * the scheduler for the TCB and stack of the deleted task. */
+                vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
+
+                /* Increment the ucTasksDeleted variable so the idle task knows
+                 * there is a task that has been deleted and that it should therefore
+                 * check the xTasksWaitingTermination list. */
+                ++uxDeletedTasksWaitingCleanUp;
+
+                /* Call the delete hook before portPRE_TASK_DELETE_HOOK() as
+                 * portPRE_TASK_DELETE_HOOK() does not return in the Win32 port. */
+                traceTASK_DELETE( pxTCB );
+
+                /* The pre-delete hook is primarily for the Windows simulator,
+                 * in which Windows specific clean up operations are performed,
+                 * after which it is not possible to yield away from this task -
+                 * hence xYieldPending is used to latch that a context switch is
+                 * required. */
+                portPRE_TASK_DELETE_HOOK( pxTCB, &xYieldPending );
+            }
+            else
+            {
+                --uxCurrentNumberOfTasks;
+                traceTASK_DELETE( pxTCB );
+
+                /* Reset the next expected unblock time in case it referred to
+                 * the task that has just been deleted. */
                 prvResetNextTaskUnblockTime();
             }
-            taskEXIT_CRITICAL();
         }
-        else
+        taskEXIT_CRITICAL();
+
+        /* If the task is not deleting itself, call prvDeleteTCB from outside of
+         * critical section. If a task deletes itself, prvDeleteTCB is called
+         * from prvCheckTasksWaitingTermination which is called from Idle task. */
+        if( pxTCB != pxCurrentTCB )
         {
-            mtCOVERAGE_TEST_MARKER();
+            prvDeleteTCB( pxTCB );
         }
 
-        if( pxTCB == pxCurrentTCB )
+        /* Force a reschedule if it is the currently running task that has just
+         * been deleted. */
+        if( xSchedulerRunning != pdFALSE )
         {
-            if( xSchedulerRunning != pdFALSE )
+            if( pxTCB == pxCurrentTCB )
             {
-                /* The current task has just been suspended. */
                 configASSERT( uxSchedulerSuspended == 0 );
                 portYIELD_WITHIN_API();
             }
             else
             {
-                /* The scheduler is not running, but the task that was pointed
-                 * to by pxCurrentTCB has just been suspended and pxCurrentTCB
-                 * must be adjusted to point to a different task. */
-                if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks ) /*lint !e931 Right has no side effect, just volatile. */
-                {
-                    /* No other tasks are ready, so set pxCurrentTCB back to
-                     * NULL so when the next task is created pxCurrentTCB will
-                     * be set to point to it no matter what its relative priority
-                     * is. */
-                    pxCurrentTCB = NULL;
-                }
-                else
-                {
-                    vTaskSwitchContext();
-                }
+                mtCOVERAGE_TEST_MARKER();
             }
         }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
     }
 
-#endif /* INCLUDE_vTaskSuspend */
+#endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskSuspend == 1 )
+#if ( INCLUDE_xTaskDelayUntil == 1 )
 
-    static BaseType_t prvTaskIsTaskSuspended( const TaskHandle_t xTask )
+    BaseType_t xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
+                                const TickType_t xTimeIncrement )
     {
-        BaseType_t xReturn = pdFALSE;
-        const TCB_t * const pxTCB = xTask;
-
-        /* Accesses xPendingReadyList so must be called from a critical
-         * section. */
+        TickType_t xTimeToWake;
+        BaseType_t xAlreadyYielded, xShouldDelay = pdFALSE;
 
-        /* It does not make sense to check if the calling task is suspended. */
-        configASSERT( xTask );
+        configASSERT( pxPreviousWakeTime );
+        configASSERT( ( xTimeIncrement > 0U ) );
+        configASSERT( uxSchedulerSuspended == 0 );
 
-        /* Is the task being resumed actually in the suspended list? */
-        if( listIS_CONTAINED_WITHIN( &xSuspendedTaskList, &( pxTCB->xStateListItem ) ) != pdFALSE )
+        vTaskSuspendAll();
         {
-            /* Has the task already been resumed from within an ISR? */
-            if( listIS_CONTAINED_WITHIN( &xPendingReadyList, &( pxTCB->xEventListItem ) ) == pdFALSE )
+            /* Minor optimisation.  The tick count cannot change in this
+             * block. */
+            const TickType_t xConstTickCount = taskSYNCED_TICK_COUNT();
+
+            /* Generate the tick time at which the task wants to wake. */
+            xTimeToWake = *pxPreviousWakeTime + xTimeIncrement;
+
+            if( xConstTickCount < *pxPreviousWakeTime )
             {
-                /* Is it in the suspended list because it is in the Suspended
-                 * state, or because is is blocked with no timeout? */
-                if( listIS_CONTAINED_WITHIN( NULL, &( pxTCB->xEventListItem ) ) != pdFALSE ) /*lint !e961.  The cast is only redundant when NULL is used. */
+                /* The tick count has overflowed since this function was
+                 * lasted called.  In this case the only time we should ever
+                 * actually delay is if the wake time has also  overflowed,
+                 * and the wake time is greater than the tick time.  When this
+                 * is the case it is as if neither time had overflowed. */
+                if( ( xTimeToWake < *pxPreviousWakeTime ) && ( xTimeToWake > xConstTickCount ) )
                 {
-                    xReturn = pdTRUE;
+                    xShouldDelay = pdTRUE;
                 }
                 else
                 {
@@ -1806,51 +2552,48 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                /* The tick time has not overflowed.  In this case we will
+                 * delay if either the wake time has overflowed, and/or the
+                 * tick time is less than the wake time. */
+                if( ( xTimeToWake < *pxPreviousWakeTime ) || ( xTimeToWake > xConstTickCount ) )
+                {
+                    xShouldDelay = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-
-        return xReturn;
-    } /*lint !e818 xTask cannot be a pointer to const because it is a typedef. */
-
-#endif /* INCLUDE_vTaskSuspend */
-/*-----------------------------------------------------------*/
-
-#if ( INCLUDE_vTaskSuspend == 1 )
-
-    void vTaskResume( TaskHandle_t xTaskToResume )
-    {
-        TCB_t * const pxTCB = xTaskToResume;
 
-        /* It does not make sense to resume the calling task. */
-        configASSERT( xTaskToResume );
+            /* Update the wake time ready for the next call. */
+            *pxPreviousWakeTime = xTimeToWake;
 
-        /* The parameter cannot be NULL as it is impossible to resume the
-         * currently executing task. */
-        if( ( pxTCB != pxCurrentTCB ) && ( pxTCB != NULL ) )
-        {
-            taskENTER_CRITICAL();
+            #if ( configUSE_EDF_SCHEDULING == 1 )
             {
-                if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
+                if( pxCurrentTCB->xRelativeDeadline != ( TickType_t ) 0 )
                 {
-                    traceTASK_RESUME( pxTCB );
+                    /* The current release has completed.  Count it as late if
+                     * its deadline has been reached, then set the deadline of
+                     * the next release, which occurs at xTimeToWake. */
+                    if( ( TickType_t ) ( xConstTickCount - pxCurrentTCB->xAbsoluteDeadline ) <= ( portMAX_DELAY >> 1 ) )
+                    {
+                        ( pxCurrentTCB->uxDeadlineMisses )++;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-                    /* The ready list can be accessed even if the scheduler is
-                     * suspended because this is inside a critical section. */
-                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
+                    pxCurrentTCB->xAbsoluteDeadline = xTimeToWake + pxCurrentTCB->xRelativeDeadline;
 
-                    /* A higher priority task may have just been resumed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    /* If the next release is already due the task stays in its
+                     * ready list, so move it to the position of its new
+                     * deadline.  The yield below then selects the task with
+                     * the earliest deadline. */
+                    if( ( xShouldDelay == pdFALSE ) && taskIS_EDF_PRIORITY( pxCurrentTCB->uxPriority ) )
                     {
-                        /* This yield may not cause the task just resumed to run,
-                         * but will leave the lists in the correct state for the
-                         * next yield. */
-                        taskYIELD_IF_USING_PREEMPTION();
+                        ( void ) uxListRemove( &( pxCurrentTCB->xStateListItem ) );
+                        prvInsertTaskByDeadline( pxCurrentTCB );
                     }
                     else
                     {
@@ -1862,2159 +2605,3920 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
-            taskEXIT_CRITICAL();
+            #endif /* configUSE_EDF_SCHEDULING */
+
+            if( xShouldDelay != pdFALSE )
+            {
+                traceTASK_DELAY_UNTIL( xTimeToWake );
+
+                /* prvAddCurrentTaskToDelayedList() needs the block time, not
+                 * the time to wake, so subtract the current tick count. */
+                prvAddCurrentTaskToDelayedList( xTimeToWake - xConstTickCount, pdFALSE );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        xAlreadyYielded = xTaskResumeAll();
+
+        /* Force a reschedule if xTaskResumeAll has not already done so, we may
+         * have put ourselves to sleep. */
+        if( xAlreadyYielded == pdFALSE )
+        {
+            portYIELD_WITHIN_API();
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
-    }
 
-#endif /* INCLUDE_vTaskSuspend */
+        return xShouldDelay;
+    }
 
+#endif /* INCLUDE_xTaskDelayUntil */
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) )
+#if ( INCLUDE_vTaskDelay == 1 )
 
-    BaseType_t xTaskResumeFromISR( TaskHandle_t xTaskToResume )
+    void vTaskDelay( const TickType_t xTicksToDelay )
     {
-        BaseType_t xYieldRequired = pdFALSE;
-        TCB_t * const pxTCB = xTaskToResume;
-        UBaseType_t uxSavedInterruptStatus;
-
-        configASSERT( xTaskToResume );
-
-        /* RTOS ports that support interrupt nesting have the concept of a
-         * maximum  system call (or maximum API call) interrupt priority.
-         * Interrupts that are  above the maximum system call priority are keep
-         * permanently enabled, even when the RTOS kernel is in a critical section,
-         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
-         * is defined in FreeRTOSConfig.h then
-         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-         * failure if a FreeRTOS API function is called from an interrupt that has
-         * been assigned a priority above the configured maximum system call
-         * priority.  Only FreeRTOS functions that end in FromISR can be called
-         * from interrupts  that have been assigned a priority at or (logically)
-         * below the maximum system call interrupt priority.  FreeRTOS maintains a
-         * separate interrupt safe API to ensure interrupt entry is as fast and as
-         * simple as possible.  More information (albeit Cortex-M specific) is
-         * provided on the following link:
-         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+        BaseType_t xAlreadyYielded = pdFALSE;
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        /* A delay time of zero just forces a reschedule. */
+        if( xTicksToDelay > ( TickType_t ) 0U )
         {
-            if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
+            configASSERT( uxSchedulerSuspended == 0 );
+            vTaskSuspendAll();
             {
-                traceTASK_RESUME_FROM_ISR( pxTCB );
+                traceTASK_DELAY();
 
-                /* Check the ready lists can be accessed. */
-                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-                {
-                    /* Ready lists can be accessed so move the task from the
-                     * suspended list to the ready list directly. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
-                    {
-                        xYieldRequired = pdTRUE;
+                /* A task that is removed from the event list while the
+                 * scheduler is suspended will not get placed in the ready
+                 * list or removed from the blocked list until the scheduler
+                 * is resumed.
+                 *
+                 * This task cannot be in an event list as it is the currently
+                 * executing task. */
+                prvAddCurrentTaskToDelayedList( xTicksToDelay, pdFALSE );
+            }
+            xAlreadyYielded = xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-                        /* Mark that a yield is pending in case the user is not
-                         * using the return value to initiate a context switch
-                         * from the ISR using portYIELD_FROM_ISR. */
-                        xYieldPending = pdTRUE;
-                    }
+        /* Force a reschedule if xTaskResumeAll has not already done so, we may
+         * have put ourselves to sleep. */
+        if( xAlreadyYielded == pdFALSE )
+        {
+            portYIELD_WITHIN_API();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* INCLUDE_vTaskDelay */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) )
+
+    eTaskState eTaskGetState( TaskHandle_t xTask )
+    {
+        eTaskState eReturn;
+        List_t const * pxStateList;
+        BaseType_t xIsDelayed;
+        const TCB_t * const pxTCB = xTask;
+
+        configASSERT( pxTCB );
+
+        if( pxTCB == pxCurrentTCB )
+        {
+            /* The task calling this function is querying its own state. */
+            eReturn = eRunning;
+        }
+        else
+        {
+            taskENTER_CRITICAL();
+            {
+                pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
+
+                #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+                {
+                    xIsDelayed = ( taskLIST_IS_DELAYED_LIST( pxStateList ) ) ? pdTRUE : pdFALSE;
+                }
+                #else
+                {
+                    xIsDelayed = ( ( pxStateList == pxDelayedTaskList ) || ( pxStateList == pxOverflowDelayedTaskList ) ) ? pdTRUE : pdFALSE;
+                }
+                #endif
+            }
+            taskEXIT_CRITICAL();
+
+            if( xIsDelayed != pdFALSE )
+            {
+                /* The task being queried is referenced from one of the Blocked
+                 * lists. */
+                eReturn = eBlocked;
+            }
+
+            #if ( INCLUDE_vTaskSuspend == 1 )
+                else if( pxStateList == &xSuspendedTaskList )
+                {
+                    /* The task being queried is referenced from the suspended
+                     * list.  Is it genuinely suspended or is it blocked
+                     * indefinitely? */
+                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL )
+                    {
+                        #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+                        {
+                            BaseType_t x;
+
+                            /* The task does not appear on the event list item of
+                             * and of the RTOS objects, but could still be in the
+                             * blocked state if it is waiting on its notification
+                             * rather than waiting on an object.  If not, is
+                             * suspended. */
+                            eReturn = eSuspended;
+
+                            for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+                            {
+                                if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+                                {
+                                    eReturn = eBlocked;
+                                    break;
+                                }
+                            }
+                        }
+                        #else /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+                        {
+                            eReturn = eSuspended;
+                        }
+                        #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+                    }
                     else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        eReturn = eBlocked;
                     }
-
-                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
                 }
-                else
+            #endif /* if ( INCLUDE_vTaskSuspend == 1 ) */
+
+            #if ( INCLUDE_vTaskDelete == 1 )
+                else if( ( pxStateList == &xTasksWaitingTermination ) || ( pxStateList == NULL ) )
                 {
-                    /* The delayed or ready lists cannot be accessed so the task
-                     * is held in the pending ready list until the scheduler is
-                     * unsuspended. */
-                    vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                    /* The task being queried is referenced from the deleted
+                     * tasks list, or it is not referenced from any lists at
+                     * all. */
+                    eReturn = eDeleted;
                 }
-            }
-            else
+            #endif
+
+            else /*lint !e525 Negative indentation is intended to make use of pre-processor clearer. */
             {
-                mtCOVERAGE_TEST_MARKER();
+                /* If the task is not in any other state, it must be in the
+                 * Ready (including pending ready) state. */
+                eReturn = eReady;
             }
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-        return xYieldRequired;
-    }
+        return eReturn;
+    } /*lint !e818 xTask cannot be a pointer to const because it is a typedef. */
 
-#endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
+#endif /* INCLUDE_eTaskGetState */
 /*-----------------------------------------------------------*/
 
-void vTaskStartScheduler( void )
-{
-    BaseType_t xReturn;
+#if ( INCLUDE_uxTaskPriorityGet == 1 )
 
-    /* Add the idle task at the lowest priority. */
-    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    UBaseType_t uxTaskPriorityGet( const TaskHandle_t xTask )
     {
-        StaticTask_t * pxIdleTaskTCBBuffer = NULL;
-        StackType_t * pxIdleTaskStackBuffer = NULL;
-        uint32_t ulIdleTaskStackSize;
+        TCB_t const * pxTCB;
 
-        /* The Idle task is created using user provided RAM - obtain the
-         * address of the RAM then create the idle task. */
-        vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
-        xIdleTaskHandle = xTaskCreateStatic( prvIdleTask,
-                                             configIDLE_TASK_NAME,
-                                             ulIdleTaskStackSize,
-                                             ( void * ) NULL,       /*lint !e961.  The cast is not redundant for all compilers. */
-                                             portPRIVILEGE_BIT,     /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
-                                             pxIdleTaskStackBuffer,
-                                             pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+        /* If null is passed in here then it is the priority of the task that
+         * called uxTaskPriorityGet() that is being queried.  A critical section
+         * is not required because the priority is of type UBaseType_t. */
+        pxTCB = prvGetTCBFromHandle( xTask );
 
-        if( xIdleTaskHandle != NULL )
-        {
-            xReturn = pdPASS;
-        }
-        else
-        {
-            xReturn = pdFAIL;
-        }
+        return pxTCB->uxPriority;
     }
-    #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+
+#endif /* INCLUDE_uxTaskPriorityGet */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskPriorityGet == 1 )
+
+    UBaseType_t uxTaskPriorityGetFromISR( const TaskHandle_t xTask )
     {
-        /* The Idle task is being created using dynamically allocated RAM. */
-        xReturn = xTaskCreate( prvIdleTask,
-                               configIDLE_TASK_NAME,
-                               configMINIMAL_STACK_SIZE,
-                               ( void * ) NULL,
-                               portPRIVILEGE_BIT,  /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
-                               &xIdleTaskHandle ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+        TCB_t const * pxTCB;
+
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum  system call (or maximum API call) interrupt priority.
+         * Interrupts that are  above the maximum system call priority are keep
+         * permanently enabled, even when the RTOS kernel is in a critical section,
+         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+         * is defined in FreeRTOSConfig.h then
+         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+         * failure if a FreeRTOS API function is called from an interrupt that has
+         * been assigned a priority above the configured maximum system call
+         * priority.  Only FreeRTOS functions that end in FromISR can be called
+         * from interrupts  that have been assigned a priority at or (logically)
+         * below the maximum system call interrupt priority.  FreeRTOS maintains a
+         * separate interrupt safe API to ensure interrupt entry is as fast and as
+         * simple as possible.  More information (albeit Cortex-M specific) is
+         * provided on the following link:
+         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        /* If null is passed in here then it is the priority of the calling task
+         * that is being queried.  Interrupts do not need to be masked because
+         * the priority is of type UBaseType_t. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        return pxTCB->uxPriority;
     }
-    #endif /* configSUPPORT_STATIC_ALLOCATION */
 
-    #if ( configUSE_TIMERS == 1 )
+#endif /* INCLUDE_uxTaskPriorityGet */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    UBaseType_t uxTaskGetDeadlineMissCount( const TaskHandle_t xTask )
     {
-        if( xReturn == pdPASS )
-        {
-            xReturn = xTimerCreateTimerTask();
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+        TCB_t const * pxTCB;
+
+        /* If null is passed in here then it is the deadline miss count of the
+         * calling task that is being queried.  A critical section is not
+         * required because the count is of type UBaseType_t. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        return pxTCB->uxDeadlineMisses;
     }
-    #endif /* configUSE_TIMERS */
 
-    if( xReturn == pdPASS )
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+    void vTaskSetBudget( TaskHandle_t xTask,
+                         uint32_t ulBudget,
+                         TickType_t xPeriod,
+                         eBudgetAction eAction )
     {
-        /* freertos_tasks_c_additions_init() should only be called if the user
-         * definable macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is
-         * the only macro called by the function. */
-        #ifdef FREERTOS_TASKS_C_ADDITIONS_INIT
-        {
-            freertos_tasks_c_additions_init();
-        }
-        #endif
+        TCB_t * pxTCB;
 
-        /* Interrupts are turned off here, to ensure a tick does not occur
-         * before or during the call to xPortStartScheduler().  The stacks of
-         * the created tasks contain a status word with interrupts switched on
-         * so interrupts will automatically get re-enabled when the first task
-         * starts to run. */
-        portDISABLE_INTERRUPTS();
+        configASSERT( ( ulBudget == 0UL ) || ( xPeriod > ( TickType_t ) 0U ) );
 
-        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+        taskENTER_CRITICAL();
         {
-            /* Switch C-Runtime's TLS Block to point to the TLS
-             * block specific to the task that will run first. */
-            configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
-        }
-        #endif
-
-        xNextTaskUnblockTime = portMAX_DELAY;
-        xSchedulerRunning = pdTRUE;
-        xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
+            /* If null is passed in here then it is the budget of the calling
+             * task that is being set. */
+            pxTCB = prvGetTCBFromHandle( xTask );
 
-        /* If configGENERATE_RUN_TIME_STATS is defined then the following
-         * macro must be defined to configure the timer/counter used to generate
-         * the run time counter time base.   NOTE:  If configGENERATE_RUN_TIME_STATS
-         * is set to 0 and the following line fails to build then ensure you do not
-         * have portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() defined in your
-         * FreeRTOSConfig.h file. */
-        portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
+            /* The idle task must always be able to run. */
+            configASSERT( ( ulBudget == 0UL ) || ( pxTCB != xIdleTaskHandle ) );
 
-        traceTASK_SWITCHED_IN();
+            /* Charge the running task for the time it has run under its old
+             * budget before the budget is changed. */
+            if( xSchedulerRunning != pdFALSE )
+            {
+                prvBudgetCharge( xTickCount );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-        /* Setting up the timer tick is hardware specific and thus in the
-         * portable interface. */
-        xPortStartScheduler();
+            if( pxTCB->ucBudgetState == taskBUDGET_DEMOTED )
+            {
+                prvBudgetRestorePriority( pxTCB );
 
-        /* In most cases, xPortStartScheduler() will not return. If it
-         * returns pdTRUE then there was not enough heap memory available
-         * to create either the Idle or the Timer task. If it returned
-         * pdFALSE, then the application called xTaskEndScheduler().
-         * Most ports don't implement xTaskEndScheduler() as there is
-         * nothing to return to. */
-    }
-    else
-    {
-        /* This line will only be reached if the kernel could not be started,
-         * because there was not enough FreeRTOS heap to create the idle task
-         * or the timer task. */
-        configASSERT( xReturn != errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY );
-    }
-
-    /* Prevent compiler warnings if INCLUDE_xTaskGetIdleTaskHandle is set to 0,
-     * meaning xIdleTaskHandle is not used anywhere else. */
-    ( void ) xIdleTaskHandle;
-
-    /* OpenOCD makes use of uxTopUsedPriority for thread debugging. Prevent uxTopUsedPriority
-     * from getting optimized out as it is no longer used by the kernel. */
-    ( void ) uxTopUsedPriority;
-}
-/*-----------------------------------------------------------*/
-
-void vTaskEndScheduler( void )
-{
-    /* Stop the scheduler interrupts and call the portable scheduler end
-     * routine so the original ISRs can be restored if necessary.  The port
-     * layer must ensure interrupts enable  bit is left in the correct state. */
-    portDISABLE_INTERRUPTS();
-    xSchedulerRunning = pdFALSE;
-    vPortEndScheduler();
-}
-/*----------------------------------------------------------*/
+                #if ( configUSE_PREEMPTION == 1 )
+                {
+                    if( ( pxTCB != pxCurrentTCB ) && ( taskPREEMPTS_CURRENT_TASK( pxTCB ) ) )
+                    {
+                        taskYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_PREEMPTION */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-void vTaskSuspendAll( void )
-{
-    /* A critical section is not required as the variable is of type
-     * BaseType_t.  Please read Richard Barry's reply in the following link to a
-     * post in the FreeRTOS support forum before reporting this as a bug! -
-     * https://goo.gl/wu4acr */
+            pxTCB->ulBudget = ulBudget;
+            pxTCB->ulBudgetUsed = 0UL;
+            pxTCB->ulPeakBudgetUsed = 0UL;
+            pxTCB->xBudgetPeriod = xPeriod;
+            pxTCB->xBudgetReplenishTime = xTickCount + xPeriod;
+            pxTCB->uxBudgetOverruns = ( UBaseType_t ) 0U;
+            pxTCB->ucBudgetAction = ( uint8_t ) eAction;
+            pxTCB->ucBudgetState = taskBUDGET_AVAILABLE;
 
-    /* portSOFTWARE_BARRIER() is only implemented for emulated/simulated ports that
-     * do not otherwise exhibit real time behaviour. */
-    portSOFTWARE_BARRIER();
+            if( ulBudget != 0UL )
+            {
+                if( listLIST_ITEM_CONTAINER( &( pxTCB->xBudgetListItem ) ) == NULL )
+                {
+                    listINSERT_END( &xBudgetedTaskList, &( pxTCB->xBudgetListItem ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                if( listLIST_ITEM_CONTAINER( &( pxTCB->xBudgetListItem ) ) != NULL )
+                {
+                    ( void ) uxListRemove( &( pxTCB->xBudgetListItem ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
 
-    /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
-     * is used to allow calls to vTaskSuspendAll() to nest. */
-    ++uxSchedulerSuspended;
+            /* Budgets are checked on every tick while a task that has one is
+             * running. */
+            portUPDATE_TICK_INTERRUPT();
+        }
+        taskEXIT_CRITICAL();
+    }
 
-    /* Enforces ordering for ports and optimised compilers that may otherwise place
-     * the above increment elsewhere. */
-    portMEMORY_BARRIER();
-}
-/*----------------------------------------------------------*/
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
 
-#if ( configUSE_TICKLESS_IDLE != 0 )
+#if ( INCLUDE_vTaskPrioritySet == 1 )
 
-    static TickType_t prvGetExpectedIdleTime( void )
+    void vTaskPrioritySet( TaskHandle_t xTask,
+                           UBaseType_t uxNewPriority )
     {
-        TickType_t xReturn;
-        UBaseType_t uxHigherPriorityReadyTasks = pdFALSE;
-
-        /* uxHigherPriorityReadyTasks takes care of the case where
-         * configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
-         * task that are in the Ready state, even though the idle task is
-         * running. */
-        #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
-        {
-            if( uxTopReadyPriority > tskIDLE_PRIORITY )
-            {
-                uxHigherPriorityReadyTasks = pdTRUE;
-            }
-        }
-        #else
-        {
-            const UBaseType_t uxLeastSignificantBit = ( UBaseType_t ) 0x01;
+        TCB_t * pxTCB;
+        UBaseType_t uxCurrentBasePriority, uxPriorityUsedOnEntry;
+        BaseType_t xYieldRequired = pdFALSE;
 
-            /* When port optimised task selection is used the uxTopReadyPriority
-             * variable is used as a bit map.  If bits other than the least
-             * significant bit are set then there are tasks that have a priority
-             * above the idle priority that are in the Ready state.  This takes
-             * care of the case where the co-operative scheduler is in use. */
-            if( uxTopReadyPriority > uxLeastSignificantBit )
-            {
-                uxHigherPriorityReadyTasks = pdTRUE;
-            }
-        }
-        #endif /* if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) */
+        configASSERT( uxNewPriority < configMAX_PRIORITIES );
 
-        if( pxCurrentTCB->uxPriority > tskIDLE_PRIORITY )
-        {
-            xReturn = 0;
-        }
-        else if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > 1 )
-        {
-            /* There are other idle priority tasks in the ready state.  If
-             * time slicing is used then the very next tick interrupt must be
-             * processed. */
-            xReturn = 0;
-        }
-        else if( uxHigherPriorityReadyTasks != pdFALSE )
+        /* Ensure the new priority is valid. */
+        if( uxNewPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
         {
-            /* There are tasks in the Ready state that have a priority above the
-             * idle priority.  This path can only be reached if
-             * configUSE_PREEMPTION is 0. */
-            xReturn = 0;
+            uxNewPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
         }
         else
         {
-            xReturn = xNextTaskUnblockTime - xTickCount;
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        return xReturn;
-    }
-
-#endif /* configUSE_TICKLESS_IDLE */
-/*----------------------------------------------------------*/
-
-BaseType_t xTaskResumeAll( void )
-{
-    TCB_t * pxTCB = NULL;
-    BaseType_t xAlreadyYielded = pdFALSE;
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the priority of the calling
+             * task that is being changed. */
+            pxTCB = prvGetTCBFromHandle( xTask );
 
-    /* If uxSchedulerSuspended is zero then this function does not match a
-     * previous call to vTaskSuspendAll(). */
-    configASSERT( uxSchedulerSuspended );
+            traceTASK_PRIORITY_SET( pxTCB, uxNewPriority );
 
-    /* It is possible that an ISR caused a task to be removed from an event
-     * list while the scheduler was suspended.  If this was the case then the
-     * removed task will have been added to the xPendingReadyList.  Once the
-     * scheduler has been resumed it is safe to move all the pending ready
-     * tasks from this list into their appropriate ready list. */
-    taskENTER_CRITICAL();
-    {
-        --uxSchedulerSuspended;
+            #if ( configUSE_MUTEXES == 1 )
+            {
+                uxCurrentBasePriority = pxTCB->uxBasePriority;
+            }
+            #else
+            {
+                uxCurrentBasePriority = pxTCB->uxPriority;
+            }
+            #endif
 
-        if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-        {
-            if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
+            if( uxCurrentBasePriority != uxNewPriority )
             {
-                /* Move any readied tasks from the pending list into the
-                 * appropriate ready list. */
-                while( listLIST_IS_EMPTY( &xPendingReadyList ) == pdFALSE )
+                /* The priority change may have readied a task of higher
+                 * priority than the calling task. */
+                if( uxNewPriority > uxCurrentBasePriority )
                 {
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                    listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
-                    portMEMORY_BARRIER();
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
-
-                    /* If the moved task has a priority higher than or equal to
-                     * the current task then a yield must be performed. */
-                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    if( pxTCB != pxCurrentTCB )
                     {
-                        xYieldPending = pdTRUE;
+                        /* The priority of a task other than the currently
+                         * running task is being raised.  Is the priority being
+                         * raised above that of the running task? */
+                        if( uxNewPriority >= pxCurrentTCB->uxPriority )
+                        {
+                            xYieldRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
                     else
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        /* The priority of the running task is being raised,
+                         * but the running task must already be the highest
+                         * priority task able to run so no yield is required. */
                     }
                 }
-
-                if( pxTCB != NULL )
+                else if( pxTCB == pxCurrentTCB )
                 {
-                    /* A task was unblocked while the scheduler was suspended,
-                     * which may have prevented the next unblock time from being
-                     * re-calculated, in which case re-calculate it now.  Mainly
-                     * important for low power tickless implementations, where
-                     * this can prevent an unnecessary exit from low power
-                     * state. */
-                    prvResetNextTaskUnblockTime();
+                    /* Setting the priority of the running task down means
+                     * there may now be another task of higher priority that
+                     * is ready to execute. */
+                    xYieldRequired = pdTRUE;
                 }
-
-                /* If any ticks occurred while the scheduler was suspended then
-                 * they should be processed now.  This ensures the tick count does
-                 * not  slip, and that any delayed tasks are resumed at the correct
-                 * time. */
+                else
                 {
-                    TickType_t xPendedCounts = xPendedTicks; /* Non-volatile copy. */
+                    /* Setting the priority of any other task down does not
+                     * require a yield as the running task must be above the
+                     * new priority of the task being modified. */
+                }
 
-                    if( xPendedCounts > ( TickType_t ) 0U )
+                /* Remember the ready list the task might be referenced from
+                 * before its uxPriority member is changed so the
+                 * taskRESET_READY_PRIORITY() macro can function correctly. */
+                uxPriorityUsedOnEntry = pxTCB->uxPriority;
+
+                #if ( configUSE_MUTEXES == 1 )
+                {
+                    /* Only change the priority being used if the task is not
+                     * currently using an inherited priority. */
+                    if( pxTCB->uxBasePriority == pxTCB->uxPriority )
                     {
-                        do
-                        {
-                            if( xTaskIncrementTick() != pdFALSE )
-                            {
-                                xYieldPending = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-
-                            --xPendedCounts;
-                        } while( xPendedCounts > ( TickType_t ) 0U );
-
-                        xPendedTicks = 0;
+                        pxTCB->uxPriority = uxNewPriority;
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
+
+                    /* The base priority gets set whatever. */
+                    pxTCB->uxBasePriority = uxNewPriority;
+                }
+                #else /* if ( configUSE_MUTEXES == 1 ) */
+                {
+                    pxTCB->uxPriority = uxNewPriority;
                 }
+                #endif /* if ( configUSE_MUTEXES == 1 ) */
 
-                if( xYieldPending != pdFALSE )
+                /* Only reset the event list item value if the value is not
+                 * being used for anything else. */
+                if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
                 {
-                    #if ( configUSE_PREEMPTION != 0 )
-                    {
-                        xAlreadyYielded = pdTRUE;
-                    }
-                    #endif
-                    taskYIELD_IF_USING_PREEMPTION();
+                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
-            }
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-    }
-    taskEXIT_CRITICAL();
-
-    return xAlreadyYielded;
-}
-/*-----------------------------------------------------------*/
-
-TickType_t xTaskGetTickCount( void )
-{
-    TickType_t xTicks;
-
-    /* Critical section required if running on a 16 bit processor. */
-    portTICK_TYPE_ENTER_CRITICAL();
-    {
-        xTicks = xTickCount;
-    }
-    portTICK_TYPE_EXIT_CRITICAL();
-
-    return xTicks;
-}
-/*-----------------------------------------------------------*/
-
-TickType_t xTaskGetTickCountFromISR( void )
-{
-    TickType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
-
-    /* RTOS ports that support interrupt nesting have the concept of a maximum
-     * system call (or maximum API call) interrupt priority.  Interrupts that are
-     * above the maximum system call priority are kept permanently enabled, even
-     * when the RTOS kernel is in a critical section, but cannot make any calls to
-     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-     * failure if a FreeRTOS API function is called from an interrupt that has been
-     * assigned a priority above the configured maximum system call priority.
-     * Only FreeRTOS functions that end in FromISR can be called from interrupts
-     * that have been assigned a priority at or (logically) below the maximum
-     * system call  interrupt priority.  FreeRTOS maintains a separate interrupt
-     * safe API to ensure interrupt entry is as fast and as simple as possible.
-     * More information (albeit Cortex-M specific) is provided on the following
-     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
-
-    uxSavedInterruptStatus = portTICK_TYPE_SET_INTERRUPT_MASK_FROM_ISR();
-    {
-        xReturn = xTickCount;
-    }
-    portTICK_TYPE_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
-
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
-
-UBaseType_t uxTaskGetNumberOfTasks( void )
-{
-    /* A critical section is not required because the variables are of type
-     * BaseType_t. */
-    return uxCurrentNumberOfTasks;
-}
-/*-----------------------------------------------------------*/
-
-char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-{
-    TCB_t * pxTCB;
-
-    /* If null is passed in here then the name of the calling task is being
-     * queried. */
-    pxTCB = prvGetTCBFromHandle( xTaskToQuery );
-    configASSERT( pxTCB );
-    return &( pxTCB->pcTaskName[ 0 ] );
-}
-/*-----------------------------------------------------------*/
-
-#if ( INCLUDE_xTaskGetHandle == 1 )
-
-    static TCB_t * prvSearchForNameWithinSingleList( List_t * pxList,
-                                                     const char pcNameToQuery[] )
-    {
-        TCB_t * pxNextTCB;
-        TCB_t * pxFirstTCB;
-        TCB_t * pxReturn = NULL;
-        UBaseType_t x;
-        char cNextChar;
-        BaseType_t xBreakLoop;
-
-        /* This function is called with the scheduler suspended. */
-
-        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
-        {
-            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-
-            do
-            {
-                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-
-                /* Check each character in the name looking for a match or
-                 * mismatch. */
-                xBreakLoop = pdFALSE;
 
-                for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
+                /* If the task is in the blocked or suspended list we need do
+                 * nothing more than change its priority variable. However, if
+                 * the task is in a ready list it needs to be removed and placed
+                 * in the list appropriate to its new priority. */
+                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
                 {
-                    cNextChar = pxNextTCB->pcTaskName[ x ];
-
-                    if( cNextChar != pcNameToQuery[ x ] )
-                    {
-                        /* Characters didn't match. */
-                        xBreakLoop = pdTRUE;
-                    }
-                    else if( cNextChar == ( char ) 0x00 )
+                    /* The task is currently in its ready list - remove before
+                     * adding it to its new ready list.  As we are in a critical
+                     * section we can do this even if the scheduler is suspended. */
+                    if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
                     {
-                        /* Both strings terminated, a match must have been
-                         * found. */
-                        pxReturn = pxNextTCB;
-                        xBreakLoop = pdTRUE;
+                        /* It is known that the task is in its ready list so
+                         * there is no need to check again and the ready priority
+                         * reset macro can be called directly. */
+                        taskCLEAR_READY_PRIORITY( uxPriorityUsedOnEntry );
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
 
-                    if( xBreakLoop != pdFALSE )
-                    {
-                        break;
-                    }
+                    prvAddTaskToReadyList( pxTCB );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
                 }
 
-                if( pxReturn != NULL )
+                if( xYieldRequired != pdFALSE )
                 {
-                    /* The handle has been found. */
-                    break;
+                    taskYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
                 }
-            } while( pxNextTCB != pxFirstTCB );
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
 
-        return pxReturn;
+                /* Remove compiler warning about unused variables when the port
+                 * optimised task selection is not being used. */
+                ( void ) uxPriorityUsedOnEntry;
+            }
+        }
+        taskEXIT_CRITICAL();
     }
 
-#endif /* INCLUDE_xTaskGetHandle */
+#endif /* INCLUDE_vTaskPrioritySet */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskGetHandle == 1 )
+#if ( INCLUDE_vTaskSuspend == 1 )
 
-    TaskHandle_t xTaskGetHandle( const char * pcNameToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    void vTaskSuspend( TaskHandle_t xTaskToSuspend )
     {
-        UBaseType_t uxQueue = configMAX_PRIORITIES;
         TCB_t * pxTCB;
 
-        /* Task names will be truncated to configMAX_TASK_NAME_LEN - 1 bytes. */
-        configASSERT( strlen( pcNameToQuery ) < configMAX_TASK_NAME_LEN );
-
-        vTaskSuspendAll();
+        taskENTER_CRITICAL();
         {
-            /* Search the ready lists. */
-            do
-            {
-                uxQueue--;
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) &( pxReadyTasksLists[ uxQueue ] ), pcNameToQuery );
+            /* If null is passed in here then it is the running task that is
+             * being suspended. */
+            pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
 
-                if( pxTCB != NULL )
-                {
-                    /* Found the handle. */
-                    break;
-                }
-            } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+            traceTASK_SUSPEND( pxTCB );
 
-            /* Search the delayed lists. */
-            if( pxTCB == NULL )
+            /* Remove task from the ready/delayed list and place in the
+             * suspended list. */
+            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
             {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
             }
-
-            if( pxTCB == NULL )
+            else
             {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+                mtCOVERAGE_TEST_MARKER();
             }
 
-            #if ( INCLUDE_vTaskSuspend == 1 )
+            #if ( configUSE_PREEMPTION_THRESHOLD == 1 )
             {
-                if( pxTCB == NULL )
-                {
-                    /* Search the suspended list. */
-                    pxTCB = prvSearchForNameWithinSingleList( &xSuspendedTaskList, pcNameToQuery );
-                }
+                prvRemovePreemptedTask( pxTCB );
             }
             #endif
 
-            #if ( INCLUDE_vTaskDelete == 1 )
+            #if ( configUSE_SHARED_STACKS == 1 )
             {
-                if( pxTCB == NULL )
+                /* Other tasks can use the shared stack while the task is
+                 * suspended, so its context is rebuilt when it next runs and
+                 * any job it was part way through is abandoned. */
+                if( pxTCB->ucJobState != taskJOB_NONE )
                 {
-                    /* Search the deleted list. */
-                    pxTCB = prvSearchForNameWithinSingleList( &xTasksWaitingTermination, pcNameToQuery );
+                    pxTCB->ucJobState = taskJOB_WAITING;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
                 }
             }
             #endif
-        }
-        ( void ) xTaskResumeAll();
-
-        return pxTCB;
-    }
 
-#endif /* INCLUDE_xTaskGetHandle */
-/*-----------------------------------------------------------*/
+            /* Is the task waiting on an event also? */
+            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+            {
+                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+            vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
 
-    UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray,
-                                      const UBaseType_t uxArraySize,
-                                      configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
-    {
-        UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
-
-        vTaskSuspendAll();
-        {
-            /* Is there a space in the array for each task in the system? */
-            if( uxArraySize >= uxCurrentNumberOfTasks )
+            #if ( configUSE_TASK_NOTIFICATIONS == 1 )
             {
-                /* Fill in an TaskStatus_t structure with information on each
-                 * task in the Ready state. */
-                do
-                {
-                    uxQueue--;
-                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ), eReady );
-                } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-
-                /* Fill in an TaskStatus_t structure with information on each
-                 * task in the Blocked state. */
-                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
-                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+                BaseType_t x;
 
-                #if ( INCLUDE_vTaskDelete == 1 )
+                for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
                 {
-                    /* Fill in an TaskStatus_t structure with information on
-                     * each task that has been deleted but not yet cleaned up. */
-                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xTasksWaitingTermination, eDeleted );
+                    if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+                    {
+                        /* The task was blocked to wait for a notification, but is
+                         * now suspended, so no notification was received. */
+                        pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+                    }
                 }
-                #endif
+            }
+            #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+        }
+        taskEXIT_CRITICAL();
 
-                #if ( INCLUDE_vTaskSuspend == 1 )
-                {
-                    /* Fill in an TaskStatus_t structure with information on
-                     * each task in the Suspended state. */
-                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xSuspendedTaskList, eSuspended );
-                }
-                #endif
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* Reset the next expected unblock time in case it referred to the
+             * task that is now in the Suspended state. */
+            taskENTER_CRITICAL();
+            {
+                prvResetNextTaskUnblockTime();
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-                #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        if( pxTCB == pxCurrentTCB )
+        {
+            if( xSchedulerRunning != pdFALSE )
+            {
+                /* The current task has just been suspended. */
+                configASSERT( uxSchedulerSuspended == 0 );
+                portYIELD_WITHIN_API();
+            }
+            else
+            {
+                /* The scheduler is not running, but the task that was pointed
+                 * to by pxCurrentTCB has just been suspended and pxCurrentTCB
+                 * must be adjusted to point to a different task. */
+                if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks ) /*lint !e931 Right has no side effect, just volatile. */
                 {
-                    if( pulTotalRunTime != NULL )
-                    {
-                        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                            portALT_GET_RUN_TIME_COUNTER_VALUE( ( *pulTotalRunTime ) );
-                        #else
-                            *pulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
-                        #endif
-                    }
+                    /* No other tasks are ready, so set pxCurrentTCB back to
+                     * NULL so when the next task is created pxCurrentTCB will
+                     * be set to point to it no matter what its relative priority
+                     * is. */
+                    pxCurrentTCB = NULL;
                 }
-                #else /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+                else
                 {
-                    if( pulTotalRunTime != NULL )
-                    {
-                        *pulTotalRunTime = 0;
-                    }
+                    vTaskSwitchContext();
                 }
-                #endif /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
             }
         }
-        ( void ) xTaskResumeAll();
-
-        return uxTask;
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
 
-#endif /* configUSE_TRACE_FACILITY */
-/*----------------------------------------------------------*/
+#endif /* INCLUDE_vTaskSuspend */
+/*-----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+#if ( INCLUDE_vTaskSuspend == 1 )
 
-    TaskHandle_t xTaskGetIdleTaskHandle( void )
+    static BaseType_t prvTaskIsTaskSuspended( const TaskHandle_t xTask )
     {
-        /* If xTaskGetIdleTaskHandle() is called before the scheduler has been
-         * started, then xIdleTaskHandle will be NULL. */
-        configASSERT( ( xIdleTaskHandle != NULL ) );
-        return xIdleTaskHandle;
-    }
-
-#endif /* INCLUDE_xTaskGetIdleTaskHandle */
-/*----------------------------------------------------------*/
+        BaseType_t xReturn = pdFALSE;
+        const TCB_t * const pxTCB = xTask;
 
-/* This conditional compilation should use inequality to 0, not equality to 1.
- * This is to ensure vTaskStepTick() is available when user defined low power mode
- * implementations require configUSE_TICKLESS_IDLE to be set to a value other than
- * 1. */
-#if ( configUSE_TICKLESS_IDLE != 0 )
+        /* Accesses xPendingReadyList so must be called from a critical
+         * section. */
 
-    void vTaskStepTick( TickType_t xTicksToJump )
-    {
-        /* Correct the tick count value after a period during which the tick
-         * was suppressed.  Note this does *not* call the tick hook function for
-         * each stepped tick. */
-        configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+        /* It does not make sense to check if the calling task is suspended. */
+        configASSERT( xTask );
 
-        if( ( xTickCount + xTicksToJump ) == xNextTaskUnblockTime )
+        /* Is the task being resumed actually in the suspended list? */
+        if( listIS_CONTAINED_WITHIN( &xSuspendedTaskList, &( pxTCB->xStateListItem ) ) != pdFALSE )
         {
-            /* Arrange for xTickCount to reach xNextTaskUnblockTime in
-             * xTaskIncrementTick() when the scheduler resumes.  This ensures
-             * that any delayed tasks are resumed at the correct time. */
-            configASSERT( uxSchedulerSuspended );
-            configASSERT( xTicksToJump != ( TickType_t ) 0 );
-
-            /* Prevent the tick interrupt modifying xPendedTicks simultaneously. */
-            taskENTER_CRITICAL();
+            /* Has the task already been resumed from within an ISR? */
+            if( listIS_CONTAINED_WITHIN( &xPendingReadyList, &( pxTCB->xEventListItem ) ) == pdFALSE )
+            {
+                /* Is it in the suspended list because it is in the Suspended
+                 * state, or because is is blocked with no timeout? */
+                if( listIS_CONTAINED_WITHIN( NULL, &( pxTCB->xEventListItem ) ) != pdFALSE ) /*lint !e961.  The cast is only redundant when NULL is used. */
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
             {
-                xPendedTicks++;
+                mtCOVERAGE_TEST_MARKER();
             }
-            taskEXIT_CRITICAL();
-            xTicksToJump--;
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        xTickCount += xTicksToJump;
-        traceINCREASE_TICK_COUNT( xTicksToJump );
-    }
-
-#endif /* configUSE_TICKLESS_IDLE */
-/*----------------------------------------------------------*/
-
-BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
-{
-    BaseType_t xYieldOccurred;
-
-    /* Must not be called with the scheduler suspended as the implementation
-     * relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
-    configASSERT( uxSchedulerSuspended == 0 );
-
-    /* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
-     * the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
-    vTaskSuspendAll();
-
-    /* Prevent the tick interrupt modifying xPendedTicks simultaneously. */
-    taskENTER_CRITICAL();
-    {
-        xPendedTicks += xTicksToCatchUp;
-    }
-    taskEXIT_CRITICAL();
-    xYieldOccurred = xTaskResumeAll();
+        return xReturn;
+    } /*lint !e818 xTask cannot be a pointer to const because it is a typedef. */
 
-    return xYieldOccurred;
-}
-/*----------------------------------------------------------*/
+#endif /* INCLUDE_vTaskSuspend */
+/*-----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskAbortDelay == 1 )
+#if ( INCLUDE_vTaskSuspend == 1 )
 
-    BaseType_t xTaskAbortDelay( TaskHandle_t xTask )
+    void vTaskResume( TaskHandle_t xTaskToResume )
     {
-        TCB_t * pxTCB = xTask;
-        BaseType_t xReturn;
+        TCB_t * const pxTCB = xTaskToResume;
 
-        configASSERT( pxTCB );
+        /* It does not make sense to resume the calling task. */
+        configASSERT( xTaskToResume );
 
-        vTaskSuspendAll();
+        /* The parameter cannot be NULL as it is impossible to resume the
+         * currently executing task. */
+        if( ( pxTCB != pxCurrentTCB ) && ( pxTCB != NULL ) )
         {
-            /* A task can only be prematurely removed from the Blocked state if
-             * it is actually in the Blocked state. */
-            if( eTaskGetState( xTask ) == eBlocked )
+            taskENTER_CRITICAL();
             {
-                xReturn = pdPASS;
+                if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
+                {
+                    traceTASK_RESUME( pxTCB );
 
-                /* Remove the reference to the task from the blocked list.  An
-                 * interrupt won't touch the xStateListItem because the
-                 * scheduler is suspended. */
-                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    /* The ready list can be accessed even if the scheduler is
+                     * suspended because this is inside a critical section. */
+                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
 
-                /* Is the task waiting on an event also?  If so remove it from
-                 * the event list too.  Interrupts can touch the event list item,
-                 * even though the scheduler is suspended, so a critical section
-                 * is used. */
-                taskENTER_CRITICAL();
-                {
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                    /* A higher priority task may have just been resumed. */
+                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
                     {
-                        ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
-
-                        /* This lets the task know it was forcibly removed from the
-                         * blocked state so it should not re-evaluate its block time and
-                         * then block again. */
-                        pxTCB->ucDelayAborted = pdTRUE;
+                        /* This yield may not cause the task just resumed to run,
+                         * but will leave the lists in the correct state for the
+                         * next yield. */
+                        taskYIELD_IF_USING_PREEMPTION();
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                taskEXIT_CRITICAL();
-
-                /* Place the unblocked task into the appropriate ready list. */
-                prvAddTaskToReadyList( pxTCB );
-
-                /* A task being unblocked cannot cause an immediate context
-                 * switch if preemption is turned off. */
-                #if ( configUSE_PREEMPTION == 1 )
+                else
                 {
-                    /* Preemption is on, but a context switch should only be
-                     * performed if the unblocked task has a priority that is
-                     * higher than the currently executing task. */
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* INCLUDE_vTaskSuspend */
+
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) )
+
+    BaseType_t xTaskResumeFromISR( TaskHandle_t xTaskToResume )
+    {
+        BaseType_t xYieldRequired = pdFALSE;
+        TCB_t * const pxTCB = xTaskToResume;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( xTaskToResume );
+
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum  system call (or maximum API call) interrupt priority.
+         * Interrupts that are  above the maximum system call priority are keep
+         * permanently enabled, even when the RTOS kernel is in a critical section,
+         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+         * is defined in FreeRTOSConfig.h then
+         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+         * failure if a FreeRTOS API function is called from an interrupt that has
+         * been assigned a priority above the configured maximum system call
+         * priority.  Only FreeRTOS functions that end in FromISR can be called
+         * from interrupts  that have been assigned a priority at or (logically)
+         * below the maximum system call interrupt priority.  FreeRTOS maintains a
+         * separate interrupt safe API to ensure interrupt entry is as fast and as
+         * simple as possible.  More information (albeit Cortex-M specific) is
+         * provided on the following link:
+         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
+            {
+                traceTASK_RESUME_FROM_ISR( pxTCB );
+
+                /* Check the ready lists can be accessed. */
+                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                {
+                    /* Ready lists can be accessed so move the task from the
+                     * suspended list to the ready list directly. */
+                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
                     {
-                        /* Pend the yield to be performed when the scheduler
-                         * is unsuspended. */
+                        xYieldRequired = pdTRUE;
+
+                        /* Mark that a yield is pending in case the user is not
+                         * using the return value to initiate a context switch
+                         * from the ISR using portYIELD_FROM_ISR. */
                         xYieldPending = pdTRUE;
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
+
+                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
+                }
+                else
+                {
+                    /* The delayed or ready lists cannot be accessed so the task
+                     * is held in the pending ready list until the scheduler is
+                     * unsuspended. */
+                    vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
-                #endif /* configUSE_PREEMPTION */
             }
             else
             {
-                xReturn = pdFAIL;
+                mtCOVERAGE_TEST_MARKER();
             }
         }
-        ( void ) xTaskResumeAll();
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-        return xReturn;
+        return xYieldRequired;
     }
 
-#endif /* INCLUDE_xTaskAbortDelay */
-/*----------------------------------------------------------*/
+#endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
+/*-----------------------------------------------------------*/
 
-BaseType_t xTaskIncrementTick( void )
+void vTaskStartScheduler( void )
 {
-    TCB_t * pxTCB;
-    TickType_t xItemValue;
-    BaseType_t xSwitchRequired = pdFALSE;
-
-    /* Called by the portable layer each time a tick interrupt occurs.
-     * Increments the tick then checks to see if the new tick value will cause any
-     * tasks to be unblocked. */
-    traceTASK_INCREMENT_TICK( xTickCount );
+    BaseType_t xReturn;
 
-    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+    /* Add the idle task at the lowest priority. */
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
     {
-        /* Minor optimisation.  The tick count cannot change in this
-         * block. */
-        const TickType_t xConstTickCount = xTickCount + ( TickType_t ) 1;
+        StaticTask_t * pxIdleTaskTCBBuffer = NULL;
+        StackType_t * pxIdleTaskStackBuffer = NULL;
+        uint32_t ulIdleTaskStackSize;
 
-        /* Increment the RTOS tick, switching the delayed and overflowed
-         * delayed lists if it wraps to 0. */
-        xTickCount = xConstTickCount;
+        /* The Idle task is created using user provided RAM - obtain the
+         * address of the RAM then create the idle task. */
+        vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
+        xIdleTaskHandle = xTaskCreateStatic( prvIdleTask,
+                                             configIDLE_TASK_NAME,
+                                             ulIdleTaskStackSize,
+                                             ( void * ) NULL,       /*lint !e961.  The cast is not redundant for all compilers. */
+                                             portPRIVILEGE_BIT,     /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                             pxIdleTaskStackBuffer,
+                                             pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
 
-        if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+        if( xIdleTaskHandle != NULL )
         {
-            taskSWITCH_DELAYED_LISTS();
+            xReturn = pdPASS;
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            xReturn = pdFAIL;
         }
+    }
+    #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+    {
+        /* The Idle task is being created using dynamically allocated RAM. */
+        xReturn = xTaskCreate( prvIdleTask,
+                               configIDLE_TASK_NAME,
+                               configMINIMAL_STACK_SIZE,
+                               ( void * ) NULL,
+                               portPRIVILEGE_BIT,  /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                               &xIdleTaskHandle ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+    }
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
 
-        /* See if this tick has made a timeout expire.  Tasks are stored in
-         * the  queue in the order of their wake time - meaning once one task
-         * has been found whose block time has not expired there is no need to
-         * look any further down the list. */
-        if( xConstTickCount >= xNextTaskUnblockTime )
+    #if ( configUSE_TIMERS == 1 )
+    {
+        if( xReturn == pdPASS )
         {
-            for( ; ; )
-            {
-                if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-                {
-                    /* The delayed list is empty.  Set xNextTaskUnblockTime
-                     * to the maximum possible value so it is extremely
-                     * unlikely that the
-                     * if( xTickCount >= xNextTaskUnblockTime ) test will pass
-                     * next time through. */
-                    xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                    break;
-                }
-                else
-                {
-                    /* The delayed list is not empty, get the value of the
-                     * item at the head of the delayed list.  This is the time
-                     * at which the task at the head of the delayed list must
-                     * be removed from the Blocked state. */
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                    xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
-
-                    if( xConstTickCount < xItemValue )
-                    {
-                        /* It is not time to unblock this item yet, but the
-                         * item value is the time at which the task at the head
-                         * of the blocked list must be removed from the Blocked
-                         * state -  so record the item value in
-                         * xNextTaskUnblockTime. */
-                        xNextTaskUnblockTime = xItemValue;
-                        break; /*lint !e9011 Code structure here is deemed easier to understand with multiple breaks. */
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* It is time to remove the item from the Blocked state. */
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-
-                    /* Is the task waiting on an event also?  If so remove
-                     * it from the event list. */
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-                    {
-                        listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* Place the unblocked task into the appropriate ready
-                     * list. */
-                    prvAddTaskToReadyList( pxTCB );
-
-                    /* A task being unblocked cannot cause an immediate
-                     * context switch if preemption is turned off. */
-                    #if ( configUSE_PREEMPTION == 1 )
-                    {
-                        /* Preemption is on, but a context switch should
-                         * only be performed if the unblocked task's
-                         * priority is higher than the currently executing
-                         * task.
-                         * The case of equal priority tasks sharing
-                         * processing time (which happens when both
-                         * preemption and time slicing are on) is
-                         * handled below.*/
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-                        {
-                            xSwitchRequired = pdTRUE;
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                    }
-                    #endif /* configUSE_PREEMPTION */
-                }
-            }
+            xReturn = xTimerCreateTimerTask();
         }
-
-        /* Tasks of equal priority to the currently running task will share
-         * processing time (time slice) if preemption is on, and the application
-         * writer has not explicitly turned time slicing off. */
-        #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+        else
         {
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
-            {
-                xSwitchRequired = pdTRUE;
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+            mtCOVERAGE_TEST_MARKER();
         }
-        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
+    }
+    #endif /* configUSE_TIMERS */
 
-        #if ( configUSE_TICK_HOOK == 1 )
+    if( xReturn == pdPASS )
+    {
+        /* freertos_tasks_c_additions_init() should only be called if the user
+         * definable macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is
+         * the only macro called by the function. */
+        #ifdef FREERTOS_TASKS_C_ADDITIONS_INIT
         {
-            /* Guard against the tick hook being called when the pended tick
-             * count is being unwound (when the scheduler is being unlocked). */
-            if( xPendedTicks == ( TickType_t ) 0 )
-            {
-                vApplicationTickHook();
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+            freertos_tasks_c_additions_init();
         }
-        #endif /* configUSE_TICK_HOOK */
+        #endif
 
-        #if ( configUSE_PREEMPTION == 1 )
+        /* Interrupts are turned off here, to ensure a tick does not occur
+         * before or during the call to xPortStartScheduler().  The stacks of
+         * the created tasks contain a status word with interrupts switched on
+         * so interrupts will automatically get re-enabled when the first task
+         * starts to run. */
+        portDISABLE_INTERRUPTS();
+
+        #if ( configUSE_EDF_SCHEDULING == 1 )
         {
-            if( xYieldPending != pdFALSE )
+            /* The task that runs first was chosen by priority alone as the
+             * tasks were created.  If it is deadline scheduled then start the
+             * one with the earliest deadline instead. */
+            if( taskIS_EDF_PRIORITY( pxCurrentTCB->uxPriority ) )
             {
-                xSwitchRequired = pdTRUE;
+                pxCurrentTCB = listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) );
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        #endif /* configUSE_PREEMPTION */
-    }
-    else
-    {
-        ++xPendedTicks;
+        #endif /* configUSE_EDF_SCHEDULING */
 
-        /* The tick hook gets called at regular intervals, even if the
-         * scheduler is locked. */
-        #if ( configUSE_TICK_HOOK == 1 )
+        #if ( configUSE_SHARED_STACKS == 1 )
         {
-            vApplicationTickHook();
+            /* The context of a task on a shared stack may have been
+             * overwritten by another task created on the same stack. */
+            prvSharedStackPrepareTask( pxCurrentTCB );
         }
         #endif
-    }
 
-    return xSwitchRequired;
-}
-/*-----------------------------------------------------------*/
+        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+        {
+            /* Switch C-Runtime's TLS Block to point to the TLS
+             * block specific to the task that will run first. */
+            configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+        }
+        #endif
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+        xNextTaskUnblockTime = portMAX_DELAY;
+        xSchedulerRunning = pdTRUE;
+        xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
 
-    void vTaskSetApplicationTaskTag( TaskHandle_t xTask,
-                                     TaskHookFunction_t pxHookFunction )
-    {
-        TCB_t * xTCB;
-
-        /* If xTask is NULL then it is the task hook of the calling task that is
-         * getting set. */
-        if( xTask == NULL )
-        {
-            xTCB = ( TCB_t * ) pxCurrentTCB;
-        }
-        else
-        {
-            xTCB = xTask;
-        }
+        /* If configGENERATE_RUN_TIME_STATS is defined then the following
+         * macro must be defined to configure the timer/counter used to generate
+         * the run time counter time base.   NOTE:  If configGENERATE_RUN_TIME_STATS
+         * is set to 0 and the following line fails to build then ensure you do not
+         * have portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() defined in your
+         * FreeRTOSConfig.h file. */
+        portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
 
-        /* Save the hook function in the TCB.  A critical section is required as
-         * the value can be accessed from an interrupt. */
-        taskENTER_CRITICAL();
+        #if ( configUSE_TASK_BUDGETS == 1 )
         {
-            xTCB->pxTaskTag = pxHookFunction;
+            /* Start the counter used to measure the execution time of tasks
+             * that have a budget, and charge the first task from now. */
+            portCONFIGURE_BUDGET_COUNTER();
+            ulBudgetChargedTime = portGET_BUDGET_COUNTER_VALUE();
         }
-        taskEXIT_CRITICAL();
-    }
+        #endif /* configUSE_TASK_BUDGETS */
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
-/*-----------------------------------------------------------*/
+        traceTASK_SWITCHED_IN();
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+        /* Setting up the timer tick is hardware specific and thus in the
+         * portable interface. */
+        xPortStartScheduler();
 
-    TaskHookFunction_t xTaskGetApplicationTaskTag( TaskHandle_t xTask )
+        /* In most cases, xPortStartScheduler() will not return. If it
+         * returns pdTRUE then there was not enough heap memory available
+         * to create either the Idle or the Timer task. If it returned
+         * pdFALSE, then the application called xTaskEndScheduler().
+         * Most ports don't implement xTaskEndScheduler() as there is
+         * nothing to return to. */
+    }
+    else
     {
-        TCB_t * pxTCB;
-        TaskHookFunction_t xReturn;
-
-        /* If xTask is NULL then set the calling task's hook. */
-        pxTCB = prvGetTCBFromHandle( xTask );
-
-        /* Save the hook function in the TCB.  A critical section is required as
-         * the value can be accessed from an interrupt. */
-        taskENTER_CRITICAL();
-        {
-            xReturn = pxTCB->pxTaskTag;
-        }
-        taskEXIT_CRITICAL();
-
-        return xReturn;
+        /* This line will only be reached if the kernel could not be started,
+         * because there was not enough FreeRTOS heap to create the idle task
+         * or the timer task. */
+        configASSERT( xReturn != errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY );
     }
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
+    /* Prevent compiler warnings if INCLUDE_xTaskGetIdleTaskHandle is set to 0,
+     * meaning xIdleTaskHandle is not used anywhere else. */
+    ( void ) xIdleTaskHandle;
+
+    /* OpenOCD makes use of uxTopUsedPriority for thread debugging. Prevent uxTopUsedPriority
+     * from getting optimized out as it is no longer used by the kernel. */
+    ( void ) uxTopUsedPriority;
+}
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+void vTaskEndScheduler( void )
+{
+    /* Stop the scheduler interrupts and call the portable scheduler end
+     * routine so the original ISRs can be restored if necessary.  The port
+     * layer must ensure interrupts enable  bit is left in the correct state. */
+    portDISABLE_INTERRUPTS();
+    xSchedulerRunning = pdFALSE;
+    vPortEndScheduler();
+}
+/*----------------------------------------------------------*/
 
-    TaskHookFunction_t xTaskGetApplicationTaskTagFromISR( TaskHandle_t xTask )
-    {
-        TCB_t * pxTCB;
-        TaskHookFunction_t xReturn;
-        UBaseType_t uxSavedInterruptStatus;
+void vTaskSuspendAll( void )
+{
+    /* A critical section is not required as the variable is of type
+     * BaseType_t.  Please read Richard Barry's reply in the following link to a
+     * post in the FreeRTOS support forum before reporting this as a bug! -
+     * https://goo.gl/wu4acr */
 
-        /* If xTask is NULL then set the calling task's hook. */
-        pxTCB = prvGetTCBFromHandle( xTask );
+    /* portSOFTWARE_BARRIER() is only implemented for emulated/simulated ports that
+     * do not otherwise exhibit real time behaviour. */
+    portSOFTWARE_BARRIER();
 
-        /* Save the hook function in the TCB.  A critical section is required as
-         * the value can be accessed from an interrupt. */
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    #if ( configUSE_DYNAMIC_TICK == 1 )
+    {
+        /* The tick count does not move while the scheduler is suspended, so
+         * bring it up to date first - code that runs with the scheduler
+         * suspended expects it to hold the time at which it was suspended. */
+        if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
         {
-            xReturn = pxTCB->pxTaskTag;
+            portSYNC_TICK_COUNT();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
-
-        return xReturn;
     }
+    #endif /* configUSE_DYNAMIC_TICK */
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
-/*-----------------------------------------------------------*/
+    /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
+     * is used to allow calls to vTaskSuspendAll() to nest. */
+    ++uxSchedulerSuspended;
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+    /* Enforces ordering for ports and optimised compilers that may otherwise place
+     * the above increment elsewhere. */
+    portMEMORY_BARRIER();
+}
+/*----------------------------------------------------------*/
 
-    BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
-                                             void * pvParameter )
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+    static TickType_t prvGetExpectedIdleTime( void )
     {
-        TCB_t * xTCB;
-        BaseType_t xReturn;
+        TickType_t xReturn;
+        UBaseType_t uxHigherPriorityReadyTasks = pdFALSE;
 
-        /* If xTask is NULL then we are calling our own task hook. */
-        if( xTask == NULL )
+        /* uxHigherPriorityReadyTasks takes care of the case where
+         * configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
+         * task that are in the Ready state, even though the idle task is
+         * running. */
+        #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
         {
-            xTCB = pxCurrentTCB;
+            if( uxTopReadyPriority > tskIDLE_PRIORITY )
+            {
+                uxHigherPriorityReadyTasks = pdTRUE;
+            }
         }
-        else
+        #else
         {
-            xTCB = xTask;
+            const UBaseType_t uxLeastSignificantBit = ( UBaseType_t ) 0x01;
+
+            /* When port optimised task selection is used the uxTopReadyPriority
+             * variable is used as a bit map.  If bits other than the least
+             * significant bit are set then there are tasks that have a priority
+             * above the idle priority that are in the Ready state.  This takes
+             * care of the case where the co-operative scheduler is in use. */
+            #if ( configMAX_PRIORITIES > 32 )
+            {
+                /* With the two level bit map the idle priority is the least
+                 * significant bit of the first second level word. */
+                if( ( uxTopReadyPriority > uxLeastSignificantBit ) || ( uxReadyPriorityWords[ 0 ] > uxLeastSignificantBit ) )
+                {
+                    uxHigherPriorityReadyTasks = pdTRUE;
+                }
+            }
+            #else
+            {
+                if( uxTopReadyPriority > uxLeastSignificantBit )
+                {
+                    uxHigherPriorityReadyTasks = pdTRUE;
+                }
+            }
+            #endif /* configMAX_PRIORITIES */
         }
+        #endif /* if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) */
 
-        if( xTCB->pxTaskTag != NULL )
+        if( pxCurrentTCB->uxPriority > tskIDLE_PRIORITY )
         {
-            xReturn = xTCB->pxTaskTag( pvParameter );
+            xReturn = 0;
+        }
+        else if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > 1 )
+        {
+            /* There are other idle priority tasks in the ready state.  If
+             * time slicing is used then the very next tick interrupt must be
+             * processed. */
+            xReturn = 0;
+        }
+        else if( uxHigherPriorityReadyTasks != pdFALSE )
+        {
+            /* There are tasks in the Ready state that have a priority above the
+             * idle priority.  This path can only be reached if
+             * configUSE_PREEMPTION is 0. */
+            xReturn = 0;
         }
         else
         {
-            xReturn = pdFAIL;
+            xReturn = xNextTaskUnblockTime - xTickCount;
         }
 
         return xReturn;
     }
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
-/*-----------------------------------------------------------*/
+#endif /* configUSE_TICKLESS_IDLE */
+/*----------------------------------------------------------*/
 
-void vTaskSwitchContext( void )
-{
-    if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
-    {
-        /* The scheduler is currently suspended - do not allow a context
-         * switch. */
-        xYieldPending = pdTRUE;
-    }
-    else
-    {
-        xYieldPending = pdFALSE;
-        traceTASK_SWITCHED_OUT();
+#if ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 2 ) || ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_PRIORITY_EVENT_LISTS == 1 ) ) )
 
-        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+    static UBaseType_t prvGetHighestSetBit( uint32_t ulBits )
+    {
+        /* Bit positions indexed by the top five bits of the product of the
+         * de Bruijn sequence 0x07C4ACDD and a value of the form 2^(n+1)-1. */
+        static const uint8_t ucBitPositions[ 32 ] =
         {
-            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
-            #else
-                ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
-            #endif
+            0U,  9U,  1U,  10U, 13U, 21U, 2U,  29U, 11U, 14U, 16U, 18U, 22U, 25U, 3U, 30U,
+            8U,  12U, 20U, 28U, 15U, 17U, 24U, 7U,  19U, 27U, 23U, 6U,  26U, 5U,  4U, 31U
+        };
 
-            /* Add the amount of time the task has been running to the
-             * accumulated time so far.  The time the task started running was
-             * stored in ulTaskSwitchedInTime.  Note that there is no overflow
-             * protection here so count values are only valid until the timer
-             * overflows.  The guard against negative values is to protect
-             * against suspect run time stat counter implementations - which
-             * are provided by the application, not the kernel. */
-            if( ulTotalRunTime > ulTaskSwitchedInTime )
-            {
-                pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+        configASSERT( ulBits != 0UL );
 
-            ulTaskSwitchedInTime = ulTotalRunTime;
-        }
-        #endif /* configGENERATE_RUN_TIME_STATS */
+        /* Set every bit below the most significant set bit so the value
+         * becomes 2^(n+1)-1, which the multiply maps to a unique index. */
+        ulBits |= ulBits >> 1;
+        ulBits |= ulBits >> 2;
+        ulBits |= ulBits >> 4;
+        ulBits |= ulBits >> 8;
+        ulBits |= ulBits >> 16;
 
-        /* Check for stack overflow, if configured. */
-        taskCHECK_FOR_STACK_OVERFLOW();
+        return ( UBaseType_t ) ucBitPositions[ ( uint32_t ) ( ulBits * 0x07C4ACDDUL ) >> 27 ];
+    }
 
-        /* Before the currently running task is switched out, save its errno. */
-        #if ( configUSE_POSIX_ERRNO == 1 )
-        {
-            pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
-        }
-        #endif
+#endif /* ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 2 ) || ( ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) && ( configUSE_PRIORITY_EVENT_LISTS == 1 ) ) */
+/*----------------------------------------------------------*/
 
-        /* Select a new task to run using either the generic C or port
-         * optimised asm code. */
-        taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-        traceTASK_SWITCHED_IN();
+BaseType_t xTaskResumeAll( void )
+{
+    TCB_t * pxTCB = NULL;
+    BaseType_t xAlreadyYielded = pdFALSE;
 
-        /* After the new task is switched in, update the global errno. */
-        #if ( configUSE_POSIX_ERRNO == 1 )
-        {
-            FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
-        }
-        #endif
+    /* If uxSchedulerSuspended is zero then this function does not match a
+     * previous call to vTaskSuspendAll(). */
+    configASSERT( uxSchedulerSuspended );
 
-        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
-        {
-            /* Switch C-Runtime's TLS Block to point to the TLS
-             * Block specific to this task. */
-            configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
-        }
-        #endif
+    /* It is possible that an ISR caused a task to be removed from an event
+     * list while the scheduler was suspended.  If this was the case then the
+     * removed task will have been added to the xPendingReadyList.  Once the
+     * scheduler has been resumed it is safe to move all the pending ready
+     * tasks from this list into their appropriate ready list. */
+    taskENTER_CRITICAL();
+    {
+        --uxSchedulerSuspended;
+
+        if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+        {
+            if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
+            {
+                /* Move any readied tasks from the pending list into the
+                 * appropriate ready list. */
+                while( listLIST_IS_EMPTY( &xPendingReadyList ) == pdFALSE )
+                {
+                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                    portMEMORY_BARRIER();
+                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
+
+                    /* If the moved task has a priority higher than or equal to
+                     * the current task then a yield must be performed. */
+                    if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+                    {
+                        xYieldPending = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                if( pxTCB != NULL )
+                {
+                    /* A task was unblocked while the scheduler was suspended,
+                     * which may have prevented the next unblock time from being
+                     * re-calculated, in which case re-calculate it now.  Mainly
+                     * important for low power tickless implementations, where
+                     * this can prevent an unnecessary exit from low power
+                     * state. */
+                    prvResetNextTaskUnblockTime();
+                }
+
+                /* If any ticks occurred while the scheduler was suspended then
+                 * they should be processed now.  This ensures the tick count does
+                 * not  slip, and that any delayed tasks are resumed at the correct
+                 * time. */
+                {
+                    TickType_t xPendedCounts = xPendedTicks; /* Non-volatile copy. */
+
+                    if( xPendedCounts > ( TickType_t ) 0U )
+                    {
+                        do
+                        {
+                            if( xTaskIncrementTick() != pdFALSE )
+                            {
+                                xYieldPending = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+
+                            --xPendedCounts;
+                        } while( xPendedCounts > ( TickType_t ) 0U );
+
+                        xPendedTicks = 0;
+
+                        #if ( configTICK_UNBLOCK_LIMIT > 0 )
+                        {
+                            /* No task can be allowed to run while a task that
+                             * is due at the last tick processed is still
+                             * Blocked, as it may have the higher priority. */
+                            if( xTickUnblocksDeferred != pdFALSE )
+                            {
+                                if( prvUnblockDeferredTasks( taskUNBLOCK_ALL ) != pdFALSE )
+                                {
+                                    xYieldPending = pdTRUE;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif /* configTICK_UNBLOCK_LIMIT */
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                if( xYieldPending != pdFALSE )
+                {
+                    #if ( configUSE_PREEMPTION != 0 )
+                    {
+                        xAlreadyYielded = pdTRUE;
+                    }
+                    #endif
+                    taskYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
+    taskEXIT_CRITICAL();
+
+    return xAlreadyYielded;
 }
 /*-----------------------------------------------------------*/
 
-void vTaskPlaceOnEventList( List_t * const pxEventList,
-                            const TickType_t xTicksToWait )
+TickType_t xTaskGetTickCount( void )
 {
-    configASSERT( pxEventList );
+    TickType_t xTicks;
 
-    /* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
-     * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+    /* Critical section required if running on a 16 bit processor. */
+    portTICK_TYPE_ENTER_CRITICAL();
+    {
+        xTicks = taskSYNCED_TICK_COUNT();
+    }
+    portTICK_TYPE_EXIT_CRITICAL();
 
-    /* Place the event list item of the TCB in the appropriate event list.
-     * This is placed in the list in priority order so the highest priority task
-     * is the first to be woken by the event.
-     *
-     * Note: Lists are sorted in ascending order by ListItem_t.xItemValue.
-     * Normally, the xItemValue of a TCB's ListItem_t members is:
-     *      xItemValue = ( configMAX_PRIORITIES - uxPriority )
-     * Therefore, the event list is sorted in descending priority order.
-     *
-     * The queue that contains the event list is locked, preventing
-     * simultaneous access from interrupts. */
-    vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+    return xTicks;
+}
+/*-----------------------------------------------------------*/
 
-    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+TickType_t xTaskGetTickCountFromISR( void )
+{
+    TickType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
+
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+     * failure if a FreeRTOS API function is called from an interrupt that has been
+     * assigned a priority above the configured maximum system call priority.
+     * Only FreeRTOS functions that end in FromISR can be called from interrupts
+     * that have been assigned a priority at or (logically) below the maximum
+     * system call  interrupt priority.  FreeRTOS maintains a separate interrupt
+     * safe API to ensure interrupt entry is as fast and as simple as possible.
+     * More information (albeit Cortex-M specific) is provided on the following
+     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = portTICK_TYPE_SET_INTERRUPT_MASK_FROM_ISR();
+    {
+        xReturn = taskSYNCED_TICK_COUNT();
+    }
+    portTICK_TYPE_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+    return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
-                                     const TickType_t xItemValue,
-                                     const TickType_t xTicksToWait )
+TickType_t xTaskGetTickCountIncludingPended( void )
 {
-    configASSERT( pxEventList );
+    TickType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
 
-    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
-     * the event groups implementation. */
-    configASSERT( uxSchedulerSuspended != 0 );
+    /* Masking interrupts works from a task or an ISR, and stops the tick
+     * interrupt, or xTaskResumeAll() winding the pended ticks down, from
+     * changing either count between the two reads. */
+    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    {
+        xReturn = taskSYNCED_TICK_COUNT() + xPendedTicks;
+    }
+    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-    /* Store the item value in the event list item.  It is safe to access the
-     * event list item here as interrupts won't access the event list item of a
-     * task that is not in the Blocked state. */
-    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
 
-    /* Place the event list item of the TCB at the end of the appropriate event
-     * list.  It is safe to access the event list here because it is part of an
-     * event group implementation - and interrupts don't access event groups
-     * directly (instead they access them indirectly by pending function calls to
-     * the task level). */
-    listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+UBaseType_t uxTaskGetNumberOfTasks( void )
+{
+    /* A critical section is not required because the variables are of type
+     * BaseType_t. */
+    return uxCurrentNumberOfTasks;
+}
+/*-----------------------------------------------------------*/
 
-    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+{
+    TCB_t * pxTCB;
+
+    /* If null is passed in here then the name of the calling task is being
+     * queried. */
+    pxTCB = prvGetTCBFromHandle( xTaskToQuery );
+    configASSERT( pxTCB );
+    return &( pxTCB->pcTaskName[ 0 ] );
 }
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TIMERS == 1 )
+#if ( INCLUDE_xTaskGetHandle == 1 )
 
-    void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
-                                          TickType_t xTicksToWait,
-                                          const BaseType_t xWaitIndefinitely )
+    static TCB_t * prvSearchForNameWithinSingleList( List_t * pxList,
+                                                     const char pcNameToQuery[] )
     {
-        configASSERT( pxEventList );
+        TCB_t * pxNextTCB;
+        TCB_t * pxFirstTCB;
+        TCB_t * pxReturn = NULL;
+        UBaseType_t x;
+        char cNextChar;
+        BaseType_t xBreakLoop;
+
+        /* This function is called with the scheduler suspended. */
+
+        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        {
+            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            do
+            {
+                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                /* Check each character in the name looking for a match or
+                 * mismatch. */
+                xBreakLoop = pdFALSE;
+
+                for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
+                {
+                    cNextChar = pxNextTCB->pcTaskName[ x ];
+
+                    if( cNextChar != pcNameToQuery[ x ] )
+                    {
+                        /* Characters didn't match. */
+                        xBreakLoop = pdTRUE;
+                    }
+                    else if( cNextChar == ( char ) 0x00 )
+                    {
+                        /* Both strings terminated, a match must have been
+                         * found. */
+                        pxReturn = pxNextTCB;
+                        xBreakLoop = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( xBreakLoop != pdFALSE )
+                    {
+                        break;
+                    }
+                }
+
+                if( pxReturn != NULL )
+                {
+                    /* The handle has been found. */
+                    break;
+                }
+            } while( pxNextTCB != pxFirstTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxReturn;
+    }
+
+#endif /* INCLUDE_xTaskGetHandle */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskGetHandle == 1 )
+
+    TaskHandle_t xTaskGetHandle( const char * pcNameToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    {
+        UBaseType_t uxQueue = configMAX_PRIORITIES;
+        TCB_t * pxTCB;
+
+        /* Task names will be truncated to configMAX_TASK_NAME_LEN - 1 bytes. */
+        configASSERT( strlen( pcNameToQuery ) < configMAX_TASK_NAME_LEN );
+
+        vTaskSuspendAll();
+        {
+            /* Search the ready lists. */
+            do
+            {
+                uxQueue--;
+                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) &( pxReadyTasksLists[ uxQueue ] ), pcNameToQuery );
+
+                if( pxTCB != NULL )
+                {
+                    /* Found the handle. */
+                    break;
+                }
+            } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+            /* Search the delayed lists. */
+            #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+            {
+                UBaseType_t uxSlot;
+                List_t * const pxFirstSlot = &( xDelayedTaskWheel[ 0 ][ 0 ] );
+
+                for( uxSlot = ( UBaseType_t ) 0U; ( pxTCB == NULL ) && ( uxSlot < ( taskWHEEL_LEVELS * taskWHEEL_SLOTS ) ); uxSlot++ )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( &( pxFirstSlot[ uxSlot ] ), pcNameToQuery );
+                }
+            }
+            #else
+            {
+                if( pxTCB == NULL )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+                }
+
+                if( pxTCB == NULL )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+                }
+            }
+            #endif /* configUSE_DELAYED_TASK_WHEEL */
+
+            #if ( INCLUDE_vTaskSuspend == 1 )
+            {
+                if( pxTCB == NULL )
+                {
+                    /* Search the suspended list. */
+                    pxTCB = prvSearchForNameWithinSingleList( &xSuspendedTaskList, pcNameToQuery );
+                }
+            }
+            #endif
+
+            #if ( INCLUDE_vTaskDelete == 1 )
+            {
+                if( pxTCB == NULL )
+                {
+                    /* Search the deleted list. */
+                    pxTCB = prvSearchForNameWithinSingleList( &xTasksWaitingTermination, pcNameToQuery );
+                }
+            }
+            #endif
+        }
+        ( void ) xTaskResumeAll();
+
+        return pxTCB;
+    }
+
+#endif /* INCLUDE_xTaskGetHandle */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray,
+                                      const UBaseType_t uxArraySize,
+                                      configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
+    {
+        UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
+
+        vTaskSuspendAll();
+        {
+            /* Is there a space in the array for each task in the system? */
+            if( uxArraySize >= uxCurrentNumberOfTasks )
+            {
+                /* Fill in an TaskStatus_t structure with information on each
+                 * task in the Ready state. */
+                do
+                {
+                    uxQueue--;
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ), eReady );
+                } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+                /* Fill in an TaskStatus_t structure with information on each
+                 * task in the Blocked state. */
+                #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+                {
+                    UBaseType_t uxSlot;
+                    List_t * const pxFirstSlot = &( xDelayedTaskWheel[ 0 ][ 0 ] );
+
+                    for( uxSlot = ( UBaseType_t ) 0U; uxSlot < ( taskWHEEL_LEVELS * taskWHEEL_SLOTS ); uxSlot++ )
+                    {
+                        uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxFirstSlot[ uxSlot ] ), eBlocked );
+                    }
+                }
+                #else
+                {
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+                }
+                #endif /* configUSE_DELAYED_TASK_WHEEL */
+
+                #if ( INCLUDE_vTaskDelete == 1 )
+                {
+                    /* Fill in an TaskStatus_t structure with information on
+                     * each task that has been deleted but not yet cleaned up. */
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xTasksWaitingTermination, eDeleted );
+                }
+                #endif
+
+                #if ( INCLUDE_vTaskSuspend == 1 )
+                {
+                    /* Fill in an TaskStatus_t structure with information on
+                     * each task in the Suspended state. */
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xSuspendedTaskList, eSuspended );
+                }
+                #endif
+
+                #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                {
+                    if( pulTotalRunTime != NULL )
+                    {
+                        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                            portALT_GET_RUN_TIME_COUNTER_VALUE( ( *pulTotalRunTime ) );
+                        #else
+                            *pulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+                        #endif
+                    }
+                }
+                #else /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+                {
+                    if( pulTotalRunTime != NULL )
+                    {
+                        *pulTotalRunTime = 0;
+                    }
+                }
+                #endif /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return uxTask;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*----------------------------------------------------------*/
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+    UBaseType_t uxTaskGetBudgetState( TaskBudgetStatus_t * const pxBudgetStatusArray,
+                                      const UBaseType_t uxArraySize )
+    {
+        UBaseType_t uxTask = 0;
+        const ListItem_t * pxIterator;
+        const ListItem_t * const pxEndMarker = listGET_END_MARKER( &xBudgetedTaskList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+        TCB_t * pxTCB;
+
+        /* The tick interrupt updates the budget of the running task, so a
+         * critical section is used rather than suspending the scheduler. */
+        taskENTER_CRITICAL();
+        {
+            /* Is there a space in the array for each task with a budget? */
+            if( uxArraySize >= listCURRENT_LIST_LENGTH( &xBudgetedTaskList ) )
+            {
+                /* Bring the budget of the calling task up to date. */
+                prvBudgetCharge( xTickCount );
+
+                for( pxIterator = listGET_HEAD_ENTRY( &xBudgetedTaskList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+                {
+                    pxTCB = listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                    pxBudgetStatusArray[ uxTask ].xHandle = ( TaskHandle_t ) pxTCB;
+                    pxBudgetStatusArray[ uxTask ].pcTaskName = ( const char * ) &( pxTCB->pcTaskName[ 0 ] );
+                    pxBudgetStatusArray[ uxTask ].ulBudget = pxTCB->ulBudget;
+                    pxBudgetStatusArray[ uxTask ].xPeriod = pxTCB->xBudgetPeriod;
+                    pxBudgetStatusArray[ uxTask ].uxOverruns = pxTCB->uxBudgetOverruns;
+
+                    /* A task that has not run since its period ended has not
+                     * had its budget replenished yet. */
+                    if( ( pxTCB->ucBudgetState != taskBUDGET_DEMOTED ) && ( taskBUDGET_PERIOD_ENDED( pxTCB, xTickCount ) != pdFALSE ) )
+                    {
+                        prvBudgetReplenish( pxTCB, xTickCount );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxBudgetStatusArray[ uxTask ].ulBudgetUsed = pxTCB->ulBudgetUsed;
+                    pxBudgetStatusArray[ uxTask ].ulPeakBudgetUsed = ( pxTCB->ulBudgetUsed > pxTCB->ulPeakBudgetUsed ) ? pxTCB->ulBudgetUsed : pxTCB->ulPeakBudgetUsed;
+                    pxBudgetStatusArray[ uxTask ].xThrottled = ( pxTCB->ucBudgetState != taskBUDGET_AVAILABLE ) ? pdTRUE : pdFALSE;
+                    uxTask++;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return uxTask;
+    }
+
+#endif /* configUSE_TASK_BUDGETS */
+/*----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+
+    TaskHandle_t xTaskGetIdleTaskHandle( void )
+    {
+        /* If xTaskGetIdleTaskHandle() is called before the scheduler has been
+         * started, then xIdleTaskHandle will be NULL. */
+        configASSERT( ( xIdleTaskHandle != NULL ) );
+        return xIdleTaskHandle;
+    }
+
+#endif /* INCLUDE_xTaskGetIdleTaskHandle */
+/*----------------------------------------------------------*/
+
+/* This conditional compilation should use inequality to 0, not equality to 1.
+ * This is to ensure vTaskStepTick() is available when user defined low power mode
+ * implementations require configUSE_TICKLESS_IDLE to be set to a value other than
+ * 1. */
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+    void vTaskStepTick( TickType_t xTicksToJump )
+    {
+        /* Correct the tick count value after a period during which the tick
+         * was suppressed.  Note this does *not* call the tick hook function for
+         * each stepped tick. */
+        configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+
+        if( ( xTickCount + xTicksToJump ) == xNextTaskUnblockTime )
+        {
+            /* Arrange for xTickCount to reach xNextTaskUnblockTime in
+             * xTaskIncrementTick() when the scheduler resumes.  This ensures
+             * that any delayed tasks are resumed at the correct time. */
+            configASSERT( uxSchedulerSuspended );
+            configASSERT( xTicksToJump != ( TickType_t ) 0 );
+
+            /* Prevent the tick interrupt modifying xPendedTicks simultaneously. */
+            taskADD_PENDED_TICKS( 1U );
+            xTicksToJump--;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xTickCount += xTicksToJump;
+        traceINCREASE_TICK_COUNT( xTicksToJump );
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*----------------------------------------------------------*/
+
+BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
+{
+    BaseType_t xYieldOccurred;
+
+    /* Must not be called with the scheduler suspended as the implementation
+     * relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
+    configASSERT( uxSchedulerSuspended == 0 );
+
+    /* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
+     * the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
+    vTaskSuspendAll();
+
+    /* Prevent the tick interrupt modifying xPendedTicks simultaneously. */
+    taskADD_PENDED_TICKS( xTicksToCatchUp );
+    xYieldOccurred = xTaskResumeAll();
+
+    return xYieldOccurred;
+}
+/*----------------------------------------------------------*/
+
+#if ( configUSE_DYNAMIC_TICK == 1 )
+
+    TickType_t xTaskGetTicksToNextEvent( void )
+    {
+        TickType_t xReturn;
+
+        if( xPendedTicks != ( TickType_t ) 0 )
+        {
+            /* The scheduler is, or was very recently, suspended and ticks are
+             * waiting to be processed.  Tick normally until they have been. */
+            xReturn = ( TickType_t ) 1;
+        }
+        else
+        {
+            xReturn = xNextTaskUnblockTime - xTickCount;
+
+            #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+            {
+                UBaseType_t uxTopPriority;
+
+                /* Tasks that share the highest ready priority time slice, which
+                 * needs a tick interrupt on every tick. */
+                taskGET_HIGHEST_READY_PRIORITY( uxTopPriority );
+
+                if( ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > ( UBaseType_t ) 1 ) &&
+                    ( taskIS_EDF_PRIORITY( uxTopPriority ) == pdFALSE ) )
+                {
+                    xReturn = ( TickType_t ) 1;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
+
+            #if ( configUSE_TASK_BUDGETS == 1 )
+            {
+                /* The budget of the running task is checked on every tick, and
+                 * a demoted task has its priority restored on the tick its
+                 * budget is replenished. */
+                if( pxCurrentTCB->ulBudget != 0UL )
+                {
+                    xReturn = ( TickType_t ) 1;
+                }
+                else if( ( uxBudgetDemotedTasks > ( UBaseType_t ) 0U ) &&
+                         ( ( TickType_t ) ( xNextBudgetReplenishTime - xTickCount ) < xReturn ) )
+                {
+                    xReturn = xNextBudgetReplenishTime - xTickCount;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_TASK_BUDGETS */
+
+            if( xReturn == ( TickType_t ) 0 )
+            {
+                /* xTickCount has reached xNextTaskUnblockTime without a task
+                 * being unblocked, which only happens when xNextTaskUnblockTime
+                 * is portMAX_DELAY.  The next tick is the tick count overflow. */
+                xReturn = ( TickType_t ) 1;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xReturn;
+    }
+/*----------------------------------------------------------*/
+
+    TickType_t xTaskStepTickDynamic( TickType_t xTicksToStep )
+    {
+        TickType_t xTicksToLimit;
+
+        /* The tick count does not move while the scheduler is suspended, and
+         * ticks that are already pended must be processed before it can move
+         * forward, otherwise a task could miss its unblock time. */
+        if( ( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE ) && ( xPendedTicks == ( TickType_t ) 0 ) )
+        {
+            /* Stop one tick short of xNextTaskUnblockTime.  The tick interrupt
+             * is programmed to occur no later than xNextTaskUnblockTime, and it
+             * is that interrupt that moves the tick count onto it. */
+            xTicksToLimit = xNextTaskUnblockTime - xTickCount;
+
+            if( xTicksToLimit != ( TickType_t ) 0 )
+            {
+                xTicksToLimit--;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xTicksToStep > xTicksToLimit )
+            {
+                xTicksToStep = xTicksToLimit;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xTickCount += xTicksToStep;
+            traceINCREASE_TICK_COUNT( xTicksToStep );
+        }
+        else
+        {
+            xTicksToStep = ( TickType_t ) 0;
+        }
+
+        return xTicksToStep;
+    }
+
+#endif /* configUSE_DYNAMIC_TICK */
+/*----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskAbortDelay == 1 )
+
+    BaseType_t xTaskAbortDelay( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB = xTask;
+        BaseType_t xReturn;
+
+        configASSERT( pxTCB );
+
+        vTaskSuspendAll();
+        {
+            /* A task can only be prematurely removed from the Blocked state if
+             * it is actually in the Blocked state. */
+            if( eTaskGetState( xTask ) == eBlocked )
+            {
+                xReturn = pdPASS;
+
+                /* Remove the reference to the task from the blocked list.  An
+                 * interrupt won't touch the xStateListItem because the
+                 * scheduler is suspended. */
+                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+                /* Is the task waiting on an event also?  If so remove it from
+                 * the event list too.  Interrupts can touch the event list item,
+                 * even though the scheduler is suspended, so a critical section
+                 * is used. */
+                taskENTER_CRITICAL();
+                {
+                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                    {
+                        ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+
+                        /* This lets the task know it was forcibly removed from the
+                         * blocked state so it should not re-evaluate its block time and
+                         * then block again. */
+                        pxTCB->ucDelayAborted = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                /* Place the unblocked task into the appropriate ready list. */
+                prvAddTaskToReadyList( pxTCB );
+
+                /* A task being unblocked cannot cause an immediate context
+                 * switch if preemption is turned off. */
+                #if ( configUSE_PREEMPTION == 1 )
+                {
+                    /* Preemption is on, but a context switch should only be
+                     * performed if the unblocked task has a priority that is
+                     * higher than the currently executing task. */
+                    if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
+                    {
+                        /* Pend the yield to be performed when the scheduler
+                         * is unsuspended. */
+                        xYieldPending = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_PREEMPTION */
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return xReturn;
+    }
+
+#endif /* INCLUDE_xTaskAbortDelay */
+/*----------------------------------------------------------*/
+
+BaseType_t xTaskIncrementTick( void )
+{
+    BaseType_t xSwitchRequired = pdFALSE;
+
+    /* Called by the portable layer each time a tick interrupt occurs.
+     * Increments the tick then checks to see if the new tick value will cause any
+     * tasks to be unblocked. */
+    traceTASK_INCREMENT_TICK( xTickCount );
+
+    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+    {
+        /* Minor optimisation.  The tick count cannot change in this
+         * block. */
+        const TickType_t xConstTickCount = xTickCount + ( TickType_t ) 1;
+
+        #if ( configTICK_UNBLOCK_LIMIT > 0 )
+        {
+            /* Tasks left due by the previous tick must be moved before the
+             * tick count moves on.  The port normally does that before the
+             * tick interrupt returns, so this only happens when several ticks
+             * are processed back to back, as when pended ticks are unwound. */
+            if( xTickUnblocksDeferred != pdFALSE )
+            {
+                if( prvUnblockDeferredTasks( taskUNBLOCK_ALL ) != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configTICK_UNBLOCK_LIMIT */
+
+        /* Increment the RTOS tick, switching the delayed and overflowed
+         * delayed lists if it wraps to 0. */
+        xTickCount = xConstTickCount;
+
+        if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+        {
+            taskSWITCH_DELAYED_LISTS();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* See if this tick has made a timeout expire.  Tasks are stored in
+         * the  queue in the order of their wake time - meaning once one task
+         * has been found whose block time has not expired there is no need to
+         * look any further down the list. */
+        if( xConstTickCount >= xNextTaskUnblockTime )
+        {
+            if( prvUnblockDueTasks( xConstTickCount, ( UBaseType_t ) configTICK_UNBLOCK_LIMIT ) != pdFALSE )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        /* Tasks of equal priority to the currently running task will share
+         * processing time (time slice) if preemption is on, and the application
+         * writer has not explicitly turned time slicing off. */
+        #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+        {
+            if( ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 ) &&
+                ( taskIS_EDF_PRIORITY( pxCurrentTCB->uxPriority ) == pdFALSE ) &&
+                ( taskHOLDS_PREEMPTION_THRESHOLD( pxCurrentTCB ) == pdFALSE ) )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
+
+        #if ( configUSE_TASK_BUDGETS == 1 )
+        {
+            if( prvBudgetEnforce() != pdFALSE )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TASK_BUDGETS */
+
+        #if ( configUSE_TICK_HOOK == 1 )
+        {
+            /* Guard against the tick hook being called when the pended tick
+             * count is being unwound (when the scheduler is being unlocked). */
+            if( xPendedTicks == ( TickType_t ) 0 )
+            {
+                vApplicationTickHook();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TICK_HOOK */
+
+        #if ( configUSE_PREEMPTION == 1 )
+        {
+            if( xYieldPending != pdFALSE )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_PREEMPTION */
+    }
+    else
+    {
+        ++xPendedTicks;
+
+        /* The tick hook gets called at regular intervals, even if the
+         * scheduler is locked. */
+        #if ( configUSE_TICK_HOOK == 1 )
+        {
+            vApplicationTickHook();
+        }
+        #endif
+    }
+
+    return xSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configTICK_UNBLOCK_LIMIT > 0 )
+
+    BaseType_t xTaskUnblockDeferred( BaseType_t * const pxSwitchRequired )
+    {
+        configASSERT( pxSwitchRequired != NULL );
+
+        if( xTickUnblocksDeferred != pdFALSE )
+        {
+            if( prvUnblockDeferredTasks( ( UBaseType_t ) configTICK_UNBLOCK_LIMIT ) != pdFALSE )
+            {
+                *pxSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* xTaskIncrementTick() checked for time slicing before these tasks
+             * were ready, so check again now that some of them may share the
+             * running task's priority. */
+            #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+            {
+                if( ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 ) &&
+                    ( taskIS_EDF_PRIORITY( pxCurrentTCB->uxPriority ) == pdFALSE ) &&
+                    ( taskHOLDS_PREEMPTION_THRESHOLD( pxCurrentTCB ) == pdFALSE ) )
+                {
+                    *pxSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
+
+            if( xTickUnblocksDeferred == pdFALSE )
+            {
+                /* The time at which the next task is due is known again. */
+                portUPDATE_TICK_INTERRUPT();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xTickUnblocksDeferred;
+    }
+
+#endif /* configTICK_UNBLOCK_LIMIT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    void vTaskSetApplicationTaskTag( TaskHandle_t xTask,
+                                     TaskHookFunction_t pxHookFunction )
+    {
+        TCB_t * xTCB;
+
+        /* If xTask is NULL then it is the task hook of the calling task that is
+         * getting set. */
+        if( xTask == NULL )
+        {
+            xTCB = ( TCB_t * ) pxCurrentTCB;
+        }
+        else
+        {
+            xTCB = xTask;
+        }
+
+        /* Save the hook function in the TCB.  A critical section is required as
+         * the value can be accessed from an interrupt. */
+        taskENTER_CRITICAL();
+        {
+            xTCB->pxTaskTag = pxHookFunction;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    TaskHookFunction_t xTaskGetApplicationTaskTag( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        TaskHookFunction_t xReturn;
+
+        /* If xTask is NULL then set the calling task's hook. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        /* Save the hook function in the TCB.  A critical section is required as
+         * the value can be accessed from an interrupt. */
+        taskENTER_CRITICAL();
+        {
+            xReturn = pxTCB->pxTaskTag;
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    TaskHookFunction_t xTaskGetApplicationTaskTagFromISR( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        TaskHookFunction_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+
+        /* If xTask is NULL then set the calling task's hook. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        /* Save the hook function in the TCB.  A critical section is required as
+         * the value can be accessed from an interrupt. */
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            xReturn = pxTCB->pxTaskTag;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
+                                             void * pvParameter )
+    {
+        TCB_t * xTCB;
+        BaseType_t xReturn;
+
+        /* If xTask is NULL then we are calling our own task hook. */
+        if( xTask == NULL )
+        {
+            xTCB = pxCurrentTCB;
+        }
+        else
+        {
+            xTCB = xTask;
+        }
+
+        if( xTCB->pxTaskTag != NULL )
+        {
+            xReturn = xTCB->pxTaskTag( pvParameter );
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+void vTaskSwitchContext( void )
+{
+    #if ( configUSE_TASK_BUDGETS == 1 )
+        BaseType_t xBudgetChanged;
+    #endif
+
+    if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+    {
+        /* The scheduler is currently suspended - do not allow a context
+         * switch. */
+        xYieldPending = pdTRUE;
+    }
+    else
+    {
+        xYieldPending = pdFALSE;
+        traceTASK_SWITCHED_OUT();
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        {
+            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
+            #else
+                ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+            #endif
+
+            /* Add the amount of time the task has been running to the
+             * accumulated time so far.  The time the task started running was
+             * stored in ulTaskSwitchedInTime.  Note that there is no overflow
+             * protection here so count values are only valid until the timer
+             * overflows.  The guard against negative values is to protect
+             * against suspect run time stat counter implementations - which
+             * are provided by the application, not the kernel. */
+            if( ulTotalRunTime > ulTaskSwitchedInTime )
+            {
+                pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            ulTaskSwitchedInTime = ulTotalRunTime;
+        }
+        #endif /* configGENERATE_RUN_TIME_STATS */
+
+        #if ( configUSE_TASK_BUDGETS == 1 )
+        {
+            /* Charge the task being switched out for the time it has run, and
+             * demote or block it if it has used up its budget. */
+            xBudgetChanged = prvBudgetEnforce();
+        }
+        #endif /* configUSE_TASK_BUDGETS */
+
+        /* Check for stack overflow, if configured. */
+        taskCHECK_FOR_STACK_OVERFLOW();
+
+        /* Before the currently running task is switched out, save its errno. */
+        #if ( configUSE_POSIX_ERRNO == 1 )
+        {
+            pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
+        }
+        #endif
+
+        #if ( configUSE_SHARED_STACKS == 1 )
+        {
+            /* A task on a shared stack that blocked between jobs, but was
+             * released again before it was switched out, still has a context
+             * that can be resumed. */
+            if( ( pxCurrentTCB->ucJobState == taskJOB_WAITING ) &&
+                ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ), &( pxCurrentTCB->xStateListItem ) ) != pdFALSE ) )
+            {
+                pxCurrentTCB->ucJobState = taskJOB_IDLE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_SHARED_STACKS */
+
+        /* Select a new task to run using either the generic C or port
+         * optimised asm code. */
+        #if ( configUSE_PREEMPTION_THRESHOLD == 1 )
+        {
+            prvSelectTaskWithThreshold();
+        }
+        #else
+        {
+            taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        }
+        #endif
+        traceTASK_SWITCHED_IN();
+
+        #if ( configUSE_SHARED_STACKS == 1 )
+        {
+            prvSharedStackPrepareTask( pxCurrentTCB );
+        }
+        #endif
+
+        #if ( ( configUSE_TASK_BUDGETS == 1 ) && ( configUSE_DYNAMIC_TICK == 1 ) )
+        {
+            /* A task that has a budget needs a tick interrupt on every tick
+             * so it can be stopped when the budget runs out. */
+            if( ( pxCurrentTCB->ulBudget != 0UL ) || ( xBudgetChanged != pdFALSE ) )
+            {
+                portUPDATE_TICK_INTERRUPT();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #elif ( configUSE_TASK_BUDGETS == 1 )
+        {
+            /* Only the dynamic tick needs to know if a task was demoted or
+             * blocked. */
+            ( void ) xBudgetChanged;
+        }
+        #endif
+
+        /* After the new task is switched in, update the global errno. */
+        #if ( configUSE_POSIX_ERRNO == 1 )
+        {
+            FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
+        }
+        #endif
+
+        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+        {
+            /* Switch C-Runtime's TLS Block to point to the TLS
+             * Block specific to this task. */
+            configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+        }
+        #endif
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnEventList( EventList_t * const pxEventList,
+                            const TickType_t xTicksToWait )
+{
+    configASSERT( pxEventList );
+
+    /* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
+     * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+
+    /* Place the event list item of the TCB in the appropriate event list.
+     * This is placed in the list in priority order so the highest priority task
+     * is the first to be woken by the event.
+     *
+     * Note: Lists are sorted in ascending order by ListItem_t.xItemValue.
+     * Normally, the xItemValue of a TCB's ListItem_t members is:
+     *      xItemValue = ( configMAX_PRIORITIES - uxPriority )
+     * Therefore, the event list is sorted in descending priority order.
+     *
+     * The queue that contains the event list is locked, preventing
+     * simultaneous access from interrupts. */
+    #if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+    {
+        /* Appending to the waiting list for the task's priority gives the
+         * same order as the sorted insertion, without walking the tasks
+         * that are already waiting. */
+        prvEventListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+    }
+    #else
+    {
+        vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+    }
+    #endif
+
+    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
+                                     const TickType_t xItemValue,
+                                     const TickType_t xTicksToWait )
+{
+    configASSERT( pxEventList );
+
+    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+     * the event groups implementation. */
+    configASSERT( uxSchedulerSuspended != 0 );
+
+    /* Store the item value in the event list item.  It is safe to access the
+     * event list item here as interrupts won't access the event list item of a
+     * task that is not in the Blocked state. */
+    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+    /* Place the event list item of the TCB at the end of the appropriate event
+     * list.  It is safe to access the event list here because it is part of an
+     * event group implementation - and interrupts don't access event groups
+     * directly (instead they access them indirectly by pending function calls to
+     * the task level). */
+    listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMERS == 1 )
+
+    void vTaskPlaceOnEventListRestricted( EventList_t * const pxEventList,
+                                          TickType_t xTicksToWait,
+                                          const BaseType_t xWaitIndefinitely )
+    {
+        configASSERT( pxEventList );
+
+        /* This function should not be called by application code hence the
+         * 'Restricted' in its name.  It is not part of the public API.  It is
+         * designed for use by kernel code, and has special calling requirements -
+         * it should be called with the scheduler suspended. */
+
+
+        /* Place the event list item of the TCB in the appropriate event list.
+         * In this case it is assume that this is the only task that is going to
+         * be waiting on this event list, so the faster vListInsertEnd() function
+         * can be used in place of vListInsert. */
+        #if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+        {
+            prvEventListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+        }
+        #else
+        {
+            listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+        }
+        #endif
+
+        /* If the task should block indefinitely then set the block time to a
+         * value that will be recognised as an indefinite delay inside the
+         * prvAddCurrentTaskToDelayedList() function. */
+        if( xWaitIndefinitely != pdFALSE )
+        {
+            xTicksToWait = portMAX_DELAY;
+        }
+
+        traceTASK_DELAY_UNTIL( ( xTickCount + xTicksToWait ) );
+        prvAddCurrentTaskToDelayedList( xTicksToWait, xWaitIndefinitely );
+    }
+
+#endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskRemoveFromEventList( EventList_t * const pxEventList )
+{
+    TCB_t * pxUnblockedTCB;
+    BaseType_t xReturn;
+
+    #if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+        List_t * pxWaitingList;
+    #endif
+
+    /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
+     * called from a critical section within an ISR. */
+
+    /* The event list is sorted in priority order, so the first in the list can
+     * be removed as it is known to be the highest priority.  Remove the TCB from
+     * the delayed list, and add it to the ready list.
+     *
+     * If an event is for a queue that is locked then this function will never
+     * get called - the lock count on the queue will get modified instead.  This
+     * means exclusive access to the event list is guaranteed here.
+     *
+     * This function assumes that a check has already been made to ensure that
+     * pxEventList is not empty. */
+    #if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+    {
+        /* The first task in the highest priority waiting list is the highest
+         * priority task that has waited longest. */
+        pxWaitingList = prvEventListGetHighestWaitingList( pxEventList );
+        configASSERT( pxWaitingList );
+        pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxWaitingList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        configASSERT( pxUnblockedTCB );
+        listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
+
+        if( listLIST_IS_EMPTY( pxWaitingList ) != pdFALSE )
+        {
+            pxEventList->uxWaitingPriorities &= ~( ( UBaseType_t ) 1U << ( UBaseType_t ) ( pxWaitingList - pxEventList->xWaitingLists ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #else /* if ( configUSE_PRIORITY_EVENT_LISTS == 1 ) */
+    {
+        pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        configASSERT( pxUnblockedTCB );
+        listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
+    }
+    #endif /* if ( configUSE_PRIORITY_EVENT_LISTS == 1 ) */
+
+    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+    {
+        listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+        prvAddTaskToReadyList( pxUnblockedTCB );
+
+        #if ( configUSE_TICKLESS_IDLE != 0 )
+        {
+            /* If a task is blocked on a kernel object then xNextTaskUnblockTime
+             * might be set to the blocked task's time out time.  If the task is
+             * unblocked for a reason other than a timeout xNextTaskUnblockTime is
+             * normally left unchanged, because it is automatically reset to a new
+             * value when the tick count equals xNextTaskUnblockTime.  However if
+             * tickless idling is used it might be more important to enter sleep mode
+             * at the earliest possible time - so reset xNextTaskUnblockTime here to
+             * ensure it is updated at the earliest possible time. */
+            prvResetNextTaskUnblockTime();
+        }
+        #endif
+    }
+    else
+    {
+        /* The delayed and ready lists cannot be accessed, so hold this task
+         * pending until the scheduler is resumed. */
+        listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+    }
+
+    if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) )
+    {
+        /* Return true if the task removed from the event list has a higher
+         * priority than the calling task.  This allows the calling task to know if
+         * it should force a context switch now. */
+        xReturn = pdTRUE;
+
+        /* Mark that a yield is pending in case the user is not using the
+         * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
+        xYieldPending = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
+                                        const TickType_t xItemValue )
+{
+    TCB_t * pxUnblockedTCB;
+
+    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+     * the event flags implementation. */
+    configASSERT( uxSchedulerSuspended != pdFALSE );
+
+    /* Store the new item value in the event list. */
+    listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+    /* Remove the event list form the event flag.  Interrupts do not access
+     * event flags. */
+    pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+    configASSERT( pxUnblockedTCB );
+    listREMOVE_ITEM( pxEventListItem );
+
+    #if ( configUSE_TICKLESS_IDLE != 0 )
+    {
+        /* If a task is blocked on a kernel object then xNextTaskUnblockTime
+         * might be set to the blocked task's time out time.  If the task is
+         * unblocked for a reason other than a timeout xNextTaskUnblockTime is
+         * normally left unchanged, because it is automatically reset to a new
+         * value when the tick count equals xNextTaskUnblockTime.  However if
+         * tickless idling is used it might be more important to enter sleep mode
+         * at the earliest possible time - so reset xNextTaskUnblockTime here to
+         * ensure it is updated at the earliest possible time. */
+        prvResetNextTaskUnblockTime();
+    }
+    #endif
+
+    /* Remove the task from the delayed list and add it to the ready list.  The
+     * scheduler is suspended so interrupts will not be accessing the ready
+     * lists. */
+    listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+    prvAddTaskToReadyList( pxUnblockedTCB );
+
+    if( taskPREEMPTS_CURRENT_TASK( pxUnblockedTCB ) )
+    {
+        /* The unblocked task has a priority above that of the calling task, so
+         * a context switch is required.  This function is called with the
+         * scheduler suspended so xYieldPending is set so the context switch
+         * occurs immediately that the scheduler is resumed (unsuspended). */
+        xYieldPending = pdTRUE;
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PRIORITY_EVENT_LISTS == 1 )
+
+/* Find the highest priority that has its bit set in a bit map of waiting
+ * priorities, using the same method as the ready task selection. */
+    #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+        #define taskGET_HIGHEST_WAITING_PRIORITY( uxTopPriority, uxWaitingPriorities )    ( uxTopPriority ) = prvGetHighestSetBit( ( uint32_t ) ( uxWaitingPriorities ) )
+    #else
+        #define taskGET_HIGHEST_WAITING_PRIORITY( uxTopPriority, uxWaitingPriorities )    portGET_HIGHEST_PRIORITY( uxTopPriority, uxWaitingPriorities )
+    #endif
+
+    void vTaskEventListInitialise( EventList_t * const pxEventList )
+    {
+        UBaseType_t uxPriority;
+
+        configASSERT( pxEventList );
+
+        for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+        {
+            vListInitialise( &( pxEventList->xWaitingLists[ uxPriority ] ) );
+        }
+
+        pxEventList->uxWaitingPriorities = ( UBaseType_t ) 0U;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTaskEventListIsEmpty( EventList_t * const pxEventList )
+    {
+        BaseType_t xReturn;
+
+        if( prvEventListGetHighestWaitingList( pxEventList ) == NULL )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxTaskEventListGetHighestPriority( EventList_t * const pxEventList )
+    {
+        List_t * const pxWaitingList = prvEventListGetHighestWaitingList( pxEventList );
+        UBaseType_t uxReturn;
+
+        if( pxWaitingList != NULL )
+        {
+            /* Use the item value, as the sorted event list does, so a change
+             * to the priority of the waiting task is seen in the same way. */
+            uxReturn = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxWaitingList );
+        }
+        else
+        {
+            uxReturn = tskIDLE_PRIORITY;
+        }
+
+        return uxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvEventListInsert( EventList_t * const pxEventList,
+                                    ListItem_t * const pxEventListItem )
+    {
+        const UBaseType_t uxPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_LIST_ITEM_VALUE( pxEventListItem );
+
+        /* The item value of an event list item that is not in use by an event
+         * group is always ( configMAX_PRIORITIES - uxPriority ). */
+        configASSERT( uxPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+        listINSERT_END( &( pxEventList->xWaitingLists[ uxPriority ] ), pxEventListItem );
+        pxEventList->uxWaitingPriorities |= ( UBaseType_t ) 1U << uxPriority;
+    }
+/*-----------------------------------------------------------*/
+
+    static List_t * prvEventListGetHighestWaitingList( EventList_t * const pxEventList )
+    {
+        List_t * pxWaitingList = NULL;
+        UBaseType_t uxPriority;
+
+        /* Tasks that time out, are deleted, are suspended or have their delay
+         * aborted are removed from their waiting list without the bit map
+         * being updated, as only their list item is known at that point.  A
+         * bit found set for an empty list is cleared here instead, so each
+         * stale bit is only skipped once. */
+        while( ( pxWaitingList == NULL ) && ( pxEventList->uxWaitingPriorities != ( UBaseType_t ) 0U ) )
+        {
+            taskGET_HIGHEST_WAITING_PRIORITY( uxPriority, pxEventList->uxWaitingPriorities );
+
+            if( listLIST_IS_EMPTY( &( pxEventList->xWaitingLists[ uxPriority ] ) ) == pdFALSE )
+            {
+                pxWaitingList = &( pxEventList->xWaitingLists[ uxPriority ] );
+            }
+            else
+            {
+                pxEventList->uxWaitingPriorities &= ~( ( UBaseType_t ) 1U << uxPriority );
+            }
+        }
+
+        return pxWaitingList;
+    }
+
+#endif /* configUSE_PRIORITY_EVENT_LISTS */
+/*-----------------------------------------------------------*/
+
+void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+    configASSERT( pxTimeOut );
+    taskENTER_CRITICAL();
+    {
+        pxTimeOut->xOverflowCount = xNumOfOverflows;
+        pxTimeOut->xTimeOnEntering = taskSYNCED_TICK_COUNT();
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+    /* For internal use only as it does not use a critical section. */
+    pxTimeOut->xOverflowCount = xNumOfOverflows;
+    pxTimeOut->xTimeOnEntering = taskSYNCED_TICK_COUNT();
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
+                                 TickType_t * const pxTicksToWait )
+{
+    BaseType_t xReturn;
+
+    configASSERT( pxTimeOut );
+    configASSERT( pxTicksToWait );
+
+    taskENTER_CRITICAL();
+    {
+        /* Minor optimisation.  The tick count cannot change in this block. */
+        const TickType_t xConstTickCount = taskSYNCED_TICK_COUNT();
+        const TickType_t xElapsedTime = xConstTickCount - pxTimeOut->xTimeOnEntering;
+
+        #if ( INCLUDE_xTaskAbortDelay == 1 )
+            if( pxCurrentTCB->ucDelayAborted != ( uint8_t ) pdFALSE )
+            {
+                /* The delay was aborted, which is not the same as a time out,
+                 * but has the same result. */
+                pxCurrentTCB->ucDelayAborted = pdFALSE;
+                xReturn = pdTRUE;
+            }
+            else
+        #endif
+
+        #if ( INCLUDE_vTaskSuspend == 1 )
+            if( *pxTicksToWait == portMAX_DELAY )
+            {
+                /* If INCLUDE_vTaskSuspend is set to 1 and the block time
+                 * specified is the maximum block time then the task should block
+                 * indefinitely, and therefore never time out. */
+                xReturn = pdFALSE;
+            }
+            else
+        #endif
+
+        if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
+        {
+            /* The tick count is greater than the time at which
+             * vTaskSetTimeout() was called, but has also overflowed since
+             * vTaskSetTimeOut() was called.  It must have wrapped all the way
+             * around and gone past again. This passed since vTaskSetTimeout()
+             * was called. */
+            xReturn = pdTRUE;
+            *pxTicksToWait = ( TickType_t ) 0;
+        }
+        else if( xElapsedTime < *pxTicksToWait ) /*lint !e961 Explicit casting is only redundant with some compilers, whereas others require it to prevent integer conversion errors. */
+        {
+            /* Not a genuine timeout. Adjust parameters for time remaining. */
+            *pxTicksToWait -= xElapsedTime;
+            vTaskInternalSetTimeOutState( pxTimeOut );
+            xReturn = pdFALSE;
+        }
+        else
+        {
+            *pxTicksToWait = ( TickType_t ) 0;
+            xReturn = pdTRUE;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
 
-        /* This function should not be called by application code hence the
-         * 'Restricted' in its name.  It is not part of the public API.  It is
-         * designed for use by kernel code, and has special calling requirements -
-         * it should be called with the scheduler suspended. */
+void vTaskMissedYield( void )
+{
+    xYieldPending = pdTRUE;
+}
+/*-----------------------------------------------------------*/
 
+#if ( configUSE_TRACE_FACILITY == 1 )
 
-        /* Place the event list item of the TCB in the appropriate event list.
-         * In this case it is assume that this is the only task that is going to
-         * be waiting on this event list, so the faster vListInsertEnd() function
-         * can be used in place of vListInsert. */
-        listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+    UBaseType_t uxTaskGetTaskNumber( TaskHandle_t xTask )
+    {
+        UBaseType_t uxReturn;
+        TCB_t const * pxTCB;
 
-        /* If the task should block indefinitely then set the block time to a
-         * value that will be recognised as an indefinite delay inside the
-         * prvAddCurrentTaskToDelayedList() function. */
-        if( xWaitIndefinitely != pdFALSE )
+        if( xTask != NULL )
         {
-            xTicksToWait = portMAX_DELAY;
+            pxTCB = xTask;
+            uxReturn = pxTCB->uxTaskNumber;
+        }
+        else
+        {
+            uxReturn = 0U;
         }
 
-        traceTASK_DELAY_UNTIL( ( xTickCount + xTicksToWait ) );
-        prvAddCurrentTaskToDelayedList( xTicksToWait, xWaitIndefinitely );
+        return uxReturn;
     }
 
-#endif /* configUSE_TIMERS */
+#endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
-{
-    TCB_t * pxUnblockedTCB;
-    BaseType_t xReturn;
-
-    /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
-     * called from a critical section within an ISR. */
-
-    /* The event list is sorted in priority order, so the first in the list can
-     * be removed as it is known to be the highest priority.  Remove the TCB from
-     * the delayed list, and add it to the ready list.
-     *
-     * If an event is for a queue that is locked then this function will never
-     * get called - the lock count on the queue will get modified instead.  This
-     * means exclusive access to the event list is guaranteed here.
-     *
-     * This function assumes that a check has already been made to ensure that
-     * pxEventList is not empty. */
-    pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-    configASSERT( pxUnblockedTCB );
-    listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
+#if ( configUSE_TRACE_FACILITY == 1 )
 
-    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+    void vTaskSetTaskNumber( TaskHandle_t xTask,
+                             const UBaseType_t uxHandle )
     {
-        listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
-        prvAddTaskToReadyList( pxUnblockedTCB );
+        TCB_t * pxTCB;
 
-        #if ( configUSE_TICKLESS_IDLE != 0 )
+        if( xTask != NULL )
         {
-            /* If a task is blocked on a kernel object then xNextTaskUnblockTime
-             * might be set to the blocked task's time out time.  If the task is
-             * unblocked for a reason other than a timeout xNextTaskUnblockTime is
-             * normally left unchanged, because it is automatically reset to a new
-             * value when the tick count equals xNextTaskUnblockTime.  However if
-             * tickless idling is used it might be more important to enter sleep mode
-             * at the earliest possible time - so reset xNextTaskUnblockTime here to
-             * ensure it is updated at the earliest possible time. */
-            prvResetNextTaskUnblockTime();
+            pxTCB = xTask;
+            pxTCB->uxTaskNumber = uxHandle;
         }
-        #endif
-    }
-    else
-    {
-        /* The delayed and ready lists cannot be accessed, so hold this task
-         * pending until the scheduler is resumed. */
-        listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
     }
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
-    {
-        /* Return true if the task removed from the event list has a higher
-         * priority than the calling task.  This allows the calling task to know if
-         * it should force a context switch now. */
-        xReturn = pdTRUE;
+#endif /* configUSE_TRACE_FACILITY */
 
-        /* Mark that a yield is pending in case the user is not using the
-         * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
-        xYieldPending = pdTRUE;
-    }
-    else
+/*
+ * -----------------------------------------------------------
+ * The Idle task.
+ * ----------------------------------------------------------
+ *
+ * The portTASK_FUNCTION() macro is used to allow port/compiler specific
+ * language extensions.  The equivalent prototype for this function is:
+ *
+ * void prvIdleTask( void *pvParameters );
+ *
+ */
+static portTASK_FUNCTION( prvIdleTask, pvParameters )
+{
+    /* Stop warnings. */
+    ( void ) pvParameters;
+
+    /** THIS IS THE RTOS IDLE TASK - WHICH IS CREATED AUTOMATICALLY WHEN THE
+     * SCHEDULER IS STARTED. **/
+
+    /* In case a task that has a secure context deletes itself, in which case
+     * the idle task is responsible for deleting the task's secure context, if
+     * any. */
+    portALLOCATE_SECURE_CONTEXT( configMINIMAL_SECURE_STACK_SIZE );
+
+    for( ; ; )
     {
-        xReturn = pdFALSE;
-    }
+        /* See if any tasks have deleted themselves - if so then the idle task
+         * is responsible for freeing the deleted task's TCB and stack. */
+        prvCheckTasksWaitingTermination();
 
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
+        #if ( configUSE_PREEMPTION == 0 )
+        {
+            /* If we are not using preemption we keep forcing a task switch to
+             * see if any other task has become available.  If we are using
+             * preemption we don't need to do this as any task becoming available
+             * will automatically get the processor anyway. */
+            taskYIELD();
+        }
+        #endif /* configUSE_PREEMPTION */
 
-void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
-                                        const TickType_t xItemValue )
-{
-    TCB_t * pxUnblockedTCB;
+        #if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+        {
+            /* When using preemption tasks of equal priority will be
+             * timesliced.  If a task that is sharing the idle priority is ready
+             * to run then the idle task should yield before the end of the
+             * timeslice.
+             *
+             * A critical region is not required here as we are just reading from
+             * the list, and an occasional incorrect value will not matter.  If
+             * the ready list at the idle priority contains more than one task
+             * then a task other than the idle task is ready to execute. */
+            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+            {
+                taskYIELD();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
 
-    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
-     * the event flags implementation. */
-    configASSERT( uxSchedulerSuspended != pdFALSE );
+        #if ( configUSE_IDLE_HOOK == 1 )
+        {
+            extern void vApplicationIdleHook( void );
 
-    /* Store the new item value in the event list. */
-    listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+            /* Call the user defined function from within the idle task.  This
+             * allows the application designer to add background functionality
+             * without the overhead of a separate task.
+             * NOTE: vApplicationIdleHook() MUST NOT, UNDER ANY CIRCUMSTANCES,
+             * CALL A FUNCTION THAT MIGHT BLOCK. */
+            vApplicationIdleHook();
+        }
+        #endif /* configUSE_IDLE_HOOK */
 
-    /* Remove the event list form the event flag.  Interrupts do not access
-     * event flags. */
-    pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-    configASSERT( pxUnblockedTCB );
-    listREMOVE_ITEM( pxEventListItem );
+        /* This conditional compilation should use inequality to 0, not equality
+         * to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
+         * user defined low power mode  implementations require
+         * configUSE_TICKLESS_IDLE to be set to a value other than 1. */
+        #if ( configUSE_TICKLESS_IDLE != 0 )
+        {
+            TickType_t xExpectedIdleTime;
 
-    #if ( configUSE_TICKLESS_IDLE != 0 )
-    {
-        /* If a task is blocked on a kernel object then xNextTaskUnblockTime
-         * might be set to the blocked task's time out time.  If the task is
-         * unblocked for a reason other than a timeout xNextTaskUnblockTime is
-         * normally left unchanged, because it is automatically reset to a new
-         * value when the tick count equals xNextTaskUnblockTime.  However if
-         * tickless idling is used it might be more important to enter sleep mode
-         * at the earliest possible time - so reset xNextTaskUnblockTime here to
-         * ensure it is updated at the earliest possible time. */
-        prvResetNextTaskUnblockTime();
-    }
-    #endif
+            /* It is not desirable to suspend then resume the scheduler on
+             * each iteration of the idle task.  Therefore, a preliminary
+             * test of the expected idle time is performed without the
+             * scheduler suspended.  The result here is not necessarily
+             * valid. */
+            xExpectedIdleTime = prvGetExpectedIdleTime();
 
-    /* Remove the task from the delayed list and add it to the ready list.  The
-     * scheduler is suspended so interrupts will not be accessing the ready
-     * lists. */
-    listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
-    prvAddTaskToReadyList( pxUnblockedTCB );
+            if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+            {
+                vTaskSuspendAll();
+                {
+                    /* Now the scheduler is suspended, the expected idle
+                     * time can be sampled again, and this time its value can
+                     * be used. */
+                    configASSERT( xNextTaskUnblockTime >= xTickCount );
+                    xExpectedIdleTime = prvGetExpectedIdleTime();
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
-    {
-        /* The unblocked task has a priority above that of the calling task, so
-         * a context switch is required.  This function is called with the
-         * scheduler suspended so xYieldPending is set so the context switch
-         * occurs immediately that the scheduler is resumed (unsuspended). */
-        xYieldPending = pdTRUE;
-    }
-}
-/*-----------------------------------------------------------*/
+                    /* Define the following macro to set xExpectedIdleTime to 0
+                     * if the application does not want
+                     * portSUPPRESS_TICKS_AND_SLEEP() to be called. */
+                    configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( xExpectedIdleTime );
 
-void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
-{
-    configASSERT( pxTimeOut );
-    taskENTER_CRITICAL();
-    {
-        pxTimeOut->xOverflowCount = xNumOfOverflows;
-        pxTimeOut->xTimeOnEntering = xTickCount;
+                    if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+                    {
+                        traceLOW_POWER_IDLE_BEGIN();
+                        portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
+                        traceLOW_POWER_IDLE_END();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                ( void ) xTaskResumeAll();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TICKLESS_IDLE */
     }
-    taskEXIT_CRITICAL();
-}
-/*-----------------------------------------------------------*/
-
-void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
-{
-    /* For internal use only as it does not use a critical section. */
-    pxTimeOut->xOverflowCount = xNumOfOverflows;
-    pxTimeOut->xTimeOnEntering = xTickCount;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
-                                 TickType_t * const pxTicksToWait )
-{
-    BaseType_t xReturn;
-
-    configASSERT( pxTimeOut );
-    configASSERT( pxTicksToWait );
+#if ( configUSE_TICKLESS_IDLE != 0 )
 
-    taskENTER_CRITICAL();
+    eSleepModeStatus eTaskConfirmSleepModeStatus( void )
     {
-        /* Minor optimisation.  The tick count cannot change in this block. */
-        const TickType_t xConstTickCount = xTickCount;
-        const TickType_t xElapsedTime = xConstTickCount - pxTimeOut->xTimeOnEntering;
+        #if ( INCLUDE_vTaskSuspend == 1 )
+            /* The idle task exists in addition to the application tasks. */
+            const UBaseType_t uxNonApplicationTasks = 1;
+        #endif /* INCLUDE_vTaskSuspend */
 
-        #if ( INCLUDE_xTaskAbortDelay == 1 )
-            if( pxCurrentTCB->ucDelayAborted != ( uint8_t ) pdFALSE )
-            {
-                /* The delay was aborted, which is not the same as a time out,
-                 * but has the same result. */
-                pxCurrentTCB->ucDelayAborted = pdFALSE;
-                xReturn = pdTRUE;
-            }
-            else
-        #endif
+        eSleepModeStatus eReturn = eStandardSleep;
 
-        #if ( INCLUDE_vTaskSuspend == 1 )
-            if( *pxTicksToWait == portMAX_DELAY )
-            {
-                /* If INCLUDE_vTaskSuspend is set to 1 and the block time
-                 * specified is the maximum block time then the task should block
-                 * indefinitely, and therefore never time out. */
-                xReturn = pdFALSE;
-            }
-            else
-        #endif
+        /* This function must be called from a critical section. */
 
-        if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
+        if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
         {
-            /* The tick count is greater than the time at which
-             * vTaskSetTimeout() was called, but has also overflowed since
-             * vTaskSetTimeOut() was called.  It must have wrapped all the way
-             * around and gone past again. This passed since vTaskSetTimeout()
-             * was called. */
-            xReturn = pdTRUE;
-            *pxTicksToWait = ( TickType_t ) 0;
+            /* A task was made ready while the scheduler was suspended. */
+            eReturn = eAbortSleep;
         }
-        else if( xElapsedTime < *pxTicksToWait ) /*lint !e961 Explicit casting is only redundant with some compilers, whereas others require it to prevent integer conversion errors. */
+        else if( xYieldPending != pdFALSE )
         {
-            /* Not a genuine timeout. Adjust parameters for time remaining. */
-            *pxTicksToWait -= xElapsedTime;
-            vTaskInternalSetTimeOutState( pxTimeOut );
-            xReturn = pdFALSE;
+            /* A yield was pended while the scheduler was suspended. */
+            eReturn = eAbortSleep;
+        }
+        else if( xPendedTicks != 0 )
+        {
+            /* A tick interrupt has already occurred but was held pending
+             * because the scheduler is suspended. */
+            eReturn = eAbortSleep;
         }
+
+        #if ( INCLUDE_vTaskSuspend == 1 )
+            else if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) )
+            {
+                /* If all the tasks are in the suspended list (which might mean they
+                 * have an infinite block time rather than actually being suspended)
+                 * then it is safe to turn all clocks off and just wait for external
+                 * interrupts. */
+                eReturn = eNoTasksWaitingTimeout;
+            }
+        #endif /* INCLUDE_vTaskSuspend */
         else
         {
-            *pxTicksToWait = ( TickType_t ) 0;
-            xReturn = pdTRUE;
+            mtCOVERAGE_TEST_MARKER();
         }
+
+        return eReturn;
     }
-    taskEXIT_CRITICAL();
 
-    return xReturn;
-}
+#endif /* configUSE_TICKLESS_IDLE */
 /*-----------------------------------------------------------*/
 
-void vTaskMissedYield( void )
-{
-    xYieldPending = pdTRUE;
-}
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+
+    void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet,
+                                            BaseType_t xIndex,
+                                            void * pvValue )
+    {
+        TCB_t * pxTCB;
+
+        if( ( xIndex >= 0 ) &&
+            ( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS ) )
+        {
+            pxTCB = prvGetTCBFromHandle( xTaskToSet );
+            configASSERT( pxTCB != NULL );
+            pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
+        }
+    }
+
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
 
-    UBaseType_t uxTaskGetTaskNumber( TaskHandle_t xTask )
+    void * pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery,
+                                               BaseType_t xIndex )
     {
-        UBaseType_t uxReturn;
-        TCB_t const * pxTCB;
+        void * pvReturn = NULL;
+        TCB_t * pxTCB;
 
-        if( xTask != NULL )
+        if( ( xIndex >= 0 ) &&
+            ( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS ) )
         {
-            pxTCB = xTask;
-            uxReturn = pxTCB->uxTaskNumber;
+            pxTCB = prvGetTCBFromHandle( xTaskToQuery );
+            pvReturn = pxTCB->pvThreadLocalStoragePointers[ xIndex ];
         }
         else
         {
-            uxReturn = 0U;
+            pvReturn = NULL;
         }
 
-        return uxReturn;
+        return pvReturn;
     }
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( portUSING_MPU_WRAPPERS == 1 )
 
-    void vTaskSetTaskNumber( TaskHandle_t xTask,
-                             const UBaseType_t uxHandle )
+    void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify,
+                                  const MemoryRegion_t * const xRegions )
     {
         TCB_t * pxTCB;
 
-        if( xTask != NULL )
+        /* If null is passed in here then we are modifying the MPU settings of
+         * the calling task. */
+        pxTCB = prvGetTCBFromHandle( xTaskToModify );
+
+        vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
+    }
+
+#endif /* portUSING_MPU_WRAPPERS */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseTaskLists( void )
+{
+    UBaseType_t uxPriority;
+
+    for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+    {
+        vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
+    }
+
+    #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+    {
+        UBaseType_t uxLevel, uxSlot;
+
+        for( uxLevel = ( UBaseType_t ) 0U; uxLevel < taskWHEEL_LEVELS; uxLevel++ )
         {
-            pxTCB = xTask;
-            pxTCB->uxTaskNumber = uxHandle;
+            for( uxSlot = ( UBaseType_t ) 0U; uxSlot < taskWHEEL_SLOTS; uxSlot++ )
+            {
+                vListInitialise( &( xDelayedTaskWheel[ uxLevel ][ uxSlot ] ) );
+            }
+
+            ulDelayedTaskWheelMap[ uxLevel ] = 0UL;
         }
     }
+    #else
+    {
+        vListInitialise( &xDelayedTaskList1 );
+        vListInitialise( &xDelayedTaskList2 );
+    }
+    #endif /* configUSE_DELAYED_TASK_WHEEL */
 
-#endif /* configUSE_TRACE_FACILITY */
+    vListInitialise( &xPendingReadyList );
 
-/*
- * -----------------------------------------------------------
- * The Idle task.
- * ----------------------------------------------------------
- *
- * The portTASK_FUNCTION() macro is used to allow port/compiler specific
- * language extensions.  The equivalent prototype for this function is:
- *
- * void prvIdleTask( void *pvParameters );
- *
- */
-static portTASK_FUNCTION( prvIdleTask, pvParameters )
+    #if ( configUSE_TASK_BUDGETS == 1 )
+    {
+        vListInitialise( &xBudgetedTaskList );
+    }
+    #endif /* configUSE_TASK_BUDGETS */
+
+    #if ( INCLUDE_vTaskDelete == 1 )
+    {
+        vListInitialise( &xTasksWaitingTermination );
+    }
+    #endif /* INCLUDE_vTaskDelete */
+
+    #if ( INCLUDE_vTaskSuspend == 1 )
+    {
+        vListInitialise( &xSuspendedTaskList );
+    }
+    #endif /* INCLUDE_vTaskSuspend */
+
+    #if ( configUSE_DELAYED_TASK_WHEEL == 0 )
+    {
+        /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
+         * using list2. */
+        pxDelayedTaskList = &xDelayedTaskList1;
+        pxOverflowDelayedTaskList = &xDelayedTaskList2;
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckTasksWaitingTermination( void )
 {
-    /* Stop warnings. */
-    ( void ) pvParameters;
+    /** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
 
-    /** THIS IS THE RTOS IDLE TASK - WHICH IS CREATED AUTOMATICALLY WHEN THE
-     * SCHEDULER IS STARTED. **/
+    #if ( INCLUDE_vTaskDelete == 1 )
+    {
+        TCB_t * pxTCB;
 
-    /* In case a task that has a secure context deletes itself, in which case
-     * the idle task is responsible for deleting the task's secure context, if
-     * any. */
-    portALLOCATE_SECURE_CONTEXT( configMINIMAL_SECURE_STACK_SIZE );
+        /* uxDeletedTasksWaitingCleanUp is used to prevent taskENTER_CRITICAL()
+         * being called too often in the idle task. */
+        while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+        {
+            taskENTER_CRITICAL();
+            {
+                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                --uxCurrentNumberOfTasks;
+                --uxDeletedTasksWaitingCleanUp;
+            }
+            taskEXIT_CRITICAL();
+
+            prvDeleteTCB( pxTCB );
+        }
+    }
+    #endif /* INCLUDE_vTaskDelete */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    void vTaskGetInfo( TaskHandle_t xTask,
+                       TaskStatus_t * pxTaskStatus,
+                       BaseType_t xGetFreeStackSpace,
+                       eTaskState eState )
+    {
+        TCB_t * pxTCB;
+
+        /* xTask is NULL then get the state of the calling task. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        pxTaskStatus->xHandle = ( TaskHandle_t ) pxTCB;
+        pxTaskStatus->pcTaskName = ( const char * ) &( pxTCB->pcTaskName[ 0 ] );
+        pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
+        pxTaskStatus->pxStackBase = pxTCB->pxStack;
+        #if ( ( portSTACK_GROWTH > 0 ) && ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
+            pxTaskStatus->pxTopOfStack = pxTCB->pxTopOfStack;
+            pxTaskStatus->pxEndOfStack = pxTCB->pxEndOfStack;
+        #endif
+        pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
 
-    for( ; ; )
-    {
-        /* See if any tasks have deleted themselves - if so then the idle task
-         * is responsible for freeing the deleted task's TCB and stack. */
-        prvCheckTasksWaitingTermination();
+        #if ( configUSE_MUTEXES == 1 )
+        {
+            pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
+        }
+        #else
+        {
+            pxTaskStatus->uxBasePriority = 0;
+        }
+        #endif
 
-        #if ( configUSE_PREEMPTION == 0 )
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
         {
-            /* If we are not using preemption we keep forcing a task switch to
-             * see if any other task has become available.  If we are using
-             * preemption we don't need to do this as any task becoming available
-             * will automatically get the processor anyway. */
-            taskYIELD();
+            pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
         }
-        #endif /* configUSE_PREEMPTION */
+        #else
+        {
+            pxTaskStatus->ulRunTimeCounter = ( configRUN_TIME_COUNTER_TYPE ) 0;
+        }
+        #endif
 
-        #if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+        /* Obtaining the task state is a little fiddly, so is only done if the
+         * value of eState passed into this function is eInvalid - otherwise the
+         * state is just set to whatever is passed in. */
+        if( eState != eInvalid )
         {
-            /* When using preemption tasks of equal priority will be
-             * timesliced.  If a task that is sharing the idle priority is ready
-             * to run then the idle task should yield before the end of the
-             * timeslice.
-             *
-             * A critical region is not required here as we are just reading from
-             * the list, and an occasional incorrect value will not matter.  If
-             * the ready list at the idle priority contains more than one task
-             * then a task other than the idle task is ready to execute. */
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+            if( pxTCB == pxCurrentTCB )
             {
-                taskYIELD();
+                pxTaskStatus->eCurrentState = eRunning;
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                pxTaskStatus->eCurrentState = eState;
+
+                #if ( INCLUDE_vTaskSuspend == 1 )
+                {
+                    /* If the task is in the suspended list then there is a
+                     *  chance it is actually just blocked indefinitely - so really
+                     *  it should be reported as being in the Blocked state. */
+                    if( eState == eSuspended )
+                    {
+                        vTaskSuspendAll();
+                        {
+                            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                            {
+                                pxTaskStatus->eCurrentState = eBlocked;
+                            }
+                        }
+                        ( void ) xTaskResumeAll();
+                    }
+                }
+                #endif /* INCLUDE_vTaskSuspend */
             }
         }
-        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
-
-        #if ( configUSE_IDLE_HOOK == 1 )
+        else
         {
-            extern void vApplicationIdleHook( void );
-
-            /* Call the user defined function from within the idle task.  This
-             * allows the application designer to add background functionality
-             * without the overhead of a separate task.
-             * NOTE: vApplicationIdleHook() MUST NOT, UNDER ANY CIRCUMSTANCES,
-             * CALL A FUNCTION THAT MIGHT BLOCK. */
-            vApplicationIdleHook();
+            pxTaskStatus->eCurrentState = eTaskGetState( pxTCB );
         }
-        #endif /* configUSE_IDLE_HOOK */
 
-        /* This conditional compilation should use inequality to 0, not equality
-         * to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
-         * user defined low power mode  implementations require
-         * configUSE_TICKLESS_IDLE to be set to a value other than 1. */
-        #if ( configUSE_TICKLESS_IDLE != 0 )
+        /* Obtaining the stack space takes some time, so the xGetFreeStackSpace
+         * parameter is provided to allow it to be skipped. */
+        if( xGetFreeStackSpace != pdFALSE )
         {
-            TickType_t xExpectedIdleTime;
-
-            /* It is not desirable to suspend then resume the scheduler on
-             * each iteration of the idle task.  Therefore, a preliminary
-             * test of the expected idle time is performed without the
-             * scheduler suspended.  The result here is not necessarily
-             * valid. */
-            xExpectedIdleTime = prvGetExpectedIdleTime();
-
-            if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+            #if ( portSTACK_GROWTH > 0 )
             {
-                vTaskSuspendAll();
-                {
-                    /* Now the scheduler is suspended, the expected idle
-                     * time can be sampled again, and this time its value can
-                     * be used. */
-                    configASSERT( xNextTaskUnblockTime >= xTickCount );
-                    xExpectedIdleTime = prvGetExpectedIdleTime();
-
-                    /* Define the following macro to set xExpectedIdleTime to 0
-                     * if the application does not want
-                     * portSUPPRESS_TICKS_AND_SLEEP() to be called. */
-                    configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( xExpectedIdleTime );
-
-                    if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
-                    {
-                        traceLOW_POWER_IDLE_BEGIN();
-                        portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
-                        traceLOW_POWER_IDLE_END();
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                ( void ) xTaskResumeAll();
+                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
             }
-            else
+            #else
             {
-                mtCOVERAGE_TEST_MARKER();
+                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
             }
+            #endif
+        }
+        else
+        {
+            pxTaskStatus->usStackHighWaterMark = 0;
         }
-        #endif /* configUSE_TICKLESS_IDLE */
     }
-}
+
+#endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TICKLESS_IDLE != 0 )
+#if ( configUSE_TRACE_FACILITY == 1 )
 
-    eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+    static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t * pxTaskStatusArray,
+                                                     List_t * pxList,
+                                                     eTaskState eState )
     {
-        #if ( INCLUDE_vTaskSuspend == 1 )
-            /* The idle task exists in addition to the application tasks. */
-            const UBaseType_t uxNonApplicationTasks = 1;
-        #endif /* INCLUDE_vTaskSuspend */
-
-        eSleepModeStatus eReturn = eStandardSleep;
-
-        /* This function must be called from a critical section. */
+        configLIST_VOLATILE TCB_t * pxNextTCB;
+        configLIST_VOLATILE TCB_t * pxFirstTCB;
+        UBaseType_t uxTask = 0;
 
-        if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
-        {
-            /* A task was made ready while the scheduler was suspended. */
-            eReturn = eAbortSleep;
-        }
-        else if( xYieldPending != pdFALSE )
-        {
-            /* A yield was pended while the scheduler was suspended. */
-            eReturn = eAbortSleep;
-        }
-        else if( xPendedTicks != 0 )
+        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
         {
-            /* A tick interrupt has already occurred but was held pending
-             * because the scheduler is suspended. */
-            eReturn = eAbortSleep;
-        }
+            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
-        #if ( INCLUDE_vTaskSuspend == 1 )
-            else if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) )
+            /* Populate an TaskStatus_t structure within the
+             * pxTaskStatusArray array for each task that is referenced from
+             * pxList.  See the definition of TaskStatus_t in task.h for the
+             * meaning of each TaskStatus_t structure member. */
+            do
             {
-                /* If all the tasks are in the suspended list (which might mean they
-                 * have an infinite block time rather than actually being suspended)
-                 * then it is safe to turn all clocks off and just wait for external
-                 * interrupts. */
-                eReturn = eNoTasksWaitingTimeout;
-            }
-        #endif /* INCLUDE_vTaskSuspend */
+                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
+                uxTask++;
+            } while( pxNextTCB != pxFirstTCB );
+        }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        return eReturn;
+        return uxTask;
     }
 
-#endif /* configUSE_TICKLESS_IDLE */
+#endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
 
-    void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet,
-                                            BaseType_t xIndex,
-                                            void * pvValue )
+    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+    {
+        uint32_t ulCount = 0U;
+
+        while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+        {
+            pucStackByte -= portSTACK_GROWTH;
+            ulCount++;
+        }
+
+        ulCount /= ( uint32_t ) sizeof( StackType_t ); /*lint !e961 Casting is not redundant on smaller architectures. */
+
+        return ( configSTACK_DEPTH_TYPE ) ulCount;
+    }
+
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
+
+/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are the
+ * same except for their return type.  Using configSTACK_DEPTH_TYPE allows the
+ * user to determine the return type.  It gets around the problem of the value
+ * overflowing on 8-bit types without breaking backward compatibility for
+ * applications that expect an 8-bit return type. */
+    configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
     {
         TCB_t * pxTCB;
+        uint8_t * pucEndOfStack;
+        configSTACK_DEPTH_TYPE uxReturn;
 
-        if( ( xIndex >= 0 ) &&
-            ( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS ) )
+        /* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are
+         * the same except for their return type.  Using configSTACK_DEPTH_TYPE
+         * allows the user to determine the return type.  It gets around the
+         * problem of the value overflowing on 8-bit types without breaking
+         * backward compatibility for applications that expect an 8-bit return
+         * type. */
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        #if portSTACK_GROWTH < 0
         {
-            pxTCB = prvGetTCBFromHandle( xTaskToSet );
-            configASSERT( pxTCB != NULL );
-            pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+        }
+        #else
+        {
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
         }
+        #endif
+
+        uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
+
+        return uxReturn;
     }
 
-#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
 /*-----------------------------------------------------------*/
 
-#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
 
-    void * pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery,
-                                               BaseType_t xIndex )
+    UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
     {
-        void * pvReturn = NULL;
         TCB_t * pxTCB;
+        uint8_t * pucEndOfStack;
+        UBaseType_t uxReturn;
 
-        if( ( xIndex >= 0 ) &&
-            ( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS ) )
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        #if portSTACK_GROWTH < 0
         {
-            pxTCB = prvGetTCBFromHandle( xTaskToQuery );
-            pvReturn = pxTCB->pvThreadLocalStoragePointers[ xIndex ];
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
         }
-        else
+        #else
         {
-            pvReturn = NULL;
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
         }
+        #endif
 
-        return pvReturn;
+        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+
+        return uxReturn;
     }
 
-#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
 /*-----------------------------------------------------------*/
 
-#if ( portUSING_MPU_WRAPPERS == 1 )
+#if ( INCLUDE_vTaskDelete == 1 )
 
-    void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify,
-                                  const MemoryRegion_t * const xRegions )
+    static void prvDeleteTCB( TCB_t * pxTCB )
     {
-        TCB_t * pxTCB;
+        /* This call is required specifically for the TriCore port.  It must be
+         * above the vPortFree() calls.  The call is also used by ports/demos that
+         * want to allocate and clean RAM statically. */
+        portCLEAN_UP_TCB( pxTCB );
 
-        /* If null is passed in here then we are modifying the MPU settings of
-         * the calling task. */
-        pxTCB = prvGetTCBFromHandle( xTaskToModify );
+        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+        {
+            /* Free up the memory allocated for the task's TLS Block. */
+            configDEINIT_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+        }
+        #endif
 
-        vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
+        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
+        {
+            /* The task can only have been allocated dynamically - free both
+             * the stack and TCB. */
+            vPortFreeStack( pxTCB->pxStack );
+            vPortFree( pxTCB );
+        }
+        #elif ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+        {
+            /* The task could have been allocated statically or dynamically, so
+             * check what was statically allocated before trying to free the
+             * memory. */
+            if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+            {
+                /* Both the stack and TCB were allocated dynamically, so both
+                 * must be freed. */
+                vPortFreeStack( pxTCB->pxStack );
+                vPortFree( pxTCB );
+            }
+            else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+            {
+                /* Only the stack was statically allocated, so the TCB is the
+                 * only memory that must be freed. */
+                vPortFree( pxTCB );
+            }
+            else
+            {
+                /* Neither the stack nor the TCB were allocated dynamically, so
+                 * nothing needs to be freed. */
+                configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB );
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
     }
 
-#endif /* portUSING_MPU_WRAPPERS */
+#endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
-static void prvInitialiseTaskLists( void )
+static void prvResetNextTaskUnblockTime( void )
 {
-    UBaseType_t uxPriority;
-
-    for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+    #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
     {
-        vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
+        xNextTaskUnblockTime = prvDelayedTaskWheelNextVisitTime( xTickCount );
     }
-
-    vListInitialise( &xDelayedTaskList1 );
-    vListInitialise( &xDelayedTaskList2 );
-    vListInitialise( &xPendingReadyList );
-
-    #if ( INCLUDE_vTaskDelete == 1 )
+    #else
     {
-        vListInitialise( &xTasksWaitingTermination );
+        if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+        {
+            /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+             * the maximum possible value so it is  extremely unlikely that the
+             * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+             * there is an item in the delayed list. */
+            xNextTaskUnblockTime = portMAX_DELAY;
+        }
+        else
+        {
+            /* The new current delayed list is not empty, get the value of
+             * the item at the head of the delayed list.  This is the time at
+             * which the task at the head of the delayed list should be removed
+             * from the Blocked state. */
+            xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        }
     }
-    #endif /* INCLUDE_vTaskDelete */
+    #endif /* configUSE_DELAYED_TASK_WHEEL */
 
-    #if ( INCLUDE_vTaskSuspend == 1 )
+    #if ( configTICK_UNBLOCK_LIMIT > 0 )
     {
-        vListInitialise( &xSuspendedTaskList );
+        if( xTickUnblocksDeferred != pdFALSE )
+        {
+            /* Tasks that are due are still waiting to be moved by
+             * xTaskUnblockDeferred(), which recalculates the time once they
+             * have been.  Until then the tick count must not be stepped past
+             * the time they are due at. */
+            xNextTaskUnblockTime = xTickCount;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
-    #endif /* INCLUDE_vTaskSuspend */
-
-    /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-     * using list2. */
-    pxDelayedTaskList = &xDelayedTaskList1;
-    pxOverflowDelayedTaskList = &xDelayedTaskList2;
+    #endif /* configTICK_UNBLOCK_LIMIT */
 }
 /*-----------------------------------------------------------*/
 
-static void prvCheckTasksWaitingTermination( void )
+static BaseType_t prvUnblockDueTasks( const TickType_t xTimeNow,
+                                      UBaseType_t uxUnblockLimit )
 {
-    /** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
+    BaseType_t xSwitchRequired = pdFALSE;
 
-    #if ( INCLUDE_vTaskDelete == 1 )
+    #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
     {
-        TCB_t * pxTCB;
-
-        /* uxDeletedTasksWaitingCleanUp is used to prevent taskENTER_CRITICAL()
-         * being called too often in the idle task. */
-        while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
-        {
-            taskENTER_CRITICAL();
-            {
-                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-                --uxCurrentNumberOfTasks;
-                --uxDeletedTasksWaitingCleanUp;
-            }
-            taskEXIT_CRITICAL();
-
-            prvDeleteTCB( pxTCB );
-        }
+        xSwitchRequired = prvDelayedTaskWheelAdvance( xTimeNow, uxUnblockLimit );
     }
-    #endif /* INCLUDE_vTaskDelete */
-}
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_TRACE_FACILITY == 1 )
-
-    void vTaskGetInfo( TaskHandle_t xTask,
-                       TaskStatus_t * pxTaskStatus,
-                       BaseType_t xGetFreeStackSpace,
-                       eTaskState eState )
+    #else /* configUSE_DELAYED_TASK_WHEEL */
     {
         TCB_t * pxTCB;
+        TickType_t xItemValue;
 
-        /* xTask is NULL then get the state of the calling task. */
-        pxTCB = prvGetTCBFromHandle( xTask );
-
-        pxTaskStatus->xHandle = ( TaskHandle_t ) pxTCB;
-        pxTaskStatus->pcTaskName = ( const char * ) &( pxTCB->pcTaskName[ 0 ] );
-        pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
-        pxTaskStatus->pxStackBase = pxTCB->pxStack;
-        #if ( ( portSTACK_GROWTH > 0 ) && ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
-            pxTaskStatus->pxTopOfStack = pxTCB->pxTopOfStack;
-            pxTaskStatus->pxEndOfStack = pxTCB->pxEndOfStack;
-        #endif
-        pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
-
-        #if ( configUSE_MUTEXES == 1 )
-        {
-            pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
-        }
-        #else
-        {
-            pxTaskStatus->uxBasePriority = 0;
-        }
-        #endif
-
-        #if ( configGENERATE_RUN_TIME_STATS == 1 )
-        {
-            pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
-        }
-        #else
+        #if ( configTICK_UNBLOCK_LIMIT == 0 )
         {
-            pxTaskStatus->ulRunTimeCounter = ( configRUN_TIME_COUNTER_TYPE ) 0;
+            ( void ) uxUnblockLimit;
         }
         #endif
 
-        /* Obtaining the task state is a little fiddly, so is only done if the
-         * value of eState passed into this function is eInvalid - otherwise the
-         * state is just set to whatever is passed in. */
-        if( eState != eInvalid )
+        /* Tasks are stored in the queue in the order of their wake time -
+         * meaning once one task has been found whose block time has not
+         * expired there is no need to look any further down the list. */
+        for( ; ; )
         {
-            if( pxTCB == pxCurrentTCB )
+            if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
             {
-                pxTaskStatus->eCurrentState = eRunning;
+                /* The delayed list is empty.  Set xNextTaskUnblockTime to the
+                 * maximum possible value so it is extremely unlikely that the
+                 * if( xTickCount >= xNextTaskUnblockTime ) test will pass next
+                 * time through. */
+                xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                break;
             }
             else
             {
-                pxTaskStatus->eCurrentState = eState;
+                /* The delayed list is not empty, get the value of the item at
+                 * the head of the delayed list.  This is the time at which the
+                 * task at the head of the delayed list must be removed from the
+                 * Blocked state. */
+                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+                if( xTimeNow < xItemValue )
+                {
+                    /* It is not time to unblock this item yet, but the item
+                     * value is the time at which the task at the head of the
+                     * blocked list must be removed from the Blocked state - so
+                     * record the item value in xNextTaskUnblockTime. */
+                    xNextTaskUnblockTime = xItemValue;
+                    break; /*lint !e9011 Code structure here is deemed easier to understand with multiple breaks. */
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-                #if ( INCLUDE_vTaskSuspend == 1 )
+                #if ( configTICK_UNBLOCK_LIMIT > 0 )
                 {
-                    /* If the task is in the suspended list then there is a
-                     *  chance it is actually just blocked indefinitely - so really
-                     *  it should be reported as being in the Blocked state. */
-                    if( eState == eSuspended )
+                    if( uxUnblockLimit == ( UBaseType_t ) 0U )
                     {
-                        vTaskSuspendAll();
-                        {
-                            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-                            {
-                                pxTaskStatus->eCurrentState = eBlocked;
-                            }
-                        }
-                        ( void ) xTaskResumeAll();
+                        /* Leave the rest for xTaskUnblockDeferred(), with the
+                         * time they are due at still recorded as reached. */
+                        xTickUnblocksDeferred = pdTRUE;
+                        xNextTaskUnblockTime = xTimeNow;
+                        break;
+                    }
+                    else
+                    {
+                        uxUnblockLimit--;
                     }
                 }
-                #endif /* INCLUDE_vTaskSuspend */
-            }
-        }
-        else
-        {
-            pxTaskStatus->eCurrentState = eTaskGetState( pxTCB );
-        }
+                #endif /* configTICK_UNBLOCK_LIMIT */
 
-        /* Obtaining the stack space takes some time, so the xGetFreeStackSpace
-         * parameter is provided to allow it to be skipped. */
-        if( xGetFreeStackSpace != pdFALSE )
-        {
-            #if ( portSTACK_GROWTH > 0 )
-            {
-                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
-            }
-            #else
-            {
-                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
-            }
-            #endif
-        }
-        else
-        {
-            pxTaskStatus->usStackHighWaterMark = 0;
+                /* It is time to remove the item from the Blocked state. */
+                listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+
+                /* Is the task waiting on an event also?  If so remove it from
+                 * the event list. */
+                if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                {
+                    listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Place the unblocked task into the appropriate ready list. */
+                prvAddTaskToReadyList( pxTCB );
+
+                /* A task being unblocked cannot cause an immediate context
+                 * switch if preemption is turned off. */
+                #if ( configUSE_PREEMPTION == 1 )
+                {
+                    /* Preemption is on, but a context switch should only be
+                     * performed if the unblocked task's priority is higher than
+                     * the currently executing task.
+                     * The case of equal priority tasks sharing processing time
+                     * (which happens when both preemption and time slicing are
+                     * on) is handled by the caller. */
+                    if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
+                    {
+                        xSwitchRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_PREEMPTION */
+            }
         }
     }
+    #endif /* configUSE_DELAYED_TASK_WHEEL */
 
-#endif /* configUSE_TRACE_FACILITY */
+    return xSwitchRequired;
+}
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configTICK_UNBLOCK_LIMIT > 0 )
 
-    static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t * pxTaskStatusArray,
-                                                     List_t * pxList,
-                                                     eTaskState eState )
+    static BaseType_t prvUnblockDeferredTasks( UBaseType_t uxUnblockLimit )
     {
-        configLIST_VOLATILE TCB_t * pxNextTCB;
-        configLIST_VOLATILE TCB_t * pxFirstTCB;
-        UBaseType_t uxTask = 0;
+        /* The tick count cannot have moved since the tasks were deferred, so
+         * they are still due at the current tick count. */
+        xTickUnblocksDeferred = pdFALSE;
 
-        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        return prvUnblockDueTasks( xTickCount, uxUnblockLimit );
+    }
+
+#endif /* configTICK_UNBLOCK_LIMIT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+    static UBaseType_t prvDelayedTaskWheelLowestSetBit( uint32_t ulBits )
+    {
+        /* Index of the least significant set bit of a non-zero value, found
+         * with a de Bruijn multiply so no CLZ/CTZ instruction is needed. */
+        static const uint8_t ucDeBruijnBitPosition[ 32 ] =
         {
-            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            0U,  1U,  28U, 2U,  29U, 14U, 24U, 3U,  30U, 22U, 20U, 15U, 25U, 17U, 4U,  8U,
+            31U, 27U, 13U, 23U, 21U, 19U, 16U, 7U,  26U, 12U, 18U, 6U,  11U, 5U,  10U, 9U
+        };
+        const uint32_t ulLowestBit = ulBits & ( ~ulBits + 1UL );
 
-            /* Populate an TaskStatus_t structure within the
-             * pxTaskStatusArray array for each task that is referenced from
-             * pxList.  See the definition of TaskStatus_t in task.h for the
-             * meaning of each TaskStatus_t structure member. */
-            do
-            {
-                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
-                uxTask++;
-            } while( pxNextTCB != pxFirstTCB );
-        }
-        else
+        return ( UBaseType_t ) ucDeBruijnBitPosition[ ( uint32_t ) ( ulLowestBit * 0x077CB531UL ) >> 27 ];
+    }
+/*-----------------------------------------------------------*/
+
+    static TickType_t prvDelayedTaskWheelSlotDelay( const UBaseType_t uxLevel,
+                                                    const UBaseType_t uxSlot,
+                                                    const TickType_t xTimeNow )
+    {
+        const UBaseType_t uxShift = uxLevel * taskWHEEL_SLOT_BITS;
+        const UBaseType_t uxLevelMask = taskWHEEL_LEVEL_MASK( uxLevel );
+        const TickType_t xCurrentBlock = xTimeNow >> uxShift;
+        UBaseType_t uxBlocksToGo;
+
+        /* A slot is visited when the tick count enters the block of
+         * ( 1 << uxShift ) ticks that the slot represents.  The slot matching
+         * the current block has already been visited, so is a full level
+         * revolution away. */
+        uxBlocksToGo = ( uxSlot - ( UBaseType_t ) xCurrentBlock ) & uxLevelMask;
+
+        if( uxBlocksToGo == ( UBaseType_t ) 0U )
         {
-            mtCOVERAGE_TEST_MARKER();
+            uxBlocksToGo = uxLevelMask + ( UBaseType_t ) 1U;
         }
 
-        return uxTask;
+        return ( TickType_t ) ( ( TickType_t ) ( xCurrentBlock + uxBlocksToGo ) << uxShift ) - xTimeNow;
     }
-
-#endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
-
-    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+    static TickType_t prvDelayedTaskWheelInsert( ListItem_t * const pxStateListItem,
+                                                 const TickType_t xTimeNow )
     {
-        uint32_t ulCount = 0U;
+        const TickType_t xTimeToWake = listGET_LIST_ITEM_VALUE( pxStateListItem );
+        TickType_t xDifference = xTimeToWake ^ xTimeNow;
+        UBaseType_t uxLevel = ( UBaseType_t ) 0U;
+        UBaseType_t uxSlot;
 
-        while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+        /* The task goes in the level of the most significant bit group in
+         * which its wake time differs from the current time.  A wake time equal
+         * to the current time goes in level 0, in the slot that is being
+         * processed. */
+        while( xDifference > ( TickType_t ) taskWHEEL_SLOT_MASK )
         {
-            pucStackByte -= portSTACK_GROWTH;
-            ulCount++;
+            xDifference >>= taskWHEEL_SLOT_BITS;
+            uxLevel++;
         }
 
-        ulCount /= ( uint32_t ) sizeof( StackType_t ); /*lint !e961 Casting is not redundant on smaller architectures. */
+        uxSlot = ( UBaseType_t ) ( xTimeToWake >> ( uxLevel * taskWHEEL_SLOT_BITS ) ) & taskWHEEL_SLOT_MASK;
 
-        return ( configSTACK_DEPTH_TYPE ) ulCount;
-    }
+        /* The slots are not sorted, so insertion does not depend on the number
+         * of tasks already in the Blocked state. */
+        listINSERT_END( &( xDelayedTaskWheel[ uxLevel ][ uxSlot ] ), pxStateListItem );
+        ulDelayedTaskWheelMap[ uxLevel ] |= ( uint32_t ) 1UL << uxSlot;
 
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
+        return prvDelayedTaskWheelSlotDelay( uxLevel, uxSlot, xTimeNow );
+    }
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
-
-/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are the
- * same except for their return type.  Using configSTACK_DEPTH_TYPE allows the
- * user to determine the return type.  It gets around the problem of the value
- * overflowing on 8-bit types without breaking backward compatibility for
- * applications that expect an 8-bit return type. */
-    configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
+    static TickType_t prvDelayedTaskWheelNextVisitTime( const TickType_t xTimeNow )
     {
-        TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
-        configSTACK_DEPTH_TYPE uxReturn;
-
-        /* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are
-         * the same except for their return type.  Using configSTACK_DEPTH_TYPE
-         * allows the user to determine the return type.  It gets around the
-         * problem of the value overflowing on 8-bit types without breaking
-         * backward compatibility for applications that expect an 8-bit return
-         * type. */
-
-        pxTCB = prvGetTCBFromHandle( xTask );
+        TickType_t xDelay, xShortestDelay = portMAX_DELAY;
+        TickType_t xNextVisitTime = portMAX_DELAY;
+        UBaseType_t uxLevel, uxLevelMask, uxFirstSlot, uxSlot;
+        uint32_t ulMap;
 
-        #if portSTACK_GROWTH < 0
-        {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
-        }
-        #else
+        for( uxLevel = ( UBaseType_t ) 0U; uxLevel < taskWHEEL_LEVELS; uxLevel++ )
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
-        }
-        #endif
+            uxLevelMask = taskWHEEL_LEVEL_MASK( uxLevel );
 
-        uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
+            /* The first slot of this level the tick count will reach. */
+            uxFirstSlot = ( ( UBaseType_t ) ( xTimeNow >> ( uxLevel * taskWHEEL_SLOT_BITS ) ) + ( UBaseType_t ) 1U ) & uxLevelMask;
 
-        return uxReturn;
-    }
+            while( ulDelayedTaskWheelMap[ uxLevel ] != 0UL )
+            {
+                /* Rotate the occupancy map so bit 0 represents uxFirstSlot, then
+                 * the lowest set bit is the next occupied slot to be visited. */
+                ulMap = ulDelayedTaskWheelMap[ uxLevel ];
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
-/*-----------------------------------------------------------*/
+                if( uxFirstSlot != ( UBaseType_t ) 0U )
+                {
+                    ulMap = ( ulMap >> uxFirstSlot ) | ( ulMap << ( ( uxLevelMask + ( UBaseType_t ) 1U ) - uxFirstSlot ) );
+                }
 
-#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+                uxSlot = ( prvDelayedTaskWheelLowestSetBit( ulMap ) + uxFirstSlot ) & uxLevelMask;
 
-    UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
-    {
-        TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
-        UBaseType_t uxReturn;
+                if( listLIST_IS_EMPTY( &( xDelayedTaskWheel[ uxLevel ][ uxSlot ] ) ) != pdFALSE )
+                {
+                    /* Tasks removed from the wheel by other kernel functions
+                     * leave their slot bit set, so clear it now. */
+                    ulDelayedTaskWheelMap[ uxLevel ] &= ~( ( uint32_t ) 1UL << uxSlot );
+                }
+                else
+                {
+                    xDelay = prvDelayedTaskWheelSlotDelay( uxLevel, uxSlot, xTimeNow );
 
-        pxTCB = prvGetTCBFromHandle( xTask );
+                    if( xDelay < xShortestDelay )
+                    {
+                        xShortestDelay = xDelay;
+                    }
 
-        #if portSTACK_GROWTH < 0
-        {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+                    break;
+                }
+            }
         }
-        #else
+
+        if( xShortestDelay != portMAX_DELAY )
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
-        }
-        #endif
+            xNextVisitTime = xTimeNow + xShortestDelay;
 
-        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+            if( xNextVisitTime < xTimeNow )
+            {
+                /* The visit is after the tick count overflows, at which point
+                 * taskSWITCH_DELAYED_LISTS() forces a visit anyway. */
+                xNextVisitTime = portMAX_DELAY;
+            }
+        }
 
-        return uxReturn;
+        return xNextVisitTime;
     }
-
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskDelete == 1 )
-
-    static void prvDeleteTCB( TCB_t * pxTCB )
+    static BaseType_t prvDelayedTaskWheelAdvance( const TickType_t xTimeNow,
+                                                  UBaseType_t uxMoveLimit )
     {
-        /* This call is required specifically for the TriCore port.  It must be
-         * above the vPortFree() calls.  The call is also used by ports/demos that
-         * want to allocate and clean RAM statically. */
-        portCLEAN_UP_TCB( pxTCB );
+        TCB_t * pxTCB;
+        List_t * pxSlot;
+        UBaseType_t uxLevel = ( UBaseType_t ) 0U;
+        UBaseType_t uxSlot;
+        BaseType_t xSwitchRequired = pdFALSE;
+        BaseType_t xLimitReached = pdFALSE;
 
-        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+        #if ( configTICK_UNBLOCK_LIMIT == 0 )
         {
-            /* Free up the memory allocated for the task's TLS Block. */
-            configDEINIT_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+            ( void ) uxMoveLimit;
         }
         #endif
 
-        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
+        /* Level n reaches a slot boundary when the lower n bit groups of the
+         * tick count are all zero. */
+        while( ( ( uxLevel + ( UBaseType_t ) 1U ) < taskWHEEL_LEVELS ) &&
+               ( ( ( UBaseType_t ) ( xTimeNow >> ( uxLevel * taskWHEEL_SLOT_BITS ) ) & taskWHEEL_SLOT_MASK ) == ( UBaseType_t ) 0U ) )
         {
-            /* The task can only have been allocated dynamically - free both
-             * the stack and TCB. */
-            vPortFreeStack( pxTCB->pxStack );
-            vPortFree( pxTCB );
+            uxLevel++;
         }
-        #elif ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+
+        /* Move the tasks in the slots that have been reached down the wheel,
+         * starting from the highest level so a task can move down several
+         * levels in one tick.  A task never goes back into the slot it came
+         * from, as its wake time now matches the tick count in that slot's bit
+         * group - which is also why stopping part way through and starting
+         * again with the same xTimeNow carries on where it stopped. */
+        for( ; ( uxLevel > ( UBaseType_t ) 0U ) && ( xLimitReached == pdFALSE ); uxLevel-- )
         {
-            /* The task could have been allocated statically or dynamically, so
-             * check what was statically allocated before trying to free the
-             * memory. */
-            if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+            uxSlot = ( UBaseType_t ) ( xTimeNow >> ( uxLevel * taskWHEEL_SLOT_BITS ) ) & taskWHEEL_SLOT_MASK;
+            pxSlot = &( xDelayedTaskWheel[ uxLevel ][ uxSlot ] );
+            ulDelayedTaskWheelMap[ uxLevel ] &= ~( ( uint32_t ) 1UL << uxSlot );
+
+            while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
             {
-                /* Both the stack and TCB were allocated dynamically, so both
-                 * must be freed. */
-                vPortFreeStack( pxTCB->pxStack );
-                vPortFree( pxTCB );
+                #if ( configTICK_UNBLOCK_LIMIT > 0 )
+                {
+                    if( uxMoveLimit == ( UBaseType_t ) 0U )
+                    {
+                        xLimitReached = pdTRUE;
+                        break;
+                    }
+                    else
+                    {
+                        uxMoveLimit--;
+                    }
+                }
+                #endif /* configTICK_UNBLOCK_LIMIT */
+
+                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                ( void ) prvDelayedTaskWheelInsert( &( pxTCB->xStateListItem ), xTimeNow );
             }
-            else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+        }
+
+        /* Every task now in the level 0 slot for this tick is due, unless its
+         * wake time is a whole number of tick count overflows away. */
+        uxSlot = ( UBaseType_t ) xTimeNow & taskWHEEL_SLOT_MASK;
+        pxSlot = &( xDelayedTaskWheel[ 0 ][ uxSlot ] );
+        ulDelayedTaskWheelMap[ 0 ] &= ~( ( uint32_t ) 1UL << uxSlot );
+
+        while( ( listLIST_IS_EMPTY( pxSlot ) == pdFALSE ) && ( xLimitReached == pdFALSE ) )
+        {
+            #if ( configTICK_UNBLOCK_LIMIT > 0 )
             {
-                /* Only the stack was statically allocated, so the TCB is the
-                 * only memory that must be freed. */
-                vPortFree( pxTCB );
+                if( uxMoveLimit == ( UBaseType_t ) 0U )
+                {
+                    xLimitReached = pdTRUE;
+                    break;
+                }
+                else
+                {
+                    uxMoveLimit--;
+                }
+            }
+            #endif /* configTICK_UNBLOCK_LIMIT */
+
+            pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+
+            if( listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) ) == xTimeNow )
+            {
+                /* Is the task waiting on an event also?  If so remove it from
+                 * the event list. */
+                if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                {
+                    listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                prvAddTaskToReadyList( pxTCB );
+
+                #if ( configUSE_PREEMPTION == 1 )
+                {
+                    if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
+                    {
+                        xSwitchRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_PREEMPTION */
             }
             else
             {
-                /* Neither the stack nor the TCB were allocated dynamically, so
-                 * nothing needs to be freed. */
-                configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB );
-                mtCOVERAGE_TEST_MARKER();
+                ( void ) prvDelayedTaskWheelInsert( &( pxTCB->xStateListItem ), xTimeNow );
             }
         }
-        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-    }
 
-#endif /* INCLUDE_vTaskDelete */
-/*-----------------------------------------------------------*/
+        if( xLimitReached == pdFALSE )
+        {
+            xNextTaskUnblockTime = prvDelayedTaskWheelNextVisitTime( xTimeNow );
+        }
+        else
+        {
+            #if ( configTICK_UNBLOCK_LIMIT > 0 )
+            {
+                /* Leave the rest for xTaskUnblockDeferred(), with the time
+                 * they are due at still recorded as reached. */
+                xTickUnblocksDeferred = pdTRUE;
+                xNextTaskUnblockTime = xTimeNow;
+            }
+            #endif
+        }
 
-static void prvResetNextTaskUnblockTime( void )
-{
-    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-    {
-        /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-         * the maximum possible value so it is  extremely unlikely that the
-         * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-         * there is an item in the delayed list. */
-        xNextTaskUnblockTime = portMAX_DELAY;
-    }
-    else
-    {
-        /* The new current delayed list is not empty, get the value of
-         * the item at the head of the delayed list.  This is the time at
-         * which the task at the head of the delayed list should be removed
-         * from the Blocked state. */
-        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+        return xSwitchRequired;
     }
-}
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
 /*-----------------------------------------------------------*/
 
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
@@ -4098,9 +6602,9 @@ static void prvResetNextTaskUnblockTime( void )
                     if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
                     {
                         /* It is known that the task is in its ready list so
-                         * there is no need to check again and the port level
+                         * there is no need to check again and the ready priority
                          * reset macro can be called directly. */
-                        portRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority, uxTopReadyPriority );
+                        taskCLEAR_READY_PRIORITY( pxMutexHolderTCB->uxPriority );
                     }
                     else
                     {
@@ -4183,7 +6687,7 @@ static void prvResetNextTaskUnblockTime( void )
                      * the holding task from the ready list. */
                     if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
                     {
-                        portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+                        taskCLEAR_READY_PRIORITY( pxTCB->uxPriority );
                     }
                     else
                     {
@@ -4303,9 +6807,9 @@ static void prvResetNextTaskUnblockTime( void )
                         if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
                         {
                             /* It is known that the task is in its ready list so
-                             * there is no need to check again and the port level
+                             * there is no need to check again and the ready priority
                              * reset macro can be called directly. */
-                            portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+                            taskCLEAR_READY_PRIORITY( pxTCB->uxPriority );
                         }
                         else
                         {
@@ -4338,6 +6842,46 @@ static void prvResetNextTaskUnblockTime( void )
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_CEILING_MUTEXES == 1 )
+
+    void vTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority )
+    {
+        TCB_t * const pxTCB = pxCurrentTCB;
+
+        /* A task whose own priority is above the ceiling could preempt the
+         * holder and then block on the mutex, which is exactly what the ceiling
+         * is there to prevent - the ceiling must be at least the priority of
+         * every task that takes the mutex. */
+        configASSERT( pxTCB->uxBasePriority <= uxCeilingPriority );
+
+        if( pxTCB->uxPriority < uxCeilingPriority )
+        {
+            /* The calling task is running so its event list item value cannot
+             * be in use for anything else, and it is in its ready list. */
+            listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxCeilingPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            {
+                taskCLEAR_READY_PRIORITY( pxTCB->uxPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceTASK_PRIORITY_INHERIT( pxTCB, uxCeilingPriority );
+            pxTCB->uxPriority = uxCeilingPriority;
+            prvAddTaskToReadyList( pxTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if ( portCRITICAL_NESTING_IN_TCB == 1 )
 
     void vTaskEnterCritical( void )
@@ -4680,10 +7224,24 @@ TickType_t uxTaskResetEventItemValue( void )
             ( pxCurrentTCB->uxMutexesHeld )++;
         }
 
-        return pxCurrentTCB;
+        return pxCurrentTCB;
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_LIGHTWEIGHT_MUTEXES == 1 )
+
+    void vTaskIncrementMutexHeldCountOf( TaskHandle_t xMutexHolder )
+    {
+        TCB_t * const pxTCB = xMutexHolder;
+
+        configASSERT( pxTCB );
+
+        ( pxTCB->uxMutexesHeld )++;
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* configUSE_LIGHTWEIGHT_MUTEXES */
 /*-----------------------------------------------------------*/
 
 #if ( configUSE_TASK_NOTIFICATIONS == 1 )
@@ -4915,6 +7473,21 @@ TickType_t uxTaskResetEventItemValue( void )
                     break;
             }
 
+            #if ( configUSE_WAITSETS == 1 )
+            {
+                if( prvNotifyWaitSet( pxTCB, uxIndexToNotify ) != pdFALSE )
+                {
+                    /* The task is blocked on its waitset rather than on this
+                     * index, so unblock it as if it were waiting here. */
+                    ucOriginalNotifyState = taskWAITING_NOTIFICATION;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+
             traceTASK_NOTIFY( uxIndexToNotify );
 
             /* If the task is in the blocked state specifically to wait for a
@@ -4943,7 +7516,7 @@ TickType_t uxTaskResetEventItemValue( void )
                 }
                 #endif
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5057,6 +7630,21 @@ TickType_t uxTaskResetEventItemValue( void )
                     break;
             }
 
+            #if ( configUSE_WAITSETS == 1 )
+            {
+                if( prvNotifyWaitSet( pxTCB, uxIndexToNotify ) != pdFALSE )
+                {
+                    /* The task is blocked on its waitset rather than on this
+                     * index, so unblock it as if it were waiting here. */
+                    ucOriginalNotifyState = taskWAITING_NOTIFICATION;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+
             traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify );
 
             /* If the task is in the blocked state specifically to wait for a
@@ -5078,7 +7666,7 @@ TickType_t uxTaskResetEventItemValue( void )
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5148,6 +7736,21 @@ TickType_t uxTaskResetEventItemValue( void )
              * semaphore. */
             ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 
+            #if ( configUSE_WAITSETS == 1 )
+            {
+                if( prvNotifyWaitSet( pxTCB, uxIndexToNotify ) != pdFALSE )
+                {
+                    /* The task is blocked on its waitset rather than on this
+                     * index, so unblock it as if it were waiting here. */
+                    ucOriginalNotifyState = taskWAITING_NOTIFICATION;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+
             traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify );
 
             /* If the task is in the blocked state specifically to wait for a
@@ -5169,7 +7772,7 @@ TickType_t uxTaskResetEventItemValue( void )
                     listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                if( taskPREEMPTS_CURRENT_TASK( pxTCB ) )
                 {
                     /* The notified task has a priority above the currently
                      * executing task so a yield is required. */
@@ -5242,19 +7845,259 @@ TickType_t uxTaskResetEventItemValue( void )
          * its notification state cleared. */
         pxTCB = prvGetTCBFromHandle( xTask );
 
+        /* Return the notification as it was before the bits were cleared,
+         * then clear the bit mask.  The notification value is only ever
+         * written as a whole, so an atomic AND is enough. */
+        ulReturn = Atomic_AND_u32( &( pxTCB->ulNotifiedValue[ uxIndexToClear ] ), ~ulBitsToClear );
+
+        return ulReturn;
+    }
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WAITSETS == 1 )
+
+    static BaseType_t prvNotifyWaitSet( TCB_t * const pxTCB,
+                                        UBaseType_t uxIndexToNotify )
+    {
+        const uint32_t ulBits = pxTCB->ulWaitSetBits[ uxIndexToNotify ];
+        BaseType_t xWaiting = pdFALSE;
+
+        if( ulBits != 0UL )
+        {
+            pxTCB->ulNotifiedValue[ configWAITSET_NOTIFICATION_INDEX ] |= ulBits;
+
+            if( pxTCB->ucNotifyState[ configWAITSET_NOTIFICATION_INDEX ] == taskWAITING_NOTIFICATION )
+            {
+                xWaiting = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxTCB->ucNotifyState[ configWAITSET_NOTIFICATION_INDEX ] = taskNOTIFICATION_RECEIVED;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xWaiting;
+    }
+
+#endif /* configUSE_WAITSETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WAITSETS == 1 )
+
+    BaseType_t xTaskSetWaitSetMember( TaskHandle_t xTask,
+                                      UBaseType_t uxIndexToWaitOn,
+                                      uint32_t ulBits )
+    {
+        TCB_t * const pxTCB = xTask;
+        BaseType_t xReturn = pdFAIL;
+        BaseType_t xPending = pdFALSE;
+
+        configASSERT( pxTCB );
+        configASSERT( uxIndexToWaitOn < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        configASSERT( uxIndexToWaitOn != configWAITSET_NOTIFICATION_INDEX );
+
         taskENTER_CRITICAL();
         {
-            /* Return the notification as it was before the bits were cleared,
-             * then clear the bit mask. */
-            ulReturn = pxTCB->ulNotifiedValue[ uxIndexToClear ];
-            pxTCB->ulNotifiedValue[ uxIndexToClear ] &= ~ulBitsToClear;
+            if( ulBits != 0UL )
+            {
+                if( pxTCB->ulWaitSetBits[ uxIndexToWaitOn ] == 0UL )
+                {
+                    pxTCB->ulWaitSetBits[ uxIndexToWaitOn ] = ulBits;
+
+                    /* A notification that arrived before the index was added
+                     * is posted now, so it is not missed. */
+                    if( pxTCB->ucNotifyState[ uxIndexToWaitOn ] == taskNOTIFICATION_RECEIVED )
+                    {
+                        xPending = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    /* The index is already a member. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                if( pxTCB->ulWaitSetBits[ uxIndexToWaitOn ] != 0UL )
+                {
+                    pxTCB->ulWaitSetBits[ uxIndexToWaitOn ] = 0UL;
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    /* The index is not a member. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            if( xPending != pdFALSE )
+            {
+                ( void ) xTaskGenericNotify( xTask, configWAITSET_NOTIFICATION_INDEX, ulBits, eSetBits, NULL );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
         taskEXIT_CRITICAL();
 
-        return ulReturn;
+        return xReturn;
     }
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
+#endif /* configUSE_WAITSETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_SB_TRIGGER_TIMEOUT == 1 )
+
+    BaseType_t xTaskLimitNotifyWaitTime( TaskHandle_t xTask,
+                                         TickType_t xTicksToWait )
+    {
+        TCB_t * const pxTCB = xTask;
+        List_t const * pxStateList;
+        TickType_t xConstTickCount, xTimeToWake;
+        BaseType_t xReturn = pdFALSE, xIsDelayed;
+
+        #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+            TickType_t xNextWheelVisitTime;
+        #endif
+
+        configASSERT( pxTCB );
+
+        /* An interrupt cannot move a task between the delayed lists while the
+         * scheduler is suspended, as the task that suspended it may be part way
+         * through changing them.  A task that has timed out but not yet run is
+         * still marked as waiting, but is no longer referenced from a Blocked
+         * list. */
+        if( ( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE ) &&
+            ( pxTCB->ucNotifyState[ tskDEFAULT_INDEX_TO_NOTIFY ] == taskWAITING_NOTIFICATION ) )
+        {
+            pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
+
+            #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+            {
+                xIsDelayed = ( taskLIST_IS_DELAYED_LIST( pxStateList ) ) ? pdTRUE : pdFALSE;
+            }
+            #else
+            {
+                xIsDelayed = ( ( pxStateList == pxDelayedTaskList ) || ( pxStateList == pxOverflowDelayedTaskList ) ) ? pdTRUE : pdFALSE;
+            }
+            #endif
+
+            #if ( configTICK_UNBLOCK_LIMIT > 0 )
+            {
+                /* Tasks that are already due may still be waiting to be moved,
+                 * and they cannot be told apart from tasks due a full tick
+                 * count period from now. */
+                if( xTickUnblocksDeferred != pdFALSE )
+                {
+                    xIsDelayed = pdFALSE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configTICK_UNBLOCK_LIMIT */
+
+            xConstTickCount = taskSYNCED_TICK_COUNT();
+            xTimeToWake = xConstTickCount + xTicksToWait;
+
+            if( ( xIsDelayed != pdFALSE ) &&
+                ( ( TickType_t ) ( listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) ) - xConstTickCount ) <= xTicksToWait ) )
+            {
+                /* The task already times out no later than requested. */
+                xReturn = pdTRUE;
+            }
+
+            #if ( INCLUDE_vTaskSuspend == 1 )
+                else if( ( xIsDelayed != pdFALSE ) || ( pxStateList == &xSuspendedTaskList ) )
+            #else
+                else if( xIsDelayed != pdFALSE )
+            #endif
+            {
+                /* Move the task from the list it is blocked on, which may be the
+                 * suspended list if it is blocked indefinitely, to the position
+                 * in the delayed task list or wheel for the new wake time.  Any
+                 * xNextTaskUnblockTime that is now early is corrected when it is
+                 * reached. */
+                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+                #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+                {
+                    if( xTimeToWake == xConstTickCount )
+                    {
+                        xTimeToWake++;
+                    }
+
+                    listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), xTimeToWake );
+                    xNextWheelVisitTime = xConstTickCount + prvDelayedTaskWheelInsert( &( pxTCB->xStateListItem ), xConstTickCount );
+
+                    if( ( xNextWheelVisitTime > xConstTickCount ) && ( xNextWheelVisitTime < xNextTaskUnblockTime ) )
+                    {
+                        xNextTaskUnblockTime = xNextWheelVisitTime;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #else /* configUSE_DELAYED_TASK_WHEEL */
+                {
+                    listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), xTimeToWake );
+
+                    if( xTimeToWake < xConstTickCount )
+                    {
+                        vListInsert( pxOverflowDelayedTaskList, &( pxTCB->xStateListItem ) );
+                    }
+                    else
+                    {
+                        vListInsert( pxDelayedTaskList, &( pxTCB->xStateListItem ) );
+
+                        if( xTimeToWake < xNextTaskUnblockTime )
+                        {
+                            xNextTaskUnblockTime = xTimeToWake;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+                #endif /* configUSE_DELAYED_TASK_WHEEL */
+
+                portUPDATE_TICK_INTERRUPT();
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                /* The task is not in the Blocked state. */
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_SB_TRIGGER_TIMEOUT */
 /*-----------------------------------------------------------*/
 
 #if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
@@ -5298,7 +8141,11 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                                             const BaseType_t xCanBlockIndefinitely )
 {
     TickType_t xTimeToWake;
-    const TickType_t xConstTickCount = xTickCount;
+    const TickType_t xConstTickCount = taskSYNCED_TICK_COUNT();
+
+    #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+        TickType_t xNextWheelVisitTime;
+    #endif
 
     #if ( INCLUDE_xTaskAbortDelay == 1 )
     {
@@ -5309,13 +8156,30 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
     }
     #endif
 
+    #if ( configUSE_SHARED_STACKS == 1 )
+    {
+        /* The job code of a task on a shared stack must run to completion, as
+         * other tasks use the stack once it blocks. */
+        configASSERT( pxCurrentTCB->ucJobState != taskJOB_RUNNING );
+
+        if( pxCurrentTCB->ucJobState == taskJOB_IDLE )
+        {
+            pxCurrentTCB->ucJobState = taskJOB_WAITING;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif
+
     /* Remove the task from the ready list before adding it to the blocked list
      * as the same list item is used for both lists. */
     if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
     {
         /* The current task must be in a ready list, so there is no need to
-         * check, and the port reset macro can be called directly. */
-        portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority ); /*lint !e931 pxCurrentTCB cannot change as it is the calling task.  pxCurrentTCB->uxPriority and uxTopReadyPriority cannot change as called with scheduler suspended or in a critical section. */
+         * check, and the ready priority clear macro can be called directly. */
+        taskCLEAR_READY_PRIORITY( pxCurrentTCB->uxPriority ); /*lint !e931 pxCurrentTCB cannot change as it is the calling task.  pxCurrentTCB->uxPriority and uxTopReadyPriority cannot change as called with scheduler suspended or in a critical section. */
     }
     else
     {
@@ -5338,33 +8202,60 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
              * kernel will manage it correctly. */
             xTimeToWake = xConstTickCount + xTicksToWait;
 
-            /* The list item will be inserted in wake time order. */
-            listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
-
-            if( xTimeToWake < xConstTickCount )
+            #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
             {
-                /* Wake time has overflowed.  Place this item in the overflow
-                 * list. */
-                vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                /* A zero block time wakes the task on the next tick, as it does
+                 * when the task is at the head of a sorted delayed list. */
+                if( xTimeToWake == xConstTickCount )
+                {
+                    xTimeToWake++;
+                }
+
+                listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
+                xNextWheelVisitTime = xConstTickCount + prvDelayedTaskWheelInsert( &( pxCurrentTCB->xStateListItem ), xConstTickCount );
+
+                /* Bring xNextTaskUnblockTime forward if the wheel slot used is
+                 * visited sooner, unless the visit is beyond a tick count overflow. */
+                if( ( xNextWheelVisitTime > xConstTickCount ) && ( xNextWheelVisitTime < xNextTaskUnblockTime ) )
+                {
+                    xNextTaskUnblockTime = xNextWheelVisitTime;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-            else
+            #else /* configUSE_DELAYED_TASK_WHEEL */
             {
-                /* The wake time has not overflowed, so the current block list
-                 * is used. */
-                vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                /* The list item will be inserted in wake time order. */
+                listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-                /* If the task entering the blocked state was placed at the
-                 * head of the list of blocked tasks then xNextTaskUnblockTime
-                 * needs to be updated too. */
-                if( xTimeToWake < xNextTaskUnblockTime )
+                if( xTimeToWake < xConstTickCount )
                 {
-                    xNextTaskUnblockTime = xTimeToWake;
+                    /* Wake time has overflowed.  Place this item in the overflow
+                     * list. */
+                    vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* The wake time has not overflowed, so the current block list
+                     * is used. */
+                    vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+                    /* If the task entering the blocked state was placed at the
+                     * head of the list of blocked tasks then xNextTaskUnblockTime
+                     * needs to be updated too. */
+                    if( xTimeToWake < xNextTaskUnblockTime )
+                    {
+                        xNextTaskUnblockTime = xTimeToWake;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
             }
+            #endif /* configUSE_DELAYED_TASK_WHEEL */
         }
     }
     #else /* INCLUDE_vTaskSuspend */
@@ -5374,36 +8265,67 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
          * will manage it correctly. */
         xTimeToWake = xConstTickCount + xTicksToWait;
 
-        /* The list item will be inserted in wake time order. */
-        listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
-
-        if( xTimeToWake < xConstTickCount )
+        #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
         {
-            /* Wake time has overflowed.  Place this item in the overflow list. */
-            vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            /* A zero block time wakes the task on the next tick, as it does
+             * when the task is at the head of a sorted delayed list. */
+            if( xTimeToWake == xConstTickCount )
+            {
+                xTimeToWake++;
+            }
+
+            listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
+            xNextWheelVisitTime = xConstTickCount + prvDelayedTaskWheelInsert( &( pxCurrentTCB->xStateListItem ), xConstTickCount );
+
+            /* Bring xNextTaskUnblockTime forward if the wheel slot used is
+             * visited sooner, unless the visit is beyond a tick count overflow. */
+            if( ( xNextWheelVisitTime > xConstTickCount ) && ( xNextWheelVisitTime < xNextTaskUnblockTime ) )
+            {
+                xNextTaskUnblockTime = xNextWheelVisitTime;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-        else
+        #else /* configUSE_DELAYED_TASK_WHEEL */
         {
-            /* The wake time has not overflowed, so the current block list is used. */
-            vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            /* The list item will be inserted in wake time order. */
+            listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-            /* If the task entering the blocked state was placed at the head of the
-             * list of blocked tasks then xNextTaskUnblockTime needs to be updated
-             * too. */
-            if( xTimeToWake < xNextTaskUnblockTime )
+            if( xTimeToWake < xConstTickCount )
             {
-                xNextTaskUnblockTime = xTimeToWake;
+                /* Wake time has overflowed.  Place this item in the overflow list. */
+                vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                /* The wake time has not overflowed, so the current block list is used. */
+                vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+                /* If the task entering the blocked state was placed at the head of the
+                 * list of blocked tasks then xNextTaskUnblockTime needs to be updated
+                 * too. */
+                if( xTimeToWake < xNextTaskUnblockTime )
+                {
+                    xNextTaskUnblockTime = xTimeToWake;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
         }
+        #endif /* configUSE_DELAYED_TASK_WHEEL */
 
         /* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
         ( void ) xCanBlockIndefinitely;
     }
     #endif /* INCLUDE_vTaskSuspend */
+
+    /* xNextTaskUnblockTime may have moved forward, and the task has left its
+     * ready list, so the time of the next tick interrupt may have changed. */
+    portUPDATE_TICK_INTERRUPT();
 }
 
 /* Code below here allows additional code to be inserted into this source file,
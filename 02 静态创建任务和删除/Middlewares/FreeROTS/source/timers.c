@@ -71,6 +71,26 @@
     #define tmrSTATUS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 0x02 )
     #define tmrSTATUS_IS_AUTORELOAD              ( ( uint8_t ) 0x04 )
 
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/* Dimensions of the timer wheel.  Level n of the wheel holds the timers whose
+ * expiry time first differs from xActiveTimerWheelTime in the n'th group of
+ * tmrWHEEL_SLOT_BITS bits, indexed by the value of that bit group in the
+ * expiry time.  Enough levels are used to cover every bit of TickType_t, so the
+ * top level may have fewer than tmrWHEEL_SLOTS usable slots. */
+        #if ( configUSE_16_BIT_TICKS == 1 )
+            #define tmrWHEEL_TICK_BITS    ( 16U )
+        #else
+            #define tmrWHEEL_TICK_BITS    ( 32U )
+        #endif
+
+        #define tmrWHEEL_SLOT_BITS        ( ( UBaseType_t ) configTIMER_WHEEL_SLOT_BITS )
+        #define tmrWHEEL_SLOTS            ( ( UBaseType_t ) 1U << tmrWHEEL_SLOT_BITS )
+        #define tmrWHEEL_SLOT_MASK        ( tmrWHEEL_SLOTS - ( UBaseType_t ) 1U )
+        #define tmrWHEEL_LEVELS           ( ( tmrWHEEL_TICK_BITS + configTIMER_WHEEL_SLOT_BITS - 1U ) / configTIMER_WHEEL_SLOT_BITS )
+
+    #endif /* configUSE_TIMER_WHEEL */
+
 /* The definition of the timers themselves. */
     typedef struct tmrTimerControl                  /* The old naming convention is used to prevent breaking kernel aware debuggers. */
     {
@@ -134,9 +154,20 @@
  * xActiveTimerList1 and xActiveTimerList2 could be at function scope but that
  * breaks some kernel aware debuggers, and debuggers that reply on removing the
  * static qualifier. */
-    PRIVILEGED_DATA static List_t xActiveTimerList1;
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/* With the timer wheel, active timers that expire before the tick count next
+ * overflows are held in the wheel instead of a sorted list.  Timers that expire
+ * after the overflow are still held in the sorted overflow list, which is
+ * moved into the wheel when the tick count overflows. */
+        PRIVILEGED_DATA static List_t xActiveTimerWheel[ tmrWHEEL_LEVELS ][ tmrWHEEL_SLOTS ]; /*< Active timers, unsorted within each slot. */
+        PRIVILEGED_DATA static uint32_t ulActiveTimerWheelMap[ tmrWHEEL_LEVELS ];               /*< Bit n is set if slot n of the level may hold a timer.  Bits are cleared lazily, so a set bit can refer to an empty slot. */
+        PRIVILEGED_DATA static TickType_t xActiveTimerWheelTime;                                /*< The time the wheel has been moved on to.  No timer in the wheel expires before it, and it is never ahead of the tick count. */
+    #else
+        PRIVILEGED_DATA static List_t xActiveTimerList1;
+        PRIVILEGED_DATA static List_t * pxCurrentTimerList;
+    #endif /* configUSE_TIMER_WHEEL */
     PRIVILEGED_DATA static List_t xActiveTimerList2;
-    PRIVILEGED_DATA static List_t * pxCurrentTimerList;
     PRIVILEGED_DATA static List_t * pxOverflowTimerList;
 
 /* A queue that is used to send commands to the timer service task. */
@@ -228,6 +259,29 @@
                                        void * const pvTimerID,
                                        TimerCallbackFunction_t pxCallbackFunction,
                                        Timer_t * pxNewTimer ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/*
+ * Insert a timer list item, the value of which is the expiry time of the
+ * timer, into the timer wheel slot chosen by comparing the expiry time with
+ * xActiveTimerWheelTime.  The expiry time must not be before
+ * xActiveTimerWheelTime.
+ */
+        static void prvTimerWheelInsert( ListItem_t * const pxTimerListItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move the timers in the wheel slots that start at or before xTimeNow down the
+ * wheel, then return the expire time of the timer that will expire first and
+ * set *pxWheelWasEmpty to pdFALSE.  If the first timer is still in a slot above
+ * level 0 then the start of that slot, which is after xTimeNow, is returned
+ * instead.  If the wheel does not contain any timers then return 0 and set
+ * *pxWheelWasEmpty to pdTRUE.
+ */
+        static TickType_t prvTimerWheelNextExpireTime( const TickType_t xTimeNow,
+                                                       BaseType_t * const pxWheelWasEmpty ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
     BaseType_t xTimerCreateTimerTask( void )
@@ -541,7 +595,13 @@
     static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
                                         const TickType_t xTimeNow )
     {
-        Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        #if ( configUSE_TIMER_WHEEL == 1 )
+            /* Every timer in a level 0 slot of the wheel has the same expiry
+             * time, so the slot is selected by the expiry time alone. */
+            Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( xActiveTimerWheel[ 0 ][ ( UBaseType_t ) xNextExpireTime & tmrWHEEL_SLOT_MASK ] ) ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        #else
+            Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        #endif
 
         /* Remove the timer from the list of active timers.  A check has already
          * been performed to ensure the list is not empty. */
@@ -622,7 +682,32 @@
                 if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
                 {
                     ( void ) xTaskResumeAll();
-                    prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+
+                    #if ( configUSE_TIMER_WHEEL == 1 )
+                    {
+                        TickType_t xExactExpireTime;
+
+                        /* xNextExpireTime can be the start of the wheel slot
+                         * that holds the next timer rather than the expiry time
+                         * of the timer itself.  Move the timers in the slots that
+                         * have now been reached down the wheel to find out if a
+                         * timer really has expired. */
+                        xExactExpireTime = prvTimerWheelNextExpireTime( xTimeNow, &xListWasEmpty );
+
+                        if( ( xListWasEmpty == pdFALSE ) && ( xExactExpireTime <= xTimeNow ) )
+                        {
+                            prvProcessExpiredTimer( xExactExpireTime, xTimeNow );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #else /* configUSE_TIMER_WHEEL */
+                    {
+                        prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+                    }
+                    #endif /* configUSE_TIMER_WHEEL */
                 }
                 else
                 {
@@ -674,17 +759,29 @@
          * this task to unblock when the tick count overflows, at which point the
          * timer lists will be switched and the next expiry time can be
          * re-assessed.  */
-        *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
-
-        if( *pxListWasEmpty == pdFALSE )
+        #if ( configUSE_TIMER_WHEEL == 1 )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            /* Passing the time the wheel has already been moved on to means
+             * no timers are moved, so this may return the start of a wheel slot
+             * rather than an expiry time.  That is never later than the expiry
+             * time, so the task still unblocks in time. */
+            xNextExpireTime = prvTimerWheelNextExpireTime( xActiveTimerWheelTime, pxListWasEmpty );
         }
-        else
+        #else /* configUSE_TIMER_WHEEL */
         {
-            /* Ensure the task unblocks when the tick count rolls over. */
-            xNextExpireTime = ( TickType_t ) 0U;
+            *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+
+            if( *pxListWasEmpty == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            }
+            else
+            {
+                /* Ensure the task unblocks when the tick count rolls over. */
+                xNextExpireTime = ( TickType_t ) 0U;
+            }
         }
+        #endif /* configUSE_TIMER_WHEEL */
 
         return xNextExpireTime;
     }
@@ -749,7 +846,15 @@
             }
             else
             {
-                vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                {
+                    prvTimerWheelInsert( &( pxTimer->xTimerListItem ) );
+                }
+                #else
+                {
+                    vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                }
+                #endif
             }
         }
 
@@ -905,29 +1010,70 @@
     }
 /*-----------------------------------------------------------*/
 
-    static void prvSwitchTimerLists( void )
-    {
-        TickType_t xNextExpireTime;
-        List_t * pxTemp;
+    #if ( configUSE_TIMER_WHEEL == 1 )
 
-        /* The tick count has overflowed.  The timer lists must be switched.
-         * If there are any timers still referenced from the current timer list
-         * then they must have expired and should be processed before the lists
-         * are switched. */
-        while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+        static void prvSwitchTimerLists( void )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            TickType_t xNextExpireTime;
+            BaseType_t xWheelWasEmpty;
+            ListItem_t * pxTimerListItem;
+
+            /* The tick count has overflowed.  If there are any timers still in
+             * the wheel then they must have expired and should be processed
+             * before the overflow list is moved into the wheel.  Passing the
+             * highest possible time moves every timer down to level 0, in expiry
+             * time order. */
+            xNextExpireTime = prvTimerWheelNextExpireTime( tmrMAX_TIME_BEFORE_OVERFLOW, &xWheelWasEmpty );
+
+            while( xWheelWasEmpty == pdFALSE )
+            {
+                /* Process the expired timer.  For auto-reload timers, be careful
+                 * to process only expirations that occur before the overflow.
+                 * Further expirations go into the overflow list. */
+                prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+                xNextExpireTime = prvTimerWheelNextExpireTime( tmrMAX_TIME_BEFORE_OVERFLOW, &xWheelWasEmpty );
+            }
+
+            /* The wheel is empty, so it can start again from the beginning of
+             * the new tick count epoch, holding the timers that were in the
+             * overflow list. */
+            xActiveTimerWheelTime = ( TickType_t ) 0U;
 
-            /* Process the expired timer.  For auto-reload timers, be careful to
-             * process only expirations that occur on the current list.  Further
-             * expirations must wait until after the lists are switched. */
-            prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+            while( listLIST_IS_EMPTY( pxOverflowTimerList ) == pdFALSE )
+            {
+                pxTimerListItem = listGET_HEAD_ENTRY( pxOverflowTimerList );
+                ( void ) uxListRemove( pxTimerListItem );
+                prvTimerWheelInsert( pxTimerListItem );
+            }
         }
 
-        pxTemp = pxCurrentTimerList;
-        pxCurrentTimerList = pxOverflowTimerList;
-        pxOverflowTimerList = pxTemp;
-    }
+    #else /* configUSE_TIMER_WHEEL */
+
+        static void prvSwitchTimerLists( void )
+        {
+            TickType_t xNextExpireTime;
+            List_t * pxTemp;
+
+            /* The tick count has overflowed.  The timer lists must be switched.
+             * If there are any timers still referenced from the current timer list
+             * then they must have expired and should be processed before the lists
+             * are switched. */
+            while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+
+                /* Process the expired timer.  For auto-reload timers, be careful to
+                 * process only expirations that occur on the current list.  Further
+                 * expirations must wait until after the lists are switched. */
+                prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+            }
+
+            pxTemp = pxCurrentTimerList;
+            pxCurrentTimerList = pxOverflowTimerList;
+            pxOverflowTimerList = pxTemp;
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
     static void prvCheckForValidListAndQueue( void )
@@ -939,9 +1085,30 @@
         {
             if( xTimerQueue == NULL )
             {
-                vListInitialise( &xActiveTimerList1 );
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                {
+                    UBaseType_t uxLevel, uxSlot;
+
+                    for( uxLevel = ( UBaseType_t ) 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+                    {
+                        for( uxSlot = ( UBaseType_t ) 0U; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+                        {
+                            vListInitialise( &( xActiveTimerWheel[ uxLevel ][ uxSlot ] ) );
+                        }
+
+                        ulActiveTimerWheelMap[ uxLevel ] = 0UL;
+                    }
+
+                    xActiveTimerWheelTime = ( TickType_t ) 0U;
+                }
+                #else
+                {
+                    vListInitialise( &xActiveTimerList1 );
+                    pxCurrentTimerList = &xActiveTimerList1;
+                }
+                #endif /* configUSE_TIMER_WHEEL */
+
                 vListInitialise( &xActiveTimerList2 );
-                pxCurrentTimerList = &xActiveTimerList1;
                 pxOverflowTimerList = &xActiveTimerList2;
 
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -981,6 +1148,140 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static UBaseType_t prvTimerWheelLowestSetBit( uint32_t ulBits )
+        {
+            /* Index of the least significant set bit of a non-zero value, found
+             * with a de Bruijn multiply so no CLZ/CTZ instruction is needed. */
+            static const uint8_t ucDeBruijnBitPosition[ 32 ] =
+            {
+                0U,  1U,  28U, 2U,  29U, 14U, 24U, 3U,  30U, 22U, 20U, 15U, 25U, 17U, 4U,  8U,
+                31U, 27U, 13U, 23U, 21U, 19U, 16U, 7U,  26U, 12U, 18U, 6U,  11U, 5U,  10U, 9U
+            };
+            const uint32_t ulLowestBit = ulBits & ( ~ulBits + 1UL );
+
+            return ( UBaseType_t ) ucDeBruijnBitPosition[ ( uint32_t ) ( ulLowestBit * 0x077CB531UL ) >> 27 ];
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvTimerWheelInsert( ListItem_t * const pxTimerListItem )
+        {
+            const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( pxTimerListItem );
+            TickType_t xDifference = xExpiryTime ^ xActiveTimerWheelTime;
+            UBaseType_t uxLevel = ( UBaseType_t ) 0U;
+            UBaseType_t uxSlot;
+
+            configASSERT( xExpiryTime >= xActiveTimerWheelTime );
+
+            /* The timer goes in the level of the most significant bit group in
+             * which its expiry time differs from the wheel time.  As the expiry
+             * time is not before the wheel time, its value in that bit group is
+             * greater, so a timer in a lower level always expires before a timer
+             * in a higher level, and within a level a lower slot always expires
+             * before a higher one. */
+            while( xDifference > ( TickType_t ) tmrWHEEL_SLOT_MASK )
+            {
+                xDifference >>= tmrWHEEL_SLOT_BITS;
+                uxLevel++;
+            }
+
+            uxSlot = ( UBaseType_t ) ( xExpiryTime >> ( uxLevel * tmrWHEEL_SLOT_BITS ) ) & tmrWHEEL_SLOT_MASK;
+
+            /* The slots are not sorted, so insertion does not depend on the
+             * number of active timers. */
+            listINSERT_END( &( xActiveTimerWheel[ uxLevel ][ uxSlot ] ), pxTimerListItem );
+            ulActiveTimerWheelMap[ uxLevel ] |= ( uint32_t ) 1UL << uxSlot;
+        }
+/*-----------------------------------------------------------*/
+
+        static TickType_t prvTimerWheelNextExpireTime( const TickType_t xTimeNow,
+                                                       BaseType_t * const pxWheelWasEmpty )
+        {
+            TickType_t xNextExpireTime = ( TickType_t ) 0U;
+            TickType_t xSlotStart;
+            List_t * pxSlot;
+            ListItem_t * pxTimerListItem;
+            UBaseType_t uxLevel = ( UBaseType_t ) 0U;
+            UBaseType_t uxSlot, uxShift;
+
+            *pxWheelWasEmpty = pdTRUE;
+
+            while( uxLevel < tmrWHEEL_LEVELS )
+            {
+                if( ulActiveTimerWheelMap[ uxLevel ] == 0UL )
+                {
+                    uxLevel++;
+                }
+                else
+                {
+                    /* The lowest occupied level and slot hold the timer that
+                     * will expire first - see prvTimerWheelInsert(). */
+                    uxSlot = prvTimerWheelLowestSetBit( ulActiveTimerWheelMap[ uxLevel ] );
+                    pxSlot = &( xActiveTimerWheel[ uxLevel ][ uxSlot ] );
+
+                    if( listLIST_IS_EMPTY( pxSlot ) != pdFALSE )
+                    {
+                        /* Timers removed from the wheel by a stop, reset or
+                         * delete command leave their slot bit set, so clear it
+                         * now. */
+                        ulActiveTimerWheelMap[ uxLevel ] &= ~( ( uint32_t ) 1UL << uxSlot );
+                    }
+                    else if( uxLevel == ( UBaseType_t ) 0U )
+                    {
+                        /* Every timer in a level 0 slot has the same expiry
+                         * time. */
+                        xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxSlot );
+                        *pxWheelWasEmpty = pdFALSE;
+                        break;
+                    }
+                    else
+                    {
+                        /* The first time covered by the slot, which has the
+                         * wheel time's value in every higher bit group. */
+                        uxShift = uxLevel * tmrWHEEL_SLOT_BITS;
+                        xSlotStart = ( TickType_t ) ( ( ( xActiveTimerWheelTime >> uxShift ) & ~( ( TickType_t ) tmrWHEEL_SLOT_MASK ) ) | ( TickType_t ) uxSlot ) << uxShift;
+
+                        if( xSlotStart <= xTimeNow )
+                        {
+                            /* Move the wheel time on to the start of the slot
+                             * and the timers in the slot down the wheel.  The
+                             * placement of the timers in higher slots and levels
+                             * does not change, as the wheel time only changes in
+                             * the bit groups below them.  The search then starts
+                             * again from level 0.  A timer only ever moves down,
+                             * so it is moved at most tmrWHEEL_LEVELS - 1 times
+                             * however long it is active. */
+                            xActiveTimerWheelTime = xSlotStart;
+                            ulActiveTimerWheelMap[ uxLevel ] &= ~( ( uint32_t ) 1UL << uxSlot );
+
+                            while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+                            {
+                                pxTimerListItem = listGET_HEAD_ENTRY( pxSlot );
+                                ( void ) uxListRemove( pxTimerListItem );
+                                prvTimerWheelInsert( pxTimerListItem );
+                            }
+
+                            uxLevel = ( UBaseType_t ) 0U;
+                        }
+                        else
+                        {
+                            /* No timer in the slot can expire before its
+                             * start. */
+                            xNextExpireTime = xSlotStart;
+                            *pxWheelWasEmpty = pdFALSE;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            return xNextExpireTime;
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
     BaseType_t xTimerIsTimerActive( TimerHandle_t xTimer )
     {
         BaseType_t xReturn;
@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2026 Freerots_Learning_Projects contributors.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+#include "event_groups.h"
+#include "waitset.h"
+
+/* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e9021 !e961 !e750. */
+
+
+/* This entire source file will be skipped if the application is not configured
+ * to include waitsets.  This #if is closed at the very bottom of this file.  If
+ * you want to include waitsets then ensure configUSE_WAITSETS is set to 1 in
+ * FreeRTOSConfig.h. */
+#if ( configUSE_WAITSETS == 1 )
+
+/*
+ * A waitset holds no state of its own beyond its owner.  Each member records
+ * the owner and its bits, and posts the bits straight to the owner's
+ * notification at index configWAITSET_NOTIFICATION_INDEX with eSetBits, so the
+ * notification value is the readiness bitmap.  Posting is one notification
+ * whatever the number of members, waiting is one notification wait, and the
+ * wait returns and clears the whole bitmap at once.  Notification indexes of
+ * the owner are members through its TCB, which posts the bits from the
+ * xTaskNotify...() functions themselves.
+ */
+
+/*-----------------------------------------------------------*/
+
+    WaitSetHandle_t xWaitSetCreateStatic( TaskHandle_t xOwner,
+                                          WaitSet_t * pxWaitSetBuffer )
+    {
+        WaitSet_t * pxReturn = NULL;
+
+        configASSERT( pxWaitSetBuffer != NULL );
+
+        if( pxWaitSetBuffer != NULL )
+        {
+            if( xOwner == NULL )
+            {
+                xOwner = xTaskGetCurrentTaskHandle();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            configASSERT( xOwner );
+
+            pxWaitSetBuffer->xOwner = xOwner;
+            pxReturn = pxWaitSetBuffer;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        WaitSetHandle_t xWaitSetCreate( TaskHandle_t xOwner )
+        {
+            WaitSet_t * pxReturn = NULL;
+            WaitSet_t * pxAllocation;
+
+            pxAllocation = ( WaitSet_t * ) pvPortMalloc( sizeof( WaitSet_t ) ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned for any type. */
+
+            if( pxAllocation != NULL )
+            {
+                pxReturn = xWaitSetCreateStatic( xOwner, pxAllocation );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return pxReturn;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWaitSetAddQueue( WaitSetHandle_t xWaitSet,
+                                 QueueSetMemberHandle_t xQueueOrSemaphore,
+                                 uint32_t ulBits )
+    {
+        configASSERT( xWaitSet );
+        configASSERT( ulBits != 0UL );
+
+        return xQueueSetWaitSetMember( xQueueOrSemaphore, xWaitSet->xOwner, ulBits );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWaitSetRemoveQueue( WaitSetHandle_t xWaitSet,
+                                    QueueSetMemberHandle_t xQueueOrSemaphore )
+    {
+        configASSERT( xWaitSet );
+
+        return xQueueSetWaitSetMember( xQueueOrSemaphore, xWaitSet->xOwner, 0UL );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWaitSetAddStreamBuffer( WaitSetHandle_t xWaitSet,
+                                        StreamBufferHandle_t xStreamBuffer,
+                                        uint32_t ulBits )
+    {
+        configASSERT( xWaitSet );
+        configASSERT( ulBits != 0UL );
+
+        return xStreamBufferSetWaitSetMember( xStreamBuffer, xWaitSet->xOwner, ulBits );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWaitSetRemoveStreamBuffer( WaitSetHandle_t xWaitSet,
+                                           StreamBufferHandle_t xStreamBuffer )
+    {
+        configASSERT( xWaitSet );
+
+        return xStreamBufferSetWaitSetMember( xStreamBuffer, xWaitSet->xOwner, 0UL );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWaitSetAddEventGroup( WaitSetHandle_t xWaitSet,
+                                      EventGroupHandle_t xEventGroup,
+                                      const EventBits_t uxBitsToWaitFor,
+                                      uint32_t ulBits )
+    {
+        configASSERT( xWaitSet );
+        configASSERT( ulBits != 0UL );
+
+        return xEventGroupSetWaitSetMember( xEventGroup, uxBitsToWaitFor, xWaitSet->xOwner, ulBits );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWaitSetRemoveEventGroup( WaitSetHandle_t xWaitSet,
+                                         EventGroupHandle_t xEventGroup )
+    {
+        configASSERT( xWaitSet );
+
+        return xEventGroupSetWaitSetMember( xEventGroup, 0, xWaitSet->xOwner, 0UL );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWaitSetAddNotification( WaitSetHandle_t xWaitSet,
+                                        UBaseType_t uxIndexToWaitOn,
+                                        uint32_t ulBits )
+    {
+        configASSERT( xWaitSet );
+        configASSERT( ulBits != 0UL );
+
+        return xTaskSetWaitSetMember( xWaitSet->xOwner, uxIndexToWaitOn, ulBits );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xWaitSetRemoveNotification( WaitSetHandle_t xWaitSet,
+                                           UBaseType_t uxIndexToWaitOn )
+    {
+        configASSERT( xWaitSet );
+
+        return xTaskSetWaitSetMember( xWaitSet->xOwner, uxIndexToWaitOn, 0UL );
+    }
+/*-----------------------------------------------------------*/
+
+    uint32_t ulWaitSetWait( WaitSetHandle_t xWaitSet,
+                            TickType_t xTicksToWait )
+    {
+        uint32_t ulReady = 0UL;
+
+        configASSERT( xWaitSet );
+        configASSERT( xWaitSet->xOwner == xTaskGetCurrentTaskHandle() );
+
+        /* Every bit is cleared on exit, in the same critical section in which
+         * the value is read, so a post that arrives after this call returns is
+         * kept for the next call. */
+        if( xTaskNotifyWaitIndexed( configWAITSET_NOTIFICATION_INDEX, 0UL, 0xffffffffUL, &ulReady, xTicksToWait ) == pdFALSE )
+        {
+            ulReady = 0UL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return ulReady;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include waitsets.  If you want to include waitsets then ensure
+ * configUSE_WAITSETS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_WAITSETS == 1 */
@@ -12,29 +12,94 @@ void Start_Task(void *pvParameters);                 // 启动任务函数声明
 #define TASK1_PRIORITY 1
 #define TASK1_STACK_SIZE 128
 TaskHandle_t task1_handler;
+#if !configUSE_CYCLIC_EXECUTIVE
+#if !configUSE_SHARED_STACKS
 StackType_t task1_stack[TASK1_STACK_SIZE];
+#endif
 StaticTask_t task1_tcb;
+#endif
 void vTask1(void *pvParameters);
 
 /* 任务2（LED2 翻转）配置 */
 #define TASK2_PRIORITY 2
 #define TASK2_STACK_SIZE 128
 TaskHandle_t task2_handler;
+#if !configUSE_CYCLIC_EXECUTIVE
+#if !configUSE_SHARED_STACKS
 StackType_t task2_stack[TASK2_STACK_SIZE];
+#endif
 StaticTask_t task2_tcb;
+#endif
 void vTask2(void *pvParameters);
 
 /* 任务3（打印时钟）配置 */
 #define TASK3_PRIORITY 3
 #define TASK3_STACK_SIZE 128
 TaskHandle_t task3_handler;
+#if !configUSE_CYCLIC_EXECUTIVE
+#if !configUSE_SHARED_STACKS
 StackType_t task3_stack[TASK3_STACK_SIZE];
+#endif
 StaticTask_t task3_tcb;
+#endif
 void vTask3(void *pvParameters);
 
+#if configUSE_CYCLIC_EXECUTIVE
+/* 循环执行器配置 - 任务1~3的工作改为静态调度表中的函数, 由一个执行器任务按帧依次调用, 不再各自占用任务和栈 */
+#define CYCLIC_TASK_PRIORITY 4                                      // 执行器任务优先级, 独占最高优先级以保证各帧准时开始
+#define CYCLIC_TASK_STACK_SIZE 128                                  // 执行器任务栈大小，单位：字，表中函数都在此栈上运行
+#define CYCLIC_MINOR_FRAME_MS 100                                   // 小帧长度，单位：ms
+#define CYCLIC_MINOR_FRAMES 5                                       // 每个大帧包含的小帧数, 大帧500ms即任务1~3的运行周期
+StackType_t cyclic_task_stack[CYCLIC_TASK_STACK_SIZE];
+StaticTask_t cyclic_task_tcb;
+void vJob1(void *pvParameters);
+void vJob2(void *pvParameters);
+void vJob3(void *pvParameters);
+/* 调度表: 任务1~3都在第0小帧依次运行, 执行器每500ms只唤醒一次; 第1~4小帧为空, 执行器不会被唤醒, 可留给以后100ms周期的控制函数 */
+static const CyclicSlot_t cyclic_slots[] =
+{
+    {0, vJob1, NULL},
+    {0, vJob2, NULL},
+    {0, vJob3, NULL},
+};
+static CyclicSlotStats_t cyclic_slot_stats[sizeof(cyclic_slots) / sizeof(cyclic_slots[0])]; // 每个槽位的执行时间统计(CPU周期)
+static const CyclicSchedule_t cyclic_schedule =
+{
+    cyclic_slots,
+    sizeof(cyclic_slots) / sizeof(cyclic_slots[0]),
+    pdMS_TO_TICKS(CYCLIC_MINOR_FRAME_MS),
+    CYCLIC_MINOR_FRAMES,
+    cyclic_slot_stats,
+};
+#elif configUSE_SHARED_STACKS
+/* 任务1~3共享栈配置 - 三个任务互不抢占, 每次运行到完成后释放栈, 共用一块栈空间 */
+#define TASK_GROUP_THRESHOLD 3                                      // 任务1~3的抢占阈值, 只有优先级高于3的任务4能抢占它们
+#define TASK_GROUP_PERIOD_MS 500                                    // 任务1~3的运行周期，单位：ms
+#define TASK_GROUP_STACK_SIZE 128                                   // 共享栈大小，单位：字，取三个任务中最大的栈需求
+StackType_t task_group_stack[TASK_GROUP_STACK_SIZE];
+void vJob1(void *pvParameters);
+void vJob2(void *pvParameters);
+void vJob3(void *pvParameters);
+#elif configUSE_PERIODIC_TASKS
+/* 任务1~3周期任务配置 - 由内核按固定周期释放, 相位自动错开, 并统计释放抖动和响应时间 */
+#define TASK_GROUP_PERIOD_MS 500                                    // 任务1~3的运行周期，单位：ms
+PeriodicTask_t task1_periodic;                                      // 任务1~3的周期控制块, 可随时用vPeriodicTaskGetStats()读取统计
+PeriodicTask_t task2_periodic;
+PeriodicTask_t task3_periodic;
+void vJob1(void *pvParameters);
+void vJob2(void *pvParameters);
+void vJob3(void *pvParameters);
+#endif
+
 /* 任务4 (按键扫描)配置 */
+#if configUSE_CYCLIC_EXECUTIVE
+#define TASK4_PRIORITY 3                                            // 最高优先级4留给循环执行器
+#else
 #define TASK4_PRIORITY 4
+#endif
 #define TASK4_STACK_SIZE 128
+#define TASK4_BUDGET_PERIOD_MS 100                                  // 任务4执行时间预算的补充周期，单位：ms
+#define TASK4_BUDGET_CYCLES (configCPU_CLOCK_HZ / 1000 * 10)        // 任务4每个周期可用的CPU周期数，72MHz下为10ms
 TaskHandle_t task4_handler;
 StackType_t task4_stack[TASK4_STACK_SIZE];
 StaticTask_t task4_tcb;
@@ -92,6 +157,33 @@ void FreeROTS_Start(void)
 void Start_Task(void *pvParameters)
 {
     taskENTER_CRITICAL(); /* 进入临界区，防止任务创建过程中被抢占 */
+#if configUSE_CYCLIC_EXECUTIVE
+    /* 任务1~3的工作由循环执行器按调度表调用, 只需创建一个执行器任务 */
+    xCyclicExecutiveCreateStatic(&cyclic_schedule, CYCLIC_TASK_PRIORITY, CYCLIC_TASK_STACK_SIZE,
+                                 cyclic_task_stack, &cyclic_task_tcb);
+#elif configUSE_SHARED_STACKS
+    /* 任务1~3作为周期作业共用task_group_stack, 必须在任何一个开始运行前全部创建 */
+    task1_handler = xTaskCreateStaticSharedStack(vJob1, "vTask1", TASK_GROUP_STACK_SIZE, NULL, TASK1_PRIORITY,
+                                                 TASK_GROUP_THRESHOLD, pdMS_TO_TICKS(TASK_GROUP_PERIOD_MS),
+                                                 task_group_stack, &task1_tcb);
+    task2_handler = xTaskCreateStaticSharedStack(vJob2, "vTask2", TASK_GROUP_STACK_SIZE, NULL, TASK2_PRIORITY,
+                                                 TASK_GROUP_THRESHOLD, pdMS_TO_TICKS(TASK_GROUP_PERIOD_MS),
+                                                 task_group_stack, &task2_tcb);
+    task3_handler = xTaskCreateStaticSharedStack(vJob3, "vTask3", TASK_GROUP_STACK_SIZE, NULL, TASK3_PRIORITY,
+                                                 TASK_GROUP_THRESHOLD, pdMS_TO_TICKS(TASK_GROUP_PERIOD_MS),
+                                                 task_group_stack, &task3_tcb);
+#elif configUSE_PERIODIC_TASKS
+    /* 任务1~3周期相同, 自动相位把它们的释放时刻均匀错开, 避免同一个节拍同时唤醒三个任务 */
+    task1_handler = xPeriodicTaskCreateStatic(vJob1, "vTask1", TASK1_STACK_SIZE, NULL, TASK1_PRIORITY,
+                                              pdMS_TO_TICKS(TASK_GROUP_PERIOD_MS), periodicAUTO_PHASE, 0,
+                                              task1_stack, &task1_tcb, &task1_periodic);
+    task2_handler = xPeriodicTaskCreateStatic(vJob2, "vTask2", TASK2_STACK_SIZE, NULL, TASK2_PRIORITY,
+                                              pdMS_TO_TICKS(TASK_GROUP_PERIOD_MS), periodicAUTO_PHASE, 0,
+                                              task2_stack, &task2_tcb, &task2_periodic);
+    task3_handler = xPeriodicTaskCreateStatic(vJob3, "vTask3", TASK3_STACK_SIZE, NULL, TASK3_PRIORITY,
+                                              pdMS_TO_TICKS(TASK_GROUP_PERIOD_MS), periodicAUTO_PHASE, 0,
+                                              task3_stack, &task3_tcb, &task3_periodic);
+#else
     task1_handler = xTaskCreateStatic(
         (TaskFunction_t)vTask1,
         (char *)"vTask1",
@@ -116,6 +208,7 @@ void Start_Task(void *pvParameters)
         (UBaseType_t)TASK3_PRIORITY,
         (StackType_t *)task3_stack,
         (StaticTask_t *)&task3_tcb);
+#endif
     task4_handler = xTaskCreateStatic(
         (TaskFunction_t)vTask4,
         (char *)"vTask4",
@@ -124,6 +217,10 @@ void Start_Task(void *pvParameters)
         (UBaseType_t)TASK4_PRIORITY,
         (StackType_t *)task4_stack,
         (StaticTask_t *)&task4_tcb);
+#if configUSE_TASK_BUDGETS
+    /* 按键扫描任务优先级最高, 每100ms最多占用10ms CPU, 用完后降到空闲优先级运行到下个周期, 避免其空转时饿死低优先级任务 */
+    vTaskSetBudget(task4_handler, TASK4_BUDGET_CYCLES, pdMS_TO_TICKS(TASK4_BUDGET_PERIOD_MS), eBudgetDemote);
+#endif
     vTaskDelete(start_task_handler); /* 创建完成后删除自身 */
     taskEXIT_CRITICAL();             /* 退出临界区 */
 }
@@ -166,6 +263,30 @@ void vTask3(void *pvParameters)
     }
 }
 
+#if configUSE_CYCLIC_EXECUTIVE || configUSE_SHARED_STACKS || configUSE_PERIODIC_TASKS
+/**
+ * 函数: vJob1 ~ vJob3
+ * 描述: 循环执行器、共享栈或周期任务模式下任务1~3的单次作业, 每500ms被调用一次, 不能延时或阻塞。
+ */
+void vJob1(void *pvParameters)
+{
+    printf("Task1 is running  RTOS tick: %lu  \r\n", xTaskGetTickCount());
+    LED_Toggle(LED_PIN1);
+}
+
+void vJob2(void *pvParameters)
+{
+    printf("Task2 is running  RTOS tick: %lu  \r\n", xTaskGetTickCount());
+    LED_Toggle(LED_PIN2);
+}
+
+void vJob3(void *pvParameters)
+{
+    printf("Task3 is running  RTOS tick: %lu  HAL tick: %lu\r\n",
+           xTaskGetTickCount(), HAL_GetTick());
+}
+#endif
+
 void vTask4(void *pvParameters)
 {
     uint8_t key_num = 0;
@@ -2,6 +2,8 @@
 #define FREERTOS_DEMO_H
 
 #include "./FreeROTS/source/Tim2.h"
+#include "cyclic.h"
+#include "periodic.h"
 #include "./SYSTEM/usart/usart.h"
 #include "./Hardware/LED/LED.h"
 #include "./Hardware/OLED/OLED.h"
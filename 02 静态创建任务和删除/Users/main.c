@@ -9,7 +9,9 @@ int main(void)
     sys_stm32_clock_init(RCC_PLL_MUL9); /* 设置时钟, 72Mhz */
     usart_init(115200);                 /* 初始化串口为115200 */
     delay_init(72);                     /* 延时初始化 */
+#if !(SYS_SUPPORT_OS && SYS_HAL_TICK_USE_OS)
     MX_TIM2_Init();                     /* 初始化TIM2用于HAL tick */
+#endif
 
     Key_Init(); /* 初始化按键 */
     LED_Init();